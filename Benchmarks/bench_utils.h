@@ -0,0 +1,26 @@
+#ifndef ALGLIB_BENCHMARKS_BENCH_UTILS_H_
+#define ALGLIB_BENCHMARKS_BENCH_UTILS_H_
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+namespace bench {
+
+// Largest amount of elements used by benchmarks, also the capacity of
+// fixed size containers.
+inline constexpr int64_t kMaxSize{16 << 20};
+
+// Runs a benchmark for sizes 16, 256, ..., 16M.
+inline void Sizes(benchmark::internal::Benchmark *benchmark) {
+  benchmark->RangeMultiplier(16)->Range(16, kMaxSize);
+}
+
+// Reports the amount of elements processed by all iterations.
+inline void SetItems(benchmark::State &state) {
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace bench
+
+#endif  // ALGLIB_BENCHMARKS_BENCH_UTILS_H_
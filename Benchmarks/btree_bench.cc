@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "bench_utils.h"
+#include "btree.h"
+
+namespace {
+
+using BTree = alglib::BTreeMap<uint64_t, uint64_t>;
+using StdMap = std::map<uint64_t, uint64_t>;
+
+void Insert(BTree &map, uint64_t key) { map.Insert(key, key); }
+void Insert(StdMap &map, uint64_t key) { map.emplace(key, key); }
+
+bool Contains(const BTree &map, uint64_t key) { return map.Contains(key); }
+bool Contains(const StdMap &map, uint64_t key) { return map.contains(key); }
+
+// Sums the values of up to 100 elements starting at a key.
+uint64_t Scan(const BTree &map, uint64_t key) {
+  uint64_t sum{};
+  int left{100};
+  for (auto it{map.LowerBound(key)}; it != map.end() && left > 0;
+       ++it, --left) {
+    sum += it->second;
+  }
+  return sum;
+}
+uint64_t Scan(const StdMap &map, uint64_t key) {
+  uint64_t sum{};
+  int left{100};
+  for (auto it{map.lower_bound(key)}; it != map.end() && left > 0;
+       ++it, --left) {
+    sum += it->second;
+  }
+  return sum;
+}
+
+// Keys in random order, the same for every map.
+std::vector<uint64_t> Keys(int64_t size, uint64_t seed) {
+  std::mt19937_64 random(seed);
+  std::vector<uint64_t> keys(static_cast<size_t>(size));
+  for (uint64_t &key : keys) key = random();
+  return keys;
+}
+
+// Builds a map from keys in random order.
+template <typename Map>
+void BM_OrderedMapInsert(benchmark::State &state) {
+  const std::vector<uint64_t> keys{Keys(state.range(0), 42)};
+  for (auto _ : state) {
+    Map map;
+    for (uint64_t key : keys) Insert(map, key);
+    benchmark::DoNotOptimize(map);
+  }
+  bench::SetItems(state);
+}
+
+// Looks up keys of which half are in the map.
+template <typename Map>
+void BM_OrderedMapLookup(benchmark::State &state) {
+  const std::vector<uint64_t> keys{Keys(state.range(0), 42)};
+  std::vector<uint64_t> lookups{Keys(state.range(0), 7)};
+  for (size_t i{}; i < lookups.size(); i += 2) lookups[i] = keys[i];
+  Map map;
+  for (uint64_t key : keys) Insert(map, key);
+  for (auto _ : state) {
+    size_t found{};
+    for (uint64_t key : lookups) found += Contains(map, key);
+    benchmark::DoNotOptimize(found);
+  }
+  bench::SetItems(state);
+}
+
+// Reads short ranges in key order, the pattern of a sorted index.
+template <typename Map>
+void BM_OrderedMapRangeScan(benchmark::State &state) {
+  const std::vector<uint64_t> keys{Keys(state.range(0), 42)};
+  const std::vector<uint64_t> starts{Keys(1024, 7)};
+  Map map;
+  for (uint64_t key : keys) Insert(map, key);
+  for (auto _ : state) {
+    uint64_t sum{};
+    for (uint64_t key : starts) sum += Scan(map, key);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+}  // namespace
+
+BENCHMARK(BM_OrderedMapInsert<StdMap>)->Apply(bench::Sizes);
+BENCHMARK(BM_OrderedMapInsert<BTree>)->Apply(bench::Sizes);
+BENCHMARK(BM_OrderedMapLookup<StdMap>)->Apply(bench::Sizes);
+BENCHMARK(BM_OrderedMapLookup<BTree>)->Apply(bench::Sizes);
+BENCHMARK(BM_OrderedMapRangeScan<StdMap>)->Apply(bench::Sizes);
+BENCHMARK(BM_OrderedMapRangeScan<BTree>)->Apply(bench::Sizes);
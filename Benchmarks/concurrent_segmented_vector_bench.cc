@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "bench_utils.h"
+#include "concurrent_segmented_vector.h"
+#include "vector.h"
+
+namespace {
+
+// Vector shared by threads under a lock, the usual way of collecting
+// results from many threads into one array.
+class LockedVector {
+ public:
+  size_t PushBack(int value) {
+    std::lock_guard lock(mutex);
+    vector.Push(value);
+    return vector.Size() - 1;
+  }
+
+ private:
+  std::mutex mutex;
+  alglib::Vector<int> vector;
+};
+
+using SegmentedVector = alglib::ConcurrentSegmentedVector<int>;
+
+// Every thread appends a block of elements to one shared container. The
+// container is created by the first thread before the threads start
+// together, and destroyed after they all finish.
+template <typename Container>
+void BM_SharedAppend(benchmark::State &state) {
+  static std::unique_ptr<Container> container;
+  if (state.thread_index() == 0) container = std::make_unique<Container>();
+  for (auto _ : state) {
+    for (int64_t i{}; i < state.range(0); ++i) {
+      benchmark::DoNotOptimize(container->PushBack(static_cast<int>(i)));
+    }
+  }
+  bench::SetItems(state);
+  if (state.thread_index() == 0) container.reset();
+}
+
+}  // namespace
+
+BENCHMARK(BM_SharedAppend<LockedVector>)
+    ->Arg(1024)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+BENCHMARK(BM_SharedAppend<SegmentedVector>)
+    ->Arg(1024)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
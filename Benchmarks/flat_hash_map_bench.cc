@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "bench_utils.h"
+#include "flat_hash_map.h"
+
+namespace {
+
+using FlatMap = alglib::FlatHashMap<uint64_t, uint64_t>;
+using StdMap = std::unordered_map<uint64_t, uint64_t>;
+
+void Insert(FlatMap &map, uint64_t key) { map[key] = key; }
+void Insert(StdMap &map, uint64_t key) { map[key] = key; }
+
+bool Contains(const FlatMap &map, uint64_t key) { return map.Contains(key); }
+bool Contains(const StdMap &map, uint64_t key) { return map.contains(key); }
+
+// Keys in random order, the same for every map.
+std::vector<uint64_t> Keys(int64_t size, uint64_t seed) {
+  std::mt19937_64 random(seed);
+  std::vector<uint64_t> keys(static_cast<size_t>(size));
+  for (uint64_t &key : keys) key = random();
+  return keys;
+}
+
+// Builds a map from scratch, including all its growth.
+template <typename Map>
+void BM_HashMapInsert(benchmark::State &state) {
+  const std::vector<uint64_t> keys{Keys(state.range(0), 42)};
+  for (auto _ : state) {
+    Map map;
+    for (uint64_t key : keys) Insert(map, key);
+    benchmark::DoNotOptimize(map);
+  }
+  bench::SetItems(state);
+}
+
+// Looks up keys of which half are in the map, the pattern of an index.
+template <typename Map>
+void BM_HashMapLookup(benchmark::State &state) {
+  const std::vector<uint64_t> keys{Keys(state.range(0), 42)};
+  std::vector<uint64_t> lookups{Keys(state.range(0), 7)};
+  for (size_t i{}; i < lookups.size(); i += 2) lookups[i] = keys[i];
+  Map map;
+  for (uint64_t key : keys) Insert(map, key);
+  for (auto _ : state) {
+    size_t found{};
+    for (uint64_t key : lookups) found += Contains(map, key);
+    benchmark::DoNotOptimize(found);
+  }
+  bench::SetItems(state);
+}
+
+}  // namespace
+
+BENCHMARK(BM_HashMapInsert<StdMap>)->Apply(bench::Sizes);
+BENCHMARK(BM_HashMapInsert<FlatMap>)->Apply(bench::Sizes);
+BENCHMARK(BM_HashMapLookup<StdMap>)->Apply(bench::Sizes);
+BENCHMARK(BM_HashMapLookup<FlatMap>)->Apply(bench::Sizes);
@@ -0,0 +1,206 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <forward_list>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "bench_utils.h"
+#include "doubly_linked_list.h"
+#include "ranges.h"
+#include "singly_linked_list.h"
+#include "vector.h"
+
+namespace {
+
+using SinglyList = alglib::SinglyLinkedList<int>;
+using DoublyList = alglib::DoublyLinkedList<int>;
+
+void PushFront(SinglyList &list, int value) { list.InsertAtBeginning(value); }
+void PushFront(DoublyList &list, int value) { list.InsertAtBeginning(value); }
+void PushFront(std::forward_list<int> &list, int value) {
+  list.push_front(value);
+}
+void PushFront(std::list<int> &list, int value) { list.push_front(value); }
+
+void PushBack(SinglyList &list, int value) { list.InsertAtEnd(value); }
+void PushBack(DoublyList &list, int value) { list.InsertAtEnd(value); }
+void PushBack(std::list<int> &list, int value) { list.push_back(value); }
+
+void PopFront(SinglyList &list) { list.DeleteAtBeggining(); }
+void PopFront(DoublyList &list) { list.DeleteAtBeginning(); }
+void PopFront(std::forward_list<int> &list) { list.pop_front(); }
+void PopFront(std::list<int> &list) { list.pop_front(); }
+
+bool Contains(const SinglyList &list, int value) {
+  return !list.Traverse([value](int element) { return element != value; });
+}
+bool Contains(const DoublyList &list, int value) {
+  return list.Find(value) != list.end();
+}
+template <typename List>
+bool Contains(const List &list, int value) {
+  return std::find(list.begin(), list.end(), value) != list.end();
+}
+
+template <typename List>
+long long Sum(const List &list) {
+  long long sum{};
+  if constexpr (requires { list.Traverse([](int) {}); }) {
+    list.Traverse([&sum](int value) { sum += value; });
+  } else {
+    for (int value : list) sum += value;
+  }
+  return sum;
+}
+
+template <typename List>
+void Fill(List &list, int64_t size) {
+  for (int64_t i{size - 1}; i >= 0; --i) {
+    PushFront(list, static_cast<int>(i));
+  }
+}
+
+template <typename List>
+void BM_ListPushFront(benchmark::State &state) {
+  for (auto _ : state) {
+    auto list{std::make_unique<List>()};
+    for (int64_t i{}; i < state.range(0); ++i) {
+      PushFront(*list, static_cast<int>(i));
+    }
+    benchmark::DoNotOptimize(*list);
+    state.PauseTiming();
+    list.reset();
+    state.ResumeTiming();
+  }
+  bench::SetItems(state);
+}
+
+template <typename List>
+void BM_ListPushBack(benchmark::State &state) {
+  for (auto _ : state) {
+    auto list{std::make_unique<List>()};
+    for (int64_t i{}; i < state.range(0); ++i) {
+      PushBack(*list, static_cast<int>(i));
+    }
+    benchmark::DoNotOptimize(*list);
+    state.PauseTiming();
+    list.reset();
+    state.ResumeTiming();
+  }
+  bench::SetItems(state);
+}
+
+template <typename List>
+void BM_ListPopFront(benchmark::State &state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    List list;
+    Fill(list, state.range(0));
+    state.ResumeTiming();
+    for (int64_t i{}; i < state.range(0); ++i) PopFront(list);
+    benchmark::DoNotOptimize(list);
+  }
+  bench::SetItems(state);
+}
+
+template <typename List>
+void BM_ListFind(benchmark::State &state) {
+  List list;
+  Fill(list, state.range(0));
+  const int last{static_cast<int>(state.range(0) - 1)};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Contains(list, last));
+  }
+  bench::SetItems(state);
+}
+
+template <typename List>
+void BM_ListTraverse(benchmark::State &state) {
+  List list;
+  Fill(list, state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Sum(list));
+  }
+  bench::SetItems(state);
+}
+
+// Pushes two elements for every pop at the front, so nodes are freed and
+// allocated again while the list grows.
+template <typename List>
+void BM_ListMixed(benchmark::State &state) {
+  for (auto _ : state) {
+    auto list{std::make_unique<List>()};
+    for (int64_t i{}; i < state.range(0); ++i) {
+      PushFront(*list, static_cast<int>(i));
+      if (i % 2 == 1) PopFront(*list);
+    }
+    benchmark::DoNotOptimize(*list);
+    state.PauseTiming();
+    list.reset();
+    state.ResumeTiming();
+  }
+  bench::SetItems(state);
+}
+
+// Exports the squares of even elements, first by copying the list out with
+// GetAsVector and then through lazy views streaming into the result.
+template <typename List>
+void BM_ListExportCopy(benchmark::State &state) {
+  List list;
+  Fill(list, state.range(0));
+  for (auto _ : state) {
+    alglib::Vector<int> result;
+    for (int value : list.GetAsVector()) {
+      if (value % 2 == 0) result.Push(value * value);
+    }
+    benchmark::DoNotOptimize(result);
+  }
+  bench::SetItems(state);
+}
+
+template <typename List>
+void BM_ListExportViews(benchmark::State &state) {
+  List list;
+  Fill(list, state.range(0));
+  for (auto _ : state) {
+    alglib::Vector<int> result;
+    alglib::AppendTo(
+        list | alglib::Filter([](int value) { return value % 2 == 0; }) |
+            alglib::Transform([](int value) { return value * value; }),
+        result);
+    benchmark::DoNotOptimize(result);
+  }
+  bench::SetItems(state);
+}
+
+}  // namespace
+
+BENCHMARK(BM_ListPushFront<SinglyList>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListPushFront<DoublyList>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListPushFront<std::forward_list<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListPushFront<std::list<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListPushBack<SinglyList>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListPushBack<DoublyList>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListPushBack<std::list<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListPopFront<SinglyList>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListPopFront<DoublyList>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListPopFront<std::forward_list<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListPopFront<std::list<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListFind<SinglyList>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListFind<DoublyList>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListFind<std::forward_list<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListFind<std::list<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListTraverse<SinglyList>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListTraverse<DoublyList>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListTraverse<std::forward_list<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListTraverse<std::list<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListMixed<SinglyList>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListMixed<DoublyList>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListMixed<std::forward_list<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListMixed<std::list<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListExportCopy<SinglyList>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListExportCopy<DoublyList>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListExportViews<SinglyList>)->Apply(bench::Sizes);
+BENCHMARK(BM_ListExportViews<DoublyList>)->Apply(bench::Sizes);
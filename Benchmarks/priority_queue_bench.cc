@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "bench_utils.h"
+#include "priority_queue.h"
+
+namespace {
+
+template <size_t arity>
+using DaryQueue = alglib::PriorityQueue<uint64_t, std::less<uint64_t>, arity>;
+using StdQueue = std::priority_queue<uint64_t>;
+
+void Push(StdQueue &queue, uint64_t value) { queue.push(value); }
+template <size_t arity>
+void Push(DaryQueue<arity> &queue, uint64_t value) { queue.Push(value); }
+
+uint64_t Pop(StdQueue &queue) {
+  const uint64_t value{queue.top()};
+  queue.pop();
+  return value;
+}
+template <size_t arity>
+uint64_t Pop(DaryQueue<arity> &queue) { return queue.Pop(); }
+
+// Keys in random order, the same for every queue.
+std::vector<uint64_t> Keys(int64_t size) {
+  std::mt19937_64 random(42);
+  std::vector<uint64_t> keys(static_cast<size_t>(size));
+  for (uint64_t &key : keys) key = random();
+  return keys;
+}
+
+// Fills the queue and pops all values, which is the pattern of top-K jobs.
+template <typename Queue>
+void BM_PriorityQueuePushPop(benchmark::State &state) {
+  const std::vector<uint64_t> keys{Keys(state.range(0))};
+  for (auto _ : state) {
+    Queue queue;
+    for (uint64_t key : keys) Push(queue, key);
+    uint64_t sum{};
+    for (size_t i{}; i < keys.size(); ++i) sum += Pop(queue);
+    benchmark::DoNotOptimize(sum);
+  }
+  bench::SetItems(state);
+}
+
+// Replaces the top of a full queue, the pattern of a timer wheel.
+template <typename Queue>
+void BM_PriorityQueueReplaceTop(benchmark::State &state) {
+  const std::vector<uint64_t> keys{Keys(state.range(0))};
+  Queue queue;
+  for (uint64_t key : keys) Push(queue, key);
+  std::mt19937_64 random(7);
+  for (auto _ : state) {
+    for (int64_t i{}; i < state.range(0); ++i) {
+      benchmark::DoNotOptimize(Pop(queue));
+      Push(queue, random());
+    }
+  }
+  bench::SetItems(state);
+}
+
+}  // namespace
+
+BENCHMARK(BM_PriorityQueuePushPop<StdQueue>)->Apply(bench::Sizes);
+BENCHMARK(BM_PriorityQueuePushPop<DaryQueue<2>>)->Apply(bench::Sizes);
+BENCHMARK(BM_PriorityQueuePushPop<DaryQueue<4>>)->Apply(bench::Sizes);
+BENCHMARK(BM_PriorityQueueReplaceTop<StdQueue>)->Apply(bench::Sizes);
+BENCHMARK(BM_PriorityQueueReplaceTop<DaryQueue<2>>)->Apply(bench::Sizes);
+BENCHMARK(BM_PriorityQueueReplaceTop<DaryQueue<4>>)->Apply(bench::Sizes);
@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+
+#include <deque>
+#include <memory>
+#include <queue>
+
+#include "bench_utils.h"
+#include "circular_queue.h"
+#include "sll_queue.h"
+
+namespace {
+
+using ListQueue = alglib::SLLQueue<int>;
+using RingQueue = alglib::CircularQueue<int, bench::kMaxSize>;
+
+void Enqueue(ListQueue &queue, int value) { queue.Enqueue(value); }
+void Enqueue(RingQueue &queue, int value) { queue.Enqueue(value); }
+void Enqueue(std::queue<int> &queue, int value) { queue.push(value); }
+void Enqueue(std::deque<int> &queue, int value) { queue.push_back(value); }
+
+int Dequeue(ListQueue &queue) { return queue.Dequeue(); }
+int Dequeue(RingQueue &queue) { return queue.Dequeue(); }
+int Dequeue(std::queue<int> &queue) {
+  const int value{queue.front()};
+  queue.pop();
+  return value;
+}
+int Dequeue(std::deque<int> &queue) {
+  const int value{queue.front()};
+  queue.pop_front();
+  return value;
+}
+
+// Queues are created on the heap, CircularQueue holds all of its capacity.
+template <typename Queue>
+std::unique_ptr<Queue> Filled(int64_t size) {
+  auto queue{std::make_unique<Queue>()};
+  for (int64_t i{}; i < size; ++i) Enqueue(*queue, static_cast<int>(i));
+  return queue;
+}
+
+template <typename Queue>
+void BM_QueueEnqueue(benchmark::State &state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto queue{std::make_unique<Queue>()};
+    state.ResumeTiming();
+    for (int64_t i{}; i < state.range(0); ++i) {
+      Enqueue(*queue, static_cast<int>(i));
+    }
+    benchmark::DoNotOptimize(*queue);
+    state.PauseTiming();
+    queue.reset();
+    state.ResumeTiming();
+  }
+  bench::SetItems(state);
+}
+
+template <typename Queue>
+void BM_QueueDequeue(benchmark::State &state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto queue{Filled<Queue>(state.range(0))};
+    state.ResumeTiming();
+    for (int64_t i{}; i < state.range(0); ++i) {
+      benchmark::DoNotOptimize(Dequeue(*queue));
+    }
+    state.PauseTiming();
+    queue.reset();
+    state.ResumeTiming();
+  }
+  bench::SetItems(state);
+}
+
+// Keeps the queue at a given size while elements flow through it, the way a
+// buffer between two stages is used.
+template <typename Queue>
+void BM_QueueMixed(benchmark::State &state) {
+  auto queue{Filled<Queue>(state.range(0) - 1)};
+  for (auto _ : state) {
+    for (int64_t i{}; i < state.range(0); ++i) {
+      Enqueue(*queue, static_cast<int>(i));
+      benchmark::DoNotOptimize(Dequeue(*queue));
+    }
+  }
+  bench::SetItems(state);
+}
+
+}  // namespace
+
+BENCHMARK(BM_QueueEnqueue<ListQueue>)->Apply(bench::Sizes);
+BENCHMARK(BM_QueueEnqueue<RingQueue>)->Apply(bench::Sizes);
+BENCHMARK(BM_QueueEnqueue<std::queue<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_QueueEnqueue<std::deque<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_QueueDequeue<ListQueue>)->Apply(bench::Sizes);
+BENCHMARK(BM_QueueDequeue<RingQueue>)->Apply(bench::Sizes);
+BENCHMARK(BM_QueueDequeue<std::queue<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_QueueDequeue<std::deque<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_QueueMixed<ListQueue>)->Apply(bench::Sizes);
+BENCHMARK(BM_QueueMixed<RingQueue>)->Apply(bench::Sizes);
+BENCHMARK(BM_QueueMixed<std::queue<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_QueueMixed<std::deque<int>>)->Apply(bench::Sizes);
@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+#include "bench_utils.h"
+#include "simd_algorithms.h"
+#include "soa_vector.h"
+#include "vector.h"
+
+namespace {
+
+// Record of a particle. Summing one field of an array of these records reads
+// whole records, while the SoA layout reads only the summed column.
+struct Particle {
+  float x;
+  float y;
+  float z;
+  float mass;
+  int32_t id;
+  int32_t flags;
+};
+
+using ParticleColumns =
+    alglib::SoAVector<float, float, float, float, int32_t, int32_t>;
+
+alglib::Vector<Particle> FilledRecords(int64_t size) {
+  alglib::Vector<Particle> records;
+  for (int64_t i{}; i < size; ++i) {
+    const float value{static_cast<float>(i % 100)};
+    records.Push(Particle{value, value, value, value, static_cast<int32_t>(i),
+                          0});
+  }
+  return records;
+}
+
+ParticleColumns FilledColumns(int64_t size) {
+  ParticleColumns columns;
+  for (int64_t i{}; i < size; ++i) {
+    const float value{static_cast<float>(i % 100)};
+    columns.Push(value, value, value, value, static_cast<int32_t>(i), 0);
+  }
+  return columns;
+}
+
+void BM_RecordsSumField(benchmark::State &state) {
+  const alglib::Vector<Particle> records{FilledRecords(state.range(0))};
+  for (auto _ : state) {
+    float sum{};
+    for (const Particle &particle : records) sum += particle.mass;
+    benchmark::DoNotOptimize(sum);
+  }
+  bench::SetItems(state);
+}
+
+void BM_ColumnsSumField(benchmark::State &state) {
+  const ParticleColumns columns{FilledColumns(state.range(0))};
+  for (auto _ : state) {
+    float sum{};
+    for (float mass : columns.Column<3>()) sum += mass;
+    benchmark::DoNotOptimize(sum);
+  }
+  bench::SetItems(state);
+}
+
+void BM_ColumnsSimdSumField(benchmark::State &state) {
+  const ParticleColumns columns{FilledColumns(state.range(0))};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(alglib::SimdSum(columns.Column<3>()));
+  }
+  bench::SetItems(state);
+}
+
+void BM_RecordsPush(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FilledRecords(state.range(0)));
+  }
+  bench::SetItems(state);
+}
+
+void BM_ColumnsPush(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FilledColumns(state.range(0)));
+  }
+  bench::SetItems(state);
+}
+
+}  // namespace
+
+BENCHMARK(BM_RecordsSumField)->Apply(bench::Sizes);
+BENCHMARK(BM_ColumnsSumField)->Apply(bench::Sizes);
+BENCHMARK(BM_ColumnsSimdSumField)->Apply(bench::Sizes);
+BENCHMARK(BM_RecordsPush)->Apply(bench::Sizes);
+BENCHMARK(BM_ColumnsPush)->Apply(bench::Sizes);
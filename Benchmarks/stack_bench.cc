@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <stack>
+#include <vector>
+
+#include "array_stack.h"
+#include "bench_utils.h"
+#include "sll_stack.h"
+
+namespace {
+
+using FixedStack = alglib::ArrayStack<int, bench::kMaxSize>;
+using ListStack = alglib::SLLStack<int>;
+using VectorStack = std::stack<int, std::vector<int>>;
+
+void Push(FixedStack &stack, int value) { stack.Push(value); }
+void Push(ListStack &stack, int value) { stack.Push(value); }
+template <typename Stack>
+void Push(Stack &stack, int value) {
+  stack.push(value);
+}
+
+int Pop(FixedStack &stack) { return stack.Pop(); }
+int Pop(ListStack &stack) { return stack.Pop(); }
+template <typename Stack>
+int Pop(Stack &stack) {
+  const int value{stack.top()};
+  stack.pop();
+  return value;
+}
+
+// Stacks are created on the heap, ArrayStack holds all of its capacity.
+template <typename Stack>
+std::unique_ptr<Stack> Filled(int64_t size) {
+  auto stack{std::make_unique<Stack>()};
+  for (int64_t i{}; i < size; ++i) Push(*stack, static_cast<int>(i));
+  return stack;
+}
+
+template <typename Stack>
+void BM_StackPush(benchmark::State &state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto stack{std::make_unique<Stack>()};
+    state.ResumeTiming();
+    for (int64_t i{}; i < state.range(0); ++i) {
+      Push(*stack, static_cast<int>(i));
+    }
+    benchmark::DoNotOptimize(*stack);
+    state.PauseTiming();
+    stack.reset();
+    state.ResumeTiming();
+  }
+  bench::SetItems(state);
+}
+
+template <typename Stack>
+void BM_StackPop(benchmark::State &state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto stack{Filled<Stack>(state.range(0))};
+    state.ResumeTiming();
+    for (int64_t i{}; i < state.range(0); ++i) {
+      benchmark::DoNotOptimize(Pop(*stack));
+    }
+    state.PauseTiming();
+    stack.reset();
+    state.ResumeTiming();
+  }
+  bench::SetItems(state);
+}
+
+// Pushes and pops around a given depth, like a depth-first search does.
+template <typename Stack>
+void BM_StackMixed(benchmark::State &state) {
+  auto stack{Filled<Stack>(state.range(0) / 2)};
+  for (auto _ : state) {
+    for (int64_t i{}; i < state.range(0); ++i) {
+      Push(*stack, static_cast<int>(i));
+      if (i % 2 == 0) Push(*stack, static_cast<int>(i));
+      benchmark::DoNotOptimize(Pop(*stack));
+      if (i % 2 == 1) benchmark::DoNotOptimize(Pop(*stack));
+    }
+  }
+  bench::SetItems(state);
+}
+
+}  // namespace
+
+BENCHMARK(BM_StackPush<FixedStack>)->Apply(bench::Sizes);
+BENCHMARK(BM_StackPush<ListStack>)->Apply(bench::Sizes);
+BENCHMARK(BM_StackPush<std::stack<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_StackPush<VectorStack>)->Apply(bench::Sizes);
+BENCHMARK(BM_StackPop<FixedStack>)->Apply(bench::Sizes);
+BENCHMARK(BM_StackPop<ListStack>)->Apply(bench::Sizes);
+BENCHMARK(BM_StackPop<std::stack<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_StackPop<VectorStack>)->Apply(bench::Sizes);
+BENCHMARK(BM_StackMixed<FixedStack>)->Apply(bench::Sizes);
+BENCHMARK(BM_StackMixed<ListStack>)->Apply(bench::Sizes);
+BENCHMARK(BM_StackMixed<std::stack<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_StackMixed<VectorStack>)->Apply(bench::Sizes);
@@ -0,0 +1,122 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "bench_utils.h"
+#include "vector.h"
+
+namespace {
+
+void Push(alglib::Vector<int> &vector, int value) { vector.Push(value); }
+void Push(std::vector<int> &vector, int value) { vector.push_back(value); }
+
+int Pop(alglib::Vector<int> &vector) { return vector.Pop(); }
+int Pop(std::vector<int> &vector) {
+  const int value{vector.back()};
+  vector.pop_back();
+  return value;
+}
+
+void Append(alglib::Vector<int> &vector, const std::vector<int> &values) {
+  vector.Append(values.begin(), values.end());
+}
+void Append(std::vector<int> &vector, const std::vector<int> &values) {
+  vector.insert(vector.end(), values.begin(), values.end());
+}
+
+template <typename Container>
+Container Filled(int64_t size) {
+  Container container;
+  for (int64_t i{}; i < size; ++i) Push(container, static_cast<int>(i));
+  return container;
+}
+
+template <typename Container>
+void BM_VectorPush(benchmark::State &state) {
+  for (auto _ : state) {
+    Container container;
+    for (int64_t i{}; i < state.range(0); ++i) {
+      Push(container, static_cast<int>(i));
+    }
+    benchmark::DoNotOptimize(container);
+  }
+  bench::SetItems(state);
+}
+
+template <typename Container>
+void BM_VectorPop(benchmark::State &state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    Container container{Filled<Container>(state.range(0))};
+    state.ResumeTiming();
+    for (int64_t i{}; i < state.range(0); ++i) {
+      benchmark::DoNotOptimize(Pop(container));
+    }
+  }
+  bench::SetItems(state);
+}
+
+template <typename Container>
+void BM_VectorAppend(benchmark::State &state) {
+  std::vector<int> values(static_cast<size_t>(state.range(0)));
+  std::iota(values.begin(), values.end(), 0);
+  for (auto _ : state) {
+    Container container;
+    Append(container, values);
+    benchmark::DoNotOptimize(container);
+  }
+  bench::SetItems(state);
+}
+
+template <typename Container>
+void BM_VectorFind(benchmark::State &state) {
+  const Container container{Filled<Container>(state.range(0))};
+  const int last{static_cast<int>(state.range(0) - 1)};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        std::find(container.begin(), container.end(), last));
+  }
+  bench::SetItems(state);
+}
+
+template <typename Container>
+void BM_VectorTraverse(benchmark::State &state) {
+  const Container container{Filled<Container>(state.range(0))};
+  for (auto _ : state) {
+    long long sum{};
+    for (int value : container) sum += value;
+    benchmark::DoNotOptimize(sum);
+  }
+  bench::SetItems(state);
+}
+
+// Pushes two elements for every pop, like a growing work list.
+template <typename Container>
+void BM_VectorMixed(benchmark::State &state) {
+  for (auto _ : state) {
+    Container container;
+    for (int64_t i{}; i < state.range(0); ++i) {
+      Push(container, static_cast<int>(i));
+      if (i % 2 == 1) benchmark::DoNotOptimize(Pop(container));
+    }
+    benchmark::DoNotOptimize(container);
+  }
+  bench::SetItems(state);
+}
+
+}  // namespace
+
+BENCHMARK(BM_VectorPush<alglib::Vector<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_VectorPush<std::vector<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_VectorPop<alglib::Vector<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_VectorPop<std::vector<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_VectorAppend<alglib::Vector<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_VectorAppend<std::vector<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_VectorFind<alglib::Vector<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_VectorFind<std::vector<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_VectorTraverse<alglib::Vector<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_VectorTraverse<std::vector<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_VectorMixed<alglib::Vector<int>>)->Apply(bench::Sizes);
+BENCHMARK(BM_VectorMixed<std::vector<int>>)->Apply(bench::Sizes);
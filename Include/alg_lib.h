@@ -32,12 +32,36 @@
 #define ALGLIB_INCLUDE_ALGLIB_H_
 
 #include "array_stack.h"
+#include "btree.h"
+#include "byte_ring.h"
+#include "cache.h"
 #include "circular_queue.h"
+#include "concurrent_queue.h"
+#include "concurrent_segmented_vector.h"
+#include "concurrent_stack.h"
 #include "constants.h"
 #include "doubly_linked_list.h"
+#include "flat_hash_map.h"
+#include "growth_policy.h"
+#include "hazard_pointers.h"
+#include "mapped_vector.h"
+#include "node_pool.h"
+#include "parallel_algorithms.h"
+#include "priority_queue.h"
+#include "ranges.h"
 #include "singly_linked_list.h"
 #include "sll_queue.h"
 #include "sll_stack.h"
+#include "simd_algorithms.h"
+#include "small_vector.h"
+#include "soa_vector.h"
+#include "spsc_ring.h"
+#include "stats.h"
+#include "task_scheduler.h"
+#include "thread_pool.h"
+#include "traversal.h"
+#include "unrolled_list.h"
 #include "vector.h"
+#include "work_stealing_deque.h"
 
 #endif // ALGLIB_INCLUDE_ALGLIB_H_
@@ -35,10 +35,14 @@
 #ifndef ALGLIB_INCLUDE_ARRAYSTACK_H_
 #define ALGLIB_INCLUDE_ARRAYSTACK_H_
 
-#include <array>
+#include <cstddef>
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 #include "constants.h"
+#include "stats.h"
 
 /// <summary>
 /// Default namespace for the AlgLib library.
@@ -48,56 +52,174 @@ namespace alglib {
 /// <summary>
 /// Template based stack implementation that uses an array as a base structure.
 /// It doesn't allocate memory on the heap, but it has a fixed capacity that has
-/// to be defined at compile time.
+/// to be defined at compile time. Elements are constructed only when they are
+/// pushed and destroyed when they are popped, so T doesn't have to be default
+/// constructible. All methods are constexpr, so the stack can be used during
+/// compile-time evaluation.
 /// </summary>
 /// <typeparam name="T"> type of data stored in stack</typeparam>
 /// <typeparam name="capacity"> max capacity of stack (size of
 /// array)</typeparam>
 template <typename T, size_t capacity>
 class ArrayStack {
+  static_assert(capacity > 0, "ArrayStack capacity has to be positive.");
+
  public:
-  // Constructor for the ArrayStack.
-  ArrayStack();
+  // Constructors and assignment operators for the ArrayStack.
+  constexpr ArrayStack() noexcept;
+  constexpr ArrayStack(const ArrayStack &other);
+  constexpr ArrayStack(ArrayStack &&other) noexcept(
+      std::is_nothrow_move_constructible_v<T>);
+  constexpr ArrayStack &operator=(const ArrayStack &other);
+  constexpr ArrayStack &operator=(ArrayStack &&other) noexcept(
+      std::is_nothrow_move_constructible_v<T>);
 
   // Methods for manipulating the stack.
-  void Push(T val);
-  T Pop();
-  T Top() const;
-  bool IsEmpty() const noexcept;
-  bool IsFull() const noexcept;
-  size_t Size() const noexcept;
-  size_t Capacity() const noexcept;
+  constexpr void Push(T val);
+  template <typename... Args>
+  constexpr T &Emplace(Args &&...args);
+  constexpr T Pop();
+  constexpr T Top() const;
+
+  // Non-throwing methods for manipulating the stack.
+  constexpr bool TryPush(T val);
+  template <typename... Args>
+  constexpr T *TryEmplace(Args &&...args);
+  constexpr bool TryPop(T &val);
+  constexpr bool TryTop(T &val) const;
+
+  constexpr bool IsEmpty() const noexcept;
+  constexpr bool IsFull() const noexcept;
+  constexpr size_t Size() const noexcept;
+  constexpr size_t Capacity() const noexcept;
+
+  // Getting statistics of the stack.
+  ContainerStats GetStats() const noexcept;
+
+  // Destructor for the ArrayStack.
+  constexpr ~ArrayStack();
 
  private:
+  /// <summary>
+  /// Uninitialized memory for elements. Being a union member, the array is
+  /// not constructed together with the stack, its elements are constructed
+  /// one by one with std::construct_at.
+  /// </summary>
+  union Storage {
+    constexpr Storage() noexcept {}
+    constexpr ~Storage() {}
+
+    T elements[capacity];
+  };
+
+  // Methods for handling elements.
+  template <typename Stack>
+  constexpr void Assign(Stack &&other);
+  constexpr void Destroy() noexcept;
+
   /// <summary>
   /// Array that holds the data of the stack.
   /// </summary>
-  std::array<T, capacity> data;
+  Storage data;
 
   /// <summary>
-  /// Index of the top element in the stack.
+  /// Number of elements in the stack, which is also the index one past the
+  /// top element.
   /// </summary>
-  int topIndex;
+  size_t size;
+
+  /// <summary>
+  /// Statistics of the stack, empty unless ALGLIB_ENABLE_STATS is defined.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS detail::StatsRecorder stats;
 };
 
 /// <summary>
-/// ArrayStack constructor. Only initializes the topIndex to -1.
+/// ArrayStack constructor. Only initializes the size to 0, no element is
+/// constructed.
+/// </summary>
+template <typename T, size_t capacity>
+constexpr ArrayStack<T, capacity>::ArrayStack() noexcept : size(0) {}
+
+/// <summary>
+/// Copy constructor copying elements of the other stack.
 /// </summary>
+/// <param name="other"> stack to be copied.</param>
 template <typename T, size_t capacity>
-ArrayStack<T, capacity>::ArrayStack() : topIndex(-1), data() {}
+constexpr ArrayStack<T, capacity>::ArrayStack(const ArrayStack &other)
+    : size(0) {
+  Assign(other);
+}
+
+/// <summary>
+/// Move constructor moving elements of the other stack. The other stack
+/// keeps its size, with elements in moved-from state.
+/// </summary>
+/// <param name="other"> stack to be moved.</param>
+template <typename T, size_t capacity>
+constexpr ArrayStack<T, capacity>::ArrayStack(ArrayStack &&other) noexcept(
+    std::is_nothrow_move_constructible_v<T>)
+    : size(0) {
+  Assign(std::move(other));
+}
+
+/// <summary>
+/// Copy assignment operator replacing elements with copies of elements of
+/// the other stack.
+/// </summary>
+/// <param name="other"> stack to be copied.</param>
+/// <returns> reference to this stack.</returns>
+template <typename T, size_t capacity>
+constexpr ArrayStack<T, capacity> &ArrayStack<T, capacity>::operator=(
+    const ArrayStack &other) {
+  if (this != &other) {
+    Destroy();
+    Assign(other);
+  }
+  return *this;
+}
+
+/// <summary>
+/// Move assignment operator replacing elements with elements moved from
+/// the other stack.
+/// </summary>
+/// <param name="other"> stack to be moved.</param>
+/// <returns> reference to this stack.</returns>
+template <typename T, size_t capacity>
+constexpr ArrayStack<T, capacity> &ArrayStack<T, capacity>::operator=(
+    ArrayStack &&other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+  if (this != &other) {
+    Destroy();
+    Assign(std::move(other));
+  }
+  return *this;
+}
 
 /// <summary>
 /// Pushes a value to the top of the stack.
-/// Handles the topIndex and checks if the stack is full.
+/// Checks if the stack is full before constructing the element.
 /// </summary>
 /// <param name="val"> value to be pushed.</param>
 template <typename T, size_t capacity>
-void ArrayStack<T, capacity>::Push(T val) {
-  topIndex++;
-  if (topIndex >= capacity) {
-    throw std::runtime_error(errors::kObjectFull);
+constexpr void ArrayStack<T, capacity>::Push(T val) {
+  Emplace(std::move(val));
+}
+
+/// <summary>
+/// Constructs a new element on the top of the stack from given arguments.
+/// </summary>
+/// <param name="args"> arguments passed to the constructor of T.</param>
+/// <returns> reference to the new element.</returns>
+/// <exception cref="std::runtime_error"> thrown when the stack is
+/// full.</exception>
+template <typename T, size_t capacity>
+template <typename... Args>
+constexpr T &ArrayStack<T, capacity>::Emplace(Args &&...args) {
+  T *element{TryEmplace(std::forward<Args>(args)...)};
+  if (element == nullptr) {
+    ALGLIB_THROW(std::runtime_error(errors::kObjectFull));
   }
-  data[topIndex] = val;
+  return *element;
 }
 
 /// <summary>
@@ -105,11 +227,15 @@ void ArrayStack<T, capacity>::Push(T val) {
 /// </summary>
 /// <returns> value that was on the top of the stack.</returns>
 template <typename T, size_t capacity>
-T ArrayStack<T, capacity>::Pop() {
-  if (topIndex < 0) {
-    throw std::runtime_error(errors::kEmptyDeletion);
+constexpr T ArrayStack<T, capacity>::Pop() {
+  if (IsEmpty()) {
+    ALGLIB_THROW(std::runtime_error(errors::kEmptyDeletion));
   }
-  return data.at(topIndex--);
+  T *top{data.elements + size - 1};
+  T result{std::move(*top)};
+  std::destroy_at(top);
+  --size;
+  return result;
 }
 
 /// <summary>
@@ -117,11 +243,78 @@ T ArrayStack<T, capacity>::Pop() {
 /// </summary>
 /// <returns>vale that is on the top of the stack.</returns>
 template <typename T, size_t capacity>
-T ArrayStack<T, capacity>::Top() const {
+constexpr T ArrayStack<T, capacity>::Top() const {
+  if (IsEmpty()) {
+    ALGLIB_THROW(std::runtime_error(errors::kPeekAtEmpty));
+  }
+  return data.elements[size - 1];
+}
+
+/// <summary>
+/// Pushes a value to the top of the stack unless the stack is full.
+/// </summary>
+/// <param name="val"> value to be pushed.</param>
+/// <returns> true if the value was pushed, false if the stack is
+/// full.</returns>
+template <typename T, size_t capacity>
+constexpr bool ArrayStack<T, capacity>::TryPush(T val) {
+  return TryEmplace(std::move(val)) != nullptr;
+}
+
+/// <summary>
+/// Constructs a new element on the top of the stack from given arguments
+/// unless the stack is full.
+/// </summary>
+/// <param name="args"> arguments passed to the constructor of T.</param>
+/// <returns> pointer to the new element or nullptr if the stack is
+/// full.</returns>
+template <typename T, size_t capacity>
+template <typename... Args>
+constexpr T *ArrayStack<T, capacity>::TryEmplace(Args &&...args) {
+  if (IsFull()) {
+    stats.Rejection();
+    return nullptr;
+  }
+  T *element{std::construct_at(data.elements + size,
+                               std::forward<Args>(args)...)};
+  ++size;
+  stats.Size(size);
+  return element;
+}
+
+/// <summary>
+/// Pops the value from the top of the stack into a given object unless the
+/// stack is empty.
+/// </summary>
+/// <param name="val"> object the top value is moved into.</param>
+/// <returns> true if a value was popped, false if the stack is
+/// empty.</returns>
+template <typename T, size_t capacity>
+constexpr bool ArrayStack<T, capacity>::TryPop(T &val) {
   if (IsEmpty()) {
-    throw std::runtime_error(errors::kPeekAtEmpty);
+    return false;
   }
-  return data.at(topIndex);
+  T *top{data.elements + size - 1};
+  val = std::move(*top);
+  std::destroy_at(top);
+  --size;
+  return true;
+}
+
+/// <summary>
+/// Copies the value from the top of the stack into a given object unless the
+/// stack is empty.
+/// </summary>
+/// <param name="val"> object the top value is copied into.</param>
+/// <returns> true if a value was copied, false if the stack is
+/// empty.</returns>
+template <typename T, size_t capacity>
+constexpr bool ArrayStack<T, capacity>::TryTop(T &val) const {
+  if (IsEmpty()) {
+    return false;
+  }
+  val = data.elements[size - 1];
+  return true;
 }
 
 /// <summary>
@@ -129,17 +322,17 @@ T ArrayStack<T, capacity>::Top() const {
 /// </summary>
 /// <returns>true if empty, false if not</returns>
 template <typename T, size_t capacity>
-bool ArrayStack<T, capacity>::IsEmpty() const noexcept {
-  return topIndex < 0;
+constexpr bool ArrayStack<T, capacity>::IsEmpty() const noexcept {
+  return size == 0;
 }
 
 /// <summary>
 /// Method that checks if the stack is full.
 /// </summary>
 /// <returns>true if stack is full, false if not.</returns>
-template <typename T, size_t capacity>  
-bool ArrayStack<T, capacity>::IsFull() const noexcept {  
- return topIndex == capacity - 1;  
+template <typename T, size_t capacity>
+constexpr bool ArrayStack<T, capacity>::IsFull() const noexcept {
+  return size == capacity;
 }
 
 /// <summary>
@@ -147,8 +340,8 @@ bool ArrayStack<T, capacity>::IsFull() const noexcept {
 /// </summary>
 /// <returns> number of items in the stack.</returns>
 template <typename T, size_t capacity>
-size_t ArrayStack<T, capacity>::Size() const noexcept {
-  return topIndex + 1;
+constexpr size_t ArrayStack<T, capacity>::Size() const noexcept {
+  return size;
 }
 
 /// <summary>
@@ -156,10 +349,64 @@ size_t ArrayStack<T, capacity>::Size() const noexcept {
 /// </summary>
 /// <returns> maximum capacity of the stack.</returns>
 template <typename T, size_t capacity>
-size_t ArrayStack<T, capacity>::Capacity() const noexcept {
+constexpr size_t ArrayStack<T, capacity>::Capacity() const noexcept {
   return capacity;
 }
 
+/// <summary>
+/// Method that gets statistics of the stack. It records the biggest size and
+/// pushes rejected because the stack was full. Without ALGLIB_ENABLE_STATS
+/// all counters are zero.
+/// </summary>
+/// <returns> statistics of the stack.</returns>
+template <typename T, size_t capacity>
+ContainerStats ArrayStack<T, capacity>::GetStats() const noexcept {
+  return stats.Get();
+}
+
+/// <summary>
+/// Destructor for the ArrayStack destroying elements that are left.
+/// </summary>
+template <typename T, size_t capacity>
+constexpr ArrayStack<T, capacity>::~ArrayStack() {
+  Destroy();
+}
+
+/// <summary>
+/// Copies or moves elements of another stack into this empty stack. If an
+/// element throws, the ones already made are destroyed and the stack is left
+/// empty.
+/// </summary>
+/// <param name="other"> stack whose elements are copied, or moved if it is
+/// an rvalue.</param>
+template <typename T, size_t capacity>
+template <typename Stack>
+constexpr void ArrayStack<T, capacity>::Assign(Stack &&other) {
+  ALGLIB_TRY {
+    for (; size < other.size; ++size) {
+      if constexpr (std::is_rvalue_reference_v<Stack &&>) {
+        std::construct_at(data.elements + size,
+                          std::move(other.data.elements[size]));
+      } else {
+        std::construct_at(data.elements + size, other.data.elements[size]);
+      }
+    }
+  } ALGLIB_CATCH_ALL {
+    Destroy();
+    ALGLIB_RETHROW;
+  }
+}
+
+/// <summary>
+/// Destroys all elements, from the top one, and sets the size to 0.
+/// </summary>
+template <typename T, size_t capacity>
+constexpr void ArrayStack<T, capacity>::Destroy() noexcept {
+  for (; size > 0; --size) {
+    std::destroy_at(data.elements + size - 1);
+  }
+}
+
 }  // namespace alglib
 
 #endif  // ALGLIB_INCLUDE_ARRAYSTACK_H_
\ No newline at end of file
@@ -0,0 +1,1840 @@
+//*****************************************************************************
+// The MIT License (MIT)
+//
+// Copyright � 2024 Piotr Walczak
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the �Software�), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED �AS IS�, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//*****************************************************************************
+
+//*****************************************************************************
+// File: btree.h
+//
+// This file contains BTreeMap and BTreeSet, ordered containers built on a
+// B+ tree. Nodes are wide arrays sized in bytes, so a lookup reads a few
+// cache lines per level instead of one node per key, and keys of a node are
+// kept apart from values so that searching a node only touches keys. All
+// elements live in leaves, which are linked for in-order scans. Everything
+// is implemented in the alglib namespace.
+//*****************************************************************************
+
+#ifndef ALGLIB_INCLUDE_BTREE_H_
+#define ALGLIB_INCLUDE_BTREE_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "constants.h"
+#include "stats.h"
+#include "vector.h"
+
+/// <summary>
+/// Default namespace for the AlgLib library.
+/// </summary>
+namespace alglib {
+
+/// <summary>
+/// Default size of a single node of the B+ tree, four cache lines.
+/// </summary>
+inline constexpr size_t kDefaultNodeBytes{256};
+
+/// <summary>
+/// Namespace for helpers of containers.
+/// </summary>
+namespace detail {
+
+/// <summary>
+/// Value type of trees used as sets, which don't store values.
+/// </summary>
+struct BTreeNoValue {};
+
+/// <summary>
+/// Storage for the values of a leaf. Sets use the empty specialization.
+/// </summary>
+template <typename V, size_t capacity>
+struct BTreeLeafValues {
+  V *Get() noexcept { return std::launder(reinterpret_cast<V *>(storage)); }
+
+  alignas(V) std::byte storage[capacity * sizeof(V)];
+};
+
+template <size_t capacity>
+struct BTreeLeafValues<BTreeNoValue, capacity> {
+  BTreeNoValue *Get() noexcept { return nullptr; }
+};
+
+/// <summary>
+/// Result of dereferencing a map iterator accessed with the arrow operator.
+/// It holds the pair of references, so it->second works like for other
+/// maps.
+/// </summary>
+template <typename Reference>
+struct BTreeArrow {
+  const Reference *operator->() const noexcept { return &reference; }
+
+  Reference reference;
+};
+
+/// <summary>
+/// Gets the number of entries that fit in a node of a given size, leaving
+/// one spare entry for a node that is about to be split.
+/// </summary>
+/// <param name="node_bytes"> size of the node.</param>
+/// <param name="header_bytes"> size of the fields before the entries.</param>
+/// <param name="entry_bytes"> size of a single entry.</param>
+/// <returns> number of entries, at least 4.</returns>
+constexpr size_t BTreeNodeCapacity(size_t node_bytes, size_t header_bytes,
+                                   size_t entry_bytes) noexcept {
+  const size_t entries{
+      node_bytes > header_bytes ? (node_bytes - header_bytes) / entry_bytes
+                                : 0};
+  return entries > 5 ? entries - 1 : 4;
+}
+
+/// <summary>
+/// B+ tree shared by BTreeMap and BTreeSet. Internal nodes hold separator
+/// keys and child pointers, and a key equal to a separator is always in the
+/// subtree to its right. Leaves hold sorted keys and their values in
+/// separate arrays and are linked in both directions. Nodes have one spare
+/// slot, so an insertion can always complete in the node before it is
+/// split. Every node except the root is kept at least about half full, by
+/// borrowing from a sibling or merging with it after erasing.
+/// </summary>
+/// <typeparam name="K"> type of keys.</typeparam>
+/// <typeparam name="V"> type of values, BTreeNoValue for sets.</typeparam>
+/// <typeparam name="NodeBytes"> approximate size of a node in bytes. A node
+/// holds at least four keys.</typeparam>
+/// <typeparam name="Compare"> strict weak ordering of keys.</typeparam>
+/// <typeparam name="Allocator"> allocator used to obtain memory for
+/// nodes.</typeparam>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+class BTree {
+  static constexpr bool kIsSet{std::is_same_v<V, BTreeNoValue>};
+  static constexpr size_t kValueBytes{kIsSet ? 0 : sizeof(V)};
+  static constexpr size_t kHeaderBytes{sizeof(size_t) + sizeof(void *)};
+  static constexpr size_t kLeafBytes{kHeaderBytes + 2 * sizeof(void *)};
+
+ public:
+  /// <summary>
+  /// Maximum number of elements of a leaf.
+  /// </summary>
+  static constexpr size_t kLeafCapacity{
+      BTreeNodeCapacity(NodeBytes, kLeafBytes, sizeof(K) + kValueBytes)};
+  /// <summary>
+  /// Maximum number of keys of an internal node, which has one more child.
+  /// </summary>
+  static constexpr size_t kInternalCapacity{BTreeNodeCapacity(
+      NodeBytes, kHeaderBytes + 2 * sizeof(void *),
+      sizeof(K) + sizeof(void *))};
+
+ private:
+  struct Node;
+  struct Leaf;
+  struct Internal;
+
+ public:
+  /// <summary>
+  /// Bidirectional iterator over the elements in key order. Map iterators
+  /// give a pair of references to the key and the value, set iterators give
+  /// a constant reference to the key.
+  /// </summary>
+  /// <typeparam name="Value"> type of values the iterator gives access
+  /// to, const qualified for a constant iterator.</typeparam>
+  template <typename Value>
+  class Iter {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::conditional_t<kIsSet, K, std::pair<K, V>>;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<kIsSet, const K &,
+                                         std::pair<const K &, Value &>>;
+    using pointer =
+        std::conditional_t<kIsSet, const K *, BTreeArrow<reference>>;
+
+    // Constructors
+    Iter() noexcept = default;
+    template <typename Other>
+      requires std::is_convertible_v<Other *, Value *>
+    Iter(const Iter<Other> &other) noexcept
+        : leaf(other.leaf), index(other.index), tree(other.tree) {}
+
+    // Access operators
+    reference operator*() const noexcept {
+      if constexpr (kIsSet) {
+        return leaf->Keys()[index];
+      } else {
+        return reference(leaf->Keys()[index], leaf->Values()[index]);
+      }
+    }
+    pointer operator->() const noexcept {
+      if constexpr (kIsSet) {
+        return leaf->Keys() + index;
+      } else {
+        return pointer{**this};
+      }
+    }
+
+    // Moving operators
+    Iter &operator++() noexcept {
+      if (++index == leaf->count) {
+        leaf = leaf->next;
+        index = 0;
+      }
+      return *this;
+    }
+    Iter operator++(int) noexcept {
+      Iter tmp{*this};
+      ++*this;
+      return tmp;
+    }
+    Iter &operator--() noexcept {
+      if (leaf == nullptr) {
+        leaf = tree->last_leaf;
+        index = leaf->count;
+      } else if (index == 0) {
+        leaf = leaf->previous;
+        index = leaf->count;
+      }
+      --index;
+      return *this;
+    }
+    Iter operator--(int) noexcept {
+      Iter tmp{*this};
+      --*this;
+      return tmp;
+    }
+
+    // Comparison operator, inequality is generated from it.
+    bool operator==(const Iter &other) const noexcept {
+      return leaf == other.leaf && index == other.index;
+    }
+
+   private:
+    friend class BTree;
+    template <typename Other>
+    friend class Iter;
+
+    Iter(Leaf *leaf, size_t index, const BTree *tree) noexcept
+        : leaf(leaf), index(index), tree(tree) {}
+
+    /// <summary>
+    /// Leaf holding the element, nullptr for the past the end iterator.
+    /// </summary>
+    Leaf *leaf{nullptr};
+    /// <summary>
+    /// Index of the element in the leaf.
+    /// </summary>
+    size_t index{0};
+    /// <summary>
+    /// Tree of the leaf, used to step back from the end.
+    /// </summary>
+    const BTree *tree{nullptr};
+  };
+
+  using Iterator = Iter<V>;
+  using ConstIterator = Iter<const V>;
+
+  /// <summary>
+  /// Pair of iterators delimiting the elements with keys in a given range,
+  /// usable in for-each style loops.
+  /// </summary>
+  template <typename It>
+  struct KeyRange {
+    It begin() const noexcept { return first; }
+    It end() const noexcept { return last; }
+
+    It first;
+    It last;
+  };
+
+  // Constructors, assignment operators and destructor.
+  BTree() noexcept = default;
+  explicit BTree(const Compare &compare,
+                 const Allocator &allocator = Allocator());
+  BTree(const BTree &other);
+  BTree(BTree &&other) noexcept;
+  BTree &operator=(const BTree &other);
+  BTree &operator=(BTree &&other) noexcept(
+      std::allocator_traits<Allocator>::propagate_on_container_move_assignment::
+          value ||
+      std::allocator_traits<Allocator>::is_always_equal::value);
+  ~BTree();
+
+  // Methods for finding elements.
+  Iterator Find(const K &key);
+  ConstIterator Find(const K &key) const;
+  bool Contains(const K &key) const;
+  Iterator LowerBound(const K &key);
+  ConstIterator LowerBound(const K &key) const;
+  Iterator UpperBound(const K &key);
+  ConstIterator UpperBound(const K &key) const;
+  KeyRange<Iterator> Range(const K &first, const K &last);
+  KeyRange<ConstIterator> Range(const K &first, const K &last) const;
+
+  // Methods for removing elements.
+  size_t Erase(const K &key);
+  void Clear() noexcept;
+
+  // Methods for size of the tree.
+  bool IsEmpty() const noexcept;
+  size_t Size() const noexcept;
+  size_t Height() const noexcept;
+
+  // Getting statistics of the tree.
+  ContainerStats GetStats() const noexcept;
+
+  // Iterators
+  Iterator begin() noexcept;
+  Iterator end() noexcept;
+  ConstIterator begin() const noexcept;
+  ConstIterator end() const noexcept;
+  ConstIterator cbegin() const noexcept;
+  ConstIterator cend() const noexcept;
+
+ protected:
+  // Methods used by the map and the set to insert elements.
+  std::pair<Iterator, bool> InsertUnique(K &&key, V &&value);
+  template <typename Source>
+  void Build(Source source, size_t count);
+  template <typename Element, typename KeyOf>
+  void CheckSorted(const Vector<Element> &sorted, KeyOf key_of) const;
+
+ private:
+  /// <summary>
+  /// Fields shared by leaves and internal nodes.
+  /// </summary>
+  struct Node {
+    size_t count{0};
+    bool is_leaf{true};
+  };
+
+  /// <summary>
+  /// Leaf holding elements, of which the first count are constructed.
+  /// </summary>
+  struct Leaf : Node {
+    K *Keys() noexcept {
+      return std::launder(reinterpret_cast<K *>(keys));
+    }
+    V *Values() noexcept { return values.Get(); }
+
+    Leaf *previous{nullptr};
+    Leaf *next{nullptr};
+    alignas(K) std::byte keys[(kLeafCapacity + 1) * sizeof(K)];
+    ALGLIB_NO_UNIQUE_ADDRESS BTreeLeafValues<V, kLeafCapacity + 1> values;
+  };
+
+  /// <summary>
+  /// Internal node holding count separators and count + 1 children.
+  /// </summary>
+  struct Internal : Node {
+    K *Keys() noexcept {
+      return std::launder(reinterpret_cast<K *>(keys));
+    }
+
+    alignas(K) std::byte keys[(kInternalCapacity + 1) * sizeof(K)];
+    Node *children[kInternalCapacity + 2];
+  };
+
+  /// <summary>
+  /// Source for Build that moves the elements out of the leaves of another
+  /// tree in key order.
+  /// </summary>
+  struct MovingSource {
+    decltype(auto) operator*() const noexcept {
+      if constexpr (kIsSet) {
+        return std::move(leaf->Keys()[index]);
+      } else {
+        return std::pair<K &&, V &&>(std::move(leaf->Keys()[index]),
+                                     std::move(leaf->Values()[index]));
+      }
+    }
+    MovingSource &operator++() noexcept {
+      if (++index == leaf->count) {
+        leaf = leaf->next;
+        index = 0;
+      }
+      return *this;
+    }
+
+    Leaf *leaf;
+    size_t index;
+  };
+
+  /// <summary>
+  /// Internal node visited on the way to a leaf and the index of the child
+  /// that was taken.
+  /// </summary>
+  struct PathEntry {
+    Internal *node;
+    size_t child;
+  };
+
+  // Height can't exceed the number of bits of a size, as every internal
+  // node has at least two children.
+  static constexpr size_t kMaxHeight{sizeof(size_t) * 8};
+  static constexpr size_t kMinLeafCount{kLeafCapacity / 2};
+  static constexpr size_t kMinInternalCount{(kInternalCapacity + 1) / 2 - 1};
+
+  using LeafAllocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Leaf>;
+  using LeafTraits = std::allocator_traits<LeafAllocator>;
+  using InternalAllocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Internal>;
+  using InternalTraits = std::allocator_traits<InternalAllocator>;
+
+  // Methods for searching inside nodes.
+  size_t LowerIndex(const K *keys, size_t count, const K &key) const;
+  size_t UpperIndex(const K *keys, size_t count, const K &key) const;
+  Leaf *Descend(const K &key, PathEntry *path) const;
+  Iterator Normalize(Leaf *leaf, size_t index) const noexcept;
+
+  // Methods for moving elements inside and between nodes.
+  template <typename T>
+  static void ShiftRight(T *data, size_t first, size_t last) noexcept;
+  template <typename T>
+  static void ShiftLeft(T *data, size_t first, size_t last) noexcept;
+  static void LeafInsert(Leaf *leaf, size_t index, K &&key, V &&value);
+  static void LeafErase(Leaf *leaf, size_t index) noexcept;
+  static void LeafMove(Leaf *from, size_t first, size_t count, Leaf *to,
+                       size_t at) noexcept;
+  static void InternalInsert(Internal *node, size_t index, K &&key,
+                             Node *right) noexcept;
+  static void InternalErase(Internal *node, size_t index) noexcept;
+
+  // Methods for restoring the shape of the tree.
+  void SplitLeaf(Leaf *leaf, Leaf *right) noexcept;
+  void InsertIntoParent(Node *left, K &&separator, Node *right,
+                        const PathEntry *path, size_t depth,
+                        Internal **spares) noexcept;
+  void FixLeaf(Leaf *leaf, const PathEntry *path, size_t depth);
+  void FixInternal(Internal *node, const PathEntry *path, size_t depth);
+
+  // Methods for managing memory of nodes.
+  Leaf *CreateLeaf();
+  Internal *CreateInternal();
+  void DestroyLeaf(Leaf *leaf) noexcept;
+  void DestroyInternal(Internal *node) noexcept;
+  void DestroySubtree(Node *node) noexcept;
+  void SwapNodes(BTree &other) noexcept;
+
+  /// <summary>
+  /// Root of the tree, nullptr for an empty tree.
+  /// </summary>
+  Node *root{nullptr};
+  /// <summary>
+  /// Leaf with the smallest keys.
+  /// </summary>
+  Leaf *first_leaf{nullptr};
+  /// <summary>
+  /// Leaf with the largest keys.
+  /// </summary>
+  Leaf *last_leaf{nullptr};
+  /// <summary>
+  /// Number of elements in the tree.
+  /// </summary>
+  size_t size{0};
+  /// <summary>
+  /// Number of levels of the tree, 0 for an empty one.
+  /// </summary>
+  size_t height{0};
+
+  /// <summary>
+  /// Ordering of keys.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS Compare compare;
+  /// <summary>
+  /// Allocator that provides memory for leaves.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS LeafAllocator leaf_allocator;
+  /// <summary>
+  /// Allocator that provides memory for internal nodes.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS InternalAllocator internal_allocator;
+  /// <summary>
+  /// Statistics of the tree, empty unless ALGLIB_ENABLE_STATS is defined.
+  /// They belong to the tree object and are not moved with its nodes.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS detail::StatsRecorder stats;
+};
+
+/// <summary>
+/// Constructor for an empty tree with a given ordering and allocator.
+/// </summary>
+/// <param name="compare"> ordering of keys.</param>
+/// <param name="allocator"> allocator used by the tree.</param>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+BTree<K, V, NodeBytes, Compare, Allocator>::BTree(const Compare &compare,
+                                                  const Allocator &allocator)
+    : compare(compare), leaf_allocator(allocator),
+      internal_allocator(allocator) {}
+
+/// <summary>
+/// Copy constructor. The copy is bulk loaded from the elements of the other
+/// tree in linear time, so its nodes are packed.
+/// </summary>
+/// <param name="other"> tree to be copied.</param>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+BTree<K, V, NodeBytes, Compare, Allocator>::BTree(const BTree &other)
+    : compare(other.compare),
+      leaf_allocator(LeafTraits::select_on_container_copy_construction(
+          other.leaf_allocator)),
+      internal_allocator(
+          InternalTraits::select_on_container_copy_construction(
+              other.internal_allocator)) {
+  Build(other.begin(), other.size);
+}
+
+/// <summary>
+/// Move constructor. Nodes of the other tree are taken over and the other
+/// tree is left empty.
+/// </summary>
+/// <param name="other"> tree to be moved.</param>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+BTree<K, V, NodeBytes, Compare, Allocator>::BTree(BTree &&other) noexcept
+    : root(std::exchange(other.root, nullptr)),
+      first_leaf(std::exchange(other.first_leaf, nullptr)),
+      last_leaf(std::exchange(other.last_leaf, nullptr)),
+      size(std::exchange(other.size, 0)),
+      height(std::exchange(other.height, 0)), compare(other.compare),
+      leaf_allocator(std::move(other.leaf_allocator)),
+      internal_allocator(std::move(other.internal_allocator)) {}
+
+/// <summary>
+/// Copy assignment operator. Elements of the other tree are copied into a
+/// new tree, so this one is unchanged if a copy throws. The allocator of the
+/// other tree is taken only if the allocator propagates on copy assignment.
+/// </summary>
+/// <param name="other"> tree to be copied.</param>
+/// <returns> reference to this tree.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+BTree<K, V, NodeBytes, Compare, Allocator> &
+BTree<K, V, NodeBytes, Compare, Allocator>::operator=(const BTree &other) {
+  if (this != &other) {
+    constexpr bool kPropagate{
+        LeafTraits::propagate_on_container_copy_assignment::value};
+    BTree copy(other.compare, kPropagate ? Allocator(other.leaf_allocator)
+                                         : Allocator(leaf_allocator));
+    copy.Build(other.begin(), other.size);
+    Clear();
+    SwapNodes(copy);
+    if constexpr (kPropagate) {
+      std::swap(leaf_allocator, copy.leaf_allocator);
+      std::swap(internal_allocator, copy.internal_allocator);
+    }
+    compare = other.compare;
+  }
+  return *this;
+}
+
+/// <summary>
+/// Move assignment operator. Elements of this tree are destroyed and the
+/// nodes of the other tree are taken over. If the allocator doesn't
+/// propagate and the allocators differ, nodes can't be shared and the
+/// elements are moved into new nodes instead.
+/// </summary>
+/// <param name="other"> tree to be moved.</param>
+/// <returns> reference to this tree.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+BTree<K, V, NodeBytes, Compare, Allocator> &
+BTree<K, V, NodeBytes, Compare, Allocator>::operator=(BTree &&other) noexcept(
+    std::allocator_traits<Allocator>::propagate_on_container_move_assignment::
+        value ||
+    std::allocator_traits<Allocator>::is_always_equal::value) {
+  if (this != &other) {
+    if constexpr (LeafTraits::propagate_on_container_move_assignment::value) {
+      Clear();
+      SwapNodes(other);
+      std::swap(leaf_allocator, other.leaf_allocator);
+      std::swap(internal_allocator, other.internal_allocator);
+    } else {
+      if (leaf_allocator == other.leaf_allocator) {
+        Clear();
+        SwapNodes(other);
+      } else {
+        Build(MovingSource{other.first_leaf, 0}, other.size);
+      }
+    }
+    compare = other.compare;
+  }
+  return *this;
+}
+
+/// <summary>
+/// Destroys all elements and returns the nodes to the allocator.
+/// </summary>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+BTree<K, V, NodeBytes, Compare, Allocator>::~BTree() {
+  Clear();
+}
+
+/// <summary>
+/// Finds the element with a given key.
+/// </summary>
+/// <param name="key"> key to be found.</param>
+/// <returns> iterator to the element or end() if there is none.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+typename BTree<K, V, NodeBytes, Compare, Allocator>::Iterator
+BTree<K, V, NodeBytes, Compare, Allocator>::Find(const K &key) {
+  const Iterator found{LowerBound(key)};
+  if (found.leaf != nullptr && !compare(key, found.leaf->Keys()[found.index]))
+    return found;
+  return end();
+}
+
+/// <summary>
+/// Finds the element with a given key.
+/// </summary>
+/// <param name="key"> key to be found.</param>
+/// <returns> iterator to the element or end() if there is none.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+typename BTree<K, V, NodeBytes, Compare, Allocator>::ConstIterator
+BTree<K, V, NodeBytes, Compare, Allocator>::Find(const K &key) const {
+  return const_cast<BTree *>(this)->Find(key);
+}
+
+/// <summary>
+/// Checks if the tree has an element with a given key.
+/// </summary>
+/// <param name="key"> key to be found.</param>
+/// <returns> true if the key is in the tree, false if not.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+bool BTree<K, V, NodeBytes, Compare, Allocator>::Contains(
+    const K &key) const {
+  return Find(key) != end();
+}
+
+/// <summary>
+/// Finds the first element with a key not smaller than a given one.
+/// </summary>
+/// <param name="key"> key to be compared with.</param>
+/// <returns> iterator to the element or end() if there is none.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+typename BTree<K, V, NodeBytes, Compare, Allocator>::Iterator
+BTree<K, V, NodeBytes, Compare, Allocator>::LowerBound(const K &key) {
+  if (root == nullptr) return end();
+  Leaf *leaf{Descend(key, nullptr)};
+  return Normalize(leaf, LowerIndex(leaf->Keys(), leaf->count, key));
+}
+
+/// <summary>
+/// Finds the first element with a key not smaller than a given one.
+/// </summary>
+/// <param name="key"> key to be compared with.</param>
+/// <returns> iterator to the element or end() if there is none.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+typename BTree<K, V, NodeBytes, Compare, Allocator>::ConstIterator
+BTree<K, V, NodeBytes, Compare, Allocator>::LowerBound(const K &key) const {
+  return const_cast<BTree *>(this)->LowerBound(key);
+}
+
+/// <summary>
+/// Finds the first element with a key greater than a given one.
+/// </summary>
+/// <param name="key"> key to be compared with.</param>
+/// <returns> iterator to the element or end() if there is none.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+typename BTree<K, V, NodeBytes, Compare, Allocator>::Iterator
+BTree<K, V, NodeBytes, Compare, Allocator>::UpperBound(const K &key) {
+  if (root == nullptr) return end();
+  Leaf *leaf{Descend(key, nullptr)};
+  return Normalize(leaf, UpperIndex(leaf->Keys(), leaf->count, key));
+}
+
+/// <summary>
+/// Finds the first element with a key greater than a given one.
+/// </summary>
+/// <param name="key"> key to be compared with.</param>
+/// <returns> iterator to the element or end() if there is none.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+typename BTree<K, V, NodeBytes, Compare, Allocator>::ConstIterator
+BTree<K, V, NodeBytes, Compare, Allocator>::UpperBound(const K &key) const {
+  return const_cast<BTree *>(this)->UpperBound(key);
+}
+
+/// <summary>
+/// Gets the elements with keys from first, inclusive, to last, exclusive.
+/// Both ends are found with one descent each, and the elements between
+/// them are visited by walking the linked leaves.
+/// </summary>
+/// <param name="first"> smallest key of the range.</param>
+/// <param name="last"> key past the range.</param>
+/// <returns> range of elements, empty if last is not greater than
+/// first.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+typename BTree<K, V, NodeBytes, Compare,
+               Allocator>::template KeyRange<typename BTree<
+    K, V, NodeBytes, Compare, Allocator>::Iterator>
+BTree<K, V, NodeBytes, Compare, Allocator>::Range(const K &first,
+                                                  const K &last) {
+  const Iterator begin_it{LowerBound(first)};
+  if (!compare(first, last)) return {begin_it, begin_it};
+  return {begin_it, LowerBound(last)};
+}
+
+/// <summary>
+/// Gets the elements with keys from first, inclusive, to last, exclusive.
+/// </summary>
+/// <param name="first"> smallest key of the range.</param>
+/// <param name="last"> key past the range.</param>
+/// <returns> range of elements, empty if last is not greater than
+/// first.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+typename BTree<K, V, NodeBytes, Compare,
+               Allocator>::template KeyRange<typename BTree<
+    K, V, NodeBytes, Compare, Allocator>::ConstIterator>
+BTree<K, V, NodeBytes, Compare, Allocator>::Range(const K &first,
+                                                  const K &last) const {
+  const auto range{const_cast<BTree *>(this)->Range(first, last)};
+  return {range.first, range.last};
+}
+
+/// <summary>
+/// Removes the element with a given key. A leaf left less than half full
+/// borrows an element from a sibling or is merged with it, which may
+/// continue up the tree.
+/// </summary>
+/// <param name="key"> key of the element.</param>
+/// <returns> number of removed elements, 0 or 1.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+size_t BTree<K, V, NodeBytes, Compare, Allocator>::Erase(const K &key) {
+  if (root == nullptr) return 0;
+  std::array<PathEntry, kMaxHeight> path;
+  Leaf *leaf{Descend(key, path.data())};
+  const size_t index{LowerIndex(leaf->Keys(), leaf->count, key)};
+  if (index == leaf->count || compare(key, leaf->Keys()[index])) return 0;
+  LeafErase(leaf, index);
+  --size;
+  FixLeaf(leaf, path.data(), height - 1);
+  return 1;
+}
+
+/// <summary>
+/// Removes all elements and returns all nodes to the allocator.
+/// </summary>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+void BTree<K, V, NodeBytes, Compare, Allocator>::Clear() noexcept {
+  if (root != nullptr) DestroySubtree(root);
+  root = nullptr;
+  first_leaf = nullptr;
+  last_leaf = nullptr;
+  size = 0;
+  height = 0;
+}
+
+/// <summary>
+/// Checks if the tree is empty.
+/// </summary>
+/// <returns> true if empty, false if not.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+bool BTree<K, V, NodeBytes, Compare, Allocator>::IsEmpty() const noexcept {
+  return size == 0;
+}
+
+/// <summary>
+/// Gets the number of elements in the tree.
+/// </summary>
+/// <returns> number of elements.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+size_t BTree<K, V, NodeBytes, Compare, Allocator>::Size() const noexcept {
+  return size;
+}
+
+/// <summary>
+/// Gets the number of levels of the tree, which is the number of nodes read
+/// by a lookup.
+/// </summary>
+/// <returns> number of levels, 0 for an empty tree.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+size_t BTree<K, V, NodeBytes, Compare, Allocator>::Height() const noexcept {
+  return height;
+}
+
+/// <summary>
+/// Gets statistics of the tree. It records allocated and released leaves
+/// and internal nodes and the biggest size. Elements moved between nodes
+/// when they split or merge are not counted. Without ALGLIB_ENABLE_STATS
+/// all counters are zero.
+/// </summary>
+/// <returns> statistics of the tree.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+ContainerStats BTree<K, V, NodeBytes, Compare, Allocator>::GetStats()
+    const noexcept {
+  return stats.Get();
+}
+
+/// <summary>
+/// Returns iterator to the element with the smallest key.
+/// </summary>
+/// <returns> iterator to the first element.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+typename BTree<K, V, NodeBytes, Compare, Allocator>::Iterator
+BTree<K, V, NodeBytes, Compare, Allocator>::begin() noexcept {
+  return Iterator(first_leaf, 0, this);
+}
+
+/// <summary>
+/// Returns iterator past the element with the largest key.
+/// </summary>
+/// <returns> iterator past the last element.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+typename BTree<K, V, NodeBytes, Compare, Allocator>::Iterator
+BTree<K, V, NodeBytes, Compare, Allocator>::end() noexcept {
+  return Iterator(nullptr, 0, this);
+}
+
+/// <summary>
+/// Returns constant iterator to the element with the smallest key.
+/// </summary>
+/// <returns> iterator to the first element.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+typename BTree<K, V, NodeBytes, Compare, Allocator>::ConstIterator
+BTree<K, V, NodeBytes, Compare, Allocator>::begin() const noexcept {
+  return ConstIterator(first_leaf, 0, this);
+}
+
+/// <summary>
+/// Returns constant iterator past the element with the largest key.
+/// </summary>
+/// <returns> iterator past the last element.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+typename BTree<K, V, NodeBytes, Compare, Allocator>::ConstIterator
+BTree<K, V, NodeBytes, Compare, Allocator>::end() const noexcept {
+  return ConstIterator(nullptr, 0, this);
+}
+
+/// <summary>
+/// Returns constant iterator to the element with the smallest key.
+/// </summary>
+/// <returns> iterator to the first element.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+typename BTree<K, V, NodeBytes, Compare, Allocator>::ConstIterator
+BTree<K, V, NodeBytes, Compare, Allocator>::cbegin() const noexcept {
+  return begin();
+}
+
+/// <summary>
+/// Returns constant iterator past the element with the largest key.
+/// </summary>
+/// <returns> iterator past the last element.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+typename BTree<K, V, NodeBytes, Compare, Allocator>::ConstIterator
+BTree<K, V, NodeBytes, Compare, Allocator>::cend() const noexcept {
+  return end();
+}
+
+/// <summary>
+/// Inserts an element unless its key is already in the tree. A full leaf
+/// is split in half and its parent gets a separator, which may split the
+/// parents up to the root. All nodes and the separator are obtained before
+/// anything changes, so the tree is unchanged if that throws.
+/// </summary>
+/// <param name="key"> key of the element.</param>
+/// <param name="value"> value of the element.</param>
+/// <returns> iterator to the element with the key and true if the element
+/// was inserted.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+std::pair<typename BTree<K, V, NodeBytes, Compare, Allocator>::Iterator,
+          bool>
+BTree<K, V, NodeBytes, Compare, Allocator>::InsertUnique(K &&key,
+                                                         V &&value) {
+  if (root == nullptr) {
+    Leaf *leaf{CreateLeaf()};
+    ALGLIB_TRY { LeafInsert(leaf, 0, std::move(key), std::move(value)); }
+    ALGLIB_CATCH_ALL {
+      DestroyLeaf(leaf);
+      ALGLIB_RETHROW;
+    }
+    root = first_leaf = last_leaf = leaf;
+    height = 1;
+    size = 1;
+    stats.Size(size);
+    return {Iterator(leaf, 0, this), true};
+  }
+  std::array<PathEntry, kMaxHeight> path;
+  Leaf *leaf{Descend(key, path.data())};
+  const size_t index{LowerIndex(leaf->Keys(), leaf->count, key)};
+  if (index < leaf->count && !compare(key, leaf->Keys()[index])) {
+    return {Iterator(leaf, index, this), false};
+  }
+  if (leaf->count < kLeafCapacity) {
+    LeafInsert(leaf, index, std::move(key), std::move(value));
+    ++size;
+    stats.Size(size);
+    return {Iterator(leaf, index, this), true};
+  }
+  // Every full parent splits too, and a new root is needed when all of
+  // them are full.
+  size_t depth{height - 1};
+  while (depth > 0 && path[depth - 1].node->count == kInternalCapacity) {
+    --depth;
+  }
+  const size_t spare_count{height - 1 - depth + (depth == 0 ? 1 : 0)};
+  std::array<Internal *, kMaxHeight> spares{};
+  size_t created{};
+  Leaf *right{nullptr};
+  // The separator is a copy of the key that becomes the first one of the
+  // right half.
+  constexpr size_t keep{(kLeafCapacity + 1) / 2};
+  std::optional<K> separator;
+  ALGLIB_TRY {
+    right = CreateLeaf();
+    for (; created < spare_count; ++created) {
+      spares[created] = CreateInternal();
+    }
+    separator.emplace(index == keep
+                          ? key
+                          : leaf->Keys()[index < keep ? keep - 1 : keep]);
+    LeafInsert(leaf, index, std::move(key), std::move(value));
+  }
+  ALGLIB_CATCH_ALL {
+    if (right != nullptr) DestroyLeaf(right);
+    for (size_t i{}; i < created; ++i) DestroyInternal(spares[i]);
+    ALGLIB_RETHROW;
+  }
+  ++size;
+  stats.Size(size);
+  SplitLeaf(leaf, right);
+  InsertIntoParent(leaf, std::move(*separator), right, path.data(),
+                   height - 1, spares.data());
+  if (index >= keep) return {Iterator(right, index - keep, this), true};
+  return {Iterator(leaf, index, this), true};
+}
+
+/// <summary>
+/// Replaces the elements with ones read in key order from a source, in
+/// linear time. Elements are spread evenly over as few leaves as possible,
+/// and each level of internal nodes is built over the one below it, with
+/// the smallest key of every child but the first as separators. The tree
+/// is unchanged if a copy throws.
+/// </summary>
+/// <param name="source"> iterator to the first element, giving keys for
+/// sets and pairs of a key and a value for maps.</param>
+/// <param name="count"> number of elements.</param>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+template <typename Source>
+void BTree<K, V, NodeBytes, Compare, Allocator>::Build(Source source,
+                                                       size_t count) {
+  if (count == 0) {
+    Clear();
+    return;
+  }
+  Vector<Node *> level;
+  Vector<const K *> smallest;
+  Vector<Internal *> internals;
+  Leaf *first{nullptr};
+  Leaf *last{nullptr};
+  size_t levels{1};
+  ALGLIB_TRY {
+    const size_t leaves{(count + kLeafCapacity - 1) / kLeafCapacity};
+    level.Reserve(leaves);
+    smallest.Reserve(leaves);
+    // Every internal node is recorded as soon as it is created, so that it
+    // is released if a later copy throws; the push must not throw then.
+    size_t internal_count{};
+    for (size_t nodes{leaves}; nodes > 1;) {
+      nodes = (nodes + kInternalCapacity) / (kInternalCapacity + 1);
+      internal_count += nodes;
+    }
+    internals.Reserve(internal_count);
+    for (size_t i{}; i < leaves; ++i) {
+      Leaf *leaf{CreateLeaf()};
+      leaf->previous = last;
+      (last != nullptr ? last->next : first) = leaf;
+      last = leaf;
+      const size_t elements{count / leaves + (i < count % leaves ? 1 : 0)};
+      for (size_t j{}; j < elements; ++j, ++source) {
+        if constexpr (kIsSet) {
+          std::construct_at(leaf->Keys() + j, *source);
+        } else {
+          std::construct_at(leaf->Keys() + j, std::get<0>(*source));
+          ALGLIB_TRY {
+            std::construct_at(leaf->Values() + j, std::get<1>(*source));
+          }
+          ALGLIB_CATCH_ALL {
+            std::destroy_at(leaf->Keys() + j);
+            ALGLIB_RETHROW;
+          }
+        }
+        ++leaf->count;
+      }
+      level.Push(leaf);
+      smallest.Push(leaf->Keys());
+    }
+    while (level.Size() > 1) {
+      const size_t children{level.Size()};
+      const auto below{level.AsSpan()};
+      const auto below_smallest{smallest.AsSpan()};
+      const size_t nodes{(children + kInternalCapacity) /
+                         (kInternalCapacity + 1)};
+      Vector<Node *> parents;
+      Vector<const K *> parent_smallest;
+      parents.Reserve(nodes);
+      parent_smallest.Reserve(nodes);
+      for (size_t i{}, child{}; i < nodes; ++i) {
+        Internal *node{CreateInternal()};
+        internals.Push(node);
+        const size_t taken{children / nodes + (i < children % nodes ? 1 : 0)};
+        node->children[0] = below[child];
+        for (size_t j{1}; j < taken; ++j) {
+          std::construct_at(node->Keys() + j - 1, *below_smallest[child + j]);
+          node->children[j] = below[child + j];
+          ++node->count;
+        }
+        parents.Push(node);
+        parent_smallest.Push(below_smallest[child]);
+        child += taken;
+      }
+      level = std::move(parents);
+      smallest = std::move(parent_smallest);
+      ++levels;
+    }
+  }
+  ALGLIB_CATCH_ALL {
+    while (first != nullptr) {
+      Leaf *next{first->next};
+      DestroyLeaf(first);
+      first = next;
+    }
+    for (Internal *node : internals) DestroyInternal(node);
+    ALGLIB_RETHROW;
+  }
+  Clear();
+  root = level.At(0);
+  first_leaf = first;
+  last_leaf = last;
+  size = count;
+  height = levels;
+  stats.Size(size);
+}
+
+/// <summary>
+/// Checks that elements of a vector are sorted by strictly increasing key.
+/// </summary>
+/// <param name="sorted"> elements to be checked.</param>
+/// <param name="key_of"> function returning the key of an element.</param>
+/// <exception cref="std::runtime_error"> thrown when two neighbouring
+/// keys are not in increasing order.</exception>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+template <typename Element, typename KeyOf>
+void BTree<K, V, NodeBytes, Compare, Allocator>::CheckSorted(
+    const Vector<Element> &sorted, KeyOf key_of) const {
+  const auto elements{sorted.AsSpan()};
+  for (size_t i{1}; i < elements.size(); ++i) {
+    if (!compare(key_of(elements[i - 1]), key_of(elements[i]))) {
+      ALGLIB_THROW(std::runtime_error(errors::kUnsortedInput));
+    }
+  }
+}
+
+/// <summary>
+/// Finds the first key of a node that is not smaller than a given one.
+/// </summary>
+/// <param name="keys"> sorted keys of the node.</param>
+/// <param name="count"> number of keys.</param>
+/// <param name="key"> key to be compared with.</param>
+/// <returns> index of the key or count if there is none.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+size_t BTree<K, V, NodeBytes, Compare, Allocator>::LowerIndex(
+    const K *keys, size_t count, const K &key) const {
+  return static_cast<size_t>(
+      std::lower_bound(keys, keys + count, key, compare) - keys);
+}
+
+/// <summary>
+/// Finds the first key of a node that is greater than a given one.
+/// </summary>
+/// <param name="keys"> sorted keys of the node.</param>
+/// <param name="count"> number of keys.</param>
+/// <param name="key"> key to be compared with.</param>
+/// <returns> index of the key or count if there is none.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+size_t BTree<K, V, NodeBytes, Compare, Allocator>::UpperIndex(
+    const K *keys, size_t count, const K &key) const {
+  return static_cast<size_t>(
+      std::upper_bound(keys, keys + count, key, compare) - keys);
+}
+
+/// <summary>
+/// Walks from the root to the leaf that may hold a key. The tree must not
+/// be empty.
+/// </summary>
+/// <param name="key"> key to be found.</param>
+/// <param name="path"> array filled with visited internal nodes and taken
+/// children, from the root down, or nullptr.</param>
+/// <returns> leaf that may hold the key.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+typename BTree<K, V, NodeBytes, Compare, Allocator>::Leaf *
+BTree<K, V, NodeBytes, Compare, Allocator>::Descend(const K &key,
+                                                    PathEntry *path) const {
+  Node *node{root};
+  for (size_t depth{}; !node->is_leaf; ++depth) {
+    Internal *internal{static_cast<Internal *>(node)};
+    const size_t child{UpperIndex(internal->Keys(), internal->count, key)};
+    if (path != nullptr) path[depth] = {internal, child};
+    node = internal->children[child];
+  }
+  return static_cast<Leaf *>(node);
+}
+
+/// <summary>
+/// Makes an iterator to a position in a leaf, moving to the next leaf when
+/// the position is past the last element.
+/// </summary>
+/// <param name="leaf"> leaf of the position.</param>
+/// <param name="index"> index in the leaf, at most the number of its
+/// elements.</param>
+/// <returns> iterator to the element at the position.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+typename BTree<K, V, NodeBytes, Compare, Allocator>::Iterator
+BTree<K, V, NodeBytes, Compare, Allocator>::Normalize(
+    Leaf *leaf, size_t index) const noexcept {
+  if (index == leaf->count) return Iterator(leaf->next, 0, this);
+  return Iterator(leaf, index, this);
+}
+
+/// <summary>
+/// Moves the objects of a range one position to the right. The position
+/// after the range must be free, and the first one is free afterwards.
+/// </summary>
+/// <param name="data"> array of objects.</param>
+/// <param name="first"> index of the first object.</param>
+/// <param name="last"> index past the last object.</param>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+template <typename T>
+void BTree<K, V, NodeBytes, Compare, Allocator>::ShiftRight(
+    T *data, size_t first, size_t last) noexcept {
+  for (size_t i{last}; i > first; --i) {
+    std::construct_at(data + i, std::move(data[i - 1]));
+    std::destroy_at(data + i - 1);
+  }
+}
+
+/// <summary>
+/// Moves the objects of a range one position to the left. The position
+/// before the range must be free, and the last one is free afterwards.
+/// </summary>
+/// <param name="data"> array of objects.</param>
+/// <param name="first"> index of the first object.</param>
+/// <param name="last"> index past the last object.</param>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+template <typename T>
+void BTree<K, V, NodeBytes, Compare, Allocator>::ShiftLeft(
+    T *data, size_t first, size_t last) noexcept {
+  for (size_t i{first}; i < last; ++i) {
+    std::construct_at(data + i - 1, std::move(data[i]));
+    std::destroy_at(data + i);
+  }
+}
+
+/// <summary>
+/// Inserts an element at a given index of a leaf. The leaf may use its
+/// spare slot.
+/// </summary>
+/// <param name="leaf"> leaf with room for the element.</param>
+/// <param name="index"> index of the new element.</param>
+/// <param name="key"> key of the element.</param>
+/// <param name="value"> value of the element.</param>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+void BTree<K, V, NodeBytes, Compare, Allocator>::LeafInsert(Leaf *leaf,
+                                                            size_t index,
+                                                            K &&key,
+                                                            V &&value) {
+  ShiftRight(leaf->Keys(), index, leaf->count);
+  std::construct_at(leaf->Keys() + index, std::move(key));
+  if constexpr (!kIsSet) {
+    ShiftRight(leaf->Values(), index, leaf->count);
+    std::construct_at(leaf->Values() + index, std::move(value));
+  }
+  ++leaf->count;
+}
+
+/// <summary>
+/// Removes the element at a given index of a leaf.
+/// </summary>
+/// <param name="leaf"> leaf of the element.</param>
+/// <param name="index"> index of the element.</param>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+void BTree<K, V, NodeBytes, Compare, Allocator>::LeafErase(
+    Leaf *leaf, size_t index) noexcept {
+  std::destroy_at(leaf->Keys() + index);
+  ShiftLeft(leaf->Keys(), index + 1, leaf->count);
+  if constexpr (!kIsSet) {
+    std::destroy_at(leaf->Values() + index);
+    ShiftLeft(leaf->Values(), index + 1, leaf->count);
+  }
+  --leaf->count;
+}
+
+/// <summary>
+/// Moves consecutive elements from one leaf to a position in another one.
+/// </summary>
+/// <param name="from"> leaf the elements are taken from.</param>
+/// <param name="first"> index of the first moved element.</param>
+/// <param name="count"> number of moved elements.</param>
+/// <param name="to"> leaf the elements are moved to.</param>
+/// <param name="at"> index of the first moved element in the target
+/// leaf.</param>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+void BTree<K, V, NodeBytes, Compare, Allocator>::LeafMove(
+    Leaf *from, size_t first, size_t count, Leaf *to, size_t at) noexcept {
+  auto move = [&](auto *source, auto *target) {
+    for (size_t i{to->count}; i > at; --i) {
+      std::construct_at(target + i - 1 + count, std::move(target[i - 1]));
+      std::destroy_at(target + i - 1);
+    }
+    for (size_t i{}; i < count; ++i) {
+      std::construct_at(target + at + i, std::move(source[first + i]));
+      std::destroy_at(source + first + i);
+    }
+    for (size_t i{first + count}; i < from->count; ++i) {
+      std::construct_at(source + i - count, std::move(source[i]));
+      std::destroy_at(source + i);
+    }
+  };
+  move(from->Keys(), to->Keys());
+  if constexpr (!kIsSet) move(from->Values(), to->Values());
+  from->count -= count;
+  to->count += count;
+}
+
+/// <summary>
+/// Inserts a separator and the child to its right into an internal node.
+/// The node may use its spare slot.
+/// </summary>
+/// <param name="node"> internal node with room for the separator.</param>
+/// <param name="index"> index of the separator.</param>
+/// <param name="key"> separator.</param>
+/// <param name="right"> child with keys not smaller than the
+/// separator.</param>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+void BTree<K, V, NodeBytes, Compare, Allocator>::InternalInsert(
+    Internal *node, size_t index, K &&key, Node *right) noexcept {
+  ShiftRight(node->Keys(), index, node->count);
+  std::construct_at(node->Keys() + index, std::move(key));
+  std::copy_backward(node->children + index + 1,
+                     node->children + node->count + 1,
+                     node->children + node->count + 2);
+  node->children[index + 1] = right;
+  ++node->count;
+}
+
+/// <summary>
+/// Removes a separator and the child to its right from an internal node.
+/// </summary>
+/// <param name="node"> internal node.</param>
+/// <param name="index"> index of the separator.</param>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+void BTree<K, V, NodeBytes, Compare, Allocator>::InternalErase(
+    Internal *node, size_t index) noexcept {
+  std::destroy_at(node->Keys() + index);
+  ShiftLeft(node->Keys(), index + 1, node->count);
+  std::copy(node->children + index + 2, node->children + node->count + 1,
+            node->children + index + 1);
+  --node->count;
+}
+
+/// <summary>
+/// Splits an overfull leaf, moving its upper half to a new leaf linked
+/// after it.
+/// </summary>
+/// <param name="leaf"> leaf using its spare slot.</param>
+/// <param name="right"> empty leaf.</param>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+void BTree<K, V, NodeBytes, Compare, Allocator>::SplitLeaf(
+    Leaf *leaf, Leaf *right) noexcept {
+  constexpr size_t keep{(kLeafCapacity + 1) / 2};
+  LeafMove(leaf, keep, leaf->count - keep, right, 0);
+  right->previous = leaf;
+  right->next = leaf->next;
+  (leaf->next != nullptr ? leaf->next->previous : last_leaf) = right;
+  leaf->next = right;
+}
+
+/// <summary>
+/// Adds a new right sibling of a node to the parent of the node. Parents
+/// that overflow send their middle separator further up, and a new root is
+/// made when the root splits. Nodes needed for that are taken from
+/// spares, which were allocated up front.
+/// </summary>
+/// <param name="left"> node that was split.</param>
+/// <param name="separator"> smallest key of the new node.</param>
+/// <param name="right"> new node.</param>
+/// <param name="path"> path that was taken to the node.</param>
+/// <param name="depth"> level of the node, 0 for the root.</param>
+/// <param name="spares"> empty internal nodes, one per split parent and
+/// one for a new root.</param>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+void BTree<K, V, NodeBytes, Compare, Allocator>::InsertIntoParent(
+    Node *left, K &&separator, Node *right, const PathEntry *path,
+    size_t depth, Internal **spares) noexcept {
+  for (;; --depth) {
+    if (depth == 0) {
+      Internal *new_root{*spares};
+      std::construct_at(new_root->Keys(), std::move(separator));
+      new_root->children[0] = left;
+      new_root->children[1] = right;
+      new_root->count = 1;
+      root = new_root;
+      ++height;
+      return;
+    }
+    Internal *parent{path[depth - 1].node};
+    InternalInsert(parent, path[depth - 1].child, std::move(separator),
+                   right);
+    if (parent->count <= kInternalCapacity) return;
+    // The middle separator moves up, the ones after it go to the sibling.
+    constexpr size_t middle{(kInternalCapacity + 1) / 2};
+    Internal *sibling{*spares++};
+    K *keys{parent->Keys()};
+    for (size_t i{middle + 1}; i < parent->count; ++i) {
+      std::construct_at(sibling->Keys() + i - middle - 1, std::move(keys[i]));
+      std::destroy_at(keys + i);
+    }
+    std::copy(parent->children + middle + 1,
+              parent->children + parent->count + 1, sibling->children);
+    sibling->count = parent->count - middle - 1;
+    separator = std::move(keys[middle]);
+    std::destroy_at(keys + middle);
+    parent->count = middle;
+    left = parent;
+    right = sibling;
+  }
+}
+
+/// <summary>
+/// Restores the minimum size of a leaf after an element was erased from it.
+/// The leaf takes an element from a sibling that has more than the minimum,
+/// or is merged with a sibling, which removes a separator from the parent.
+/// An empty root leaf is released.
+/// </summary>
+/// <param name="leaf"> leaf an element was erased from.</param>
+/// <param name="path"> path that was taken to the leaf.</param>
+/// <param name="depth"> level of the leaf, 0 for the root.</param>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+void BTree<K, V, NodeBytes, Compare, Allocator>::FixLeaf(
+    Leaf *leaf, const PathEntry *path, size_t depth) {
+  if (depth == 0) {
+    if (leaf->count == 0) Clear();
+    return;
+  }
+  if (leaf->count >= kMinLeafCount) return;
+  auto [parent, child] = path[depth - 1];
+  Leaf *left{child > 0 ? static_cast<Leaf *>(parent->children[child - 1])
+                       : nullptr};
+  Leaf *right{child < parent->count
+                  ? static_cast<Leaf *>(parent->children[child + 1])
+                  : nullptr};
+  if (left != nullptr && left->count > kMinLeafCount) {
+    LeafMove(left, left->count - 1, 1, leaf, 0);
+    parent->Keys()[child - 1] = leaf->Keys()[0];
+    return;
+  }
+  if (right != nullptr && right->count > kMinLeafCount) {
+    LeafMove(right, 0, 1, leaf, leaf->count);
+    parent->Keys()[child] = right->Keys()[0];
+    return;
+  }
+  // Neither sibling can spare an element, so two leaves become one and the
+  // one on the right is released.
+  if (left == nullptr) {
+    left = leaf;
+  } else {
+    right = leaf;
+    --child;
+  }
+  LeafMove(right, 0, right->count, left, left->count);
+  left->next = right->next;
+  (right->next != nullptr ? right->next->previous : last_leaf) = left;
+  InternalErase(parent, child);
+  DestroyLeaf(right);
+  FixInternal(parent, path, depth - 1);
+}
+
+/// <summary>
+/// Restores the minimum size of an internal node after a separator was
+/// removed from it, by rotating a separator through the parent from a
+/// sibling or merging with a sibling. A root left without separators is
+/// replaced by its only child.
+/// </summary>
+/// <param name="node"> internal node a separator was removed from.</param>
+/// <param name="path"> path that was taken to the node.</param>
+/// <param name="depth"> level of the node, 0 for the root.</param>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+void BTree<K, V, NodeBytes, Compare, Allocator>::FixInternal(
+    Internal *node, const PathEntry *path, size_t depth) {
+  if (depth == 0) {
+    if (node->count == 0) {
+      root = node->children[0];
+      DestroyInternal(node);
+      --height;
+    }
+    return;
+  }
+  if (node->count >= kMinInternalCount) return;
+  auto [parent, child] = path[depth - 1];
+  Internal *left{child > 0
+                     ? static_cast<Internal *>(parent->children[child - 1])
+                     : nullptr};
+  Internal *right{child < parent->count
+                      ? static_cast<Internal *>(parent->children[child + 1])
+                      : nullptr};
+  K *separators{parent->Keys()};
+  if (left != nullptr && left->count > kMinInternalCount) {
+    ShiftRight(node->Keys(), 0, node->count);
+    std::construct_at(node->Keys(), std::move(separators[child - 1]));
+    std::copy_backward(node->children, node->children + node->count + 1,
+                       node->children + node->count + 2);
+    node->children[0] = left->children[left->count];
+    ++node->count;
+    separators[child - 1] = std::move(left->Keys()[left->count - 1]);
+    std::destroy_at(left->Keys() + left->count - 1);
+    --left->count;
+    return;
+  }
+  if (right != nullptr && right->count > kMinInternalCount) {
+    std::construct_at(node->Keys() + node->count,
+                      std::move(separators[child]));
+    node->children[node->count + 1] = right->children[0];
+    ++node->count;
+    separators[child] = std::move(right->Keys()[0]);
+    std::destroy_at(right->Keys());
+    ShiftLeft(right->Keys(), 1, right->count);
+    std::copy(right->children + 1, right->children + right->count + 1,
+              right->children);
+    --right->count;
+    return;
+  }
+  // Two nodes and the separator between them become one node, and the one
+  // on the right is released.
+  if (left == nullptr) {
+    left = node;
+  } else {
+    right = node;
+    --child;
+  }
+  std::construct_at(left->Keys() + left->count, std::move(separators[child]));
+  for (size_t i{}; i < right->count; ++i) {
+    std::construct_at(left->Keys() + left->count + 1 + i,
+                      std::move(right->Keys()[i]));
+    std::destroy_at(right->Keys() + i);
+  }
+  std::copy(right->children, right->children + right->count + 1,
+            left->children + left->count + 1);
+  left->count += right->count + 1;
+  right->count = 0;
+  InternalErase(parent, child);
+  DestroyInternal(right);
+  FixInternal(parent, path, depth - 1);
+}
+
+/// <summary>
+/// Allocates an empty leaf.
+/// </summary>
+/// <returns> pointer to the leaf.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+typename BTree<K, V, NodeBytes, Compare, Allocator>::Leaf *
+BTree<K, V, NodeBytes, Compare, Allocator>::CreateLeaf() {
+  Leaf *leaf{LeafTraits::allocate(leaf_allocator, 1)};
+  LeafTraits::construct(leaf_allocator, leaf);
+  stats.Allocation();
+  return leaf;
+}
+
+/// <summary>
+/// Allocates an empty internal node.
+/// </summary>
+/// <returns> pointer to the node.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+typename BTree<K, V, NodeBytes, Compare, Allocator>::Internal *
+BTree<K, V, NodeBytes, Compare, Allocator>::CreateInternal() {
+  Internal *node{InternalTraits::allocate(internal_allocator, 1)};
+  InternalTraits::construct(internal_allocator, node);
+  node->is_leaf = false;
+  stats.Allocation();
+  return node;
+}
+
+/// <summary>
+/// Destroys the elements of a leaf and returns it to the allocator.
+/// </summary>
+/// <param name="leaf"> leaf to be released.</param>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+void BTree<K, V, NodeBytes, Compare, Allocator>::DestroyLeaf(
+    Leaf *leaf) noexcept {
+  std::destroy_n(leaf->Keys(), leaf->count);
+  if constexpr (!kIsSet) std::destroy_n(leaf->Values(), leaf->count);
+  LeafTraits::destroy(leaf_allocator, leaf);
+  LeafTraits::deallocate(leaf_allocator, leaf, 1);
+  stats.Deallocation();
+}
+
+/// <summary>
+/// Destroys the separators of an internal node and returns it to the
+/// allocator. Children are not released.
+/// </summary>
+/// <param name="node"> internal node to be released.</param>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+void BTree<K, V, NodeBytes, Compare, Allocator>::DestroyInternal(
+    Internal *node) noexcept {
+  std::destroy_n(node->Keys(), node->count);
+  InternalTraits::destroy(internal_allocator, node);
+  InternalTraits::deallocate(internal_allocator, node, 1);
+  stats.Deallocation();
+}
+
+/// <summary>
+/// Releases a node and all nodes below it.
+/// </summary>
+/// <param name="node"> root of the subtree.</param>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+void BTree<K, V, NodeBytes, Compare, Allocator>::DestroySubtree(
+    Node *node) noexcept {
+  if (node->is_leaf) {
+    DestroyLeaf(static_cast<Leaf *>(node));
+    return;
+  }
+  Internal *internal{static_cast<Internal *>(node)};
+  for (size_t i{}; i <= internal->count; ++i) {
+    DestroySubtree(internal->children[i]);
+  }
+  DestroyInternal(internal);
+}
+
+/// <summary>
+/// Swaps the nodes and elements with another tree, keeping the allocators.
+/// </summary>
+/// <param name="other"> tree to swap with.</param>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+void BTree<K, V, NodeBytes, Compare, Allocator>::SwapNodes(
+    BTree &other) noexcept {
+  std::swap(root, other.root);
+  std::swap(first_leaf, other.first_leaf);
+  std::swap(last_leaf, other.last_leaf);
+  std::swap(size, other.size);
+  std::swap(height, other.height);
+}
+
+}  // namespace detail
+
+/// <summary>
+/// Ordered map built on a B+ tree with nodes of about NodeBytes bytes.
+/// Lookups take a logarithmic number of steps with a few cache misses each,
+/// and scans in key order walk the linked leaves. Inserting and erasing
+/// move elements between nodes, so they invalidate iterators. Keys must be
+/// copyable, as internal nodes keep copies of them as separators.
+/// </summary>
+/// <typeparam name="K"> type of keys.</typeparam>
+/// <typeparam name="V"> type of mapped values.</typeparam>
+/// <typeparam name="NodeBytes"> approximate size of a node in bytes, for
+/// example a few cache lines or a page.</typeparam>
+/// <typeparam name="Compare"> strict weak ordering of keys.</typeparam>
+/// <typeparam name="Allocator"> allocator used to obtain memory for
+/// nodes.</typeparam>
+template <typename K, typename V, size_t NodeBytes = kDefaultNodeBytes,
+          typename Compare = std::less<K>,
+          typename Allocator = std::allocator<std::pair<const K, V>>>
+class BTreeMap
+    : public detail::BTree<K, V, NodeBytes, Compare, Allocator> {
+  using Tree = detail::BTree<K, V, NodeBytes, Compare, Allocator>;
+
+ public:
+  using Iterator = typename Tree::Iterator;
+  using ConstIterator = typename Tree::ConstIterator;
+
+  // Constructors for the BTreeMap.
+  using Tree::Tree;
+  BTreeMap() noexcept = default;
+  BTreeMap(std::initializer_list<std::pair<const K, V>> values);
+
+  // Methods for inserting elements.
+  std::pair<Iterator, bool> Insert(K key, V value);
+  std::pair<Iterator, bool> InsertOrAssign(K key, V value);
+  template <typename... Args>
+  std::pair<Iterator, bool> TryEmplace(const K &key, Args &&...args);
+  void BulkLoad(const Vector<std::pair<K, V>> &sorted);
+
+  // Methods for accessing mapped values.
+  V &operator[](const K &key);
+  V &At(const K &key);
+  const V &At(const K &key) const;
+};
+
+/// <summary>
+/// Constructor inserting the elements of a list. For repeated keys the
+/// first element is kept.
+/// </summary>
+/// <param name="values"> elements to be inserted.</param>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+BTreeMap<K, V, NodeBytes, Compare, Allocator>::BTreeMap(
+    std::initializer_list<std::pair<const K, V>> values) {
+  for (const auto &[key, value] : values) Insert(key, value);
+}
+
+/// <summary>
+/// Inserts an element unless its key is already in the map.
+/// </summary>
+/// <param name="key"> key of the element.</param>
+/// <param name="value"> value of the element.</param>
+/// <returns> iterator to the element with the key and true if the element
+/// was inserted.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+std::pair<typename BTreeMap<K, V, NodeBytes, Compare, Allocator>::Iterator,
+          bool>
+BTreeMap<K, V, NodeBytes, Compare, Allocator>::Insert(K key, V value) {
+  return this->InsertUnique(std::move(key), std::move(value));
+}
+
+/// <summary>
+/// Inserts an element, or assigns the value to the element with the key.
+/// </summary>
+/// <param name="key"> key of the element.</param>
+/// <param name="value"> value to be inserted or assigned.</param>
+/// <returns> iterator to the element with the key and true if the element
+/// was inserted.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+std::pair<typename BTreeMap<K, V, NodeBytes, Compare, Allocator>::Iterator,
+          bool>
+BTreeMap<K, V, NodeBytes, Compare, Allocator>::InsertOrAssign(K key,
+                                                              V value) {
+  const Iterator found{this->Find(key)};
+  if (found != this->end()) {
+    found->second = std::move(value);
+    return {found, false};
+  }
+  return this->InsertUnique(std::move(key), std::move(value));
+}
+
+/// <summary>
+/// Constructs the mapped value from given arguments unless the key is
+/// already in the map. Nothing is constructed for an existing key.
+/// </summary>
+/// <param name="key"> key of the element.</param>
+/// <param name="args"> arguments passed to the constructor of V.</param>
+/// <returns> iterator to the element with the key and true if the element
+/// was inserted.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+template <typename... Args>
+std::pair<typename BTreeMap<K, V, NodeBytes, Compare, Allocator>::Iterator,
+          bool>
+BTreeMap<K, V, NodeBytes, Compare, Allocator>::TryEmplace(const K &key,
+                                                          Args &&...args) {
+  const Iterator found{this->Find(key)};
+  if (found != this->end()) return {found, false};
+  return this->InsertUnique(K(key), V(std::forward<Args>(args)...));
+}
+
+/// <summary>
+/// Replaces the elements of the map with the elements of a vector sorted
+/// by key, in linear time.
+/// </summary>
+/// <param name="sorted"> elements sorted by strictly increasing
+/// key.</param>
+/// <exception cref="std::runtime_error"> thrown when the keys are not
+/// sorted or repeat.</exception>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+void BTreeMap<K, V, NodeBytes, Compare, Allocator>::BulkLoad(
+    const Vector<std::pair<K, V>> &sorted) {
+  this->CheckSorted(sorted, [](const std::pair<K, V> &element) -> const K & {
+    return element.first;
+  });
+  this->Build(sorted.begin(), sorted.Size());
+}
+
+/// <summary>
+/// Returns the value mapped to a key, inserting a value initialized one if
+/// the key is not in the map.
+/// </summary>
+/// <param name="key"> key of the element.</param>
+/// <returns> reference to the mapped value.</returns>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+V &BTreeMap<K, V, NodeBytes, Compare, Allocator>::operator[](const K &key) {
+  return TryEmplace(key).first->second;
+}
+
+/// <summary>
+/// Returns the value mapped to a key.
+/// </summary>
+/// <param name="key"> key of the element.</param>
+/// <returns> reference to the mapped value.</returns>
+/// <exception cref="std::runtime_error"> thrown when the key is not in the
+/// map.</exception>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+V &BTreeMap<K, V, NodeBytes, Compare, Allocator>::At(const K &key) {
+  const Iterator found{this->Find(key)};
+  if (found == this->end()) {
+    ALGLIB_THROW(std::runtime_error(errors::kItemNotFound));
+  }
+  return found->second;
+}
+
+/// <summary>
+/// Returns the value mapped to a key.
+/// </summary>
+/// <param name="key"> key of the element.</param>
+/// <returns> reference to the mapped value.</returns>
+/// <exception cref="std::runtime_error"> thrown when the key is not in the
+/// map.</exception>
+template <typename K, typename V, size_t NodeBytes, typename Compare,
+          typename Allocator>
+const V &BTreeMap<K, V, NodeBytes, Compare, Allocator>::At(
+    const K &key) const {
+  const ConstIterator found{this->Find(key)};
+  if (found == this->end()) {
+    ALGLIB_THROW(std::runtime_error(errors::kItemNotFound));
+  }
+  return found->second;
+}
+
+/// <summary>
+/// Ordered set built on the same B+ tree as BTreeMap. Leaves hold only
+/// keys, so each of them fits more keys than a map leaf.
+/// </summary>
+/// <typeparam name="K"> type of keys.</typeparam>
+/// <typeparam name="NodeBytes"> approximate size of a node in
+/// bytes.</typeparam>
+/// <typeparam name="Compare"> strict weak ordering of keys.</typeparam>
+/// <typeparam name="Allocator"> allocator used to obtain memory for
+/// nodes.</typeparam>
+template <typename K, size_t NodeBytes = kDefaultNodeBytes,
+          typename Compare = std::less<K>,
+          typename Allocator = std::allocator<K>>
+class BTreeSet : public detail::BTree<K, detail::BTreeNoValue, NodeBytes,
+                                      Compare, Allocator> {
+  using Tree =
+      detail::BTree<K, detail::BTreeNoValue, NodeBytes, Compare, Allocator>;
+
+ public:
+  using Iterator = typename Tree::Iterator;
+  using ConstIterator = typename Tree::ConstIterator;
+
+  // Constructors for the BTreeSet.
+  using Tree::Tree;
+  BTreeSet() noexcept = default;
+  BTreeSet(std::initializer_list<K> values);
+
+  // Methods for inserting keys.
+  std::pair<Iterator, bool> Insert(K key);
+  void BulkLoad(const Vector<K> &sorted);
+};
+
+/// <summary>
+/// Constructor inserting the keys of a list.
+/// </summary>
+/// <param name="values"> keys to be inserted.</param>
+template <typename K, size_t NodeBytes, typename Compare, typename Allocator>
+BTreeSet<K, NodeBytes, Compare, Allocator>::BTreeSet(
+    std::initializer_list<K> values) {
+  for (const K &value : values) Insert(value);
+}
+
+/// <summary>
+/// Inserts a key unless it is already in the set.
+/// </summary>
+/// <param name="key"> key to be inserted.</param>
+/// <returns> iterator to the key and true if it was inserted.</returns>
+template <typename K, size_t NodeBytes, typename Compare, typename Allocator>
+std::pair<typename BTreeSet<K, NodeBytes, Compare, Allocator>::Iterator, bool>
+BTreeSet<K, NodeBytes, Compare, Allocator>::Insert(K key) {
+  return this->InsertUnique(std::move(key), detail::BTreeNoValue{});
+}
+
+/// <summary>
+/// Replaces the keys of the set with the keys of a sorted vector, in
+/// linear time.
+/// </summary>
+/// <param name="sorted"> strictly increasing keys.</param>
+/// <exception cref="std::runtime_error"> thrown when the keys are not
+/// sorted or repeat.</exception>
+template <typename K, size_t NodeBytes, typename Compare, typename Allocator>
+void BTreeSet<K, NodeBytes, Compare, Allocator>::BulkLoad(
+    const Vector<K> &sorted) {
+  this->CheckSorted(sorted, [](const K &key) -> const K & { return key; });
+  this->Build(sorted.begin(), sorted.Size());
+}
+
+}  // namespace alglib
+
+#endif  // ALGLIB_INCLUDE_BTREE_H_
@@ -0,0 +1,321 @@
+//*****************************************************************************
+// The MIT License (MIT)
+//
+// Copyright � 2024 Piotr Walczak
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the �Software�), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED �AS IS�, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//*****************************************************************************
+
+//*****************************************************************************
+// File: byte_ring.h
+//
+// This file contains the implementation of the ByteRing class. It is a fixed
+// capacity circular buffer of bytes meant for socket and file buffering.
+// Instead of moving single bytes in and out, it exposes its free and filled
+// regions as at most two contiguous spans that can be passed straight to
+// vectored I/O calls like readv and writev, and is advanced afterwards with
+// Commit and Consume. The class is implemented in the alglib namespace.
+//*****************************************************************************
+
+#ifndef ALGLIB_INCLUDE_BYTERING_H_
+#define ALGLIB_INCLUDE_BYTERING_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+
+#include "constants.h"
+#include "stats.h"
+
+/// <summary>
+/// Default namespace for the AlgLib library.
+/// </summary>
+namespace alglib {
+
+/// <summary>
+/// ByteRing is a byte version of CircularQueue that works on whole regions
+/// instead of single elements. Like CircularQueue it doesn't allocate memory
+/// on the heap. Free space and stored bytes each occupy at most two
+/// contiguous regions of the buffer: one up to its end and one that wraps
+/// around to its start. Whenever the ring becomes empty the front goes back
+/// to the start of the buffer, so free space is a single span again.
+/// </summary>
+/// <typeparam name="capacity"> max number of bytes in ring.</typeparam>
+template <size_t capacity>
+class ByteRing {
+  static_assert(capacity > 0, "ByteRing capacity has to be positive.");
+
+ public:
+  /// <summary>
+  /// Regions of the buffer, in order. Second span is empty when the region
+  /// doesn't wrap around.
+  /// </summary>
+  using Spans = std::array<std::span<std::byte>, 2>;
+  using ConstSpans = std::array<std::span<const std::byte>, 2>;
+
+  // Constructor for the ByteRing.
+  ByteRing();
+
+  // Methods for checking state of the ring.
+  bool IsEmpty() const noexcept;
+  bool IsFull() const noexcept;
+  size_t Size() const noexcept;
+  size_t FreeSpace() const noexcept;
+  static constexpr size_t Capacity() noexcept;
+
+  // Getting statistics of the ring.
+  ContainerStats GetStats() const noexcept;
+
+  // Methods exposing the buffer without copying.
+  Spans WritableSpans() noexcept;
+  Spans ReadableSpans() noexcept;
+  ConstSpans ReadableSpans() const noexcept;
+  void Commit(size_t count);
+  void Consume(size_t count);
+
+  // Methods copying bytes in and out of the ring.
+  size_t Write(std::span<const std::byte> bytes) noexcept;
+  size_t Read(std::span<std::byte> bytes) noexcept;
+  void Clear() noexcept;
+
+ private:
+  // Method for finding regions of the buffer.
+  Spans Regions(size_t start, size_t count) noexcept;
+
+  /// <summary>
+  /// Buffer that stores bytes of the ring.
+  /// </summary>
+  std::array<std::byte, capacity> buffer;
+  /// <summary>
+  /// Index of the first stored byte.
+  /// </summary>
+  size_t front;
+  /// <summary>
+  /// Number of stored bytes.
+  /// </summary>
+  size_t size;
+  /// <summary>
+  /// Statistics of the ring, empty unless ALGLIB_ENABLE_STATS is defined.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS detail::StatsRecorder stats;
+};
+
+/// <summary>
+/// Constructor for the ByteRing. It initializes the front index and size to
+/// 0, the buffer itself is left uninitialized.
+/// </summary>
+template <size_t capacity>
+ByteRing<capacity>::ByteRing() : front(0), size(0) {}
+
+/// <summary>
+/// Checks if the ring holds no bytes.
+/// </summary>
+/// <returns> true if empty, false if not.</returns>
+template <size_t capacity>
+bool ByteRing<capacity>::IsEmpty() const noexcept {
+  return size == 0;
+}
+
+/// <summary>
+/// Checks if the ring has no free space.
+/// </summary>
+/// <returns> true if full, false if not.</returns>
+template <size_t capacity>
+bool ByteRing<capacity>::IsFull() const noexcept {
+  return size == capacity;
+}
+
+/// <summary>
+/// Gets the number of bytes stored in the ring.
+/// </summary>
+/// <returns> number of stored bytes.</returns>
+template <size_t capacity>
+size_t ByteRing<capacity>::Size() const noexcept {
+  return size;
+}
+
+/// <summary>
+/// Gets the number of bytes that can still be written to the ring.
+/// </summary>
+/// <returns> number of free bytes.</returns>
+template <size_t capacity>
+size_t ByteRing<capacity>::FreeSpace() const noexcept {
+  return capacity - size;
+}
+
+/// <summary>
+/// Gets the max number of bytes the ring can hold.
+/// </summary>
+/// <returns> capacity of the ring.</returns>
+template <size_t capacity>
+constexpr size_t ByteRing<capacity>::Capacity() noexcept {
+  return capacity;
+}
+
+/// <summary>
+/// Gets statistics of the ring. It records the biggest number of stored
+/// bytes and writes or commits that didn't fit in the free space. The ring
+/// never allocates. Without ALGLIB_ENABLE_STATS all counters are zero.
+/// </summary>
+/// <returns> statistics of the ring.</returns>
+template <size_t capacity>
+ContainerStats ByteRing<capacity>::GetStats() const noexcept {
+  return stats.Get();
+}
+
+/// <summary>
+/// Gets the free space of the ring, where new bytes can be placed before
+/// calling Commit. Spans stay valid until the ring is modified.
+/// </summary>
+/// <returns> free regions, in the order they will be filled.</returns>
+template <size_t capacity>
+typename ByteRing<capacity>::Spans
+ByteRing<capacity>::WritableSpans() noexcept {
+  const size_t rear{front + size < capacity ? front + size
+                                            : front + size - capacity};
+  return Regions(rear, capacity - size);
+}
+
+/// <summary>
+/// Gets the stored bytes of the ring, which can be read before calling
+/// Consume. Spans stay valid until the ring is modified.
+/// </summary>
+/// <returns> filled regions, from the oldest byte.</returns>
+template <size_t capacity>
+typename ByteRing<capacity>::Spans
+ByteRing<capacity>::ReadableSpans() noexcept {
+  return Regions(front, size);
+}
+
+/// <summary>
+/// Gets the stored bytes of the ring, which can be read before calling
+/// Consume. Spans stay valid until the ring is modified.
+/// </summary>
+/// <returns> filled regions, from the oldest byte.</returns>
+template <size_t capacity>
+typename ByteRing<capacity>::ConstSpans ByteRing<capacity>::ReadableSpans()
+    const noexcept {
+  const Spans regions{const_cast<ByteRing *>(this)->ReadableSpans()};
+  return {regions[0], regions[1]};
+}
+
+/// <summary>
+/// Marks bytes placed at the start of the writable spans as stored.
+/// </summary>
+/// <param name="count"> number of bytes that were written.</param>
+/// <exception cref="std::runtime_error"> thrown when count is bigger than
+/// the free space.</exception>
+template <size_t capacity>
+void ByteRing<capacity>::Commit(size_t count) {
+  if (count > FreeSpace()) {
+    stats.Rejection();
+    ALGLIB_THROW(std::runtime_error(errors::kObjectFull));
+  }
+  size += count;
+  stats.Size(size);
+}
+
+/// <summary>
+/// Removes bytes from the front of the ring, usually after they were read
+/// through the readable spans.
+/// </summary>
+/// <param name="count"> number of bytes to remove.</param>
+/// <exception cref="std::runtime_error"> thrown when count is bigger than
+/// the number of stored bytes.</exception>
+template <size_t capacity>
+void ByteRing<capacity>::Consume(size_t count) {
+  if (count > size) {
+    ALGLIB_THROW(std::runtime_error(errors::kEmptyDeletion));
+  }
+  size -= count;
+  if (size == 0) {
+    front = 0;
+  } else {
+    front = front + count < capacity ? front + count
+                                     : front + count - capacity;
+  }
+}
+
+/// <summary>
+/// Copies as many bytes as fit into the ring.
+/// </summary>
+/// <param name="bytes"> bytes to be written.</param>
+/// <returns> number of bytes written.</returns>
+template <size_t capacity>
+size_t ByteRing<capacity>::Write(std::span<const std::byte> bytes) noexcept {
+  size_t written{};
+  for (std::span<std::byte> region : WritableSpans()) {
+    const size_t count{std::min(region.size(), bytes.size() - written)};
+    std::copy_n(bytes.data() + written, count, region.data());
+    written += count;
+  }
+  if (written < bytes.size()) stats.Rejection();
+  size += written;
+  stats.Size(size);
+  return written;
+}
+
+/// <summary>
+/// Copies bytes from the front of the ring and removes them.
+/// </summary>
+/// <param name="bytes"> buffer the bytes are copied to.</param>
+/// <returns> number of bytes read, less than buffer size if the ring ran
+/// empty.</returns>
+template <size_t capacity>
+size_t ByteRing<capacity>::Read(std::span<std::byte> bytes) noexcept {
+  size_t read{};
+  for (std::span<std::byte> region : ReadableSpans()) {
+    const size_t count{std::min(region.size(), bytes.size() - read)};
+    std::copy_n(region.data(), count, bytes.data() + read);
+    read += count;
+  }
+  Consume(read);
+  return read;
+}
+
+/// <summary>
+/// Removes all bytes from the ring.
+/// </summary>
+template <size_t capacity>
+void ByteRing<capacity>::Clear() noexcept {
+  front = 0;
+  size = 0;
+}
+
+/// <summary>
+/// Splits a region of the ring that may wrap around the end of the buffer
+/// into contiguous spans.
+/// </summary>
+/// <param name="start"> index of the first byte of the region.</param>
+/// <param name="count"> number of bytes in the region.</param>
+/// <returns> part before the end of the buffer and part after
+/// wrapping.</returns>
+template <size_t capacity>
+typename ByteRing<capacity>::Spans ByteRing<capacity>::Regions(
+    size_t start, size_t count) noexcept {
+  const size_t first{std::min(count, capacity - start)};
+  return {std::span<std::byte>(buffer.data() + start, first),
+          std::span<std::byte>(buffer.data(), count - first)};
+}
+
+}  // namespace alglib
+
+#endif  // ALGLIB_INCLUDE_BYTERING_H_
@@ -0,0 +1,942 @@
+//*****************************************************************************
+// The MIT License (MIT)
+//
+// Copyright � 2024 Piotr Walczak
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the �Software�), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED �AS IS�, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//*****************************************************************************
+
+//*****************************************************************************
+// File: cache.h
+//
+// This file contains the implementation of bounded key-value caches. LRUCache
+// evicts the least recently used entry and LFUCache the least frequently used
+// one. Both keep their entries in a DoublyLinkedList ordered by eviction
+// priority, with nodes taken from the shared NodePool, and find them through
+// a hash index of list iterators, so all operations take constant time.
+// ShardedCache splits keys between several independently locked caches for
+// use from many threads. The classes are implemented in the alglib namespace.
+//*****************************************************************************
+
+#ifndef ALGLIB_INCLUDE_CACHE_H_
+#define ALGLIB_INCLUDE_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "constants.h"
+#include "doubly_linked_list.h"
+#include "node_pool.h"
+#include "stats.h"
+
+/// <summary>
+/// Default namespace for the AlgLib library.
+/// </summary>
+namespace alglib {
+
+/// <summary>
+/// Byte capacity of caches that only limit the number of entries.
+/// </summary>
+inline constexpr size_t kUnlimitedCacheBytes{
+    std::numeric_limits<size_t>::max()};
+
+/// <summary>
+/// Cache that evicts the least recently used entry when it runs out of room.
+/// It holds at most a given number of entries and, when sizes are given to
+/// Put, at most a given number of bytes.
+/// </summary>
+/// <typeparam name="K"> type of the keys.</typeparam>
+/// <typeparam name="V"> type of the cached values.</typeparam>
+/// <typeparam name="Hash"> hash function of the keys.</typeparam>
+/// <typeparam name="KeyEqual"> equality of the keys.</typeparam>
+template <typename K, typename V, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+class LRUCache {
+ public:
+  using KeyType = K;
+  using ValueType = V;
+  using EvictionCallback = std::function<void(const K &, V &)>;
+
+  // Constructors and assignment operators.
+  explicit LRUCache(size_t capacity,
+                    size_t byte_capacity = kUnlimitedCacheBytes);
+  LRUCache(const LRUCache &) = delete;
+  LRUCache &operator=(const LRUCache &) = delete;
+
+  // Methods for accessing and modifying entries.
+  V *Get(const K &key);
+  bool Put(const K &key, V value, size_t bytes = 0);
+  bool Erase(const K &key);
+  bool Contains(const K &key) const;
+  void Clear() noexcept;
+
+  // Method for observing evictions.
+  void SetEvictionCallback(EvictionCallback callback);
+
+  // Size and limits of the cache.
+  size_t Size() const noexcept;
+  size_t Bytes() const noexcept;
+  size_t Capacity() const noexcept;
+  size_t ByteCapacity() const noexcept;
+
+  // Statistics of the cache.
+  ContainerStats GetStats() const noexcept;
+
+ private:
+  /// <summary>
+  /// Entry of the cache, stored in the recency list.
+  /// </summary>
+  struct Entry {
+    K key;
+    V value;
+    size_t bytes;
+  };
+
+  using List = DoublyLinkedList<Entry, PoolAllocator<Entry>>;
+  using Index = std::unordered_map<
+      K, typename List::Iterator, Hash, KeyEqual,
+      PoolAllocator<std::pair<const K, typename List::Iterator>>>;
+
+  // Methods removing entries.
+  void Remove(typename List::Iterator it);
+  void EvictToFit();
+
+  /// <summary>
+  /// Entries ordered from the most to the least recently used.
+  /// </summary>
+  List entries;
+
+  /// <summary>
+  /// Positions of the entries in the list, by key.
+  /// </summary>
+  Index index;
+
+  // Limits and current size in bytes.
+  size_t capacity;
+  size_t byte_capacity;
+  size_t total_bytes;
+
+  /// <summary>
+  /// Function called with entries evicted to make room for others.
+  /// </summary>
+  EvictionCallback on_evict;
+
+  /// <summary>
+  /// Statistics of the cache, empty unless ALGLIB_ENABLE_STATS is defined.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS detail::StatsRecorder stats;
+};
+
+/// <summary>
+/// Cache that evicts the least frequently used entry when it runs out of
+/// room. From entries used equally often the least recently used one goes
+/// first. It holds at most a given number of entries and, when sizes are
+/// given to Put, at most a given number of bytes.
+/// </summary>
+/// <typeparam name="K"> type of the keys.</typeparam>
+/// <typeparam name="V"> type of the cached values.</typeparam>
+/// <typeparam name="Hash"> hash function of the keys.</typeparam>
+/// <typeparam name="KeyEqual"> equality of the keys.</typeparam>
+template <typename K, typename V, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+class LFUCache {
+ public:
+  using KeyType = K;
+  using ValueType = V;
+  using EvictionCallback = std::function<void(const K &, V &)>;
+
+  // Constructors and assignment operators.
+  explicit LFUCache(size_t capacity,
+                    size_t byte_capacity = kUnlimitedCacheBytes);
+  LFUCache(const LFUCache &) = delete;
+  LFUCache &operator=(const LFUCache &) = delete;
+
+  // Methods for accessing and modifying entries.
+  V *Get(const K &key);
+  bool Put(const K &key, V value, size_t bytes = 0);
+  bool Erase(const K &key);
+  bool Contains(const K &key) const;
+  void Clear() noexcept;
+
+  // Method for observing evictions.
+  void SetEvictionCallback(EvictionCallback callback);
+
+  // Size and limits of the cache.
+  size_t Size() const noexcept;
+  size_t Bytes() const noexcept;
+  size_t Capacity() const noexcept;
+  size_t ByteCapacity() const noexcept;
+
+  // Statistics of the cache.
+  ContainerStats GetStats() const noexcept;
+
+  // Number of uses of a cached entry.
+  size_t Frequency(const K &key) const;
+
+ private:
+  /// <summary>
+  /// Entry of the cache, stored in the frequency list.
+  /// </summary>
+  struct Entry {
+    K key;
+    V value;
+    size_t bytes;
+    size_t frequency;
+  };
+
+  using List = DoublyLinkedList<Entry, PoolAllocator<Entry>>;
+  using Index = std::unordered_map<
+      K, typename List::Iterator, Hash, KeyEqual,
+      PoolAllocator<std::pair<const K, typename List::Iterator>>>;
+  using Groups = std::unordered_map<
+      size_t, typename List::Iterator, std::hash<size_t>,
+      std::equal_to<size_t>,
+      PoolAllocator<std::pair<const size_t, typename List::Iterator>>>;
+
+  // Methods keeping the list ordered by frequency.
+  void Detach(typename List::Iterator it);
+  void Touch(typename List::Iterator it);
+
+  // Methods removing entries.
+  void Remove(typename List::Iterator it);
+  void EvictToFit(typename List::Iterator keep);
+
+  /// <summary>
+  /// Entries ordered by ascending frequency. Entries with the same frequency
+  /// form a group ordered from the least to the most recently used.
+  /// </summary>
+  List entries;
+
+  /// <summary>
+  /// Positions of the entries in the list, by key.
+  /// </summary>
+  Index index;
+
+  /// <summary>
+  /// Last entry of every group, by frequency.
+  /// </summary>
+  Groups group_last;
+
+  // Limits and current size in bytes.
+  size_t capacity;
+  size_t byte_capacity;
+  size_t total_bytes;
+
+  /// <summary>
+  /// Function called with entries evicted to make room for others.
+  /// </summary>
+  EvictionCallback on_evict;
+
+  /// <summary>
+  /// Statistics of the cache, empty unless ALGLIB_ENABLE_STATS is defined.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS detail::StatsRecorder stats;
+};
+
+/// <summary>
+/// Cache split into shards, each being a separate cache guarded by its own
+/// mutex. Keys are assigned to shards by hash, so threads working on
+/// different keys rarely wait for each other. Values are returned by copy, as
+/// the entry may be evicted by another thread as soon as the lock is
+/// released.
+/// </summary>
+/// <typeparam name="Cache"> type of a single shard, LRUCache or
+/// LFUCache.</typeparam>
+/// <typeparam name="Hash"> hash function used to pick the shard.</typeparam>
+template <typename Cache, typename Hash = std::hash<typename Cache::KeyType>>
+class ShardedCache {
+ public:
+  using KeyType = typename Cache::KeyType;
+  using ValueType = typename Cache::ValueType;
+  using EvictionCallback = typename Cache::EvictionCallback;
+
+  // Constructors and assignment operators.
+  ShardedCache(size_t shard_count, size_t capacity,
+               size_t byte_capacity = kUnlimitedCacheBytes);
+  ShardedCache(const ShardedCache &) = delete;
+  ShardedCache &operator=(const ShardedCache &) = delete;
+
+  // Methods for accessing and modifying entries.
+  std::optional<ValueType> Get(const KeyType &key);
+  bool Put(const KeyType &key, ValueType value, size_t bytes = 0);
+  bool Erase(const KeyType &key);
+  bool Contains(const KeyType &key) const;
+  void Clear();
+
+  // Method for observing evictions.
+  void SetEvictionCallback(const EvictionCallback &callback);
+
+  // Size of the cache.
+  size_t Size() const;
+  size_t Bytes() const;
+  size_t ShardCount() const noexcept;
+
+  // Statistics of the cache.
+  ContainerStats GetStats() const noexcept;
+
+ private:
+  /// <summary>
+  /// Single shard, aligned so that locks of neighbouring shards don't share
+  /// a cache line.
+  /// </summary>
+  struct alignas(64) Shard {
+    Shard(size_t capacity, size_t byte_capacity);
+
+    mutable std::mutex mutex;
+    Cache cache;
+  };
+
+  Shard &ShardFor(const KeyType &key) const;
+
+  /// <summary>
+  /// Shards of the cache.
+  /// </summary>
+  std::vector<std::unique_ptr<Shard>> shards;
+
+  /// <summary>
+  /// Hash function used to pick the shard.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS Hash hash;
+};
+
+/// <summary>
+/// Constructor creating an empty cache with given limits.
+/// </summary>
+/// <param name="capacity"> maximum number of entries.</param>
+/// <param name="byte_capacity"> maximum sum of entry sizes.</param>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+LRUCache<K, V, Hash, KeyEqual>::LRUCache(size_t capacity,
+                                         size_t byte_capacity)
+    : capacity(capacity), byte_capacity(byte_capacity), total_bytes(0) {}
+
+/// <summary>
+/// Looks up a value and marks it as the most recently used one.
+/// </summary>
+/// <param name="key"> key of the value.</param>
+/// <returns> pointer to the cached value, valid until the entry is removed,
+/// or nullptr if the key is not cached.</returns>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+V *LRUCache<K, V, Hash, KeyEqual>::Get(const K &key) {
+  auto found{index.find(key)};
+  if (found == index.end()) return nullptr;
+  entries.Splice(entries.begin(), entries, found->second);
+  return &found->second->value;
+}
+
+/// <summary>
+/// Stores a value as the most recently used one, replacing the value cached
+/// under the same key. Least recently used entries are evicted until the
+/// cache fits in its limits.
+/// </summary>
+/// <param name="key"> key of the value.</param>
+/// <param name="value"> value that will be cached.</param>
+/// <param name="bytes"> size of the entry counted against the byte
+/// capacity.</param>
+/// <returns> true if the value was cached, false if it can never fit and the
+/// key was removed instead.</returns>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+bool LRUCache<K, V, Hash, KeyEqual>::Put(const K &key, V value,
+                                         size_t bytes) {
+  if (capacity == 0 || bytes > byte_capacity) {
+    stats.Rejection();
+    Erase(key);
+    return false;
+  }
+  auto found{index.find(key)};
+  if (found != index.end()) {
+    typename List::Iterator it{found->second};
+    it->value = std::move(value);
+    total_bytes = total_bytes - it->bytes + bytes;
+    it->bytes = bytes;
+    entries.Splice(entries.begin(), entries, it);
+  } else {
+    typename List::Iterator it{
+        entries.InsertBefore(entries.begin(), Entry{key, std::move(value),
+                                                    bytes})};
+    ALGLIB_TRY {
+      index.emplace(key, it);
+    } ALGLIB_CATCH_ALL {
+      entries.Erase(it);
+      ALGLIB_RETHROW;
+    }
+    total_bytes += bytes;
+  }
+  EvictToFit();
+  stats.Size(index.size());
+  return true;
+}
+
+/// <summary>
+/// Removes a value from the cache without calling the eviction callback.
+/// </summary>
+/// <param name="key"> key of the value.</param>
+/// <returns> true if the key was cached.</returns>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+bool LRUCache<K, V, Hash, KeyEqual>::Erase(const K &key) {
+  auto found{index.find(key)};
+  if (found == index.end()) return false;
+  Remove(found->second);
+  return true;
+}
+
+/// <summary>
+/// Checks whether a key is cached without marking it as used.
+/// </summary>
+/// <param name="key"> key that is checked.</param>
+/// <returns> true if the key is cached.</returns>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+bool LRUCache<K, V, Hash, KeyEqual>::Contains(const K &key) const {
+  return index.find(key) != index.end();
+}
+
+/// <summary>
+/// Removes all entries without calling the eviction callback.
+/// </summary>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void LRUCache<K, V, Hash, KeyEqual>::Clear() noexcept {
+  index.clear();
+  while (!entries.IsEmpty()) entries.DeleteAtEnd();
+  total_bytes = 0;
+}
+
+/// <summary>
+/// Sets function called with every entry evicted to make room for other
+/// ones, just before the entry is destroyed. The function must not use the
+/// cache.
+/// </summary>
+/// <param name="callback"> function taking key and value of the evicted
+/// entry.</param>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void LRUCache<K, V, Hash, KeyEqual>::SetEvictionCallback(
+    EvictionCallback callback) {
+  on_evict = std::move(callback);
+}
+
+/// <summary>
+/// Returns number of cached entries.
+/// </summary>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+size_t LRUCache<K, V, Hash, KeyEqual>::Size() const noexcept {
+  return index.size();
+}
+
+/// <summary>
+/// Returns sum of sizes of cached entries.
+/// </summary>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+size_t LRUCache<K, V, Hash, KeyEqual>::Bytes() const noexcept {
+  return total_bytes;
+}
+
+/// <summary>
+/// Returns maximum number of entries.
+/// </summary>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+size_t LRUCache<K, V, Hash, KeyEqual>::Capacity() const noexcept {
+  return capacity;
+}
+
+/// <summary>
+/// Returns maximum sum of sizes of entries.
+/// </summary>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+size_t LRUCache<K, V, Hash, KeyEqual>::ByteCapacity() const noexcept {
+  return byte_capacity;
+}
+
+/// <summary>
+/// Returns statistics of the cache. Allocations and deallocations count the
+/// nodes of the entry list, the biggest size is the number of entries after
+/// evictions and Put calls with entries that can never fit count as
+/// rejected. Without ALGLIB_ENABLE_STATS all counters are zero.
+/// </summary>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+ContainerStats LRUCache<K, V, Hash, KeyEqual>::GetStats() const noexcept {
+  ContainerStats result{stats.Get()};
+  const ContainerStats nodes{entries.GetStats()};
+  result.allocations = nodes.allocations;
+  result.deallocations = nodes.deallocations;
+  return result;
+}
+
+/// <summary>
+/// Removes an entry from the list and the index.
+/// </summary>
+/// <param name="it"> iterator to the entry.</param>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void LRUCache<K, V, Hash, KeyEqual>::Remove(typename List::Iterator it) {
+  total_bytes -= it->bytes;
+  index.erase(it->key);
+  entries.Erase(it);
+}
+
+/// <summary>
+/// Evicts least recently used entries until the cache fits in its limits.
+/// </summary>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void LRUCache<K, V, Hash, KeyEqual>::EvictToFit() {
+  while (index.size() > capacity || total_bytes > byte_capacity) {
+    typename List::Iterator victim{std::prev(entries.end())};
+    if (on_evict) on_evict(victim->key, victim->value);
+    Remove(victim);
+  }
+}
+
+/// <summary>
+/// Constructor creating an empty cache with given limits.
+/// </summary>
+/// <param name="capacity"> maximum number of entries.</param>
+/// <param name="byte_capacity"> maximum sum of entry sizes.</param>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+LFUCache<K, V, Hash, KeyEqual>::LFUCache(size_t capacity,
+                                         size_t byte_capacity)
+    : capacity(capacity), byte_capacity(byte_capacity), total_bytes(0) {}
+
+/// <summary>
+/// Looks up a value and counts it as used.
+/// </summary>
+/// <param name="key"> key of the value.</param>
+/// <returns> pointer to the cached value, valid until the entry is removed,
+/// or nullptr if the key is not cached.</returns>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+V *LFUCache<K, V, Hash, KeyEqual>::Get(const K &key) {
+  auto found{index.find(key)};
+  if (found == index.end()) return nullptr;
+  Touch(found->second);
+  return &found->second->value;
+}
+
+/// <summary>
+/// Stores a value, replacing the value cached under the same key, which
+/// counts as its use. New entries start with frequency of one. Least
+/// frequently used entries are evicted until the cache fits in its limits.
+/// </summary>
+/// <param name="key"> key of the value.</param>
+/// <param name="value"> value that will be cached.</param>
+/// <param name="bytes"> size of the entry counted against the byte
+/// capacity.</param>
+/// <returns> true if the value was cached, false if it can never fit and the
+/// key was removed instead.</returns>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+bool LFUCache<K, V, Hash, KeyEqual>::Put(const K &key, V value,
+                                         size_t bytes) {
+  if (capacity == 0 || bytes > byte_capacity) {
+    stats.Rejection();
+    Erase(key);
+    return false;
+  }
+  auto found{index.find(key)};
+  if (found != index.end()) {
+    typename List::Iterator it{found->second};
+    it->value = std::move(value);
+    total_bytes = total_bytes - it->bytes + bytes;
+    it->bytes = bytes;
+    Touch(it);
+    EvictToFit(it);
+    stats.Size(index.size());
+    return true;
+  }
+  auto group{group_last.find(1)};
+  typename List::Iterator position{
+      group != group_last.end() ? std::next(group->second) : entries.begin()};
+  typename List::Iterator it{
+      entries.InsertBefore(position, Entry{key, std::move(value), bytes, 1})};
+  ALGLIB_TRY {
+    index.emplace(key, it);
+    group_last[1] = it;
+  } ALGLIB_CATCH_ALL {
+    index.erase(key);
+    Detach(it);
+    entries.Erase(it);
+    ALGLIB_RETHROW;
+  }
+  total_bytes += bytes;
+  EvictToFit(it);
+  stats.Size(index.size());
+  return true;
+}
+
+/// <summary>
+/// Removes a value from the cache without calling the eviction callback.
+/// </summary>
+/// <param name="key"> key of the value.</param>
+/// <returns> true if the key was cached.</returns>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+bool LFUCache<K, V, Hash, KeyEqual>::Erase(const K &key) {
+  auto found{index.find(key)};
+  if (found == index.end()) return false;
+  Remove(found->second);
+  return true;
+}
+
+/// <summary>
+/// Checks whether a key is cached without counting it as used.
+/// </summary>
+/// <param name="key"> key that is checked.</param>
+/// <returns> true if the key is cached.</returns>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+bool LFUCache<K, V, Hash, KeyEqual>::Contains(const K &key) const {
+  return index.find(key) != index.end();
+}
+
+/// <summary>
+/// Removes all entries without calling the eviction callback.
+/// </summary>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void LFUCache<K, V, Hash, KeyEqual>::Clear() noexcept {
+  index.clear();
+  group_last.clear();
+  while (!entries.IsEmpty()) entries.DeleteAtEnd();
+  total_bytes = 0;
+}
+
+/// <summary>
+/// Sets function called with every entry evicted to make room for other
+/// ones, just before the entry is destroyed. The function must not use the
+/// cache.
+/// </summary>
+/// <param name="callback"> function taking key and value of the evicted
+/// entry.</param>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void LFUCache<K, V, Hash, KeyEqual>::SetEvictionCallback(
+    EvictionCallback callback) {
+  on_evict = std::move(callback);
+}
+
+/// <summary>
+/// Returns number of cached entries.
+/// </summary>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+size_t LFUCache<K, V, Hash, KeyEqual>::Size() const noexcept {
+  return index.size();
+}
+
+/// <summary>
+/// Returns sum of sizes of cached entries.
+/// </summary>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+size_t LFUCache<K, V, Hash, KeyEqual>::Bytes() const noexcept {
+  return total_bytes;
+}
+
+/// <summary>
+/// Returns maximum number of entries.
+/// </summary>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+size_t LFUCache<K, V, Hash, KeyEqual>::Capacity() const noexcept {
+  return capacity;
+}
+
+/// <summary>
+/// Returns maximum sum of sizes of entries.
+/// </summary>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+size_t LFUCache<K, V, Hash, KeyEqual>::ByteCapacity() const noexcept {
+  return byte_capacity;
+}
+
+/// <summary>
+/// Returns statistics of the cache. Allocations and deallocations count the
+/// nodes of the entry list, the biggest size is the number of entries after
+/// evictions and Put calls with entries that can never fit count as
+/// rejected. Without ALGLIB_ENABLE_STATS all counters are zero.
+/// </summary>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+ContainerStats LFUCache<K, V, Hash, KeyEqual>::GetStats() const noexcept {
+  ContainerStats result{stats.Get()};
+  const ContainerStats nodes{entries.GetStats()};
+  result.allocations = nodes.allocations;
+  result.deallocations = nodes.deallocations;
+  return result;
+}
+
+/// <summary>
+/// Returns how many times an entry was used, counting the Put that created
+/// it.
+/// </summary>
+/// <param name="key"> key of the entry.</param>
+/// <exception cref="std::runtime_error">Thrown when the key is not
+/// cached.</exception>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+size_t LFUCache<K, V, Hash, KeyEqual>::Frequency(const K &key) const {
+  auto found{index.find(key)};
+  if (found == index.end()) {
+    ALGLIB_THROW(std::runtime_error(errors::kItemNotFound));
+  }
+  return found->second->frequency;
+}
+
+/// <summary>
+/// Takes an entry out of its group record before the entry is moved or
+/// removed. When it was the last entry of the group, the entry before it
+/// takes its place, or the group goes away if it had no other entries.
+/// </summary>
+/// <param name="it"> iterator to the entry.</param>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void LFUCache<K, V, Hash, KeyEqual>::Detach(typename List::Iterator it) {
+  auto group{group_last.find(it->frequency)};
+  if (group == group_last.end() || group->second != it) return;
+  if (it != entries.begin() && std::prev(it)->frequency == it->frequency) {
+    group->second = std::prev(it);
+  } else {
+    group_last.erase(group);
+  }
+}
+
+/// <summary>
+/// Counts a use of an entry, moving it to the end of the next group.
+/// </summary>
+/// <param name="it"> iterator to the entry.</param>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void LFUCache<K, V, Hash, KeyEqual>::Touch(typename List::Iterator it) {
+  const size_t frequency{it->frequency};
+  auto [target, created] = group_last.try_emplace(frequency + 1, it);
+  // Without a group for the next frequency, the end of the own group is the
+  // right place, as all groups after it have higher frequencies.
+  typename List::Iterator after{
+      created ? group_last.find(frequency)->second : target->second};
+  Detach(it);
+  if (after != it) entries.Splice(std::next(after), entries, it);
+  it->frequency = frequency + 1;
+  target->second = it;
+}
+
+/// <summary>
+/// Removes an entry from the list, the groups and the index.
+/// </summary>
+/// <param name="it"> iterator to the entry.</param>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void LFUCache<K, V, Hash, KeyEqual>::Remove(typename List::Iterator it) {
+  Detach(it);
+  total_bytes -= it->bytes;
+  index.erase(it->key);
+  entries.Erase(it);
+}
+
+/// <summary>
+/// Evicts least frequently used entries until the cache fits in its limits.
+/// </summary>
+/// <param name="keep"> entry that was just stored and is never
+/// evicted.</param>
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void LFUCache<K, V, Hash, KeyEqual>::EvictToFit(
+    typename List::Iterator keep) {
+  while (index.size() > capacity || total_bytes > byte_capacity) {
+    typename List::Iterator victim{entries.begin()};
+    if (victim == keep) ++victim;
+    if (on_evict) on_evict(victim->key, victim->value);
+    Remove(victim);
+  }
+}
+
+/// <summary>
+/// Constructor for a shard creating its cache.
+/// </summary>
+template <typename Cache, typename Hash>
+ShardedCache<Cache, Hash>::Shard::Shard(size_t capacity, size_t byte_capacity)
+    : cache(capacity, byte_capacity) {}
+
+/// <summary>
+/// Constructor creating an empty cache split into a given number of shards.
+/// Limits are divided evenly between the shards, so the whole cache may
+/// start evicting before it is full when keys are not spread evenly.
+/// </summary>
+/// <param name="shard_count"> number of shards, at least one is
+/// created.</param>
+/// <param name="capacity"> maximum number of entries.</param>
+/// <param name="byte_capacity"> maximum sum of entry sizes.</param>
+template <typename Cache, typename Hash>
+ShardedCache<Cache, Hash>::ShardedCache(size_t shard_count, size_t capacity,
+                                        size_t byte_capacity) {
+  if (shard_count == 0) shard_count = 1;
+  const size_t shard_capacity{(capacity + shard_count - 1) / shard_count};
+  const size_t shard_bytes{
+      byte_capacity == kUnlimitedCacheBytes
+          ? kUnlimitedCacheBytes
+          : byte_capacity / shard_count + (byte_capacity % shard_count != 0)};
+  shards.reserve(shard_count);
+  for (size_t i{}; i < shard_count; ++i) {
+    shards.push_back(std::make_unique<Shard>(shard_capacity, shard_bytes));
+  }
+}
+
+/// <summary>
+/// Looks up a value and counts it as used.
+/// </summary>
+/// <param name="key"> key of the value.</param>
+/// <returns> copy of the cached value or std::nullopt if the key is not
+/// cached.</returns>
+template <typename Cache, typename Hash>
+std::optional<typename ShardedCache<Cache, Hash>::ValueType>
+ShardedCache<Cache, Hash>::Get(const KeyType &key) {
+  Shard &shard{ShardFor(key)};
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  ValueType *value{shard.cache.Get(key)};
+  if (value == nullptr) return std::nullopt;
+  return *value;
+}
+
+/// <summary>
+/// Stores a value in the shard of its key.
+/// </summary>
+/// <param name="key"> key of the value.</param>
+/// <param name="value"> value that will be cached.</param>
+/// <param name="bytes"> size of the entry counted against the byte
+/// capacity.</param>
+/// <returns> true if the value was cached.</returns>
+template <typename Cache, typename Hash>
+bool ShardedCache<Cache, Hash>::Put(const KeyType &key, ValueType value,
+                                    size_t bytes) {
+  Shard &shard{ShardFor(key)};
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  return shard.cache.Put(key, std::move(value), bytes);
+}
+
+/// <summary>
+/// Removes a value from the cache without calling the eviction callback.
+/// </summary>
+/// <param name="key"> key of the value.</param>
+/// <returns> true if the key was cached.</returns>
+template <typename Cache, typename Hash>
+bool ShardedCache<Cache, Hash>::Erase(const KeyType &key) {
+  Shard &shard{ShardFor(key)};
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  return shard.cache.Erase(key);
+}
+
+/// <summary>
+/// Checks whether a key is cached without counting it as used.
+/// </summary>
+/// <param name="key"> key that is checked.</param>
+/// <returns> true if the key is cached.</returns>
+template <typename Cache, typename Hash>
+bool ShardedCache<Cache, Hash>::Contains(const KeyType &key) const {
+  Shard &shard{ShardFor(key)};
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  return shard.cache.Contains(key);
+}
+
+/// <summary>
+/// Removes all entries, locking one shard at a time.
+/// </summary>
+template <typename Cache, typename Hash>
+void ShardedCache<Cache, Hash>::Clear() {
+  for (const std::unique_ptr<Shard> &shard : shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    shard->cache.Clear();
+  }
+}
+
+/// <summary>
+/// Sets function called with every evicted entry. It is called while the
+/// shard of the entry is locked, so it must not use the cache.
+/// </summary>
+/// <param name="callback"> function taking key and value of the evicted
+/// entry.</param>
+template <typename Cache, typename Hash>
+void ShardedCache<Cache, Hash>::SetEvictionCallback(
+    const EvictionCallback &callback) {
+  for (const std::unique_ptr<Shard> &shard : shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    shard->cache.SetEvictionCallback(callback);
+  }
+}
+
+/// <summary>
+/// Returns number of cached entries. Shards are counted one at a time, so the
+/// result is only exact when no other thread modifies the cache.
+/// </summary>
+template <typename Cache, typename Hash>
+size_t ShardedCache<Cache, Hash>::Size() const {
+  size_t size{};
+  for (const std::unique_ptr<Shard> &shard : shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    size += shard->cache.Size();
+  }
+  return size;
+}
+
+/// <summary>
+/// Returns sum of sizes of cached entries, with the same precision as Size.
+/// </summary>
+template <typename Cache, typename Hash>
+size_t ShardedCache<Cache, Hash>::Bytes() const {
+  size_t bytes{};
+  for (const std::unique_ptr<Shard> &shard : shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    bytes += shard->cache.Bytes();
+  }
+  return bytes;
+}
+
+/// <summary>
+/// Returns number of shards.
+/// </summary>
+template <typename Cache, typename Hash>
+size_t ShardedCache<Cache, Hash>::ShardCount() const noexcept {
+  return shards.size();
+}
+
+/// <summary>
+/// Returns statistics of all shards added together. Counters are read
+/// without locking the shards, and the biggest sizes of the shards are
+/// summed, so the biggest size may exceed the number of entries the whole
+/// cache ever held at once.
+/// </summary>
+template <typename Cache, typename Hash>
+ContainerStats ShardedCache<Cache, Hash>::GetStats() const noexcept {
+  ContainerStats total{};
+  for (const std::unique_ptr<Shard> &shard : shards) {
+    const ContainerStats stats{shard->cache.GetStats()};
+    total.allocations += stats.allocations;
+    total.deallocations += stats.deallocations;
+    total.reallocations += stats.reallocations;
+    total.bytes_moved += stats.bytes_moved;
+    total.high_water_mark += stats.high_water_mark;
+    total.rejected += stats.rejected;
+  }
+  return total;
+}
+
+/// <summary>
+/// Picks the shard of a key. The hash is mixed first, so that the shard
+/// doesn't depend on the same low bits that pick the bucket inside it.
+/// </summary>
+/// <param name="key"> key of an entry.</param>
+/// <returns> shard responsible for the key.</returns>
+template <typename Cache, typename Hash>
+typename ShardedCache<Cache, Hash>::Shard &ShardedCache<Cache, Hash>::ShardFor(
+    const KeyType &key) const {
+  const uint64_t mixed{static_cast<uint64_t>(hash(key)) *
+                       0x9E3779B97F4A7C15ULL};
+  return *shards[static_cast<size_t>(mixed >> 32) % shards.size()];
+}
+
+}  // namespace alglib
+
+#endif  // ALGLIB_INCLUDE_CACHE_H_
@@ -35,10 +35,14 @@
 #ifndef ALGLIB_INCLUDE_CIRCULARQUEUE_H_
 #define ALGLIB_INCLUDE_CIRCULARQUEUE_H_
 
-#include <array>
+#include <cstddef>
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 #include "constants.h"
+#include "stats.h"
 
 /// <summary>
 /// Default namespace for the AlgLib library.
@@ -49,30 +53,76 @@ namespace alglib {
 /// CircularQueue class is a queue data structure implemented using an array.
 /// It doesn't allocate memory on the heap and has a fixed capacity that has
 /// to be defined at compile time. It uses a circular buffer to store elements.
+/// Elements are constructed only when they are enqueued and destroyed when
+/// they are dequeued, so T doesn't have to be default constructible. All
+/// methods are constexpr, so the queue can be used during compile-time
+/// evaluation.
 /// </summary>
 /// <typeparam name="T"> type that will be stored in queue.</typeparam>
 /// <typeparam name="capacity"> max capacity of queue.</typeparam>
 template <typename T, size_t capacity>
 class CircularQueue {
+  static_assert(capacity > 0, "CircularQueue capacity has to be positive.");
+
  public:
-  // Constructor for the CircularQueue.
-  CircularQueue();
+  // Constructors and assignment operators for the CircularQueue.
+  constexpr CircularQueue() noexcept;
+  constexpr CircularQueue(const CircularQueue &other);
+  constexpr CircularQueue(CircularQueue &&other) noexcept(
+      std::is_nothrow_move_constructible_v<T>);
+  constexpr CircularQueue &operator=(const CircularQueue &other);
+  constexpr CircularQueue &operator=(CircularQueue &&other) noexcept(
+      std::is_nothrow_move_constructible_v<T>);
 
   // Manipulation methods for the queue.
-  bool IsEmpty() const noexcept;
-  bool IsFull() const noexcept;
-  T Dequeue();
-  void Enqueue(T value);
+  constexpr bool IsEmpty() const noexcept;
+  constexpr bool IsFull() const noexcept;
+  constexpr T Dequeue();
+  constexpr void Enqueue(T value);
+  template <typename... Args>
+  constexpr T &Emplace(Args &&...args);
 
   // Methods for peeking at values in the queue.
-  T PeekFront() const;
-  T PeekRear() const;
+  constexpr T PeekFront() const;
+  constexpr T PeekRear() const;
+
+  // Non-throwing methods for manipulating and peeking at the queue.
+  constexpr bool TryEnqueue(T value);
+  template <typename... Args>
+  constexpr T *TryEmplace(Args &&...args);
+  constexpr bool TryDequeue(T &value);
+  constexpr bool TryPeekFront(T &value) const;
+  constexpr bool TryPeekRear(T &value) const;
+
+  // Getting statistics of the queue.
+  ContainerStats GetStats() const noexcept;
+
+  // Destructor for the CircularQueue.
+  constexpr ~CircularQueue();
 
  private:
+  /// <summary>
+  /// Uninitialized memory for elements. Being a union member, the array is
+  /// not constructed together with the queue, its elements are constructed
+  /// one by one with std::construct_at.
+  /// </summary>
+  union Storage {
+    constexpr Storage() noexcept {}
+    constexpr ~Storage() {}
+
+    T elements[capacity];
+  };
+
+  // Methods for handling elements.
+  static constexpr size_t Wrap(size_t index) noexcept;
+  template <typename Queue>
+  constexpr void Assign(Queue &&other);
+  constexpr void Destroy() noexcept;
+
   /// <summary>
   /// Main array that stores elements of the queue.
   /// </summary>
-  std::array<T, capacity> queue;
+  Storage queue;
   /// <summary>
   /// Index of the front element of the queue.
   /// </summary>
@@ -81,14 +131,74 @@ class CircularQueue {
   /// Amount of active elements in the queue.
   /// </summary>
   size_t size;
+  /// <summary>
+  /// Statistics of the queue, empty unless ALGLIB_ENABLE_STATS is defined.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS detail::StatsRecorder stats;
 };
 
 /// <summary>
 /// Constructor for the CircularQueue. It initializes the front index and size
-/// to 0.
+/// to 0, no element is constructed.
+/// </summary>
+template <typename T, size_t capacity>
+constexpr CircularQueue<T, capacity>::CircularQueue() noexcept
+    : front(0), size(0) {}
+
+/// <summary>
+/// Copy constructor copying elements of the other queue.
+/// </summary>
+/// <param name="other"> queue to be copied.</param>
+template <typename T, size_t capacity>
+constexpr CircularQueue<T, capacity>::CircularQueue(
+    const CircularQueue &other)
+    : front(0), size(0) {
+  Assign(other);
+}
+
+/// <summary>
+/// Move constructor moving elements of the other queue. The other queue
+/// keeps its size, with elements in moved-from state.
+/// </summary>
+/// <param name="other"> queue to be moved.</param>
+template <typename T, size_t capacity>
+constexpr CircularQueue<T, capacity>::CircularQueue(
+    CircularQueue &&other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    : front(0), size(0) {
+  Assign(std::move(other));
+}
+
+/// <summary>
+/// Copy assignment operator replacing elements with copies of elements of
+/// the other queue.
+/// </summary>
+/// <param name="other"> queue to be copied.</param>
+/// <returns> reference to this queue.</returns>
+template <typename T, size_t capacity>
+constexpr CircularQueue<T, capacity> &CircularQueue<T, capacity>::operator=(
+    const CircularQueue &other) {
+  if (this != &other) {
+    Destroy();
+    Assign(other);
+  }
+  return *this;
+}
+
+/// <summary>
+/// Move assignment operator replacing elements with elements moved from the
+/// other queue.
 /// </summary>
+/// <param name="other"> queue to be moved.</param>
+/// <returns> reference to this queue.</returns>
 template <typename T, size_t capacity>
-CircularQueue<T, capacity>::CircularQueue() : front(0), size(0), queue() {}
+constexpr CircularQueue<T, capacity> &CircularQueue<T, capacity>::operator=(
+    CircularQueue &&other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+  if (this != &other) {
+    Destroy();
+    Assign(std::move(other));
+  }
+  return *this;
+}
 
 /// <summary>
 /// Checks if the queue is empty by checking the size value.
@@ -96,7 +206,7 @@ CircularQueue<T, capacity>::CircularQueue() : front(0), size(0), queue() {}
 /// </summary>
 /// <returns> true if empty, false if not.</returns>
 template <typename T, size_t capacity>
-bool CircularQueue<T, capacity>::IsEmpty() const noexcept {
+constexpr bool CircularQueue<T, capacity>::IsEmpty() const noexcept {
   return size == 0;
 }
 
@@ -105,7 +215,7 @@ bool CircularQueue<T, capacity>::IsEmpty() const noexcept {
 /// </summary>
 /// <returns> true if full, false if not</returns>
 template <typename T, size_t capacity>
-bool CircularQueue<T, capacity>::IsFull() const noexcept {
+constexpr bool CircularQueue<T, capacity>::IsFull() const noexcept {
   return size == capacity;
 }
 
@@ -115,12 +225,14 @@ bool CircularQueue<T, capacity>::IsFull() const noexcept {
 /// </summary>
 /// <returns> value of front element in queue.</returns>
 template <typename T, size_t capacity>
-T CircularQueue<T, capacity>::Dequeue() {
+constexpr T CircularQueue<T, capacity>::Dequeue() {
   if (IsEmpty()) {
-    throw std::runtime_error(errors::kEmptyDeletion);
+    ALGLIB_THROW(std::runtime_error(errors::kEmptyDeletion));
   }
-  T result{queue.at(front)};
-  front = (front + 1) % capacity;
+  T *element{queue.elements + front};
+  T result{std::move(*element)};
+  std::destroy_at(element);
+  front = Wrap(front + 1);
   --size;
   return result;
 }
@@ -131,13 +243,25 @@ T CircularQueue<T, capacity>::Dequeue() {
 /// </summary>
 /// <param name="value"> value to be inserted into queue.</param>
 template <typename T, size_t capacity>
-void CircularQueue<T, capacity>::Enqueue(T value) {
-  if (IsFull()) {
-    throw std::runtime_error(errors::kObjectFull);
+constexpr void CircularQueue<T, capacity>::Enqueue(T value) {
+  Emplace(std::move(value));
+}
+
+/// <summary>
+/// Constructs a new element at the rear of the queue from given arguments.
+/// </summary>
+/// <param name="args"> arguments passed to the constructor of T.</param>
+/// <returns> reference to the new element.</returns>
+/// <exception cref="std::runtime_error"> thrown when the queue is
+/// full.</exception>
+template <typename T, size_t capacity>
+template <typename... Args>
+constexpr T &CircularQueue<T, capacity>::Emplace(Args &&...args) {
+  T *element{TryEmplace(std::forward<Args>(args)...)};
+  if (element == nullptr) {
+    ALGLIB_THROW(std::runtime_error(errors::kObjectFull));
   }
-  size_t rear{(front + size) % capacity};
-  queue.at(rear) = value;
-  ++size;
+  return *element;
 }
 
 /// <summary>
@@ -145,11 +269,11 @@ void CircularQueue<T, capacity>::Enqueue(T value) {
 /// </summary>
 /// <returns> value from the front of the queue.</returns>
 template <typename T, size_t capacity>
-T CircularQueue<T, capacity>::PeekFront() const {
+constexpr T CircularQueue<T, capacity>::PeekFront() const {
   if (IsEmpty()) {
-    throw std::runtime_error(errors::kPeekAtEmpty);
+    ALGLIB_THROW(std::runtime_error(errors::kPeekAtEmpty));
   }
-  return queue.at(front);
+  return queue.elements[front];
 }
 
 /// <summary>
@@ -158,12 +282,166 @@ T CircularQueue<T, capacity>::PeekFront() const {
 /// </summary>
 /// <returns> value from the rear of the queue.</returns>
 template <typename T, size_t capacity>
-T CircularQueue<T, capacity>::PeekRear() const {
+constexpr T CircularQueue<T, capacity>::PeekRear() const {
   if (IsEmpty()) {
-    throw std::runtime_error(errors::kPeekAtEmpty);
+    ALGLIB_THROW(std::runtime_error(errors::kPeekAtEmpty));
+  }
+  return queue.elements[Wrap(front + size - 1)];
+}
+
+/// <summary>
+/// Adds a new value to the rear of the queue unless the queue is full.
+/// </summary>
+/// <param name="value"> value to be inserted into queue.</param>
+/// <returns> true if the value was inserted, false if the queue is
+/// full.</returns>
+template <typename T, size_t capacity>
+constexpr bool CircularQueue<T, capacity>::TryEnqueue(T value) {
+  return TryEmplace(std::move(value)) != nullptr;
+}
+
+/// <summary>
+/// Constructs a new element at the rear of the queue from given arguments
+/// unless the queue is full.
+/// </summary>
+/// <param name="args"> arguments passed to the constructor of T.</param>
+/// <returns> pointer to the new element or nullptr if the queue is
+/// full.</returns>
+template <typename T, size_t capacity>
+template <typename... Args>
+constexpr T *CircularQueue<T, capacity>::TryEmplace(Args &&...args) {
+  if (IsFull()) {
+    stats.Rejection();
+    return nullptr;
+  }
+  T *element{std::construct_at(queue.elements + Wrap(front + size),
+                               std::forward<Args>(args)...)};
+  ++size;
+  stats.Size(size);
+  return element;
+}
+
+/// <summary>
+/// Moves the value from the front of the queue into a given object unless
+/// the queue is empty.
+/// </summary>
+/// <param name="value"> object the front value is moved into.</param>
+/// <returns> true if a value was dequeued, false if the queue is
+/// empty.</returns>
+template <typename T, size_t capacity>
+constexpr bool CircularQueue<T, capacity>::TryDequeue(T &value) {
+  if (IsEmpty()) {
+    return false;
+  }
+  T *element{queue.elements + front};
+  value = std::move(*element);
+  std::destroy_at(element);
+  front = Wrap(front + 1);
+  --size;
+  return true;
+}
+
+/// <summary>
+/// Copies the value from the front of the queue into a given object unless
+/// the queue is empty.
+/// </summary>
+/// <param name="value"> object the front value is copied into.</param>
+/// <returns> true if a value was copied, false if the queue is
+/// empty.</returns>
+template <typename T, size_t capacity>
+constexpr bool CircularQueue<T, capacity>::TryPeekFront(T &value) const {
+  if (IsEmpty()) {
+    return false;
+  }
+  value = queue.elements[front];
+  return true;
+}
+
+/// <summary>
+/// Copies the value from the rear of the queue into a given object unless
+/// the queue is empty.
+/// </summary>
+/// <param name="value"> object the rear value is copied into.</param>
+/// <returns> true if a value was copied, false if the queue is
+/// empty.</returns>
+template <typename T, size_t capacity>
+constexpr bool CircularQueue<T, capacity>::TryPeekRear(T &value) const {
+  if (IsEmpty()) {
+    return false;
+  }
+  value = queue.elements[Wrap(front + size - 1)];
+  return true;
+}
+
+/// <summary>
+/// Gets statistics of the queue. It records the biggest size and insertions
+/// rejected because the queue was full. Without ALGLIB_ENABLE_STATS all
+/// counters are zero.
+/// </summary>
+/// <returns> statistics of the queue.</returns>
+template <typename T, size_t capacity>
+ContainerStats CircularQueue<T, capacity>::GetStats() const noexcept {
+  return stats.Get();
+}
+
+/// <summary>
+/// Destructor for the CircularQueue destroying elements that are left.
+/// </summary>
+template <typename T, size_t capacity>
+constexpr CircularQueue<T, capacity>::~CircularQueue() {
+  Destroy();
+}
+
+/// <summary>
+/// Brings an index that went past the end of the array back to its start.
+/// Indexes are never bigger than twice the capacity, so a comparison is
+/// enough instead of a division.
+/// </summary>
+/// <param name="index"> index smaller than twice the capacity.</param>
+/// <returns> index inside of the array.</returns>
+template <typename T, size_t capacity>
+constexpr size_t CircularQueue<T, capacity>::Wrap(size_t index) noexcept {
+  return index < capacity ? index : index - capacity;
+}
+
+/// <summary>
+/// Copies or moves elements of another queue into this empty queue. They
+/// keep their positions in the array. If an element throws, the ones
+/// already made are destroyed and the queue is left empty.
+/// </summary>
+/// <param name="other"> queue whose elements are copied, or moved if it is
+/// an rvalue.</param>
+template <typename T, size_t capacity>
+template <typename Queue>
+constexpr void CircularQueue<T, capacity>::Assign(Queue &&other) {
+  front = other.front;
+  ALGLIB_TRY {
+    for (; size < other.size; ++size) {
+      const size_t index{Wrap(front + size)};
+      if constexpr (std::is_rvalue_reference_v<Queue &&>) {
+        std::construct_at(queue.elements + index,
+                          std::move(other.queue.elements[index]));
+      } else {
+        std::construct_at(queue.elements + index,
+                          other.queue.elements[index]);
+      }
+    }
+  } ALGLIB_CATCH_ALL {
+    Destroy();
+    ALGLIB_RETHROW;
+  }
+}
+
+/// <summary>
+/// Destroys all elements, from the front one, and resets the queue.
+/// </summary>
+template <typename T, size_t capacity>
+constexpr void CircularQueue<T, capacity>::Destroy() noexcept {
+  for (; size > 0; --size) {
+    std::destroy_at(queue.elements + front);
+    front = Wrap(front + 1);
   }
-  size_t rear{(front + size - 1) % capacity};
-  return queue.at(rear);
+  front = 0;
 }
 
 }  // namespace alglib
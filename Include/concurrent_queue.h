@@ -0,0 +1,380 @@
+//*****************************************************************************
+// The MIT License (MIT)
+//
+// Copyright � 2024 Piotr Walczak
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the �Software�), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED �AS IS�, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//*****************************************************************************
+
+//*****************************************************************************
+// File: concurrent_queue.h
+//
+// This file contains the implementation of a lock-free queue that can be
+// used by many producers and consumers at once. It is the Michael-Scott
+// algorithm: a singly linked list with a dummy head node, where threads
+// swing atomic head and tail pointers with compare-and-swap. Removed nodes
+// are released through hazard pointers, and all nodes come from the shared
+// node pool. The class is implemented in the alglib namespace.
+//*****************************************************************************
+
+#ifndef ALGLIB_INCLUDE_CONCURRENTQUEUE_H_
+#define ALGLIB_INCLUDE_CONCURRENTQUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include "constants.h"
+#include "hazard_pointers.h"
+#include "node_pool.h"
+#include "stats.h"
+
+/// <summary>
+/// Default namespace for the AlgLib library.
+/// </summary>
+namespace alglib {
+
+/// <summary>
+/// Lock-free multi-producer, multi-consumer queue with the same interface as
+/// SLLQueue, except PeekFront: the front element may be taken by another
+/// thread at any moment, so it can't be handed out by reference. Elements
+/// are kept in first in, first out order. Enqueue never waits for other
+/// threads; a thread can only be delayed by others that succeed.
+/// </summary>
+/// <typeparam name="T"> type that will be stored in queue.</typeparam>
+template <typename T>
+class ConcurrentQueue {
+ public:
+  // Constructors and assignment operators.
+  ConcurrentQueue();
+  ConcurrentQueue(const ConcurrentQueue &) = delete;
+  ConcurrentQueue &operator=(const ConcurrentQueue &) = delete;
+
+  // Methods for checking state of the queue.
+  bool IsEmpty() const noexcept;
+
+  // Methods for adding elements to the queue.
+  void Enqueue(T value);
+  template <typename InputIt>
+  void EnqueueBulk(InputIt first, InputIt last);
+
+  // Methods for taking elements from the queue.
+  T Dequeue();
+  bool TryDequeue(T &value);
+
+  // Getting statistics of the queue.
+  ContainerStats GetStats() const noexcept;
+
+  // Destructor for the queue.
+  ~ConcurrentQueue();
+
+ private:
+  /// <summary>
+  /// Node of the queue. Value of the dummy node at the front was already
+  /// taken, or never set for the first one, so it is not constructed.
+  /// </summary>
+  struct Node {
+    T *Value() noexcept;
+
+    std::atomic<Node *> next{nullptr};
+    alignas(T) std::byte storage[sizeof(T)];
+  };
+
+  // Methods for allocating and releasing nodes.
+  template <typename... Args>
+  Node *CreateNode(Args &&...args);
+  static void ReleaseNode(void *node) noexcept;
+
+  // Methods linking and unlinking nodes.
+  void Link(Node *first, Node *last);
+  template <typename Consumer>
+  bool Pop(Consumer &&consume);
+
+  /// <summary>
+  /// Dummy node before the first element. Aligned so that consumers and
+  /// producers don't compete for the same cache line.
+  /// </summary>
+  alignas(64) std::atomic<Node *> head;
+
+  /// <summary>
+  /// Last node of the queue, or a node shortly before it while a producer
+  /// is between its two steps.
+  /// </summary>
+  alignas(64) std::atomic<Node *> tail;
+
+  /// <summary>
+  /// Statistics of the queue, empty unless ALGLIB_ENABLE_STATS is defined.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS detail::SharedStatsRecorder stats;
+};
+
+/// <summary>
+/// Gets pointer to the value stored in the node.
+/// </summary>
+template <typename T>
+T *ConcurrentQueue<T>::Node::Value() noexcept {
+  return std::launder(reinterpret_cast<T *>(storage));
+}
+
+/// <summary>
+/// Constructor for the queue creating its dummy node.
+/// </summary>
+template <typename T>
+ConcurrentQueue<T>::ConcurrentQueue() {
+  Node *dummy{CreateNode()};
+  head.store(dummy, std::memory_order_relaxed);
+  tail.store(dummy, std::memory_order_relaxed);
+}
+
+/// <summary>
+/// Method that checks whether the queue has no elements. The answer may be
+/// out of date as soon as it is returned if other threads use the queue.
+/// </summary>
+/// <returns>True if queue had no elements.</returns>
+template <typename T>
+bool ConcurrentQueue<T>::IsEmpty() const noexcept {
+  Node *front{HazardPointers::Protect(0, head)};
+  const bool empty{front->next.load(std::memory_order_acquire) == nullptr};
+  HazardPointers::Clear(0);
+  return empty;
+}
+
+/// <summary>
+/// Method that adds an element at the end of the queue.
+/// </summary>
+/// <param name="value">Value that will be added.</param>
+template <typename T>
+void ConcurrentQueue<T>::Enqueue(T value) {
+  Node *node{CreateNode(std::move(value))};
+  Link(node, node);
+}
+
+/// <summary>
+/// Method that adds a range of elements at the end of the queue. The nodes
+/// are chained first and linked with a single compare-and-swap, so the
+/// elements stay next to each other even with other producers running.
+/// </summary>
+/// <param name="first">Iterator to the first element.</param>
+/// <param name="last">Iterator past the last element.</param>
+template <typename T>
+template <typename InputIt>
+void ConcurrentQueue<T>::EnqueueBulk(InputIt first, InputIt last) {
+  if (first == last) return;
+  Node *chain_first{CreateNode(*first)};
+  Node *chain_last{chain_first};
+  ALGLIB_TRY {
+    for (++first; first != last; ++first) {
+      Node *node{CreateNode(*first)};
+      chain_last->next.store(node, std::memory_order_relaxed);
+      chain_last = node;
+    }
+  } ALGLIB_CATCH_ALL {
+    while (chain_first) {
+      Node *next{chain_first->next.load(std::memory_order_relaxed)};
+      std::destroy_at(chain_first->Value());
+      ReleaseNode(chain_first);
+      stats.Deallocation();
+      chain_first = next;
+    }
+    ALGLIB_RETHROW;
+  }
+  Link(chain_first, chain_last);
+}
+
+/// <summary>
+/// Method that removes the element at the front of the queue and returns it.
+/// </summary>
+/// <returns>Removed element.</returns>
+/// <exception cref="std::runtime_error">Thrown when the queue is
+/// empty.</exception>
+template <typename T>
+T ConcurrentQueue<T>::Dequeue() {
+  std::optional<T> result;
+  if (!Pop([&result](T &&value) { result.emplace(std::move(value)); })) {
+    ALGLIB_THROW(std::runtime_error(errors::kEmptyDeletion));
+  }
+  return std::move(*result);
+}
+
+/// <summary>
+/// Method that removes the element at the front of the queue, if there is
+/// one, without throwing.
+/// </summary>
+/// <param name="value">Variable that the element is moved into.</param>
+/// <returns>True if an element was removed, false if the queue was
+/// empty.</returns>
+template <typename T>
+bool ConcurrentQueue<T>::TryDequeue(T &value) {
+  return Pop([&value](T &&front) { value = std::move(front); });
+}
+
+/// <summary>
+/// Returns statistics of the queue. It records allocated and released nodes
+/// and the biggest number of nodes held at once, which includes the dummy
+/// node. Nodes count as released when they are retired, before their memory
+/// goes back to the pool. Without ALGLIB_ENABLE_STATS all counters are zero.
+/// </summary>
+/// <returns> statistics of the queue.</returns>
+template <typename T>
+ContainerStats ConcurrentQueue<T>::GetStats() const noexcept {
+  return stats.Get();
+}
+
+/// <summary>
+/// Destructor for the queue. It must not run while other threads use the
+/// queue, so the nodes are released right away.
+/// </summary>
+template <typename T>
+ConcurrentQueue<T>::~ConcurrentQueue() {
+  Node *node{head.load(std::memory_order_relaxed)};
+  Node *next{node->next.load(std::memory_order_relaxed)};
+  ReleaseNode(node);
+  stats.Deallocation();
+  while (next) {
+    node = next;
+    next = node->next.load(std::memory_order_relaxed);
+    std::destroy_at(node->Value());
+    ReleaseNode(node);
+    stats.Deallocation();
+  }
+}
+
+/// <summary>
+/// Obtains memory for a node from the shared pool and constructs its value
+/// from given arguments. Without arguments the value is left unconstructed.
+/// </summary>
+/// <returns> pointer to the new node.</returns>
+template <typename T>
+template <typename... Args>
+typename ConcurrentQueue<T>::Node *ConcurrentQueue<T>::CreateNode(
+    Args &&...args) {
+  void *memory{NodePool::Shared().Allocate(sizeof(Node), alignof(Node))};
+  Node *node{::new (memory) Node};
+  if constexpr (sizeof...(Args) > 0) {
+    ALGLIB_TRY {
+      std::construct_at(node->Value(), std::forward<Args>(args)...);
+    } ALGLIB_CATCH_ALL {
+      ReleaseNode(node);
+      ALGLIB_RETHROW;
+    }
+  }
+  stats.NodeAllocation();
+  return node;
+}
+
+/// <summary>
+/// Returns memory of a node to the shared pool. The value has to be
+/// destroyed before.
+/// </summary>
+/// <param name="node"> node created with CreateNode.</param>
+template <typename T>
+void ConcurrentQueue<T>::ReleaseNode(void *node) noexcept {
+  static_cast<Node *>(node)->~Node();
+  NodePool::Shared().Deallocate(node, sizeof(Node), alignof(Node));
+}
+
+/// <summary>
+/// Links a chain of nodes after the last node of the queue. When the tail
+/// pointer lags behind, the thread first helps to move it forward.
+/// </summary>
+/// <param name="first"> first node of the chain.</param>
+/// <param name="last"> last node of the chain.</param>
+template <typename T>
+void ConcurrentQueue<T>::Link(Node *first, Node *last) {
+  while (true) {
+    Node *back{HazardPointers::Protect(0, tail)};
+    Node *next{back->next.load(std::memory_order_acquire)};
+    if (next != nullptr) {
+      tail.compare_exchange_weak(back, next, std::memory_order_release,
+                                 std::memory_order_relaxed);
+      continue;
+    }
+    if (back->next.compare_exchange_weak(next, first,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed)) {
+      tail.compare_exchange_strong(back, last, std::memory_order_release,
+                                   std::memory_order_relaxed);
+      break;
+    }
+  }
+  HazardPointers::Clear(0);
+}
+
+/// <summary>
+/// Unlinks the dummy node at the front, making the node of the first element
+/// the new dummy, and hands the element to a consumer. The old dummy is
+/// retired, as other threads may still read it. Room for it is made before
+/// the head moves, so once the element is taken nothing can throw but the
+/// consumer.
+/// </summary>
+/// <param name="consume"> callable taking the element as T&&.</param>
+/// <returns> true if an element was taken, false if the queue was
+/// empty.</returns>
+template <typename T>
+template <typename Consumer>
+bool ConcurrentQueue<T>::Pop(Consumer &&consume) {
+  HazardPointers::Reserve(1);
+  while (true) {
+    Node *front{HazardPointers::Protect(0, head)};
+    Node *next{front->next.load(std::memory_order_acquire)};
+    HazardPointers::Set(1, next);
+    if (head.load(std::memory_order_seq_cst) != front) continue;
+    if (next == nullptr) {
+      HazardPointers::Clear(0);
+      HazardPointers::Clear(1);
+      return false;
+    }
+    Node *back{tail.load(std::memory_order_acquire)};
+    if (front == back) {
+      tail.compare_exchange_weak(back, next, std::memory_order_release,
+                                 std::memory_order_relaxed);
+      continue;
+    }
+    if (head.compare_exchange_weak(front, next, std::memory_order_acq_rel,
+                                   std::memory_order_relaxed)) {
+      // Only the thread that moved the head may touch the value of the new
+      // dummy, and the hazard slot keeps it alive until the value is gone.
+      T *value{next->Value()};
+      ALGLIB_TRY {
+        consume(std::move(*value));
+      } ALGLIB_CATCH_ALL {
+        std::destroy_at(value);
+        HazardPointers::Clear(0);
+        HazardPointers::Clear(1);
+        HazardPointers::RetireReserved(front, &ReleaseNode);
+        stats.Deallocation();
+        ALGLIB_RETHROW;
+      }
+      std::destroy_at(value);
+      HazardPointers::Clear(0);
+      HazardPointers::Clear(1);
+      HazardPointers::RetireReserved(front, &ReleaseNode);
+      stats.Deallocation();
+      return true;
+    }
+  }
+}
+
+}  // namespace alglib
+
+#endif  // ALGLIB_INCLUDE_CONCURRENTQUEUE_H_
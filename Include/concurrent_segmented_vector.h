@@ -0,0 +1,563 @@
+//*****************************************************************************
+// The MIT License (MIT)
+//
+// Copyright � 2024 Piotr Walczak
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the �Software�), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED �AS IS�, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//*****************************************************************************
+
+//*****************************************************************************
+// File: concurrent_segmented_vector.h
+//
+// This file contains the implementation of an append-only vector that can be
+// used by many threads at once. Elements are stored in segments whose sizes
+// double, and a segment never moves once it is allocated, so references to
+// elements stay valid while other threads keep appending. Appending takes a
+// slot with a single atomic increment and readers check a flag published
+// with the element, so neither side waits for the other. The class is
+// implemented in the alglib namespace.
+//*****************************************************************************
+
+#ifndef ALGLIB_INCLUDE_CONCURRENTSEGMENTEDVECTOR_H_
+#define ALGLIB_INCLUDE_CONCURRENTSEGMENTEDVECTOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "constants.h"
+#include "stats.h"
+#include "traversal.h"
+
+/// <summary>
+/// Default namespace for the AlgLib library.
+/// </summary>
+namespace alglib {
+
+/// <summary>
+/// Lock-free append-only vector for many threads. Every append takes the
+/// next index from an atomic counter, constructs the element in its slot and
+/// then publishes it, so appends on different cores only share the counter.
+/// Segment k holds first_segment * 2^k elements and is allocated by the
+/// first thread that needs it; a thread that loses the race for it frees
+/// its own copy. Elements never move, references to them stay valid until
+/// the vector is destroyed, and a published element can be read by any
+/// thread without locking. Indices are handed out in order, but elements
+/// may be published out of order, so Size counts slots that were taken,
+/// and TryGet and Traverse see only the published ones. If a constructor
+/// throws, its slot is never published.
+/// </summary>
+/// <typeparam name="T"> type of data stored in the vector.</typeparam>
+/// <typeparam name="first_segment"> number of elements in the first
+/// segment, a power of two.</typeparam>
+template <typename T, size_t first_segment = 8>
+class ConcurrentSegmentedVector {
+  static_assert(std::has_single_bit(first_segment),
+                "Size of the first segment has to be a power of two.");
+
+ public:
+  // Constructors and assignment operators.
+  ConcurrentSegmentedVector() noexcept = default;
+  ConcurrentSegmentedVector(const ConcurrentSegmentedVector &) = delete;
+  ConcurrentSegmentedVector &operator=(const ConcurrentSegmentedVector &) =
+      delete;
+
+  // Methods for appending elements.
+  size_t PushBack(T value);
+  template <typename... Args>
+  T &Emplace(Args &&...args);
+  void Reserve(size_t amount);
+
+  // Methods for reading elements.
+  T &operator[](size_t index) noexcept;
+  const T &operator[](size_t index) const noexcept;
+  T &At(size_t index);
+  const T &At(size_t index) const;
+  T *TryGet(size_t index) noexcept;
+  const T *TryGet(size_t index) const noexcept;
+  template <typename Function>
+  bool Traverse(Function &&visit_callback);
+  template <typename Function>
+  bool Traverse(Function &&visit_callback) const;
+
+  // Methods for checking state of the vector.
+  size_t Size() const noexcept;
+  bool IsEmpty() const noexcept;
+
+  // Getting statistics of the vector.
+  ContainerStats GetStats() const noexcept;
+
+  // Destructor for the vector.
+  ~ConcurrentSegmentedVector();
+
+ private:
+  /// <summary>
+  /// Segment of the vector: a block with the elements followed by one
+  /// published flag for each of them.
+  /// </summary>
+  struct Segment {
+    T *elements;
+    std::atomic<bool> *published;
+  };
+
+  /// <summary>
+  /// Position of an element: index of its segment and offset inside it.
+  /// </summary>
+  struct Location {
+    size_t segment;
+    size_t offset;
+  };
+
+  static constexpr size_t kFirstShift{std::countr_zero(first_segment)};
+  static constexpr size_t kMaxSegments{std::numeric_limits<size_t>::digits -
+                                       kFirstShift};
+  static constexpr size_t kAlignment{
+      std::max(alignof(T), alignof(std::atomic<bool>))};
+
+  // Methods calculating positions and sizes of segments.
+  static constexpr Location Locate(size_t index) noexcept;
+  static constexpr size_t SegmentSize(size_t segment) noexcept;
+  static constexpr size_t FlagsOffset(size_t segment) noexcept;
+  static constexpr size_t SegmentBytes(size_t segment) noexcept;
+
+  // Methods for allocating and releasing segments.
+  std::byte *EnsureSegment(size_t segment);
+  static std::byte *CreateSegment(size_t segment);
+  static void ReleaseSegment(std::byte *block, size_t segment) noexcept;
+  static Segment View(std::byte *block, size_t segment) noexcept;
+
+  // Methods finding elements.
+  Segment SegmentOf(Location location) const noexcept;
+  T *Published(size_t index) const noexcept;
+
+  /// <summary>
+  /// Number of slots taken by appending threads. Aligned so that the
+  /// contended counter doesn't share a cache line with the segment table.
+  /// </summary>
+  alignas(64) std::atomic<size_t> size{0};
+
+  /// <summary>
+  /// Blocks of the segments, nullptr for segments not allocated yet.
+  /// </summary>
+  alignas(64) std::atomic<std::byte *> segments[kMaxSegments]{};
+
+  /// <summary>
+  /// Statistics of the vector, empty unless ALGLIB_ENABLE_STATS is defined.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS detail::SharedStatsRecorder stats;
+};
+
+/// <summary>
+/// Method that appends a copy or a moved value to the vector.
+/// </summary>
+/// <param name="value"> value to be appended.</param>
+/// <returns> index of the new element, which stays valid for the lifetime
+/// of the vector.</returns>
+template <typename T, size_t first_segment>
+size_t ConcurrentSegmentedVector<T, first_segment>::PushBack(T value) {
+  const size_t index{size.fetch_add(1, std::memory_order_relaxed)};
+  const Location location{Locate(index)};
+  const Segment segment{
+      View(EnsureSegment(location.segment), location.segment)};
+  std::construct_at(segment.elements + location.offset, std::move(value));
+  segment.published[location.offset].store(true, std::memory_order_release);
+  stats.Size(index + 1);
+  return index;
+}
+
+/// <summary>
+/// Method that appends an element constructed in place from given
+/// arguments.
+/// </summary>
+/// <param name="args"> arguments for the constructor of T.</param>
+/// <returns> reference to the new element, which stays valid for the
+/// lifetime of the vector.</returns>
+template <typename T, size_t first_segment>
+template <typename... Args>
+T &ConcurrentSegmentedVector<T, first_segment>::Emplace(Args &&...args) {
+  const size_t index{size.fetch_add(1, std::memory_order_relaxed)};
+  const Location location{Locate(index)};
+  const Segment segment{
+      View(EnsureSegment(location.segment), location.segment)};
+  T *element{std::construct_at(segment.elements + location.offset,
+                               std::forward<Args>(args)...)};
+  segment.published[location.offset].store(true, std::memory_order_release);
+  stats.Size(index + 1);
+  return *element;
+}
+
+/// <summary>
+/// Method that allocates the segments needed to hold a given number of
+/// elements, so appends up to it don't allocate. It can be called while
+/// other threads append.
+/// </summary>
+/// <param name="amount"> number of elements.</param>
+template <typename T, size_t first_segment>
+void ConcurrentSegmentedVector<T, first_segment>::Reserve(size_t amount) {
+  if (amount == 0) return;
+  const size_t last{Locate(amount - 1).segment};
+  for (size_t segment{}; segment <= last; ++segment) EnsureSegment(segment);
+}
+
+/// <summary>
+/// Method that gets an element without checking whether it was published.
+/// It is safe for indices returned by PushBack on this thread, or handed
+/// over from the appending thread with release and acquire ordering.
+/// </summary>
+/// <param name="index"> index of the element.</param>
+/// <returns> reference to the element.</returns>
+template <typename T, size_t first_segment>
+T &ConcurrentSegmentedVector<T, first_segment>::operator[](
+    size_t index) noexcept {
+  const Location location{Locate(index)};
+  return SegmentOf(location).elements[location.offset];
+}
+
+/// <summary>
+/// Method that gets a constant element without checking whether it was
+/// published.
+/// </summary>
+/// <param name="index"> index of the element.</param>
+/// <returns> constant reference to the element.</returns>
+template <typename T, size_t first_segment>
+const T &ConcurrentSegmentedVector<T, first_segment>::operator[](
+    size_t index) const noexcept {
+  const Location location{Locate(index)};
+  return SegmentOf(location).elements[location.offset];
+}
+
+/// <summary>
+/// Method that gets a published element. If the element wasn't published
+/// yet, an exception is thrown.
+/// </summary>
+/// <param name="index"> index of the element.</param>
+/// <returns> reference to the element.</returns>
+/// <exception cref="std::runtime_error"> thrown when there is no published
+/// element at the index.</exception>
+template <typename T, size_t first_segment>
+T &ConcurrentSegmentedVector<T, first_segment>::At(size_t index) {
+  T *element{Published(index)};
+  if (element == nullptr) {
+    ALGLIB_THROW(std::runtime_error(errors::kIndexOutOfRange));
+  }
+  return *element;
+}
+
+/// <summary>
+/// Method that gets a published constant element. If the element wasn't
+/// published yet, an exception is thrown.
+/// </summary>
+/// <param name="index"> index of the element.</param>
+/// <returns> constant reference to the element.</returns>
+/// <exception cref="std::runtime_error"> thrown when there is no published
+/// element at the index.</exception>
+template <typename T, size_t first_segment>
+const T &ConcurrentSegmentedVector<T, first_segment>::At(size_t index) const {
+  const T *element{Published(index)};
+  if (element == nullptr) {
+    ALGLIB_THROW(std::runtime_error(errors::kIndexOutOfRange));
+  }
+  return *element;
+}
+
+/// <summary>
+/// Method that gets a published element without waiting for appending
+/// threads.
+/// </summary>
+/// <param name="index"> index of the element.</param>
+/// <returns> pointer to the element or nullptr if it wasn't published
+/// yet.</returns>
+template <typename T, size_t first_segment>
+T *ConcurrentSegmentedVector<T, first_segment>::TryGet(size_t index) noexcept {
+  return Published(index);
+}
+
+/// <summary>
+/// Method that gets a published constant element without waiting for
+/// appending threads.
+/// </summary>
+/// <param name="index"> index of the element.</param>
+/// <returns> pointer to the element or nullptr if it wasn't published
+/// yet.</returns>
+template <typename T, size_t first_segment>
+const T *ConcurrentSegmentedVector<T, first_segment>::TryGet(
+    size_t index) const noexcept {
+  return Published(index);
+}
+
+/// <summary>
+/// Method that passes the published elements to a callable by reference, in
+/// order of their indices. Slots taken by threads that haven't published
+/// their elements yet are skipped.
+/// </summary>
+/// <param name="visit_callback"> callable taking T&. When it returns a
+/// value convertible to bool, false stops the traversal.</param>
+/// <returns> true if all published elements were visited.</returns>
+template <typename T, size_t first_segment>
+template <typename Function>
+bool ConcurrentSegmentedVector<T, first_segment>::Traverse(
+    Function &&visit_callback) {
+  const size_t count{size.load(std::memory_order_acquire)};
+  for (size_t index{}; index < count; ++index) {
+    T *element{Published(index)};
+    if (element && !detail::Visit(visit_callback, *element)) return false;
+  }
+  return true;
+}
+
+/// <summary>
+/// Method that passes the published elements to a callable by constant
+/// reference, in order of their indices.
+/// </summary>
+/// <param name="visit_callback"> callable taking const T&. When it returns
+/// a value convertible to bool, false stops the traversal.</param>
+/// <returns> true if all published elements were visited.</returns>
+template <typename T, size_t first_segment>
+template <typename Function>
+bool ConcurrentSegmentedVector<T, first_segment>::Traverse(
+    Function &&visit_callback) const {
+  const size_t count{size.load(std::memory_order_acquire)};
+  for (size_t index{}; index < count; ++index) {
+    const T *element{Published(index)};
+    if (element && !detail::Visit(visit_callback, *element)) return false;
+  }
+  return true;
+}
+
+/// <summary>
+/// Method that returns the number of slots taken by appends. Elements whose
+/// appends are still running are counted, but may not be published yet.
+/// </summary>
+/// <returns> number of taken slots.</returns>
+template <typename T, size_t first_segment>
+size_t ConcurrentSegmentedVector<T, first_segment>::Size() const noexcept {
+  return size.load(std::memory_order_acquire);
+}
+
+/// <summary>
+/// Method that checks whether any slot was taken.
+/// </summary>
+/// <returns> true if the vector is empty, false if not.</returns>
+template <typename T, size_t first_segment>
+bool ConcurrentSegmentedVector<T, first_segment>::IsEmpty() const noexcept {
+  return Size() == 0;
+}
+
+/// <summary>
+/// Method that gets statistics of the vector. It records allocated segments,
+/// including blocks freed right away after another thread installed the same
+/// segment first, and the biggest number of slots taken by appends that
+/// finished. Elements never move, so no reallocations are recorded. Without
+/// ALGLIB_ENABLE_STATS all counters are zero.
+/// </summary>
+/// <returns> statistics of the vector.</returns>
+template <typename T, size_t first_segment>
+ContainerStats ConcurrentSegmentedVector<T, first_segment>::GetStats()
+    const noexcept {
+  return stats.Get();
+}
+
+/// <summary>
+/// Destructor for the vector. Destroys the published elements and releases
+/// all segments. No thread may use the vector at that time.
+/// </summary>
+template <typename T, size_t first_segment>
+ConcurrentSegmentedVector<T, first_segment>::~ConcurrentSegmentedVector() {
+  for (size_t index{}; index < kMaxSegments; ++index) {
+    std::byte *block{segments[index].load(std::memory_order_acquire)};
+    if (block == nullptr) continue;
+    const Segment segment{View(block, index)};
+    for (size_t offset{}; offset < SegmentSize(index); ++offset) {
+      if (segment.published[offset].load(std::memory_order_relaxed)) {
+        std::destroy_at(segment.elements + offset);
+      }
+    }
+    ReleaseSegment(block, index);
+    stats.Deallocation();
+  }
+}
+
+/// <summary>
+/// Method that finds the segment and the offset of an element. Indices are
+/// counted from first_segment, so the segment is the position of the
+/// highest set bit.
+/// </summary>
+/// <param name="index"> index of the element.</param>
+/// <returns> location of the element.</returns>
+template <typename T, size_t first_segment>
+constexpr typename ConcurrentSegmentedVector<T, first_segment>::Location
+ConcurrentSegmentedVector<T, first_segment>::Locate(size_t index) noexcept {
+  const size_t shifted{index + first_segment};
+  const size_t segment{std::bit_width(shifted) - 1 - kFirstShift};
+  return {segment, shifted - (first_segment << segment)};
+}
+
+/// <summary>
+/// Method that calculates the number of elements of a segment.
+/// </summary>
+/// <param name="segment"> index of the segment.</param>
+/// <returns> number of elements.</returns>
+template <typename T, size_t first_segment>
+constexpr size_t ConcurrentSegmentedVector<T, first_segment>::SegmentSize(
+    size_t segment) noexcept {
+  return first_segment << segment;
+}
+
+/// <summary>
+/// Method that calculates where the flags start in the block of a segment.
+/// </summary>
+/// <param name="segment"> index of the segment.</param>
+/// <returns> offset of the flags in bytes.</returns>
+template <typename T, size_t first_segment>
+constexpr size_t ConcurrentSegmentedVector<T, first_segment>::FlagsOffset(
+    size_t segment) noexcept {
+  constexpr size_t kFlagAlignment{alignof(std::atomic<bool>)};
+  const size_t bytes{SegmentSize(segment) * sizeof(T)};
+  return (bytes + kFlagAlignment - 1) / kFlagAlignment * kFlagAlignment;
+}
+
+/// <summary>
+/// Method that calculates the size of the block of a segment.
+/// </summary>
+/// <param name="segment"> index of the segment.</param>
+/// <returns> size of the block in bytes.</returns>
+template <typename T, size_t first_segment>
+constexpr size_t ConcurrentSegmentedVector<T, first_segment>::SegmentBytes(
+    size_t segment) noexcept {
+  return FlagsOffset(segment) +
+         SegmentSize(segment) * sizeof(std::atomic<bool>);
+}
+
+/// <summary>
+/// Method that gets the block of a segment, allocating it if no thread did
+/// it yet. When two threads allocate the same segment at once, the one that
+/// installs its block second frees it and uses the first one.
+/// </summary>
+/// <param name="segment"> index of the segment.</param>
+/// <returns> block of the segment.</returns>
+template <typename T, size_t first_segment>
+std::byte *ConcurrentSegmentedVector<T, first_segment>::EnsureSegment(
+    size_t segment) {
+  std::byte *block{segments[segment].load(std::memory_order_acquire)};
+  if (block) return block;
+  std::byte *created{CreateSegment(segment)};
+  stats.Allocation();
+  if (segments[segment].compare_exchange_strong(block, created,
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_acquire)) {
+    return created;
+  }
+  ReleaseSegment(created, segment);
+  stats.Deallocation();
+  return block;
+}
+
+/// <summary>
+/// Method that allocates the block of a segment and clears its published
+/// flags.
+/// </summary>
+/// <param name="segment"> index of the segment.</param>
+/// <returns> new block.</returns>
+template <typename T, size_t first_segment>
+std::byte *ConcurrentSegmentedVector<T, first_segment>::CreateSegment(
+    size_t segment) {
+  auto *block{static_cast<std::byte *>(::operator new(
+      SegmentBytes(segment), std::align_val_t(kAlignment)))};
+  auto *flags{reinterpret_cast<std::atomic<bool> *>(block +
+                                                     FlagsOffset(segment))};
+  for (size_t offset{}; offset < SegmentSize(segment); ++offset) {
+    std::construct_at(flags + offset, false);
+  }
+  return block;
+}
+
+/// <summary>
+/// Method that releases the block of a segment. Elements in it have to be
+/// destroyed first.
+/// </summary>
+/// <param name="block"> block of the segment.</param>
+/// <param name="segment"> index of the segment.</param>
+template <typename T, size_t first_segment>
+void ConcurrentSegmentedVector<T, first_segment>::ReleaseSegment(
+    std::byte *block, size_t segment) noexcept {
+  ::operator delete(block, SegmentBytes(segment),
+                    std::align_val_t(kAlignment));
+}
+
+/// <summary>
+/// Method that gets the elements and the flags of a block.
+/// </summary>
+/// <param name="block"> block of the segment.</param>
+/// <param name="segment"> index of the segment.</param>
+/// <returns> parts of the segment.</returns>
+template <typename T, size_t first_segment>
+typename ConcurrentSegmentedVector<T, first_segment>::Segment
+ConcurrentSegmentedVector<T, first_segment>::View(std::byte *block,
+                                                  size_t segment) noexcept {
+  return {reinterpret_cast<T *>(block),
+          reinterpret_cast<std::atomic<bool> *>(block +
+                                                FlagsOffset(segment))};
+}
+
+/// <summary>
+/// Method that gets the segment holding an element. The segment has to be
+/// allocated.
+/// </summary>
+/// <param name="location"> location of the element.</param>
+/// <returns> parts of the segment.</returns>
+template <typename T, size_t first_segment>
+typename ConcurrentSegmentedVector<T, first_segment>::Segment
+ConcurrentSegmentedVector<T, first_segment>::SegmentOf(
+    Location location) const noexcept {
+  return View(segments[location.segment].load(std::memory_order_acquire),
+              location.segment);
+}
+
+/// <summary>
+/// Method that finds a published element. The flag is read with acquire
+/// ordering, so the whole element written by the appending thread is
+/// visible after it.
+/// </summary>
+/// <param name="index"> index of the element.</param>
+/// <returns> pointer to the element or nullptr if it wasn't published
+/// yet.</returns>
+template <typename T, size_t first_segment>
+T *ConcurrentSegmentedVector<T, first_segment>::Published(
+    size_t index) const noexcept {
+  if (index >= size.load(std::memory_order_acquire)) return nullptr;
+  const Location location{Locate(index)};
+  std::byte *block{
+      segments[location.segment].load(std::memory_order_acquire)};
+  if (block == nullptr) return nullptr;
+  const Segment segment{View(block, location.segment)};
+  if (!segment.published[location.offset].load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  return segment.elements + location.offset;
+}
+
+}  // namespace alglib
+
+#endif  // ALGLIB_INCLUDE_CONCURRENTSEGMENTEDVECTOR_H_
@@ -0,0 +1,344 @@
+//*****************************************************************************
+// The MIT License (MIT)
+//
+// Copyright � 2024 Piotr Walczak
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the �Software�), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED �AS IS�, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//*****************************************************************************
+
+//*****************************************************************************
+// File: concurrent_stack.h
+//
+// This file contains the implementation of a lock-free stack that can be
+// used by many threads at once. It is the Treiber algorithm: a singly linked
+// list whose top pointer is swung with compare-and-swap. Popped nodes are
+// released through hazard pointers, which also rules out the ABA problem,
+// and all nodes come from the shared node pool. The class is implemented in
+// the alglib namespace.
+//*****************************************************************************
+
+#ifndef ALGLIB_INCLUDE_CONCURRENTSTACK_H_
+#define ALGLIB_INCLUDE_CONCURRENTSTACK_H_
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "constants.h"
+#include "hazard_pointers.h"
+#include "node_pool.h"
+#include "stats.h"
+
+/// <summary>
+/// Default namespace for the AlgLib library.
+/// </summary>
+namespace alglib {
+
+/// <summary>
+/// Lock-free stack for many threads with the same interface as SLLStack.
+/// A node can't be freed or reused while a thread holds a hazard pointer to
+/// it, so a compare-and-swap on the top can't succeed on a recycled address.
+/// For copyable types Pop copies the element and leaves the original in the
+/// node until the node is released, so Top can read it safely at the same
+/// time; move-only types are moved out, and offer no Top.
+/// </summary>
+/// <typeparam name="T"> type of data stored on the stack.</typeparam>
+template <typename T>
+class ConcurrentStack {
+ public:
+  // Constructors and assignment operators.
+  ConcurrentStack() noexcept;
+  ConcurrentStack(const ConcurrentStack &) = delete;
+  ConcurrentStack &operator=(const ConcurrentStack &) = delete;
+
+  // Methods for manipulating the stack.
+  void Push(T val);
+  T Pop();
+  bool TryPop(T &value);
+  template <typename OutputIt>
+  size_t PopAll(OutputIt out);
+  T Top() const
+    requires std::is_copy_constructible_v<T>;
+  bool IsEmpty() const noexcept;
+
+  // Getting statistics of the stack.
+  ContainerStats GetStats() const noexcept;
+
+  // Destructor for the stack.
+  ~ConcurrentStack();
+
+ private:
+  /// <summary>
+  /// Node of the stack. Next pointer doesn't change after the node is
+  /// pushed, so it doesn't have to be atomic.
+  /// </summary>
+  struct Node {
+    T data;
+    Node *next;
+  };
+
+  // Methods for allocating and releasing nodes.
+  static Node *CreateNode(T value);
+  static void ReleaseNode(void *node) noexcept;
+  T Extract(Node *node);
+
+  // Method unlinking the top node.
+  Node *PopNode();
+
+  /// <summary>
+  /// Pointer to the top node of the stack.
+  /// </summary>
+  std::atomic<Node *> top;
+
+  /// <summary>
+  /// Statistics of the stack, empty unless ALGLIB_ENABLE_STATS is defined.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS detail::SharedStatsRecorder stats;
+};
+
+/// <summary>
+/// Constructor for the stack. Initializes the top pointer to nullptr.
+/// </summary>
+template <typename T>
+ConcurrentStack<T>::ConcurrentStack() noexcept : top(nullptr) {}
+
+/// <summary>
+/// Method that pushes a value on the top of the stack.
+/// </summary>
+/// <param name="val"> value to be pushed.</param>
+template <typename T>
+void ConcurrentStack<T>::Push(T val) {
+  Node *node{CreateNode(std::move(val))};
+  stats.NodeAllocation();
+  node->next = top.load(std::memory_order_relaxed);
+  while (!top.compare_exchange_weak(node->next, node,
+                                    std::memory_order_release,
+                                    std::memory_order_relaxed)) {
+  }
+}
+
+/// <summary>
+/// Method that removes the value from the top of the stack and returns it.
+/// </summary>
+/// <returns> value that was on the top of the stack.</returns>
+/// <exception cref="std::runtime_error"> thrown when the stack is
+/// empty.</exception>
+template <typename T>
+T ConcurrentStack<T>::Pop() {
+  HazardPointers::Reserve(1);
+  Node *node{PopNode()};
+  if (node == nullptr) {
+    ALGLIB_THROW(std::runtime_error(errors::kEmptyDeletion));
+  }
+  return Extract(node);
+}
+
+/// <summary>
+/// Method that removes the value from the top of the stack, if there is one,
+/// without throwing.
+/// </summary>
+/// <param name="value"> variable that the value is stored in.</param>
+/// <returns> true if a value was removed, false if the stack was
+/// empty.</returns>
+template <typename T>
+bool ConcurrentStack<T>::TryPop(T &value) {
+  HazardPointers::Reserve(1);
+  Node *node{PopNode()};
+  if (node == nullptr) return false;
+  value = Extract(node);
+  return true;
+}
+
+/// <summary>
+/// Method that detaches the whole stack with a single exchange and writes
+/// its values to an output iterator, from the top one.
+/// </summary>
+/// <param name="out"> iterator the values are written to.</param>
+/// <returns> number of values removed.</returns>
+template <typename T>
+template <typename OutputIt>
+size_t ConcurrentStack<T>::PopAll(OutputIt out) {
+  Node *next{top.exchange(nullptr, std::memory_order_acquire)};
+  size_t count{};
+  ALGLIB_TRY {
+    // Room to retire every node is made up front, so taking a value can't
+    // fail to retire its node.
+    size_t length{};
+    for (Node *node{next}; node; node = node->next) ++length;
+    HazardPointers::Reserve(length);
+    for (; next; ++count) {
+      Node *node{next};
+      next = node->next;
+      *out = Extract(node);
+      ++out;
+    }
+  } ALGLIB_CATCH_ALL {
+    // Threads that saw one of the nodes on the top may still read it, so
+    // the nodes that are left are retired rather than freed.
+    while (next) {
+      Node *node{next};
+      next = node->next;
+      HazardPointers::Retire(node, &ReleaseNode);
+      stats.Deallocation();
+    }
+    ALGLIB_RETHROW;
+  }
+  return count;
+}
+
+/// <summary>
+/// Method that gets a copy of the value from the top of the stack without
+/// removing it.
+/// </summary>
+/// <returns> value that is on the top of the stack.</returns>
+/// <exception cref="std::runtime_error"> thrown when the stack is
+/// empty.</exception>
+template <typename T>
+T ConcurrentStack<T>::Top() const
+  requires std::is_copy_constructible_v<T>
+{
+  Node *node{HazardPointers::Protect(0, top)};
+  if (node == nullptr) {
+    HazardPointers::Clear(0);
+    ALGLIB_THROW(std::runtime_error(errors::kPeekAtEmpty));
+  }
+  ALGLIB_TRY {
+    T result{node->data};
+    HazardPointers::Clear(0);
+    return result;
+  } ALGLIB_CATCH_ALL {
+    HazardPointers::Clear(0);
+    ALGLIB_RETHROW;
+  }
+}
+
+/// <summary>
+/// Method that checks whether the stack is empty. The answer may be out of
+/// date as soon as it is returned if other threads use the stack.
+/// </summary>
+/// <returns> true if empty, false if not.</returns>
+template <typename T>
+bool ConcurrentStack<T>::IsEmpty() const noexcept {
+  return top.load(std::memory_order_acquire) == nullptr;
+}
+
+/// <summary>
+/// Returns statistics of the stack. It records allocated and released nodes
+/// and the biggest number of nodes held at once. Nodes count as released
+/// when they are retired, before their memory goes back to the pool. Without
+/// ALGLIB_ENABLE_STATS all counters are zero.
+/// </summary>
+/// <returns> statistics of the stack.</returns>
+template <typename T>
+ContainerStats ConcurrentStack<T>::GetStats() const noexcept {
+  return stats.Get();
+}
+
+/// <summary>
+/// Destructor for the stack. It must not run while other threads use the
+/// stack, so the nodes are released right away.
+/// </summary>
+template <typename T>
+ConcurrentStack<T>::~ConcurrentStack() {
+  Node *node{top.load(std::memory_order_relaxed)};
+  while (node) {
+    Node *next{node->next};
+    ReleaseNode(node);
+    stats.Deallocation();
+    node = next;
+  }
+}
+
+/// <summary>
+/// Obtains memory for a node from the shared pool and constructs it.
+/// </summary>
+/// <param name="value"> value that will be stored in node.</param>
+/// <returns> pointer to the new node.</returns>
+template <typename T>
+typename ConcurrentStack<T>::Node *ConcurrentStack<T>::CreateNode(T value) {
+  void *memory{NodePool::Shared().Allocate(sizeof(Node), alignof(Node))};
+  ALGLIB_TRY {
+    return ::new (memory) Node{std::move(value), nullptr};
+  } ALGLIB_CATCH_ALL {
+    NodePool::Shared().Deallocate(memory, sizeof(Node), alignof(Node));
+    ALGLIB_RETHROW;
+  }
+}
+
+/// <summary>
+/// Destroys a node together with its value and returns its memory to the
+/// shared pool.
+/// </summary>
+/// <param name="node"> node created with CreateNode.</param>
+template <typename T>
+void ConcurrentStack<T>::ReleaseNode(void *node) noexcept {
+  static_cast<Node *>(node)->~Node();
+  NodePool::Shared().Deallocate(node, sizeof(Node), alignof(Node));
+}
+
+/// <summary>
+/// Takes the value of an unlinked node and retires the node. The value is
+/// copied when possible, so that threads reading it in Top are not
+/// disturbed. The caller has to make room for the node with
+/// HazardPointers::Reserve.
+/// </summary>
+/// <param name="node"> node removed from the stack.</param>
+/// <returns> value of the node.</returns>
+template <typename T>
+T ConcurrentStack<T>::Extract(Node *node) {
+  // Retires the node once the value is taken, also if taking it throws.
+  struct Retirer {
+    ~Retirer() noexcept {
+      HazardPointers::RetireReserved(node, &ReleaseNode);
+    }
+    Node *node;
+  } retirer{node};
+  stats.Deallocation();
+  if constexpr (std::is_copy_constructible_v<T>) {
+    return std::as_const(node->data);
+  } else {
+    return std::move(node->data);
+  }
+}
+
+/// <summary>
+/// Unlinks the top node. The top is protected by a hazard pointer while its
+/// next pointer is read and swapped in, so the node can't be released and
+/// pushed again in the meantime.
+/// </summary>
+/// <returns> unlinked node, or nullptr if the stack was empty.</returns>
+template <typename T>
+typename ConcurrentStack<T>::Node *ConcurrentStack<T>::PopNode() {
+  Node *node{HazardPointers::Protect(0, top)};
+  while (node &&
+         !top.compare_exchange_weak(node, node->next,
+                                    std::memory_order_acquire,
+                                    std::memory_order_relaxed)) {
+    node = HazardPointers::Protect(0, top);
+  }
+  HazardPointers::Clear(0);
+  return node;
+}
+
+}  // namespace alglib
+
+#endif  // ALGLIB_INCLUDE_CONCURRENTSTACK_H_
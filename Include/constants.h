@@ -25,14 +25,45 @@
 //*****************************************************************************
 // File: array_stack.h
 //
-// This file contains constant values that are used in the library.
+// This file contains constant values, error reporting macros and portability
+// macros that are used in the library.
 //*****************************************************************************
 
 #ifndef ALGLIB_INCLUDE_CONSTANTS_H_
 #define ALGLIB_INCLUDE_CONSTANTS_H_
 
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
 #include <string>
 
+// Macros for reporting errors. When exceptions are disabled, for example with
+// -fno-exceptions, errors print their message and abort the program instead
+// of throwing, try blocks always run and catch blocks are never entered.
+// Errors that callers expect on the hot path have non-throwing Try* methods.
+#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+#define ALGLIB_EXCEPTIONS 1
+#define ALGLIB_THROW(exception) throw exception
+#define ALGLIB_TRY try
+#define ALGLIB_CATCH_ALL catch (...)
+#define ALGLIB_RETHROW throw
+#else
+#define ALGLIB_EXCEPTIONS 0
+#define ALGLIB_THROW(exception) ::alglib::errors::Abort(exception)
+#define ALGLIB_TRY if (true)
+#define ALGLIB_CATCH_ALL if (false)
+#define ALGLIB_RETHROW std::abort()
+#endif
+
+// Attribute letting empty members like allocators, comparators and disabled
+// statistics take no space. MSVC accepts the standard spelling but ignores
+// it, so its own attribute is used there.
+#if defined(_MSC_VER)
+#define ALGLIB_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define ALGLIB_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
 /// <summary>
 /// Default namespace for the AlgLib library.
 /// </summary>
@@ -50,6 +81,24 @@ inline constexpr const char* kEmptyDeletion{"Cannot delete from empty object."};
 inline constexpr const char* kObjectFull{"Object full."};
 inline constexpr const char* kObjectEmpty{"Object empty."};
 inline constexpr const char* kPeekAtEmpty{"Cannot peek at empty objects."};
+inline constexpr const char* kReadOnlyObject{"Cannot modify read-only object."};
+inline constexpr const char* kMappingFailed{"Memory mapping failed."};
+inline constexpr const char* kMisalignedFile{
+    "File size is not a multiple of element size."};
+inline constexpr const char* kAllocatorMismatch{
+    "Objects use allocators that are not equal."};
+inline constexpr const char* kUnsortedInput{
+    "Input is not sorted in strictly increasing order."};
+
+/// <summary>
+/// Reports an error when exceptions are disabled. The message of the
+/// exception that would be thrown is printed to stderr before aborting.
+/// </summary>
+/// <param name="error"> exception describing the error.</param>
+[[noreturn]] inline void Abort(const std::exception &error) noexcept {
+  std::fprintf(stderr, "alglib: %s\n", error.what());
+  std::abort();
+}
 
 }  // namespace errors
 
@@ -37,10 +37,18 @@
 #ifndef ALGLIB_INCLUDE_DOUBLYLINKEDLIST_H_
 #define ALGLIB_INCLUDE_DOUBLYLINKEDLIST_H_
 
+#include <cstddef>
 #include <cstdlib>
 #include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <vector>
 
 #include "constants.h"
+#include "stats.h"
+#include "traversal.h"
 
 /// <summary>
 /// Default namespace for the AlgLib library.
@@ -49,31 +57,112 @@ namespace alglib {
 
 /// <summary>
 /// Template based doubly linked list implementation. All nodes are
-/// dynamically allocated.
+/// dynamically allocated through the allocator, which is rebound to the
+/// internal node type. The list keeps the number of nodes, so positions given
+/// by index are reached by walking from the closer end of the list. Iterators
+/// allow inserting and erasing nodes in constant time.
 /// </summary>
-template <typename T>
+/// <typeparam name="T"> type of data stored in list.</typeparam>
+/// <typeparam name="Allocator"> allocator used to obtain memory for
+/// nodes.</typeparam>
+template <typename T, typename Allocator = std::allocator<T>>
 class DoublyLinkedList {
+  struct Node;
+
  public:
-  // Constructor for the doubly linked list.
+  /// <summary>
+  /// Bidirectional iterator over nodes of the list. It stays valid until the
+  /// node it points to is erased. Const qualified type makes a constant
+  /// iterator.
+  /// </summary>
+  /// <typeparam name="Value"> type of data the iterator gives access
+  /// to.</typeparam>
+  template <typename Value>
+  class Iter {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::remove_cv_t<Value>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value *;
+    using reference = Value &;
+
+    // Constructors
+    Iter() noexcept;
+    template <typename OtherValue>
+      requires std::is_convertible_v<OtherValue *, Value *>
+    Iter(const Iter<OtherValue> &other) noexcept;
+
+    // Access operators
+    reference operator*() const noexcept;
+    pointer operator->() const noexcept;
+
+    // Moving operators
+    Iter &operator++() noexcept;
+    Iter operator++(int) noexcept;
+    Iter &operator--() noexcept;
+    Iter operator--(int) noexcept;
+
+    // Comparison operator, inequality is generated from it.
+    bool operator==(const Iter &other) const noexcept;
+
+   private:
+    friend class DoublyLinkedList;
+    template <typename OtherValue>
+    friend class Iter;
+
+    Iter(Node *node, const DoublyLinkedList *list) noexcept;
+
+    // Node the iterator points to, nullptr for the past the end iterator.
+    Node *node_;
+    // List that the node belongs to, used to step back from the end.
+    const DoublyLinkedList *list_;
+  };
+
+  using Iterator = Iter<T>;
+  using ConstIterator = Iter<const T>;
+
+  // Constructors for the doubly linked list.
   DoublyLinkedList();
+  explicit DoublyLinkedList(const Allocator &allocator);
 
   // Methods for exploring the doubly linked list.
-  void Traverse(const std::function<void(T)> &visit_callback) noexcept;
+  template <typename Function>
+  bool Traverse(Function &&visit_callback);
+  template <typename Function>
+  bool Traverse(Function &&visit_callback) const;
   size_t Size() const noexcept;
-  size_t Find(const T value) const;
+  ContainerStats GetStats() const noexcept;
+  Iterator Find(const T &value) noexcept;
+  ConstIterator Find(const T &value) const noexcept;
 
   // Method for converting the doubly linked list to a vector.
   std::vector<T> GetAsVector() const noexcept;
 
+  // Iterators
+  Iterator begin() noexcept;
+  Iterator end() noexcept;
+  ConstIterator begin() const noexcept;
+  ConstIterator end() const noexcept;
+  ConstIterator cbegin() const noexcept;
+  ConstIterator cend() const noexcept;
+  size_t size() const noexcept;
+
   // Methods for inserting elements into the doubly linked list.
   void InsertAtBeginning(const T data) noexcept;
   void InsertAtEnd(const T data) noexcept;
   void InsertAtPosition(const uint32_t pos, const T data);
+  Iterator InsertBefore(ConstIterator pos, T data);
 
   // Methods for deleting elements from the doubly linked list.
   void DeleteAtBeginning();
   void DeleteAtEnd();
   void DeleteAtPosition(uint32_t pos);
+  Iterator Erase(ConstIterator pos);
+  template <typename Predicate>
+  size_t RemoveIf(Predicate predicate);
+
+  // Method for moving a node between positions or lists without copying it.
+  void Splice(ConstIterator pos, DoublyLinkedList &other, ConstIterator it);
 
   // Method for checking if the doubly linked list is empty.
   bool IsEmpty() const noexcept;
@@ -95,56 +184,220 @@ class DoublyLinkedList {
     T data;
   };
 
+  using NodeAllocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Node>;
+  using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+  // Methods for allocating and releasing nodes.
+  Node *CreateNode(T value);
+  void DestroyNode(Node *node) noexcept;
+
+  // Method for reaching a node by index from the closer end.
+  Node *NodeAt(size_t pos) const noexcept;
+
   // Head and tail pointers for the doubly linked list.
   Node *head_;
   Node *tail_;
+
+  // Number of nodes in the doubly linked list.
+  size_t size_;
+
+  // Allocator that provides memory for the nodes.
+  ALGLIB_NO_UNIQUE_ADDRESS NodeAllocator node_allocator_;
+
+  // Statistics of the list, empty unless ALGLIB_ENABLE_STATS is defined.
+  ALGLIB_NO_UNIQUE_ADDRESS detail::StatsRecorder stats_;
 };
 
+/// <summary>
+/// Default constructor creating iterator that doesn't point to any node.
+/// </summary>
+template <typename T, typename Allocator>
+template <typename Value>
+DoublyLinkedList<T, Allocator>::Iter<Value>::Iter() noexcept
+    : node_(nullptr), list_(nullptr) {}
+
+/// <summary>
+/// Converting constructor, used to make constant iterator from a mutable one.
+/// </summary>
+template <typename T, typename Allocator>
+template <typename Value>
+template <typename OtherValue>
+  requires std::is_convertible_v<OtherValue *, Value *>
+DoublyLinkedList<T, Allocator>::Iter<Value>::Iter(
+    const Iter<OtherValue> &other) noexcept
+    : node_(other.node_), list_(other.list_) {}
+
+/// <summary>
+/// Constructor used by the list to make iterator pointing to a given node.
+/// </summary>
+/// <param name="node"> node or nullptr for the past the end iterator.</param>
+/// <param name="list"> list that the node belongs to.</param>
+template <typename T, typename Allocator>
+template <typename Value>
+DoublyLinkedList<T, Allocator>::Iter<Value>::Iter(
+    Node *node, const DoublyLinkedList *list) noexcept
+    : node_(node), list_(list) {}
+
+/// <summary>
+/// Gets the value stored in the node.
+/// </summary>
+template <typename T, typename Allocator>
+template <typename Value>
+typename DoublyLinkedList<T, Allocator>::template Iter<Value>::reference
+DoublyLinkedList<T, Allocator>::Iter<Value>::operator*() const noexcept {
+  return node_->data;
+}
+
+/// <summary>
+/// Gives access to members of the value stored in the node.
+/// </summary>
+template <typename T, typename Allocator>
+template <typename Value>
+typename DoublyLinkedList<T, Allocator>::template Iter<Value>::pointer
+DoublyLinkedList<T, Allocator>::Iter<Value>::operator->() const noexcept {
+  return &node_->data;
+}
+
+/// <summary>
+/// Pre-increment. Makes the iterator point to the next node.
+/// </summary>
+template <typename T, typename Allocator>
+template <typename Value>
+typename DoublyLinkedList<T, Allocator>::template Iter<Value> &
+DoublyLinkedList<T, Allocator>::Iter<Value>::operator++() noexcept {
+  node_ = node_->next;
+  return *this;
+}
+
+/// <summary>
+/// Post-increment. Makes the iterator point to the next node.
+/// </summary>
+template <typename T, typename Allocator>
+template <typename Value>
+typename DoublyLinkedList<T, Allocator>::template Iter<Value>
+DoublyLinkedList<T, Allocator>::Iter<Value>::operator++(int) noexcept {
+  Iter tmp{*this};
+  node_ = node_->next;
+  return tmp;
+}
+
+/// <summary>
+/// Pre-decrement. Makes the iterator point to the previous node. Past the end
+/// iterator moves to the last node.
+/// </summary>
+template <typename T, typename Allocator>
+template <typename Value>
+typename DoublyLinkedList<T, Allocator>::template Iter<Value> &
+DoublyLinkedList<T, Allocator>::Iter<Value>::operator--() noexcept {
+  node_ = node_ ? node_->previous : list_->tail_;
+  return *this;
+}
+
+/// <summary>
+/// Post-decrement. Makes the iterator point to the previous node. Past the
+/// end iterator moves to the last node.
+/// </summary>
+template <typename T, typename Allocator>
+template <typename Value>
+typename DoublyLinkedList<T, Allocator>::template Iter<Value>
+DoublyLinkedList<T, Allocator>::Iter<Value>::operator--(int) noexcept {
+  Iter tmp{*this};
+  --*this;
+  return tmp;
+}
+
+/// <summary>
+/// Checks whether two iterators point to the same node.
+/// </summary>
+template <typename T, typename Allocator>
+template <typename Value>
+bool DoublyLinkedList<T, Allocator>::Iter<Value>::operator==(
+    const Iter &other) const noexcept {
+  return node_ == other.node_;
+}
+
 /// <summary>
 /// Constructor for the Node structure. It initializes the data of the node
 /// with the given data and sets the next and previous pointers to nullptr.
 /// </summary>
 /// <param name="data"> Value that will be set as node value.</param>
-template <typename T>
-DoublyLinkedList<T>::Node::Node(const T data)
-    : next(nullptr), previous(nullptr), data(data) {}
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::Node::Node(T data)
+    : next(nullptr), previous(nullptr), data(std::move(data)) {}
 
 /// <summary>
 /// Constructor for the doubly linked list. It initializes the head and tail
 /// pointers to nullptr.
 /// </summary>
-template <typename T>
-DoublyLinkedList<T>::DoublyLinkedList() : head_(nullptr), tail_(nullptr) {}
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::DoublyLinkedList()
+    : head_(nullptr), tail_(nullptr), size_(0), node_allocator_() {}
+
+/// <summary>
+/// Constructor for the doubly linked list that takes nodes from a given
+/// allocator. It initializes the head and tail pointers to nullptr.
+/// </summary>
+/// <param name="allocator"> allocator used for the nodes.</param>
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::DoublyLinkedList(const Allocator &allocator)
+    : head_(nullptr), tail_(nullptr), size_(0), node_allocator_(allocator) {}
 
 /// <summary>
 /// Method for traversing the doubly linked list. It starts at the head of the
-/// list and moves to the next node until the end of the list is reached.
+/// list and passes the data of each node to a callable by reference. The
+/// callable is a template parameter, so the call can be inlined into the
+/// loop over the nodes.
 /// </summary>
-template <typename T>
-void DoublyLinkedList<T>::Traverse(
-    const std::function<void(T)> &visit_callback) noexcept {
-  Node *tmp{head_};
-  while (tmp) {
-    visit_callback(tmp->data);
-    tmp = tmp->next;
+/// <param name="visit_callback">Callable taking T&. When it returns a value
+/// convertible to bool, false stops the traversal.</param>
+/// <returns>True if all nodes were visited.</returns>
+template <typename T, typename Allocator>
+template <typename Function>
+bool DoublyLinkedList<T, Allocator>::Traverse(Function &&visit_callback) {
+  for (Node *tmp{head_}; tmp; tmp = tmp->next) {
+    if (!detail::Visit(visit_callback, tmp->data)) return false;
   }
+  return true;
 }
 
 /// <summary>
-/// Method for calculating the number of elements in the doubly linked list.
-/// It starts at the head of the list and moves to the next node until the end
-/// of the list is reached.
+/// Method for traversing the constant doubly linked list. It passes the data
+/// of each node to a callable by constant reference.
 /// </summary>
-/// <returns> Number of nodes in list.</returns>
-template <typename T>
-size_t DoublyLinkedList<T>::Size() const noexcept {
-  Node *tmp{head_};
-  size_t count{};
-  while (tmp) {
-    ++count;
-    tmp = tmp->next;
+/// <param name="visit_callback">Callable taking const T&. When it returns a
+/// value convertible to bool, false stops the traversal.</param>
+/// <returns>True if all nodes were visited.</returns>
+template <typename T, typename Allocator>
+template <typename Function>
+bool DoublyLinkedList<T, Allocator>::Traverse(
+    Function &&visit_callback) const {
+  for (const Node *tmp{head_}; tmp; tmp = tmp->next) {
+    if (!detail::Visit(visit_callback, tmp->data)) return false;
   }
-  return count;
+  return true;
+}
+
+/// <summary>
+/// Method for getting the number of elements in the doubly linked list. The
+/// count is kept up to date by all modifying methods.
+/// </summary>
+/// <returns> Number of nodes in list.</returns>
+template <typename T, typename Allocator>
+size_t DoublyLinkedList<T, Allocator>::Size() const noexcept {
+  return size_;
+}
+
+/// <summary>
+/// Method for getting statistics of the doubly linked list. It records
+/// allocated and released nodes and the biggest size, which includes nodes
+/// spliced from other lists. Without ALGLIB_ENABLE_STATS all counters are
+/// zero.
+/// </summary>
+/// <returns> Statistics of the list.</returns>
+template <typename T, typename Allocator>
+ContainerStats DoublyLinkedList<T, Allocator>::GetStats() const noexcept {
+  return stats_.Get();
 }
 
 /// <summary>
@@ -152,20 +405,28 @@ size_t DoublyLinkedList<T>::Size() const noexcept {
 /// of the list and moves to the next node until the end of the list is reached.
 /// </summary>
 /// <param name="value"> Value that list is searched for.</param>
-/// <returns> Index of element if found. (0 - first).</returns>
-template <typename T>
-size_t DoublyLinkedList<T>::Find(const T value) const {
+/// <returns> Iterator to the first node holding the value or end() if the
+/// value is not in the list.</returns>
+template <typename T, typename Allocator>
+typename DoublyLinkedList<T, Allocator>::Iterator
+DoublyLinkedList<T, Allocator>::Find(const T &value) noexcept {
   Node *tmp{head_};
-  size_t count{};
-  while (tmp && tmp->data != value) {
-    ++count;
-    tmp = tmp->next;
-  }
-  if (tmp == nullptr) {
-    throw std::runtime_error(errors::kItemNotFound);
-  } else {
-    return count;
-  }
+  while (tmp && tmp->data != value) tmp = tmp->next;
+  return Iterator(tmp, this);
+}
+
+/// <summary>
+/// Method for finding a value in the constant doubly linked list.
+/// </summary>
+/// <param name="value"> Value that list is searched for.</param>
+/// <returns> Constant iterator to the first node holding the value or end()
+/// if the value is not in the list.</returns>
+template <typename T, typename Allocator>
+typename DoublyLinkedList<T, Allocator>::ConstIterator
+DoublyLinkedList<T, Allocator>::Find(const T &value) const noexcept {
+  Node *tmp{head_};
+  while (tmp && tmp->data != value) tmp = tmp->next;
+  return ConstIterator(tmp, this);
 }
 
 /// <summary>
@@ -177,10 +438,10 @@ size_t DoublyLinkedList<T>::Find(const T value) const {
 /// point of the doubly linked list.
 /// </summary>
 /// <returns>Doubly linked list as vector.</returns>
-template <typename T>
-std::vector<T> DoublyLinkedList<T>::GetAsVector() const noexcept {
+template <typename T, typename Allocator>
+std::vector<T> DoublyLinkedList<T, Allocator>::GetAsVector() const noexcept {
   std::vector<T> vec{};
-  vec.reserve(Size());
+  vec.reserve(size_);
   Node *tmp{head_};
   while (tmp) {
     vec.emplace_back(tmp->data);
@@ -189,6 +450,69 @@ std::vector<T> DoublyLinkedList<T>::GetAsVector() const noexcept {
   return vec;
 }
 
+/// <summary>
+/// Returns iterator to the first node.
+/// </summary>
+template <typename T, typename Allocator>
+typename DoublyLinkedList<T, Allocator>::Iterator
+DoublyLinkedList<T, Allocator>::begin() noexcept {
+  return Iterator(head_, this);
+}
+
+/// <summary>
+/// Returns iterator to the position past the last node.
+/// </summary>
+template <typename T, typename Allocator>
+typename DoublyLinkedList<T, Allocator>::Iterator
+DoublyLinkedList<T, Allocator>::end() noexcept {
+  return Iterator(nullptr, this);
+}
+
+/// <summary>
+/// Returns constant iterator to the first node.
+/// </summary>
+template <typename T, typename Allocator>
+typename DoublyLinkedList<T, Allocator>::ConstIterator
+DoublyLinkedList<T, Allocator>::begin() const noexcept {
+  return ConstIterator(head_, this);
+}
+
+/// <summary>
+/// Returns constant iterator to the position past the last node.
+/// </summary>
+template <typename T, typename Allocator>
+typename DoublyLinkedList<T, Allocator>::ConstIterator
+DoublyLinkedList<T, Allocator>::end() const noexcept {
+  return ConstIterator(nullptr, this);
+}
+
+/// <summary>
+/// Returns constant iterator to the first node.
+/// </summary>
+template <typename T, typename Allocator>
+typename DoublyLinkedList<T, Allocator>::ConstIterator
+DoublyLinkedList<T, Allocator>::cbegin() const noexcept {
+  return begin();
+}
+
+/// <summary>
+/// Returns constant iterator to the position past the last node.
+/// </summary>
+template <typename T, typename Allocator>
+typename DoublyLinkedList<T, Allocator>::ConstIterator
+DoublyLinkedList<T, Allocator>::cend() const noexcept {
+  return end();
+}
+
+/// <summary>
+/// Returns number of nodes under the name used by std::ranges::size, which
+/// makes the list a sized range.
+/// </summary>
+template <typename T, typename Allocator>
+size_t DoublyLinkedList<T, Allocator>::size() const noexcept {
+  return size_;
+}
+
 /// <summary>
 /// Method for inserting a new node at the beginning of the doubly linked list.
 /// It creates a new node with the given data and sets the next pointer of the
@@ -196,17 +520,9 @@ std::vector<T> DoublyLinkedList<T>::GetAsVector() const noexcept {
 /// previous pointer of the head node to the new node.
 /// </summary>
 /// <param name="data">Value that will be inserted.</param>
-template <typename T>
-void DoublyLinkedList<T>::InsertAtBeginning(const T data) noexcept {
-  Node *new_node{new Node(data)};
-  if (IsEmpty()) {
-    head_ = new_node;
-    tail_ = new_node;
-  } else {
-    new_node->next = head_;
-    head_->previous = new_node;
-    head_ = new_node;
-  }
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::InsertAtBeginning(const T data) noexcept {
+  InsertBefore(begin(), data);
 }
 
 /// <summary>
@@ -216,53 +532,56 @@ void DoublyLinkedList<T>::InsertAtBeginning(const T data) noexcept {
 /// head pointer to the new node.
 /// </summary>
 /// <param name="data">Value that will be inserted.</param>
-template <typename T>
-void DoublyLinkedList<T>::InsertAtEnd(const T data) noexcept {
-  Node *new_node{new Node(data)};
-  if (IsEmpty()) {
-    head_ = new_node;
-    tail_ = new_node;
-  } else {
-    tail_->next = new_node;
-    new_node->previous = tail_;
-    tail_ = new_node;
-  }
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::InsertAtEnd(const T data) noexcept {
+  InsertBefore(end(), data);
 }
 
 /// <summary>
 /// Method for inserting a new node at the given position in the doubly linked
-/// list. If the position is 0, insert at the beginning. If the position is
-/// equal to the size, insert at the end. Otherwise, link it into the middle. If
-/// pos is out of range, an exception is thrown.
+/// list. The node that will follow the new one is reached by walking from the
+/// closer end of the list. If pos is out of range, an exception is thrown.
 /// </summary>
 /// <param name="pos">Position to insert the data (0-based index).</param>
 /// <param name="data">Value that will be inserted.</param>
-template <typename T>
-void DoublyLinkedList<T>::InsertAtPosition(const uint32_t pos, const T data) {
-  const size_t current_size{Size()};
-  if (pos > current_size) {
-    throw std::runtime_error(errors::kIndexOutOfRange);
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::InsertAtPosition(const uint32_t pos,
+                                                      const T data) {
+  if (pos > size_) {
+    ALGLIB_THROW(std::runtime_error(errors::kIndexOutOfRange));
   }
-  if (pos == 0) {
-    InsertAtBeginning(data);
-    return;
-  }
-  if (pos == current_size) {
-    InsertAtEnd(data);
-    return;
-  }
-  Node *new_node = new Node(data);
-  Node *prev_node = head_;
-  for (uint32_t i{}; i < pos - 1; ++i) {
-    prev_node = prev_node->next;
-  }
-  Node *next_node{prev_node->next};
+  InsertBefore(ConstIterator(NodeAt(pos), this), data);
+}
+
+/// <summary>
+/// Method for inserting a new node before the node that an iterator points
+/// to. It only relinks the neighbours, so it takes constant time.
+/// </summary>
+/// <param name="pos">Iterator to the node that will follow the new one, end()
+/// appends the node.</param>
+/// <param name="data">Value that will be inserted.</param>
+/// <returns>Iterator to the inserted node.</returns>
+template <typename T, typename Allocator>
+typename DoublyLinkedList<T, Allocator>::Iterator
+DoublyLinkedList<T, Allocator>::InsertBefore(ConstIterator pos, T data) {
+  Node *new_node{CreateNode(std::move(data))};
+  Node *next_node{pos.node_};
+  Node *prev_node{next_node ? next_node->previous : tail_};
   new_node->next = next_node;
   new_node->previous = prev_node;
-  prev_node->next = new_node;
+  if (prev_node) {
+    prev_node->next = new_node;
+  } else {
+    head_ = new_node;
+  }
   if (next_node) {
     next_node->previous = new_node;
+  } else {
+    tail_ = new_node;
   }
+  ++size_;
+  stats_.Size(size_);
+  return Iterator(new_node, this);
 }
 
 /// <summary>
@@ -270,21 +589,12 @@ void DoublyLinkedList<T>::InsertAtPosition(const uint32_t pos, const T data) {
 /// is empty, an exception is thrown. If the list has only one node, the node
 /// is deleted and the head pointer is set to nullptr.
 /// </summary>
-template <typename T>
-void DoublyLinkedList<T>::DeleteAtBeginning() {
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::DeleteAtBeginning() {
   if (IsEmpty()) {
-    throw std::runtime_error(errors::kEmptyDeletion);
-  }
-  if (head_ == tail_) {
-    delete head_;
-    head_ = nullptr;
-    tail_ = nullptr;
-  } else {
-    Node *tmp{head_};
-    head_ = head_->next;
-    head_->previous = nullptr;
-    delete tmp;
+    ALGLIB_THROW(std::runtime_error(errors::kEmptyDeletion));
   }
+  Erase(begin());
 }
 
 /// <summary>
@@ -292,71 +602,155 @@ void DoublyLinkedList<T>::DeleteAtBeginning() {
 /// empty, an exception is thrown. If the list has only one node, the node is
 /// deleted and the head pointer is set to nullptr
 /// </summary>
-template <typename T>
-void DoublyLinkedList<T>::DeleteAtEnd() {
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::DeleteAtEnd() {
   if (IsEmpty()) {
-    throw std::runtime_error(errors::kEmptyDeletion);
-  }
-  if (head_ == tail_) {
-    delete head_;
-    head_ = nullptr;
-    tail_ = nullptr;
-  } else {
-    Node *tmp{tail_};
-    tail_ = tail_->previous;
-    tail_->next = nullptr;
-    delete tmp;
+    ALGLIB_THROW(std::runtime_error(errors::kEmptyDeletion));
   }
+  Erase(ConstIterator(tail_, this));
 }
 
 /// <summary>
-/// Deletes the node at the given position in the doubly linked list. If the
-/// list is empty, an exception is thrown. If the position is out of range, an
+/// Deletes the node at the given position in the doubly linked list. The node
+/// is reached by walking from the closer end of the list. If the list is
+/// empty, an exception is thrown. If the position is out of range, an
 /// exception is thrown.
 /// </summary>
 /// <param name="pos">Position of node to delete (0 - first).</param>
-template <typename T>
-void DoublyLinkedList<T>::DeleteAtPosition(uint32_t pos) {
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::DeleteAtPosition(uint32_t pos) {
   if (IsEmpty()) {
-    throw std::runtime_error(errors::kEmptyDeletion);
-  }
-  const size_t current_size{Size()};
-  if (pos >= current_size) {
-    throw std::runtime_error(errors::kIndexOutOfRange);
+    ALGLIB_THROW(std::runtime_error(errors::kEmptyDeletion));
   }
-  if (pos == 0) {
-    DeleteAtBeginning();
-    return;
+  if (pos >= size_) {
+    ALGLIB_THROW(std::runtime_error(errors::kIndexOutOfRange));
   }
-  if (pos == current_size - 1) {
-    DeleteAtEnd();
-    return;
+  Erase(ConstIterator(NodeAt(pos), this));
+}
+
+/// <summary>
+/// Method for deleting the node that an iterator points to. It only relinks
+/// the neighbours, so it takes constant time. Other iterators stay valid.
+/// </summary>
+/// <param name="pos">Iterator to the node that will be deleted.</param>
+/// <returns>Iterator to the node that followed the deleted one.</returns>
+/// <exception cref="std::runtime_error">Thrown when the list is empty or the
+/// iterator is end().</exception>
+template <typename T, typename Allocator>
+typename DoublyLinkedList<T, Allocator>::Iterator
+DoublyLinkedList<T, Allocator>::Erase(ConstIterator pos) {
+  if (IsEmpty()) {
+    ALGLIB_THROW(std::runtime_error(errors::kEmptyDeletion));
   }
-  Node *curr{head_};
-  for (uint32_t i{}; i < pos; ++i) {
-    curr = curr->next;
+  Node *curr{pos.node_};
+  if (curr == nullptr) {
+    ALGLIB_THROW(std::runtime_error(errors::kIndexOutOfRange));
   }
   Node *prev_node{curr->previous};
   Node *next_node{curr->next};
   if (prev_node) {
     prev_node->next = next_node;
+  } else {
+    head_ = next_node;
   }
   if (next_node) {
-    next_node->previous = next_node;
+    next_node->previous = prev_node;
+  } else {
+    tail_ = prev_node;
+  }
+  DestroyNode(curr);
+  --size_;
+  return Iterator(next_node, this);
+}
+
+/// <summary>
+/// Method for deleting all nodes whose data satisfies a predicate, in a
+/// single pass over the list.
+/// </summary>
+/// <param name="predicate">Callable taking const T& and returning true for
+/// nodes that will be deleted.</param>
+/// <returns>Number of deleted nodes.</returns>
+template <typename T, typename Allocator>
+template <typename Predicate>
+size_t DoublyLinkedList<T, Allocator>::RemoveIf(Predicate predicate) {
+  size_t removed{};
+  Node *tmp{head_};
+  while (tmp) {
+    Node *next{tmp->next};
+    if (std::invoke(predicate, std::as_const(tmp->data))) {
+      Erase(ConstIterator(tmp, this));
+      ++removed;
+    }
+    tmp = next;
   }
-  delete curr;
+  return removed;
+}
+
+/// <summary>
+/// Method for moving a node of this or other list before a given position in
+/// this list. The node is relinked, not copied, so it takes constant time and
+/// iterators to it stay valid, now pointing into this list.
+/// </summary>
+/// <param name="pos">Iterator to the node that will follow the moved one,
+/// end() moves it to the end.</param>
+/// <param name="other">List that the node belongs to, can be this
+/// list.</param>
+/// <param name="it">Iterator to the node that will be moved.</param>
+/// <exception cref="std::runtime_error">Thrown when the iterator is end() or
+/// allocators of the lists are not equal.</exception>
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::Splice(ConstIterator pos,
+                                            DoublyLinkedList &other,
+                                            ConstIterator it) {
+  Node *node{it.node_};
+  if (node == nullptr) {
+    ALGLIB_THROW(std::runtime_error(errors::kIndexOutOfRange));
+  }
+  if (&other != this && !(node_allocator_ == other.node_allocator_)) {
+    ALGLIB_THROW(std::runtime_error(errors::kAllocatorMismatch));
+  }
+  Node *next_node{pos.node_};
+  if (next_node == node || (&other == this && next_node == node->next)) {
+    return;
+  }
+  if (node->previous) {
+    node->previous->next = node->next;
+  } else {
+    other.head_ = node->next;
+  }
+  if (node->next) {
+    node->next->previous = node->previous;
+  } else {
+    other.tail_ = node->previous;
+  }
+  --other.size_;
+  Node *prev_node{next_node ? next_node->previous : tail_};
+  node->next = next_node;
+  node->previous = prev_node;
+  if (prev_node) {
+    prev_node->next = node;
+  } else {
+    head_ = node;
+  }
+  if (next_node) {
+    next_node->previous = node;
+  } else {
+    tail_ = node;
+  }
+  ++size_;
+  stats_.Size(size_);
 }
 
 /// <summary>
 /// Destructor for the doubly linked list. It traverses the list and deletes
 /// each node in the list. It also deletes the tail pointer.
 /// </summary>
-template <typename T>
-DoublyLinkedList<T>::~DoublyLinkedList() {
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::~DoublyLinkedList() {
   Node *tmp{head_};
   while (tmp) {
     Node *next{tmp->next};
-    delete tmp;
+    DestroyNode(tmp);
     tmp = next;
   }
   head_ = nullptr;
@@ -367,11 +761,75 @@ DoublyLinkedList<T>::~DoublyLinkedList() {
 /// Method for checking if the doubly linked list is empty
 /// </summary>
 /// <returns>True if the list is empty, false otherwise.</returns>
-template <typename T>
-bool DoublyLinkedList<T>::IsEmpty() const noexcept {
+template <typename T, typename Allocator>
+bool DoublyLinkedList<T, Allocator>::IsEmpty() const noexcept {
   return (head_ == nullptr);
 }
 
+/// <summary>
+/// Obtains memory for a new node from the node allocator and constructs the
+/// node with a given value.
+/// </summary>
+/// <param name="value"> value that will be stored in the node.</param>
+/// <returns> pointer to the new node.</returns>
+template <typename T, typename Allocator>
+typename DoublyLinkedList<T, Allocator>::Node *
+DoublyLinkedList<T, Allocator>::CreateNode(T value) {
+  Node *node{NodeTraits::allocate(node_allocator_, 1)};
+  ALGLIB_TRY {
+    NodeTraits::construct(node_allocator_, node, std::move(value));
+  } ALGLIB_CATCH_ALL {
+    NodeTraits::deallocate(node_allocator_, node, 1);
+    ALGLIB_RETHROW;
+  }
+  stats_.Allocation();
+  return node;
+}
+
+/// <summary>
+/// Destroys a node and returns its memory to the node allocator.
+/// </summary>
+/// <param name="node"> node created with CreateNode.</param>
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::DestroyNode(Node *node) noexcept {
+  NodeTraits::destroy(node_allocator_, node);
+  NodeTraits::deallocate(node_allocator_, node, 1);
+  stats_.Deallocation();
+}
+
+/// <summary>
+/// Finds the node at a given position by walking from the head or from the
+/// tail, whichever is closer.
+/// </summary>
+/// <param name="pos"> position of the node (0 - first).</param>
+/// <returns> pointer to the node or nullptr when pos is equal to the
+/// size.</returns>
+template <typename T, typename Allocator>
+typename DoublyLinkedList<T, Allocator>::Node *
+DoublyLinkedList<T, Allocator>::NodeAt(size_t pos) const noexcept {
+  if (pos >= size_) return nullptr;
+  Node *tmp;
+  if (pos < size_ / 2) {
+    tmp = head_;
+    for (size_t i{}; i < pos; ++i) tmp = tmp->next;
+  } else {
+    tmp = tail_;
+    for (size_t i{size_ - 1}; i > pos; --i) tmp = tmp->previous;
+  }
+  return tmp;
+}
+
+/// <summary>
+/// Aliases for containers that take memory from a std::pmr::memory_resource.
+/// </summary>
+namespace pmr {
+
+template <typename T>
+using DoublyLinkedList =
+    alglib::DoublyLinkedList<T, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
 }  // namespace alglib
 
 #endif  // ALGLIB_INCLUDE_DOUBLYLINKEDLIST_H_
\ No newline at end of file
@@ -0,0 +1,1773 @@
+//*****************************************************************************
+// The MIT License (MIT)
+//
+// Copyright � 2024 Piotr Walczak
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the �Software�), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED �AS IS�, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//*****************************************************************************
+
+//*****************************************************************************
+// File: flat_hash_map.h
+//
+// This file contains FlatHashMap and FlatHashSet, open addressing hash
+// tables in the style of Swiss tables. Elements are stored inline in one
+// contiguous block, and a separate array of control bytes holds 7 bits of
+// the hash of every element. Lookups compare the control bytes of 16 slots
+// at once with SSE2 or NEON instructions, so most probes touch one cache
+// line of metadata and one element. Everything is implemented in the alglib
+// namespace.
+//*****************************************************************************
+
+#ifndef ALGLIB_INCLUDE_FLATHASHMAP_H_
+#define ALGLIB_INCLUDE_FLATHASHMAP_H_
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define ALGLIB_FLAT_HASH_SSE2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define ALGLIB_FLAT_HASH_NEON 1
+#endif
+
+#include "constants.h"
+#include "stats.h"
+
+/// <summary>
+/// Default namespace for the AlgLib library.
+/// </summary>
+namespace alglib {
+
+/// <summary>
+/// Transparent hash for string keys, so tables with std::string keys can be
+/// searched with std::string_view or string literals without making a
+/// std::string. Use it together with std::equal_to<>.
+/// </summary>
+struct StringHash {
+  using is_transparent = void;
+
+  size_t operator()(std::string_view value) const noexcept {
+    return std::hash<std::string_view>{}(value);
+  }
+};
+
+/// <summary>
+/// Namespace for helpers of containers.
+/// </summary>
+namespace detail {
+
+/// <summary>
+/// Values of control bytes. Full slots hold the low 7 bits of the hash, so
+/// full bytes are never negative, while empty and deleted ones have the sign
+/// bit set.
+/// </summary>
+inline constexpr int8_t kCtrlEmpty{-128};
+inline constexpr int8_t kCtrlDeleted{-2};
+
+/// <summary>
+/// Set of slots of a group found by a match, one bit per slot. Bits are
+/// visited from the lowest slot to the highest one.
+/// </summary>
+/// <typeparam name="shift"> log2 of the number of bits per slot.</typeparam>
+template <int shift>
+class GroupMask {
+ public:
+  explicit GroupMask(uint64_t bits) noexcept : bits(bits) {}
+
+  explicit operator bool() const noexcept { return bits != 0; }
+  size_t Lowest() const noexcept {
+    return static_cast<size_t>(std::countr_zero(bits)) >> shift;
+  }
+  void ClearLowest() noexcept { bits &= bits - 1; }
+
+ private:
+  uint64_t bits;
+};
+
+/// <summary>
+/// Control bytes of 16 consecutive slots, compared all at once. SSE2 uses
+/// one bit per slot from movemask, NEON narrows the comparison to 4 bits per
+/// slot, and other targets fall back to a scalar loop.
+/// </summary>
+class Group {
+ public:
+  static constexpr size_t kWidth{16};
+
+#if defined(ALGLIB_FLAT_HASH_SSE2)
+  using Mask = GroupMask<0>;
+
+  explicit Group(const int8_t *ctrl) noexcept
+      : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl))) {}
+
+  Mask Match(int8_t h2) const noexcept {
+    return Mask(static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2)))));
+  }
+  Mask MatchEmpty() const noexcept { return Match(kCtrlEmpty); }
+  Mask MatchEmptyOrDeleted() const noexcept {
+    return Mask(static_cast<uint32_t>(_mm_movemask_epi8(ctrl)));
+  }
+
+ private:
+  __m128i ctrl;
+#elif defined(ALGLIB_FLAT_HASH_NEON)
+  using Mask = GroupMask<2>;
+
+  explicit Group(const int8_t *ctrl) noexcept : ctrl(vld1q_s8(ctrl)) {}
+
+  Mask Match(int8_t h2) const noexcept {
+    return ToMask(vceqq_s8(ctrl, vdupq_n_s8(h2)));
+  }
+  Mask MatchEmpty() const noexcept { return Match(kCtrlEmpty); }
+  Mask MatchEmptyOrDeleted() const noexcept {
+    return ToMask(vcltq_s8(ctrl, vdupq_n_s8(0)));
+  }
+
+ private:
+  // Narrows a comparison result to a nibble per slot and keeps one bit of
+  // every nibble.
+  static Mask ToMask(uint8x16_t lanes) noexcept {
+    const uint8x8_t nibbles{vshrn_n_u16(vreinterpretq_u16_u8(lanes), 4)};
+    return Mask(vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) &
+                0x8888888888888888ull);
+  }
+
+  int8x16_t ctrl;
+#else
+  using Mask = GroupMask<0>;
+
+  explicit Group(const int8_t *ctrl) noexcept {
+    std::memcpy(this->ctrl, ctrl, kWidth);
+  }
+
+  Mask Match(int8_t h2) const noexcept {
+    uint64_t bits{};
+    for (size_t i{}; i < kWidth; ++i) {
+      bits |= static_cast<uint64_t>(ctrl[i] == h2) << i;
+    }
+    return Mask(bits);
+  }
+  Mask MatchEmpty() const noexcept { return Match(kCtrlEmpty); }
+  Mask MatchEmptyOrDeleted() const noexcept {
+    uint64_t bits{};
+    for (size_t i{}; i < kWidth; ++i) {
+      bits |= static_cast<uint64_t>(ctrl[i] < 0) << i;
+    }
+    return Mask(bits);
+  }
+
+ private:
+  int8_t ctrl[kWidth];
+#endif
+};
+
+/// <summary>
+/// Mixes the bits of a hash, so that hashes like std::hash of integers,
+/// which is the identity, spread over all groups and control bytes.
+/// </summary>
+/// <param name="hash"> hash returned by the hash function.</param>
+/// <returns> mixed hash.</returns>
+inline size_t MixHash(size_t hash) noexcept {
+  if constexpr (sizeof(size_t) == 8) {
+    hash *= static_cast<size_t>(0x9E3779B97F4A7C15ull);
+    return hash ^ (hash >> 32);
+  } else {
+    hash *= static_cast<size_t>(0x9E3779B9u);
+    return hash ^ (hash >> 16);
+  }
+}
+
+/// <summary>
+/// Concept for hash and equality functions that accept other types than
+/// the key, which enables heterogeneous lookup.
+/// </summary>
+template <typename Hash, typename KeyEqual>
+concept TransparentHashing = requires {
+  typename Hash::is_transparent;
+  typename KeyEqual::is_transparent;
+};
+
+/// <summary>
+/// Storage of an element in a slot of the table. Elements are constructed,
+/// read and destroyed through value, and moved to other slots through
+/// Mutable.
+/// </summary>
+/// <typeparam name="Slot"> type of stored elements.</typeparam>
+template <typename Slot>
+union SlotStorage {
+  SlotStorage() noexcept {}
+  ~SlotStorage() {}
+
+  Slot &Mutable() noexcept { return value; }
+
+  Slot value;
+};
+
+/// <summary>
+/// Storage of a map element. The element is exposed as a pair with a const
+/// key, but it is moved to other slots through a pair with the same layout
+/// and a mutable key, so growing the table moves keys instead of copying
+/// them.
+/// </summary>
+/// <typeparam name="K"> type of keys.</typeparam>
+/// <typeparam name="V"> type of mapped values.</typeparam>
+template <typename K, typename V>
+union SlotStorage<std::pair<const K, V>> {
+  SlotStorage() noexcept {}
+  ~SlotStorage() {}
+
+  std::pair<K, V> &Mutable() noexcept { return mutable_value; }
+
+  std::pair<const K, V> value;
+  std::pair<K, V> mutable_value;
+};
+
+/// <summary>
+/// Open addressing hash table shared by FlatHashMap and FlatHashSet. The
+/// table has a power of two number of slots, at least 16, split into groups
+/// of 16. A hash selects the first group with its high bits, and groups are
+/// probed in triangular order until one has an empty slot, which visits
+/// every group once. The low 7 bits of the hash are kept in the control
+/// byte, so only slots whose byte matches are compared with the key. The
+/// table grows when 7/8 of the slots are used.
+/// </summary>
+/// <typeparam name="Key"> type of keys.</typeparam>
+/// <typeparam name="Slot"> type of stored elements.</typeparam>
+/// <typeparam name="KeyOf"> function object returning the key of an
+/// element.</typeparam>
+/// <typeparam name="Hash"> hash function of keys.</typeparam>
+/// <typeparam name="KeyEqual"> equality of keys.</typeparam>
+/// <typeparam name="Allocator"> allocator used to obtain memory for
+/// elements.</typeparam>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+class FlatHashTable {
+  template <typename Value>
+  class Iter;
+
+ public:
+  using Iterator = Iter<Slot>;
+  using ConstIterator = Iter<const Slot>;
+
+  // Constructors, assignment operators and destructor.
+  FlatHashTable() noexcept = default;
+  explicit FlatHashTable(size_t capacity, const Hash &hash = Hash(),
+                         const KeyEqual &equal = KeyEqual(),
+                         const Allocator &allocator = Allocator());
+  FlatHashTable(const FlatHashTable &other);
+  FlatHashTable(const FlatHashTable &other, const Allocator &allocator);
+  FlatHashTable(FlatHashTable &&other) noexcept;
+  FlatHashTable &operator=(const FlatHashTable &other);
+  FlatHashTable &operator=(FlatHashTable &&other) noexcept(
+      std::allocator_traits<Allocator>::propagate_on_container_move_assignment::
+          value ||
+      std::allocator_traits<Allocator>::is_always_equal::value);
+  ~FlatHashTable();
+
+  // Methods for finding elements.
+  Iterator Find(const Key &key);
+  ConstIterator Find(const Key &key) const;
+  template <typename Lookup>
+    requires TransparentHashing<Hash, KeyEqual>
+  Iterator Find(const Lookup &key);
+  template <typename Lookup>
+    requires TransparentHashing<Hash, KeyEqual>
+  ConstIterator Find(const Lookup &key) const;
+  bool Contains(const Key &key) const;
+  template <typename Lookup>
+    requires TransparentHashing<Hash, KeyEqual>
+  bool Contains(const Lookup &key) const;
+
+  // Methods for removing elements.
+  size_t Erase(const Key &key);
+  template <typename Lookup>
+    requires TransparentHashing<Hash, KeyEqual>
+  size_t Erase(const Lookup &key);
+  Iterator Erase(ConstIterator position);
+  void Clear() noexcept;
+
+  // Methods for size and memory of the table.
+  bool IsEmpty() const noexcept;
+  size_t Size() const noexcept;
+  size_t Capacity() const noexcept;
+  float LoadFactor() const noexcept;
+  void Reserve(size_t amount);
+  ContainerStats GetStats() const noexcept;
+
+  // Iterators
+  Iterator begin() noexcept;
+  Iterator end() noexcept;
+  ConstIterator begin() const noexcept;
+  ConstIterator end() const noexcept;
+  ConstIterator cbegin() const noexcept;
+  ConstIterator cend() const noexcept;
+
+ protected:
+  // Methods used by the map and the set to insert elements.
+  template <typename Lookup>
+  std::pair<size_t, bool> FindOrPrepareInsert(const Lookup &key);
+  template <typename... Args>
+  void ConstructAt(size_t index, Args &&...args);
+  void Abandon(size_t index) noexcept;
+  Iterator IteratorAt(size_t index) noexcept;
+
+ private:
+  using Storage = SlotStorage<Slot>;
+  using SlotAllocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Storage>;
+  using SlotTraits = std::allocator_traits<SlotAllocator>;
+  using CtrlAllocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<int8_t>;
+  using CtrlTraits = std::allocator_traits<CtrlAllocator>;
+
+  // Methods for probing the table.
+  template <typename Lookup>
+  size_t FindIndex(const Lookup &key, size_t hash) const;
+  size_t FindFreeSlot(size_t hash) const noexcept;
+  static int8_t H2(size_t hash) noexcept;
+  static size_t GrowthLimit(size_t capacity) noexcept;
+  static size_t CapacityFor(size_t amount) noexcept;
+
+  // Methods for managing memory of the table.
+  template <typename Element>
+  void InsertDistinct(Element &&element);
+  void Resize(size_t new_capacity);
+  void SwapStorage(FlatHashTable &other) noexcept;
+  void DestroyAll() noexcept;
+  void Release() noexcept;
+  void SetCtrl(size_t index, int8_t value) noexcept;
+
+  /// <summary>
+  /// Control bytes of all slots.
+  /// </summary>
+  int8_t *ctrl{nullptr};
+  /// <summary>
+  /// Raw storage of elements, only full slots are constructed.
+  /// </summary>
+  Storage *slots{nullptr};
+  /// <summary>
+  /// Number of slots, zero or a power of two not smaller than 16.
+  /// </summary>
+  size_t capacity{0};
+  /// <summary>
+  /// Number of elements in the table.
+  /// </summary>
+  size_t size{0};
+  /// <summary>
+  /// Number of empty slots that can be filled before the table grows.
+  /// Deleted slots don't count, they are reused but never made empty again
+  /// until the table is rebuilt.
+  /// </summary>
+  size_t growth_left{0};
+
+  /// <summary>
+  /// Hash function of keys.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS Hash hash;
+  /// <summary>
+  /// Equality of keys.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS KeyEqual equal;
+  /// <summary>
+  /// Allocator that provides memory for the elements.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS SlotAllocator slot_allocator;
+  /// <summary>
+  /// Allocator that provides memory for the control bytes.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS CtrlAllocator ctrl_allocator;
+  /// <summary>
+  /// Statistics of the table, empty unless ALGLIB_ENABLE_STATS is defined.
+  /// They belong to the table object and are not moved with its memory.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS StatsRecorder stats;
+};
+
+/// <summary>
+/// Forward iterator over the elements of a table. Incrementing skips empty
+/// and deleted slots.
+/// </summary>
+/// <typeparam name="Value"> type of elements, const qualified for a constant
+/// iterator.</typeparam>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename Value>
+class FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::Iter {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = std::remove_cv_t<Value>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = Value *;
+  using reference = Value &;
+
+  // Constructors
+  Iter() noexcept = default;
+  template <typename Other>
+    requires std::is_convertible_v<Other *, Value *>
+  Iter(const Iter<Other> &other) noexcept
+      : ctrl(other.ctrl), slot(other.slot), last(other.last) {}
+
+  // Access operators
+  reference operator*() const noexcept { return slot->value; }
+  pointer operator->() const noexcept { return &slot->value; }
+
+  // Moving operators
+  Iter &operator++() noexcept {
+    ++ctrl;
+    ++slot;
+    SkipFree();
+    return *this;
+  }
+  Iter operator++(int) noexcept {
+    Iter tmp{*this};
+    ++*this;
+    return tmp;
+  }
+
+  // Comparison operators
+  bool operator==(const Iter &other) const noexcept {
+    return slot == other.slot;
+  }
+
+ private:
+  friend class FlatHashTable;
+  template <typename Other>
+  friend class Iter;
+
+  using StoragePointer =
+      std::conditional_t<std::is_const_v<Value>, const Storage *, Storage *>;
+
+  // Constructor used by the table.
+  Iter(const int8_t *ctrl, StoragePointer slot, const int8_t *last) noexcept
+      : ctrl(ctrl), slot(slot), last(last) {}
+
+  // Moves to the first full slot that is not before the current one.
+  void SkipFree() noexcept {
+    while (ctrl != last && *ctrl < 0) {
+      ++ctrl;
+      ++slot;
+    }
+  }
+
+  /// <summary>
+  /// Control byte of the current slot.
+  /// </summary>
+  const int8_t *ctrl{nullptr};
+  /// <summary>
+  /// Current slot.
+  /// </summary>
+  StoragePointer slot{nullptr};
+  /// <summary>
+  /// Control byte past the last slot.
+  /// </summary>
+  const int8_t *last{nullptr};
+};
+
+/// <summary>
+/// Constructor reserving memory for a given number of elements.
+/// </summary>
+/// <param name="capacity"> number of elements that fit without
+/// growing.</param>
+/// <param name="hash"> hash function of keys.</param>
+/// <param name="equal"> equality of keys.</param>
+/// <param name="allocator"> allocator used by the table.</param>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::FlatHashTable(
+    size_t capacity, const Hash &hash, const KeyEqual &equal,
+    const Allocator &allocator)
+    : hash(hash), equal(equal), slot_allocator(allocator),
+      ctrl_allocator(allocator) {
+  Reserve(capacity);
+}
+
+/// <summary>
+/// Copy constructor. The copy has just enough slots for the elements of the
+/// other table.
+/// </summary>
+/// <param name="other"> table to be copied.</param>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::FlatHashTable(
+    const FlatHashTable &other)
+    : FlatHashTable(other,
+                    Allocator(SlotTraits::select_on_container_copy_construction(
+                        other.slot_allocator))) {}
+
+/// <summary>
+/// Copy constructor that uses a given allocator for the copy. The copy has
+/// just enough slots for the elements of the other table.
+/// </summary>
+/// <param name="other"> table to be copied.</param>
+/// <param name="allocator"> allocator used by the new table.</param>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::FlatHashTable(
+    const FlatHashTable &other, const Allocator &allocator)
+    : hash(other.hash), equal(other.equal), slot_allocator(allocator),
+      ctrl_allocator(allocator) {
+  Reserve(other.size);
+  ALGLIB_TRY {
+    for (const Slot &element : other) InsertDistinct(element);
+  }
+  ALGLIB_CATCH_ALL {
+    DestroyAll();
+    Release();
+    ALGLIB_RETHROW;
+  }
+  stats.Size(size);
+}
+
+/// <summary>
+/// Move constructor. Memory of the other table is taken over and the other
+/// table is left empty.
+/// </summary>
+/// <param name="other"> table to be moved.</param>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::FlatHashTable(
+    FlatHashTable &&other) noexcept
+    : ctrl(std::exchange(other.ctrl, nullptr)),
+      slots(std::exchange(other.slots, nullptr)),
+      capacity(std::exchange(other.capacity, 0)),
+      size(std::exchange(other.size, 0)),
+      growth_left(std::exchange(other.growth_left, 0)), hash(other.hash),
+      equal(other.equal), slot_allocator(std::move(other.slot_allocator)),
+      ctrl_allocator(std::move(other.ctrl_allocator)) {}
+
+/// <summary>
+/// Copy assignment operator. Elements of the other table are copied into a
+/// new table, so this one is unchanged if a copy throws. The allocator of
+/// the other table is taken only if the allocator propagates on copy
+/// assignment.
+/// </summary>
+/// <param name="other"> table to be copied.</param>
+/// <returns> reference to this table.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator> &
+FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::operator=(
+    const FlatHashTable &other) {
+  if (this != &other) {
+    constexpr bool kPropagate{
+        SlotTraits::propagate_on_container_copy_assignment::value};
+    FlatHashTable copy(other, kPropagate ? Allocator(other.slot_allocator)
+                                         : Allocator(slot_allocator));
+    DestroyAll();
+    Release();
+    SwapStorage(copy);
+    if constexpr (kPropagate) {
+      std::swap(slot_allocator, copy.slot_allocator);
+      std::swap(ctrl_allocator, copy.ctrl_allocator);
+    }
+    hash = other.hash;
+    equal = other.equal;
+    if (capacity != 0) stats.Allocation();
+    stats.Size(size);
+  }
+  return *this;
+}
+
+/// <summary>
+/// Move assignment operator. Elements of this table are destroyed and the
+/// memory of the other table is taken over. If the allocator doesn't
+/// propagate and the allocators differ, memory can't be shared and the
+/// elements are moved one by one instead.
+/// </summary>
+/// <param name="other"> table to be moved.</param>
+/// <returns> reference to this table.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator> &
+FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::operator=(
+    FlatHashTable &&other) noexcept(
+    std::allocator_traits<Allocator>::propagate_on_container_move_assignment::
+        value ||
+    std::allocator_traits<Allocator>::is_always_equal::value) {
+  if (this != &other) {
+    if constexpr (SlotTraits::propagate_on_container_move_assignment::value) {
+      DestroyAll();
+      Release();
+      SwapStorage(other);
+      std::swap(slot_allocator, other.slot_allocator);
+      std::swap(ctrl_allocator, other.ctrl_allocator);
+    } else {
+      if (slot_allocator == other.slot_allocator) {
+        DestroyAll();
+        Release();
+        SwapStorage(other);
+      } else {
+        FlatHashTable moved(other.size, other.hash, other.equal,
+                            Allocator(slot_allocator));
+        for (size_t index{}; index < other.capacity; ++index) {
+          if (other.ctrl[index] >= 0) {
+            moved.InsertDistinct(std::move(other.slots[index].Mutable()));
+          }
+        }
+        DestroyAll();
+        Release();
+        SwapStorage(moved);
+        if (capacity != 0) stats.Allocation();
+        stats.Size(size);
+      }
+    }
+    hash = other.hash;
+    equal = other.equal;
+  }
+  return *this;
+}
+
+/// <summary>
+/// Destroys all elements and returns memory to the allocator.
+/// </summary>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::~FlatHashTable() {
+  DestroyAll();
+  Release();
+}
+
+/// <summary>
+/// Finds the element with a given key.
+/// </summary>
+/// <param name="key"> key to be found.</param>
+/// <returns> iterator to the element or end() if there is none.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::Iterator
+FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::Find(
+    const Key &key) {
+  const size_t index{FindIndex(key, MixHash(hash(key)))};
+  return Iterator(ctrl + index, slots + index, ctrl + capacity);
+}
+
+/// <summary>
+/// Finds the element with a given key.
+/// </summary>
+/// <param name="key"> key to be found.</param>
+/// <returns> iterator to the element or end() if there is none.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual,
+                       Allocator>::ConstIterator
+FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::Find(
+    const Key &key) const {
+  const size_t index{FindIndex(key, MixHash(hash(key)))};
+  return ConstIterator(ctrl + index, slots + index, ctrl + capacity);
+}
+
+/// <summary>
+/// Finds the element with a key equal to a value of another type, without
+/// converting it to the key type. Available when both the hash and the
+/// equality are transparent.
+/// </summary>
+/// <param name="key"> value to be found.</param>
+/// <returns> iterator to the element or end() if there is none.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename Lookup>
+  requires TransparentHashing<Hash, KeyEqual>
+typename FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::Iterator
+FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::Find(
+    const Lookup &key) {
+  const size_t index{FindIndex(key, MixHash(hash(key)))};
+  return Iterator(ctrl + index, slots + index, ctrl + capacity);
+}
+
+/// <summary>
+/// Finds the element with a key equal to a value of another type, without
+/// converting it to the key type. Available when both the hash and the
+/// equality are transparent.
+/// </summary>
+/// <param name="key"> value to be found.</param>
+/// <returns> iterator to the element or end() if there is none.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename Lookup>
+  requires TransparentHashing<Hash, KeyEqual>
+typename FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual,
+                       Allocator>::ConstIterator
+FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::Find(
+    const Lookup &key) const {
+  const size_t index{FindIndex(key, MixHash(hash(key)))};
+  return ConstIterator(ctrl + index, slots + index, ctrl + capacity);
+}
+
+/// <summary>
+/// Checks if the table has an element with a given key.
+/// </summary>
+/// <param name="key"> key to be found.</param>
+/// <returns> true if the key is in the table, false if not.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+bool FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::Contains(
+    const Key &key) const {
+  return FindIndex(key, MixHash(hash(key))) != capacity;
+}
+
+/// <summary>
+/// Checks if the table has an element with a key equal to a value of
+/// another type. Available when both the hash and the equality are
+/// transparent.
+/// </summary>
+/// <param name="key"> value to be found.</param>
+/// <returns> true if the key is in the table, false if not.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename Lookup>
+  requires TransparentHashing<Hash, KeyEqual>
+bool FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::Contains(
+    const Lookup &key) const {
+  return FindIndex(key, MixHash(hash(key))) != capacity;
+}
+
+/// <summary>
+/// Removes the element with a given key.
+/// </summary>
+/// <param name="key"> key of the element.</param>
+/// <returns> number of removed elements, 0 or 1.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+size_t FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::Erase(
+    const Key &key) {
+  const size_t index{FindIndex(key, MixHash(hash(key)))};
+  if (index == capacity) return 0;
+  Erase(ConstIterator(ctrl + index, slots + index, ctrl + capacity));
+  return 1;
+}
+
+/// <summary>
+/// Removes the element with a key equal to a value of another type.
+/// Available when both the hash and the equality are transparent.
+/// </summary>
+/// <param name="key"> value equal to the key of the element.</param>
+/// <returns> number of removed elements, 0 or 1.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename Lookup>
+  requires TransparentHashing<Hash, KeyEqual>
+size_t FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::Erase(
+    const Lookup &key) {
+  const size_t index{FindIndex(key, MixHash(hash(key)))};
+  if (index == capacity) return 0;
+  Erase(ConstIterator(ctrl + index, slots + index, ctrl + capacity));
+  return 1;
+}
+
+/// <summary>
+/// Removes the element at a given position. Other elements don't move, so
+/// other iterators stay valid. If the group of the slot still has an empty
+/// slot, no probe has ever passed through the group, so the slot becomes
+/// empty again. Otherwise it is marked as deleted, so probes keep going
+/// past it.
+/// </summary>
+/// <param name="position"> iterator to the element.</param>
+/// <returns> iterator to the next element.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::Iterator
+FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::Erase(
+    ConstIterator position) {
+  const size_t index{static_cast<size_t>(position.ctrl - ctrl)};
+  SlotTraits::destroy(slot_allocator, &slots[index].value);
+  --size;
+  const size_t group{index & ~(Group::kWidth - 1)};
+  if (Group(ctrl + group).MatchEmpty()) {
+    SetCtrl(index, kCtrlEmpty);
+    ++growth_left;
+  } else {
+    SetCtrl(index, kCtrlDeleted);
+  }
+  Iterator next(ctrl + index, slots + index, ctrl + capacity);
+  next.SkipFree();
+  return next;
+}
+
+/// <summary>
+/// Removes all elements. The memory is kept and all slots become empty.
+/// </summary>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual,
+                   Allocator>::Clear() noexcept {
+  DestroyAll();
+  if (capacity != 0) {
+    std::memset(ctrl, kCtrlEmpty, capacity);
+  }
+  size = 0;
+  growth_left = GrowthLimit(capacity);
+}
+
+/// <summary>
+/// Checks if the table is empty.
+/// </summary>
+/// <returns> true if empty, false if not.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+bool FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual,
+                   Allocator>::IsEmpty() const noexcept {
+  return size == 0;
+}
+
+/// <summary>
+/// Gets the number of elements in the table.
+/// </summary>
+/// <returns> number of elements.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+size_t FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual,
+                     Allocator>::Size() const noexcept {
+  return size;
+}
+
+/// <summary>
+/// Gets the number of slots of the table.
+/// </summary>
+/// <returns> number of slots.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+size_t FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual,
+                     Allocator>::Capacity() const noexcept {
+  return capacity;
+}
+
+/// <summary>
+/// Gets the ratio of elements to slots.
+/// </summary>
+/// <returns> load factor, 0 for a table without slots.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+float FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual,
+                    Allocator>::LoadFactor() const noexcept {
+  return capacity == 0 ? 0.0f
+                       : static_cast<float>(size) /
+                             static_cast<float>(capacity);
+}
+
+/// <summary>
+/// Makes room for a given number of elements, so inserting them doesn't
+/// grow the table.
+/// </summary>
+/// <param name="amount"> number of elements.</param>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::Reserve(
+    size_t amount) {
+  if (amount > size + growth_left) {
+    Resize(CapacityFor(amount));
+  }
+}
+
+/// <summary>
+/// Gets statistics of the table. Slots and their control bytes count as one
+/// allocation. Every resize is a reallocation, including rebuilds at the
+/// same capacity that clear deleted slots. Without ALGLIB_ENABLE_STATS all
+/// counters are zero.
+/// </summary>
+/// <returns> statistics of the table.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+ContainerStats FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual,
+                             Allocator>::GetStats() const noexcept {
+  return stats.Get();
+}
+
+/// <summary>
+/// Returns iterator to the first element.
+/// </summary>
+/// <returns> iterator to the first element.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::Iterator
+FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::begin() noexcept {
+  Iterator first(ctrl, slots, ctrl + capacity);
+  first.SkipFree();
+  return first;
+}
+
+/// <summary>
+/// Returns iterator past the last element.
+/// </summary>
+/// <returns> iterator past the last element.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::Iterator
+FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::end() noexcept {
+  return Iterator(ctrl + capacity, slots + capacity, ctrl + capacity);
+}
+
+/// <summary>
+/// Returns constant iterator to the first element.
+/// </summary>
+/// <returns> iterator to the first element.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual,
+                       Allocator>::ConstIterator
+FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::begin()
+    const noexcept {
+  ConstIterator first(ctrl, slots, ctrl + capacity);
+  first.SkipFree();
+  return first;
+}
+
+/// <summary>
+/// Returns constant iterator past the last element.
+/// </summary>
+/// <returns> iterator past the last element.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual,
+                       Allocator>::ConstIterator
+FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::end()
+    const noexcept {
+  return ConstIterator(ctrl + capacity, slots + capacity, ctrl + capacity);
+}
+
+/// <summary>
+/// Returns constant iterator to the first element.
+/// </summary>
+/// <returns> iterator to the first element.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual,
+                       Allocator>::ConstIterator
+FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::cbegin()
+    const noexcept {
+  return begin();
+}
+
+/// <summary>
+/// Returns constant iterator past the last element.
+/// </summary>
+/// <returns> iterator past the last element.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual,
+                       Allocator>::ConstIterator
+FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::cend()
+    const noexcept {
+  return end();
+}
+
+/// <summary>
+/// Finds the slot of a key, or prepares a free slot for it. The free slot
+/// is only reserved: the caller constructs the element with ConstructAt, or
+/// gives the slot back with Abandon if the construction throws.
+/// </summary>
+/// <param name="key"> key to be found.</param>
+/// <returns> index of the slot and true if the slot is free, false if the
+/// key is already there.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename Lookup>
+std::pair<size_t, bool>
+FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual,
+              Allocator>::FindOrPrepareInsert(const Lookup &key) {
+  const size_t key_hash{MixHash(hash(key))};
+  const size_t found{FindIndex(key, key_hash)};
+  if (found != capacity) return {found, false};
+  size_t index{FindFreeSlot(key_hash)};
+  if (index == capacity || (growth_left == 0 && ctrl[index] == kCtrlEmpty)) {
+    // Tables with many deleted slots are rebuilt at the same size, others
+    // double.
+    Resize(size * 2 < GrowthLimit(capacity) ? capacity
+                                              : CapacityFor(size + 1));
+    index = FindFreeSlot(key_hash);
+  }
+  if (ctrl[index] == kCtrlEmpty) --growth_left;
+  SetCtrl(index, H2(key_hash));
+  ++size;
+  stats.Size(size);
+  return {index, true};
+}
+
+/// <summary>
+/// Constructs an element in a slot prepared by FindOrPrepareInsert.
+/// </summary>
+/// <param name="index"> index of the slot.</param>
+/// <param name="args"> arguments passed to the constructor of the
+/// element.</param>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename... Args>
+void FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::ConstructAt(
+    size_t index, Args &&...args) {
+  SlotTraits::construct(slot_allocator, &slots[index].value,
+                        std::forward<Args>(args)...);
+}
+
+/// <summary>
+/// Gives back a slot prepared by FindOrPrepareInsert whose element couldn't
+/// be constructed. The slot is marked as deleted, which is always safe.
+/// </summary>
+/// <param name="index"> index of the slot.</param>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::Abandon(
+    size_t index) noexcept {
+  SetCtrl(index, kCtrlDeleted);
+  --size;
+}
+
+/// <summary>
+/// Makes an iterator to a given slot.
+/// </summary>
+/// <param name="index"> index of a full slot.</param>
+/// <returns> iterator to the element in the slot.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::Iterator
+FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::IteratorAt(
+    size_t index) noexcept {
+  return Iterator(ctrl + index, slots + index, ctrl + capacity);
+}
+
+/// <summary>
+/// Probes the table for a key. Each group is checked with one comparison of
+/// its control bytes, and only slots with matching bytes compare the keys.
+/// The probe stops at the first group with an empty slot.
+/// </summary>
+/// <param name="key"> key to be found.</param>
+/// <param name="key_hash"> mixed hash of the key.</param>
+/// <returns> index of the slot holding the key or capacity if there is
+/// none.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename Lookup>
+size_t FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::FindIndex(
+    const Lookup &key, size_t key_hash) const {
+  if (capacity == 0) return 0;
+  const size_t group_mask{capacity / Group::kWidth - 1};
+  size_t group{(key_hash >> 7) & group_mask};
+  for (size_t step{1};; ++step) {
+    const size_t offset{group * Group::kWidth};
+    const Group probe(ctrl + offset);
+    for (auto match{probe.Match(H2(key_hash))}; match; match.ClearLowest()) {
+      const size_t index{offset + match.Lowest()};
+      if (equal(KeyOf{}(slots[index].value), key)) return index;
+    }
+    if (probe.MatchEmpty()) return capacity;
+    group = (group + step) & group_mask;
+  }
+}
+
+/// <summary>
+/// Finds the first empty or deleted slot on the probe sequence of a hash.
+/// </summary>
+/// <param name="key_hash"> mixed hash of the key.</param>
+/// <returns> index of the slot or capacity if the table has no
+/// slots.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+size_t FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual,
+                     Allocator>::FindFreeSlot(size_t key_hash) const noexcept {
+  if (capacity == 0) return 0;
+  const size_t group_mask{capacity / Group::kWidth - 1};
+  size_t group{(key_hash >> 7) & group_mask};
+  for (size_t step{1};; ++step) {
+    const size_t offset{group * Group::kWidth};
+    const auto free{Group(ctrl + offset).MatchEmptyOrDeleted()};
+    if (free) return offset + free.Lowest();
+    group = (group + step) & group_mask;
+  }
+}
+
+/// <summary>
+/// Gets the part of a hash kept in the control byte.
+/// </summary>
+/// <param name="key_hash"> mixed hash of the key.</param>
+/// <returns> low 7 bits of the hash.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+int8_t FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::H2(
+    size_t key_hash) noexcept {
+  return static_cast<int8_t>(key_hash & 0x7F);
+}
+
+/// <summary>
+/// Gets the number of elements that fit in a given number of slots, 7/8 of
+/// them.
+/// </summary>
+/// <param name="capacity"> number of slots.</param>
+/// <returns> maximum number of elements.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+size_t FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual,
+                     Allocator>::GrowthLimit(size_t capacity) noexcept {
+  return capacity - capacity / 8;
+}
+
+/// <summary>
+/// Gets the smallest number of slots for a given number of elements.
+/// </summary>
+/// <param name="amount"> number of elements.</param>
+/// <returns> power of two number of slots, at least 16.</returns>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+size_t FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual,
+                     Allocator>::CapacityFor(size_t amount) noexcept {
+  size_t slots_needed{Group::kWidth};
+  while (GrowthLimit(slots_needed) < amount) slots_needed *= 2;
+  return slots_needed;
+}
+
+/// <summary>
+/// Moves all elements into new memory with a given number of slots. This
+/// also turns all deleted slots into empty ones. If moving an element
+/// throws, the new memory is released and the table is unchanged, as
+/// elements are copied unless their move constructor can't throw or they
+/// can't be copied. Map elements are moved with a mutable key.
+/// </summary>
+/// <param name="new_capacity"> new number of slots.</param>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::Resize(
+    size_t new_capacity) {
+  FlatHashTable resized(0, hash, equal, Allocator(slot_allocator));
+  resized.ctrl = CtrlTraits::allocate(resized.ctrl_allocator, new_capacity);
+  ALGLIB_TRY {
+    resized.slots =
+        SlotTraits::allocate(resized.slot_allocator, new_capacity);
+  }
+  ALGLIB_CATCH_ALL {
+    CtrlTraits::deallocate(resized.ctrl_allocator, resized.ctrl,
+                           new_capacity);
+    resized.ctrl = nullptr;
+    ALGLIB_RETHROW;
+  }
+  std::memset(resized.ctrl, kCtrlEmpty, new_capacity);
+  resized.capacity = new_capacity;
+  resized.growth_left = GrowthLimit(new_capacity);
+  for (size_t index{}; index < capacity; ++index) {
+    if (ctrl[index] >= 0) {
+      resized.InsertDistinct(std::move_if_noexcept(slots[index].Mutable()));
+    }
+  }
+  if (capacity != 0) stats.Reallocation(size * sizeof(Slot));
+  stats.Allocation();
+  DestroyAll();
+  Release();
+  SwapStorage(resized);
+}
+
+/// <summary>
+/// Constructs an element whose key is not in the table yet in the first
+/// free slot of its probe sequence. The table must have room for it.
+/// </summary>
+/// <param name="element"> element to be copied or moved in.</param>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename Element>
+void FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::
+    InsertDistinct(Element &&element) {
+  const size_t element_hash{MixHash(hash(KeyOf{}(element)))};
+  const size_t index{FindFreeSlot(element_hash)};
+  ConstructAt(index, std::forward<Element>(element));
+  if (ctrl[index] == kCtrlEmpty) --growth_left;
+  SetCtrl(index, H2(element_hash));
+  ++size;
+}
+
+/// <summary>
+/// Swaps the memory and elements with another table, keeping the
+/// allocators.
+/// </summary>
+/// <param name="other"> table to swap with.</param>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::SwapStorage(
+    FlatHashTable &other) noexcept {
+  std::swap(ctrl, other.ctrl);
+  std::swap(slots, other.slots);
+  std::swap(capacity, other.capacity);
+  std::swap(size, other.size);
+  std::swap(growth_left, other.growth_left);
+}
+
+/// <summary>
+/// Destroys all elements without changing the control bytes.
+/// </summary>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual,
+                   Allocator>::DestroyAll() noexcept {
+  if constexpr (!std::is_trivially_destructible_v<Slot>) {
+    for (size_t index{}; index < capacity; ++index) {
+      if (ctrl[index] >= 0) {
+        SlotTraits::destroy(slot_allocator, &slots[index].value);
+      }
+    }
+  }
+}
+
+/// <summary>
+/// Returns memory to the allocators.
+/// </summary>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual,
+                   Allocator>::Release() noexcept {
+  if (capacity != 0) {
+    SlotTraits::deallocate(slot_allocator, slots, capacity);
+    CtrlTraits::deallocate(ctrl_allocator, ctrl, capacity);
+    stats.Deallocation();
+  }
+  ctrl = nullptr;
+  slots = nullptr;
+  capacity = 0;
+  size = 0;
+  growth_left = 0;
+}
+
+/// <summary>
+/// Sets the control byte of a slot.
+/// </summary>
+/// <param name="index"> index of the slot.</param>
+/// <param name="value"> new control byte.</param>
+template <typename Key, typename Slot, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void FlatHashTable<Key, Slot, KeyOf, Hash, KeyEqual, Allocator>::SetCtrl(
+    size_t index, int8_t value) noexcept {
+  ctrl[index] = value;
+}
+
+/// <summary>
+/// Returns the key of a map element.
+/// </summary>
+struct PairKey {
+  template <typename Pair>
+  const auto &operator()(const Pair &pair) const noexcept {
+    return pair.first;
+  }
+};
+
+/// <summary>
+/// Returns a set element, which is its own key.
+/// </summary>
+struct SelfKey {
+  template <typename T>
+  const T &operator()(const T &value) const noexcept {
+    return value;
+  }
+};
+
+}  // namespace detail
+
+/// <summary>
+/// Hash map storing its elements inline in an open addressing table. It has
+/// fewer cache misses per lookup than node based maps, because keys are
+/// found through a dense array of control bytes probed 16 at a time, and
+/// the matching element is read from a contiguous block. Inserting may move
+/// elements, which invalidates iterators and references. Erasing doesn't
+/// move anything. Keys and values are moved when the table grows.
+/// </summary>
+/// <typeparam name="K"> type of keys.</typeparam>
+/// <typeparam name="V"> type of mapped values.</typeparam>
+/// <typeparam name="Hash"> hash function of keys.</typeparam>
+/// <typeparam name="KeyEqual"> equality of keys. Heterogeneous lookup is
+/// enabled when both it and the hash are transparent, for example
+/// StringHash with std::equal_to<>.</typeparam>
+/// <typeparam name="Allocator"> allocator used to obtain memory.</typeparam>
+template <typename K, typename V, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>,
+          typename Allocator = std::allocator<std::pair<const K, V>>>
+class FlatHashMap
+    : public detail::FlatHashTable<K, std::pair<const K, V>, detail::PairKey,
+                                   Hash, KeyEqual, Allocator> {
+  using Table = detail::FlatHashTable<K, std::pair<const K, V>,
+                                      detail::PairKey, Hash, KeyEqual,
+                                      Allocator>;
+
+ public:
+  using Iterator = typename Table::Iterator;
+  using ConstIterator = typename Table::ConstIterator;
+
+  // Constructors for the FlatHashMap.
+  using Table::Table;
+  FlatHashMap() noexcept = default;
+  FlatHashMap(std::initializer_list<std::pair<const K, V>> values);
+
+  // Methods for inserting elements.
+  std::pair<Iterator, bool> Insert(const std::pair<const K, V> &value);
+  std::pair<Iterator, bool> Insert(std::pair<const K, V> &&value);
+  template <typename... Args>
+  std::pair<Iterator, bool> TryEmplace(const K &key, Args &&...args);
+  template <typename... Args>
+  std::pair<Iterator, bool> TryEmplace(K &&key, Args &&...args);
+  template <typename Value>
+  std::pair<Iterator, bool> InsertOrAssign(const K &key, Value &&value);
+  template <typename Value>
+  std::pair<Iterator, bool> InsertOrAssign(K &&key, Value &&value);
+
+  // Methods for accessing mapped values.
+  V &operator[](const K &key);
+  V &operator[](K &&key);
+  V &At(const K &key);
+  const V &At(const K &key) const;
+  template <typename Lookup>
+    requires detail::TransparentHashing<Hash, KeyEqual>
+  V &At(const Lookup &key);
+  template <typename Lookup>
+    requires detail::TransparentHashing<Hash, KeyEqual>
+  const V &At(const Lookup &key) const;
+
+ private:
+  // Method for inserting an element built from a key and arguments.
+  template <typename Key, typename... Args>
+  std::pair<Iterator, bool> EmplaceKey(Key &&key, Args &&...args);
+};
+
+/// <summary>
+/// Constructor inserting the elements of a list. For repeated keys the first
+/// element is kept.
+/// </summary>
+/// <param name="values"> elements to be inserted.</param>
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Allocator>
+FlatHashMap<K, V, Hash, KeyEqual, Allocator>::FlatHashMap(
+    std::initializer_list<std::pair<const K, V>> values)
+    : Table(values.size()) {
+  for (const auto &value : values) Insert(value);
+}
+
+/// <summary>
+/// Inserts a copy of an element unless its key is already in the map.
+/// </summary>
+/// <param name="value"> element to be inserted.</param>
+/// <returns> iterator to the element with the key and true if the element
+/// was inserted.</returns>
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Allocator>
+std::pair<typename FlatHashMap<K, V, Hash, KeyEqual, Allocator>::Iterator,
+          bool>
+FlatHashMap<K, V, Hash, KeyEqual, Allocator>::Insert(
+    const std::pair<const K, V> &value) {
+  return EmplaceKey(value.first, value.second);
+}
+
+/// <summary>
+/// Moves an element into the map unless its key is already there.
+/// </summary>
+/// <param name="value"> element to be inserted.</param>
+/// <returns> iterator to the element with the key and true if the element
+/// was inserted.</returns>
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Allocator>
+std::pair<typename FlatHashMap<K, V, Hash, KeyEqual, Allocator>::Iterator,
+          bool>
+FlatHashMap<K, V, Hash, KeyEqual, Allocator>::Insert(
+    std::pair<const K, V> &&value) {
+  return EmplaceKey(value.first, std::move(value.second));
+}
+
+/// <summary>
+/// Constructs the mapped value from given arguments unless the key is
+/// already in the map. Nothing is constructed for an existing key.
+/// </summary>
+/// <param name="key"> key of the element.</param>
+/// <param name="args"> arguments passed to the constructor of V.</param>
+/// <returns> iterator to the element with the key and true if the element
+/// was inserted.</returns>
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename... Args>
+std::pair<typename FlatHashMap<K, V, Hash, KeyEqual, Allocator>::Iterator,
+          bool>
+FlatHashMap<K, V, Hash, KeyEqual, Allocator>::TryEmplace(const K &key,
+                                                         Args &&...args) {
+  return EmplaceKey(key, std::forward<Args>(args)...);
+}
+
+/// <summary>
+/// Constructs the mapped value from given arguments unless the key is
+/// already in the map. The key is moved only if the element is inserted.
+/// </summary>
+/// <param name="key"> key of the element.</param>
+/// <param name="args"> arguments passed to the constructor of V.</param>
+/// <returns> iterator to the element with the key and true if the element
+/// was inserted.</returns>
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename... Args>
+std::pair<typename FlatHashMap<K, V, Hash, KeyEqual, Allocator>::Iterator,
+          bool>
+FlatHashMap<K, V, Hash, KeyEqual, Allocator>::TryEmplace(K &&key,
+                                                         Args &&...args) {
+  return EmplaceKey(std::move(key), std::forward<Args>(args)...);
+}
+
+/// <summary>
+/// Inserts an element, or assigns the value to the element with the key.
+/// </summary>
+/// <param name="key"> key of the element.</param>
+/// <param name="value"> value to be inserted or assigned.</param>
+/// <returns> iterator to the element with the key and true if the element
+/// was inserted.</returns>
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename Value>
+std::pair<typename FlatHashMap<K, V, Hash, KeyEqual, Allocator>::Iterator,
+          bool>
+FlatHashMap<K, V, Hash, KeyEqual, Allocator>::InsertOrAssign(const K &key,
+                                                             Value &&value) {
+  auto result{EmplaceKey(key, std::forward<Value>(value))};
+  if (!result.second) result.first->second = std::forward<Value>(value);
+  return result;
+}
+
+/// <summary>
+/// Inserts an element, or assigns the value to the element with the key.
+/// The key is moved only if the element is inserted.
+/// </summary>
+/// <param name="key"> key of the element.</param>
+/// <param name="value"> value to be inserted or assigned.</param>
+/// <returns> iterator to the element with the key and true if the element
+/// was inserted.</returns>
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename Value>
+std::pair<typename FlatHashMap<K, V, Hash, KeyEqual, Allocator>::Iterator,
+          bool>
+FlatHashMap<K, V, Hash, KeyEqual, Allocator>::InsertOrAssign(K &&key,
+                                                             Value &&value) {
+  auto result{EmplaceKey(std::move(key), std::forward<Value>(value))};
+  if (!result.second) result.first->second = std::forward<Value>(value);
+  return result;
+}
+
+/// <summary>
+/// Returns the value mapped to a key, inserting a value initialized one if
+/// the key is not in the map.
+/// </summary>
+/// <param name="key"> key of the element.</param>
+/// <returns> reference to the mapped value.</returns>
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Allocator>
+V &FlatHashMap<K, V, Hash, KeyEqual, Allocator>::operator[](const K &key) {
+  return EmplaceKey(key).first->second;
+}
+
+/// <summary>
+/// Returns the value mapped to a key, inserting a value initialized one if
+/// the key is not in the map. The key is moved only if it is inserted.
+/// </summary>
+/// <param name="key"> key of the element.</param>
+/// <returns> reference to the mapped value.</returns>
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Allocator>
+V &FlatHashMap<K, V, Hash, KeyEqual, Allocator>::operator[](K &&key) {
+  return EmplaceKey(std::move(key)).first->second;
+}
+
+/// <summary>
+/// Returns the value mapped to a key.
+/// </summary>
+/// <param name="key"> key of the element.</param>
+/// <returns> reference to the mapped value.</returns>
+/// <exception cref="std::runtime_error"> thrown when the key is not in the
+/// map.</exception>
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Allocator>
+V &FlatHashMap<K, V, Hash, KeyEqual, Allocator>::At(const K &key) {
+  const auto found{this->Find(key)};
+  if (found == this->end()) {
+    ALGLIB_THROW(std::runtime_error(errors::kItemNotFound));
+  }
+  return found->second;
+}
+
+/// <summary>
+/// Returns the value mapped to a key.
+/// </summary>
+/// <param name="key"> key of the element.</param>
+/// <returns> reference to the mapped value.</returns>
+/// <exception cref="std::runtime_error"> thrown when the key is not in the
+/// map.</exception>
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Allocator>
+const V &FlatHashMap<K, V, Hash, KeyEqual, Allocator>::At(
+    const K &key) const {
+  const auto found{this->Find(key)};
+  if (found == this->end()) {
+    ALGLIB_THROW(std::runtime_error(errors::kItemNotFound));
+  }
+  return found->second;
+}
+
+/// <summary>
+/// Returns the value mapped to a key equal to a value of another type.
+/// Available when both the hash and the equality are transparent.
+/// </summary>
+/// <param name="key"> value equal to the key of the element.</param>
+/// <returns> reference to the mapped value.</returns>
+/// <exception cref="std::runtime_error"> thrown when the key is not in the
+/// map.</exception>
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename Lookup>
+  requires detail::TransparentHashing<Hash, KeyEqual>
+V &FlatHashMap<K, V, Hash, KeyEqual, Allocator>::At(const Lookup &key) {
+  const auto found{this->Find(key)};
+  if (found == this->end()) {
+    ALGLIB_THROW(std::runtime_error(errors::kItemNotFound));
+  }
+  return found->second;
+}
+
+/// <summary>
+/// Returns the value mapped to a key equal to a value of another type.
+/// Available when both the hash and the equality are transparent.
+/// </summary>
+/// <param name="key"> value equal to the key of the element.</param>
+/// <returns> reference to the mapped value.</returns>
+/// <exception cref="std::runtime_error"> thrown when the key is not in the
+/// map.</exception>
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename Lookup>
+  requires detail::TransparentHashing<Hash, KeyEqual>
+const V &FlatHashMap<K, V, Hash, KeyEqual, Allocator>::At(
+    const Lookup &key) const {
+  const auto found{this->Find(key)};
+  if (found == this->end()) {
+    ALGLIB_THROW(std::runtime_error(errors::kItemNotFound));
+  }
+  return found->second;
+}
+
+/// <summary>
+/// Inserts an element built from a key and arguments for the mapped value,
+/// unless the key is already in the map.
+/// </summary>
+/// <param name="key"> key of the element.</param>
+/// <param name="args"> arguments passed to the constructor of V.</param>
+/// <returns> iterator to the element with the key and true if the element
+/// was inserted.</returns>
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename Key, typename... Args>
+std::pair<typename FlatHashMap<K, V, Hash, KeyEqual, Allocator>::Iterator,
+          bool>
+FlatHashMap<K, V, Hash, KeyEqual, Allocator>::EmplaceKey(Key &&key,
+                                                         Args &&...args) {
+  const auto [index, inserted] = this->FindOrPrepareInsert(key);
+  if (inserted) {
+    ALGLIB_TRY {
+      this->ConstructAt(index, std::piecewise_construct,
+                        std::forward_as_tuple(std::forward<Key>(key)),
+                        std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+    ALGLIB_CATCH_ALL {
+      this->Abandon(index);
+      ALGLIB_RETHROW;
+    }
+  }
+  return {this->IteratorAt(index), inserted};
+}
+
+/// <summary>
+/// Hash set storing its keys inline in an open addressing table, with the
+/// same layout and probing as FlatHashMap. Keys are only reachable through
+/// constant iterators, as changing them would break the table.
+/// </summary>
+/// <typeparam name="K"> type of keys.</typeparam>
+/// <typeparam name="Hash"> hash function of keys.</typeparam>
+/// <typeparam name="KeyEqual"> equality of keys. Heterogeneous lookup is
+/// enabled when both it and the hash are transparent.</typeparam>
+/// <typeparam name="Allocator"> allocator used to obtain memory.</typeparam>
+template <typename K, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>,
+          typename Allocator = std::allocator<K>>
+class FlatHashSet : public detail::FlatHashTable<K, K, detail::SelfKey, Hash,
+                                                 KeyEqual, Allocator> {
+  using Table =
+      detail::FlatHashTable<K, K, detail::SelfKey, Hash, KeyEqual, Allocator>;
+
+ public:
+  using Iterator = typename Table::ConstIterator;
+  using ConstIterator = typename Table::ConstIterator;
+
+  // Constructors for the FlatHashSet.
+  using Table::Table;
+  FlatHashSet() noexcept = default;
+  FlatHashSet(std::initializer_list<K> values);
+
+  // Methods for inserting keys.
+  std::pair<Iterator, bool> Insert(const K &key);
+  std::pair<Iterator, bool> Insert(K &&key);
+  template <typename... Args>
+  std::pair<Iterator, bool> Emplace(Args &&...args);
+
+  // Methods for finding and removing keys, through constant iterators.
+  ConstIterator Find(const K &key) const;
+  template <typename Lookup>
+    requires detail::TransparentHashing<Hash, KeyEqual>
+  ConstIterator Find(const Lookup &key) const;
+  using Table::Erase;
+  ConstIterator Erase(ConstIterator position);
+
+  // Iterators, all of them constant.
+  ConstIterator begin() const noexcept;
+  ConstIterator end() const noexcept;
+
+ private:
+  // Method for inserting a key.
+  template <typename Key>
+  std::pair<Iterator, bool> InsertKey(Key &&key);
+};
+
+/// <summary>
+/// Constructor inserting the keys of a list.
+/// </summary>
+/// <param name="values"> keys to be inserted.</param>
+template <typename K, typename Hash, typename KeyEqual, typename Allocator>
+FlatHashSet<K, Hash, KeyEqual, Allocator>::FlatHashSet(
+    std::initializer_list<K> values)
+    : Table(values.size()) {
+  for (const K &value : values) Insert(value);
+}
+
+/// <summary>
+/// Inserts a copy of a key unless it is already in the set.
+/// </summary>
+/// <param name="key"> key to be inserted.</param>
+/// <returns> iterator to the key and true if it was inserted.</returns>
+template <typename K, typename Hash, typename KeyEqual, typename Allocator>
+std::pair<typename FlatHashSet<K, Hash, KeyEqual, Allocator>::Iterator, bool>
+FlatHashSet<K, Hash, KeyEqual, Allocator>::Insert(const K &key) {
+  return InsertKey(key);
+}
+
+/// <summary>
+/// Moves a key into the set unless it is already there.
+/// </summary>
+/// <param name="key"> key to be inserted.</param>
+/// <returns> iterator to the key and true if it was inserted.</returns>
+template <typename K, typename Hash, typename KeyEqual, typename Allocator>
+std::pair<typename FlatHashSet<K, Hash, KeyEqual, Allocator>::Iterator, bool>
+FlatHashSet<K, Hash, KeyEqual, Allocator>::Insert(K &&key) {
+  return InsertKey(std::move(key));
+}
+
+/// <summary>
+/// Constructs a key from given arguments and inserts it unless it is
+/// already in the set.
+/// </summary>
+/// <param name="args"> arguments passed to the constructor of K.</param>
+/// <returns> iterator to the key and true if it was inserted.</returns>
+template <typename K, typename Hash, typename KeyEqual, typename Allocator>
+template <typename... Args>
+std::pair<typename FlatHashSet<K, Hash, KeyEqual, Allocator>::Iterator, bool>
+FlatHashSet<K, Hash, KeyEqual, Allocator>::Emplace(Args &&...args) {
+  return InsertKey(K(std::forward<Args>(args)...));
+}
+
+/// <summary>
+/// Finds a key in the set.
+/// </summary>
+/// <param name="key"> key to be found.</param>
+/// <returns> iterator to the key or end() if there is none.</returns>
+template <typename K, typename Hash, typename KeyEqual, typename Allocator>
+typename FlatHashSet<K, Hash, KeyEqual, Allocator>::ConstIterator
+FlatHashSet<K, Hash, KeyEqual, Allocator>::Find(const K &key) const {
+  return Table::Find(key);
+}
+
+/// <summary>
+/// Finds a key equal to a value of another type. Available when both the
+/// hash and the equality are transparent.
+/// </summary>
+/// <param name="key"> value to be found.</param>
+/// <returns> iterator to the key or end() if there is none.</returns>
+template <typename K, typename Hash, typename KeyEqual, typename Allocator>
+template <typename Lookup>
+  requires detail::TransparentHashing<Hash, KeyEqual>
+typename FlatHashSet<K, Hash, KeyEqual, Allocator>::ConstIterator
+FlatHashSet<K, Hash, KeyEqual, Allocator>::Find(const Lookup &key) const {
+  return Table::Find(key);
+}
+
+/// <summary>
+/// Removes the key at a given position. Other keys don't move.
+/// </summary>
+/// <param name="position"> iterator to the key.</param>
+/// <returns> iterator to the next key.</returns>
+template <typename K, typename Hash, typename KeyEqual, typename Allocator>
+typename FlatHashSet<K, Hash, KeyEqual, Allocator>::ConstIterator
+FlatHashSet<K, Hash, KeyEqual, Allocator>::Erase(ConstIterator position) {
+  return Table::Erase(position);
+}
+
+/// <summary>
+/// Returns constant iterator to the first key.
+/// </summary>
+/// <returns> iterator to the first key.</returns>
+template <typename K, typename Hash, typename KeyEqual, typename Allocator>
+typename FlatHashSet<K, Hash, KeyEqual, Allocator>::ConstIterator
+FlatHashSet<K, Hash, KeyEqual, Allocator>::begin() const noexcept {
+  return Table::begin();
+}
+
+/// <summary>
+/// Returns constant iterator past the last key.
+/// </summary>
+/// <returns> iterator past the last key.</returns>
+template <typename K, typename Hash, typename KeyEqual, typename Allocator>
+typename FlatHashSet<K, Hash, KeyEqual, Allocator>::ConstIterator
+FlatHashSet<K, Hash, KeyEqual, Allocator>::end() const noexcept {
+  return Table::end();
+}
+
+/// <summary>
+/// Inserts a key unless it is already in the set.
+/// </summary>
+/// <param name="key"> key to be inserted.</param>
+/// <returns> iterator to the key and true if it was inserted.</returns>
+template <typename K, typename Hash, typename KeyEqual, typename Allocator>
+template <typename Key>
+std::pair<typename FlatHashSet<K, Hash, KeyEqual, Allocator>::Iterator, bool>
+FlatHashSet<K, Hash, KeyEqual, Allocator>::InsertKey(Key &&key) {
+  const auto [index, inserted] = this->FindOrPrepareInsert(key);
+  if (inserted) {
+    ALGLIB_TRY { this->ConstructAt(index, std::forward<Key>(key)); }
+    ALGLIB_CATCH_ALL {
+      this->Abandon(index);
+      ALGLIB_RETHROW;
+    }
+  }
+  return {this->IteratorAt(index), inserted};
+}
+
+}  // namespace alglib
+
+#endif  // ALGLIB_INCLUDE_FLATHASHMAP_H_
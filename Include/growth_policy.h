@@ -0,0 +1,140 @@
+//*****************************************************************************
+// The MIT License (MIT)
+//
+// Copyright � 2024 Piotr Walczak
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the �Software�), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED �AS IS�, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//*****************************************************************************
+
+//*****************************************************************************
+// File: growth_policy.h
+//
+// This file contains growth policies used by Vector and SmallVector to decide
+// how much memory to allocate when they run out of capacity. Policy is any
+// callable object that takes the current capacity and the required amount of
+// elements and returns the new capacity. The policies are implemented in the
+// alglib namespace.
+//*****************************************************************************
+
+#ifndef ALGLIB_INCLUDE_GROWTHPOLICY_H_
+#define ALGLIB_INCLUDE_GROWTHPOLICY_H_
+
+#include <concepts>
+#include <cstddef>
+
+/// <summary>
+/// Default namespace for the AlgLib library.
+/// </summary>
+namespace alglib {
+
+/// <summary>
+/// Concept for growth policies. Policy is called with the current capacity and
+/// the amount of elements that has to fit after growing. Container never uses
+/// less capacity than required, even if the policy returns a smaller value.
+/// </summary>
+template <typename Policy>
+concept GrowthPolicy =
+    std::copy_constructible<Policy> &&
+    requires(const Policy &policy, size_t capacity, size_t required) {
+      { policy(capacity, required) } -> std::convertible_to<size_t>;
+    };
+
+/// <summary>
+/// Capacity used by the built-in policies when a container without any memory
+/// grows.
+/// </summary>
+inline constexpr size_t kInitialGrowthCapacity{4};
+
+/// <summary>
+/// Policy that multiplies the capacity by Numerator / Denominator. Factors
+/// below 2 waste less memory and let the allocator reuse blocks released by
+/// earlier growth steps.
+/// </summary>
+/// <typeparam name="Numerator"> numerator of the growth factor.</typeparam>
+/// <typeparam name="Denominator"> denominator of the growth
+/// factor.</typeparam>
+template <size_t Numerator, size_t Denominator>
+struct MultiplicativeGrowth {
+  static_assert(Denominator > 0 && Numerator > Denominator,
+                "Growth factor has to be greater than 1.");
+
+  constexpr size_t operator()(size_t capacity,
+                              size_t required) const noexcept;
+};
+
+/// <summary>
+/// Policy that doubles the capacity. It is the default policy of containers.
+/// </summary>
+using DoublingGrowth = MultiplicativeGrowth<2, 1>;
+
+/// <summary>
+/// Policy that grows the capacity by half.
+/// </summary>
+using OneAndHalfGrowth = MultiplicativeGrowth<3, 2>;
+
+/// <summary>
+/// Policy that rounds the capacity up to the next multiple of a constant
+/// chunk. Memory overhead is bounded by one chunk, but the amount of
+/// reallocations grows linearly with the size.
+/// </summary>
+/// <typeparam name="Chunk"> amount of elements added by one growth
+/// step.</typeparam>
+template <size_t Chunk>
+struct FixedChunkGrowth {
+  static_assert(Chunk > 0, "Chunk has to contain at least one element.");
+
+  constexpr size_t operator()(size_t capacity,
+                              size_t required) const noexcept;
+};
+
+/// <summary>
+/// Calculates the grown capacity. Empty containers get the initial capacity.
+/// </summary>
+/// <param name="capacity"> current capacity.</param>
+/// <param name="required"> amount of elements that has to fit.</param>
+/// <returns> new capacity, not smaller than required.</returns>
+template <size_t Numerator, size_t Denominator>
+constexpr size_t MultiplicativeGrowth<Numerator, Denominator>::operator()(
+    size_t capacity, size_t required) const noexcept {
+  if (capacity == 0) {
+    return required < kInitialGrowthCapacity ? kInitialGrowthCapacity
+                                             : required;
+  }
+  const size_t grown{capacity / Denominator * Numerator +
+                     capacity % Denominator * Numerator / Denominator};
+  return grown < required ? required : grown;
+}
+
+/// <summary>
+/// Calculates the grown capacity by rounding the required amount up to
+/// a multiple of the chunk.
+/// </summary>
+/// <param name="capacity"> current capacity.</param>
+/// <param name="required"> amount of elements that has to fit.</param>
+/// <returns> new capacity, not smaller than required.</returns>
+template <size_t Chunk>
+constexpr size_t FixedChunkGrowth<Chunk>::operator()(
+    size_t capacity, size_t required) const noexcept {
+  const size_t grown{(required + Chunk - 1) / Chunk * Chunk};
+  return grown < capacity ? capacity : grown;
+}
+
+}  // namespace alglib
+
+#endif  // ALGLIB_INCLUDE_GROWTHPOLICY_H_
@@ -0,0 +1,400 @@
+//*****************************************************************************
+// The MIT License (MIT)
+//
+// Copyright � 2024 Piotr Walczak
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the �Software�), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED �AS IS�, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//*****************************************************************************
+
+//*****************************************************************************
+// File: hazard_pointers.h
+//
+// This file contains the implementation of hazard pointers, a safe memory
+// reclamation scheme for lock-free data structures. Before a thread reads a
+// shared node it publishes the node's address in one of its hazard slots.
+// Nodes unlinked from a structure are retired instead of freed, and a retired
+// node is only released once no thread publishes it. The class is implemented
+// in the alglib namespace.
+//*****************************************************************************
+
+#ifndef ALGLIB_INCLUDE_HAZARDPOINTERS_H_
+#define ALGLIB_INCLUDE_HAZARDPOINTERS_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+/// <summary>
+/// Default namespace for the AlgLib library.
+/// </summary>
+namespace alglib {
+
+/// <summary>
+/// Process wide hazard pointer domain. Every thread that uses it gets a
+/// record with a few hazard slots, which is handed over to another thread
+/// when the first one exits. Each thread keeps its retired nodes and scans
+/// the slots of all threads once enough of them pile up. Nodes still
+/// retired by exiting threads are passed to whichever thread scans next.
+/// </summary>
+class HazardPointers {
+ public:
+  /// <summary>
+  /// Number of hazard slots of every thread.
+  /// </summary>
+  static constexpr size_t kSlotsPerThread{2};
+
+  /// <summary>
+  /// Function releasing a retired node.
+  /// </summary>
+  using Deleter = void (*)(void *);
+
+  HazardPointers() = delete;
+
+  // Methods for protecting nodes read by the calling thread.
+  template <typename T>
+  static T *Protect(size_t slot, const std::atomic<T *> &source) noexcept;
+  static void Set(size_t slot, const void *pointer) noexcept;
+  static void Clear(size_t slot) noexcept;
+
+  // Methods for releasing unlinked nodes.
+  static void Retire(void *node, Deleter deleter);
+  static void Reserve(size_t count);
+  static void RetireReserved(void *node, Deleter deleter) noexcept;
+  static void Scan();
+
+  // Number of nodes retired by the calling thread and not yet released.
+  static size_t RetiredCount() noexcept;
+
+ private:
+  /// <summary>
+  /// Hazard slots of a single thread, linked into a list that never shrinks.
+  /// </summary>
+  struct Record {
+    std::atomic<const void *> slots[kSlotsPerThread]{};
+    std::atomic<bool> active{true};
+    Record *next{nullptr};
+  };
+
+  /// <summary>
+  /// Retired node waiting to be released.
+  /// </summary>
+  struct Retired {
+    void *node;
+    Deleter deleter;
+  };
+
+  /// <summary>
+  /// State shared by all threads. It is never destroyed, so threads can
+  /// still retire nodes while the program exits.
+  /// </summary>
+  struct Domain {
+    std::atomic<Record *> records{nullptr};
+    std::atomic<size_t> record_count{0};
+    std::mutex orphans_mutex;
+    std::vector<Retired> orphans;
+    // Room in orphans promised by Reserve to threads whose state was
+    // destroyed, guarded by orphans_mutex.
+    size_t orphans_reserved{0};
+  };
+
+  /// <summary>
+  /// State of a single thread. On destruction it gives its record back and
+  /// passes nodes it couldn't release to the domain.
+  /// </summary>
+  struct ThreadState {
+    ThreadState();
+    ~ThreadState();
+
+    Record *record;
+    std::vector<Retired> retired;
+
+    // Set when the state of the thread is destroyed. Nodes retired later,
+    // for example by thread_local structures, go straight to the domain.
+    static inline thread_local bool destroyed{false};
+    // Room in the orphans of the domain reserved by the thread after its
+    // state was destroyed.
+    static inline thread_local size_t orphan_reservation{0};
+  };
+
+  // Minimum number of retired nodes that triggers a scan.
+  static constexpr size_t kScanThreshold{64};
+
+  static Domain &GetDomain();
+  static ThreadState &Local();
+  static Record *AcquireRecord();
+  static size_t ScanThreshold();
+  static void ReserveOrphans(Domain &domain, size_t count);
+  static void ScanRetired(std::vector<Retired> &retired);
+};
+
+/// <summary>
+/// Loads a pointer and publishes it in a hazard slot of the calling thread,
+/// retrying until the published value is still the current one. After that
+/// the node can't be released until the slot is cleared or overwritten.
+/// </summary>
+/// <param name="slot"> index of the slot, smaller than
+/// kSlotsPerThread.</param>
+/// <param name="source"> atomic pointer to the node.</param>
+/// <returns> protected pointer, can be nullptr.</returns>
+template <typename T>
+T *HazardPointers::Protect(size_t slot,
+                           const std::atomic<T *> &source) noexcept {
+  std::atomic<const void *> &hazard{Local().record->slots[slot]};
+  T *pointer{source.load(std::memory_order_relaxed)};
+  while (true) {
+    hazard.store(pointer, std::memory_order_seq_cst);
+    T *current{source.load(std::memory_order_seq_cst)};
+    if (current == pointer) return pointer;
+    pointer = current;
+  }
+}
+
+/// <summary>
+/// Publishes a pointer in a hazard slot of the calling thread. The caller has
+/// to check afterwards that the node is still reachable.
+/// </summary>
+/// <param name="slot"> index of the slot.</param>
+/// <param name="pointer"> pointer to the node.</param>
+inline void HazardPointers::Set(size_t slot, const void *pointer) noexcept {
+  Local().record->slots[slot].store(pointer, std::memory_order_seq_cst);
+}
+
+/// <summary>
+/// Clears a hazard slot of the calling thread.
+/// </summary>
+/// <param name="slot"> index of the slot.</param>
+inline void HazardPointers::Clear(size_t slot) noexcept {
+  Local().record->slots[slot].store(nullptr, std::memory_order_release);
+}
+
+/// <summary>
+/// Hands over a node that was unlinked from a structure. It is released with
+/// the deleter once no thread publishes it in a hazard slot.
+/// </summary>
+/// <param name="node"> unlinked node.</param>
+/// <param name="deleter"> function releasing the node.</param>
+inline void HazardPointers::Retire(void *node, Deleter deleter) {
+  if (ThreadState::destroyed) {
+    Domain &domain{GetDomain()};
+    std::lock_guard<std::mutex> lock(domain.orphans_mutex);
+    ReserveOrphans(domain, 1);
+    domain.orphans.push_back({node, deleter});
+    return;
+  }
+  ThreadState &state{Local()};
+  state.retired.push_back({node, deleter});
+  if (state.retired.size() >= ScanThreshold()) Scan();
+}
+
+/// <summary>
+/// Makes room for nodes that the calling thread will hand over with
+/// RetireReserved, which then can't fail. It also creates the state of the
+/// thread, so Protect, Set and Clear don't allocate afterwards. A new call
+/// replaces the room made by the previous one.
+/// </summary>
+/// <param name="count"> number of nodes to make room for.</param>
+inline void HazardPointers::Reserve(size_t count) {
+  if (ThreadState::destroyed) {
+    Domain &domain{GetDomain()};
+    std::lock_guard<std::mutex> lock(domain.orphans_mutex);
+    domain.orphans_reserved -= ThreadState::orphan_reservation;
+    ThreadState::orphan_reservation = 0;
+    ReserveOrphans(domain, count);
+    domain.orphans_reserved += count;
+    ThreadState::orphan_reservation = count;
+    return;
+  }
+  ThreadState &state{Local()};
+  if (state.retired.size() >= ScanThreshold()) Scan();
+  const size_t needed{state.retired.size() + count};
+  if (needed > state.retired.capacity()) {
+    state.retired.reserve(std::max(needed, 2 * state.retired.capacity()));
+  }
+}
+
+/// <summary>
+/// Hands over a node like Retire, using room made by Reserve, so it neither
+/// allocates nor throws. It doesn't scan; the next Retire or Reserve does.
+/// </summary>
+/// <param name="node"> unlinked node.</param>
+/// <param name="deleter"> function releasing the node.</param>
+inline void HazardPointers::RetireReserved(void *node,
+                                           Deleter deleter) noexcept {
+  if (ThreadState::destroyed) {
+    Domain &domain{GetDomain()};
+    std::lock_guard<std::mutex> lock(domain.orphans_mutex);
+    domain.orphans.push_back({node, deleter});
+    --domain.orphans_reserved;
+    --ThreadState::orphan_reservation;
+    return;
+  }
+  Local().retired.push_back({node, deleter});
+}
+
+/// <summary>
+/// Releases all nodes retired by the calling thread, or by threads that
+/// exited, that are not published in any hazard slot.
+/// </summary>
+inline void HazardPointers::Scan() { ScanRetired(Local().retired); }
+
+/// <summary>
+/// Returns number of nodes retired by the calling thread that were not
+/// released yet.
+/// </summary>
+inline size_t HazardPointers::RetiredCount() noexcept {
+  return Local().retired.size();
+}
+
+/// <summary>
+/// Returns number of retired nodes of a thread that triggers a scan. It grows
+/// with the number of hazard slots, so a scan always releases some nodes.
+/// </summary>
+/// <returns> minimum number of retired nodes scanned at once.</returns>
+inline size_t HazardPointers::ScanThreshold() {
+  return std::max(kScanThreshold,
+                  2 * kSlotsPerThread *
+                      GetDomain().record_count.load(std::memory_order_relaxed));
+}
+
+/// <summary>
+/// Makes room in the orphans of the domain for more nodes, keeping the room
+/// promised by Reserve. The orphans mutex has to be held.
+/// </summary>
+/// <param name="domain"> domain shared by all threads.</param>
+/// <param name="count"> number of nodes to make room for.</param>
+inline void HazardPointers::ReserveOrphans(Domain &domain, size_t count) {
+  std::vector<Retired> &orphans{domain.orphans};
+  const size_t needed{orphans.size() + domain.orphans_reserved + count};
+  if (needed > orphans.capacity()) {
+    orphans.reserve(std::max(needed, 2 * orphans.capacity()));
+  }
+}
+
+/// <summary>
+/// Releases retired nodes that are not published in any hazard slot. Nodes
+/// left by exited threads are taken over first.
+/// </summary>
+/// <param name="retired"> nodes retired by the calling thread. Nodes that
+/// are still protected stay in it.</param>
+inline void HazardPointers::ScanRetired(std::vector<Retired> &retired) {
+  Domain &domain{GetDomain()};
+  {
+    std::lock_guard<std::mutex> lock(domain.orphans_mutex);
+    retired.insert(retired.end(), domain.orphans.begin(),
+                   domain.orphans.end());
+    domain.orphans.clear();
+  }
+
+  // Pairs with the stores in Protect, so a slot published before a node was
+  // unlinked is seen here.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  std::vector<const void *> hazards;
+  for (Record *record{domain.records.load(std::memory_order_acquire)}; record;
+       record = record->next) {
+    for (std::atomic<const void *> &slot : record->slots) {
+      const void *pointer{slot.load(std::memory_order_seq_cst)};
+      if (pointer) hazards.push_back(pointer);
+    }
+  }
+  std::sort(hazards.begin(), hazards.end());
+
+  std::vector<Retired> kept;
+  for (const Retired &node : retired) {
+    if (std::binary_search(hazards.begin(), hazards.end(), node.node)) {
+      kept.push_back(node);
+    } else {
+      node.deleter(node.node);
+    }
+  }
+  retired.swap(kept);
+}
+
+/// <summary>
+/// Returns the domain shared by all threads.
+/// </summary>
+inline HazardPointers::Domain &HazardPointers::GetDomain() {
+  static Domain *domain{new Domain()};
+  return *domain;
+}
+
+/// <summary>
+/// Returns state of the calling thread, creating it on first use.
+/// </summary>
+inline HazardPointers::ThreadState &HazardPointers::Local() {
+  thread_local ThreadState state;
+  return state;
+}
+
+/// <summary>
+/// Takes over a record given back by an exited thread or adds a new one to
+/// the list of records.
+/// </summary>
+/// <returns> record owned by the calling thread.</returns>
+inline HazardPointers::Record *HazardPointers::AcquireRecord() {
+  Domain &domain{GetDomain()};
+  for (Record *record{domain.records.load(std::memory_order_acquire)}; record;
+       record = record->next) {
+    bool active{false};
+    if (!record->active.load(std::memory_order_relaxed) &&
+        record->active.compare_exchange_strong(active, true,
+                                               std::memory_order_acquire)) {
+      return record;
+    }
+  }
+  Record *record{new Record()};
+  Record *head{domain.records.load(std::memory_order_relaxed)};
+  do {
+    record->next = head;
+  } while (!domain.records.compare_exchange_weak(head, record,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed));
+  domain.record_count.fetch_add(1, std::memory_order_relaxed);
+  return record;
+}
+
+/// <summary>
+/// Constructor for the state of a thread, acquiring its record.
+/// </summary>
+inline HazardPointers::ThreadState::ThreadState() : record(AcquireRecord()) {}
+
+/// <summary>
+/// Destructor for the state of a thread. It releases what it can, passes the
+/// remaining nodes to the domain and gives the record back.
+/// </summary>
+inline HazardPointers::ThreadState::~ThreadState() {
+  for (std::atomic<const void *> &slot : record->slots) {
+    slot.store(nullptr, std::memory_order_release);
+  }
+  ScanRetired(retired);
+  if (!retired.empty()) {
+    Domain &domain{GetDomain()};
+    std::lock_guard<std::mutex> lock(domain.orphans_mutex);
+    ReserveOrphans(domain, retired.size());
+    domain.orphans.insert(domain.orphans.end(), retired.begin(),
+                          retired.end());
+  }
+  record->active.store(false, std::memory_order_release);
+  destroyed = true;
+}
+
+}  // namespace alglib
+
+#endif  // ALGLIB_INCLUDE_HAZARDPOINTERS_H_
@@ -0,0 +1,1106 @@
+//*****************************************************************************
+// The MIT License (MIT)
+//
+// Copyright � 2024 Piotr Walczak
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the �Software�), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED �AS IS�, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//*****************************************************************************
+
+//*****************************************************************************
+// File: mapped_vector.h
+//
+// This file contains the implementation of the MappedVector class. MappedVector
+// keeps trivially copyable elements in a memory mapped file, so opening an
+// existing dataset doesn't need to read or deserialize it and many processes
+// can share its pages through the page cache. The file holds nothing but the
+// elements, one after another. The class is implemented with mmap on POSIX
+// systems and with MapViewOfFile on Windows, in the alglib namespace.
+//*****************************************************************************
+
+#ifndef ALGLIB_INCLUDE_MAPPEDVECTOR_H_
+#define ALGLIB_INCLUDE_MAPPEDVECTOR_H_
+
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "constants.h"
+#include "growth_policy.h"
+#include "stats.h"
+#include "vector.h"
+
+/// <summary>
+/// Default namespace for the AlgLib library.
+/// </summary>
+namespace alglib {
+
+/// <summary>
+/// Modes in which MappedVector can open a file.
+/// </summary>
+enum class MapMode {
+  /// <summary>
+  /// File is mapped without write access. Existing file is required and
+  /// methods that modify the vector throw an exception.
+  /// </summary>
+  kReadOnly,
+  /// <summary>
+  /// File is created if it doesn't exist and changes are written back to it.
+  /// </summary>
+  kReadWrite
+};
+
+/// <summary>
+/// Hints about the expected access pattern passed to the operating system.
+/// </summary>
+enum class AccessAdvice { kNormal, kSequential, kRandom, kWillNeed, kDontNeed };
+
+/// <summary>
+/// Vector of trivially copyable elements that lives in a memory mapped file.
+/// It has the same accessors and iterators as Vector. File may be larger than
+/// the elements while the vector is open, as capacity is reserved in the file
+/// itself, and it is truncated to the exact size of the elements when the
+/// vector is closed. Elements of a read-only vector must not be modified
+/// through references or iterators, because the pages are mapped without
+/// write access.
+/// </summary>
+/// <typeparam name="T"> type of data stored in vector.</typeparam>
+/// <typeparam name="Growth"> policy that calculates new capacity when the
+/// vector runs out of space.</typeparam>
+template <typename T, typename Growth = DoublingGrowth>
+class MappedVector {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "MappedVector can only store trivially copyable types.");
+  static_assert(GrowthPolicy<Growth>,
+                "Growth has to satisfy the GrowthPolicy concept.");
+
+ public:
+  using Iterator = VectorIter<T>;
+  using ConstIterator = ConstVectorIter<T>;
+  using ReverseIterator = ReverseVectorIter<T>;
+  using ConstReverseIterator = ConstReverseVectorIter<T>;
+
+  // Constructors, assignment and destructor for the MappedVector.
+  MappedVector() noexcept;
+  explicit MappedVector(const std::filesystem::path &path,
+                        MapMode mode = MapMode::kReadWrite);
+  MappedVector(const MappedVector &) = delete;
+  MappedVector(MappedVector &&other) noexcept;
+  MappedVector &operator=(const MappedVector &) = delete;
+  MappedVector &operator=(MappedVector &&other) noexcept;
+  ~MappedVector() noexcept;
+
+  // Opening and closing the file.
+  void Open(const std::filesystem::path &path,
+            MapMode mode = MapMode::kReadWrite);
+  void Close();
+  bool IsOpen() const noexcept;
+  bool IsReadOnly() const noexcept;
+
+  // Inserting and removing elements from the vector.
+  void Push(const T &value);
+  T Pop();
+
+  // Accessing elements in the vector.
+  T &At(size_t index);
+  const T &At(size_t index) const;
+  T &Front();
+  const T &Front() const;
+  T &Back();
+  const T &Back() const;
+
+  // Getting size and capacity of the vector.
+  size_t Size() const noexcept;
+  size_t Capacity() const noexcept;
+
+  // Getting statistics of the vector.
+  ContainerStats GetStats() const noexcept;
+
+  // Resizing and reserving the vector.
+  void Resize(size_t new_size);
+  void Resize(size_t new_size, const T &value);
+  void Reserve(size_t amount);
+  void Clear();
+
+  // Working with the mapping.
+  void Sync();
+  void Advise(AccessAdvice advice);
+
+  // Accessing underlying contiguous memory.
+  T *Data() noexcept;
+  const T *Data() const noexcept;
+  std::span<T> AsSpan() noexcept;
+  std::span<const T> AsSpan() const noexcept;
+
+  // Iterators
+  Iterator begin() noexcept;
+  Iterator end() noexcept;
+  ConstIterator begin() const noexcept;
+  ConstIterator end() const noexcept;
+  ConstIterator cbegin() const noexcept;
+  ConstIterator cend() const noexcept;
+  ReverseIterator rbegin() noexcept;
+  ReverseIterator rend() noexcept;
+  ConstReverseIterator crbegin() const noexcept;
+  ConstReverseIterator crend() const noexcept;
+  Iterator Begin() noexcept;
+  Iterator End() noexcept;
+  ConstIterator ConstBegin() const noexcept;
+  ConstIterator ConstEnd() const noexcept;
+  ReverseIterator ReverseBegin() noexcept;
+  ReverseIterator ReverseEnd() noexcept;
+  ConstReverseIterator ConstReverseBegin() const noexcept;
+  ConstReverseIterator ConstReverseEnd() const noexcept;
+
+ private:
+  // Methods that check state before modifying the vector.
+  void CheckWritable() const;
+  void CheckIndex(size_t index) const;
+
+  // Methods that calculate new capacity and map the file again with it.
+  size_t GrownCapacity(size_t required) const;
+  void Remap(size_t new_capacity);
+
+  // Platform specific methods working with the file and the mapping.
+  void OpenFile(const std::filesystem::path &path);
+  size_t FileBytes() const;
+  void SetFileBytes(size_t bytes);
+  T *MapFile(size_t bytes);
+  void UnmapFile(T *block, size_t bytes) noexcept;
+  void CloseFile() noexcept;
+  [[noreturn]] static void ThrowSystemError();
+
+  // Method that swaps all members with other vector.
+  void Swap(MappedVector &other) noexcept;
+
+  /// <summary>
+  /// Amount of elements in the vector.
+  /// </summary>
+  size_t size;
+
+  /// <summary>
+  /// Amount of elements that fit in the mapped part of the file.
+  /// </summary>
+  size_t capacity;
+
+  /// <summary>
+  /// Pointer to the beginning of the mapping or nullptr if nothing is mapped.
+  /// </summary>
+  T *data;
+
+  /// <summary>
+  /// Flag telling whether the file was opened without write access.
+  /// </summary>
+  bool read_only;
+
+  /// <summary>
+  /// Policy that calculates new capacity when the vector grows.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS Growth growth;
+
+  /// <summary>
+  /// Statistics of the vector, empty unless ALGLIB_ENABLE_STATS is defined.
+  /// They belong to the vector object and aren't swapped with the file.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS detail::StatsRecorder stats;
+
+#ifdef _WIN32
+  /// <summary>
+  /// Handle of the open file.
+  /// </summary>
+  HANDLE file;
+
+  /// <summary>
+  /// Handle of the file mapping object backing the current view.
+  /// </summary>
+  HANDLE mapping;
+#else
+  /// <summary>
+  /// Descriptor of the open file.
+  /// </summary>
+  int file;
+#endif
+};
+
+/// <summary>
+/// Constructor creating a vector that isn't attached to any file. Open has to
+/// be called before elements are added.
+/// </summary>
+template <typename T, typename Growth>
+MappedVector<T, Growth>::MappedVector() noexcept
+    : size(0),
+      capacity(0),
+      data(nullptr),
+      read_only(false),
+      growth(),
+#ifdef _WIN32
+      file(INVALID_HANDLE_VALUE),
+      mapping(nullptr) {
+}
+#else
+      file(-1) {
+}
+#endif
+
+/// <summary>
+/// Constructor that opens a file and maps all elements it contains.
+/// </summary>
+/// <param name="path"> path to the file.</param>
+/// <param name="mode"> mode in which the file is opened.</param>
+template <typename T, typename Growth>
+MappedVector<T, Growth>::MappedVector(const std::filesystem::path &path,
+                                      MapMode mode)
+    : MappedVector() {
+  Open(path, mode);
+}
+
+/// <summary>
+/// Move constructor. Takes over the file and the mapping of the other vector,
+/// which is left closed.
+/// </summary>
+/// <param name="other"> vector that will be moved from.</param>
+template <typename T, typename Growth>
+MappedVector<T, Growth>::MappedVector(MappedVector &&other) noexcept
+    : MappedVector() {
+  Swap(other);
+}
+
+/// <summary>
+/// Move assignment operator. Closes the current file and takes over the file
+/// of the other vector.
+/// </summary>
+/// <param name="other"> vector that will be moved from.</param>
+/// <returns> reference to this vector.</returns>
+template <typename T, typename Growth>
+MappedVector<T, Growth> &MappedVector<T, Growth>::operator=(
+    MappedVector &&other) noexcept {
+  if (this != &other) {
+    MappedVector tmp(std::move(other));
+    Swap(tmp);
+  }
+  return *this;
+}
+
+/// <summary>
+/// Destructor. Closes the file, errors are ignored. Close should be called
+/// explicitly when errors have to be detected.
+/// </summary>
+template <typename T, typename Growth>
+MappedVector<T, Growth>::~MappedVector() noexcept {
+  ALGLIB_TRY {
+    Close();
+  } ALGLIB_CATCH_ALL {
+  }
+}
+
+/// <summary>
+/// Opens a file and maps all elements it contains. Currently open file is
+/// closed first. No element is read, pages are loaded on first access.
+/// </summary>
+/// <param name="path"> path to the file.</param>
+/// <param name="mode"> mode in which the file is opened.</param>
+/// <exception cref="std::system_error"> thrown when the file can't be opened
+/// or mapped.</exception>
+/// <exception cref="std::runtime_error"> thrown when the file size is not a
+/// multiple of element size.</exception>
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::Open(const std::filesystem::path &path,
+                                   MapMode mode) {
+  Close();
+  read_only = mode == MapMode::kReadOnly;
+  OpenFile(path);
+  ALGLIB_TRY {
+    const size_t bytes{FileBytes()};
+    if (bytes % sizeof(T) != 0) {
+      ALGLIB_THROW(std::runtime_error(errors::kMisalignedFile));
+    }
+    data = MapFile(bytes);
+    size = bytes / sizeof(T);
+    capacity = size;
+    if (data) stats.Allocation();
+    stats.Size(size);
+  } ALGLIB_CATCH_ALL {
+    CloseFile();
+    ALGLIB_RETHROW;
+  }
+}
+
+/// <summary>
+/// Unmaps the elements and closes the file. Writable files are truncated to
+/// the size of the elements, so reserved capacity doesn't stay in the file.
+/// Closing a vector without open file does nothing.
+/// </summary>
+/// <exception cref="std::system_error"> thrown when the file can't be
+/// truncated.</exception>
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::Close() {
+  if (!IsOpen()) return;
+  if (data) stats.Deallocation();
+  UnmapFile(data, capacity * sizeof(T));
+  data = nullptr;
+  capacity = 0;
+#ifdef _WIN32
+  // File can't be truncated while a mapping object refers to it.
+  if (mapping) CloseHandle(mapping);
+  mapping = nullptr;
+#endif
+  struct FileCloser {
+    MappedVector *vector;
+    ~FileCloser() { vector->CloseFile(); }
+  } closer{this};
+  const size_t bytes{size * sizeof(T)};
+  size = 0;
+  if (!read_only) {
+    SetFileBytes(bytes);
+  }
+}
+
+/// <summary>
+/// Method for checking whether the vector is attached to a file.
+/// </summary>
+/// <returns> true if a file is open.</returns>
+template <typename T, typename Growth>
+bool MappedVector<T, Growth>::IsOpen() const noexcept {
+#ifdef _WIN32
+  return file != INVALID_HANDLE_VALUE;
+#else
+  return file != -1;
+#endif
+}
+
+/// <summary>
+/// Method for checking whether the file was opened without write access.
+/// </summary>
+/// <returns> true if the vector is read-only.</returns>
+template <typename T, typename Growth>
+bool MappedVector<T, Growth>::IsReadOnly() const noexcept {
+  return read_only;
+}
+
+/// <summary>
+/// Adds a copy of the value to the end of the vector. If the size exceeds the
+/// capacity, the file is grown by the growth policy and mapped again.
+/// </summary>
+/// <param name="value"> value to be added.</param>
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::Push(const T &value) {
+  CheckWritable();
+  if (size == capacity) {
+    const T copy(value);
+    Remap(GrownCapacity(size + 1));
+    data[size++] = copy;
+    stats.Size(size);
+    return;
+  }
+  data[size++] = value;
+  stats.Size(size);
+}
+
+/// <summary>
+/// Removes the last element of the vector and returns it. Capacity in the file
+/// is kept.
+/// </summary>
+/// <returns> removed element.</returns>
+template <typename T, typename Growth>
+T MappedVector<T, Growth>::Pop() {
+  CheckWritable();
+  if (size == 0) ALGLIB_THROW(std::runtime_error(errors::kEmptyDeletion));
+  return data[--size];
+}
+
+/// <summary>
+/// Returns the element at a given index.
+/// </summary>
+/// <param name="index"> index of the element.</param>
+/// <returns> reference to the element.</returns>
+/// <exception cref="std::runtime_error"> thrown when the index is out of
+/// range.</exception>
+template <typename T, typename Growth>
+T &MappedVector<T, Growth>::At(size_t index) {
+  CheckIndex(index);
+  return data[index];
+}
+
+/// <summary>
+/// Returns the element at a given index.
+/// </summary>
+/// <param name="index"> index of the element.</param>
+/// <returns> constant reference to the element.</returns>
+/// <exception cref="std::runtime_error"> thrown when the index is out of
+/// range.</exception>
+template <typename T, typename Growth>
+const T &MappedVector<T, Growth>::At(size_t index) const {
+  CheckIndex(index);
+  return data[index];
+}
+
+/// <summary>
+/// Returns the first element of the vector.
+/// </summary>
+/// <returns> first element of the vector.</returns>
+template <typename T, typename Growth>
+T &MappedVector<T, Growth>::Front() {
+  return data[0];
+}
+
+/// <summary>
+/// Returns the first element of the vector.
+/// </summary>
+/// <returns> first element of the vector.</returns>
+template <typename T, typename Growth>
+const T &MappedVector<T, Growth>::Front() const {
+  return data[0];
+}
+
+/// <summary>
+/// Returns the last element of the vector.
+/// </summary>
+/// <returns> last element of the vector.</returns>
+template <typename T, typename Growth>
+T &MappedVector<T, Growth>::Back() {
+  return data[size - 1];
+}
+
+/// <summary>
+/// Returns the last element of the vector.
+/// </summary>
+/// <returns> last element of the vector.</returns>
+template <typename T, typename Growth>
+const T &MappedVector<T, Growth>::Back() const {
+  return data[size - 1];
+}
+
+/// <summary>
+/// Method for getting amount of elements in the vector.
+/// </summary>
+/// <returns> size of the vector.</returns>
+template <typename T, typename Growth>
+size_t MappedVector<T, Growth>::Size() const noexcept {
+  return size;
+}
+
+/// <summary>
+/// Method for getting amount of elements that fit in the mapped file.
+/// </summary>
+/// <returns> capacity of the vector.</returns>
+template <typename T, typename Growth>
+size_t MappedVector<T, Growth>::Capacity() const noexcept {
+  return capacity;
+}
+
+/// <summary>
+/// Returns statistics of the vector. Every mapping of the file counts as an
+/// allocation and every unmapping as a deallocation. Growing the file counts
+/// as a reallocation that moves no bytes, as the elements stay in the file.
+/// The biggest size includes elements found in the file when it was opened.
+/// Without ALGLIB_ENABLE_STATS all counters are zero.
+/// </summary>
+/// <returns> statistics of the vector.</returns>
+template <typename T, typename Growth>
+ContainerStats MappedVector<T, Growth>::GetStats() const noexcept {
+  return stats.Get();
+}
+
+/// <summary>
+/// Modifies the size of the vector. New elements are value initialized.
+/// Capacity is kept when the vector shrinks.
+/// </summary>
+/// <param name="new_size"> new size.</param>
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::Resize(size_t new_size) {
+  Resize(new_size, T());
+}
+
+/// <summary>
+/// Modifies the size of the vector. New elements are copies of a given value.
+/// Capacity is kept when the vector shrinks.
+/// </summary>
+/// <param name="new_size"> new size.</param>
+/// <param name="value"> value that the new elements will be initialised
+/// to.</param>
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::Resize(size_t new_size, const T &value) {
+  CheckWritable();
+  const T copy(value);
+  if (new_size > capacity) {
+    Remap(GrownCapacity(new_size));
+  }
+  for (; size < new_size; ++size) {
+    data[size] = copy;
+  }
+  size = new_size;
+  stats.Size(size);
+}
+
+/// <summary>
+/// Makes sure that a given amount of elements fits in the file without
+/// mapping it again. Capacity is never decreased.
+/// </summary>
+/// <param name="amount"> amount of elements to reserve space for.</param>
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::Reserve(size_t amount) {
+  CheckWritable();
+  if (amount > capacity) {
+    Remap(amount);
+  }
+}
+
+/// <summary>
+/// Removes all elements of the vector. Space in the file is kept until the
+/// vector is closed.
+/// </summary>
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::Clear() {
+  CheckWritable();
+  size = 0;
+}
+
+/// <summary>
+/// Writes modified pages back to the file and waits until they are stored.
+/// Does nothing for read-only vectors.
+/// </summary>
+/// <exception cref="std::system_error"> thrown when writing fails.</exception>
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::Sync() {
+  if (read_only || data == nullptr) return;
+#ifdef _WIN32
+  if (!FlushViewOfFile(data, 0) || !FlushFileBuffers(file)) {
+    ThrowSystemError();
+  }
+#else
+  if (msync(data, capacity * sizeof(T), MS_SYNC) != 0) {
+    ThrowSystemError();
+  }
+#endif
+}
+
+/// <summary>
+/// Tells the operating system how the elements will be accessed, so it can
+/// adjust read-ahead or load and drop pages early. Advice is only a hint and
+/// it is ignored on systems that don't support it.
+/// </summary>
+/// <param name="advice"> expected access pattern.</param>
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::Advise(AccessAdvice advice) {
+  if (data == nullptr) return;
+#ifdef _WIN32
+  (void)advice;
+#else
+  int native{POSIX_MADV_NORMAL};
+  switch (advice) {
+    case AccessAdvice::kNormal:
+      native = POSIX_MADV_NORMAL;
+      break;
+    case AccessAdvice::kSequential:
+      native = POSIX_MADV_SEQUENTIAL;
+      break;
+    case AccessAdvice::kRandom:
+      native = POSIX_MADV_RANDOM;
+      break;
+    case AccessAdvice::kWillNeed:
+      native = POSIX_MADV_WILLNEED;
+      break;
+    case AccessAdvice::kDontNeed:
+      native = POSIX_MADV_DONTNEED;
+      break;
+  }
+  posix_madvise(data, capacity * sizeof(T), native);
+#endif
+}
+
+/// <summary>
+/// Returns pointer to the first element of the vector.
+/// </summary>
+template <typename T, typename Growth>
+T *MappedVector<T, Growth>::Data() noexcept {
+  return data;
+}
+
+/// <summary>
+/// Returns pointer to the first element of the vector.
+/// </summary>
+template <typename T, typename Growth>
+const T *MappedVector<T, Growth>::Data() const noexcept {
+  return data;
+}
+
+/// <summary>
+/// Returns span that views all elements of the vector.
+/// </summary>
+template <typename T, typename Growth>
+std::span<T> MappedVector<T, Growth>::AsSpan() noexcept {
+  return std::span<T>(data, size);
+}
+
+/// <summary>
+/// Returns span that views all elements of the vector.
+/// </summary>
+template <typename T, typename Growth>
+std::span<const T> MappedVector<T, Growth>::AsSpan() const noexcept {
+  return std::span<const T>(data, size);
+}
+
+/// <summary>
+/// Standard compliant function returning iterator object
+/// </summary>
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::Iterator
+MappedVector<T, Growth>::begin() noexcept {
+  return Iterator(data);
+}
+
+/// <summary>
+/// Standard compliant function returning iterator object
+/// </summary>
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::Iterator
+MappedVector<T, Growth>::end() noexcept {
+  return Iterator(data + size);
+}
+
+/// <summary>
+/// Standard compliant function returning iterator object
+/// </summary>
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::ConstIterator
+MappedVector<T, Growth>::begin() const noexcept {
+  return ConstIterator(data);
+}
+
+/// <summary>
+/// Standard compliant function returning iterator object
+/// </summary>
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::ConstIterator
+MappedVector<T, Growth>::end() const noexcept {
+  return ConstIterator(data + size);
+}
+
+/// <summary>
+/// Standard compliant function returning iterator object
+/// </summary>
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::ConstIterator
+MappedVector<T, Growth>::cbegin() const noexcept {
+  return ConstIterator(data);
+}
+
+/// <summary>
+/// Standard compliant function returning iterator object
+/// </summary>
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::ConstIterator
+MappedVector<T, Growth>::cend() const noexcept {
+  return ConstIterator(data + size);
+}
+
+/// <summary>
+/// Standard compliant function returning iterator object
+/// </summary>
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::ReverseIterator
+MappedVector<T, Growth>::rbegin() noexcept {
+  return ReverseIterator(end());
+}
+
+/// <summary>
+/// Standard compliant function returning iterator object
+/// </summary>
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::ReverseIterator
+MappedVector<T, Growth>::rend() noexcept {
+  return ReverseIterator(begin());
+}
+
+/// <summary>
+/// Standard compliant function returning iterator object
+/// </summary>
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::ConstReverseIterator
+MappedVector<T, Growth>::crbegin() const noexcept {
+  return ConstReverseIterator(cend());
+}
+
+/// <summary>
+/// Standard compliant function returning iterator object
+/// </summary>
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::ConstReverseIterator
+MappedVector<T, Growth>::crend() const noexcept {
+  return ConstReverseIterator(cbegin());
+}
+
+/// <summary>
+/// Wrapper around standard compliant function name
+/// </summary>
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::Iterator
+MappedVector<T, Growth>::Begin() noexcept {
+  return begin();
+}
+
+/// <summary>
+/// Wrapper around standard compliant function name
+/// </summary>
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::Iterator
+MappedVector<T, Growth>::End() noexcept {
+  return end();
+}
+
+/// <summary>
+/// Wrapper around standard compliant function name
+/// </summary>
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::ConstIterator
+MappedVector<T, Growth>::ConstBegin() const noexcept {
+  return cbegin();
+}
+
+/// <summary>
+/// Wrapper around standard compliant function name
+/// </summary>
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::ConstIterator
+MappedVector<T, Growth>::ConstEnd() const noexcept {
+  return cend();
+}
+
+/// <summary>
+/// Wrapper around standard compliant function name
+/// </summary>
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::ReverseIterator
+MappedVector<T, Growth>::ReverseBegin() noexcept {
+  return rbegin();
+}
+
+/// <summary>
+/// Wrapper around standard compliant function name
+/// </summary>
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::ReverseIterator
+MappedVector<T, Growth>::ReverseEnd() noexcept {
+  return rend();
+}
+
+/// <summary>
+/// Wrapper around standard compliant function name
+/// </summary>
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::ConstReverseIterator
+MappedVector<T, Growth>::ConstReverseBegin() const noexcept {
+  return crbegin();
+}
+
+/// <summary>
+/// Wrapper around standard compliant function name
+/// </summary>
+template <typename T, typename Growth>
+typename MappedVector<T, Growth>::ConstReverseIterator
+MappedVector<T, Growth>::ConstReverseEnd() const noexcept {
+  return crend();
+}
+
+/// <summary>
+/// Throws an exception if the vector can't be modified.
+/// </summary>
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::CheckWritable() const {
+  if (!IsOpen()) ALGLIB_THROW(std::runtime_error(errors::kMappingFailed));
+  if (read_only) ALGLIB_THROW(std::runtime_error(errors::kReadOnlyObject));
+}
+
+/// <summary>
+/// Throws an exception if the index is out of range.
+/// </summary>
+/// <param name="index"> index to be checked.</param>
+/// <exception cref="std::runtime_error"> thrown when the index is out of
+/// range.</exception>
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::CheckIndex(size_t index) const {
+  if (index >= size) {
+    ALGLIB_THROW(std::runtime_error(errors::kIndexOutOfRange));
+  }
+}
+
+/// <summary>
+/// Calculates new capacity by asking the growth policy. Result is never
+/// smaller than the required amount.
+/// </summary>
+/// <param name="required"> amount of elements that has to fit.</param>
+/// <returns> new capacity of the vector.</returns>
+template <typename T, typename Growth>
+size_t MappedVector<T, Growth>::GrownCapacity(size_t required) const {
+  const size_t grown{static_cast<size_t>(growth(capacity, required))};
+  return grown < required ? required : grown;
+}
+
+/// <summary>
+/// Grows the file and maps it again with a given capacity. The new view is
+/// created before the old one is released, so the vector stays intact if
+/// mapping fails. Pointers, references and iterators are invalidated.
+/// </summary>
+/// <param name="new_capacity"> new amount of elements that fit in the
+/// file.</param>
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::Remap(size_t new_capacity) {
+  const size_t bytes{new_capacity * sizeof(T)};
+#ifdef _WIN32
+  HANDLE old_mapping{mapping};
+  mapping = nullptr;
+  T *new_data;
+  ALGLIB_TRY {
+    new_data = MapFile(bytes);
+  } ALGLIB_CATCH_ALL {
+    mapping = old_mapping;
+    ALGLIB_RETHROW;
+  }
+  UnmapFile(data, 0);
+  if (old_mapping) CloseHandle(old_mapping);
+#else
+  SetFileBytes(bytes);
+  T *new_data{MapFile(bytes)};
+  UnmapFile(data, capacity * sizeof(T));
+#endif
+  if (data) stats.Deallocation();
+  stats.Allocation();
+  stats.Reallocation(0);
+  data = new_data;
+  capacity = new_capacity;
+}
+
+#ifdef _WIN32
+
+/// <summary>
+/// Opens the file with access required by the mode.
+/// </summary>
+/// <param name="path"> path to the file.</param>
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::OpenFile(const std::filesystem::path &path) {
+  const DWORD access{read_only ? GENERIC_READ : GENERIC_READ | GENERIC_WRITE};
+  const DWORD disposition{read_only ? OPEN_EXISTING : OPEN_ALWAYS};
+  file = CreateFileW(path.c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                     nullptr, disposition, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) ThrowSystemError();
+}
+
+/// <summary>
+/// Returns size of the open file in bytes.
+/// </summary>
+template <typename T, typename Growth>
+size_t MappedVector<T, Growth>::FileBytes() const {
+  LARGE_INTEGER bytes;
+  if (!GetFileSizeEx(file, &bytes)) ThrowSystemError();
+  return static_cast<size_t>(bytes.QuadPart);
+}
+
+/// <summary>
+/// Changes size of the open file. Mapping must not exist while the file is
+/// truncated.
+/// </summary>
+/// <param name="bytes"> new size of the file.</param>
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::SetFileBytes(size_t bytes) {
+  LARGE_INTEGER position;
+  position.QuadPart = static_cast<LONGLONG>(bytes);
+  if (!SetFilePointerEx(file, position, nullptr, FILE_BEGIN) ||
+      !SetEndOfFile(file)) {
+    ThrowSystemError();
+  }
+}
+
+/// <summary>
+/// Creates a mapping object of a given size and maps a view of it. Creating
+/// the mapping grows the file if it is smaller.
+/// </summary>
+/// <param name="bytes"> size of the view.</param>
+/// <returns> pointer to the view or nullptr for empty views.</returns>
+template <typename T, typename Growth>
+T *MappedVector<T, Growth>::MapFile(size_t bytes) {
+  if (bytes == 0) return nullptr;
+  const ULONGLONG size64{static_cast<ULONGLONG>(bytes)};
+  mapping = CreateFileMappingW(file, nullptr,
+                               read_only ? PAGE_READONLY : PAGE_READWRITE,
+                               static_cast<DWORD>(size64 >> 32),
+                               static_cast<DWORD>(size64), nullptr);
+  if (mapping == nullptr) ThrowSystemError();
+  void *view{MapViewOfFile(mapping,
+                           read_only ? FILE_MAP_READ : FILE_MAP_WRITE, 0, 0,
+                           bytes)};
+  if (view == nullptr) {
+    const DWORD error{GetLastError()};
+    CloseHandle(mapping);
+    mapping = nullptr;
+    ALGLIB_THROW(std::system_error(static_cast<int>(error),
+                                   std::system_category(),
+                                   errors::kMappingFailed));
+  }
+  return static_cast<T *>(view);
+}
+
+/// <summary>
+/// Unmaps a view of the file. The mapping object is released by the caller.
+/// </summary>
+/// <param name="block"> view to be unmapped.</param>
+/// <param name="bytes"> unused on Windows.</param>
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::UnmapFile(T *block, size_t bytes) noexcept {
+  (void)bytes;
+  if (block) UnmapViewOfFile(block);
+}
+
+/// <summary>
+/// Releases the mapping object and closes the file.
+/// </summary>
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::CloseFile() noexcept {
+  if (mapping) CloseHandle(mapping);
+  mapping = nullptr;
+  if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+  file = INVALID_HANDLE_VALUE;
+}
+
+/// <summary>
+/// Throws std::system_error describing the last error of the system.
+/// </summary>
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::ThrowSystemError() {
+  ALGLIB_THROW(std::system_error(static_cast<int>(GetLastError()),
+                                 std::system_category(),
+                                 errors::kMappingFailed));
+}
+
+#else
+
+/// <summary>
+/// Opens the file with access required by the mode.
+/// </summary>
+/// <param name="path"> path to the file.</param>
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::OpenFile(const std::filesystem::path &path) {
+  file = read_only ? ::open(path.c_str(), O_RDONLY | O_CLOEXEC)
+                   : ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (file == -1) ThrowSystemError();
+}
+
+/// <summary>
+/// Returns size of the open file in bytes.
+/// </summary>
+template <typename T, typename Growth>
+size_t MappedVector<T, Growth>::FileBytes() const {
+  struct stat status;
+  if (::fstat(file, &status) != 0) ThrowSystemError();
+  return static_cast<size_t>(status.st_size);
+}
+
+/// <summary>
+/// Changes size of the open file. New bytes are zero and most file systems
+/// don't allocate disk space for them until they are written.
+/// </summary>
+/// <param name="bytes"> new size of the file.</param>
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::SetFileBytes(size_t bytes) {
+  if (::ftruncate(file, static_cast<off_t>(bytes)) != 0) ThrowSystemError();
+}
+
+/// <summary>
+/// Maps a given amount of bytes from the beginning of the file. Mapping is
+/// shared, so changes are visible to other processes mapping the same file.
+/// </summary>
+/// <param name="bytes"> size of the mapping.</param>
+/// <returns> pointer to the mapping or nullptr for empty mappings.</returns>
+template <typename T, typename Growth>
+T *MappedVector<T, Growth>::MapFile(size_t bytes) {
+  if (bytes == 0) return nullptr;
+  const int protection{read_only ? PROT_READ : PROT_READ | PROT_WRITE};
+  void *block{::mmap(nullptr, bytes, protection, MAP_SHARED, file, 0)};
+  if (block == MAP_FAILED) ThrowSystemError();
+  return static_cast<T *>(block);
+}
+
+/// <summary>
+/// Unmaps a mapping created by MapFile.
+/// </summary>
+/// <param name="block"> mapping to be released.</param>
+/// <param name="bytes"> size of the mapping.</param>
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::UnmapFile(T *block, size_t bytes) noexcept {
+  if (block) ::munmap(block, bytes);
+}
+
+/// <summary>
+/// Closes the file descriptor.
+/// </summary>
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::CloseFile() noexcept {
+  if (file != -1) ::close(file);
+  file = -1;
+}
+
+/// <summary>
+/// Throws std::system_error describing the current errno.
+/// </summary>
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::ThrowSystemError() {
+  ALGLIB_THROW(std::system_error(errno, std::generic_category(),
+                                 errors::kMappingFailed));
+}
+
+#endif
+
+/// <summary>
+/// Swaps all members with other vector.
+/// </summary>
+/// <param name="other"> vector to swap with.</param>
+template <typename T, typename Growth>
+void MappedVector<T, Growth>::Swap(MappedVector &other) noexcept {
+  std::swap(size, other.size);
+  std::swap(capacity, other.capacity);
+  std::swap(data, other.data);
+  std::swap(read_only, other.read_only);
+  std::swap(growth, other.growth);
+  std::swap(file, other.file);
+#ifdef _WIN32
+  std::swap(mapping, other.mapping);
+#endif
+}
+
+}  // namespace alglib
+
+#endif  // ALGLIB_INCLUDE_MAPPEDVECTOR_H_
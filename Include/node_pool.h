@@ -0,0 +1,487 @@
+//*****************************************************************************
+// The MIT License (MIT)
+//
+// Copyright � 2024 Piotr Walczak
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the �Software�), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED �AS IS�, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//*****************************************************************************
+
+//*****************************************************************************
+// File: node_pool.h
+//
+// This file contains the implementation of the NodePool class and the
+// PoolAllocator that draws memory from it. NodePool hands out small fixed
+// size blocks carved from large slabs and keeps released blocks in intrusive
+// free lists, so containers that allocate one node at a time reuse memory
+// instead of calling the system allocator. Nodes allocated one after another
+// sit next to each other in a slab. The classes are implemented in the alglib
+// namespace.
+//*****************************************************************************
+
+#ifndef ALGLIB_INCLUDE_NODEPOOL_H_
+#define ALGLIB_INCLUDE_NODEPOOL_H_
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+#include "constants.h"
+
+/// <summary>
+/// Default namespace for the AlgLib library.
+/// </summary>
+namespace alglib {
+
+/// <summary>
+/// Pool of small memory blocks grouped in size classes. Every class has its
+/// own free list and carves new blocks from slabs obtained from the system
+/// allocator. Requests larger than the largest class or with alignment
+/// stricter than std::max_align_t are passed to operator new. Memory of all
+/// slabs is released at once when the pool is destroyed, so the pool has to
+/// outlive every container that uses it.
+///
+/// Pools created by the user are not synchronized and can be used by one
+/// thread at a time. The shared pool returned by Shared can be used from any
+/// thread. Every thread keeps a small cache of blocks for it and only touches
+/// the shared free lists, under a lock, when the cache runs empty or full.
+/// </summary>
+class NodePool {
+ public:
+  /// <summary>
+  /// Size of slabs obtained from the system allocator by default.
+  /// </summary>
+  static constexpr size_t kDefaultSlabBytes{64 * 1024};
+
+  /// <summary>
+  /// Granularity and alignment of block sizes.
+  /// </summary>
+  static constexpr size_t kGranularity{alignof(std::max_align_t)};
+
+  /// <summary>
+  /// Largest block served from the size classes.
+  /// </summary>
+  static constexpr size_t kMaxBlockBytes{256};
+
+  // Constructors and destructor for the NodePool.
+  explicit NodePool(size_t slab_bytes = kDefaultSlabBytes) noexcept;
+  NodePool(const NodePool &) = delete;
+  NodePool &operator=(const NodePool &) = delete;
+  ~NodePool();
+
+  // Methods for obtaining and releasing memory.
+  void *Allocate(size_t bytes, size_t alignment);
+  void Deallocate(void *block, size_t bytes, size_t alignment) noexcept;
+
+  // Methods for inspecting the pool.
+  size_t SlabCount() const noexcept;
+
+  // Method for accessing the pool shared by the library.
+  static NodePool &Shared();
+
+ private:
+  /// <summary>
+  /// Released block, its first bytes store pointer to the next free block.
+  /// </summary>
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+
+  /// <summary>
+  /// Header at the beginning of every slab linking all slabs of the pool.
+  /// </summary>
+  struct alignas(std::max_align_t) Slab {
+    Slab *next;
+  };
+
+  static constexpr size_t kClassCount{kMaxBlockBytes / kGranularity};
+
+  /// <summary>
+  /// Per thread cache of blocks taken from the shared pool.
+  /// </summary>
+  struct ThreadCache {
+    ~ThreadCache();
+
+    FreeBlock *lists[kClassCount]{};
+    size_t counts[kClassCount]{};
+
+    // Set when the cache of the thread is destroyed. Nodes released later,
+    // for example by thread_local containers, go straight to the pool.
+    static inline thread_local bool destroyed{false};
+  };
+
+  // Amount of blocks moved between a thread cache and the shared pool.
+  static constexpr size_t kCacheBatch{32};
+
+  // Constructor for the synchronized shared pool.
+  struct SharedTag {};
+  explicit NodePool(SharedTag) noexcept;
+
+  // Methods working on free lists of the pool itself.
+  static size_t ClassOf(size_t bytes) noexcept;
+  void *AllocateBlock(size_t size_class);
+  void DeallocateBlock(void *block, size_t size_class) noexcept;
+  static ThreadCache *LocalCache();
+
+  /// <summary>
+  /// Heads of free lists for every size class.
+  /// </summary>
+  FreeBlock *free_lists[kClassCount];
+
+  /// <summary>
+  /// Unused part of the current slab of every size class.
+  /// </summary>
+  std::byte *bump[kClassCount];
+  std::byte *bump_end[kClassCount];
+
+  /// <summary>
+  /// List of all slabs owned by the pool.
+  /// </summary>
+  Slab *slabs;
+
+  /// <summary>
+  /// Amount of slabs owned by the pool.
+  /// </summary>
+  size_t slab_count;
+
+  /// <summary>
+  /// Size of slabs obtained from the system allocator.
+  /// </summary>
+  size_t slab_bytes;
+
+  /// <summary>
+  /// Flag telling whether the pool is shared between threads.
+  /// </summary>
+  bool synchronized;
+
+  /// <summary>
+  /// Mutex guarding free lists and slabs of a synchronized pool.
+  /// </summary>
+  mutable std::mutex mutex;
+};
+
+/// <summary>
+/// Allocator that takes memory from a NodePool. Default constructed allocators
+/// use the shared pool. Rebound copies use the same pool, so it can be given to
+/// node based containers.
+/// </summary>
+/// <typeparam name="T"> type of allocated objects.</typeparam>
+template <typename T>
+class PoolAllocator {
+ public:
+  using value_type = T;
+
+  // Constructors for the PoolAllocator.
+  PoolAllocator() noexcept;
+  explicit PoolAllocator(NodePool &pool) noexcept;
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U> &other) noexcept;
+
+  // Methods for obtaining and releasing memory.
+  T *allocate(size_t amount);
+  void deallocate(T *block, size_t amount) noexcept;
+
+  // Method for getting the pool of the allocator.
+  NodePool *Pool() const noexcept;
+
+ private:
+  template <typename U>
+  friend class PoolAllocator;
+
+  /// <summary>
+  /// Pool that provides memory.
+  /// </summary>
+  NodePool *pool;
+};
+
+/// <summary>
+/// Compares two pool allocators. They are equal if they use the same pool, so
+/// memory allocated by one can be released by the other.
+/// </summary>
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T> &lhs,
+                const PoolAllocator<U> &rhs) noexcept {
+  return lhs.Pool() == rhs.Pool();
+}
+
+/// <summary>
+/// Constructor for the NodePool. No memory is allocated until the first block
+/// is requested.
+/// </summary>
+/// <param name="slab_bytes"> size of slabs obtained from the system
+/// allocator. It is increased if a slab couldn't hold the largest
+/// block.</param>
+inline NodePool::NodePool(size_t slab_bytes) noexcept
+    : free_lists{},
+      bump{},
+      bump_end{},
+      slabs(nullptr),
+      slab_count(0),
+      slab_bytes(slab_bytes < sizeof(Slab) + kMaxBlockBytes
+                     ? sizeof(Slab) + kMaxBlockBytes
+                     : slab_bytes),
+      synchronized(false) {}
+
+/// <summary>
+/// Constructor for the shared pool, which uses thread caches and a lock.
+/// </summary>
+inline NodePool::NodePool(SharedTag) noexcept : NodePool() {
+  synchronized = true;
+}
+
+/// <summary>
+/// Destructor for the NodePool. Releases all slabs at once, no matter how many
+/// blocks are still in use.
+/// </summary>
+inline NodePool::~NodePool() {
+  while (slabs) {
+    Slab *next{slabs->next};
+    ::operator delete(static_cast<void *>(slabs), slab_bytes,
+                      std::align_val_t(alignof(Slab)));
+    slabs = next;
+  }
+}
+
+/// <summary>
+/// Obtains a block of memory. Blocks are taken from the free list of the size
+/// class or carved from the current slab of that class.
+/// </summary>
+/// <param name="bytes"> size of the block.</param>
+/// <param name="alignment"> required alignment of the block.</param>
+/// <returns> pointer to the block.</returns>
+inline void *NodePool::Allocate(size_t bytes, size_t alignment) {
+  if (bytes > kMaxBlockBytes || alignment > kGranularity) {
+    return ::operator new(bytes, std::align_val_t(alignment));
+  }
+  const size_t size_class{ClassOf(bytes)};
+  if (!synchronized) return AllocateBlock(size_class);
+
+  ThreadCache *cache{LocalCache()};
+  if (cache == nullptr) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return AllocateBlock(size_class);
+  }
+  if (cache->lists[size_class] == nullptr) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i{}; i < kCacheBatch; ++i) {
+      FreeBlock *block{static_cast<FreeBlock *>(AllocateBlock(size_class))};
+      block->next = cache->lists[size_class];
+      cache->lists[size_class] = block;
+      ++cache->counts[size_class];
+    }
+  }
+  FreeBlock *block{cache->lists[size_class]};
+  cache->lists[size_class] = block->next;
+  --cache->counts[size_class];
+  return block;
+}
+
+/// <summary>
+/// Returns a block to the pool. Size and alignment have to be the same as in
+/// the call to Allocate.
+/// </summary>
+/// <param name="block"> block obtained from Allocate.</param>
+/// <param name="bytes"> size of the block.</param>
+/// <param name="alignment"> alignment of the block.</param>
+inline void NodePool::Deallocate(void *block, size_t bytes,
+                                 size_t alignment) noexcept {
+  if (bytes > kMaxBlockBytes || alignment > kGranularity) {
+    ::operator delete(block, bytes, std::align_val_t(alignment));
+    return;
+  }
+  const size_t size_class{ClassOf(bytes)};
+  if (!synchronized) {
+    DeallocateBlock(block, size_class);
+    return;
+  }
+
+  ThreadCache *cache{LocalCache()};
+  if (cache == nullptr) {
+    std::lock_guard<std::mutex> lock(mutex);
+    DeallocateBlock(block, size_class);
+    return;
+  }
+  FreeBlock *freed{static_cast<FreeBlock *>(block)};
+  freed->next = cache->lists[size_class];
+  cache->lists[size_class] = freed;
+  if (++cache->counts[size_class] > 2 * kCacheBatch) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i{}; i < kCacheBatch; ++i) {
+      FreeBlock *returned{cache->lists[size_class]};
+      cache->lists[size_class] = returned->next;
+      DeallocateBlock(returned, size_class);
+    }
+    cache->counts[size_class] -= kCacheBatch;
+  }
+}
+
+/// <summary>
+/// Method for getting amount of slabs obtained from the system allocator.
+/// It stays constant while released blocks are reused.
+/// </summary>
+/// <returns> amount of slabs.</returns>
+inline size_t NodePool::SlabCount() const noexcept {
+  if (!synchronized) return slab_count;
+  std::lock_guard<std::mutex> lock(mutex);
+  return slab_count;
+}
+
+/// <summary>
+/// Method for getting the pool shared by the whole library. It is created on
+/// first use and intentionally never destroyed, so containers with static
+/// storage duration can still release nodes during program exit.
+/// </summary>
+/// <returns> reference to the shared pool.</returns>
+inline NodePool &NodePool::Shared() {
+  static NodePool *pool{new NodePool(SharedTag{})};
+  return *pool;
+}
+
+/// <summary>
+/// Returns blocks cached by an exiting thread to the shared pool.
+/// </summary>
+inline NodePool::ThreadCache::~ThreadCache() {
+  NodePool &pool{Shared()};
+  std::lock_guard<std::mutex> lock(pool.mutex);
+  for (size_t size_class{}; size_class < kClassCount; ++size_class) {
+    while (lists[size_class]) {
+      FreeBlock *block{lists[size_class]};
+      lists[size_class] = block->next;
+      pool.DeallocateBlock(block, size_class);
+    }
+  }
+  destroyed = true;
+}
+
+/// <summary>
+/// Calculates size class of a block.
+/// </summary>
+/// <param name="bytes"> size of the block, at most kMaxBlockBytes.</param>
+/// <returns> index of the size class.</returns>
+inline size_t NodePool::ClassOf(size_t bytes) noexcept {
+  return bytes == 0 ? 0 : (bytes - 1) / kGranularity;
+}
+
+/// <summary>
+/// Takes a block from the free list of a size class or carves it from the
+/// current slab, obtaining a new slab when needed.
+/// </summary>
+/// <param name="size_class"> index of the size class.</param>
+/// <returns> pointer to the block.</returns>
+inline void *NodePool::AllocateBlock(size_t size_class) {
+  if (free_lists[size_class]) {
+    FreeBlock *block{free_lists[size_class]};
+    free_lists[size_class] = block->next;
+    return block;
+  }
+  const size_t block_bytes{(size_class + 1) * kGranularity};
+  if (static_cast<size_t>(bump_end[size_class] - bump[size_class]) <
+      block_bytes) {
+    Slab *slab{static_cast<Slab *>(
+        ::operator new(slab_bytes, std::align_val_t(alignof(Slab))))};
+    slab->next = slabs;
+    slabs = slab;
+    ++slab_count;
+    bump[size_class] = reinterpret_cast<std::byte *>(slab + 1);
+    bump_end[size_class] = reinterpret_cast<std::byte *>(slab) + slab_bytes;
+  }
+  void *block{bump[size_class]};
+  bump[size_class] += block_bytes;
+  return block;
+}
+
+/// <summary>
+/// Puts a block on the free list of its size class.
+/// </summary>
+/// <param name="block"> block to be released.</param>
+/// <param name="size_class"> index of the size class.</param>
+inline void NodePool::DeallocateBlock(void *block, size_t size_class) noexcept {
+  FreeBlock *freed{static_cast<FreeBlock *>(block)};
+  freed->next = free_lists[size_class];
+  free_lists[size_class] = freed;
+}
+
+/// <summary>
+/// Returns cache of the calling thread for the shared pool.
+/// </summary>
+/// <returns> pointer to the cache or nullptr if the thread is exiting and its
+/// cache was already destroyed.</returns>
+inline NodePool::ThreadCache *NodePool::LocalCache() {
+  if (ThreadCache::destroyed) return nullptr;
+  thread_local ThreadCache cache;
+  return &cache;
+}
+
+/// <summary>
+/// Constructor for the PoolAllocator using the shared pool.
+/// </summary>
+template <typename T>
+PoolAllocator<T>::PoolAllocator() noexcept : pool(&NodePool::Shared()) {}
+
+/// <summary>
+/// Constructor for the PoolAllocator using a given pool.
+/// </summary>
+/// <param name="pool"> pool that provides memory.</param>
+template <typename T>
+PoolAllocator<T>::PoolAllocator(NodePool &pool) noexcept : pool(&pool) {}
+
+/// <summary>
+/// Converting constructor used when the allocator is rebound to another type.
+/// </summary>
+/// <param name="other"> allocator whose pool will be used.</param>
+template <typename T>
+template <typename U>
+PoolAllocator<T>::PoolAllocator(const PoolAllocator<U> &other) noexcept
+    : pool(other.pool) {}
+
+/// <summary>
+/// Allocates memory for a given amount of objects.
+/// </summary>
+/// <param name="amount"> amount of objects.</param>
+/// <returns> pointer to uninitialized memory.</returns>
+template <typename T>
+T *PoolAllocator<T>::allocate(size_t amount) {
+  if (amount > static_cast<size_t>(-1) / sizeof(T)) {
+    ALGLIB_THROW(std::bad_alloc());
+  }
+  return static_cast<T *>(pool->Allocate(amount * sizeof(T), alignof(T)));
+}
+
+/// <summary>
+/// Returns memory to the pool.
+/// </summary>
+/// <param name="block"> memory obtained from allocate.</param>
+/// <param name="amount"> amount of objects passed to allocate.</param>
+template <typename T>
+void PoolAllocator<T>::deallocate(T *block, size_t amount) noexcept {
+  pool->Deallocate(block, amount * sizeof(T), alignof(T));
+}
+
+/// <summary>
+/// Method for getting the pool of the allocator.
+/// </summary>
+/// <returns> pointer to the pool.</returns>
+template <typename T>
+NodePool *PoolAllocator<T>::Pool() const noexcept {
+  return pool;
+}
+
+}  // namespace alglib
+
+#endif  // ALGLIB_INCLUDE_NODEPOOL_H_
@@ -0,0 +1,411 @@
+//*****************************************************************************
+// The MIT License (MIT)
+//
+// Copyright � 2024 Piotr Walczak
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the �Software�), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED �AS IS�, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//*****************************************************************************
+
+//*****************************************************************************
+// File: parallel_algorithms.h
+//
+// This file contains parallel versions of bulk algorithms: sort, transform,
+// reduce, inclusive scan and find. They work on any random access range,
+// including Vector and SmallVector, and on pairs of its iterators. Work is
+// split into chunks of at least grain size elements that run on the default
+// TaskScheduler, so they share its workers with TaskGroup and ParallelFor and
+// can be nested inside scheduler tasks. Ranges shorter than grain size are processed serially on the
+// calling thread, so small inputs don't pay for synchronization.
+//*****************************************************************************
+
+#ifndef ALGLIB_INCLUDE_PARALLELALGORITHMS_H_
+#define ALGLIB_INCLUDE_PARALLELALGORITHMS_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include "task_scheduler.h"
+
+/// <summary>
+/// Default namespace for the AlgLib library.
+/// </summary>
+namespace alglib {
+
+/// <summary>
+/// Default minimal amount of elements processed by one chunk. It is large
+/// enough for the work of a chunk to outweigh the cost of handing it to
+/// another thread for cheap per element operations.
+/// </summary>
+inline constexpr size_t kDefaultGrainSize{1 << 14};
+
+/// <summary>
+/// Namespace for helpers shared by parallel algorithms.
+/// </summary>
+namespace detail {
+
+/// <summary>
+/// Calculates amount of chunks a range is split into. Every chunk has at least
+/// grain size elements and there are at most four chunks per thread, which
+/// leaves room for balancing uneven chunks without flooding the scheduler.
+/// </summary>
+/// <param name="size"> amount of elements in the range.</param>
+/// <param name="grain_size"> minimal amount of elements in a chunk.</param>
+/// <returns> amount of chunks, 1 means that range should be processed
+/// serially.</returns>
+inline size_t ChunkCount(size_t size, size_t grain_size) noexcept {
+  size_t max_chunks{(TaskScheduler::Default().ThreadCount() + 1) * 4};
+  size_t chunks{size / std::max<size_t>(grain_size, 1)};
+  return std::clamp<size_t>(chunks, 1, max_chunks);
+}
+
+/// <summary>
+/// Calculates offset of the first element of a chunk. Chunks differ in size by
+/// at most one element.
+/// </summary>
+/// <param name="chunk"> index of the chunk, chunk_count gives the end of the
+/// range.</param>
+/// <param name="chunk_count"> amount of chunks.</param>
+/// <param name="size"> amount of elements in the range.</param>
+/// <returns> offset of the first element of the chunk.</returns>
+inline size_t ChunkBegin(size_t chunk, size_t chunk_count,
+                         size_t size) noexcept {
+  return size / chunk_count * chunk + size % chunk_count * chunk / chunk_count;
+}
+
+}  // namespace detail
+
+/// <summary>
+/// Sorts a range in parallel. Chunks are sorted independently and then merged
+/// pairwise, with all merges of one round running in parallel. Sort is not
+/// stable.
+/// </summary>
+/// <param name="first"> iterator to the first element.</param>
+/// <param name="last"> iterator past the last element.</param>
+/// <param name="comp"> comparator defining strict weak ordering.</param>
+/// <param name="grain_size"> minimal amount of elements in a chunk.</param>
+template <std::random_access_iterator It, typename Compare = std::less<>>
+void ParallelSort(It first, It last, Compare comp = Compare(),
+                  size_t grain_size = kDefaultGrainSize) {
+  size_t size{static_cast<size_t>(last - first)};
+  size_t chunk_count{detail::ChunkCount(size, grain_size)};
+  if (chunk_count == 1) {
+    std::sort(first, last, comp);
+    return;
+  }
+  auto chunk_begin = [&](size_t chunk) {
+    return first + detail::ChunkBegin(chunk, chunk_count, size);
+  };
+
+  TaskScheduler &scheduler{TaskScheduler::Default()};
+  scheduler.ParallelFor(0, chunk_count, [&](size_t chunk) {
+    std::sort(chunk_begin(chunk), chunk_begin(chunk + 1), comp);
+  });
+  for (size_t width{1}; width < chunk_count; width *= 2) {
+    size_t pair_count{(chunk_count + 2 * width - 1) / (2 * width)};
+    scheduler.ParallelFor(0, pair_count, [&](size_t pair) {
+      size_t left{pair * 2 * width};
+      size_t middle{std::min(left + width, chunk_count)};
+      size_t right{std::min(left + 2 * width, chunk_count)};
+      if (middle < right) {
+        std::inplace_merge(chunk_begin(left), chunk_begin(middle),
+                           chunk_begin(right), comp);
+      }
+    });
+  }
+}
+
+/// <summary>
+/// Sorts a range in parallel. See the iterator version for details.
+/// </summary>
+/// <param name="range"> range to be sorted, for example Vector.</param>
+/// <param name="comp"> comparator defining strict weak ordering.</param>
+/// <param name="grain_size"> minimal amount of elements in a chunk.</param>
+template <std::ranges::random_access_range Range,
+          typename Compare = std::less<>>
+void ParallelSort(Range &&range, Compare comp = Compare(),
+                  size_t grain_size = kDefaultGrainSize) {
+  ParallelSort(std::ranges::begin(range), std::ranges::end(range),
+               std::move(comp), grain_size);
+}
+
+/// <summary>
+/// Applies an operation to every element of a range and stores the results in
+/// the output range. Output may be the same as the input. Operation may be
+/// called in any order and from many threads at once.
+/// </summary>
+/// <param name="first"> iterator to the first element.</param>
+/// <param name="last"> iterator past the last element.</param>
+/// <param name="out"> iterator to the first element of the output.</param>
+/// <param name="op"> operation applied to every element.</param>
+/// <param name="grain_size"> minimal amount of elements in a chunk.</param>
+/// <returns> iterator past the last written element.</returns>
+template <std::random_access_iterator InputIt,
+          std::random_access_iterator OutputIt, typename UnaryOp>
+OutputIt ParallelTransform(InputIt first, InputIt last, OutputIt out,
+                           UnaryOp op, size_t grain_size = kDefaultGrainSize) {
+  size_t size{static_cast<size_t>(last - first)};
+  size_t chunk_count{detail::ChunkCount(size, grain_size)};
+  if (chunk_count == 1) return std::transform(first, last, out, op);
+
+  TaskScheduler::Default().ParallelFor(0, chunk_count, [&](size_t chunk) {
+    size_t begin{detail::ChunkBegin(chunk, chunk_count, size)};
+    size_t end{detail::ChunkBegin(chunk + 1, chunk_count, size)};
+    std::transform(first + begin, first + end, out + begin, op);
+  });
+  return out + size;
+}
+
+/// <summary>
+/// Applies an operation to every element of a range in parallel. See the
+/// iterator version for details.
+/// </summary>
+/// <param name="range"> input range, for example Vector.</param>
+/// <param name="out"> iterator to the first element of the output.</param>
+/// <param name="op"> operation applied to every element.</param>
+/// <param name="grain_size"> minimal amount of elements in a chunk.</param>
+/// <returns> iterator past the last written element.</returns>
+template <std::ranges::random_access_range Range,
+          std::random_access_iterator OutputIt, typename UnaryOp>
+OutputIt ParallelTransform(Range &&range, OutputIt out, UnaryOp op,
+                           size_t grain_size = kDefaultGrainSize) {
+  return ParallelTransform(std::ranges::begin(range), std::ranges::end(range),
+                           out, std::move(op), grain_size);
+}
+
+/// <summary>
+/// Combines all elements of a range with a binary operation in parallel. Every
+/// chunk is reduced separately and partial results are combined in order of
+/// chunks, so the operation has to be associative, but doesn't have to be
+/// commutative.
+/// </summary>
+/// <param name="first"> iterator to the first element.</param>
+/// <param name="last"> iterator past the last element.</param>
+/// <param name="init"> initial value, combined before all elements.</param>
+/// <param name="op"> associative binary operation.</param>
+/// <param name="grain_size"> minimal amount of elements in a chunk.</param>
+/// <returns> result of combining init with all elements.</returns>
+template <std::random_access_iterator It, typename T,
+          typename BinaryOp = std::plus<>>
+T ParallelReduce(It first, It last, T init, BinaryOp op = BinaryOp(),
+                 size_t grain_size = kDefaultGrainSize) {
+  size_t size{static_cast<size_t>(last - first)};
+  size_t chunk_count{detail::ChunkCount(size, grain_size)};
+  if (chunk_count == 1) {
+    return std::accumulate(first, last, std::move(init), op);
+  }
+
+  std::vector<std::optional<T>> partials(chunk_count);
+  TaskScheduler::Default().ParallelFor(0, chunk_count, [&](size_t chunk) {
+    It begin{first + detail::ChunkBegin(chunk, chunk_count, size)};
+    It end{first + detail::ChunkBegin(chunk + 1, chunk_count, size)};
+    T partial(*begin);
+    for (++begin; begin != end; ++begin) {
+      partial = op(std::move(partial), *begin);
+    }
+    partials[chunk].emplace(std::move(partial));
+  });
+  for (std::optional<T> &partial : partials) {
+    init = op(std::move(init), std::move(*partial));
+  }
+  return init;
+}
+
+/// <summary>
+/// Combines all elements of a range with a binary operation in parallel. See
+/// the iterator version for details.
+/// </summary>
+/// <param name="range"> input range, for example Vector.</param>
+/// <param name="init"> initial value, combined before all elements.</param>
+/// <param name="op"> associative binary operation.</param>
+/// <param name="grain_size"> minimal amount of elements in a chunk.</param>
+/// <returns> result of combining init with all elements.</returns>
+template <std::ranges::random_access_range Range, typename T,
+          typename BinaryOp = std::plus<>>
+T ParallelReduce(Range &&range, T init, BinaryOp op = BinaryOp(),
+                 size_t grain_size = kDefaultGrainSize) {
+  return ParallelReduce(std::ranges::begin(range), std::ranges::end(range),
+                        std::move(init), std::move(op), grain_size);
+}
+
+/// <summary>
+/// Calculates inclusive prefix sums of a range in parallel and stores them in
+/// the output range. Output may be the same as the input. First pass scans
+/// every chunk separately, then totals of previous chunks are combined
+/// serially and second pass adds them to the elements of later chunks. The
+/// operation has to be associative.
+/// </summary>
+/// <param name="first"> iterator to the first element.</param>
+/// <param name="last"> iterator past the last element.</param>
+/// <param name="out"> iterator to the first element of the output.</param>
+/// <param name="op"> associative binary operation.</param>
+/// <param name="grain_size"> minimal amount of elements in a chunk.</param>
+/// <returns> iterator past the last written element.</returns>
+template <std::random_access_iterator InputIt,
+          std::random_access_iterator OutputIt,
+          typename BinaryOp = std::plus<>>
+OutputIt ParallelInclusiveScan(InputIt first, InputIt last, OutputIt out,
+                               BinaryOp op = BinaryOp(),
+                               size_t grain_size = kDefaultGrainSize) {
+  using Value = std::iter_value_t<InputIt>;
+
+  size_t size{static_cast<size_t>(last - first)};
+  size_t chunk_count{detail::ChunkCount(size, grain_size)};
+  if (chunk_count == 1) return std::inclusive_scan(first, last, out, op);
+  auto chunk_begin = [&](size_t chunk) {
+    return detail::ChunkBegin(chunk, chunk_count, size);
+  };
+
+  TaskScheduler &scheduler{TaskScheduler::Default()};
+  scheduler.ParallelFor(0, chunk_count, [&](size_t chunk) {
+    std::inclusive_scan(first + chunk_begin(chunk),
+                        first + chunk_begin(chunk + 1),
+                        out + chunk_begin(chunk), op);
+  });
+
+  std::vector<std::optional<Value>> carries(chunk_count);
+  carries[1].emplace(out[chunk_begin(1) - 1]);
+  for (size_t chunk{2}; chunk < chunk_count; ++chunk) {
+    carries[chunk].emplace(
+        op(*carries[chunk - 1], out[chunk_begin(chunk) - 1]));
+  }
+
+  scheduler.ParallelFor(1, chunk_count, [&](size_t chunk) {
+    const Value &carry{*carries[chunk]};
+    for (size_t i{chunk_begin(chunk)}; i < chunk_begin(chunk + 1); ++i) {
+      out[i] = op(carry, out[i]);
+    }
+  });
+  return out + size;
+}
+
+/// <summary>
+/// Calculates inclusive prefix sums of a range in parallel. See the iterator
+/// version for details.
+/// </summary>
+/// <param name="range"> input range, for example Vector.</param>
+/// <param name="out"> iterator to the first element of the output.</param>
+/// <param name="op"> associative binary operation.</param>
+/// <param name="grain_size"> minimal amount of elements in a chunk.</param>
+/// <returns> iterator past the last written element.</returns>
+template <std::ranges::random_access_range Range,
+          std::random_access_iterator OutputIt,
+          typename BinaryOp = std::plus<>>
+OutputIt ParallelInclusiveScan(Range &&range, OutputIt out,
+                               BinaryOp op = BinaryOp(),
+                               size_t grain_size = kDefaultGrainSize) {
+  return ParallelInclusiveScan(std::ranges::begin(range),
+                               std::ranges::end(range), out, std::move(op),
+                               grain_size);
+}
+
+/// <summary>
+/// Finds the first element of a range that satisfies a predicate. Chunks are
+/// searched in parallel and chunks that start after an already found element
+/// are skipped.
+/// </summary>
+/// <param name="first"> iterator to the first element.</param>
+/// <param name="last"> iterator past the last element.</param>
+/// <param name="pred"> predicate checked for elements.</param>
+/// <param name="grain_size"> minimal amount of elements in a chunk.</param>
+/// <returns> iterator to the first matching element or last if there is
+/// none.</returns>
+template <std::random_access_iterator It, typename Predicate>
+It ParallelFindIf(It first, It last, Predicate pred,
+                  size_t grain_size = kDefaultGrainSize) {
+  size_t size{static_cast<size_t>(last - first)};
+  size_t chunk_count{detail::ChunkCount(size, grain_size)};
+  if (chunk_count == 1) return std::find_if(first, last, pred);
+
+  std::atomic<size_t> found{size};
+  TaskScheduler::Default().ParallelFor(0, chunk_count, [&](size_t chunk) {
+    size_t begin{detail::ChunkBegin(chunk, chunk_count, size)};
+    size_t end{detail::ChunkBegin(chunk + 1, chunk_count, size)};
+    if (begin >= found.load(std::memory_order_relaxed)) return;
+    It match{std::find_if(first + begin, first + end, pred)};
+    if (match == first + end) return;
+
+    size_t index{static_cast<size_t>(match - first)};
+    size_t current{found.load(std::memory_order_relaxed)};
+    while (index < current &&
+           !found.compare_exchange_weak(current, index,
+                                        std::memory_order_relaxed)) {
+    }
+  });
+  return first + found.load(std::memory_order_relaxed);
+}
+
+/// <summary>
+/// Finds the first element of a range that satisfies a predicate in parallel.
+/// See the iterator version for details.
+/// </summary>
+/// <param name="range"> range to be searched, for example Vector.</param>
+/// <param name="pred"> predicate checked for elements.</param>
+/// <param name="grain_size"> minimal amount of elements in a chunk.</param>
+/// <returns> iterator to the first matching element or end of the range if
+/// there is none.</returns>
+template <std::ranges::random_access_range Range, typename Predicate>
+std::ranges::iterator_t<Range> ParallelFindIf(
+    Range &&range, Predicate pred, size_t grain_size = kDefaultGrainSize) {
+  return ParallelFindIf(std::ranges::begin(range), std::ranges::end(range),
+                        std::move(pred), grain_size);
+}
+
+/// <summary>
+/// Finds the first element of a range equal to a given value in parallel.
+/// </summary>
+/// <param name="first"> iterator to the first element.</param>
+/// <param name="last"> iterator past the last element.</param>
+/// <param name="value"> value to be found.</param>
+/// <param name="grain_size"> minimal amount of elements in a chunk.</param>
+/// <returns> iterator to the first equal element or last if there is
+/// none.</returns>
+template <std::random_access_iterator It, typename T>
+It ParallelFind(It first, It last, const T &value,
+                size_t grain_size = kDefaultGrainSize) {
+  return ParallelFindIf(
+      first, last, [&value](const auto &element) { return element == value; },
+      grain_size);
+}
+
+/// <summary>
+/// Finds the first element of a range equal to a given value in parallel.
+/// </summary>
+/// <param name="range"> range to be searched, for example Vector.</param>
+/// <param name="value"> value to be found.</param>
+/// <param name="grain_size"> minimal amount of elements in a chunk.</param>
+/// <returns> iterator to the first equal element or end of the range if
+/// there is none.</returns>
+template <std::ranges::random_access_range Range, typename T>
+std::ranges::iterator_t<Range> ParallelFind(
+    Range &&range, const T &value, size_t grain_size = kDefaultGrainSize) {
+  return ParallelFind(std::ranges::begin(range), std::ranges::end(range), value,
+                      grain_size);
+}
+
+}  // namespace alglib
+
+#endif  // ALGLIB_INCLUDE_PARALLELALGORITHMS_H_
@@ -0,0 +1,760 @@
+//*****************************************************************************
+// The MIT License (MIT)
+//
+// Copyright � 2024 Piotr Walczak
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the �Software�), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED �AS IS�, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//*****************************************************************************
+
+//*****************************************************************************
+// File: priority_queue.h
+//
+// This file contains priority queues built on a d-ary heap stored in the
+// alg-lib Vector. PriorityQueue keeps plain values, IndexedPriorityQueue
+// also gives every value a handle that can be used to change or remove it
+// while it's in the queue. Everything is implemented in the alglib
+// namespace.
+//*****************************************************************************
+
+#ifndef ALGLIB_INCLUDE_PRIORITYQUEUE_H_
+#define ALGLIB_INCLUDE_PRIORITYQUEUE_H_
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "constants.h"
+#include "stats.h"
+#include "vector.h"
+
+/// <summary>
+/// Default namespace for the AlgLib library.
+/// </summary>
+namespace alglib {
+
+/// <summary>
+/// Namespace for helpers of containers.
+/// </summary>
+namespace detail {
+
+/// <summary>
+/// Moves a value up from a hole in a d-ary heap until its parent goes before
+/// it. Parents that go after the value are moved down into the hole instead
+/// of being swapped, so every step makes one move.
+/// </summary>
+/// <typeparam name="arity"> number of children of every node.</typeparam>
+/// <param name="data"> elements of the heap.</param>
+/// <param name="hole"> index of the slot whose element was moved out.</param>
+/// <param name="value"> value to be placed.</param>
+/// <param name="before"> returns true when the first value goes closer to
+/// the top than the second one.</param>
+/// <param name="place"> moves a value into a slot of the heap.</param>
+template <size_t arity, typename T, typename Before, typename Place>
+void HeapSiftUp(T *data, size_t hole, T value, Before &before,
+                Place &place) {
+  while (hole > 0) {
+    const size_t parent{(hole - 1) / arity};
+    if (!before(value, data[parent])) break;
+    place(hole, std::move(data[parent]));
+    hole = parent;
+  }
+  place(hole, std::move(value));
+}
+
+/// <summary>
+/// Moves a value down from a hole in a d-ary heap until none of its children
+/// goes before it. The children of a node are adjacent in memory, so picking
+/// the best one reads one or two cache lines.
+/// </summary>
+/// <typeparam name="arity"> number of children of every node.</typeparam>
+/// <param name="data"> elements of the heap.</param>
+/// <param name="size"> number of elements in the heap.</param>
+/// <param name="hole"> index of the slot whose element was moved out.</param>
+/// <param name="value"> value to be placed.</param>
+/// <param name="before"> returns true when the first value goes closer to
+/// the top than the second one.</param>
+/// <param name="place"> moves a value into a slot of the heap.</param>
+template <size_t arity, typename T, typename Before, typename Place>
+void HeapSiftDown(T *data, size_t size, size_t hole, T value, Before &before,
+                  Place &place) {
+  while (true) {
+    const size_t first{hole * arity + 1};
+    if (first >= size) break;
+    size_t best{first};
+    if (size - first >= arity) {
+      // All children exist, so the loop has a constant trip count and the
+      // compiler unrolls it into conditional moves.
+      for (size_t child{first + 1}; child < first + arity; ++child) {
+        best = before(data[child], data[best]) ? child : best;
+      }
+    } else {
+      for (size_t child{first + 1}; child < size; ++child) {
+        best = before(data[child], data[best]) ? child : best;
+      }
+    }
+    if (!before(data[best], value)) break;
+    place(hole, std::move(data[best]));
+    hole = best;
+  }
+  place(hole, std::move(value));
+}
+
+}  // namespace detail
+
+/// <summary>
+/// Priority queue implemented as a d-ary heap in a Vector. With the default
+/// std::less the greatest value is on the top, like in std::priority_queue;
+/// std::greater makes a min-queue. A node has arity children, 4 by default,
+/// which makes the heap half as deep as a binary one and keeps the children
+/// of a node next to each other, so each level of a sift costs about one
+/// cache miss.
+/// </summary>
+/// <typeparam name="T"> type of data stored in the queue.</typeparam>
+/// <typeparam name="Compare"> strict weak ordering, the value that is the
+/// greatest by it is on the top.</typeparam>
+/// <typeparam name="arity"> number of children of every node.</typeparam>
+template <typename T, typename Compare = std::less<T>, size_t arity = 4>
+class PriorityQueue {
+  static_assert(arity >= 2, "Heap node needs at least two children.");
+
+ public:
+  // Constructors for the PriorityQueue.
+  PriorityQueue() = default;
+  explicit PriorityQueue(const Compare &compare);
+  template <std::input_iterator InputIt>
+  PriorityQueue(InputIt first, InputIt last,
+                const Compare &compare = Compare());
+
+  // Methods for manipulating the queue.
+  void Push(const T &value);
+  void Push(T &&value);
+  template <typename... Args>
+  void Emplace(Args &&...args);
+  T Pop();
+  bool TryPop(T &value);
+  const T &Top() const;
+  template <std::input_iterator InputIt>
+  void BuildHeap(InputIt first, InputIt last);
+
+  // Methods for size and memory of the queue.
+  bool IsEmpty() const noexcept;
+  size_t Size() const noexcept;
+  void Reserve(size_t amount);
+  void Clear() noexcept;
+
+  // Getting statistics of the queue.
+  ContainerStats GetStats() const noexcept;
+
+ private:
+  // Methods restoring the heap order.
+  void SiftUp(size_t hole, T value);
+  void SiftDown(size_t hole, T value);
+  void Heapify();
+
+  /// <summary>
+  /// Elements of the heap. The top is the first element and the children of
+  /// the element at index i start at index i * arity + 1.
+  /// </summary>
+  Vector<T> heap;
+
+  /// <summary>
+  /// Ordering of the values.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS Compare compare;
+};
+
+/// <summary>
+/// Constructor for the PriorityQueue with a given ordering.
+/// </summary>
+/// <param name="compare"> ordering of the values.</param>
+template <typename T, typename Compare, size_t arity>
+PriorityQueue<T, Compare, arity>::PriorityQueue(const Compare &compare)
+    : compare(compare) {}
+
+/// <summary>
+/// Constructor for the PriorityQueue holding the values of a range. The heap
+/// is built in O(n) time, like in the BuildHeap method.
+/// </summary>
+/// <param name="first"> iterator to the first value.</param>
+/// <param name="last"> iterator past the last value.</param>
+/// <param name="compare"> ordering of the values.</param>
+template <typename T, typename Compare, size_t arity>
+template <std::input_iterator InputIt>
+PriorityQueue<T, Compare, arity>::PriorityQueue(InputIt first, InputIt last,
+                                                const Compare &compare)
+    : compare(compare) {
+  BuildHeap(first, last);
+}
+
+/// <summary>
+/// Inserts a copy of the value into the queue in O(log n) time.
+/// </summary>
+/// <param name="value"> value to be inserted.</param>
+template <typename T, typename Compare, size_t arity>
+void PriorityQueue<T, Compare, arity>::Push(const T &value) {
+  Emplace(value);
+}
+
+/// <summary>
+/// Moves the value into the queue in O(log n) time.
+/// </summary>
+/// <param name="value"> value to be inserted.</param>
+template <typename T, typename Compare, size_t arity>
+void PriorityQueue<T, Compare, arity>::Push(T &&value) {
+  Emplace(std::move(value));
+}
+
+/// <summary>
+/// Constructs a new value from given arguments and inserts it into the
+/// queue in O(log n) time.
+/// </summary>
+/// <param name="args"> arguments passed to the constructor of T.</param>
+template <typename T, typename Compare, size_t arity>
+template <typename... Args>
+void PriorityQueue<T, Compare, arity>::Emplace(Args &&...args) {
+  T &slot{heap.Emplace(std::forward<Args>(args)...)};
+  SiftUp(heap.Size() - 1, std::move(slot));
+}
+
+/// <summary>
+/// Removes the value from the top of the queue and returns it. The last
+/// value of the heap takes its place and is moved down.
+/// </summary>
+/// <returns> value that was on the top of the queue.</returns>
+/// <exception cref="std::runtime_error"> thrown when the queue is
+/// empty.</exception>
+template <typename T, typename Compare, size_t arity>
+T PriorityQueue<T, Compare, arity>::Pop() {
+  if (heap.Size() == 0) {
+    ALGLIB_THROW(std::runtime_error(errors::kEmptyDeletion));
+  }
+  T result(std::move(heap.Front()));
+  T last(heap.Pop());
+  if (heap.Size() != 0) SiftDown(0, std::move(last));
+  return result;
+}
+
+/// <summary>
+/// Moves the value from the top of the queue into a given object unless the
+/// queue is empty.
+/// </summary>
+/// <param name="value"> object the top value is moved into.</param>
+/// <returns> true if a value was popped, false if the queue is
+/// empty.</returns>
+template <typename T, typename Compare, size_t arity>
+bool PriorityQueue<T, Compare, arity>::TryPop(T &value) {
+  if (heap.Size() == 0) return false;
+  value = std::move(heap.Front());
+  T last(heap.Pop());
+  if (heap.Size() != 0) SiftDown(0, std::move(last));
+  return true;
+}
+
+/// <summary>
+/// Returns the value on the top of the queue without removing it.
+/// </summary>
+/// <returns> reference to the top value.</returns>
+/// <exception cref="std::runtime_error"> thrown when the queue is
+/// empty.</exception>
+template <typename T, typename Compare, size_t arity>
+const T &PriorityQueue<T, Compare, arity>::Top() const {
+  if (heap.Size() == 0) {
+    ALGLIB_THROW(std::runtime_error(errors::kPeekAtEmpty));
+  }
+  return heap.Front();
+}
+
+/// <summary>
+/// Replaces the contents of the queue with the values of a range. The values
+/// are appended in one go and ordered bottom-up, which takes O(n) time
+/// instead of O(n log n) for pushing them one by one.
+/// </summary>
+/// <param name="first"> iterator to the first value.</param>
+/// <param name="last"> iterator past the last value.</param>
+template <typename T, typename Compare, size_t arity>
+template <std::input_iterator InputIt>
+void PriorityQueue<T, Compare, arity>::BuildHeap(InputIt first,
+                                                 InputIt last) {
+  heap.Clear();
+  heap.Append(first, last);
+  Heapify();
+}
+
+/// <summary>
+/// Checks if the queue is empty.
+/// </summary>
+/// <returns> true if empty, false if not.</returns>
+template <typename T, typename Compare, size_t arity>
+bool PriorityQueue<T, Compare, arity>::IsEmpty() const noexcept {
+  return heap.Size() == 0;
+}
+
+/// <summary>
+/// Gets the number of values in the queue.
+/// </summary>
+/// <returns> number of values in the queue.</returns>
+template <typename T, typename Compare, size_t arity>
+size_t PriorityQueue<T, Compare, arity>::Size() const noexcept {
+  return heap.Size();
+}
+
+/// <summary>
+/// Gets statistics of the queue, which are the statistics of the vector
+/// holding the heap. Without ALGLIB_ENABLE_STATS all counters are zero.
+/// </summary>
+/// <returns> statistics of the queue.</returns>
+template <typename T, typename Compare, size_t arity>
+ContainerStats PriorityQueue<T, Compare, arity>::GetStats() const noexcept {
+  return heap.GetStats();
+}
+
+/// <summary>
+/// Reserves memory for a given number of values, so pushing them doesn't
+/// reallocate the heap.
+/// </summary>
+/// <param name="amount"> number of values.</param>
+template <typename T, typename Compare, size_t arity>
+void PriorityQueue<T, Compare, arity>::Reserve(size_t amount) {
+  heap.Reserve(amount);
+}
+
+/// <summary>
+/// Removes all values from the queue. The memory is kept.
+/// </summary>
+template <typename T, typename Compare, size_t arity>
+void PriorityQueue<T, Compare, arity>::Clear() noexcept {
+  heap.Clear();
+}
+
+/// <summary>
+/// Moves a value up from a hole in the heap.
+/// </summary>
+/// <param name="hole"> index of the slot whose element was moved out.</param>
+/// <param name="value"> value to be placed.</param>
+template <typename T, typename Compare, size_t arity>
+void PriorityQueue<T, Compare, arity>::SiftUp(size_t hole, T value) {
+  T *data{heap.Data()};
+  auto before{[this](const T &left, const T &right) {
+    return compare(right, left);
+  }};
+  auto place{[data](size_t index, T &&moved) {
+    data[index] = std::move(moved);
+  }};
+  detail::HeapSiftUp<arity>(data, hole, std::move(value), before, place);
+}
+
+/// <summary>
+/// Moves a value down from a hole in the heap.
+/// </summary>
+/// <param name="hole"> index of the slot whose element was moved out.</param>
+/// <param name="value"> value to be placed.</param>
+template <typename T, typename Compare, size_t arity>
+void PriorityQueue<T, Compare, arity>::SiftDown(size_t hole, T value) {
+  T *data{heap.Data()};
+  auto before{[this](const T &left, const T &right) {
+    return compare(right, left);
+  }};
+  auto place{[data](size_t index, T &&moved) {
+    data[index] = std::move(moved);
+  }};
+  detail::HeapSiftDown<arity>(data, heap.Size(), hole, std::move(value),
+                              before, place);
+}
+
+/// <summary>
+/// Orders all elements into a heap, moving down every node that has
+/// children, starting from the last one.
+/// </summary>
+template <typename T, typename Compare, size_t arity>
+void PriorityQueue<T, Compare, arity>::Heapify() {
+  const size_t size{heap.Size()};
+  if (size < 2) return;
+  for (size_t node{(size - 2) / arity + 1}; node-- > 0;) {
+    SiftDown(node, std::move(heap.Data()[node]));
+  }
+}
+
+/// <summary>
+/// Priority queue that gives every inserted value a handle. The handle stays
+/// valid while the value is in the queue, and can be used to read, change or
+/// erase the value in O(log n) time, which schedulers need to reschedule or
+/// cancel timers. The heap holds values with their handles, and a separate
+/// table maps handles to positions in the heap. Handles of removed values
+/// are reused.
+/// </summary>
+/// <typeparam name="T"> type of data stored in the queue.</typeparam>
+/// <typeparam name="Compare"> strict weak ordering, the value that is the
+/// greatest by it is on the top.</typeparam>
+/// <typeparam name="arity"> number of children of every node.</typeparam>
+template <typename T, typename Compare = std::less<T>, size_t arity = 4>
+class IndexedPriorityQueue {
+  static_assert(arity >= 2, "Heap node needs at least two children.");
+
+ public:
+  /// <summary>
+  /// Handle identifying a value in the queue.
+  /// </summary>
+  using Handle = size_t;
+
+  // Constructors for the IndexedPriorityQueue.
+  IndexedPriorityQueue() = default;
+  explicit IndexedPriorityQueue(const Compare &compare);
+
+  // Methods for manipulating the queue.
+  Handle Push(T value);
+  T Pop();
+  const T &Top() const;
+  Handle TopHandle() const;
+
+  // Methods for accessing values by their handles.
+  bool Contains(Handle handle) const noexcept;
+  const T &Get(Handle handle) const;
+  void DecreaseKey(Handle handle, T value);
+  void Update(Handle handle, T value);
+  T Erase(Handle handle);
+
+  // Methods for size of the queue.
+  bool IsEmpty() const noexcept;
+  size_t Size() const noexcept;
+  void Clear() noexcept;
+
+  // Getting statistics of the queue.
+  ContainerStats GetStats() const noexcept;
+
+ private:
+  /// <summary>
+  /// Value in the heap together with its handle.
+  /// </summary>
+  struct Entry {
+    T value;
+    Handle handle;
+  };
+
+  /// <summary>
+  /// Position of handles that are not in the queue.
+  /// </summary>
+  static constexpr size_t kFree{std::numeric_limits<size_t>::max()};
+
+  // Methods restoring the heap order.
+  void SiftUp(size_t hole, Entry entry);
+  void SiftDown(size_t hole, Entry entry);
+
+  // Methods for handling entries.
+  size_t Position(Handle handle) const;
+  T Remove(size_t position);
+
+  /// <summary>
+  /// Entries of the heap, ordered like in PriorityQueue.
+  /// </summary>
+  Vector<Entry> heap;
+  /// <summary>
+  /// Position in the heap of every handle, kFree for unused handles.
+  /// </summary>
+  Vector<size_t> positions;
+  /// <summary>
+  /// Unused handles that are given out before new ones.
+  /// </summary>
+  Vector<Handle> free_handles;
+
+  /// <summary>
+  /// Ordering of the values.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS Compare compare;
+};
+
+/// <summary>
+/// Constructor for the IndexedPriorityQueue with a given ordering.
+/// </summary>
+/// <param name="compare"> ordering of the values.</param>
+template <typename T, typename Compare, size_t arity>
+IndexedPriorityQueue<T, Compare, arity>::IndexedPriorityQueue(
+    const Compare &compare)
+    : compare(compare) {}
+
+/// <summary>
+/// Inserts a value into the queue in O(log n) time.
+/// </summary>
+/// <param name="value"> value to be inserted.</param>
+/// <returns> handle of the inserted value.</returns>
+template <typename T, typename Compare, size_t arity>
+typename IndexedPriorityQueue<T, Compare, arity>::Handle
+IndexedPriorityQueue<T, Compare, arity>::Push(T value) {
+  const bool reused{free_handles.Size() != 0};
+  const Handle handle{reused ? free_handles.Back() : positions.Size()};
+  if (!reused) positions.Push(kFree);
+  Entry &slot{heap.Emplace(Entry{std::move(value), handle})};
+  if (reused) free_handles.Pop();
+  SiftUp(heap.Size() - 1, std::move(slot));
+  return handle;
+}
+
+/// <summary>
+/// Removes the value from the top of the queue and returns it. Its handle
+/// becomes invalid.
+/// </summary>
+/// <returns> value that was on the top of the queue.</returns>
+/// <exception cref="std::runtime_error"> thrown when the queue is
+/// empty.</exception>
+template <typename T, typename Compare, size_t arity>
+T IndexedPriorityQueue<T, Compare, arity>::Pop() {
+  if (heap.Size() == 0) {
+    ALGLIB_THROW(std::runtime_error(errors::kEmptyDeletion));
+  }
+  return Remove(0);
+}
+
+/// <summary>
+/// Returns the value on the top of the queue without removing it.
+/// </summary>
+/// <returns> reference to the top value.</returns>
+/// <exception cref="std::runtime_error"> thrown when the queue is
+/// empty.</exception>
+template <typename T, typename Compare, size_t arity>
+const T &IndexedPriorityQueue<T, Compare, arity>::Top() const {
+  if (heap.Size() == 0) {
+    ALGLIB_THROW(std::runtime_error(errors::kPeekAtEmpty));
+  }
+  return heap.Front().value;
+}
+
+/// <summary>
+/// Returns the handle of the value on the top of the queue.
+/// </summary>
+/// <returns> handle of the top value.</returns>
+/// <exception cref="std::runtime_error"> thrown when the queue is
+/// empty.</exception>
+template <typename T, typename Compare, size_t arity>
+typename IndexedPriorityQueue<T, Compare, arity>::Handle
+IndexedPriorityQueue<T, Compare, arity>::TopHandle() const {
+  if (heap.Size() == 0) {
+    ALGLIB_THROW(std::runtime_error(errors::kPeekAtEmpty));
+  }
+  return heap.Front().handle;
+}
+
+/// <summary>
+/// Checks if a handle refers to a value in the queue.
+/// </summary>
+/// <param name="handle"> handle to be checked.</param>
+/// <returns> true if the value is in the queue, false if not.</returns>
+template <typename T, typename Compare, size_t arity>
+bool IndexedPriorityQueue<T, Compare, arity>::Contains(
+    Handle handle) const noexcept {
+  return handle < positions.Size() && positions.Data()[handle] != kFree;
+}
+
+/// <summary>
+/// Returns the value with a given handle.
+/// </summary>
+/// <param name="handle"> handle of the value.</param>
+/// <returns> reference to the value.</returns>
+/// <exception cref="std::runtime_error"> thrown when the handle is not in
+/// the queue.</exception>
+template <typename T, typename Compare, size_t arity>
+const T &IndexedPriorityQueue<T, Compare, arity>::Get(Handle handle) const {
+  return heap.Data()[Position(handle)].value;
+}
+
+/// <summary>
+/// Replaces the value with a given handle by one that goes closer to the
+/// top, a smaller key for a min-queue made with std::greater. Only moving
+/// the value up is checked, so it is cheaper than Update. A value that goes
+/// further from the top breaks the heap order.
+/// </summary>
+/// <param name="handle"> handle of the value.</param>
+/// <param name="value"> new value, not going after the current one.</param>
+/// <exception cref="std::runtime_error"> thrown when the handle is not in
+/// the queue.</exception>
+template <typename T, typename Compare, size_t arity>
+void IndexedPriorityQueue<T, Compare, arity>::DecreaseKey(Handle handle,
+                                                          T value) {
+  SiftUp(Position(handle), Entry{std::move(value), handle});
+}
+
+/// <summary>
+/// Replaces the value with a given handle by any value, moving it up or
+/// down the heap as needed.
+/// </summary>
+/// <param name="handle"> handle of the value.</param>
+/// <param name="value"> new value.</param>
+/// <exception cref="std::runtime_error"> thrown when the handle is not in
+/// the queue.</exception>
+template <typename T, typename Compare, size_t arity>
+void IndexedPriorityQueue<T, Compare, arity>::Update(Handle handle,
+                                                     T value) {
+  const size_t position{Position(handle)};
+  if (compare(heap.Data()[position].value, value)) {
+    SiftUp(position, Entry{std::move(value), handle});
+  } else {
+    SiftDown(position, Entry{std::move(value), handle});
+  }
+}
+
+/// <summary>
+/// Removes the value with a given handle from the queue in O(log n) time.
+/// The handle becomes invalid.
+/// </summary>
+/// <param name="handle"> handle of the value.</param>
+/// <returns> removed value.</returns>
+/// <exception cref="std::runtime_error"> thrown when the handle is not in
+/// the queue.</exception>
+template <typename T, typename Compare, size_t arity>
+T IndexedPriorityQueue<T, Compare, arity>::Erase(Handle handle) {
+  return Remove(Position(handle));
+}
+
+/// <summary>
+/// Checks if the queue is empty.
+/// </summary>
+/// <returns> true if empty, false if not.</returns>
+template <typename T, typename Compare, size_t arity>
+bool IndexedPriorityQueue<T, Compare, arity>::IsEmpty() const noexcept {
+  return heap.Size() == 0;
+}
+
+/// <summary>
+/// Gets the number of values in the queue.
+/// </summary>
+/// <returns> number of values in the queue.</returns>
+template <typename T, typename Compare, size_t arity>
+size_t IndexedPriorityQueue<T, Compare, arity>::Size() const noexcept {
+  return heap.Size();
+}
+
+/// <summary>
+/// Gets statistics of the queue. Memory counters are summed over the heap
+/// and the handle tables, the biggest size is the one of the heap. Without
+/// ALGLIB_ENABLE_STATS all counters are zero.
+/// </summary>
+/// <returns> statistics of the queue.</returns>
+template <typename T, typename Compare, size_t arity>
+ContainerStats IndexedPriorityQueue<T, Compare, arity>::GetStats()
+    const noexcept {
+  ContainerStats total{heap.GetStats()};
+  for (const ContainerStats &table :
+       {positions.GetStats(), free_handles.GetStats()}) {
+    total.allocations += table.allocations;
+    total.deallocations += table.deallocations;
+    total.reallocations += table.reallocations;
+    total.bytes_moved += table.bytes_moved;
+  }
+  return total;
+}
+
+/// <summary>
+/// Removes all values from the queue. All handles become invalid and are
+/// given out again from zero.
+/// </summary>
+template <typename T, typename Compare, size_t arity>
+void IndexedPriorityQueue<T, Compare, arity>::Clear() noexcept {
+  heap.Clear();
+  positions.Clear();
+  free_handles.Clear();
+}
+
+/// <summary>
+/// Moves an entry up from a hole in the heap, updating positions of all
+/// moved entries.
+/// </summary>
+/// <param name="hole"> index of the slot whose entry was moved out.</param>
+/// <param name="entry"> entry to be placed.</param>
+template <typename T, typename Compare, size_t arity>
+void IndexedPriorityQueue<T, Compare, arity>::SiftUp(size_t hole,
+                                                     Entry entry) {
+  Entry *data{heap.Data()};
+  size_t *table{positions.Data()};
+  auto before{[this](const Entry &left, const Entry &right) {
+    return compare(right.value, left.value);
+  }};
+  auto place{[data, table](size_t index, Entry &&moved) {
+    table[moved.handle] = index;
+    data[index] = std::move(moved);
+  }};
+  detail::HeapSiftUp<arity>(data, hole, std::move(entry), before, place);
+}
+
+/// <summary>
+/// Moves an entry down from a hole in the heap, updating positions of all
+/// moved entries.
+/// </summary>
+/// <param name="hole"> index of the slot whose entry was moved out.</param>
+/// <param name="entry"> entry to be placed.</param>
+template <typename T, typename Compare, size_t arity>
+void IndexedPriorityQueue<T, Compare, arity>::SiftDown(size_t hole,
+                                                       Entry entry) {
+  Entry *data{heap.Data()};
+  size_t *table{positions.Data()};
+  auto before{[this](const Entry &left, const Entry &right) {
+    return compare(right.value, left.value);
+  }};
+  auto place{[data, table](size_t index, Entry &&moved) {
+    table[moved.handle] = index;
+    data[index] = std::move(moved);
+  }};
+  detail::HeapSiftDown<arity>(data, heap.Size(), hole, std::move(entry),
+                              before, place);
+}
+
+/// <summary>
+/// Finds the position of a handle in the heap.
+/// </summary>
+/// <param name="handle"> handle of the value.</param>
+/// <returns> index of the entry in the heap.</returns>
+/// <exception cref="std::runtime_error"> thrown when the handle is not in
+/// the queue.</exception>
+template <typename T, typename Compare, size_t arity>
+size_t IndexedPriorityQueue<T, Compare, arity>::Position(
+    Handle handle) const {
+  if (!Contains(handle)) {
+    ALGLIB_THROW(std::runtime_error(errors::kItemNotFound));
+  }
+  return positions.Data()[handle];
+}
+
+/// <summary>
+/// Removes the entry at a given position. The last entry of the heap takes
+/// its place and is moved up or down to restore the order.
+/// </summary>
+/// <param name="position"> index of the entry in the heap.</param>
+/// <returns> removed value.</returns>
+template <typename T, typename Compare, size_t arity>
+T IndexedPriorityQueue<T, Compare, arity>::Remove(size_t position) {
+  Entry *data{heap.Data()};
+  const Handle handle{data[position].handle};
+  free_handles.Push(handle);
+  positions.Data()[handle] = kFree;
+  T result(std::move(data[position].value));
+  Entry last(heap.Pop());
+  if (position == heap.Size()) return result;
+  if (position > 0 &&
+      compare(data[(position - 1) / arity].value, last.value)) {
+    SiftUp(position, std::move(last));
+  } else {
+    SiftDown(position, std::move(last));
+  }
+  return result;
+}
+
+}  // namespace alglib
+
+#endif  // ALGLIB_INCLUDE_PRIORITYQUEUE_H_
@@ -0,0 +1,471 @@
+//*****************************************************************************
+// The MIT License (MIT)
+//
+// Copyright � 2024 Piotr Walczak
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the �Software�), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED �AS IS�, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//*****************************************************************************
+
+//*****************************************************************************
+// File: ranges.h
+//
+// This file contains lazy views over the containers of the library and sinks
+// that stream a range into a container. Filter, Transform and Take wrap a
+// range without copying it and compute elements only when they are reached,
+// so pipelines like list | Filter(f) | Transform(g) | Take(n) allocate
+// nothing. Filter and Transform are the standard filter and transform views,
+// Take is separate because it stops without advancing the base range past
+// the last taken element. Drain turns a queue or a stack into a range that
+// takes elements out of it as it is iterated. CopyTo and AppendTo write the elements of a
+// range to an output iterator or to the end of a Vector. The views are
+// implemented in the alglib namespace.
+//*****************************************************************************
+
+#ifndef ALGLIB_INCLUDE_RANGES_H_
+#define ALGLIB_INCLUDE_RANGES_H_
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "vector.h"
+
+/// <summary>
+/// Default namespace for the AlgLib library.
+/// </summary>
+namespace alglib {
+
+/// <summary>
+/// Namespace for helpers of containers.
+/// </summary>
+namespace detail {
+
+/// <summary>
+/// Base of the objects returned by Take. A range piped into an object derived
+/// from it is passed to its call operator.
+/// </summary>
+struct RangeAdaptorClosure {};
+
+/// <summary>
+/// Pipes a range into a range adaptor, so views can be chained from left to
+/// right.
+/// </summary>
+/// <param name="range"> range passed to the adaptor.</param>
+/// <param name="closure"> adaptor making a view of the range.</param>
+/// <returns> view made by the adaptor.</returns>
+template <std::ranges::viewable_range Range, typename Closure>
+  requires std::derived_from<std::remove_cvref_t<Closure>,
+                             RangeAdaptorClosure> &&
+           std::invocable<Closure, Range>
+auto operator|(Range &&range, Closure &&closure) {
+  return std::invoke(std::forward<Closure>(closure),
+                     std::forward<Range>(range));
+}
+
+/// <summary>
+/// Gets the type of the element taken by a method of form bool(T&).
+/// </summary>
+template <typename Method>
+struct TakenValue {};
+template <typename Container, typename T>
+struct TakenValue<bool (Container::*)(T &)> {
+  using type = T;
+};
+template <typename Container, typename T>
+struct TakenValue<bool (Container::*)(T &) noexcept> {
+  using type = T;
+};
+
+/// <summary>
+/// Describes how Drain takes the next element out of a container. Queues
+/// give it through TryDequeue, stacks and priority queues through TryPop.
+/// </summary>
+template <typename Container>
+struct DrainTraits {};
+template <typename Container>
+  requires requires { typename TakenValue<
+      decltype(&Container::TryDequeue)>::type; }
+struct DrainTraits<Container> {
+  using Value = typename TakenValue<decltype(&Container::TryDequeue)>::type;
+  static bool Take(Container &container, Value &value) {
+    return container.TryDequeue(value);
+  }
+};
+template <typename Container>
+  requires(!requires { &Container::TryDequeue; }) && requires {
+    typename TakenValue<decltype(&Container::TryPop)>::type;
+  }
+struct DrainTraits<Container> {
+  using Value = typename TakenValue<decltype(&Container::TryPop)>::type;
+  static bool Take(Container &container, Value &value) {
+    return container.TryPop(value);
+  }
+};
+
+}  // namespace detail
+
+/// <summary>
+/// Container whose elements can be taken out one by one with a
+/// non-throwing TryDequeue or TryPop method.
+/// </summary>
+template <typename Container>
+concept Drainable =
+    requires { typename detail::DrainTraits<Container>::Value; } &&
+    std::default_initializable<typename detail::DrainTraits<Container>::Value>;
+
+/// <summary>
+/// Input view that takes the elements out of a queue or a stack while it is
+/// iterated, in the order the container gives them. The element an iterator
+/// points to is held by the view, and the next one is taken only when the
+/// iterator is incremented, so stopping early leaves all unreached elements
+/// in the container. The view can be iterated once.
+/// </summary>
+/// <typeparam name="Container"> type of the drained container.</typeparam>
+template <Drainable Container>
+class DrainView : public std::ranges::view_interface<DrainView<Container>> {
+  using Traits = detail::DrainTraits<Container>;
+
+ public:
+  using Value = typename Traits::Value;
+
+  /// <summary>
+  /// Iterator that takes the next element when it is incremented.
+  /// </summary>
+  class Iterator {
+   public:
+    using iterator_concept = std::input_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+
+    Iterator() noexcept = default;
+    explicit Iterator(DrainView *view) noexcept : view(view) {}
+
+    Value &operator*() const noexcept { return *view->current; }
+    Iterator &operator++() {
+      view->Next();
+      return *this;
+    }
+    void operator++(int) { view->Next(); }
+    bool operator==(std::default_sentinel_t) const noexcept {
+      return !view->current.has_value();
+    }
+
+   private:
+    /// <summary>
+    /// View holding the current element.
+    /// </summary>
+    DrainView *view{nullptr};
+  };
+
+  DrainView() noexcept = default;
+  explicit DrainView(Container &container) noexcept
+      : container(std::addressof(container)) {}
+
+  Iterator begin();
+  std::default_sentinel_t end() const noexcept;
+
+ private:
+  void Next();
+
+  /// <summary>
+  /// Container the elements are taken from.
+  /// </summary>
+  Container *container{nullptr};
+  /// <summary>
+  /// Element the iterator points to, empty when the container ran out.
+  /// </summary>
+  std::optional<Value> current;
+};
+
+/// <summary>
+/// View of the elements of a base range that satisfy a predicate, made by
+/// Filter. The first matching element of a forward range is found once and
+/// remembered, and copied or moved views don't reuse it.
+/// </summary>
+template <std::ranges::input_range Base, typename Predicate>
+using FilterView = std::ranges::filter_view<Base, Predicate>;
+
+/// <summary>
+/// View that applies a function to every element of a base range when the
+/// element is reached, made by Transform.
+/// </summary>
+template <std::ranges::input_range Base, typename Function>
+using TransformView = std::ranges::transform_view<Base, Function>;
+
+/// <summary>
+/// View of at most a given number of leading elements of a base range.
+/// Reaching the last taken element doesn't advance the base range past it,
+/// so taking from a DrainView leaves the rest of the container untouched.
+/// </summary>
+/// <typeparam name="Base"> view that is shortened.</typeparam>
+template <std::ranges::input_range Base>
+  requires std::ranges::view<Base>
+class TakeView : public std::ranges::view_interface<TakeView<Base>> {
+  using BaseIterator = std::ranges::iterator_t<Base>;
+  using BaseSentinel = std::ranges::sentinel_t<Base>;
+
+ public:
+  /// <summary>
+  /// Sentinel that ends the view at the end of the base range.
+  /// </summary>
+  struct Sentinel {
+    /// <summary>
+    /// End of the base range.
+    /// </summary>
+    BaseSentinel end{};
+  };
+
+  /// <summary>
+  /// Iterator counting the elements that are left to take.
+  /// </summary>
+  class Iterator {
+   public:
+    using iterator_concept =
+        std::conditional_t<std::ranges::forward_range<Base>,
+                           std::forward_iterator_tag, std::input_iterator_tag>;
+    using iterator_category = iterator_concept;
+    using value_type = std::ranges::range_value_t<Base>;
+    using difference_type = std::ranges::range_difference_t<Base>;
+
+    Iterator() = default;
+    Iterator(BaseIterator current, size_t remaining)
+        : current(std::move(current)), remaining(remaining) {}
+
+    std::ranges::range_reference_t<Base> operator*() const {
+      return *current;
+    }
+    Iterator &operator++() {
+      if (--remaining != 0) ++current;
+      return *this;
+    }
+    auto operator++(int) {
+      if constexpr (std::ranges::forward_range<Base>) {
+        Iterator tmp{*this};
+        ++*this;
+        return tmp;
+      } else {
+        ++*this;
+      }
+    }
+    bool operator==(const Iterator &other) const noexcept {
+      return remaining == other.remaining;
+    }
+    bool operator==(const Sentinel &sentinel) const {
+      return remaining == 0 || current == sentinel.end;
+    }
+
+   private:
+    /// <summary>
+    /// Position in the base range.
+    /// </summary>
+    BaseIterator current{};
+    /// <summary>
+    /// Number of elements that are left to take, including the current one.
+    /// </summary>
+    size_t remaining{};
+  };
+
+  TakeView() = default;
+  TakeView(Base base, size_t count) : base(std::move(base)), count(count) {}
+
+  Iterator begin();
+  Sentinel end();
+  size_t size()
+    requires std::ranges::sized_range<Base>
+  {
+    const auto base_size{static_cast<size_t>(std::ranges::size(base))};
+    return base_size < count ? base_size : count;
+  }
+
+ private:
+  /// <summary>
+  /// Range that is shortened.
+  /// </summary>
+  Base base{};
+  /// <summary>
+  /// Maximal number of elements of the view.
+  /// </summary>
+  size_t count{};
+};
+
+template <typename Range>
+TakeView(Range &&, size_t) -> TakeView<std::views::all_t<Range>>;
+
+/// <summary>
+/// Namespace for helpers of containers.
+/// </summary>
+namespace detail {
+
+/// <summary>
+/// Adaptor returned by Take.
+/// </summary>
+struct TakeClosure : RangeAdaptorClosure {
+  template <std::ranges::viewable_range Range>
+  auto operator()(Range &&range) const {
+    return TakeView(std::forward<Range>(range), count);
+  }
+
+  /// <summary>
+  /// Number of elements taken by every view made by the adaptor.
+  /// </summary>
+  size_t count;
+};
+
+}  // namespace detail
+
+/// <summary>
+/// Makes a view that takes the elements out of a queue or a stack.
+/// </summary>
+/// <param name="container"> container that is drained.</param>
+/// <returns> consuming view of the container.</returns>
+template <Drainable Container>
+DrainView<Container> Drain(Container &container) noexcept {
+  return DrainView<Container>(container);
+}
+
+/// <summary>
+/// Makes an adaptor that filters a range piped into it.
+/// </summary>
+/// <param name="predicate"> callable taking an element and returning
+/// bool.</param>
+/// <returns> adaptor making a FilterView.</returns>
+template <typename Predicate>
+auto Filter(Predicate predicate) {
+  return std::views::filter(std::move(predicate));
+}
+
+/// <summary>
+/// Makes an adaptor that transforms a range piped into it.
+/// </summary>
+/// <param name="function"> callable taking an element.</param>
+/// <returns> adaptor making a TransformView.</returns>
+template <typename Function>
+auto Transform(Function function) {
+  return std::views::transform(std::move(function));
+}
+
+/// <summary>
+/// Makes an adaptor that shortens a range piped into it.
+/// </summary>
+/// <param name="count"> maximal number of elements.</param>
+/// <returns> adaptor making a TakeView.</returns>
+inline detail::TakeClosure Take(size_t count) {
+  return detail::TakeClosure{{}, count};
+}
+
+/// <summary>
+/// Writes the elements of a range to an output iterator, in order. Elements
+/// of a range of rvalues, like a view of a temporary, are moved.
+/// </summary>
+/// <param name="range"> range that is written.</param>
+/// <param name="out"> iterator the elements are written to.</param>
+/// <returns> iterator past the last written element.</returns>
+template <std::ranges::input_range Range, std::weakly_incrementable Out>
+  requires std::indirectly_writable<Out, std::ranges::range_reference_t<Range>>
+Out CopyTo(Range &&range, Out out) {
+  for (auto &&value : range) {
+    *out = std::forward<decltype(value)>(value);
+    ++out;
+  }
+  return out;
+}
+
+/// <summary>
+/// Appends the elements of a range to the end of a vector. If the size of
+/// the range is known, the capacity is reserved once up front, otherwise
+/// the vector grows as elements arrive.
+/// </summary>
+/// <param name="range"> range that is appended.</param>
+/// <param name="vector"> vector the elements are appended to.</param>
+/// <returns> reference to the vector.</returns>
+template <std::ranges::input_range Range, typename T, typename Allocator,
+          typename Growth>
+  requires std::constructible_from<T, std::ranges::range_reference_t<Range>>
+Vector<T, Allocator, Growth> &AppendTo(Range &&range,
+                                       Vector<T, Allocator, Growth> &vector) {
+  if constexpr (std::ranges::sized_range<Range>) {
+    vector.Reserve(vector.Size() +
+                   static_cast<size_t>(std::ranges::size(range)));
+  }
+  for (auto &&value : range) {
+    vector.Emplace(std::forward<decltype(value)>(value));
+  }
+  return vector;
+}
+
+/// <summary>
+/// Takes the first element out of the container. Called by the first
+/// begin, the view can only be iterated once.
+/// </summary>
+/// <returns> iterator to the first element.</returns>
+template <Drainable Container>
+typename DrainView<Container>::Iterator DrainView<Container>::begin() {
+  Next();
+  return Iterator(this);
+}
+
+/// <summary>
+/// Returns sentinel that marks the container running out of elements.
+/// </summary>
+/// <returns> default sentinel.</returns>
+template <Drainable Container>
+std::default_sentinel_t DrainView<Container>::end() const noexcept {
+  return std::default_sentinel;
+}
+
+/// <summary>
+/// Takes the next element out of the container into the view. If the
+/// container is empty, the view is left without element.
+/// </summary>
+template <Drainable Container>
+void DrainView<Container>::Next() {
+  if (!current) current.emplace();
+  if (!Traits::Take(*container, *current)) current.reset();
+}
+
+/// <summary>
+/// Returns iterator to the first element.
+/// </summary>
+/// <returns> iterator to the first element.</returns>
+template <std::ranges::input_range Base>
+  requires std::ranges::view<Base>
+typename TakeView<Base>::Iterator TakeView<Base>::begin() {
+  return Iterator(std::ranges::begin(base), count);
+}
+
+/// <summary>
+/// Returns sentinel that ends the view after count elements or at the end
+/// of the base range.
+/// </summary>
+/// <returns> end of the view.</returns>
+template <std::ranges::input_range Base>
+  requires std::ranges::view<Base>
+typename TakeView<Base>::Sentinel TakeView<Base>::end() {
+  return Sentinel{std::ranges::end(base)};
+}
+
+}  // namespace alglib
+
+#endif  // ALGLIB_INCLUDE_RANGES_H_
@@ -0,0 +1,643 @@
+//*****************************************************************************
+// The MIT License (MIT)
+//
+// Copyright � 2024 Piotr Walczak
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the �Software�), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED �AS IS�, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//*****************************************************************************
+
+//*****************************************************************************
+// File: simd_algorithms.h
+//
+// This file contains vectorized kernels for linear scans over contiguous
+// ranges of arithmetic values: find, count, sum, min/max and search in sorted
+// data. Kernels work on Vector, SmallVector, std::span and any other
+// contiguous range. Instruction set is chosen at compile time from the
+// target flags (AVX-512F, AVX2, SSE2 or AArch64 NEON). SSE2 is also used on
+// any x86-64 target, where MSVC doesn't define __SSE2__. Every kernel falls
+// back to a scalar loop for other element types and for the tail of a range.
+//*****************************************************************************
+
+#ifndef ALGLIB_INCLUDE_SIMDALGORITHMS_H_
+#define ALGLIB_INCLUDE_SIMDALGORITHMS_H_
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || \
+    defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "constants.h"
+
+/// <summary>
+/// Default namespace for the AlgLib library.
+/// </summary>
+namespace alglib {
+
+/// <summary>
+/// Concept for contiguous ranges of arithmetic values accepted by the SIMD
+/// kernels.
+/// </summary>
+template <typename Range>
+concept ArithmeticContiguousRange =
+    std::ranges::contiguous_range<Range> &&
+    std::is_arithmetic_v<std::ranges::range_value_t<Range>>;
+
+/// <summary>
+/// Type returned by SimdSum. Integers are summed in 64 bits, so sums of 32 bit
+/// values don't overflow, and floating point values are summed in their own
+/// type.
+/// </summary>
+template <typename T>
+using SimdSumType = std::conditional_t<
+    std::is_floating_point_v<T>, T,
+    std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>;
+
+/// <summary>
+/// Namespace for helpers shared by SIMD kernels.
+/// </summary>
+namespace detail {
+
+/// <summary>
+/// Per type set of vector operations used by the kernels. Primary template has
+/// zero width, which makes the kernels use only the scalar loop. Enabled
+/// specializations provide kWidth lanes and Load, Broadcast, EqualMask (bit
+/// per lane set for equal lanes), Min, Max, Store and widening sum helpers.
+/// </summary>
+/// <typeparam name="T"> type of elements.</typeparam>
+template <typename T>
+struct SimdOps {
+  static constexpr size_t kWidth{0};
+};
+
+#if defined(__AVX512F__)
+
+inline constexpr const char *kSimdInstructionSet{"AVX-512F"};
+
+template <>
+struct SimdOps<int32_t> {
+  using Register = __m512i;
+  using SumRegister = __m512i;
+  static constexpr size_t kWidth{16};
+
+  static Register Load(const int32_t *p) { return _mm512_loadu_si512(p); }
+  static Register Broadcast(int32_t v) { return _mm512_set1_epi32(v); }
+  static unsigned EqualMask(Register a, Register b) {
+    return _mm512_cmpeq_epi32_mask(a, b);
+  }
+  static Register Min(Register a, Register b) { return _mm512_min_epi32(a, b); }
+  static Register Max(Register a, Register b) { return _mm512_max_epi32(a, b); }
+  static void Store(int32_t *p, Register v) { _mm512_storeu_si512(p, v); }
+  static SumRegister ZeroSum() { return _mm512_setzero_si512(); }
+  static SumRegister AddToSum(SumRegister sum, Register v) {
+    __m512i low{_mm512_cvtepi32_epi64(_mm512_castsi512_si256(v))};
+    __m512i high{_mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(v, 1))};
+    return _mm512_add_epi64(sum, _mm512_add_epi64(low, high));
+  }
+  static int64_t ReduceSum(SumRegister sum) {
+    return _mm512_reduce_add_epi64(sum);
+  }
+};
+
+template <>
+struct SimdOps<float> {
+  using Register = __m512;
+  using SumRegister = __m512;
+  static constexpr size_t kWidth{16};
+
+  static Register Load(const float *p) { return _mm512_loadu_ps(p); }
+  static Register Broadcast(float v) { return _mm512_set1_ps(v); }
+  static unsigned EqualMask(Register a, Register b) {
+    return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ);
+  }
+  static Register Min(Register a, Register b) { return _mm512_min_ps(a, b); }
+  static Register Max(Register a, Register b) { return _mm512_max_ps(a, b); }
+  static void Store(float *p, Register v) { _mm512_storeu_ps(p, v); }
+  static SumRegister ZeroSum() { return _mm512_setzero_ps(); }
+  static SumRegister AddToSum(SumRegister sum, Register v) {
+    return _mm512_add_ps(sum, v);
+  }
+  static float ReduceSum(SumRegister sum) { return _mm512_reduce_add_ps(sum); }
+};
+
+template <>
+struct SimdOps<double> {
+  using Register = __m512d;
+  using SumRegister = __m512d;
+  static constexpr size_t kWidth{8};
+
+  static Register Load(const double *p) { return _mm512_loadu_pd(p); }
+  static Register Broadcast(double v) { return _mm512_set1_pd(v); }
+  static unsigned EqualMask(Register a, Register b) {
+    return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ);
+  }
+  static Register Min(Register a, Register b) { return _mm512_min_pd(a, b); }
+  static Register Max(Register a, Register b) { return _mm512_max_pd(a, b); }
+  static void Store(double *p, Register v) { _mm512_storeu_pd(p, v); }
+  static SumRegister ZeroSum() { return _mm512_setzero_pd(); }
+  static SumRegister AddToSum(SumRegister sum, Register v) {
+    return _mm512_add_pd(sum, v);
+  }
+  static double ReduceSum(SumRegister sum) { return _mm512_reduce_add_pd(sum); }
+};
+
+#elif defined(__AVX2__)
+
+inline constexpr const char *kSimdInstructionSet{"AVX2"};
+
+template <>
+struct SimdOps<int32_t> {
+  using Register = __m256i;
+  using SumRegister = __m256i;
+  static constexpr size_t kWidth{8};
+
+  static Register Load(const int32_t *p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  static Register Broadcast(int32_t v) { return _mm256_set1_epi32(v); }
+  static unsigned EqualMask(Register a, Register b) {
+    return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)));
+  }
+  static Register Min(Register a, Register b) { return _mm256_min_epi32(a, b); }
+  static Register Max(Register a, Register b) { return _mm256_max_epi32(a, b); }
+  static void Store(int32_t *p, Register v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v);
+  }
+  static SumRegister ZeroSum() { return _mm256_setzero_si256(); }
+  static SumRegister AddToSum(SumRegister sum, Register v) {
+    __m256i low{_mm256_cvtepi32_epi64(_mm256_castsi256_si128(v))};
+    __m256i high{_mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1))};
+    return _mm256_add_epi64(sum, _mm256_add_epi64(low, high));
+  }
+  static int64_t ReduceSum(SumRegister sum) {
+    alignas(32) int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), sum);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+  }
+};
+
+template <>
+struct SimdOps<float> {
+  using Register = __m256;
+  using SumRegister = __m256;
+  static constexpr size_t kWidth{8};
+
+  static Register Load(const float *p) { return _mm256_loadu_ps(p); }
+  static Register Broadcast(float v) { return _mm256_set1_ps(v); }
+  static unsigned EqualMask(Register a, Register b) {
+    return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ));
+  }
+  static Register Min(Register a, Register b) { return _mm256_min_ps(a, b); }
+  static Register Max(Register a, Register b) { return _mm256_max_ps(a, b); }
+  static void Store(float *p, Register v) { _mm256_storeu_ps(p, v); }
+  static SumRegister ZeroSum() { return _mm256_setzero_ps(); }
+  static SumRegister AddToSum(SumRegister sum, Register v) {
+    return _mm256_add_ps(sum, v);
+  }
+  static float ReduceSum(SumRegister sum) {
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, sum);
+    return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) +
+           ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+  }
+};
+
+template <>
+struct SimdOps<double> {
+  using Register = __m256d;
+  using SumRegister = __m256d;
+  static constexpr size_t kWidth{4};
+
+  static Register Load(const double *p) { return _mm256_loadu_pd(p); }
+  static Register Broadcast(double v) { return _mm256_set1_pd(v); }
+  static unsigned EqualMask(Register a, Register b) {
+    return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ));
+  }
+  static Register Min(Register a, Register b) { return _mm256_min_pd(a, b); }
+  static Register Max(Register a, Register b) { return _mm256_max_pd(a, b); }
+  static void Store(double *p, Register v) { _mm256_storeu_pd(p, v); }
+  static SumRegister ZeroSum() { return _mm256_setzero_pd(); }
+  static SumRegister AddToSum(SumRegister sum, Register v) {
+    return _mm256_add_pd(sum, v);
+  }
+  static double ReduceSum(SumRegister sum) {
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, sum);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+  }
+};
+
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+
+inline constexpr const char *kSimdInstructionSet{"SSE2"};
+
+template <>
+struct SimdOps<int32_t> {
+  using Register = __m128i;
+  using SumRegister = __m128i;
+  static constexpr size_t kWidth{4};
+
+  static Register Load(const int32_t *p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+  }
+  static Register Broadcast(int32_t v) { return _mm_set1_epi32(v); }
+  static unsigned EqualMask(Register a, Register b) {
+    return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)));
+  }
+  // SSE2 lacks 32 bit min and max, so they are built from a comparison.
+  static Register Min(Register a, Register b) {
+    __m128i a_greater{_mm_cmpgt_epi32(a, b)};
+    return _mm_or_si128(_mm_and_si128(a_greater, b),
+                        _mm_andnot_si128(a_greater, a));
+  }
+  static Register Max(Register a, Register b) {
+    __m128i a_greater{_mm_cmpgt_epi32(a, b)};
+    return _mm_or_si128(_mm_and_si128(a_greater, a),
+                        _mm_andnot_si128(a_greater, b));
+  }
+  static void Store(int32_t *p, Register v) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v);
+  }
+  static SumRegister ZeroSum() { return _mm_setzero_si128(); }
+  static SumRegister AddToSum(SumRegister sum, Register v) {
+    __m128i sign{_mm_cmpgt_epi32(_mm_setzero_si128(), v)};
+    __m128i low{_mm_unpacklo_epi32(v, sign)};
+    __m128i high{_mm_unpackhi_epi32(v, sign)};
+    return _mm_add_epi64(sum, _mm_add_epi64(low, high));
+  }
+  static int64_t ReduceSum(SumRegister sum) {
+    alignas(16) int64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i *>(lanes), sum);
+    return lanes[0] + lanes[1];
+  }
+};
+
+template <>
+struct SimdOps<float> {
+  using Register = __m128;
+  using SumRegister = __m128;
+  static constexpr size_t kWidth{4};
+
+  static Register Load(const float *p) { return _mm_loadu_ps(p); }
+  static Register Broadcast(float v) { return _mm_set1_ps(v); }
+  static unsigned EqualMask(Register a, Register b) {
+    return _mm_movemask_ps(_mm_cmpeq_ps(a, b));
+  }
+  static Register Min(Register a, Register b) { return _mm_min_ps(a, b); }
+  static Register Max(Register a, Register b) { return _mm_max_ps(a, b); }
+  static void Store(float *p, Register v) { _mm_storeu_ps(p, v); }
+  static SumRegister ZeroSum() { return _mm_setzero_ps(); }
+  static SumRegister AddToSum(SumRegister sum, Register v) {
+    return _mm_add_ps(sum, v);
+  }
+  static float ReduceSum(SumRegister sum) {
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, sum);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+  }
+};
+
+template <>
+struct SimdOps<double> {
+  using Register = __m128d;
+  using SumRegister = __m128d;
+  static constexpr size_t kWidth{2};
+
+  static Register Load(const double *p) { return _mm_loadu_pd(p); }
+  static Register Broadcast(double v) { return _mm_set1_pd(v); }
+  static unsigned EqualMask(Register a, Register b) {
+    return _mm_movemask_pd(_mm_cmpeq_pd(a, b));
+  }
+  static Register Min(Register a, Register b) { return _mm_min_pd(a, b); }
+  static Register Max(Register a, Register b) { return _mm_max_pd(a, b); }
+  static void Store(double *p, Register v) { _mm_storeu_pd(p, v); }
+  static SumRegister ZeroSum() { return _mm_setzero_pd(); }
+  static SumRegister AddToSum(SumRegister sum, Register v) {
+    return _mm_add_pd(sum, v);
+  }
+  static double ReduceSum(SumRegister sum) {
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, sum);
+    return lanes[0] + lanes[1];
+  }
+};
+
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+
+inline constexpr const char *kSimdInstructionSet{"NEON"};
+
+template <>
+struct SimdOps<int32_t> {
+  using Register = int32x4_t;
+  using SumRegister = int64x2_t;
+  static constexpr size_t kWidth{4};
+
+  static Register Load(const int32_t *p) { return vld1q_s32(p); }
+  static Register Broadcast(int32_t v) { return vdupq_n_s32(v); }
+  static unsigned EqualMask(Register a, Register b) {
+    const uint32x4_t bits{1, 2, 4, 8};
+    return vaddvq_u32(vandq_u32(vceqq_s32(a, b), bits));
+  }
+  static Register Min(Register a, Register b) { return vminq_s32(a, b); }
+  static Register Max(Register a, Register b) { return vmaxq_s32(a, b); }
+  static void Store(int32_t *p, Register v) { vst1q_s32(p, v); }
+  static SumRegister ZeroSum() { return vdupq_n_s64(0); }
+  static SumRegister AddToSum(SumRegister sum, Register v) {
+    return vpadalq_s32(sum, v);
+  }
+  static int64_t ReduceSum(SumRegister sum) { return vaddvq_s64(sum); }
+};
+
+template <>
+struct SimdOps<float> {
+  using Register = float32x4_t;
+  using SumRegister = float32x4_t;
+  static constexpr size_t kWidth{4};
+
+  static Register Load(const float *p) { return vld1q_f32(p); }
+  static Register Broadcast(float v) { return vdupq_n_f32(v); }
+  static unsigned EqualMask(Register a, Register b) {
+    const uint32x4_t bits{1, 2, 4, 8};
+    return vaddvq_u32(vandq_u32(vceqq_f32(a, b), bits));
+  }
+  static Register Min(Register a, Register b) { return vminq_f32(a, b); }
+  static Register Max(Register a, Register b) { return vmaxq_f32(a, b); }
+  static void Store(float *p, Register v) { vst1q_f32(p, v); }
+  static SumRegister ZeroSum() { return vdupq_n_f32(0.0f); }
+  static SumRegister AddToSum(SumRegister sum, Register v) {
+    return vaddq_f32(sum, v);
+  }
+  static float ReduceSum(SumRegister sum) { return vaddvq_f32(sum); }
+};
+
+template <>
+struct SimdOps<double> {
+  using Register = float64x2_t;
+  using SumRegister = float64x2_t;
+  static constexpr size_t kWidth{2};
+
+  static Register Load(const double *p) { return vld1q_f64(p); }
+  static Register Broadcast(double v) { return vdupq_n_f64(v); }
+  static unsigned EqualMask(Register a, Register b) {
+    const uint64x2_t bits{1, 2};
+    return static_cast<unsigned>(vaddvq_u64(vandq_u64(vceqq_f64(a, b), bits)));
+  }
+  static Register Min(Register a, Register b) { return vminq_f64(a, b); }
+  static Register Max(Register a, Register b) { return vmaxq_f64(a, b); }
+  static void Store(double *p, Register v) { vst1q_f64(p, v); }
+  static SumRegister ZeroSum() { return vdupq_n_f64(0.0); }
+  static SumRegister AddToSum(SumRegister sum, Register v) {
+    return vaddq_f64(sum, v);
+  }
+  static double ReduceSum(SumRegister sum) { return vaddvq_f64(sum); }
+};
+
+#else
+
+inline constexpr const char *kSimdInstructionSet{"scalar"};
+
+#endif
+
+/// <summary>
+/// Finds index of the first element equal to a given value.
+/// </summary>
+/// <param name="data"> pointer to the first element.</param>
+/// <param name="size"> amount of elements.</param>
+/// <param name="value"> value to be found.</param>
+/// <returns> index of the element or size if there is none.</returns>
+template <typename T>
+size_t FindKernel(const T *data, size_t size, T value) noexcept {
+  using Ops = SimdOps<T>;
+  size_t i{};
+  if constexpr (Ops::kWidth > 0) {
+    auto needle = Ops::Broadcast(value);
+    for (; i + Ops::kWidth <= size; i += Ops::kWidth) {
+      unsigned mask{Ops::EqualMask(Ops::Load(data + i), needle)};
+      if (mask != 0) return i + std::countr_zero(mask);
+    }
+  }
+  for (; i < size; ++i) {
+    if (data[i] == value) return i;
+  }
+  return size;
+}
+
+/// <summary>
+/// Counts elements equal to a given value.
+/// </summary>
+/// <param name="data"> pointer to the first element.</param>
+/// <param name="size"> amount of elements.</param>
+/// <param name="value"> value to be counted.</param>
+/// <returns> amount of equal elements.</returns>
+template <typename T>
+size_t CountKernel(const T *data, size_t size, T value) noexcept {
+  using Ops = SimdOps<T>;
+  size_t count{};
+  size_t i{};
+  if constexpr (Ops::kWidth > 0) {
+    auto needle = Ops::Broadcast(value);
+    for (; i + Ops::kWidth <= size; i += Ops::kWidth) {
+      count += std::popcount(Ops::EqualMask(Ops::Load(data + i), needle));
+    }
+  }
+  for (; i < size; ++i) {
+    count += data[i] == value;
+  }
+  return count;
+}
+
+/// <summary>
+/// Sums all elements.
+/// </summary>
+/// <param name="data"> pointer to the first element.</param>
+/// <param name="size"> amount of elements.</param>
+/// <returns> sum of the elements.</returns>
+template <typename T>
+SimdSumType<T> SumKernel(const T *data, size_t size) noexcept {
+  using Ops = SimdOps<T>;
+  SimdSumType<T> sum{};
+  size_t i{};
+  if constexpr (Ops::kWidth > 0) {
+    auto lanes = Ops::ZeroSum();
+    for (; i + Ops::kWidth <= size; i += Ops::kWidth) {
+      lanes = Ops::AddToSum(lanes, Ops::Load(data + i));
+    }
+    sum = Ops::ReduceSum(lanes);
+  }
+  for (; i < size; ++i) {
+    sum += data[i];
+  }
+  return sum;
+}
+
+/// <summary>
+/// Finds the smallest and the largest element of a non-empty range.
+/// </summary>
+/// <param name="data"> pointer to the first element.</param>
+/// <param name="size"> amount of elements, at least one.</param>
+/// <returns> pair of the smallest and the largest element.</returns>
+template <typename T>
+std::pair<T, T> MinMaxKernel(const T *data, size_t size) noexcept {
+  using Ops = SimdOps<T>;
+  T min{data[0]};
+  T max{data[0]};
+  size_t i{1};
+  if constexpr (Ops::kWidth > 0) {
+    if (size >= Ops::kWidth) {
+      auto low = Ops::Load(data);
+      auto high = low;
+      for (i = Ops::kWidth; i + Ops::kWidth <= size; i += Ops::kWidth) {
+        auto values = Ops::Load(data + i);
+        low = Ops::Min(low, values);
+        high = Ops::Max(high, values);
+      }
+      T lanes[Ops::kWidth];
+      Ops::Store(lanes, low);
+      for (T lane : lanes) min = lane < min ? lane : min;
+      Ops::Store(lanes, high);
+      for (T lane : lanes) max = lane > max ? lane : max;
+    }
+  }
+  for (; i < size; ++i) {
+    min = data[i] < min ? data[i] : min;
+    max = data[i] > max ? data[i] : max;
+  }
+  return {min, max};
+}
+
+/// <summary>
+/// Amount of elements below which search in sorted data switches from binary
+/// search to a vectorized linear scan.
+/// </summary>
+inline constexpr size_t kSortedScanWindow{64};
+
+/// <summary>
+/// Checks whether sorted data contains a given value. Binary search narrows
+/// the range down to a small window, which is then scanned with FindKernel
+/// instead of paying for unpredictable branches of the last steps.
+/// </summary>
+/// <param name="data"> pointer to the first element.</param>
+/// <param name="size"> amount of elements sorted in ascending order.</param>
+/// <param name="value"> value to be found.</param>
+/// <returns> true if the value is present.</returns>
+template <typename T>
+bool ContainsSortedKernel(const T *data, size_t size, T value) noexcept {
+  size_t low{};
+  size_t high{size};
+  while (high - low > kSortedScanWindow) {
+    size_t middle{low + (high - low) / 2};
+    if (data[middle] < value) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  size_t window_end{high < size ? high + 1 : size};
+  return FindKernel(data + low, window_end - low, value) != window_end - low;
+}
+
+}  // namespace detail
+
+/// <summary>
+/// Finds the first element of a contiguous range equal to a given value using
+/// vector instructions.
+/// </summary>
+/// <param name="range"> range to be searched, for example Vector.</param>
+/// <param name="value"> value to be found.</param>
+/// <returns> index of the first equal element or size of the range if there
+/// is none.</returns>
+template <ArithmeticContiguousRange Range>
+size_t SimdFind(const Range &range,
+                std::ranges::range_value_t<Range> value) noexcept {
+  return detail::FindKernel(std::ranges::data(range), std::ranges::size(range),
+                            value);
+}
+
+/// <summary>
+/// Counts elements of a contiguous range equal to a given value using vector
+/// instructions.
+/// </summary>
+/// <param name="range"> range to be searched, for example Vector.</param>
+/// <param name="value"> value to be counted.</param>
+/// <returns> amount of equal elements.</returns>
+template <ArithmeticContiguousRange Range>
+size_t SimdCount(const Range &range,
+                 std::ranges::range_value_t<Range> value) noexcept {
+  return detail::CountKernel(std::ranges::data(range),
+                             std::ranges::size(range), value);
+}
+
+/// <summary>
+/// Sums elements of a contiguous range using vector instructions. Floating
+/// point values are added in a different order than in a serial loop, so the
+/// result may differ from std::accumulate by rounding.
+/// </summary>
+/// <param name="range"> range to be summed, for example Vector.</param>
+/// <returns> sum of the elements, 0 for an empty range.</returns>
+template <ArithmeticContiguousRange Range>
+SimdSumType<std::ranges::range_value_t<Range>> SimdSum(
+    const Range &range) noexcept {
+  return detail::SumKernel(std::ranges::data(range), std::ranges::size(range));
+}
+
+/// <summary>
+/// Finds the smallest and the largest element of a contiguous range using
+/// vector instructions. Result for ranges containing NaN is unspecified.
+/// </summary>
+/// <param name="range"> range to be searched, for example Vector.</param>
+/// <returns> pair of the smallest and the largest element.</returns>
+/// <exception cref="std::runtime_error"> thrown when the range is
+/// empty.</exception>
+template <ArithmeticContiguousRange Range>
+std::pair<std::ranges::range_value_t<Range>, std::ranges::range_value_t<Range>>
+SimdMinMax(const Range &range) {
+  if (std::ranges::empty(range)) {
+    ALGLIB_THROW(std::runtime_error(errors::kObjectEmpty));
+  }
+  return detail::MinMaxKernel(std::ranges::data(range),
+                              std::ranges::size(range));
+}
+
+/// <summary>
+/// Checks whether a contiguous range sorted in ascending order contains a
+/// given value.
+/// </summary>
+/// <param name="range"> sorted range to be searched, for example
+/// Vector.</param>
+/// <param name="value"> value to be found.</param>
+/// <returns> true if the value is present.</returns>
+template <ArithmeticContiguousRange Range>
+bool SimdContainsSorted(const Range &range,
+                        std::ranges::range_value_t<Range> value) noexcept {
+  return detail::ContainsSortedKernel(std::ranges::data(range),
+                                      std::ranges::size(range), value);
+}
+
+}  // namespace alglib
+
+#endif  // ALGLIB_INCLUDE_SIMDALGORITHMS_H_
@@ -36,11 +36,20 @@
 #ifndef ALGLIB_INCLUDE_SINGLYLINKEDLIST_H_
 #define ALGLIB_INCLUDE_SINGLYLINKEDLIST_H_
 
+#include <cstddef>
 #include <cstdlib>
 #include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "constants.h"
+#include "node_pool.h"
+#include "stats.h"
+#include "traversal.h"
 
 /// <summary>
 /// Default namespace for the AlgLib library.
@@ -49,22 +58,90 @@ namespace alglib {
 
 /// <summary>
 /// Template based singly linked list implementation. All nodes are
-/// dynamically allocated.
+/// dynamically allocated through the allocator, which is rebound to the
+/// internal node type. The list keeps a pointer to the last node and the
+/// number of nodes, so appending and asking for the size don't walk the list.
 /// </summary>
-template <typename T>
+/// <typeparam name="T"> type of data stored in list.</typeparam>
+/// <typeparam name="Allocator"> allocator used to obtain memory for
+/// nodes.</typeparam>
+template <typename T, typename Allocator = PoolAllocator<T>>
 class SinglyLinkedList {
+  struct Node;
+
  public:
-  // Constructor for the singly linked list.
+  /// <summary>
+  /// Forward iterator over nodes of the list. It stays valid until the node
+  /// it points to is deleted. Const qualified type makes a constant
+  /// iterator.
+  /// </summary>
+  /// <typeparam name="Value"> type of data the iterator gives access
+  /// to.</typeparam>
+  template <typename Value>
+  class Iter {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::remove_cv_t<Value>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value *;
+    using reference = Value &;
+
+    // Constructors
+    Iter() noexcept;
+    template <typename OtherValue>
+      requires std::is_convertible_v<OtherValue *, Value *>
+    Iter(const Iter<OtherValue> &other) noexcept;
+
+    // Access operators
+    reference operator*() const noexcept;
+    pointer operator->() const noexcept;
+
+    // Moving operators
+    Iter &operator++() noexcept;
+    Iter operator++(int) noexcept;
+
+    // Comparison operator, inequality is generated from it.
+    bool operator==(const Iter &other) const noexcept;
+
+   private:
+    friend class SinglyLinkedList;
+    template <typename OtherValue>
+    friend class Iter;
+
+    explicit Iter(Node *node) noexcept;
+
+    // Node the iterator points to, nullptr for the past the end iterator.
+    Node *node_;
+  };
+
+  using Iterator = Iter<T>;
+  using ConstIterator = Iter<const T>;
+
+  // Constructors for the singly linked list.
   SinglyLinkedList();
+  explicit SinglyLinkedList(const Allocator &allocator);
 
   // Methods for exploring the singly linked list.
-  void Traverse(const std::function<void(T)> &visit_callback) noexcept;
+  template <typename Function>
+  bool Traverse(Function &&visit_callback);
+  template <typename Function>
+  bool Traverse(Function &&visit_callback) const;
   size_t Size() const noexcept;
+  ContainerStats GetStats() const noexcept;
   size_t Find(T value) const;
 
   // Method for converting the singly linked list to a vector.
   std::vector<T> GetAsVector() const noexcept;
 
+  // Iterators
+  Iterator begin() noexcept;
+  Iterator end() noexcept;
+  ConstIterator begin() const noexcept;
+  ConstIterator end() const noexcept;
+  ConstIterator cbegin() const noexcept;
+  ConstIterator cend() const noexcept;
+  size_t size() const noexcept;
+
   // Insertion methods
   void InsertAtBeginning(T value) noexcept;
   void InsertAtEnd(T value) noexcept;
@@ -74,6 +151,18 @@ class SinglyLinkedList {
   void DeleteAtBeggining();
   void DeleteAtEnd();
   void DeleteAtPosition(uint32_t pos);
+  template <typename Predicate>
+  size_t RemoveIf(Predicate predicate);
+
+  // Methods moving nodes between lists without copying them.
+  void Splice(SinglyLinkedList &other);
+  void SpliceAfter(uint32_t pos, SinglyLinkedList &other);
+
+  // Methods ordering the nodes in place.
+  template <typename Compare = std::less<>>
+  void Sort(Compare compare = Compare());
+  template <typename Compare = std::less<>>
+  void Merge(SinglyLinkedList &other, Compare compare = Compare());
 
   // Destructor for the singly linked list.
   ~SinglyLinkedList();
@@ -99,58 +188,212 @@ class SinglyLinkedList {
     T data;
   };
 
+  using NodeAllocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Node>;
+  using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+  // Methods for allocating and releasing nodes.
+  Node *CreateNode(T value);
+  void DestroyNode(Node *node) noexcept;
+
+  // Helpers for moving nodes of other lists into this one.
+  void CheckAllocator(const SinglyLinkedList &other) const;
+  void Release() noexcept;
+
+  // Helpers for the merge sort.
+  static Node *Split(Node *run, size_t length) noexcept;
+  template <typename Compare>
+  static std::pair<Node *, Node *> MergeRuns(Node *left, Node *right,
+                                             Compare &compare);
+
   /// <summary>
   /// Head pointer to the first node in the singly linked list.
   /// </summary>
   Node *head_;
+
+  /// <summary>
+  /// Pointer to the last node in the singly linked list.
+  /// </summary>
+  Node *tail_;
+
+  /// <summary>
+  /// Number of nodes in the singly linked list.
+  /// </summary>
+  size_t size_;
+
+  /// <summary>
+  /// Allocator that provides memory for the nodes.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS NodeAllocator node_allocator_;
+
+  /// <summary>
+  /// Statistics of the list, empty unless ALGLIB_ENABLE_STATS is defined.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS detail::StatsRecorder stats_;
 };
 
+/// <summary>
+/// Default constructor creating iterator that doesn't point to any node.
+/// </summary>
+template <typename T, typename Allocator>
+template <typename Value>
+SinglyLinkedList<T, Allocator>::Iter<Value>::Iter() noexcept
+    : node_(nullptr) {}
+
+/// <summary>
+/// Converting constructor, used to make constant iterator from a mutable one.
+/// </summary>
+template <typename T, typename Allocator>
+template <typename Value>
+template <typename OtherValue>
+  requires std::is_convertible_v<OtherValue *, Value *>
+SinglyLinkedList<T, Allocator>::Iter<Value>::Iter(
+    const Iter<OtherValue> &other) noexcept
+    : node_(other.node_) {}
+
+/// <summary>
+/// Constructor used by the list to make iterator pointing to a given node.
+/// </summary>
+/// <param name="node"> node or nullptr for the past the end iterator.</param>
+template <typename T, typename Allocator>
+template <typename Value>
+SinglyLinkedList<T, Allocator>::Iter<Value>::Iter(Node *node) noexcept
+    : node_(node) {}
+
+/// <summary>
+/// Gets the value stored in the node.
+/// </summary>
+template <typename T, typename Allocator>
+template <typename Value>
+typename SinglyLinkedList<T, Allocator>::template Iter<Value>::reference
+SinglyLinkedList<T, Allocator>::Iter<Value>::operator*() const noexcept {
+  return node_->data;
+}
+
+/// <summary>
+/// Gives access to members of the value stored in the node.
+/// </summary>
+template <typename T, typename Allocator>
+template <typename Value>
+typename SinglyLinkedList<T, Allocator>::template Iter<Value>::pointer
+SinglyLinkedList<T, Allocator>::Iter<Value>::operator->() const noexcept {
+  return &node_->data;
+}
+
+/// <summary>
+/// Pre-increment. Makes the iterator point to the next node.
+/// </summary>
+template <typename T, typename Allocator>
+template <typename Value>
+typename SinglyLinkedList<T, Allocator>::template Iter<Value> &
+SinglyLinkedList<T, Allocator>::Iter<Value>::operator++() noexcept {
+  node_ = node_->next;
+  return *this;
+}
+
+/// <summary>
+/// Post-increment. Makes the iterator point to the next node.
+/// </summary>
+template <typename T, typename Allocator>
+template <typename Value>
+typename SinglyLinkedList<T, Allocator>::template Iter<Value>
+SinglyLinkedList<T, Allocator>::Iter<Value>::operator++(int) noexcept {
+  Iter tmp{*this};
+  node_ = node_->next;
+  return tmp;
+}
+
+/// <summary>
+/// Checks whether two iterators point to the same node.
+/// </summary>
+template <typename T, typename Allocator>
+template <typename Value>
+bool SinglyLinkedList<T, Allocator>::Iter<Value>::operator==(
+    const Iter &other) const noexcept {
+  return node_ == other.node_;
+}
+
 /// <summary>
 /// Constructor for the Node structure.
 /// </summary>
 /// <param name="data">
 /// Value of type T that will be stored in nodes.
 /// </param>
-template <typename T>
-SinglyLinkedList<T>::Node::Node(T data) : next(nullptr), data(data) {}
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>::Node::Node(T data)
+    : next(nullptr), data(std::move(data)) {}
 
 /// <summary>
-/// Constructor for the SinglyLinkedList structure. Initializes the head
-/// pointer to nullptr.
+/// Constructor for the SinglyLinkedList structure. Initializes the head and
+/// tail pointers to nullptr.
 /// </summary>
-template <typename T>
-SinglyLinkedList<T>::SinglyLinkedList() : head_(nullptr) {}
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>::SinglyLinkedList()
+    : head_(nullptr), tail_(nullptr), size_(0), node_allocator_() {}
 
 /// <summary>
-/// Method that traverses the singly linked list and prints the data
-/// of each node. Modifying the method to do something else with the
-/// data is straight forward and can be done by changing the body of
-/// the while loop.
+/// Constructor for the SinglyLinkedList structure that takes nodes from a
+/// given allocator. Initializes the head and tail pointers to nullptr.
 /// </summary>
-template <typename T>
-void SinglyLinkedList<T>::Traverse(
-    const std::function<void(T)> &visit_callback) noexcept {
-  Node *tmp{head_};
-  while (tmp) {
-    visit_callback(tmp->data);
-    tmp = tmp->next;
+/// <param name="allocator"> allocator used for the nodes.</param>
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>::SinglyLinkedList(const Allocator &allocator)
+    : head_(nullptr), tail_(nullptr), size_(0), node_allocator_(allocator) {}
+
+/// <summary>
+/// Method that traverses the singly linked list and passes the data of each
+/// node to a callable by reference. The callable is a template parameter, so
+/// the call can be inlined into the loop over the nodes.
+/// </summary>
+/// <param name="visit_callback">Callable taking T&. When it returns a value
+/// convertible to bool, false stops the traversal.</param>
+/// <returns>True if all nodes were visited.</returns>
+template <typename T, typename Allocator>
+template <typename Function>
+bool SinglyLinkedList<T, Allocator>::Traverse(Function &&visit_callback) {
+  for (Node *tmp{head_}; tmp; tmp = tmp->next) {
+    if (!detail::Visit(visit_callback, tmp->data)) return false;
   }
+  return true;
 }
 
 /// <summary>
-/// Method that calculates number of nodes in the singly linked list
-/// by traversing the list.
+/// Method that traverses the constant singly linked list and passes the data
+/// of each node to a callable by constant reference.
 /// </summary>
-/// <returns>Number of nodes in structure as size_t.</returns>
-template <typename T>
-size_t SinglyLinkedList<T>::Size() const noexcept {
-  Node *tmp{head_};
-  size_t count{};
-  while (tmp) {
-    ++count;
-    tmp = tmp->next;
+/// <param name="visit_callback">Callable taking const T&. When it returns a
+/// value convertible to bool, false stops the traversal.</param>
+/// <returns>True if all nodes were visited.</returns>
+template <typename T, typename Allocator>
+template <typename Function>
+bool SinglyLinkedList<T, Allocator>::Traverse(
+    Function &&visit_callback) const {
+  for (const Node *tmp{head_}; tmp; tmp = tmp->next) {
+    if (!detail::Visit(visit_callback, tmp->data)) return false;
   }
-  return count;
+  return true;
+}
+
+/// <summary>
+/// Method that returns number of nodes in the singly linked list. The count
+/// is kept up to date by all modifying methods.
+/// </summary>
+/// <returns>Number of nodes in structure as size_t.</returns>
+template <typename T, typename Allocator>
+size_t SinglyLinkedList<T, Allocator>::Size() const noexcept {
+  return size_;
+}
+
+/// <summary>
+/// Method that returns statistics of the singly linked list. It records
+/// allocated and released nodes and the biggest size, which includes nodes
+/// spliced or merged from other lists. Without ALGLIB_ENABLE_STATS all
+/// counters are zero.
+/// </summary>
+/// <returns>Statistics of the list.</returns>
+template <typename T, typename Allocator>
+ContainerStats SinglyLinkedList<T, Allocator>::GetStats() const noexcept {
+  return stats_.Get();
 }
 
 /// <summary>
@@ -158,8 +401,8 @@ size_t SinglyLinkedList<T>::Size() const noexcept {
 /// </summary>
 /// <param name="value">Value that the list will be searched for.</param>
 /// <returns>Index of first occurance of given value (0 = first).</returns>
-template <typename T>
-size_t SinglyLinkedList<T>::Find(T value) const {
+template <typename T, typename Allocator>
+size_t SinglyLinkedList<T, Allocator>::Find(T value) const {
   Node *tmp{head_};
 
   size_t count{};
@@ -169,7 +412,7 @@ size_t SinglyLinkedList<T>::Find(T value) const {
   }
 
   if (tmp == nullptr) {
-    throw std::runtime_error(errors::kItemNotFound);
+    ALGLIB_THROW(std::runtime_error(errors::kItemNotFound));
   } else {
     return count;
   }
@@ -179,13 +422,14 @@ size_t SinglyLinkedList<T>::Find(T value) const {
 /// Method that converts the singly linked list to a vector.
 /// It is used for teseing purposes.
 /// Using it in production code is not recommended as it is
-/// simply missing the point of the singly linked list.
+/// simply missing the point of the singly linked list. Iterate the list, or
+/// pipe it through the lazy views of ranges.h, instead of copying it.
 /// </summary>
 /// <returns>std::vector of nodes that are in structure.</returns>
-template <typename T>
-std::vector<T> SinglyLinkedList<T>::GetAsVector() const noexcept {
+template <typename T, typename Allocator>
+std::vector<T> SinglyLinkedList<T, Allocator>::GetAsVector() const noexcept {
   std::vector<T> vec{};
-  vec.reserve(Size());
+  vec.reserve(size_);
   Node *tmp{head_};
   while (tmp) {
     vec.emplace_back(tmp->data);
@@ -194,38 +438,101 @@ std::vector<T> SinglyLinkedList<T>::GetAsVector() const noexcept {
   return vec;
 }
 
+/// <summary>
+/// Returns iterator to the first node.
+/// </summary>
+template <typename T, typename Allocator>
+typename SinglyLinkedList<T, Allocator>::Iterator
+SinglyLinkedList<T, Allocator>::begin() noexcept {
+  return Iterator(head_);
+}
+
+/// <summary>
+/// Returns iterator to the position past the last node.
+/// </summary>
+template <typename T, typename Allocator>
+typename SinglyLinkedList<T, Allocator>::Iterator
+SinglyLinkedList<T, Allocator>::end() noexcept {
+  return Iterator(nullptr);
+}
+
+/// <summary>
+/// Returns constant iterator to the first node.
+/// </summary>
+template <typename T, typename Allocator>
+typename SinglyLinkedList<T, Allocator>::ConstIterator
+SinglyLinkedList<T, Allocator>::begin() const noexcept {
+  return ConstIterator(head_);
+}
+
+/// <summary>
+/// Returns constant iterator to the position past the last node.
+/// </summary>
+template <typename T, typename Allocator>
+typename SinglyLinkedList<T, Allocator>::ConstIterator
+SinglyLinkedList<T, Allocator>::end() const noexcept {
+  return ConstIterator(nullptr);
+}
+
+/// <summary>
+/// Returns constant iterator to the first node.
+/// </summary>
+template <typename T, typename Allocator>
+typename SinglyLinkedList<T, Allocator>::ConstIterator
+SinglyLinkedList<T, Allocator>::cbegin() const noexcept {
+  return begin();
+}
+
+/// <summary>
+/// Returns constant iterator to the position past the last node.
+/// </summary>
+template <typename T, typename Allocator>
+typename SinglyLinkedList<T, Allocator>::ConstIterator
+SinglyLinkedList<T, Allocator>::cend() const noexcept {
+  return end();
+}
+
+/// <summary>
+/// Returns number of nodes under the name used by std::ranges::size, which
+/// makes the list a sized range.
+/// </summary>
+template <typename T, typename Allocator>
+size_t SinglyLinkedList<T, Allocator>::size() const noexcept {
+  return size_;
+}
+
 /// <summary>
 /// Method that inserts a new node at the beginning of the singly linked list
 /// by creating a new node and pointing it to the current head.
 /// </summary>
 /// <param name="value">Value for the new node.</param>
-template <typename T>
-void SinglyLinkedList<T>::InsertAtBeginning(T value) noexcept {
-  Node *new_node{new Node(value)};
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::InsertAtBeginning(T value) noexcept {
+  Node *new_node{CreateNode(std::move(value))};
   new_node->next = head_;
   head_ = new_node;
+  if (tail_ == nullptr) tail_ = new_node;
+  ++size_;
+  stats_.Size(size_);
 }
 
 /// <summary>
 /// Method that inserts a new node at the end of the singly linked list
-/// by traversing the list and adding the new node to the last node.
+/// by linking it after the tail node.
 /// </summary>
 /// <param name="value">Value for the new node.</param>
-template <typename T>
-void SinglyLinkedList<T>::InsertAtEnd(T value) noexcept {
-  Node *new_node{new Node(value)};
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::InsertAtEnd(T value) noexcept {
+  Node *new_node{CreateNode(std::move(value))};
 
-  if (head_ == nullptr) {
+  if (tail_ == nullptr) {
     head_ = new_node;
-    return;
-  }
-
-  Node *tmp{head_};
-  while (tmp->next) {
-    tmp = tmp->next;
+  } else {
+    tail_->next = new_node;
   }
-
-  tmp->next = new_node;
+  tail_ = new_node;
+  ++size_;
+  stats_.Size(size_);
 }
 
 /// <summary>
@@ -235,14 +542,14 @@ void SinglyLinkedList<T>::InsertAtEnd(T value) noexcept {
 /// </summary
 /// <param name="pos">Position for the new node (0 - first).</param>
 /// <param name="value">Value for the new node.</param>
-template <typename T>
-void SinglyLinkedList<T>::InsertAtPosition(uint32_t pos, T value) {
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::InsertAtPosition(uint32_t pos, T value) {
   if (pos < 0) {
-    throw std::runtime_error(errors::kIndexOutOfRange);
+    ALGLIB_THROW(std::runtime_error(errors::kIndexOutOfRange));
   } else if (pos == 0) {
-    Node *newNode{new Node(value)};
-    newNode->next = head_;
-    head_ = newNode;
+    InsertAtBeginning(std::move(value));
+  } else if (pos == size_) {
+    InsertAtEnd(std::move(value));
   } else {
     Node *tmp{head_};
     uint32_t count{};
@@ -250,10 +557,14 @@ void SinglyLinkedList<T>::InsertAtPosition(uint32_t pos, T value) {
       tmp = tmp->next;
       ++count;
     }
-    if (tmp == nullptr) throw std::runtime_error(errors::kIndexOutOfRange);
-    Node *newNode{new Node(value)};
+    if (tmp == nullptr) {
+      ALGLIB_THROW(std::runtime_error(errors::kIndexOutOfRange));
+    }
+    Node *newNode{CreateNode(std::move(value))};
     newNode->next = tmp->next;
     tmp->next = newNode;
+    ++size_;
+    stats_.Size(size_);
   }
 }
 
@@ -261,37 +572,44 @@ void SinglyLinkedList<T>::InsertAtPosition(uint32_t pos, T value) {
 /// Method for deleting the first node in the singly linked list
 /// by pointing the head to the next node and deleting the first node.
 /// </summary>
-template <typename T>
-void SinglyLinkedList<T>::DeleteAtBeggining() {
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::DeleteAtBeggining() {
   if (head_ == nullptr) {
-    throw std::runtime_error(errors::kEmptyDeletion);
+    ALGLIB_THROW(std::runtime_error(errors::kEmptyDeletion));
   } else if (head_->next == nullptr) {
-    delete head_;
+    DestroyNode(head_);
     head_ = nullptr;
+    tail_ = nullptr;
   } else {
     Node *tmp{head_};
     head_ = head_->next;
-    delete tmp;
+    DestroyNode(tmp);
   }
+  --size_;
 }
 
 /// <summary>
 /// Method for deleting the last node in the singly linked list
-/// by traversing the list to the last node and deleting it.
+/// by traversing the list to the node before the last one and deleting the
+/// tail. Nodes don't link back, so this is the only operation at the end of
+/// the list that walks it.
 /// </summary>
-template <typename T>
-void SinglyLinkedList<T>::DeleteAtEnd() {
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::DeleteAtEnd() {
   if (head_ == nullptr) {
-    throw std::runtime_error(errors::kEmptyDeletion);
+    ALGLIB_THROW(std::runtime_error(errors::kEmptyDeletion));
   } else if (head_->next == nullptr) {
-    delete head_;
+    DestroyNode(head_);
     head_ = nullptr;
+    tail_ = nullptr;
   } else {
     Node *tmp{head_};
-    while (tmp->next->next != nullptr) tmp = tmp->next;
-    delete tmp->next;
+    while (tmp->next != tail_) tmp = tmp->next;
+    DestroyNode(tail_);
     tmp->next = nullptr;
+    tail_ = tmp;
   }
+  --size_;
 }
 
 /// <summary>
@@ -299,14 +617,12 @@ void SinglyLinkedList<T>::DeleteAtEnd() {
 /// by traversing the list to the given position and splicing the node out.
 /// </summary>
 /// <param name="pos">Position of the node to delete (0 - first).</param>
-template <typename T>
-void SinglyLinkedList<T>::DeleteAtPosition(uint32_t pos) {
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::DeleteAtPosition(uint32_t pos) {
   if (head_ == nullptr) {
-    throw std::runtime_error(errors::kEmptyDeletion);
+    ALGLIB_THROW(std::runtime_error(errors::kEmptyDeletion));
   } else if (pos == 0) {
-    Node *tmp{head_};
-    head_ = head_->next;
-    delete tmp;
+    DeleteAtBeggining();
   } else {
     Node *tmp{head_};
     uint32_t count{};
@@ -315,11 +631,145 @@ void SinglyLinkedList<T>::DeleteAtPosition(uint32_t pos) {
       ++count;
     }
     if (tmp == nullptr || tmp->next == nullptr)
-      throw std::runtime_error(errors::kIndexOutOfRange);
+      ALGLIB_THROW(std::runtime_error(errors::kIndexOutOfRange));
     Node *toDelete{tmp->next};
     tmp->next = toDelete->next;
-    delete toDelete;
+    if (toDelete == tail_) tail_ = tmp;
+    DestroyNode(toDelete);
+    --size_;
+  }
+}
+
+/// <summary>
+/// Method for deleting all nodes whose data satisfies a predicate, in a
+/// single pass over the list.
+/// </summary>
+/// <param name="predicate">Callable taking const T& and returning true for
+/// nodes that will be deleted.</param>
+/// <returns>Number of deleted nodes.</returns>
+template <typename T, typename Allocator>
+template <typename Predicate>
+size_t SinglyLinkedList<T, Allocator>::RemoveIf(Predicate predicate) {
+  size_t removed{};
+  Node **link{&head_};
+  Node *last{nullptr};
+  while (*link) {
+    Node *node{*link};
+    if (std::invoke(predicate, std::as_const(node->data))) {
+      *link = node->next;
+      DestroyNode(node);
+      --size_;
+      ++removed;
+    } else {
+      last = node;
+      link = &node->next;
+    }
+  }
+  tail_ = last;
+  return removed;
+}
+
+/// <summary>
+/// Method that moves all nodes of other list to the end of this one. Nodes
+/// are relinked, not copied, so it takes constant time. Other list is left
+/// empty.
+/// </summary>
+/// <param name="other">List that the nodes are taken from.</param>
+/// <exception cref="std::runtime_error">Thrown when allocators of the lists
+/// are not equal, as this list couldn't release the nodes.</exception>
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::Splice(SinglyLinkedList &other) {
+  if (&other == this || other.head_ == nullptr) return;
+  CheckAllocator(other);
+  if (tail_ == nullptr) {
+    head_ = other.head_;
+  } else {
+    tail_->next = other.head_;
   }
+  tail_ = other.tail_;
+  size_ += other.size_;
+  stats_.Size(size_);
+  other.Release();
+}
+
+/// <summary>
+/// Method that moves all nodes of other list after the node at a given
+/// position. Finding the position walks the list, unless it is the last
+/// node; moving the nodes takes constant time. Other list is left empty.
+/// </summary>
+/// <param name="pos">Position of the node after which the nodes are
+/// inserted (0 - first).</param>
+/// <param name="other">List that the nodes are taken from.</param>
+/// <exception cref="std::runtime_error">Thrown when position is out of
+/// range or allocators of the lists are not equal.</exception>
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::SpliceAfter(uint32_t pos,
+                                                 SinglyLinkedList &other) {
+  if (pos >= size_) ALGLIB_THROW(std::runtime_error(errors::kIndexOutOfRange));
+  if (&other == this || other.head_ == nullptr) return;
+  CheckAllocator(other);
+  if (pos == size_ - 1) {
+    Splice(other);
+    return;
+  }
+  Node *tmp{head_};
+  for (uint32_t count{}; count < pos; ++count) tmp = tmp->next;
+  other.tail_->next = tmp->next;
+  tmp->next = other.head_;
+  size_ += other.size_;
+  stats_.Size(size_);
+  other.Release();
+}
+
+/// <summary>
+/// Method that sorts the list with bottom-up merge sort. Nodes are relinked
+/// in place, so no memory is allocated and the values are not copied. The
+/// sort is stable and takes O(n log n) time.
+/// </summary>
+/// <typeparam name="Compare"> strict weak ordering of the values.</typeparam>
+/// <param name="compare">Function object returning true when the first
+/// value goes before the second one. It must not throw.</param>
+template <typename T, typename Allocator>
+template <typename Compare>
+void SinglyLinkedList<T, Allocator>::Sort(Compare compare) {
+  for (size_t width{1}; width < size_; width *= 2) {
+    Node *rest{head_};
+    Node **link{&head_};
+    while (rest) {
+      Node *left{rest};
+      Node *right{Split(left, width)};
+      rest = Split(right, width);
+      auto [first, last] = MergeRuns(left, right, compare);
+      *link = first;
+      link = &last->next;
+      tail_ = last;
+    }
+  }
+}
+
+/// <summary>
+/// Method that merges other sorted list into this sorted list. Nodes are
+/// relinked in place and equal values from this list stay before the ones
+/// from other list. Other list is left empty.
+/// </summary>
+/// <typeparam name="Compare"> strict weak ordering of the values.</typeparam>
+/// <param name="other">Sorted list that the nodes are taken from.</param>
+/// <param name="compare">Function object that both lists are sorted by. It
+/// must not throw.</param>
+/// <exception cref="std::runtime_error">Thrown when allocators of the lists
+/// are not equal.</exception>
+template <typename T, typename Allocator>
+template <typename Compare>
+void SinglyLinkedList<T, Allocator>::Merge(SinglyLinkedList &other,
+                                           Compare compare) {
+  if (&other == this || other.head_ == nullptr) return;
+  CheckAllocator(other);
+  auto [first, last] = MergeRuns(head_, other.head_, compare);
+  head_ = first;
+  tail_ = last;
+  size_ += other.size_;
+  stats_.Size(size_);
+  other.Release();
 }
 
 /// <summary>
@@ -327,16 +777,132 @@ void SinglyLinkedList<T>::DeleteAtPosition(uint32_t pos) {
 /// It traverses the list and deletes each node
 /// as they are dynamically allocated.
 /// </summary>
-template <typename T>
-SinglyLinkedList<T>::~SinglyLinkedList() {
+template <typename T, typename Allocator>
+SinglyLinkedList<T, Allocator>::~SinglyLinkedList() {
   Node *tmp{head_};
   while (tmp) {
     Node *next{tmp->next};
-    delete tmp;
+    DestroyNode(tmp);
     tmp = next;
   }
 }
 
+/// <summary>
+/// Obtains memory for a new node from the node allocator and constructs the
+/// node with a given value.
+/// </summary>
+/// <param name="value"> value that will be stored in the node.</param>
+/// <returns> pointer to the new node.</returns>
+template <typename T, typename Allocator>
+typename SinglyLinkedList<T, Allocator>::Node *
+SinglyLinkedList<T, Allocator>::CreateNode(T value) {
+  Node *node{NodeTraits::allocate(node_allocator_, 1)};
+  ALGLIB_TRY {
+    NodeTraits::construct(node_allocator_, node, std::move(value));
+  } ALGLIB_CATCH_ALL {
+    NodeTraits::deallocate(node_allocator_, node, 1);
+    ALGLIB_RETHROW;
+  }
+  stats_.Allocation();
+  return node;
+}
+
+/// <summary>
+/// Destroys a node and returns its memory to the node allocator.
+/// </summary>
+/// <param name="node"> node created with CreateNode.</param>
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::DestroyNode(Node *node) noexcept {
+  NodeTraits::destroy(node_allocator_, node);
+  NodeTraits::deallocate(node_allocator_, node, 1);
+  stats_.Deallocation();
+}
+
+/// <summary>
+/// Checks whether nodes of other list can be released by this list.
+/// </summary>
+/// <param name="other"> list whose nodes will be taken.</param>
+/// <exception cref="std::runtime_error">Thrown when allocators of the lists
+/// are not equal.</exception>
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::CheckAllocator(
+    const SinglyLinkedList &other) const {
+  if (!(node_allocator_ == other.node_allocator_))
+    ALGLIB_THROW(std::runtime_error(errors::kAllocatorMismatch));
+}
+
+/// <summary>
+/// Forgets all nodes without destroying them, after they were moved to
+/// another list.
+/// </summary>
+template <typename T, typename Allocator>
+void SinglyLinkedList<T, Allocator>::Release() noexcept {
+  head_ = nullptr;
+  tail_ = nullptr;
+  size_ = 0;
+}
+
+/// <summary>
+/// Cuts a run of a given length from the front of a chain of nodes.
+/// </summary>
+/// <param name="run"> first node of the run, can be nullptr.</param>
+/// <param name="length"> number of nodes in the run.</param>
+/// <returns> first node after the run or nullptr if the chain ended.</returns>
+template <typename T, typename Allocator>
+typename SinglyLinkedList<T, Allocator>::Node *
+SinglyLinkedList<T, Allocator>::Split(Node *run, size_t length) noexcept {
+  for (size_t i{1}; run && i < length; ++i) run = run->next;
+  if (run == nullptr) return nullptr;
+  Node *rest{run->next};
+  run->next = nullptr;
+  return rest;
+}
+
+/// <summary>
+/// Merges two sorted chains of nodes into one. Nodes of the left chain go
+/// first when values are equal.
+/// </summary>
+/// <param name="left"> first sorted chain, can be nullptr.</param>
+/// <param name="right"> second sorted chain, can be nullptr.</param>
+/// <param name="compare"> ordering that both chains are sorted by.</param>
+/// <returns> first and last node of the merged chain.</returns>
+template <typename T, typename Allocator>
+template <typename Compare>
+std::pair<typename SinglyLinkedList<T, Allocator>::Node *,
+          typename SinglyLinkedList<T, Allocator>::Node *>
+SinglyLinkedList<T, Allocator>::MergeRuns(Node *left, Node *right,
+                                          Compare &compare) {
+  Node *first{nullptr};
+  Node *last{nullptr};
+  Node **link{&first};
+  while (left && right) {
+    if (compare(right->data, left->data)) {
+      last = right;
+      right = right->next;
+    } else {
+      last = left;
+      left = left->next;
+    }
+    *link = last;
+    link = &last->next;
+  }
+  *link = left ? left : right;
+  if (last == nullptr) last = first;
+  while (last && last->next) last = last->next;
+  return {first, last};
+}
+
+/// <summary>
+/// Aliases for containers that take memory from a std::pmr::memory_resource.
+/// </summary>
+namespace pmr {
+
+template <typename T>
+using SinglyLinkedList =
+    alglib::SinglyLinkedList<T, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
 }  // namespace alglib
 
 #endif  // ALGLIB_INCLUDE_SINGLYLINKEDLIST_H_
\ No newline at end of file
@@ -32,9 +32,14 @@
 #ifndef ALGLIB_INCLUDE_SLLQUEUE_H_
 #define ALGLIB_INCLUDE_SLLQUEUE_H_
 
+#include <memory>
+#include <memory_resource>
 #include <stdexcept>
+#include <utility>
 
 #include "constants.h"
+#include "node_pool.h"
+#include "stats.h"
 
 /// <summary>
 /// Default namespace for the library.
@@ -47,11 +52,14 @@ namespace alglib {
 /// no limit to the amount of elements besides the memory available.
 /// </summary>
 /// <typeparam name="T"> type that will be stored in queue.</typeparam>
-template <typename T>
+/// <typeparam name="Allocator"> allocator used to obtain memory for
+/// nodes.</typeparam>
+template <typename T, typename Allocator = PoolAllocator<T>>
 class SLLQueue {
  public:
-  // Constructor for the SLLQueue.
+  // Constructors for the SLLQueue.
   SLLQueue();
+  explicit SLLQueue(const Allocator &allocator);
 
   // Manipulation methods for the queue.
   bool IsEmpty() const noexcept;
@@ -62,6 +70,14 @@ class SLLQueue {
   T PeekFront() const;
   T PeekRear() const;
 
+  // Non-throwing methods for dequeuing and peeking.
+  bool TryDequeue(T &value);
+  bool TryPeekFront(T &value) const;
+  bool TryPeekRear(T &value) const;
+
+  // Getting statistics of the queue.
+  ContainerStats GetStats() const noexcept;
+
   // Destructor for the SLLQueue.
   ~SLLQueue();
 
@@ -83,6 +99,24 @@ class SLLQueue {
   /// Pointer to the rear of the queue.
   /// </summary>
   Node *rear;
+
+  using NodeAllocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Node>;
+  using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+  // Methods for allocating and releasing nodes.
+  Node *CreateNode(T value);
+  void DestroyNode(Node *node) noexcept;
+
+  /// <summary>
+  /// Allocator that provides memory for the nodes.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS NodeAllocator node_allocator;
+
+  /// <summary>
+  /// Statistics of the queue, empty unless ALGLIB_ENABLE_STATS is defined.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS detail::StatsRecorder stats;
 };
 
 /// <summary>
@@ -90,21 +124,32 @@ class SLLQueue {
 /// and next pointer to nullptr.
 /// </summary>
 /// <param name="value"> value to be set in the node.</param>
-template <typename T>
-SLLQueue<T>::Node::Node(T value) : val(value), next(nullptr) {}
+template <typename T, typename Allocator>
+SLLQueue<T, Allocator>::Node::Node(T value)
+    : val(std::move(value)), next(nullptr) {}
 
 /// <summary>
 /// SLLQueue constructor initializes the front and rear pointers to nullptr.
 /// </summary>
-template <typename T>
-SLLQueue<T>::SLLQueue() : front(nullptr), rear(nullptr) {}
+template <typename T, typename Allocator>
+SLLQueue<T, Allocator>::SLLQueue()
+    : front(nullptr), rear(nullptr), node_allocator() {}
+
+/// <summary>
+/// SLLQueue constructor that takes nodes from a given allocator. Initializes
+/// the front and rear pointers to nullptr.
+/// </summary>
+/// <param name="allocator"> allocator used for the nodes.</param>
+template <typename T, typename Allocator>
+SLLQueue<T, Allocator>::SLLQueue(const Allocator &allocator)
+    : front(nullptr), rear(nullptr), node_allocator(allocator) {}
 
 /// <summary>
 /// Checks if the queue is empty by checking if the front pointer is nullptr.
 /// </summary>
 /// <returns> true if empty, false if not.</returns>
-template <typename T>
-bool SLLQueue<T>::IsEmpty() const noexcept {
+template <typename T, typename Allocator>
+bool SLLQueue<T, Allocator>::IsEmpty() const noexcept {
   return front == nullptr;
 }
 
@@ -116,10 +161,10 @@ bool SLLQueue<T>::IsEmpty() const noexcept {
 /// throws a runtime error.
 /// </summary>
 /// <returns></returns>
-template <typename T>
-T SLLQueue<T>::Dequeue() {
+template <typename T, typename Allocator>
+T SLLQueue<T, Allocator>::Dequeue() {
   if (IsEmpty()) {
-    throw std::runtime_error(errors::kEmptyDeletion);
+    ALGLIB_THROW(std::runtime_error(errors::kEmptyDeletion));
   }
   T result{front->val};
   Node *tmp{front};
@@ -127,7 +172,7 @@ T SLLQueue<T>::Dequeue() {
   if (front == nullptr) {
     rear = nullptr;
   }
-  delete tmp;
+  DestroyNode(tmp);
   return result;
 }
 
@@ -137,14 +182,15 @@ T SLLQueue<T>::Dequeue() {
 /// the next node of the rear pointer and the rear pointer is set to the new node.
 /// </summary>
 /// <param name="value"> value to be inserted into queue.</param>
-template <typename T>
-void SLLQueue<T>::Enqueue(T value) noexcept {
-  Node *new_node{new Node(value)};
+template <typename T, typename Allocator>
+void SLLQueue<T, Allocator>::Enqueue(T value) noexcept {
+  Node *new_node{CreateNode(std::move(value))};
   if (IsEmpty()) {
     front = rear = new_node;
+  } else {
+    rear->next = new_node;
+    rear = rear->next;
   }
-  rear->next = new_node;
-  rear = rear->next;
 }
 
 /// <summary>
@@ -153,10 +199,10 @@ void SLLQueue<T>::Enqueue(T value) noexcept {
 /// </summary>
 /// <typeparam name="T"></typeparam>
 /// <returns></returns>
-template <typename T>
-T SLLQueue<T>::PeekFront() const {
+template <typename T, typename Allocator>
+T SLLQueue<T, Allocator>::PeekFront() const {
   if (IsEmpty()) {
-    throw std::runtime_error(errors::kObjectEmpty);
+    ALGLIB_THROW(std::runtime_error(errors::kObjectEmpty));
   }
   return front->val;
 }
@@ -167,30 +213,136 @@ T SLLQueue<T>::PeekFront() const {
 /// </summary>
 /// <typeparam name="T"></typeparam>
 /// <returns></returns>
-template <typename T>
-T SLLQueue<T>::PeekRear() const {
+template <typename T, typename Allocator>
+T SLLQueue<T, Allocator>::PeekRear() const {
   if (IsEmpty()) {
-    throw std::runtime_error(errors::kObjectEmpty);
+    ALGLIB_THROW(std::runtime_error(errors::kObjectEmpty));
   }
   return rear->val;
 }
 
+/// <summary>
+/// Moves the value from the front of the queue into a given object and
+/// deletes the front node, unless the queue is empty.
+/// </summary>
+/// <param name="value"> object the front value is moved into.</param>
+/// <returns> true if a value was dequeued, false if the queue is
+/// empty.</returns>
+template <typename T, typename Allocator>
+bool SLLQueue<T, Allocator>::TryDequeue(T &value) {
+  if (IsEmpty()) {
+    return false;
+  }
+  value = std::move(front->val);
+  Node *tmp{front};
+  front = front->next;
+  if (front == nullptr) {
+    rear = nullptr;
+  }
+  DestroyNode(tmp);
+  return true;
+}
+
+/// <summary>
+/// Copies the value from the front of the queue into a given object unless
+/// the queue is empty.
+/// </summary>
+/// <param name="value"> object the front value is copied into.</param>
+/// <returns> true if a value was copied, false if the queue is
+/// empty.</returns>
+template <typename T, typename Allocator>
+bool SLLQueue<T, Allocator>::TryPeekFront(T &value) const {
+  if (IsEmpty()) {
+    return false;
+  }
+  value = front->val;
+  return true;
+}
+
+/// <summary>
+/// Copies the value from the rear of the queue into a given object unless
+/// the queue is empty.
+/// </summary>
+/// <param name="value"> object the rear value is copied into.</param>
+/// <returns> true if a value was copied, false if the queue is
+/// empty.</returns>
+template <typename T, typename Allocator>
+bool SLLQueue<T, Allocator>::TryPeekRear(T &value) const {
+  if (IsEmpty()) {
+    return false;
+  }
+  value = rear->val;
+  return true;
+}
+
+/// <summary>
+/// Returns statistics of the queue. It records allocated and released nodes
+/// and the biggest number of nodes held at once. Without ALGLIB_ENABLE_STATS
+/// all counters are zero.
+/// </summary>
+/// <returns> statistics of the queue.</returns>
+template <typename T, typename Allocator>
+ContainerStats SLLQueue<T, Allocator>::GetStats() const noexcept {
+  return stats.Get();
+}
+
 /// <summary>
 /// Deletes all nodes from the queue. It starts from the front and deletes all
-/// nodes until the rear. It then deletes the rear node.
+/// nodes until the end of the list, including the rear node.
 /// </summary>
 /// <typeparam name="T"></typeparam>
-template <typename T>
-SLLQueue<T>::~SLLQueue() {
+template <typename T, typename Allocator>
+SLLQueue<T, Allocator>::~SLLQueue() {
   Node *tmp{front};
-  while (tmp != rear) {
+  while (tmp) {
     Node *next{tmp->next};
-    delete tmp;
+    DestroyNode(tmp);
     tmp = next;
   }
-  delete rear;
 }
 
+/// <summary>
+/// Obtains memory for a new node from the node allocator and constructs the
+/// node with a given value.
+/// </summary>
+/// <param name="value"> value that will be stored in the node.</param>
+/// <returns> pointer to the new node.</returns>
+template <typename T, typename Allocator>
+typename SLLQueue<T, Allocator>::Node *
+SLLQueue<T, Allocator>::CreateNode(T value) {
+  Node *node{NodeTraits::allocate(node_allocator, 1)};
+  ALGLIB_TRY {
+    NodeTraits::construct(node_allocator, node, std::move(value));
+  } ALGLIB_CATCH_ALL {
+    NodeTraits::deallocate(node_allocator, node, 1);
+    ALGLIB_RETHROW;
+  }
+  stats.NodeAllocation();
+  return node;
+}
+
+/// <summary>
+/// Destroys a node and returns its memory to the node allocator.
+/// </summary>
+/// <param name="node"> node created with CreateNode.</param>
+template <typename T, typename Allocator>
+void SLLQueue<T, Allocator>::DestroyNode(Node *node) noexcept {
+  NodeTraits::destroy(node_allocator, node);
+  NodeTraits::deallocate(node_allocator, node, 1);
+  stats.Deallocation();
+}
+
+/// <summary>
+/// Aliases for containers that take memory from a std::pmr::memory_resource.
+/// </summary>
+namespace pmr {
+
+template <typename T>
+using SLLQueue =
+    alglib::SLLQueue<T, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
 }  // namespace alglib
 
 #endif  // ALGLIB_INCLUDE_SLLQUEUE_H_
@@ -35,9 +35,14 @@
 #ifndef ALGLIB_INCLUDE_LISTSTACK_H_
 #define ALGLIB_INCLUDE_LISTSTACK_H_
 
+#include <memory>
+#include <memory_resource>
 #include <stdexcept>
+#include <utility>
 
 #include "constants.h"
+#include "node_pool.h"
+#include "stats.h"
 
 /// <summary>
 /// Default namespace for the AlgLib library.
@@ -50,19 +55,27 @@ namespace alglib {
 /// dynamically.
 /// </summary>
 /// <typeparam name="T"> type of data stored on the stack.</typeparam>
-template <typename T>
+/// <typeparam name="Allocator"> allocator used to obtain memory for
+/// nodes.</typeparam>
+template <typename T, typename Allocator = PoolAllocator<T>>
 class SLLStack {
  public:
-  // Constructor for the ArrayStack.
+  // Constructors for the SLLStack.
   SLLStack();
+  explicit SLLStack(const Allocator &allocator);
 
   // Methods for manipulating the stack.
   void Push(T val) noexcept;
   T Pop();
   T Top() const;
+  bool TryPop(T &val);
+  bool TryTop(T &val) const;
   bool IsEmpty() const noexcept;
   size_t Size() const noexcept;
 
+  // Getting statistics of the stack.
+  ContainerStats GetStats() const noexcept;
+
   // Destructor for the ArrayStack.
   ~SLLStack();
 
@@ -77,24 +90,52 @@ class SLLStack {
     Node *next;
   };
 
+  using NodeAllocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Node>;
+  using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+  // Methods for allocating and releasing nodes.
+  Node *CreateNode(T value);
+  void DestroyNode(Node *node) noexcept;
+
   /// <summary>
   /// Pointer to the top element of the stack.
   /// </summary>
   Node *top;
+
+  /// <summary>
+  /// Allocator that provides memory for the nodes.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS NodeAllocator node_allocator;
+
+  /// <summary>
+  /// Statistics of the stack, empty unless ALGLIB_ENABLE_STATS is defined.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS detail::StatsRecorder stats;
 };
 
 /// <summary>
 /// Constructor for the Node structure. Sets up the initial values for the node.
 /// </summary>
 /// <param name="data"> value that will be stored in node.</param>
-template <typename T>
-SLLStack<T>::Node::Node(T data) : data(data), next(nullptr) {}
+template <typename T, typename Allocator>
+SLLStack<T, Allocator>::Node::Node(T data)
+    : data(std::move(data)), next(nullptr) {}
 
 /// <summary>
 /// Constructor for the SLLStack. Initializes the top pointer to nullptr.
 /// </summary>
-template <typename T>
-SLLStack<T>::SLLStack() : top(nullptr) {}
+template <typename T, typename Allocator>
+SLLStack<T, Allocator>::SLLStack() : top(nullptr), node_allocator() {}
+
+/// <summary>
+/// Constructor for the SLLStack that takes nodes from a given allocator.
+/// Initializes the top pointer to nullptr.
+/// </summary>
+/// <param name="allocator"> allocator used for the nodes.</param>
+template <typename T, typename Allocator>
+SLLStack<T, Allocator>::SLLStack(const Allocator &allocator)
+    : top(nullptr), node_allocator(allocator) {}
 
 /// <summary>
 /// Pushes a value to the top of the stack by creating a new node on the heap
@@ -102,9 +143,9 @@ SLLStack<T>::SLLStack() : top(nullptr) {}
 /// to the new node.
 /// </summary>
 /// <param name="val"> value to be pushed on the stack.</param>
-template <typename T>
-void SLLStack<T>::Push(T val) noexcept {
-  Node *new_node{new Node(val)};
+template <typename T, typename Allocator>
+void SLLStack<T, Allocator>::Push(T val) noexcept {
+  Node *new_node{CreateNode(val)};
   new_node->next = top;
   top = new_node;
 }
@@ -114,15 +155,15 @@ void SLLStack<T>::Push(T val) noexcept {
 /// deleted.
 /// </summary>
 /// <returns> value on top of the stack.</returns>
-template <typename T>
-T SLLStack<T>::Pop() {
+template <typename T, typename Allocator>
+T SLLStack<T, Allocator>::Pop() {
   if (IsEmpty()) {
-    throw std::runtime_error(errors::kEmptyDeletion);
+    ALGLIB_THROW(std::runtime_error(errors::kEmptyDeletion));
   }
   T val{top->data};
   Node *tmp{top};
   top = top->next;
-  delete tmp;
+  DestroyNode(tmp);
   return val;
 }
 
@@ -130,20 +171,53 @@ T SLLStack<T>::Pop() {
 /// Returns value from the top of the stack without removing it.
 /// </summary>
 /// <returns> value on top of the stack.</returns>
-template <typename T>
-T SLLStack<T>::Top() const {
+template <typename T, typename Allocator>
+T SLLStack<T, Allocator>::Top() const {
   if (IsEmpty()) {
-    throw std::runtime_error(errors::kPeekAtEmpty);
+    ALGLIB_THROW(std::runtime_error(errors::kPeekAtEmpty));
   }
   return top->data;
 }
 
+/// <summary>
+/// Moves the value from the top of the stack into a given object and deletes
+/// the top node, unless the stack is empty.
+/// </summary>
+/// <param name="val"> object the top value is moved into.</param>
+/// <returns> true if a value was popped, false if the stack is empty.</returns>
+template <typename T, typename Allocator>
+bool SLLStack<T, Allocator>::TryPop(T &val) {
+  if (IsEmpty()) {
+    return false;
+  }
+  val = std::move(top->data);
+  Node *tmp{top};
+  top = top->next;
+  DestroyNode(tmp);
+  return true;
+}
+
+/// <summary>
+/// Copies the value from the top of the stack into a given object unless the
+/// stack is empty.
+/// </summary>
+/// <param name="val"> object the top value is copied into.</param>
+/// <returns> true if a value was copied, false if the stack is empty.</returns>
+template <typename T, typename Allocator>
+bool SLLStack<T, Allocator>::TryTop(T &val) const {
+  if (IsEmpty()) {
+    return false;
+  }
+  val = top->data;
+  return true;
+}
+
 /// <summary>
 /// Checks if the stack is empty by checking if the top pointer is nullptr.
 /// </summary>
 /// <returns>true if empty, false if not.</returns>
-template <typename T>
-bool SLLStack<T>::IsEmpty() const noexcept {
+template <typename T, typename Allocator>
+bool SLLStack<T, Allocator>::IsEmpty() const noexcept {
   return top == nullptr;
 }
 
@@ -151,8 +225,8 @@ bool SLLStack<T>::IsEmpty() const noexcept {
 /// Calculates size of the stack by traversing the list and counting the nodes.
 /// </summary>
 /// <returns>amount values on stack.</returns>
-template <typename T>
-size_t SLLStack<T>::Size() const noexcept {
+template <typename T, typename Allocator>
+size_t SLLStack<T, Allocator>::Size() const noexcept {
   size_t count{};
   Node *tmp{top};
   while (tmp) {
@@ -162,19 +236,72 @@ size_t SLLStack<T>::Size() const noexcept {
   return count;
 }
 
+/// <summary>
+/// Returns statistics of the stack. It records allocated and released nodes
+/// and the biggest number of nodes held at once. Without ALGLIB_ENABLE_STATS
+/// all counters are zero.
+/// </summary>
+/// <returns> statistics of the stack.</returns>
+template <typename T, typename Allocator>
+ContainerStats SLLStack<T, Allocator>::GetStats() const noexcept {
+  return stats.Get();
+}
+
 /// <summary>
 /// Removes all nodes from the stack by traversing the list and deleting each.
 /// </summary>
-template <typename T>
-SLLStack<T>::~SLLStack() {
+template <typename T, typename Allocator>
+SLLStack<T, Allocator>::~SLLStack() {
   Node *tmp{top};
   while (tmp) {
     Node *next{tmp->next};
-    delete tmp;
+    DestroyNode(tmp);
     tmp = next;
   }
 }
 
+/// <summary>
+/// Obtains memory for a new node from the node allocator and constructs the
+/// node with a given value.
+/// </summary>
+/// <param name="value"> value that will be stored in the node.</param>
+/// <returns> pointer to the new node.</returns>
+template <typename T, typename Allocator>
+typename SLLStack<T, Allocator>::Node *
+SLLStack<T, Allocator>::CreateNode(T value) {
+  Node *node{NodeTraits::allocate(node_allocator, 1)};
+  ALGLIB_TRY {
+    NodeTraits::construct(node_allocator, node, std::move(value));
+  } ALGLIB_CATCH_ALL {
+    NodeTraits::deallocate(node_allocator, node, 1);
+    ALGLIB_RETHROW;
+  }
+  stats.NodeAllocation();
+  return node;
+}
+
+/// <summary>
+/// Destroys a node and returns its memory to the node allocator.
+/// </summary>
+/// <param name="node"> node created with CreateNode.</param>
+template <typename T, typename Allocator>
+void SLLStack<T, Allocator>::DestroyNode(Node *node) noexcept {
+  NodeTraits::destroy(node_allocator, node);
+  NodeTraits::deallocate(node_allocator, node, 1);
+  stats.Deallocation();
+}
+
+/// <summary>
+/// Aliases for containers that take memory from a std::pmr::memory_resource.
+/// </summary>
+namespace pmr {
+
+template <typename T>
+using SLLStack =
+    alglib::SLLStack<T, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
 }  // namespace alglib
 
 #endif  // ALGLIB_INCLUDE_LISTSTACK_H_
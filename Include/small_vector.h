@@ -0,0 +1,1175 @@
+//*****************************************************************************
+// The MIT License (MIT)
+//
+// Copyright � 2024 Piotr Walczak
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the �Software�), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED �AS IS�, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//*****************************************************************************
+
+//*****************************************************************************
+// File: small_vector.h
+//
+// This file contains the implementation of the SmallVector class.
+// Implementation is based on templates, so the class can be used with any
+// type. SmallVector has the same interface as Vector, but it keeps up to N
+// elements inside the object itself. Memory is allocated on the heap only
+// when the size exceeds N, so small vectors don't allocate at all.
+//*****************************************************************************
+
+#ifndef ALGLIB_INCLUDE_SMALLVECTOR_H_
+#define ALGLIB_INCLUDE_SMALLVECTOR_H_
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "constants.h"
+#include "growth_policy.h"
+#include "stats.h"
+#include "vector.h"
+
+/// <summary>
+/// Default namespace for the AlgLib library.
+/// </summary>
+namespace alglib {
+
+/// <summary>
+/// Vector that stores up to N elements in an inline buffer and spills to heap
+/// memory obtained from the allocator once the size exceeds N. It provides the
+/// same methods and iterators as Vector, so both types can be swapped without
+/// changing the code that uses them.
+/// </summary>
+/// <typeparam name="T"> type of data stored in vector.</typeparam>
+/// <typeparam name="N"> amount of elements stored inline.</typeparam>
+/// <typeparam name="Allocator"> allocator used to obtain heap memory for
+/// elements.</typeparam>
+/// <typeparam name="Growth"> policy that calculates new capacity when the
+/// vector runs out of memory.</typeparam>
+template <typename T, size_t N, typename Allocator = std::allocator<T>,
+          typename Growth = DoublingGrowth>
+class SmallVector {
+  static_assert(N > 0, "SmallVector needs space for at least one element.");
+  static_assert(GrowthPolicy<Growth>,
+                "Growth has to satisfy the GrowthPolicy concept.");
+
+public:
+  using Iterator = VectorIter<T>;
+  using IteratorRef = VectorIter<T> &;
+
+  using ConstIterator = ConstVectorIter<T>;
+  using ConstIteratorRef = ConstVectorIter<T> &;
+
+  using ReverseIterator = ReverseVectorIter<T>;
+  using ReverseIteratorRef = ReverseVectorIter<T> &;
+
+  using ConstReverseIterator = ConstReverseVectorIter<T>;
+  using ConstReverseIteratorRef = ConstReverseVectorIter<T> &;
+
+public:
+  // Constructors for small vector class.
+  SmallVector() noexcept;
+  explicit SmallVector(const Allocator &allocator,
+                       const Growth &growth = Growth()) noexcept;
+  SmallVector(size_t elements, const Allocator &allocator = Allocator());
+  SmallVector(size_t elements, const T &value,
+              const Allocator &allocator = Allocator());
+  SmallVector(const SmallVector &other);
+  SmallVector(SmallVector &&other) noexcept(
+      std::is_nothrow_move_constructible_v<T>);
+
+  // Copy and move assignment operators.
+  SmallVector &operator=(const SmallVector &other);
+  SmallVector &operator=(SmallVector &&other);
+
+  // Inserting and removing elements from the vector.
+  void Push(const T &value);
+  void Push(T &&value);
+  template <typename... Args> T &Emplace(Args &&...args);
+  void Insert(const T &value, size_t index);
+  void Insert(T &&value, size_t index);
+  template <typename... Args> T &EmplaceAt(size_t index, Args &&...args);
+  T Pop();
+
+  // Appending whole ranges at once.
+  template <std::input_iterator InputIt>
+  void Append(InputIt first, InputIt last);
+  void Append(std::span<const T> values);
+
+  // Accessing elements in the vector.
+  T &At(size_t index);
+  const T &At(size_t index) const;
+
+  // Getting size and capacity of the vector.
+  size_t Size() const noexcept;
+  size_t Capacity() const noexcept;
+  bool IsInline() const noexcept;
+
+  // Getting allocator and growth policy of the vector.
+  Allocator GetAllocator() const noexcept;
+  Growth GetGrowthPolicy() const noexcept;
+
+  // Getting statistics of the vector.
+  ContainerStats GetStats() const noexcept;
+
+  // Resizing, reserving and shrinking the vector.
+  void Resize(size_t new_size);
+  void Resize(size_t new_size, const T &value);
+  void Reserve(size_t amount);
+  void Clear() noexcept;
+  void ShrinkToFit();
+
+  // Getting first and last element of the vector.
+  T &Front();
+  const T &Front() const;
+  T &Back();
+  const T &Back() const;
+
+  // Accessing underlying contiguous memory.
+  T *Data() noexcept;
+  const T *Data() const noexcept;
+  std::span<T> AsSpan() noexcept;
+  std::span<const T> AsSpan() const noexcept;
+  operator std::span<T>() noexcept;
+  operator std::span<const T>() const noexcept;
+
+  // Iterators
+  Iterator begin() noexcept;
+  Iterator end() noexcept;
+  ConstIterator begin() const noexcept;
+  ConstIterator end() const noexcept;
+  ConstIterator cbegin() const noexcept;
+  ConstIterator cend() const noexcept;
+  ReverseIterator rbegin() noexcept;
+  ReverseIterator rend() noexcept;
+  ConstReverseIterator crbegin() const noexcept;
+  ConstReverseIterator crend() const noexcept;
+  Iterator Begin() noexcept;
+  Iterator End() noexcept;
+  ConstIterator ConstBegin() const noexcept;
+  ConstIterator ConstEnd() const noexcept;
+  ReverseIterator ReverseBegin() noexcept;
+  ReverseIterator ReverseEnd() noexcept;
+  ConstReverseIterator ConstReverseBegin() const noexcept;
+  ConstReverseIterator ConstReverseEnd() const noexcept;
+
+  ~SmallVector() noexcept;
+
+private:
+  using AllocatorTraits = std::allocator_traits<Allocator>;
+
+  // Method that moves elements to a block that fits a given amount.
+  void Reallocate(size_t amount);
+
+  // Method that moves elements between two raw memory blocks.
+  void Relocate(T *source, size_t count, T *destination);
+
+  // Method that calculates capacity needed to fit additional elements.
+  size_t GrownCapacity(size_t additional) const;
+
+  // Method that constructs elements at the end until the size is reached.
+  template <typename... Args>
+  void Extend(size_t new_size, const Args &...args);
+
+  // Methods that manage memory and construct elements through allocator.
+  T *InlineData() noexcept;
+  T *Allocate(size_t amount);
+  void Deallocate(T *block, size_t amount) noexcept;
+  template <typename... Args> void Construct(T *slot, Args &&...args);
+  void Destroy(T *first, size_t count) noexcept;
+  void Release() noexcept;
+  void TakeFrom(SmallVector &other);
+
+  /// <summary>
+  /// Amount of elements in the vector.
+  /// </summary>
+  size_t size;
+  /// <summary>
+  /// Maximum capacity of the vector. It is never smaller than N.
+  /// </summary>
+  size_t capacity;
+
+  /// <summary>
+  /// Pointer to the elements. It points to the inline buffer until the size
+  /// exceeds N and to heap memory afterwards.
+  /// </summary>
+  T *data;
+
+  /// <summary>
+  /// Allocator that provides heap memory for the elements.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS Allocator allocator;
+
+  /// <summary>
+  /// Policy that calculates new capacity when the vector grows. It belongs to
+  /// the vector object, so assignments don't change it.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS Growth growth;
+
+  /// <summary>
+  /// Statistics of the vector, empty unless ALGLIB_ENABLE_STATS is defined.
+  /// Like the growth policy, they belong to the vector object.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS detail::StatsRecorder stats;
+
+  /// <summary>
+  /// Raw inline storage for the first N elements.
+  /// </summary>
+  alignas(T) std::byte inline_storage[N * sizeof(T)];
+};
+
+/// <summary>
+/// No argument constructor for the small vector class. The vector uses its
+/// inline buffer and doesn't allocate any memory.
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+SmallVector<T, N, Allocator, Growth>::SmallVector() noexcept
+    : size(0), capacity(N), data(InlineData()), allocator(), growth() {}
+
+/// <summary>
+/// Constructor that initializes the vector with a given allocator and growth
+/// policy. The allocator will only be used once the size exceeds N.
+/// </summary>
+/// <param name="allocator"> allocator used by the vector.</param>
+/// <param name="growth"> growth policy used by the vector.</param>
+template <typename T, size_t N, typename Allocator, typename Growth>
+SmallVector<T, N, Allocator, Growth>::SmallVector(
+    const Allocator &allocator, const Growth &growth) noexcept
+    : size(0), capacity(N), data(InlineData()), allocator(allocator),
+      growth(growth) {}
+
+/// <summary>
+/// Constructor that reserves memory for a given number of elements. Memory is
+/// allocated only if the amount of elements exceeds N.
+/// </summary>
+/// <param name="elements"> amount of elements that will be initially
+/// reserved.</param>
+/// <param name="allocator"> allocator used by the vector.</param>
+template <typename T, size_t N, typename Allocator, typename Growth>
+SmallVector<T, N, Allocator, Growth>::SmallVector(
+    size_t elements, const Allocator &allocator)
+    : SmallVector(allocator) {
+  Reallocate(elements);
+}
+
+/// <summary>
+/// Constructor that initializes the vector to a given number of elements with a
+/// given value.
+/// </summary>
+/// <param name="elements"> amount of elements.</param>
+/// <param name="value"> value that all the elements will be
+/// initialised to.</param>
+/// <param name="allocator"> allocator used by the vector.</param>
+template <typename T, size_t N, typename Allocator, typename Growth>
+SmallVector<T, N, Allocator, Growth>::SmallVector(
+    size_t elements, const T &value, const Allocator &allocator)
+    : SmallVector(allocator) {
+  Reallocate(elements);
+  for (; size < elements; ++size) {
+    Construct(data + size, value);
+  }
+  stats.Size(size);
+}
+
+/// <summary>
+/// Copy constructor. Elements are stored inline if they fit.
+/// </summary>
+/// <param name="other"> vector that will be copied.</param>
+template <typename T, size_t N, typename Allocator, typename Growth>
+SmallVector<T, N, Allocator, Growth>::SmallVector(const SmallVector &other)
+    : SmallVector(AllocatorTraits::select_on_container_copy_construction(
+                      other.allocator),
+                  other.growth) {
+  Append(other.data, other.data + other.size);
+}
+
+/// <summary>
+/// Move constructor. Heap memory of the other vector is taken over, inline
+/// elements have to be moved one by one. The other vector is left empty.
+/// </summary>
+/// <param name="other"> vector that will be moved from.</param>
+template <typename T, size_t N, typename Allocator, typename Growth>
+SmallVector<T, N, Allocator, Growth>::SmallVector(SmallVector &&other) noexcept(
+    std::is_nothrow_move_constructible_v<T>)
+    : SmallVector(other.allocator, other.growth) {
+  TakeFrom(other);
+}
+
+/// <summary>
+/// Copy assignment operator. Current elements are destroyed and copies of the
+/// other vector's elements are constructed in their place.
+/// </summary>
+/// <param name="other"> vector that will be copied.</param>
+/// <returns> reference to this vector.</returns>
+template <typename T, size_t N, typename Allocator, typename Growth>
+SmallVector<T, N, Allocator, Growth> &
+SmallVector<T, N, Allocator, Growth>::operator=(const SmallVector &other) {
+  if (this != &other) {
+    Destroy(data, size);
+    size = 0;
+    if constexpr (AllocatorTraits::propagate_on_container_copy_assignment::
+                      value) {
+      Release();
+      allocator = other.allocator;
+    }
+    Append(other.data, other.data + other.size);
+  }
+  return *this;
+}
+
+/// <summary>
+/// Move assignment operator. Current elements are released and the elements of
+/// the other vector are taken over. Heap memory is shared only if allocators
+/// allow it, otherwise elements are moved one by one.
+/// </summary>
+/// <param name="other"> vector that will be moved from.</param>
+/// <returns> reference to this vector.</returns>
+template <typename T, size_t N, typename Allocator, typename Growth>
+SmallVector<T, N, Allocator, Growth> &
+SmallVector<T, N, Allocator, Growth>::operator=(SmallVector &&other) {
+  if (this != &other) {
+    Release();
+    if constexpr (AllocatorTraits::propagate_on_container_move_assignment::
+                      value) {
+      allocator = std::move(other.allocator);
+    }
+    TakeFrom(other);
+  }
+  return *this;
+}
+
+/// <summary>
+/// Adds a copy of the value to the end of the vector. If the size exceeds the
+/// capacity, the capacity is grown by the growth policy.
+/// </summary>
+/// <param name="value"> value to be added.</param>
+template <typename T, size_t N, typename Allocator, typename Growth>
+void SmallVector<T, N, Allocator, Growth>::Push(const T &value) {
+  Emplace(value);
+}
+
+/// <summary>
+/// Moves the value to the end of the vector. If the size exceeds the
+/// capacity, the capacity is grown by the growth policy.
+/// </summary>
+/// <param name="value"> value to be added.</param>
+template <typename T, size_t N, typename Allocator, typename Growth>
+void SmallVector<T, N, Allocator, Growth>::Push(T &&value) {
+  Emplace(std::move(value));
+}
+
+/// <summary>
+/// Constructs a new element in place at the end of the vector. When memory is
+/// reallocated, the new element is constructed before old elements are
+/// relocated, so the arguments may refer to elements of the same vector.
+/// </summary>
+/// <param name="args"> arguments passed to the constructor of T.</param>
+/// <returns> reference to the new element.</returns>
+template <typename T, size_t N, typename Allocator, typename Growth>
+template <typename... Args>
+T &SmallVector<T, N, Allocator, Growth>::Emplace(Args &&...args) {
+  if (size < capacity) {
+    Construct(data + size, std::forward<Args>(args)...);
+    stats.Size(size + 1);
+    return data[size++];
+  }
+  const size_t new_capacity{GrownCapacity(1)};
+  T *new_data{Allocate(new_capacity)};
+  ALGLIB_TRY {
+    Construct(new_data + size, std::forward<Args>(args)...);
+  } ALGLIB_CATCH_ALL {
+    Deallocate(new_data, new_capacity);
+    ALGLIB_RETHROW;
+  }
+  ALGLIB_TRY {
+    Relocate(data, size, new_data);
+  } ALGLIB_CATCH_ALL {
+    Destroy(new_data + size, 1);
+    Deallocate(new_data, new_capacity);
+    ALGLIB_RETHROW;
+  }
+  stats.Reallocation(size * sizeof(T));
+  Destroy(data, size);
+  if (!IsInline()) {
+    Deallocate(data, capacity);
+  }
+  data = new_data;
+  capacity = new_capacity;
+  stats.Size(size + 1);
+  return data[size++];
+}
+
+/// <summary>
+/// Inserts a copy of the value at a given index. If the index is out of
+/// range, an exception is thrown.
+/// </summary>
+/// <param name="value"> value to be inserted.</param>
+/// <param name="index"> inserting position.</param>
+template <typename T, size_t N, typename Allocator, typename Growth>
+void SmallVector<T, N, Allocator, Growth>::Insert(const T &value,
+                                                  size_t index) {
+  EmplaceAt(index, value);
+}
+
+/// <summary>
+/// Moves the value into a given index. If the index is out of range, an
+/// exception is thrown.
+/// </summary>
+/// <param name="value"> value to be inserted.</param>
+/// <param name="index"> inserting position.</param>
+template <typename T, size_t N, typename Allocator, typename Growth>
+void SmallVector<T, N, Allocator, Growth>::Insert(T &&value, size_t index) {
+  EmplaceAt(index, std::move(value));
+}
+
+/// <summary>
+/// Constructs a new element at a given index. If the index is out of range,
+/// an exception is thrown. Elements after the index are moved one slot to the
+/// right.
+/// </summary>
+/// <param name="index"> inserting position.</param>
+/// <param name="args"> arguments passed to the constructor of T.</param>
+/// <returns> reference to the new element.</returns>
+template <typename T, size_t N, typename Allocator, typename Growth>
+template <typename... Args>
+T &SmallVector<T, N, Allocator, Growth>::EmplaceAt(size_t index,
+                                                   Args &&...args) {
+  if (index > size) {
+    ALGLIB_THROW(std::runtime_error(errors::kIndexOutOfRange));
+  }
+  if (index == size) {
+    return Emplace(std::forward<Args>(args)...);
+  }
+  T value(std::forward<Args>(args)...);
+  if (size >= capacity) {
+    Reallocate(GrownCapacity(1));
+  }
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    std::memmove(static_cast<void *>(data + index + 1), data + index,
+                 (size - index) * sizeof(T));
+    Construct(data + index, std::move(value));
+  } else {
+    Construct(data + size, std::move(data[size - 1]));
+    std::move_backward(data + index, data + size - 1, data + size);
+    data[index] = std::move(value);
+  }
+  ++size;
+  stats.Size(size);
+  return data[index];
+}
+
+/// <summary>
+/// Returns the last element of the vector and removes it from the vector.
+/// If the vector is empty, an exception is thrown.
+/// </summary>
+/// <returns> last element of the vector.</returns>
+template <typename T, size_t N, typename Allocator, typename Growth>
+T SmallVector<T, N, Allocator, Growth>::Pop() {
+  if (size == 0) {
+    ALGLIB_THROW(std::runtime_error(errors::kEmptyDeletion));
+  }
+  T result(std::move(data[size - 1]));
+  Destroy(data + size - 1, 1);
+  --size;
+  return result;
+}
+
+/// <summary>
+/// Appends all elements from a range to the end of the vector. For forward
+/// ranges the capacity grows at most once. The range must not refer to
+/// elements of this vector.
+/// </summary>
+/// <param name="first"> iterator to the first element to append.</param>
+/// <param name="last"> iterator past the last element to append.</param>
+template <typename T, size_t N, typename Allocator, typename Growth>
+template <std::input_iterator InputIt>
+void SmallVector<T, N, Allocator, Growth>::Append(InputIt first, InputIt last) {
+  if constexpr (std::forward_iterator<InputIt>) {
+    const size_t count{static_cast<size_t>(std::distance(first, last))};
+    if (size + count > capacity) {
+      Reallocate(GrownCapacity(count));
+    }
+    const size_t old_size{size};
+    ALGLIB_TRY {
+      for (; first != last; ++first, ++size) {
+        Construct(data + size, *first);
+      }
+    } ALGLIB_CATCH_ALL {
+      Destroy(data + old_size, size - old_size);
+      size = old_size;
+      ALGLIB_RETHROW;
+    }
+    stats.Size(size);
+  } else {
+    for (; first != last; ++first) {
+      Emplace(*first);
+    }
+  }
+}
+
+/// <summary>
+/// Appends all elements from a span to the end of the vector.
+/// </summary>
+/// <param name="values"> elements to append.</param>
+template <typename T, size_t N, typename Allocator, typename Growth>
+void SmallVector<T, N, Allocator, Growth>::Append(std::span<const T> values) {
+  Append(values.begin(), values.end());
+}
+
+/// <summary>
+/// Returns the element at a given index. If the index is out of range, an
+/// exception is thrown.
+/// </summary>
+/// <param name="index"> index of element to return.</param>
+/// <returns> element at a given index.</returns>
+template <typename T, size_t N, typename Allocator, typename Growth>
+T &SmallVector<T, N, Allocator, Growth>::At(size_t index) {
+  if (index >= size) {
+    ALGLIB_THROW(std::runtime_error(errors::kIndexOutOfRange));
+  }
+  return data[index];
+}
+
+/// <summary>
+/// Returns the element at a given index. If the index is out of range, an
+/// exception is thrown.
+/// </summary>
+/// <param name="index"> index of element to return.</param>
+/// <returns> element at a given index.</returns>
+template <typename T, size_t N, typename Allocator, typename Growth>
+const T &SmallVector<T, N, Allocator, Growth>::At(size_t index) const {
+  if (index >= size) {
+    ALGLIB_THROW(std::runtime_error(errors::kIndexOutOfRange));
+  }
+  return data[index];
+}
+
+/// <summary>
+/// Return amount of elements in the vector.
+/// </summary>
+/// <returns> amount of elements in the vector.</returns>
+template <typename T, size_t N, typename Allocator, typename Growth>
+size_t SmallVector<T, N, Allocator, Growth>::Size() const noexcept {
+  return size;
+}
+
+/// <summary>
+/// Returns current maximum capacity of the vector. It is at least N.
+/// </summary>
+/// <returns> current maximum capacity of the vector.</returns>
+template <typename T, size_t N, typename Allocator, typename Growth>
+size_t SmallVector<T, N, Allocator, Growth>::Capacity() const noexcept {
+  return capacity;
+}
+
+/// <summary>
+/// Checks if the elements are stored in the inline buffer.
+/// </summary>
+/// <returns> true if no heap memory is used, false if not.</returns>
+template <typename T, size_t N, typename Allocator, typename Growth>
+bool SmallVector<T, N, Allocator, Growth>::IsInline() const noexcept {
+  return capacity == N;
+}
+
+/// <summary>
+/// Returns a copy of the allocator used by the vector.
+/// </summary>
+/// <returns> allocator of the vector.</returns>
+template <typename T, size_t N, typename Allocator, typename Growth>
+Allocator SmallVector<T, N, Allocator, Growth>::GetAllocator() const noexcept {
+  return allocator;
+}
+
+/// <summary>
+/// Returns a copy of the growth policy used by the vector.
+/// </summary>
+/// <returns> growth policy of the vector.</returns>
+template <typename T, size_t N, typename Allocator, typename Growth>
+Growth SmallVector<T, N, Allocator, Growth>::GetGrowthPolicy() const noexcept {
+  return growth;
+}
+
+/// <summary>
+/// Returns statistics of the vector. It records heap allocations and
+/// deallocations, reallocations with the bytes moved by them and the biggest
+/// size. Moving elements between the inline buffer and the heap counts as a
+/// reallocation. Without ALGLIB_ENABLE_STATS all counters are zero.
+/// </summary>
+/// <returns> statistics of the vector.</returns>
+template <typename T, size_t N, typename Allocator, typename Growth>
+ContainerStats SmallVector<T, N, Allocator, Growth>::GetStats() const noexcept {
+  return stats.Get();
+}
+
+/// <summary>
+/// Modifies the size of the vector. If the new size is smaller than the current
+/// size, the vector is truncated and the capacity is kept. If the new size is
+/// larger than the current size, the new elements are value initialized.
+/// </summary>
+/// <param name="new_size"> new size.</param>
+template <typename T, size_t N, typename Allocator, typename Growth>
+void SmallVector<T, N, Allocator, Growth>::Resize(size_t new_size) {
+  if (new_size <= size) {
+    Destroy(data + new_size, size - new_size);
+    size = new_size;
+    return;
+  }
+  Extend(new_size);
+}
+
+/// <summary>
+/// Modifies the size of the vector. If the new size is smaller than the current
+/// size, the vector is truncated and the capacity is kept. If the new size is
+/// larger than the current size, the new elements are copies of a given value.
+/// The value may refer to an element of the same vector.
+/// </summary>
+/// <param name="new_size"> new size.</param>
+/// <param name="value"> value that the new elements will be initialised
+/// to.</param>
+template <typename T, size_t N, typename Allocator, typename Growth>
+void SmallVector<T, N, Allocator, Growth>::Resize(size_t new_size,
+                                                  const T &value) {
+  if (new_size <= size) {
+    Destroy(data + new_size, size - new_size);
+    size = new_size;
+    return;
+  }
+  if (new_size > capacity) {
+    const T copy(value);
+    Extend(new_size, copy);
+  } else {
+    Extend(new_size, value);
+  }
+}
+
+/// <summary>
+/// Makes sure that the vector can hold a given amount of elements without
+/// reallocating. Capacity is never decreased, so the size is not changed.
+/// </summary>
+/// <param name="amount"> amount of elements to reserve memory for.</param>
+template <typename T, size_t N, typename Allocator, typename Growth>
+void SmallVector<T, N, Allocator, Growth>::Reserve(size_t amount) {
+  if (amount > capacity) {
+    Reallocate(amount);
+  }
+}
+
+/// <summary>
+/// Destroys all elements of the vector. Memory is kept, so the vector can be
+/// filled again without reallocating.
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+void SmallVector<T, N, Allocator, Growth>::Clear() noexcept {
+  Destroy(data, size);
+  size = 0;
+}
+
+/// <summary>
+/// Shrinks the capacity of the vector to the current size. If the elements fit
+/// in the inline buffer, they are moved back into it and heap memory is
+/// released.
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+void SmallVector<T, N, Allocator, Growth>::ShrinkToFit() {
+  Reallocate(size);
+}
+
+/// <summary>
+/// Returns the first element of the vector.
+/// </summary>
+/// <returns> first element of the vector.</returns>
+template <typename T, size_t N, typename Allocator, typename Growth>
+T &SmallVector<T, N, Allocator, Growth>::Front() {
+  return data[0];
+}
+
+/// <summary>
+/// Returns the first element of the vector.
+/// </summary>
+/// <returns> first element of the vector.</returns>
+template <typename T, size_t N, typename Allocator, typename Growth>
+const T &SmallVector<T, N, Allocator, Growth>::Front() const {
+  return data[0];
+}
+
+/// <summary>
+/// Returns the last element of the vector.
+/// </summary>
+/// <returns> last element of the vector.</returns>
+template <typename T, size_t N, typename Allocator, typename Growth>
+T &SmallVector<T, N, Allocator, Growth>::Back() {
+  return data[size - 1];
+}
+
+/// <summary>
+/// Returns the last element of the vector.
+/// </summary>
+/// <returns> last element of the vector.</returns>
+template <typename T, size_t N, typename Allocator, typename Growth>
+const T &SmallVector<T, N, Allocator, Growth>::Back() const {
+  return data[size - 1];
+}
+
+/// <summary>
+/// Destroys all live elements and returns heap memory to the allocator.
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+SmallVector<T, N, Allocator, Growth>::~SmallVector() noexcept {
+  Release();
+}
+
+/// <summary>
+/// Moves elements to a block that fits a given amount of elements. Amounts
+/// that fit in N use the inline buffer. If the new capacity is smaller than
+/// the current size, the size is truncated.
+/// </summary>
+/// <param name="amount"> new amount of elements.</param>
+template <typename T, size_t N, typename Allocator, typename Growth>
+void SmallVector<T, N, Allocator, Growth>::Reallocate(size_t amount) {
+  const size_t kept{amount < size ? amount : size};
+  const size_t new_capacity{amount < N ? N : amount};
+  if (new_capacity == capacity) {
+    Destroy(data + kept, size - kept);
+    size = kept;
+    return;
+  }
+  T *new_data{new_capacity == N ? InlineData() : Allocate(new_capacity)};
+  ALGLIB_TRY {
+    Relocate(data, kept, new_data);
+  } ALGLIB_CATCH_ALL {
+    if (new_capacity != N) {
+      Deallocate(new_data, new_capacity);
+    }
+    ALGLIB_RETHROW;
+  }
+  stats.Reallocation(kept * sizeof(T));
+  Destroy(data, size);
+  if (!IsInline()) {
+    Deallocate(data, capacity);
+  }
+  data = new_data;
+  size = kept;
+  capacity = new_capacity;
+}
+
+/// <summary>
+/// Constructs count elements in destination memory from the elements in
+/// source memory, using memcpy for trivially copyable types and
+/// std::move_if_noexcept for others. Source elements are not destroyed.
+/// </summary>
+/// <param name="source"> block with constructed elements.</param>
+/// <param name="count"> amount of elements to relocate.</param>
+/// <param name="destination"> raw block for the elements.</param>
+template <typename T, size_t N, typename Allocator, typename Growth>
+void SmallVector<T, N, Allocator, Growth>::Relocate(T *source, size_t count,
+                                                    T *destination) {
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    if (count != 0) {
+      std::memcpy(static_cast<void *>(destination), source, count * sizeof(T));
+    }
+  } else {
+    size_t constructed{};
+    ALGLIB_TRY {
+      for (; constructed < count; ++constructed) {
+        Construct(destination + constructed,
+                  std::move_if_noexcept(source[constructed]));
+      }
+    } ALGLIB_CATCH_ALL {
+      Destroy(destination, constructed);
+      ALGLIB_RETHROW;
+    }
+  }
+}
+
+/// <summary>
+/// Calculates the capacity needed to fit additional elements by asking the
+/// growth policy. Result is never smaller than the required amount.
+/// </summary>
+/// <param name="additional"> amount of elements that will be added.</param>
+/// <returns> new capacity of the vector.</returns>
+template <typename T, size_t N, typename Allocator, typename Growth>
+size_t SmallVector<T, N, Allocator, Growth>::GrownCapacity(
+    size_t additional) const {
+  const size_t required{size + additional};
+  const size_t grown{static_cast<size_t>(growth(capacity, required))};
+  return grown < required ? required : grown;
+}
+
+/// <summary>
+/// Constructs elements at the end of the vector until it reaches a given size.
+/// Memory is grown by the growth policy if needed. If any construction throws,
+/// the new elements are destroyed and the size is left unchanged.
+/// </summary>
+/// <param name="new_size"> size of the vector after extending, not smaller
+/// than the current size.</param>
+/// <param name="args"> arguments passed to the constructor of every new
+/// element, none for value initialization.</param>
+template <typename T, size_t N, typename Allocator, typename Growth>
+template <typename... Args>
+void SmallVector<T, N, Allocator, Growth>::Extend(size_t new_size,
+                                                  const Args &...args) {
+  if (new_size > capacity) {
+    Reallocate(GrownCapacity(new_size - size));
+  }
+  const size_t old_size{size};
+  ALGLIB_TRY {
+    for (; size < new_size; ++size) {
+      Construct(data + size, args...);
+    }
+  } ALGLIB_CATCH_ALL {
+    Destroy(data + old_size, size - old_size);
+    size = old_size;
+    ALGLIB_RETHROW;
+  }
+  stats.Size(size);
+}
+
+/// <summary>
+/// Returns pointer to the inline buffer.
+/// </summary>
+/// <returns> pointer to the first inline slot.</returns>
+template <typename T, size_t N, typename Allocator, typename Growth>
+T *SmallVector<T, N, Allocator, Growth>::InlineData() noexcept {
+  return reinterpret_cast<T *>(inline_storage);
+}
+
+/// <summary>
+/// Obtains heap memory for a given amount of elements from the allocator.
+/// </summary>
+/// <param name="amount"> amount of elements.</param>
+/// <returns> pointer to raw memory.</returns>
+template <typename T, size_t N, typename Allocator, typename Growth>
+T *SmallVector<T, N, Allocator, Growth>::Allocate(size_t amount) {
+  T *block{AllocatorTraits::allocate(allocator, amount)};
+  stats.Allocation();
+  return block;
+}
+
+/// <summary>
+/// Returns heap memory to the allocator.
+/// </summary>
+/// <param name="block"> memory obtained from Allocate.</param>
+/// <param name="amount"> amount of elements the block was allocated
+/// for.</param>
+template <typename T, size_t N, typename Allocator, typename Growth>
+void SmallVector<T, N, Allocator, Growth>::Deallocate(T *block,
+                                                      size_t amount) noexcept {
+  AllocatorTraits::deallocate(allocator, block, amount);
+  stats.Deallocation();
+}
+
+/// <summary>
+/// Constructs an element in raw memory through the allocator.
+/// </summary>
+/// <param name="slot"> raw memory for the element.</param>
+/// <param name="args"> arguments passed to the constructor of T.</param>
+template <typename T, size_t N, typename Allocator, typename Growth>
+template <typename... Args>
+void SmallVector<T, N, Allocator, Growth>::Construct(T *slot, Args &&...args) {
+  AllocatorTraits::construct(allocator, slot, std::forward<Args>(args)...);
+}
+
+/// <summary>
+/// Destroys a given amount of elements through the allocator.
+/// </summary>
+/// <param name="first"> first element to destroy.</param>
+/// <param name="count"> amount of elements to destroy.</param>
+template <typename T, size_t N, typename Allocator, typename Growth>
+void SmallVector<T, N, Allocator, Growth>::Destroy(T *first,
+                                                   size_t count) noexcept {
+  if constexpr (!std::is_trivially_destructible_v<T>) {
+    for (size_t i{}; i < count; ++i) {
+      AllocatorTraits::destroy(allocator, first + i);
+    }
+  }
+}
+
+/// <summary>
+/// Destroys all elements, releases heap memory and switches back to the
+/// inline buffer.
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+void SmallVector<T, N, Allocator, Growth>::Release() noexcept {
+  Destroy(data, size);
+  if (!IsInline()) {
+    Deallocate(data, capacity);
+  }
+  data = InlineData();
+  size = 0;
+  capacity = N;
+}
+
+/// <summary>
+/// Takes over the elements of other vector. This vector has to be empty and
+/// inline. Heap memory is taken over directly if the allocators are equal,
+/// otherwise elements are moved one by one. The other vector is left empty.
+/// </summary>
+/// <param name="other"> vector to take the elements from.</param>
+template <typename T, size_t N, typename Allocator, typename Growth>
+void SmallVector<T, N, Allocator, Growth>::TakeFrom(SmallVector &other) {
+  if (!other.IsInline() && allocator == other.allocator) {
+    data = other.data;
+    size = other.size;
+    capacity = other.capacity;
+    other.data = other.InlineData();
+    other.size = 0;
+    other.capacity = N;
+    return;
+  }
+  if (other.size > capacity) {
+    Reallocate(other.size);
+  }
+  Relocate(other.data, other.size, data);
+  size = other.size;
+  stats.Size(size);
+  other.Release();
+}
+
+/// <summary>
+/// Returns pointer to the first element of the vector.
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+T *SmallVector<T, N, Allocator, Growth>::Data() noexcept {
+  return data;
+}
+
+/// <summary>
+/// Returns pointer to the first element of the vector.
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+const T *SmallVector<T, N, Allocator, Growth>::Data() const noexcept {
+  return data;
+}
+
+/// <summary>
+/// Returns span that views all elements of the vector.
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+std::span<T> SmallVector<T, N, Allocator, Growth>::AsSpan() noexcept {
+  return std::span<T>(data, size);
+}
+
+/// <summary>
+/// Returns span that views all elements of the vector.
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+std::span<const T>
+SmallVector<T, N, Allocator, Growth>::AsSpan() const noexcept {
+  return std::span<const T>(data, size);
+}
+
+/// <summary>
+/// Converts the vector to a span that views all of its elements.
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+SmallVector<T, N, Allocator, Growth>::operator std::span<T>() noexcept {
+  return AsSpan();
+}
+
+/// <summary>
+/// Converts the vector to a span that views all of its elements.
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+SmallVector<T, N, Allocator, Growth>::operator std::span<const T>()
+    const noexcept {
+  return AsSpan();
+}
+
+/// <summary>
+/// Standard compliant function returning iterator object
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+typename SmallVector<T, N, Allocator, Growth>::Iterator
+SmallVector<T, N, Allocator, Growth>::begin() noexcept {
+  return Iterator(data);
+}
+
+/// <summary>
+/// Standard compliant function returning iterator object
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+typename SmallVector<T, N, Allocator, Growth>::Iterator
+SmallVector<T, N, Allocator, Growth>::end() noexcept {
+  return Iterator(data + size);
+}
+
+/// <summary>
+/// Standard compliant function returning iterator object
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+typename SmallVector<T, N, Allocator, Growth>::ConstIterator
+SmallVector<T, N, Allocator, Growth>::begin() const noexcept {
+  return ConstIterator(data);
+}
+
+/// <summary>
+/// Standard compliant function returning iterator object
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+typename SmallVector<T, N, Allocator, Growth>::ConstIterator
+SmallVector<T, N, Allocator, Growth>::end() const noexcept {
+  return ConstIterator(data + size);
+}
+
+/// <summary>
+/// Standard compliant function returning iterator object
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+typename SmallVector<T, N, Allocator, Growth>::ConstIterator
+SmallVector<T, N, Allocator, Growth>::cbegin() const noexcept {
+  return ConstIterator(data);
+}
+
+/// <summary>
+/// Standard compliant function returning iterator object
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+typename SmallVector<T, N, Allocator, Growth>::ConstIterator
+SmallVector<T, N, Allocator, Growth>::cend() const noexcept {
+  return ConstIterator(data + size);
+}
+
+/// <summary>
+/// Standard compliant function returning iterator object
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+typename SmallVector<T, N, Allocator, Growth>::ReverseIterator
+SmallVector<T, N, Allocator, Growth>::rbegin() noexcept {
+  return ReverseIterator(end());
+}
+
+/// <summary>
+/// Standard compliant function returning iterator object
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+typename SmallVector<T, N, Allocator, Growth>::ReverseIterator
+SmallVector<T, N, Allocator, Growth>::rend() noexcept {
+  return ReverseIterator(begin());
+}
+
+/// <summary>
+/// Standard compliant function returning iterator object
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+typename SmallVector<T, N, Allocator, Growth>::ConstReverseIterator
+SmallVector<T, N, Allocator, Growth>::crbegin() const noexcept {
+  return ConstReverseIterator(cend());
+}
+
+/// <summary>
+/// Standard compliant function returning iterator object
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+typename SmallVector<T, N, Allocator, Growth>::ConstReverseIterator
+SmallVector<T, N, Allocator, Growth>::crend() const noexcept {
+  return ConstReverseIterator(cbegin());
+}
+
+/// <summary>
+/// Wrapper around standard compliant function name
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+typename SmallVector<T, N, Allocator, Growth>::Iterator
+SmallVector<T, N, Allocator, Growth>::Begin() noexcept {
+  return begin();
+}
+
+/// <summary>
+/// Wrapper around standard compliant function name
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+typename SmallVector<T, N, Allocator, Growth>::Iterator
+SmallVector<T, N, Allocator, Growth>::End() noexcept {
+  return end();
+}
+
+/// <summary>
+/// Wrapper around standard compliant function name
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+typename SmallVector<T, N, Allocator, Growth>::ConstIterator
+SmallVector<T, N, Allocator, Growth>::ConstBegin() const noexcept {
+  return cbegin();
+}
+
+/// <summary>
+/// Wrapper around standard compliant function name
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+typename SmallVector<T, N, Allocator, Growth>::ConstIterator
+SmallVector<T, N, Allocator, Growth>::ConstEnd() const noexcept {
+  return cend();
+}
+
+/// <summary>
+/// Wrapper around standard compliant function name
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+typename SmallVector<T, N, Allocator, Growth>::ReverseIterator
+SmallVector<T, N, Allocator, Growth>::ReverseBegin() noexcept {
+  return rbegin();
+}
+
+/// <summary>
+/// Wrapper around standard compliant function name
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+typename SmallVector<T, N, Allocator, Growth>::ReverseIterator
+SmallVector<T, N, Allocator, Growth>::ReverseEnd() noexcept {
+  return rend();
+}
+
+/// <summary>
+/// Wrapper around standard compliant function name
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+typename SmallVector<T, N, Allocator, Growth>::ConstReverseIterator
+SmallVector<T, N, Allocator, Growth>::ConstReverseBegin() const noexcept {
+  return crbegin();
+}
+
+/// <summary>
+/// Wrapper around standard compliant function name
+/// </summary>
+template <typename T, size_t N, typename Allocator, typename Growth>
+typename SmallVector<T, N, Allocator, Growth>::ConstReverseIterator
+SmallVector<T, N, Allocator, Growth>::ConstReverseEnd() const noexcept {
+  return crend();
+}
+
+/// <summary>
+/// Aliases for containers that take memory from a std::pmr::memory_resource.
+/// </summary>
+namespace pmr {
+
+template <typename T, size_t N, typename Growth = DoublingGrowth>
+using SmallVector =
+    alglib::SmallVector<T, N, std::pmr::polymorphic_allocator<T>, Growth>;
+
+} // namespace pmr
+
+} // namespace alglib
+
+#endif // ALGLIB_INCLUDE_SMALLVECTOR_H_
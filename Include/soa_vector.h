@@ -0,0 +1,889 @@
+//*****************************************************************************
+// The MIT License (MIT)
+//
+// Copyright � 2024 Piotr Walczak
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the �Software�), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED �AS IS�, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//*****************************************************************************
+
+//*****************************************************************************
+// File: soa_vector.h
+//
+// This file contains SoAVector, a growable array of records stored as a
+// structure of arrays. Each field of the record lives in its own contiguous
+// column, so a pass that reads one field streams only that field through
+// the cache, and columns can be handed to the SIMD kernels as spans. Rows
+// are accessed through light proxies holding references to the fields. The
+// class is implemented in the alglib namespace.
+//*****************************************************************************
+
+#ifndef ALGLIB_INCLUDE_SOAVECTOR_H_
+#define ALGLIB_INCLUDE_SOAVECTOR_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "constants.h"
+#include "growth_policy.h"
+#include "stats.h"
+
+/// <summary>
+/// Default namespace for the AlgLib library.
+/// </summary>
+namespace alglib {
+
+/// <summary>
+/// Alignment of every column of SoAVector, one cache line, which is enough
+/// for aligned loads of any vector width up to 512 bits.
+/// </summary>
+inline constexpr size_t kColumnAlignment{64};
+
+/// <summary>
+/// Namespace for helpers of containers.
+/// </summary>
+namespace detail {
+
+/// <summary>
+/// Proxy for a single row of a SoAVector. It holds the vector and the index
+/// of the row, and gives references to the fields of the row. It supports
+/// structured bindings, which bind references to the fields.
+/// </summary>
+/// <typeparam name="Owner"> type of the vector, const qualified for a
+/// constant row.</typeparam>
+template <typename Owner>
+class SoARow {
+ public:
+  /// <summary>
+  /// Type of reference to a field of the row.
+  /// </summary>
+  template <size_t I>
+  using Reference =
+      std::conditional_t<std::is_const_v<Owner>,
+                         const typename Owner::template FieldType<I> &,
+                         typename Owner::template FieldType<I> &>;
+
+  SoARow(Owner *owner, size_t index) noexcept : owner(owner), index(index) {}
+
+  /// <summary>
+  /// Gets a field of the row.
+  /// </summary>
+  /// <typeparam name="I"> index of the field.</typeparam>
+  /// <returns> reference to the field.</returns>
+  template <size_t I>
+  Reference<I> Get() const noexcept {
+    return std::get<I>(owner->columns)[index];
+  }
+
+  /// <summary>
+  /// Gets a field of the row under the name used by structured bindings.
+  /// </summary>
+  template <size_t I>
+  Reference<I> get() const noexcept {
+    return Get<I>();
+  }
+
+  /// <summary>
+  /// Copies the fields of the row into a tuple.
+  /// </summary>
+  /// <returns> tuple of field values.</returns>
+  typename Owner::Record ToTuple() const {
+    return ToTuple(std::make_index_sequence<Owner::kFieldCount>());
+  }
+
+ private:
+  template <size_t... I>
+  typename Owner::Record ToTuple(std::index_sequence<I...>) const {
+    return typename Owner::Record(Get<I>()...);
+  }
+
+  /// <summary>
+  /// Vector holding the row.
+  /// </summary>
+  Owner *owner;
+  /// <summary>
+  /// Index of the row.
+  /// </summary>
+  size_t index;
+};
+
+/// <summary>
+/// Iterator over the rows of a SoAVector, which gives row proxies.
+/// </summary>
+/// <typeparam name="Owner"> type of the vector, const qualified for a
+/// constant iterator.</typeparam>
+template <typename Owner>
+class SoAIter {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = typename Owner::Record;
+  using difference_type = std::ptrdiff_t;
+  using reference = SoARow<Owner>;
+
+  SoAIter() noexcept = default;
+  SoAIter(Owner *owner, size_t index) noexcept
+      : owner(owner), index(index) {}
+
+  reference operator*() const noexcept { return reference(owner, index); }
+  SoAIter &operator++() noexcept {
+    ++index;
+    return *this;
+  }
+  SoAIter operator++(int) noexcept {
+    SoAIter tmp{*this};
+    ++index;
+    return tmp;
+  }
+  bool operator==(const SoAIter &other) const noexcept {
+    return index == other.index;
+  }
+
+ private:
+  /// <summary>
+  /// Vector being iterated.
+  /// </summary>
+  Owner *owner{nullptr};
+  /// <summary>
+  /// Index of the current row.
+  /// </summary>
+  size_t index{0};
+};
+
+}  // namespace detail
+
+/// <summary>
+/// Growable array of records with the fields stored in separate columns.
+/// Every column is aligned to kColumnAlignment and all columns share a
+/// single allocation, which is grown by the growth policy like the memory
+/// of Vector. Push appends a row, Pop removes the last row and returns its
+/// fields as a tuple, and Column gives a span over one field of all rows.
+/// Growing relocates every column, which invalidates spans, rows and
+/// iterators.
+/// </summary>
+/// <typeparam name="Growth"> policy that calculates new capacity when the
+/// vector runs out of memory.</typeparam>
+/// <typeparam name="Fields"> types of the fields of a record.</typeparam>
+template <typename Growth, typename... Fields>
+class BasicSoAVector {
+  static_assert(sizeof...(Fields) > 0, "A record needs at least one field.");
+  static_assert(GrowthPolicy<Growth>,
+                "Growth has to satisfy the GrowthPolicy concept.");
+
+ public:
+  /// <summary>
+  /// Number of fields of a record.
+  /// </summary>
+  static constexpr size_t kFieldCount{sizeof...(Fields)};
+
+  /// <summary>
+  /// Type of a given field.
+  /// </summary>
+  template <size_t I>
+  using FieldType = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+  using Record = std::tuple<Fields...>;
+  using Row = detail::SoARow<BasicSoAVector>;
+  using ConstRow = detail::SoARow<const BasicSoAVector>;
+  using Iterator = detail::SoAIter<BasicSoAVector>;
+  using ConstIterator = detail::SoAIter<const BasicSoAVector>;
+
+  // Constructors, assignment operators and destructor.
+  BasicSoAVector() noexcept = default;
+  explicit BasicSoAVector(const Growth &growth) noexcept;
+  BasicSoAVector(const BasicSoAVector &other);
+  BasicSoAVector(BasicSoAVector &&other) noexcept;
+  BasicSoAVector &operator=(const BasicSoAVector &other);
+  BasicSoAVector &operator=(BasicSoAVector &&other) noexcept;
+  ~BasicSoAVector();
+
+  // Inserting and removing rows.
+  void Push(const Fields &...values);
+  template <typename... Args>
+    requires(sizeof...(Args) == sizeof...(Fields))
+  Row Emplace(Args &&...args);
+  Record Pop();
+
+  // Accessing rows and columns.
+  Row operator[](size_t index) noexcept;
+  ConstRow operator[](size_t index) const noexcept;
+  Row At(size_t index);
+  ConstRow At(size_t index) const;
+  template <size_t I>
+  std::span<FieldType<I>> Column() noexcept;
+  template <size_t I>
+  std::span<const FieldType<I>> Column() const noexcept;
+
+  // Getting size and capacity of the vector.
+  size_t Size() const noexcept;
+  size_t Capacity() const noexcept;
+  bool IsEmpty() const noexcept;
+
+  // Getting statistics of the vector.
+  ContainerStats GetStats() const noexcept;
+
+  // Reserving, clearing and shrinking the vector.
+  void Reserve(size_t amount);
+  void Clear() noexcept;
+  void ShrinkToFit();
+
+  // Iterators
+  Iterator begin() noexcept;
+  Iterator end() noexcept;
+  ConstIterator begin() const noexcept;
+  ConstIterator end() const noexcept;
+
+ private:
+  template <typename Owner>
+  friend class detail::SoARow;
+
+  using Columns = std::tuple<Fields *...>;
+
+  // Alignment of the block and of every column in it.
+  static constexpr size_t kAlignment{
+      std::max({kColumnAlignment, alignof(Fields)...})};
+  // Whether relocation moves the rows. It is decided for whole rows, since
+  // a column that was already moved from can't be restored when a later
+  // one throws.
+  static constexpr bool kMoveRows{
+      (std::is_nothrow_move_constructible_v<Fields> && ...)};
+
+  // Methods that lay out and obtain memory for the columns.
+  static size_t BlockBytes(size_t amount) noexcept;
+  static Columns Layout(std::byte *block, size_t amount) noexcept;
+  std::byte *Allocate(size_t amount);
+  void Deallocate(std::byte *block, size_t amount) noexcept;
+  void Reallocate(size_t amount);
+  size_t GrownCapacity(size_t additional) const;
+
+  // Methods that construct and destroy elements of the columns.
+  template <size_t I, bool kMove>
+  static void TransferColumns(const Columns &source, const Columns &target,
+                              size_t count);
+  template <size_t... I, typename... Args>
+  void ConstructRow(std::index_sequence<I...>, size_t index, Args &&...args);
+  template <size_t... I>
+  void DestroyRows(std::index_sequence<I...>, size_t first,
+                   size_t count) noexcept;
+  template <size_t... I>
+  Record TakeRow(std::index_sequence<I...>, size_t index);
+
+  /// <summary>
+  /// Single block holding all columns.
+  /// </summary>
+  std::byte *block{nullptr};
+  /// <summary>
+  /// Pointers to the first element of every column inside the block.
+  /// </summary>
+  Columns columns{};
+  /// <summary>
+  /// Number of rows in the vector.
+  /// </summary>
+  size_t size{0};
+  /// <summary>
+  /// Number of rows that fit in the block.
+  /// </summary>
+  size_t capacity{0};
+
+  /// <summary>
+  /// Policy that calculates new capacity when the vector runs out of memory.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS Growth growth;
+  /// <summary>
+  /// Statistics of the vector, empty unless ALGLIB_ENABLE_STATS is defined.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS detail::StatsRecorder stats;
+};
+
+/// <summary>
+/// SoAVector growing by doubling its capacity, like Vector by default.
+/// </summary>
+template <typename... Fields>
+using SoAVector = BasicSoAVector<DoublingGrowth, Fields...>;
+
+/// <summary>
+/// Constructor with a given growth policy.
+/// </summary>
+/// <param name="growth"> growth policy of the vector.</param>
+template <typename Growth, typename... Fields>
+BasicSoAVector<Growth, Fields...>::BasicSoAVector(
+    const Growth &growth) noexcept
+    : growth(growth) {}
+
+/// <summary>
+/// Copy constructor. Each column is copied as a whole, trivially copyable
+/// ones with a single memcpy.
+/// </summary>
+/// <param name="other"> vector to be copied.</param>
+template <typename Growth, typename... Fields>
+BasicSoAVector<Growth, Fields...>::BasicSoAVector(
+    const BasicSoAVector &other)
+    : growth(other.growth) {
+  if (other.size == 0) return;
+  std::byte *new_block{Allocate(other.size)};
+  const Columns new_columns{Layout(new_block, other.size)};
+  ALGLIB_TRY {
+    TransferColumns<0, false>(other.columns, new_columns, other.size);
+  }
+  ALGLIB_CATCH_ALL {
+    Deallocate(new_block, other.size);
+    ALGLIB_RETHROW;
+  }
+  block = new_block;
+  columns = new_columns;
+  size = other.size;
+  capacity = other.size;
+  stats.Size(size);
+}
+
+/// <summary>
+/// Move constructor. The block of the other vector is taken over and the
+/// other vector is left empty.
+/// </summary>
+/// <param name="other"> vector to be moved.</param>
+template <typename Growth, typename... Fields>
+BasicSoAVector<Growth, Fields...>::BasicSoAVector(
+    BasicSoAVector &&other) noexcept
+    : block(std::exchange(other.block, nullptr)),
+      columns(std::exchange(other.columns, Columns{})),
+      size(std::exchange(other.size, 0)),
+      capacity(std::exchange(other.capacity, 0)), growth(other.growth) {}
+
+/// <summary>
+/// Copy assignment operator. Rows of the other vector are copied into a new
+/// block, so this vector is unchanged if a copy throws.
+/// </summary>
+/// <param name="other"> vector to be copied.</param>
+/// <returns> reference to this vector.</returns>
+template <typename Growth, typename... Fields>
+BasicSoAVector<Growth, Fields...> &
+BasicSoAVector<Growth, Fields...>::operator=(const BasicSoAVector &other) {
+  if (this != &other) {
+    BasicSoAVector copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+/// <summary>
+/// Move assignment operator. Rows of this vector are destroyed and the block
+/// of the other vector is taken over.
+/// </summary>
+/// <param name="other"> vector to be moved.</param>
+/// <returns> reference to this vector.</returns>
+template <typename Growth, typename... Fields>
+BasicSoAVector<Growth, Fields...> &
+BasicSoAVector<Growth, Fields...>::operator=(
+    BasicSoAVector &&other) noexcept {
+  if (this != &other) {
+    Clear();
+    Deallocate(block, capacity);
+    block = std::exchange(other.block, nullptr);
+    columns = std::exchange(other.columns, Columns{});
+    size = std::exchange(other.size, 0);
+    capacity = std::exchange(other.capacity, 0);
+    growth = other.growth;
+  }
+  return *this;
+}
+
+/// <summary>
+/// Destructor. Destroys all rows and releases the block.
+/// </summary>
+template <typename Growth, typename... Fields>
+BasicSoAVector<Growth, Fields...>::~BasicSoAVector() {
+  Clear();
+  Deallocate(block, capacity);
+}
+
+/// <summary>
+/// Appends a row with copies of given field values. If the size exceeds the
+/// capacity, the capacity is grown.
+/// </summary>
+/// <param name="values"> values of the fields.</param>
+template <typename Growth, typename... Fields>
+void BasicSoAVector<Growth, Fields...>::Push(const Fields &...values) {
+  Emplace(values...);
+}
+
+/// <summary>
+/// Appends a row, constructing every field from its own argument. If the
+/// size exceeds the capacity, the capacity is grown. When memory is
+/// reallocated, the fields are built before the columns move, so the
+/// arguments may refer to rows of the same vector. If a field constructor
+/// throws, the fields built before it are destroyed and the size is
+/// unchanged.
+/// </summary>
+/// <param name="args"> one argument for the constructor of every
+/// field.</param>
+/// <returns> proxy for the new row.</returns>
+template <typename Growth, typename... Fields>
+template <typename... Args>
+  requires(sizeof...(Args) == sizeof...(Fields))
+typename BasicSoAVector<Growth, Fields...>::Row
+BasicSoAVector<Growth, Fields...>::Emplace(Args &&...args) {
+  if (size < capacity) {
+    ConstructRow(std::index_sequence_for<Fields...>(), size,
+                 std::forward<Args>(args)...);
+  } else {
+    Record values(std::forward<Args>(args)...);
+    Reallocate(GrownCapacity(1));
+    std::apply(
+        [this](Fields &...fields) {
+          ConstructRow(std::index_sequence_for<Fields...>(), size,
+                       std::move(fields)...);
+        },
+        values);
+  }
+  stats.Size(size + 1);
+  return Row(this, size++);
+}
+
+/// <summary>
+/// Removes the last row and returns its fields. If the vector is empty, an
+/// exception is thrown.
+/// </summary>
+/// <returns> fields of the last row.</returns>
+/// <exception cref="std::runtime_error"> thrown when the vector is
+/// empty.</exception>
+template <typename Growth, typename... Fields>
+typename BasicSoAVector<Growth, Fields...>::Record
+BasicSoAVector<Growth, Fields...>::Pop() {
+  if (size == 0) {
+    ALGLIB_THROW(std::runtime_error(errors::kEmptyDeletion));
+  }
+  Record result{TakeRow(std::index_sequence_for<Fields...>(), size - 1)};
+  DestroyRows(std::index_sequence_for<Fields...>(), size - 1, 1);
+  --size;
+  return result;
+}
+
+/// <summary>
+/// Gets a row without checking the index.
+/// </summary>
+/// <param name="index"> index of the row.</param>
+/// <returns> proxy for the row.</returns>
+template <typename Growth, typename... Fields>
+typename BasicSoAVector<Growth, Fields...>::Row
+BasicSoAVector<Growth, Fields...>::operator[](size_t index) noexcept {
+  return Row(this, index);
+}
+
+/// <summary>
+/// Gets a constant row without checking the index.
+/// </summary>
+/// <param name="index"> index of the row.</param>
+/// <returns> proxy for the row.</returns>
+template <typename Growth, typename... Fields>
+typename BasicSoAVector<Growth, Fields...>::ConstRow
+BasicSoAVector<Growth, Fields...>::operator[](size_t index) const noexcept {
+  return ConstRow(this, index);
+}
+
+/// <summary>
+/// Gets a row. If the index is out of range, an exception is thrown.
+/// </summary>
+/// <param name="index"> index of the row.</param>
+/// <returns> proxy for the row.</returns>
+/// <exception cref="std::runtime_error"> thrown when the index is out of
+/// range.</exception>
+template <typename Growth, typename... Fields>
+typename BasicSoAVector<Growth, Fields...>::Row
+BasicSoAVector<Growth, Fields...>::At(size_t index) {
+  if (index >= size) {
+    ALGLIB_THROW(std::runtime_error(errors::kIndexOutOfRange));
+  }
+  return Row(this, index);
+}
+
+/// <summary>
+/// Gets a constant row. If the index is out of range, an exception is
+/// thrown.
+/// </summary>
+/// <param name="index"> index of the row.</param>
+/// <returns> proxy for the row.</returns>
+/// <exception cref="std::runtime_error"> thrown when the index is out of
+/// range.</exception>
+template <typename Growth, typename... Fields>
+typename BasicSoAVector<Growth, Fields...>::ConstRow
+BasicSoAVector<Growth, Fields...>::At(size_t index) const {
+  if (index >= size) {
+    ALGLIB_THROW(std::runtime_error(errors::kIndexOutOfRange));
+  }
+  return ConstRow(this, index);
+}
+
+/// <summary>
+/// Gets one field of all rows as a contiguous span, which starts at an
+/// address aligned to kColumnAlignment. It can be passed directly to the
+/// SIMD kernels.
+/// </summary>
+/// <typeparam name="I"> index of the field.</typeparam>
+/// <returns> span over the column.</returns>
+template <typename Growth, typename... Fields>
+template <size_t I>
+std::span<typename BasicSoAVector<Growth, Fields...>::template FieldType<I>>
+BasicSoAVector<Growth, Fields...>::Column() noexcept {
+  return {std::get<I>(columns), size};
+}
+
+/// <summary>
+/// Gets one field of all rows as a contiguous constant span.
+/// </summary>
+/// <typeparam name="I"> index of the field.</typeparam>
+/// <returns> span over the column.</returns>
+template <typename Growth, typename... Fields>
+template <size_t I>
+std::span<
+    const typename BasicSoAVector<Growth, Fields...>::template FieldType<I>>
+BasicSoAVector<Growth, Fields...>::Column() const noexcept {
+  return {std::get<I>(columns), size};
+}
+
+/// <summary>
+/// Gets the number of rows.
+/// </summary>
+/// <returns> number of rows.</returns>
+template <typename Growth, typename... Fields>
+size_t BasicSoAVector<Growth, Fields...>::Size() const noexcept {
+  return size;
+}
+
+/// <summary>
+/// Gets the number of rows that fit without growing.
+/// </summary>
+/// <returns> capacity of the vector.</returns>
+template <typename Growth, typename... Fields>
+size_t BasicSoAVector<Growth, Fields...>::Capacity() const noexcept {
+  return capacity;
+}
+
+/// <summary>
+/// Checks if the vector has no rows.
+/// </summary>
+/// <returns> true if empty, false if not.</returns>
+template <typename Growth, typename... Fields>
+bool BasicSoAVector<Growth, Fields...>::IsEmpty() const noexcept {
+  return size == 0;
+}
+
+/// <summary>
+/// Gets the statistics recorded by the vector. All counters are zero unless
+/// ALGLIB_ENABLE_STATS is defined.
+/// </summary>
+/// <returns> snapshot of the statistics.</returns>
+template <typename Growth, typename... Fields>
+ContainerStats BasicSoAVector<Growth, Fields...>::GetStats() const noexcept {
+  return stats.Get();
+}
+
+/// <summary>
+/// Makes room for a given number of rows. Memory is reallocated only if the
+/// amount is greater than the current capacity.
+/// </summary>
+/// <param name="amount"> number of rows.</param>
+template <typename Growth, typename... Fields>
+void BasicSoAVector<Growth, Fields...>::Reserve(size_t amount) {
+  if (amount > capacity) Reallocate(amount);
+}
+
+/// <summary>
+/// Destroys all rows. The capacity is kept.
+/// </summary>
+template <typename Growth, typename... Fields>
+void BasicSoAVector<Growth, Fields...>::Clear() noexcept {
+  DestroyRows(std::index_sequence_for<Fields...>(), 0, size);
+  size = 0;
+}
+
+/// <summary>
+/// Reduces the capacity to the number of rows.
+/// </summary>
+template <typename Growth, typename... Fields>
+void BasicSoAVector<Growth, Fields...>::ShrinkToFit() {
+  if (capacity > size) Reallocate(size);
+}
+
+/// <summary>
+/// Returns iterator to the first row.
+/// </summary>
+/// <returns> iterator to the first row.</returns>
+template <typename Growth, typename... Fields>
+typename BasicSoAVector<Growth, Fields...>::Iterator
+BasicSoAVector<Growth, Fields...>::begin() noexcept {
+  return Iterator(this, 0);
+}
+
+/// <summary>
+/// Returns iterator past the last row.
+/// </summary>
+/// <returns> iterator past the last row.</returns>
+template <typename Growth, typename... Fields>
+typename BasicSoAVector<Growth, Fields...>::Iterator
+BasicSoAVector<Growth, Fields...>::end() noexcept {
+  return Iterator(this, size);
+}
+
+/// <summary>
+/// Returns constant iterator to the first row.
+/// </summary>
+/// <returns> iterator to the first row.</returns>
+template <typename Growth, typename... Fields>
+typename BasicSoAVector<Growth, Fields...>::ConstIterator
+BasicSoAVector<Growth, Fields...>::begin() const noexcept {
+  return ConstIterator(this, 0);
+}
+
+/// <summary>
+/// Returns constant iterator past the last row.
+/// </summary>
+/// <returns> iterator past the last row.</returns>
+template <typename Growth, typename... Fields>
+typename BasicSoAVector<Growth, Fields...>::ConstIterator
+BasicSoAVector<Growth, Fields...>::end() const noexcept {
+  return ConstIterator(this, size);
+}
+
+/// <summary>
+/// Calculates the size of a block for a given number of rows. Every column
+/// starts at a multiple of the alignment.
+/// </summary>
+/// <param name="amount"> number of rows.</param>
+/// <returns> size of the block in bytes.</returns>
+template <typename Growth, typename... Fields>
+size_t BasicSoAVector<Growth, Fields...>::BlockBytes(size_t amount) noexcept {
+  size_t bytes{};
+  ((bytes = (bytes + kAlignment - 1) / kAlignment * kAlignment +
+            amount * sizeof(Fields)),
+   ...);
+  return bytes;
+}
+
+/// <summary>
+/// Calculates the address of every column in a block.
+/// </summary>
+/// <param name="block"> block obtained from Allocate.</param>
+/// <param name="amount"> number of rows the block was allocated for.</param>
+/// <returns> pointers to the columns.</returns>
+template <typename Growth, typename... Fields>
+typename BasicSoAVector<Growth, Fields...>::Columns
+BasicSoAVector<Growth, Fields...>::Layout(std::byte *block,
+                                          size_t amount) noexcept {
+  size_t offset{};
+  auto place = [&](size_t field_bytes) {
+    offset = (offset + kAlignment - 1) / kAlignment * kAlignment;
+    std::byte *column{block + offset};
+    offset += amount * field_bytes;
+    return column;
+  };
+  return Columns{reinterpret_cast<Fields *>(place(sizeof(Fields)))...};
+}
+
+/// <summary>
+/// Obtains an aligned block for a given number of rows.
+/// </summary>
+/// <param name="amount"> number of rows.</param>
+/// <returns> pointer to raw memory or nullptr if amount is 0.</returns>
+template <typename Growth, typename... Fields>
+std::byte *BasicSoAVector<Growth, Fields...>::Allocate(size_t amount) {
+  if (amount == 0) return nullptr;
+  void *memory{
+      ::operator new(BlockBytes(amount), std::align_val_t(kAlignment))};
+  stats.Allocation();
+  return static_cast<std::byte *>(memory);
+}
+
+/// <summary>
+/// Releases a block obtained from Allocate.
+/// </summary>
+/// <param name="block"> block to be released.</param>
+/// <param name="amount"> number of rows the block was allocated for.</param>
+template <typename Growth, typename... Fields>
+void BasicSoAVector<Growth, Fields...>::Deallocate(std::byte *block,
+                                                   size_t amount) noexcept {
+  if (block) {
+    ::operator delete(block, BlockBytes(amount),
+                      std::align_val_t(kAlignment));
+    stats.Deallocation();
+  }
+}
+
+/// <summary>
+/// Moves all rows to a new block with a given capacity, column by column.
+/// Columns of trivially copyable fields are moved with a single memcpy.
+/// Rows are moved only if no field can throw while moving, otherwise every
+/// column is copied, so the vector is unchanged if a copy throws. If the
+/// capacity is smaller than the size, the rows that don't fit are
+/// destroyed.
+/// </summary>
+/// <param name="amount"> new capacity.</param>
+template <typename Growth, typename... Fields>
+void BasicSoAVector<Growth, Fields...>::Reallocate(size_t amount) {
+  std::byte *new_block{Allocate(amount)};
+  const Columns new_columns{Layout(new_block, amount)};
+  const size_t kept{amount < size ? amount : size};
+  ALGLIB_TRY { TransferColumns<0, kMoveRows>(columns, new_columns, kept); }
+  ALGLIB_CATCH_ALL {
+    Deallocate(new_block, amount);
+    ALGLIB_RETHROW;
+  }
+  if (block) stats.Reallocation(kept * (sizeof(Fields) + ...));
+  Clear();
+  Deallocate(block, capacity);
+  block = new_block;
+  columns = new_columns;
+  size = kept;
+  capacity = amount;
+}
+
+/// <summary>
+/// Calculates the capacity needed to fit additional rows by asking the
+/// growth policy.
+/// </summary>
+/// <param name="additional"> number of rows that will be added.</param>
+/// <returns> new capacity of the vector.</returns>
+template <typename Growth, typename... Fields>
+size_t BasicSoAVector<Growth, Fields...>::GrownCapacity(
+    size_t additional) const {
+  const size_t required{size + additional};
+  const size_t grown{static_cast<size_t>(growth(capacity, required))};
+  return grown < required ? required : grown;
+}
+
+/// <summary>
+/// Constructs the first count elements of the columns from the I-th one on
+/// in raw target memory, from the elements of source columns. Elements are
+/// moved if kMove is true, which the caller only sets when no move can
+/// throw, otherwise they are copied. If any construction throws, the
+/// constructed elements of all these columns are destroyed. Source elements
+/// are not destroyed.
+/// </summary>
+/// <param name="source"> columns with constructed elements.</param>
+/// <param name="target"> raw columns.</param>
+/// <param name="count"> number of elements per column.</param>
+template <typename Growth, typename... Fields>
+template <size_t I, bool kMove>
+void BasicSoAVector<Growth, Fields...>::TransferColumns(
+    const Columns &source, const Columns &target, size_t count) {
+  if constexpr (I < kFieldCount) {
+    using Field = FieldType<I>;
+    Field *from{std::get<I>(source)};
+    Field *to{std::get<I>(target)};
+    if constexpr (std::is_trivially_copyable_v<Field>) {
+      if (count != 0) {
+        std::memcpy(static_cast<void *>(to), from, count * sizeof(Field));
+      }
+    } else {
+      size_t constructed{};
+      ALGLIB_TRY {
+        for (; constructed < count; ++constructed) {
+          if constexpr (kMove) {
+            std::construct_at(to + constructed, std::move(from[constructed]));
+          } else {
+            std::construct_at(to + constructed,
+                              std::as_const(from[constructed]));
+          }
+        }
+      }
+      ALGLIB_CATCH_ALL {
+        std::destroy_n(to, constructed);
+        ALGLIB_RETHROW;
+      }
+    }
+    ALGLIB_TRY { TransferColumns<I + 1, kMove>(source, target, count); }
+    ALGLIB_CATCH_ALL {
+      std::destroy_n(to, count);
+      ALGLIB_RETHROW;
+    }
+  }
+}
+
+/// <summary>
+/// Constructs the fields of a row in raw memory, in field order. If a
+/// constructor throws, the fields constructed before it are destroyed.
+/// </summary>
+/// <param name="index"> index of the row.</param>
+/// <param name="args"> one argument for every field.</param>
+template <typename Growth, typename... Fields>
+template <size_t... I, typename... Args>
+void BasicSoAVector<Growth, Fields...>::ConstructRow(
+    std::index_sequence<I...>, size_t index, Args &&...args) {
+  size_t constructed{};
+  ALGLIB_TRY {
+    ((std::construct_at(std::get<I>(columns) + index,
+                        std::forward<Args>(args)),
+      ++constructed),
+     ...);
+  }
+  ALGLIB_CATCH_ALL {
+    ((I < constructed ? std::destroy_at(std::get<I>(columns) + index)
+                      : void()),
+     ...);
+    ALGLIB_RETHROW;
+  }
+}
+
+/// <summary>
+/// Destroys the fields of consecutive rows.
+/// </summary>
+/// <param name="first"> index of the first row.</param>
+/// <param name="count"> number of rows.</param>
+template <typename Growth, typename... Fields>
+template <size_t... I>
+void BasicSoAVector<Growth, Fields...>::DestroyRows(
+    std::index_sequence<I...>, size_t first, size_t count) noexcept {
+  (std::destroy_n(std::get<I>(columns) + first, count), ...);
+}
+
+/// <summary>
+/// Moves the fields of a row out into a tuple.
+/// </summary>
+/// <param name="index"> index of the row.</param>
+/// <returns> tuple of field values.</returns>
+template <typename Growth, typename... Fields>
+template <size_t... I>
+typename BasicSoAVector<Growth, Fields...>::Record
+BasicSoAVector<Growth, Fields...>::TakeRow(std::index_sequence<I...>,
+                                           size_t index) {
+  return Record(std::move(std::get<I>(columns)[index])...);
+}
+
+}  // namespace alglib
+
+/// <summary>
+/// Specializations that let structured bindings decompose rows of
+/// SoAVector into references to their fields.
+/// </summary>
+template <typename Owner>
+struct std::tuple_size<alglib::detail::SoARow<Owner>>
+    : std::integral_constant<size_t, Owner::kFieldCount> {};
+
+template <size_t I, typename Owner>
+struct std::tuple_element<I, alglib::detail::SoARow<Owner>> {
+  using type = typename alglib::detail::SoARow<Owner>::template Reference<I>;
+};
+
+#endif  // ALGLIB_INCLUDE_SOAVECTOR_H_
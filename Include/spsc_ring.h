@@ -0,0 +1,389 @@
+//*****************************************************************************
+// The MIT License (MIT)
+//
+// Copyright � 2024 Piotr Walczak
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the �Software�), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED �AS IS�, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//*****************************************************************************
+
+//*****************************************************************************
+// File: spsc_ring.h
+//
+// This file contains the implementation of the SpscRing class. It is a fixed
+// capacity ring buffer for handing elements from exactly one producer thread
+// to exactly one consumer thread without locks. Neither side ever waits for
+// the other, every operation finishes in a bounded number of steps. The
+// class is implemented in the alglib namespace.
+//*****************************************************************************
+
+#ifndef ALGLIB_INCLUDE_SPSCRING_H_
+#define ALGLIB_INCLUDE_SPSCRING_H_
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "constants.h"
+#include "stats.h"
+
+/// <summary>
+/// Default namespace for the AlgLib library.
+/// </summary>
+namespace alglib {
+
+/// <summary>
+/// SpscRing is a variant of CircularQueue for one producer and one consumer
+/// running in different threads. Capacity is a power of two, so positions
+/// are found by masking instead of division. Both indexes only grow and are
+/// kept on separate cache lines, and each side keeps its own copy of the
+/// other side's index, so shared memory is only read again when the copy
+/// says the ring is full or empty. Operations report full and empty rings
+/// through their return values instead of throwing.
+/// </summary>
+/// <typeparam name="T"> type that will be stored in ring.</typeparam>
+/// <typeparam name="capacity"> max capacity of ring, a power of
+/// two.</typeparam>
+template <typename T, size_t capacity>
+class SpscRing {
+  static_assert(std::has_single_bit(capacity),
+                "SpscRing capacity has to be a power of two.");
+
+ public:
+  // Constructors and assignment operators.
+  SpscRing() = default;
+  SpscRing(const SpscRing &) = delete;
+  SpscRing &operator=(const SpscRing &) = delete;
+
+  // Methods for checking state of the ring.
+  bool IsEmpty() const noexcept;
+  bool IsFull() const noexcept;
+  size_t Size() const noexcept;
+  static constexpr size_t Capacity() noexcept;
+
+  // Getting statistics of the ring.
+  ContainerStats GetStats() const noexcept;
+
+  // Methods used by the producer thread.
+  bool TryPush(const T &value);
+  bool TryPush(T &&value);
+  template <typename InputIt>
+  size_t PushN(InputIt first, size_t count);
+
+  // Methods used by the consumer thread.
+  bool TryPop(T &value);
+  template <typename OutputIt>
+  size_t PopN(OutputIt out, size_t count);
+
+  // Destructor for the ring.
+  ~SpscRing();
+
+ private:
+  /// <summary>
+  /// Mask turning an index into a position in the storage.
+  /// </summary>
+  static constexpr size_t kMask{capacity - 1};
+
+  // Methods for accessing the storage.
+  T *Slot(size_t index) noexcept;
+  template <typename Value>
+  bool Push(Value &&value);
+  size_t FreeSlots(size_t back, size_t wanted) noexcept;
+  size_t ReadySlots(size_t front, size_t wanted) noexcept;
+
+  // Method recording insertions of the producer.
+  void RecordPush(size_t back, size_t pushed, size_t wanted) noexcept;
+
+  /// <summary>
+  /// Index of the next element to pop. Written only by the consumer.
+  /// </summary>
+  alignas(64) std::atomic<size_t> head{0};
+  /// <summary>
+  /// Consumer's copy of the tail index, refreshed when the ring looks empty.
+  /// </summary>
+  size_t cached_tail{0};
+
+  /// <summary>
+  /// Index of the next free slot. Written only by the producer.
+  /// </summary>
+  alignas(64) std::atomic<size_t> tail{0};
+  /// <summary>
+  /// Producer's copy of the head index, refreshed when the ring looks full.
+  /// </summary>
+  size_t cached_head{0};
+  /// <summary>
+  /// Statistics of the ring, empty unless ALGLIB_ENABLE_STATS is defined.
+  /// Written only by the producer.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS detail::StatsRecorder stats;
+
+  /// <summary>
+  /// Memory for elements. Only slots between head and tail hold objects.
+  /// </summary>
+  alignas(std::max<size_t>(64, alignof(T)))
+      std::byte storage[capacity * sizeof(T)];
+};
+
+/// <summary>
+/// Checks if the ring holds no elements. Exact when called by the consumer,
+/// a snapshot when called by any other thread.
+/// </summary>
+/// <returns> true if empty, false if not.</returns>
+template <typename T, size_t capacity>
+bool SpscRing<T, capacity>::IsEmpty() const noexcept {
+  return Size() == 0;
+}
+
+/// <summary>
+/// Checks if the ring holds capacity elements. Exact when called by the
+/// producer, a snapshot when called by any other thread.
+/// </summary>
+/// <returns> true if full, false if not</returns>
+template <typename T, size_t capacity>
+bool SpscRing<T, capacity>::IsFull() const noexcept {
+  return Size() == capacity;
+}
+
+/// <summary>
+/// Gets the number of elements in the ring. Head is read first, so the
+/// difference can't go below zero while the other thread works.
+/// </summary>
+/// <returns> number of elements.</returns>
+template <typename T, size_t capacity>
+size_t SpscRing<T, capacity>::Size() const noexcept {
+  const size_t front{head.load(std::memory_order_acquire)};
+  const size_t back{tail.load(std::memory_order_acquire)};
+  return std::min(back - front, capacity);
+}
+
+/// <summary>
+/// Gets the max number of elements the ring can hold.
+/// </summary>
+/// <returns> capacity of the ring.</returns>
+template <typename T, size_t capacity>
+constexpr size_t SpscRing<T, capacity>::Capacity() noexcept {
+  return capacity;
+}
+
+/// <summary>
+/// Returns statistics of the ring. It records the biggest size seen by the
+/// producer after an insertion and the calls that couldn't insert every
+/// value because the ring was full. The ring never allocates. Without
+/// ALGLIB_ENABLE_STATS all counters are zero.
+/// </summary>
+/// <returns> statistics of the ring.</returns>
+template <typename T, size_t capacity>
+ContainerStats SpscRing<T, capacity>::GetStats() const noexcept {
+  return stats.Get();
+}
+
+/// <summary>
+/// Copies a value to the rear of the ring if there is a free slot.
+/// </summary>
+/// <param name="value"> value to be inserted into ring.</param>
+/// <returns> true if inserted, false if the ring was full.</returns>
+template <typename T, size_t capacity>
+bool SpscRing<T, capacity>::TryPush(const T &value) {
+  return Push(value);
+}
+
+/// <summary>
+/// Moves a value to the rear of the ring if there is a free slot. The value
+/// is left untouched when the ring is full.
+/// </summary>
+/// <param name="value"> value to be inserted into ring.</param>
+/// <returns> true if inserted, false if the ring was full.</returns>
+template <typename T, size_t capacity>
+bool SpscRing<T, capacity>::TryPush(T &&value) {
+  return Push(std::move(value));
+}
+
+/// <summary>
+/// Inserts up to count values from a range at the rear of the ring and makes
+/// them visible to the consumer at once.
+/// </summary>
+/// <param name="first"> iterator to the first value.</param>
+/// <param name="count"> number of values available in the range.</param>
+/// <returns> number of values inserted, less than count if the ring
+/// filled up.</returns>
+template <typename T, size_t capacity>
+template <typename InputIt>
+size_t SpscRing<T, capacity>::PushN(InputIt first, size_t count) {
+  const size_t back{tail.load(std::memory_order_relaxed)};
+  const size_t pushed{FreeSlots(back, count)};
+  size_t i{};
+  ALGLIB_TRY {
+    for (; i < pushed; ++i, ++first) {
+      std::construct_at(Slot(back + i), *first);
+    }
+  } ALGLIB_CATCH_ALL {
+    // Values constructed so far are handed over as if they were pushed.
+    tail.store(back + i, std::memory_order_release);
+    ALGLIB_RETHROW;
+  }
+  tail.store(back + pushed, std::memory_order_release);
+  RecordPush(back, pushed, count);
+  return pushed;
+}
+
+/// <summary>
+/// Moves the value from the front of the ring into given variable if the
+/// ring has an element.
+/// </summary>
+/// <param name="value"> variable that the element is moved into.</param>
+/// <returns> true if an element was removed, false if the ring was
+/// empty.</returns>
+template <typename T, size_t capacity>
+bool SpscRing<T, capacity>::TryPop(T &value) {
+  const size_t front{head.load(std::memory_order_relaxed)};
+  if (ReadySlots(front, 1) == 0) return false;
+  T *slot{Slot(front)};
+  value = std::move(*slot);
+  std::destroy_at(slot);
+  head.store(front + 1, std::memory_order_release);
+  return true;
+}
+
+/// <summary>
+/// Moves up to count elements from the front of the ring into an output
+/// iterator and frees their slots at once.
+/// </summary>
+/// <param name="out"> iterator the elements are written to.</param>
+/// <param name="count"> max number of elements to remove.</param>
+/// <returns> number of elements removed, less than count if the ring
+/// ran empty.</returns>
+template <typename T, size_t capacity>
+template <typename OutputIt>
+size_t SpscRing<T, capacity>::PopN(OutputIt out, size_t count) {
+  const size_t front{head.load(std::memory_order_relaxed)};
+  const size_t popped{ReadySlots(front, count)};
+  size_t i{};
+  ALGLIB_TRY {
+    for (; i < popped; ++i, ++out) {
+      T *slot{Slot(front + i)};
+      *out = std::move(*slot);
+      std::destroy_at(slot);
+    }
+  } ALGLIB_CATCH_ALL {
+    // The element that failed to move stays at the front of the ring.
+    head.store(front + i, std::memory_order_release);
+    ALGLIB_RETHROW;
+  }
+  head.store(front + popped, std::memory_order_release);
+  return popped;
+}
+
+/// <summary>
+/// Destructor for the ring destroying elements that weren't popped. No other
+/// thread may use the ring at this point.
+/// </summary>
+template <typename T, size_t capacity>
+SpscRing<T, capacity>::~SpscRing() {
+  const size_t back{tail.load(std::memory_order_acquire)};
+  for (size_t i{head.load(std::memory_order_relaxed)}; i != back; ++i) {
+    std::destroy_at(Slot(i));
+  }
+}
+
+/// <summary>
+/// Gets the storage slot for an index.
+/// </summary>
+/// <param name="index"> index of an element, not reduced to capacity.</param>
+/// <returns> pointer to the slot.</returns>
+template <typename T, size_t capacity>
+T *SpscRing<T, capacity>::Slot(size_t index) noexcept {
+  return std::launder(reinterpret_cast<T *>(storage) + (index & kMask));
+}
+
+/// <summary>
+/// Constructs a value in the slot at the tail and publishes it.
+/// </summary>
+/// <param name="value"> value to be inserted into ring.</param>
+/// <returns> true if inserted, false if the ring was full.</returns>
+template <typename T, size_t capacity>
+template <typename Value>
+bool SpscRing<T, capacity>::Push(Value &&value) {
+  const size_t back{tail.load(std::memory_order_relaxed)};
+  if (FreeSlots(back, 1) == 0) {
+    RecordPush(back, 0, 1);
+    return false;
+  }
+  std::construct_at(Slot(back), std::forward<Value>(value));
+  tail.store(back + 1, std::memory_order_release);
+  RecordPush(back, 1, 1);
+  return true;
+}
+
+/// <summary>
+/// Counts free slots for the producer. The head index is only loaded when
+/// the cached copy doesn't leave enough room.
+/// </summary>
+/// <param name="back"> current tail index.</param>
+/// <param name="wanted"> number of slots the producer needs.</param>
+/// <returns> number of slots that can be filled, at most wanted.</returns>
+template <typename T, size_t capacity>
+size_t SpscRing<T, capacity>::FreeSlots(size_t back, size_t wanted) noexcept {
+  size_t free{capacity - (back - cached_head)};
+  if (free < wanted) {
+    cached_head = head.load(std::memory_order_acquire);
+    free = capacity - (back - cached_head);
+  }
+  return std::min(free, wanted);
+}
+
+/// <summary>
+/// Counts elements ready for the consumer. The tail index is only loaded
+/// when the cached copy doesn't show enough elements.
+/// </summary>
+/// <param name="front"> current head index.</param>
+/// <param name="wanted"> number of elements the consumer needs.</param>
+/// <returns> number of elements that can be taken, at most wanted.</returns>
+template <typename T, size_t capacity>
+size_t SpscRing<T, capacity>::ReadySlots(size_t front,
+                                         size_t wanted) noexcept {
+  size_t ready{cached_tail - front};
+  if (ready < wanted) {
+    cached_tail = tail.load(std::memory_order_acquire);
+    ready = cached_tail - front;
+  }
+  return std::min(ready, wanted);
+}
+
+/// <summary>
+/// Records an insertion of the producer. The head index is only loaded when
+/// statistics are enabled, so that disabled statistics cost nothing.
+/// </summary>
+/// <param name="back"> tail index before the insertion.</param>
+/// <param name="pushed"> number of values inserted.</param>
+/// <param name="wanted"> number of values the producer tried to insert.</param>
+template <typename T, size_t capacity>
+void SpscRing<T, capacity>::RecordPush(size_t back, size_t pushed,
+                                       size_t wanted) noexcept {
+  if constexpr (kStatsEnabled) {
+    if (pushed < wanted) stats.Rejection();
+    stats.Size(back + pushed - head.load(std::memory_order_relaxed));
+  }
+}
+
+}  // namespace alglib
+
+#endif  // ALGLIB_INCLUDE_SPSCRING_H_
@@ -0,0 +1,539 @@
+//*****************************************************************************
+// The MIT License (MIT)
+//
+// Copyright � 2024 Piotr Walczak
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the �Software�), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED �AS IS�, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//*****************************************************************************
+
+//*****************************************************************************
+// File: stats.h
+//
+// This file contains optional instrumentation of the containers. When the
+// ALGLIB_ENABLE_STATS macro is defined before any library header is
+// included, containers count allocations, reallocations, moved bytes, their
+// peak size and rejected insertions, and return the counters from their
+// GetStats method. Without the macro the counters are empty objects and
+// recording them compiles to nothing. StatsRegistry collects the counters
+// of named containers for exporting. Everything is implemented in the
+// alglib namespace.
+//*****************************************************************************
+
+#ifndef ALGLIB_INCLUDE_STATS_H_
+#define ALGLIB_INCLUDE_STATS_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// Default namespace for the AlgLib library.
+/// </summary>
+namespace alglib {
+
+/// <summary>
+/// Tells whether containers were compiled with statistics. The macro has to
+/// be the same in every translation unit of a program, as it changes the
+/// layout of the containers.
+/// </summary>
+#ifdef ALGLIB_ENABLE_STATS
+constexpr bool kStatsEnabled{true};
+#else
+constexpr bool kStatsEnabled{false};
+#endif
+
+/// <summary>
+/// Counters of a single container. Each container documents which of them
+/// it records, the rest stay zero. A copied container starts with zeros.
+/// </summary>
+struct ContainerStats {
+  /// <summary>
+  /// Number of memory blocks or nodes obtained from the allocator.
+  /// </summary>
+  size_t allocations{};
+  /// <summary>
+  /// Number of memory blocks or nodes returned to the allocator.
+  /// </summary>
+  size_t deallocations{};
+  /// <summary>
+  /// Number of times elements were relocated to a new memory block.
+  /// </summary>
+  size_t reallocations{};
+  /// <summary>
+  /// Number of bytes of elements relocated by reallocations.
+  /// </summary>
+  size_t bytes_moved{};
+  /// <summary>
+  /// Biggest number of elements the container held at once.
+  /// </summary>
+  size_t high_water_mark{};
+  /// <summary>
+  /// Number of insertions refused because the container was full.
+  /// </summary>
+  size_t rejected{};
+};
+
+/// <summary>
+/// Namespace for helpers of containers.
+/// </summary>
+namespace detail {
+
+/// <summary>
+/// Recorder used when statistics are enabled. The container is its only
+/// writer, but the counters may be read by a registry on another thread, so
+/// they are atomics updated with plain relaxed loads and stores instead of
+/// read-modify-write instructions. Counting is skipped during constant
+/// evaluation.
+/// </summary>
+class EnabledStatsRecorder {
+ public:
+  // Constructors and assignment operators. Copies start from zero.
+  constexpr EnabledStatsRecorder() noexcept = default;
+  constexpr EnabledStatsRecorder(const EnabledStatsRecorder &) noexcept {}
+  constexpr EnabledStatsRecorder &operator=(
+      const EnabledStatsRecorder &) noexcept {
+    return *this;
+  }
+
+  // Methods recording events of the container.
+  constexpr void Allocation() noexcept;
+  constexpr void NodeAllocation() noexcept;
+  constexpr void Deallocation() noexcept;
+  constexpr void Reallocation(size_t bytes) noexcept;
+  constexpr void Size(size_t size) noexcept;
+  constexpr void Rejection() noexcept;
+
+  // Method reading the counters.
+  ContainerStats Get() const noexcept;
+
+ private:
+  // Method increasing a counter by a given amount.
+  static constexpr void Add(std::atomic<size_t> &counter,
+                            size_t amount) noexcept;
+
+  std::atomic<size_t> allocations{0};
+  std::atomic<size_t> deallocations{0};
+  std::atomic<size_t> reallocations{0};
+  std::atomic<size_t> bytes_moved{0};
+  std::atomic<size_t> high_water_mark{0};
+  std::atomic<size_t> rejected{0};
+};
+
+/// <summary>
+/// Recorder used when statistics are enabled in containers written by many
+/// threads at once. Counters are increased with relaxed read-modify-write
+/// instructions and the peak size is raised with a compare and swap loop, so
+/// no event is lost. It is only used by concurrent containers, which are not
+/// constant evaluated.
+/// </summary>
+class EnabledSharedStatsRecorder {
+ public:
+  // Constructors and assignment operators. Copies start from zero.
+  EnabledSharedStatsRecorder() noexcept = default;
+  EnabledSharedStatsRecorder(const EnabledSharedStatsRecorder &) noexcept {}
+  EnabledSharedStatsRecorder &operator=(
+      const EnabledSharedStatsRecorder &) noexcept {
+    return *this;
+  }
+
+  // Methods recording events of the container.
+  void Allocation() noexcept;
+  void NodeAllocation() noexcept;
+  void Deallocation() noexcept;
+  void Reallocation(size_t bytes) noexcept;
+  void Size(size_t size) noexcept;
+  void Rejection() noexcept;
+
+  // Method reading the counters.
+  ContainerStats Get() const noexcept;
+
+ private:
+  std::atomic<size_t> allocations{0};
+  std::atomic<size_t> deallocations{0};
+  std::atomic<size_t> reallocations{0};
+  std::atomic<size_t> bytes_moved{0};
+  std::atomic<size_t> high_water_mark{0};
+  std::atomic<size_t> rejected{0};
+};
+
+/// <summary>
+/// Recorder used when statistics are disabled. It is empty, and containers
+/// keep it as an ALGLIB_NO_UNIQUE_ADDRESS member, so it takes no space.
+/// </summary>
+class DisabledStatsRecorder {
+ public:
+  constexpr void Allocation() noexcept {}
+  constexpr void NodeAllocation() noexcept {}
+  constexpr void Deallocation() noexcept {}
+  constexpr void Reallocation(size_t) noexcept {}
+  constexpr void Size(size_t) noexcept {}
+  constexpr void Rejection() noexcept {}
+  ContainerStats Get() const noexcept { return {}; }
+};
+
+/// <summary>
+/// Recorder held by every instrumented container.
+/// </summary>
+using StatsRecorder = std::conditional_t<kStatsEnabled, EnabledStatsRecorder,
+                                         DisabledStatsRecorder>;
+
+/// <summary>
+/// Recorder held by every instrumented concurrent container.
+/// </summary>
+using SharedStatsRecorder =
+    std::conditional_t<kStatsEnabled, EnabledSharedStatsRecorder,
+                       DisabledStatsRecorder>;
+
+/// <summary>
+/// Records a block of memory obtained from the allocator.
+/// </summary>
+constexpr void EnabledStatsRecorder::Allocation() noexcept {
+  Add(allocations, 1);
+}
+
+/// <summary>
+/// Records a node obtained from the allocator. Nodes hold one element each,
+/// so their live count also gives the peak size.
+/// </summary>
+constexpr void EnabledStatsRecorder::NodeAllocation() noexcept {
+  Add(allocations, 1);
+  if (!std::is_constant_evaluated()) {
+    Size(allocations.load(std::memory_order_relaxed) -
+         deallocations.load(std::memory_order_relaxed));
+  }
+}
+
+/// <summary>
+/// Records a block of memory or a node returned to the allocator.
+/// </summary>
+constexpr void EnabledStatsRecorder::Deallocation() noexcept {
+  Add(deallocations, 1);
+}
+
+/// <summary>
+/// Records relocation of elements to a new memory block.
+/// </summary>
+/// <param name="bytes"> size of the relocated elements.</param>
+constexpr void EnabledStatsRecorder::Reallocation(size_t bytes) noexcept {
+  Add(reallocations, 1);
+  Add(bytes_moved, bytes);
+}
+
+/// <summary>
+/// Records the size of the container after an insertion.
+/// </summary>
+/// <param name="size"> current amount of elements.</param>
+constexpr void EnabledStatsRecorder::Size(size_t size) noexcept {
+  if (std::is_constant_evaluated()) return;
+  if (size > high_water_mark.load(std::memory_order_relaxed)) {
+    high_water_mark.store(size, std::memory_order_relaxed);
+  }
+}
+
+/// <summary>
+/// Records an insertion refused because the container was full.
+/// </summary>
+constexpr void EnabledStatsRecorder::Rejection() noexcept {
+  Add(rejected, 1);
+}
+
+/// <summary>
+/// Reads all counters.
+/// </summary>
+/// <returns> current values of the counters.</returns>
+inline ContainerStats EnabledStatsRecorder::Get() const noexcept {
+  return {allocations.load(std::memory_order_relaxed),
+          deallocations.load(std::memory_order_relaxed),
+          reallocations.load(std::memory_order_relaxed),
+          bytes_moved.load(std::memory_order_relaxed),
+          high_water_mark.load(std::memory_order_relaxed),
+          rejected.load(std::memory_order_relaxed)};
+}
+
+/// <summary>
+/// Increases a counter owned by a single writer.
+/// </summary>
+/// <param name="counter"> counter to increase.</param>
+/// <param name="amount"> value to add.</param>
+constexpr void EnabledStatsRecorder::Add(std::atomic<size_t> &counter,
+                                         size_t amount) noexcept {
+  if (std::is_constant_evaluated()) return;
+  counter.store(counter.load(std::memory_order_relaxed) + amount,
+                std::memory_order_relaxed);
+}
+
+/// <summary>
+/// Records a block of memory obtained from the allocator.
+/// </summary>
+inline void EnabledSharedStatsRecorder::Allocation() noexcept {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// <summary>
+/// Records a node obtained from the allocator. The live count is read from
+/// two counters that other threads may change in between, so the peak size
+/// is only approximate while the container is used concurrently.
+/// </summary>
+inline void EnabledSharedStatsRecorder::NodeAllocation() noexcept {
+  const size_t allocated{allocations.fetch_add(1, std::memory_order_relaxed) +
+                         1};
+  const size_t released{deallocations.load(std::memory_order_relaxed)};
+  if (allocated > released) Size(allocated - released);
+}
+
+/// <summary>
+/// Records a block of memory or a node returned to the allocator.
+/// </summary>
+inline void EnabledSharedStatsRecorder::Deallocation() noexcept {
+  deallocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// <summary>
+/// Records relocation of elements to a new memory block.
+/// </summary>
+/// <param name="bytes"> size of the relocated elements.</param>
+inline void EnabledSharedStatsRecorder::Reallocation(size_t bytes) noexcept {
+  reallocations.fetch_add(1, std::memory_order_relaxed);
+  bytes_moved.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+/// <summary>
+/// Records the size of the container after an insertion.
+/// </summary>
+/// <param name="size"> current amount of elements.</param>
+inline void EnabledSharedStatsRecorder::Size(size_t size) noexcept {
+  size_t peak{high_water_mark.load(std::memory_order_relaxed)};
+  while (size > peak && !high_water_mark.compare_exchange_weak(
+                            peak, size, std::memory_order_relaxed)) {
+  }
+}
+
+/// <summary>
+/// Records an insertion refused because the container was full.
+/// </summary>
+inline void EnabledSharedStatsRecorder::Rejection() noexcept {
+  rejected.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// <summary>
+/// Reads all counters.
+/// </summary>
+/// <returns> current values of the counters.</returns>
+inline ContainerStats EnabledSharedStatsRecorder::Get() const noexcept {
+  return {allocations.load(std::memory_order_relaxed),
+          deallocations.load(std::memory_order_relaxed),
+          reallocations.load(std::memory_order_relaxed),
+          bytes_moved.load(std::memory_order_relaxed),
+          high_water_mark.load(std::memory_order_relaxed),
+          rejected.load(std::memory_order_relaxed)};
+}
+
+}  // namespace detail
+
+/// <summary>
+/// Registry of named containers whose statistics can be read together, for
+/// example by a thread exporting metrics. Containers are registered by the
+/// user, and stay registered while the returned Registration lives. The
+/// container must outlive its registration and must not be moved while it
+/// is registered.
+/// </summary>
+class StatsRegistry {
+ public:
+  /// <summary>
+  /// Handle that keeps a container registered. Destroying it removes the
+  /// container from the registry.
+  /// </summary>
+  class Registration {
+   public:
+    // Constructors, assignment operators and destructor.
+    Registration() noexcept = default;
+    Registration(Registration &&other) noexcept;
+    Registration &operator=(Registration &&other) noexcept;
+    ~Registration();
+
+   private:
+    friend class StatsRegistry;
+
+    // Constructor used by the registry.
+    Registration(StatsRegistry *registry, uint64_t id) noexcept;
+
+    /// <summary>
+    /// Registry holding the entry, nullptr for an empty handle.
+    /// </summary>
+    StatsRegistry *registry{nullptr};
+    /// <summary>
+    /// Key of the entry in the registry.
+    /// </summary>
+    uint64_t id{0};
+  };
+
+  /// <summary>
+  /// Statistics of one registered container.
+  /// </summary>
+  struct Entry {
+    std::string name;
+    ContainerStats stats;
+  };
+
+  // Methods for managing registered containers.
+  template <typename Container>
+  [[nodiscard]] Registration Register(std::string name,
+                                      const Container &container);
+  std::vector<Entry> Snapshot() const;
+  size_t Count() const;
+
+  // Method for accessing the registry shared by the program.
+  static StatsRegistry &Global();
+
+ private:
+  // Method removing an entry, used by Registration.
+  void Unregister(uint64_t id) noexcept;
+
+  /// <summary>
+  /// Registered container with the function reading its counters.
+  /// </summary>
+  struct Source {
+    std::string name;
+    std::function<ContainerStats()> read;
+  };
+
+  /// <summary>
+  /// Mutex guarding the sources.
+  /// </summary>
+  mutable std::mutex mutex;
+  /// <summary>
+  /// Registered containers, in the order of registration.
+  /// </summary>
+  std::map<uint64_t, Source> sources;
+  /// <summary>
+  /// Key given to the next registered container.
+  /// </summary>
+  uint64_t next_id{1};
+};
+
+/// <summary>
+/// Constructor used by the registry.
+/// </summary>
+/// <param name="registry"> registry holding the entry.</param>
+/// <param name="id"> key of the entry.</param>
+inline StatsRegistry::Registration::Registration(StatsRegistry *registry,
+                                                 uint64_t id) noexcept
+    : registry(registry), id(id) {}
+
+/// <summary>
+/// Move constructor taking over the entry of another handle.
+/// </summary>
+/// <param name="other"> handle to be moved, left empty.</param>
+inline StatsRegistry::Registration::Registration(
+    Registration &&other) noexcept
+    : registry(std::exchange(other.registry, nullptr)), id(other.id) {}
+
+/// <summary>
+/// Move assignment operator removing the current entry and taking over the
+/// entry of another handle.
+/// </summary>
+/// <param name="other"> handle to be moved, left empty.</param>
+/// <returns> reference to this handle.</returns>
+inline StatsRegistry::Registration &StatsRegistry::Registration::operator=(
+    Registration &&other) noexcept {
+  if (this != &other) {
+    if (registry) registry->Unregister(id);
+    registry = std::exchange(other.registry, nullptr);
+    id = other.id;
+  }
+  return *this;
+}
+
+/// <summary>
+/// Destructor removing the entry from the registry.
+/// </summary>
+inline StatsRegistry::Registration::~Registration() {
+  if (registry) registry->Unregister(id);
+}
+
+/// <summary>
+/// Registers a container under a name. Any type with a GetStats method can
+/// be registered. Names don't have to be unique.
+/// </summary>
+/// <param name="name"> name reported with the statistics.</param>
+/// <param name="container"> container to be read.</param>
+/// <returns> handle keeping the container registered.</returns>
+template <typename Container>
+StatsRegistry::Registration StatsRegistry::Register(
+    std::string name, const Container &container) {
+  std::lock_guard<std::mutex> lock(mutex);
+  const uint64_t id{next_id++};
+  sources.emplace(id, Source{std::move(name), [&container] {
+                               return container.GetStats();
+                             }});
+  return Registration(this, id);
+}
+
+/// <summary>
+/// Reads the statistics of all registered containers.
+/// </summary>
+/// <returns> names and statistics, in the order of registration.</returns>
+inline std::vector<StatsRegistry::Entry> StatsRegistry::Snapshot() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  std::vector<Entry> entries;
+  entries.reserve(sources.size());
+  for (const auto &[id, source] : sources) {
+    entries.push_back({source.name, source.read()});
+  }
+  return entries;
+}
+
+/// <summary>
+/// Gets the number of registered containers.
+/// </summary>
+/// <returns> number of registered containers.</returns>
+inline size_t StatsRegistry::Count() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return sources.size();
+}
+
+/// <summary>
+/// Gets the registry shared by the program. It is never destroyed, so
+/// registrations in static objects can outlive it safely.
+/// </summary>
+/// <returns> reference to the global registry.</returns>
+inline StatsRegistry &StatsRegistry::Global() {
+  static StatsRegistry *registry{new StatsRegistry()};
+  return *registry;
+}
+
+/// <summary>
+/// Removes an entry from the registry.
+/// </summary>
+/// <param name="id"> key of the entry.</param>
+inline void StatsRegistry::Unregister(uint64_t id) noexcept {
+  std::lock_guard<std::mutex> lock(mutex);
+  sources.erase(id);
+}
+
+}  // namespace alglib
+
+#endif  // ALGLIB_INCLUDE_STATS_H_
@@ -0,0 +1,592 @@
+//*****************************************************************************
+// The MIT License (MIT)
+//
+// Copyright � 2024 Piotr Walczak
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the �Software�), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED �AS IS�, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//*****************************************************************************
+
+//*****************************************************************************
+// File: task_scheduler.h
+//
+// This file contains the implementation of the TaskScheduler and TaskGroup
+// classes. TaskScheduler runs small tasks on a set of worker threads that
+// each own a WorkStealingDeque: tasks spawned by a worker go to its own
+// deque, and idle workers steal from the deques of random others. TaskGroup
+// gives fork-join on top of it, and ParallelFor splits index ranges in half
+// recursively, so the work balances itself even when iterations differ in
+// cost. The classes are implemented in the alglib namespace.
+//*****************************************************************************
+
+#ifndef ALGLIB_INCLUDE_TASKSCHEDULER_H_
+#define ALGLIB_INCLUDE_TASKSCHEDULER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "concurrent_queue.h"
+#include "constants.h"
+#include "node_pool.h"
+#include "thread_pool.h"
+#include "work_stealing_deque.h"
+
+/// <summary>
+/// Default namespace for the AlgLib library.
+/// </summary>
+namespace alglib {
+
+class TaskGroup;
+
+/// <summary>
+/// Work-stealing scheduler with a fixed set of worker threads. Workers run
+/// their own newest tasks first, which keeps recently touched data in cache,
+/// and steal the oldest tasks of others, which are usually the biggest
+/// pieces of work. Tasks spawned from other threads go through a shared
+/// queue. Threads waiting for a TaskGroup run tasks in the meantime, so
+/// a scheduler without workers still makes progress. Task memory comes from
+/// the shared node pool.
+/// </summary>
+class TaskScheduler {
+ public:
+  // Constructors and destructor for the TaskScheduler.
+  explicit TaskScheduler(
+      size_t thread_count = ThreadPool::DefaultThreadCount());
+  TaskScheduler(const TaskScheduler &) = delete;
+  TaskScheduler &operator=(const TaskScheduler &) = delete;
+  ~TaskScheduler();
+
+  // Method for running loops on the scheduler.
+  template <typename Function>
+  void ParallelFor(size_t first, size_t last, Function function,
+                   size_t grain_size = 1);
+
+  // Methods for inspecting the scheduler.
+  size_t ThreadCount() const noexcept;
+
+  // Method for accessing the scheduler shared by the library.
+  static TaskScheduler &Default();
+
+ private:
+  friend class TaskGroup;
+
+  /// <summary>
+  /// Type erased task. Run executes the function, releases the task and
+  /// reports to the group.
+  /// </summary>
+  struct Task {
+    void (*run)(Task *task);
+    TaskGroup *group;
+  };
+
+  /// <summary>
+  /// Task holding a callable of a given type.
+  /// </summary>
+  template <typename Function>
+  struct FunctionTask : Task {
+    FunctionTask(TaskGroup *group, Function function);
+    static void Run(Task *task);
+
+    Function function;
+  };
+
+  /// <summary>
+  /// Worker thread with its deque of tasks.
+  /// </summary>
+  struct Worker {
+    explicit Worker(TaskScheduler *scheduler) noexcept;
+
+    TaskScheduler *scheduler;
+    WorkStealingDeque<Task *> deque;
+    std::thread thread;
+  };
+
+  /// <summary>
+  /// Number of times an idle worker looks for tasks before it goes to
+  /// sleep.
+  /// </summary>
+  static constexpr int kSpinCount{64};
+
+  // Methods for handing out tasks.
+  void Schedule(Task *task);
+  Task *FindTask(Worker *self) noexcept;
+  Worker *CurrentWorker() const noexcept;
+  static size_t NextRandom() noexcept;
+
+  // Methods for waiting.
+  void WorkerLoop(Worker *self);
+  void Wait(const TaskGroup &group) noexcept;
+  void Notify(bool all) noexcept;
+
+  // Method splitting ranges of ParallelFor.
+  template <typename Function>
+  static void SplitRange(TaskGroup &group, size_t first, size_t last,
+                         Function &function, size_t grain_size);
+
+  /// <summary>
+  /// Worker of a scheduler that runs on the current thread, if any.
+  /// </summary>
+  static inline thread_local Worker *current_worker{nullptr};
+
+  /// <summary>
+  /// Workers of the scheduler. Their deques are addressed by thieves, so
+  /// they are never moved.
+  /// </summary>
+  std::vector<std::unique_ptr<Worker>> workers;
+
+  /// <summary>
+  /// Tasks spawned from threads that aren't workers of this scheduler.
+  /// </summary>
+  ConcurrentQueue<Task *> injected;
+
+  /// <summary>
+  /// Counter increased whenever a task is scheduled, so that a sleeping
+  /// thread can tell whether something arrived since it last looked.
+  /// </summary>
+  std::atomic<uint64_t> epoch;
+
+  /// <summary>
+  /// Number of threads sleeping on the condition variable.
+  /// </summary>
+  std::atomic<size_t> sleepers;
+
+  /// <summary>
+  /// Mutex guarding the stopping flag and sleeping.
+  /// </summary>
+  std::mutex mutex;
+
+  /// <summary>
+  /// Condition variable used to wake up threads when tasks arrive or a
+  /// group finishes.
+  /// </summary>
+  std::condition_variable wake;
+
+  /// <summary>
+  /// Flag set by the destructor to make the workers exit.
+  /// </summary>
+  bool stopping;
+};
+
+/// <summary>
+/// Group of tasks that can be waited for together. Tasks may spawn more
+/// tasks into the same group. The first exception thrown by a task is
+/// rethrown by Wait. Destroying the group waits for its tasks.
+/// </summary>
+class TaskGroup {
+ public:
+  // Constructors and destructor for the TaskGroup.
+  explicit TaskGroup(TaskScheduler &scheduler = TaskScheduler::Default());
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup &operator=(const TaskGroup &) = delete;
+  ~TaskGroup();
+
+  // Methods for running tasks.
+  template <typename Function>
+  void Spawn(Function &&function);
+  void Wait();
+
+ private:
+  friend class TaskScheduler;
+
+  // Methods called by finished tasks.
+  void Fail(std::exception_ptr error) noexcept;
+  void Finish() noexcept;
+
+  /// <summary>
+  /// Scheduler that runs the tasks.
+  /// </summary>
+  TaskScheduler *scheduler;
+
+  /// <summary>
+  /// Number of spawned tasks that haven't finished yet.
+  /// </summary>
+  std::atomic<size_t> pending;
+
+  /// <summary>
+  /// Mutex guarding the exception.
+  /// </summary>
+  std::mutex mutex;
+
+  /// <summary>
+  /// First exception thrown by a task.
+  /// </summary>
+  std::exception_ptr exception;
+};
+
+/// <summary>
+/// Constructor for a task storing its callable.
+/// </summary>
+/// <param name="group"> group the task belongs to.</param>
+/// <param name="function"> callable to run.</param>
+template <typename Function>
+TaskScheduler::FunctionTask<Function>::FunctionTask(TaskGroup *group,
+                                                    Function function)
+    : Task{&FunctionTask::Run, group}, function(std::move(function)) {}
+
+/// <summary>
+/// Runs the callable of a task, then releases the task and tells the group
+/// it is finished. An exception is stored in the group.
+/// </summary>
+/// <param name="task"> task created by TaskGroup::Spawn.</param>
+template <typename Function>
+void TaskScheduler::FunctionTask<Function>::Run(Task *task) {
+  auto *self{static_cast<FunctionTask *>(task)};
+  TaskGroup *group{self->group};
+  ALGLIB_TRY {
+    self->function();
+  } ALGLIB_CATCH_ALL {
+    group->Fail(std::current_exception());
+  }
+  self->~FunctionTask();
+  NodePool::Shared().Deallocate(self, sizeof(FunctionTask),
+                                alignof(FunctionTask));
+  group->Finish();
+}
+
+/// <summary>
+/// Constructor for a worker.
+/// </summary>
+/// <param name="scheduler"> scheduler owning the worker.</param>
+inline TaskScheduler::Worker::Worker(TaskScheduler *scheduler) noexcept
+    : scheduler(scheduler) {}
+
+/// <summary>
+/// Constructor for the TaskScheduler. Starts a given amount of workers. The
+/// default leaves one hardware thread for the caller, which runs tasks while
+/// it waits.
+/// </summary>
+/// <param name="thread_count"> amount of worker threads.</param>
+inline TaskScheduler::TaskScheduler(size_t thread_count)
+    : epoch(0), sleepers(0), stopping(false) {
+  // Deques are created before any thread starts, as workers steal from all.
+  workers.reserve(thread_count);
+  for (size_t i{}; i < thread_count; ++i) {
+    workers.push_back(std::make_unique<Worker>(this));
+  }
+  for (std::unique_ptr<Worker> &worker : workers) {
+    worker->thread = std::thread([this, self = worker.get()] {
+      WorkerLoop(self);
+    });
+  }
+}
+
+/// <summary>
+/// Destructor for the TaskScheduler. All groups using it have to be finished
+/// before. Wakes the workers and joins them.
+/// </summary>
+inline TaskScheduler::~TaskScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (std::unique_ptr<Worker> &worker : workers) {
+    worker->thread.join();
+  }
+}
+
+/// <summary>
+/// Calls a function for every index in range [first, last) and waits until
+/// all calls finish. The range is halved until pieces have at most grain
+/// size indexes; one half is spawned as a task and the other is split
+/// further by the same thread, so idle workers always find big pieces to
+/// steal. First exception thrown by the function is rethrown.
+/// </summary>
+/// <param name="first"> first index.</param>
+/// <param name="last"> index past the last one.</param>
+/// <param name="function"> function taking an index.</param>
+/// <param name="grain_size"> max amount of indexes run by one task.</param>
+template <typename Function>
+void TaskScheduler::ParallelFor(size_t first, size_t last, Function function,
+                                size_t grain_size) {
+  if (first >= last) return;
+  TaskGroup group(*this);
+  SplitRange(group, first, last, function, std::max<size_t>(grain_size, 1));
+  group.Wait();
+}
+
+/// <summary>
+/// Method for getting amount of worker threads of the scheduler.
+/// </summary>
+/// <returns> amount of worker threads.</returns>
+inline size_t TaskScheduler::ThreadCount() const noexcept {
+  return workers.size();
+}
+
+/// <summary>
+/// Method for getting the scheduler shared by the whole library. It is
+/// created on first use and lives until the program exits.
+/// </summary>
+/// <returns> reference to the default scheduler.</returns>
+inline TaskScheduler &TaskScheduler::Default() {
+  static TaskScheduler scheduler;
+  return scheduler;
+}
+
+/// <summary>
+/// Puts a task where it will be found: the deque of the current worker, or
+/// the shared queue when called from any other thread.
+/// </summary>
+/// <param name="task"> task to be run.</param>
+inline void TaskScheduler::Schedule(Task *task) {
+  if (Worker *self{CurrentWorker()}) {
+    self->deque.Push(task);
+  } else {
+    injected.Enqueue(task);
+  }
+  Notify(false);
+}
+
+/// <summary>
+/// Looks for a task to run: the newest one of the current worker, then one
+/// from the shared queue, then the oldest one of the other workers starting
+/// from a random one.
+/// </summary>
+/// <param name="self"> worker of the current thread, or nullptr.</param>
+/// <returns> task to run, or nullptr if none was found.</returns>
+inline TaskScheduler::Task *TaskScheduler::FindTask(Worker *self) noexcept {
+  Task *task{nullptr};
+  if (self && self->deque.TryPop(task)) return task;
+  if (injected.TryDequeue(task)) return task;
+  const size_t count{workers.size()};
+  if (count == 0) return nullptr;
+  const size_t start{NextRandom() % count};
+  for (size_t i{}; i < count; ++i) {
+    Worker *victim{workers[(start + i) % count].get()};
+    if (victim != self && victim->deque.TrySteal(task)) return task;
+  }
+  return nullptr;
+}
+
+/// <summary>
+/// Gets the worker running on the calling thread if it belongs to this
+/// scheduler.
+/// </summary>
+/// <returns> worker of the current thread, or nullptr.</returns>
+inline TaskScheduler::Worker *TaskScheduler::CurrentWorker() const noexcept {
+  Worker *self{current_worker};
+  return self && self->scheduler == this ? self : nullptr;
+}
+
+/// <summary>
+/// Gets a pseudo random number used to pick victims of stealing, from a
+/// xorshift generator kept by every thread.
+/// </summary>
+/// <returns> pseudo random number.</returns>
+inline size_t TaskScheduler::NextRandom() noexcept {
+  static thread_local uint64_t state{
+      std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1};
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return static_cast<size_t>(state);
+}
+
+/// <summary>
+/// Loop executed by the workers. Runs tasks while there are any, looks for
+/// a while longer and then sleeps until a task is scheduled. The counter of
+/// scheduled tasks is read before the last look, so a task scheduled in
+/// between can't be missed.
+/// </summary>
+/// <param name="self"> worker running the loop.</param>
+inline void TaskScheduler::WorkerLoop(Worker *self) {
+  current_worker = self;
+  for (;;) {
+    Task *task{FindTask(self)};
+    for (int i{}; task == nullptr && i < kSpinCount; ++i) {
+      std::this_thread::yield();
+      task = FindTask(self);
+    }
+    if (task == nullptr) {
+      const uint64_t seen{epoch.load(std::memory_order_seq_cst)};
+      task = FindTask(self);
+      if (task == nullptr) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (stopping) return;
+        sleepers.fetch_add(1, std::memory_order_seq_cst);
+        wake.wait(lock, [this, seen] {
+          return stopping || epoch.load(std::memory_order_seq_cst) != seen;
+        });
+        sleepers.fetch_sub(1, std::memory_order_relaxed);
+        continue;
+      }
+    }
+    task->run(task);
+  }
+}
+
+/// <summary>
+/// Runs tasks until all tasks of a group finish. Workers keep looking for
+/// tasks, as their own deque may hold tasks of the group. Other threads
+/// sleep when there is nothing to run, until a task arrives or the group
+/// finishes.
+/// </summary>
+/// <param name="group"> group to wait for.</param>
+inline void TaskScheduler::Wait(const TaskGroup &group) noexcept {
+  Worker *self{CurrentWorker()};
+  while (group.pending.load(std::memory_order_acquire) != 0) {
+    const uint64_t seen{epoch.load(std::memory_order_seq_cst)};
+    if (Task *task{FindTask(self)}) {
+      task->run(task);
+      continue;
+    }
+    if (self) {
+      std::this_thread::yield();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    sleepers.fetch_add(1, std::memory_order_seq_cst);
+    wake.wait(lock, [this, &group, seen] {
+      return group.pending.load(std::memory_order_seq_cst) == 0 ||
+             epoch.load(std::memory_order_seq_cst) != seen;
+    });
+    sleepers.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+/// <summary>
+/// Wakes sleeping threads after a task was scheduled or a group finished.
+/// The mutex is taken only when someone sleeps.
+/// </summary>
+/// <param name="all"> true to wake all threads, false to wake one.</param>
+inline void TaskScheduler::Notify(bool all) noexcept {
+  epoch.fetch_add(1, std::memory_order_seq_cst);
+  if (sleepers.load(std::memory_order_seq_cst) == 0) return;
+  { std::lock_guard<std::mutex> lock(mutex); }
+  if (all) {
+    wake.notify_all();
+  } else {
+    wake.notify_one();
+  }
+}
+
+/// <summary>
+/// Splits a range of ParallelFor, spawning the upper halves and running the
+/// last piece on the calling thread.
+/// </summary>
+/// <param name="group"> group of the loop.</param>
+/// <param name="first"> first index.</param>
+/// <param name="last"> index past the last one.</param>
+/// <param name="function"> function taking an index.</param>
+/// <param name="grain_size"> max amount of indexes run by one task.</param>
+template <typename Function>
+void TaskScheduler::SplitRange(TaskGroup &group, size_t first, size_t last,
+                               Function &function, size_t grain_size) {
+  while (last - first > grain_size) {
+    const size_t middle{first + (last - first) / 2};
+    group.Spawn([&group, middle, last, &function, grain_size] {
+      SplitRange(group, middle, last, function, grain_size);
+    });
+    last = middle;
+  }
+  for (; first < last; ++first) {
+    function(first);
+  }
+}
+
+/// <summary>
+/// Constructor for the TaskGroup.
+/// </summary>
+/// <param name="scheduler"> scheduler that runs the tasks.</param>
+inline TaskGroup::TaskGroup(TaskScheduler &scheduler)
+    : scheduler(&scheduler), pending(0) {}
+
+/// <summary>
+/// Destructor for the TaskGroup. Waits for the tasks, an exception thrown by
+/// them is dropped.
+/// </summary>
+inline TaskGroup::~TaskGroup() { scheduler->Wait(*this); }
+
+/// <summary>
+/// Schedules a callable to run as a task of the group. When called from a
+/// worker, the task goes to the worker's own deque.
+/// </summary>
+/// <param name="function"> callable taking no arguments.</param>
+template <typename Function>
+void TaskGroup::Spawn(Function &&function) {
+  using Task = TaskScheduler::FunctionTask<std::decay_t<Function>>;
+  void *memory{NodePool::Shared().Allocate(sizeof(Task), alignof(Task))};
+  Task *task;
+  ALGLIB_TRY {
+    task = ::new (memory) Task(this, std::forward<Function>(function));
+  } ALGLIB_CATCH_ALL {
+    NodePool::Shared().Deallocate(memory, sizeof(Task), alignof(Task));
+    ALGLIB_RETHROW;
+  }
+  pending.fetch_add(1, std::memory_order_relaxed);
+  ALGLIB_TRY {
+    scheduler->Schedule(task);
+  } ALGLIB_CATCH_ALL {
+    task->~Task();
+    NodePool::Shared().Deallocate(memory, sizeof(Task), alignof(Task));
+    pending.fetch_sub(1, std::memory_order_relaxed);
+    ALGLIB_RETHROW;
+  }
+}
+
+/// <summary>
+/// Waits until all tasks of the group finish, running tasks in the meantime.
+/// The group can be used again afterwards.
+/// </summary>
+/// <exception cref="std::exception"> first exception thrown by a task of the
+/// group.</exception>
+inline void TaskGroup::Wait() {
+  scheduler->Wait(*this);
+  std::lock_guard<std::mutex> lock(mutex);
+  if (exception) {
+    std::exception_ptr error{std::exchange(exception, nullptr)};
+    std::rethrow_exception(error);
+  }
+}
+
+/// <summary>
+/// Stores an exception thrown by a task, unless an earlier one is stored.
+/// </summary>
+/// <param name="error"> exception thrown by the task.</param>
+inline void TaskGroup::Fail(std::exception_ptr error) noexcept {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (!exception) exception = std::move(error);
+}
+
+/// <summary>
+/// Marks a task of the group as finished and wakes the waiters after the
+/// last one. The group may be destroyed as soon as the counter reaches zero,
+/// so only the scheduler is used after that.
+/// </summary>
+inline void TaskGroup::Finish() noexcept {
+  TaskScheduler *owner{scheduler};
+  if (pending.fetch_sub(1, std::memory_order_seq_cst) == 1) {
+    owner->Notify(true);
+  }
+}
+
+}  // namespace alglib
+
+#endif  // ALGLIB_INCLUDE_TASKSCHEDULER_H_
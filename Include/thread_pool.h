@@ -0,0 +1,289 @@
+//*****************************************************************************
+// The MIT License (MIT)
+//
+// Copyright � 2024 Piotr Walczak
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the �Software�), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED �AS IS�, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//*****************************************************************************
+
+//*****************************************************************************
+// File: thread_pool.h
+//
+// This file contains the implementation of the ThreadPool class. ThreadPool
+// keeps a fixed set of worker threads that execute submitted tasks, so bulk
+// algorithms don't pay for creating threads on every call. The library shares
+// one default pool, but separate pools can also be created. The class is
+// implemented in the alglib namespace.
+//*****************************************************************************
+
+#ifndef ALGLIB_INCLUDE_THREADPOOL_H_
+#define ALGLIB_INCLUDE_THREADPOOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "constants.h"
+
+/// <summary>
+/// Default namespace for the AlgLib library.
+/// </summary>
+namespace alglib {
+
+/// <summary>
+/// Fixed size pool of worker threads. Tasks are taken from a shared queue in
+/// the order they were submitted. Destroying the pool finishes all queued
+/// tasks and joins the workers.
+/// </summary>
+class ThreadPool {
+ public:
+  // Constructors and destructor for the ThreadPool.
+  explicit ThreadPool(size_t thread_count = DefaultThreadCount());
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ~ThreadPool();
+
+  // Methods for running tasks on the pool.
+  void Submit(std::function<void()> task);
+  template <typename Function>
+  void ForEachChunk(size_t chunk_count, Function function);
+
+  // Methods for inspecting the pool.
+  size_t ThreadCount() const noexcept;
+  static bool InWorker() noexcept;
+
+  // Methods for accessing the pool shared by the library.
+  static ThreadPool &Default();
+  static size_t DefaultThreadCount() noexcept;
+
+ private:
+  // Method executed by every worker thread.
+  void WorkerLoop();
+
+  /// <summary>
+  /// Flag telling whether the current thread is a worker of any pool.
+  /// </summary>
+  static inline thread_local bool in_worker{false};
+
+  /// <summary>
+  /// Worker threads owned by the pool.
+  /// </summary>
+  std::vector<std::thread> workers;
+
+  /// <summary>
+  /// Tasks waiting for a free worker.
+  /// </summary>
+  std::queue<std::function<void()>> tasks;
+
+  /// <summary>
+  /// Mutex guarding the task queue and the stopping flag.
+  /// </summary>
+  std::mutex mutex;
+
+  /// <summary>
+  /// Condition variable used to wake up workers when tasks arrive.
+  /// </summary>
+  std::condition_variable task_available;
+
+  /// <summary>
+  /// Flag set by the destructor to make the workers exit.
+  /// </summary>
+  bool stopping;
+};
+
+/// <summary>
+/// Constructor for the ThreadPool. Starts a given amount of worker threads.
+/// Pool without workers is valid and runs every chunk on the calling thread.
+/// </summary>
+/// <param name="thread_count"> amount of worker threads.</param>
+inline ThreadPool::ThreadPool(size_t thread_count) : stopping(false) {
+  workers.reserve(thread_count);
+  for (size_t i{}; i < thread_count; ++i) {
+    workers.emplace_back([this] { WorkerLoop(); });
+  }
+}
+
+/// <summary>
+/// Destructor for the ThreadPool. Lets the workers finish all queued tasks and
+/// joins them.
+/// </summary>
+inline ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  task_available.notify_all();
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+}
+
+/// <summary>
+/// Adds a task to the queue. One of the workers executes it as soon as it is
+/// free. Task must not throw, as there is nobody to catch the exception.
+/// </summary>
+/// <param name="task"> function to be executed by a worker.</param>
+inline void ThreadPool::Submit(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    tasks.push(std::move(task));
+  }
+  task_available.notify_one();
+}
+
+/// <summary>
+/// Calls a function for every chunk index in range [0, chunk_count) and waits
+/// until all calls finish. Calling thread takes part in the work, and chunks
+/// are handed out dynamically, so faster threads take more of them. When
+/// called from a worker thread the chunks run serially on that thread,
+/// because waiting for other workers from inside a worker could deadlock the
+/// pool. First exception thrown by the function is rethrown after all helpers
+/// finish. If a helper can't be submitted, the helpers already submitted are
+/// stopped and waited for before the exception is rethrown.
+/// </summary>
+/// <param name="chunk_count"> amount of chunks to process.</param>
+/// <param name="function"> function taking index of a chunk.</param>
+template <typename Function>
+void ThreadPool::ForEachChunk(size_t chunk_count, Function function) {
+  if (chunk_count == 0) return;
+  size_t helper_count{std::min(chunk_count - 1, workers.size())};
+  if (InWorker() || helper_count == 0) {
+    for (size_t i{}; i < chunk_count; ++i) {
+      function(i);
+    }
+    return;
+  }
+
+  struct SharedState {
+    std::atomic<size_t> next_chunk{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr exception;
+    std::mutex mutex;
+    std::condition_variable helpers_done;
+    size_t running_helpers;
+  } state;
+  state.running_helpers = helper_count;
+
+  auto run_chunks = [&state, &function, chunk_count] {
+    for (;;) {
+      size_t chunk{state.next_chunk.fetch_add(1, std::memory_order_relaxed)};
+      if (chunk >= chunk_count || state.failed.load(std::memory_order_relaxed))
+        return;
+      ALGLIB_TRY {
+        function(chunk);
+      } ALGLIB_CATCH_ALL {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (!state.exception) state.exception = std::current_exception();
+        state.failed.store(true, std::memory_order_relaxed);
+      }
+    }
+  };
+
+  size_t submitted{};
+  ALGLIB_TRY {
+    for (; submitted < helper_count; ++submitted) {
+      Submit([&state, &run_chunks] {
+        run_chunks();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (--state.running_helpers == 0) state.helpers_done.notify_one();
+      });
+    }
+  } ALGLIB_CATCH_ALL {
+    // Helpers already in the queue use the state on this stack, so they are
+    // stopped and waited for before the exception leaves.
+    state.failed.store(true, std::memory_order_relaxed);
+    std::unique_lock<std::mutex> lock(state.mutex);
+    state.running_helpers -= helper_count - submitted;
+    state.helpers_done.wait(lock,
+                            [&state] { return state.running_helpers == 0; });
+    ALGLIB_RETHROW;
+  }
+  run_chunks();
+
+  std::unique_lock<std::mutex> lock(state.mutex);
+  state.helpers_done.wait(lock,
+                          [&state] { return state.running_helpers == 0; });
+  if (state.exception) std::rethrow_exception(state.exception);
+}
+
+/// <summary>
+/// Method for getting amount of worker threads in the pool.
+/// </summary>
+/// <returns> amount of worker threads.</returns>
+inline size_t ThreadPool::ThreadCount() const noexcept {
+  return workers.size();
+}
+
+/// <summary>
+/// Method for checking whether the calling thread is a worker of a pool.
+/// </summary>
+/// <returns> true if called from a worker thread.</returns>
+inline bool ThreadPool::InWorker() noexcept { return in_worker; }
+
+/// <summary>
+/// Method for getting the pool shared by the whole library. It is created on
+/// first use and lives until the program exits.
+/// </summary>
+/// <returns> reference to the default pool.</returns>
+inline ThreadPool &ThreadPool::Default() {
+  static ThreadPool pool;
+  return pool;
+}
+
+/// <summary>
+/// Method for getting the default amount of workers. Calling thread also takes
+/// part in ForEachChunk, so the pool uses one thread less than the hardware
+/// provides.
+/// </summary>
+/// <returns> amount of workers used by default.</returns>
+inline size_t ThreadPool::DefaultThreadCount() noexcept {
+  unsigned hardware_threads{std::thread::hardware_concurrency()};
+  return hardware_threads > 1 ? hardware_threads - 1 : 0;
+}
+
+/// <summary>
+/// Loop executed by the workers. Waits for tasks and executes them until the
+/// pool is stopping and the queue is empty.
+/// </summary>
+inline void ThreadPool::WorkerLoop() {
+  in_worker = true;
+  for (;;) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      task_available.wait(lock, [this] { return stopping || !tasks.empty(); });
+      if (tasks.empty()) return;
+      task = std::move(tasks.front());
+      tasks.pop();
+    }
+    task();
+  }
+}
+
+}  // namespace alglib
+
+#endif  // ALGLIB_INCLUDE_THREADPOOL_H_
@@ -0,0 +1,129 @@
+//*****************************************************************************
+// The MIT License (MIT)
+//
+// Copyright � 2024 Piotr Walczak
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the �Software�), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED �AS IS�, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//*****************************************************************************
+
+//*****************************************************************************
+// File: traversal.h
+//
+// This file contains helpers for internal iteration over containers that
+// provide a templated Traverse method, like the linked lists. Instead of
+// walking the container with iterators, the helpers hand a callable to
+// Traverse, which the compiler can inline into the loop over the nodes.
+// Elements are passed by reference, so nothing is copied. The helpers are
+// implemented in the alglib namespace.
+//*****************************************************************************
+
+#ifndef ALGLIB_INCLUDE_TRAVERSAL_H_
+#define ALGLIB_INCLUDE_TRAVERSAL_H_
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+/// <summary>
+/// Default namespace for the AlgLib library.
+/// </summary>
+namespace alglib {
+
+namespace detail {
+
+/// <summary>
+/// Calls a visitor of Traverse with an element.
+/// </summary>
+/// <param name="visit"> callable taking the element. It may return a value
+/// convertible to bool, false stops the traversal.</param>
+/// <param name="value"> element that is visited.</param>
+/// <returns> false if the traversal should stop.</returns>
+template <typename Function, typename Value>
+constexpr bool Visit(Function &visit, Value &value) {
+  if constexpr (std::is_void_v<std::invoke_result_t<Function &, Value &>>) {
+    std::invoke(visit, value);
+    return true;
+  } else {
+    return static_cast<bool>(std::invoke(visit, value));
+  }
+}
+
+}  // namespace detail
+
+/// <summary>
+/// Container that visits its elements through a templated Traverse method.
+/// </summary>
+template <typename Container>
+concept Traversable = requires(Container &container) {
+  container.Traverse([](auto &) {});
+};
+
+/// <summary>
+/// Calls a function with every element of a container, in order.
+/// </summary>
+/// <param name="container"> container that is traversed.</param>
+/// <param name="function"> callable taking an element by reference.</param>
+/// <returns> the function, with any state it gathered.</returns>
+template <Traversable Container, typename Function>
+Function ForEach(Container &container, Function function) {
+  container.Traverse(
+      [&function](auto &value) { std::invoke(function, value); });
+  return function;
+}
+
+/// <summary>
+/// Folds elements of a container, in order, into a single value.
+/// </summary>
+/// <param name="container"> container that is traversed.</param>
+/// <param name="init"> initial value of the result.</param>
+/// <param name="operation"> callable combining the result so far with an
+/// element, addition by default.</param>
+/// <returns> the folded value.</returns>
+template <Traversable Container, typename Result,
+          typename Operation = std::plus<>>
+Result Accumulate(const Container &container, Result init,
+                  Operation operation = Operation()) {
+  container.Traverse([&init, &operation](const auto &value) {
+    init = std::invoke(operation, std::move(init), value);
+  });
+  return init;
+}
+
+/// <summary>
+/// Counts elements of a container that satisfy a predicate.
+/// </summary>
+/// <param name="container"> container that is traversed.</param>
+/// <param name="predicate"> callable taking an element and returning
+/// bool.</param>
+/// <returns> number of elements for which the predicate returned
+/// true.</returns>
+template <Traversable Container, typename Predicate>
+size_t CountIf(const Container &container, Predicate predicate) {
+  size_t count{};
+  container.Traverse([&count, &predicate](const auto &value) {
+    if (std::invoke(predicate, value)) ++count;
+  });
+  return count;
+}
+
+}  // namespace alglib
+
+#endif  // ALGLIB_INCLUDE_TRAVERSAL_H_
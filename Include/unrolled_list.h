@@ -0,0 +1,938 @@
+//*****************************************************************************
+// The MIT License (MIT)
+//
+// Copyright � 2024 Piotr Walczak
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the �Software�), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED �AS IS�, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//*****************************************************************************
+
+//*****************************************************************************
+// File: unrolled_list.h
+//
+// This file contains the implementation of an Unrolled Linked List. Instead
+// of one node per element it keeps small arrays of elements in doubly linked
+// chunks of a fixed size in bytes. Walking the list reads elements that sit
+// next to each other in memory, and the link pointers are shared by all
+// elements of a chunk. Chunks are split when an insertion finds them full and
+// merged with a neighbour when they get sparse. The class is implemented in
+// the alglib namespace.
+//*****************************************************************************
+
+#ifndef ALGLIB_INCLUDE_UNROLLEDLIST_H_
+#define ALGLIB_INCLUDE_UNROLLEDLIST_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "constants.h"
+#include "stats.h"
+#include "traversal.h"
+
+/// <summary>
+/// Default namespace for the AlgLib library.
+/// </summary>
+namespace alglib {
+
+/// <summary>
+/// Default size of a single chunk of the unrolled list, two cache lines.
+/// </summary>
+inline constexpr size_t kDefaultChunkBytes{128};
+
+/// <summary>
+/// Template based unrolled linked list implementation. It offers the same
+/// interface as DoublyLinkedList, but stores elements in arrays held by
+/// doubly linked chunks, which are allocated through the allocator rebound to
+/// the internal chunk type. Inserting and erasing elements moves the elements
+/// that follow them in the same chunk, so iterators are invalidated by every
+/// modification of the list.
+/// </summary>
+/// <typeparam name="T"> type of data stored in list.</typeparam>
+/// <typeparam name="ChunkBytes"> size of a chunk in bytes, including links
+/// and the element count. A chunk holds at least one element.</typeparam>
+/// <typeparam name="Allocator"> allocator used to obtain memory for
+/// chunks.</typeparam>
+template <typename T, size_t ChunkBytes = kDefaultChunkBytes,
+          typename Allocator = std::allocator<T>>
+class UnrolledList {
+  struct Chunk;
+
+  // Size of the chunk fields placed before the elements.
+  static constexpr size_t kHeaderBytes{
+      (2 * sizeof(void *) + sizeof(size_t) + alignof(T) - 1) / alignof(T) *
+      alignof(T)};
+
+ public:
+  /// <summary>
+  /// Number of elements that fit in a single chunk.
+  /// </summary>
+  static constexpr size_t kChunkCapacity{
+      ChunkBytes >= kHeaderBytes + 2 * sizeof(T)
+          ? (ChunkBytes - kHeaderBytes) / sizeof(T)
+          : 2};
+
+  /// <summary>
+  /// Bidirectional iterator over elements of the list. Const qualified type
+  /// makes a constant iterator.
+  /// </summary>
+  /// <typeparam name="Value"> type of data the iterator gives access
+  /// to.</typeparam>
+  template <typename Value>
+  class Iter {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::remove_cv_t<Value>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value *;
+    using reference = Value &;
+
+    // Constructors
+    Iter() noexcept;
+    template <typename OtherValue>
+      requires std::is_convertible_v<OtherValue *, Value *>
+    Iter(const Iter<OtherValue> &other) noexcept;
+
+    // Access operators
+    reference operator*() const noexcept;
+    pointer operator->() const noexcept;
+
+    // Moving operators
+    Iter &operator++() noexcept;
+    Iter operator++(int) noexcept;
+    Iter &operator--() noexcept;
+    Iter operator--(int) noexcept;
+
+    // Comparison operator, inequality is generated from it.
+    bool operator==(const Iter &other) const noexcept;
+
+   private:
+    friend class UnrolledList;
+    template <typename OtherValue>
+    friend class Iter;
+
+    Iter(Chunk *chunk, size_t index, const UnrolledList *list) noexcept;
+
+    // Chunk holding the element, nullptr for the past the end iterator.
+    Chunk *chunk_;
+    // Index of the element in the chunk.
+    size_t index_;
+    // List that the chunk belongs to, used to step back from the end.
+    const UnrolledList *list_;
+  };
+
+  using Iterator = Iter<T>;
+  using ConstIterator = Iter<const T>;
+
+  // Constructors and assignment operators.
+  UnrolledList();
+  explicit UnrolledList(const Allocator &allocator);
+  UnrolledList(const UnrolledList &) = delete;
+  UnrolledList &operator=(const UnrolledList &) = delete;
+
+  // Methods for exploring the unrolled list.
+  template <typename Function>
+  bool Traverse(Function &&visit_callback);
+  template <typename Function>
+  bool Traverse(Function &&visit_callback) const;
+  size_t Size() const noexcept;
+  size_t ChunkCount() const noexcept;
+  Iterator Find(const T &value) noexcept;
+  ConstIterator Find(const T &value) const noexcept;
+
+  // Method for converting the unrolled list to a vector.
+  std::vector<T> GetAsVector() const noexcept;
+
+  // Iterators
+  Iterator begin() noexcept;
+  Iterator end() noexcept;
+  ConstIterator begin() const noexcept;
+  ConstIterator end() const noexcept;
+  ConstIterator cbegin() const noexcept;
+  ConstIterator cend() const noexcept;
+
+  // Methods for inserting elements into the unrolled list.
+  void InsertAtBeginning(T data);
+  void InsertAtEnd(T data);
+  void InsertAtPosition(uint32_t pos, T data);
+
+  // Methods for deleting elements from the unrolled list.
+  void DeleteAtBeginning();
+  void DeleteAtEnd();
+  void DeleteAtPosition(uint32_t pos);
+  template <typename Predicate>
+  size_t RemoveIf(Predicate predicate);
+
+  // Method for checking if the unrolled list is empty.
+  bool IsEmpty() const noexcept;
+
+  // Method for getting statistics of the unrolled list.
+  ContainerStats GetStats() const noexcept;
+
+  // Destructor for the unrolled list.
+  ~UnrolledList();
+
+ private:
+  /// <summary>
+  /// Chunk of the unrolled list. Holds links to the neighbouring chunks and
+  /// an array of elements, of which the first count are constructed.
+  /// </summary>
+  struct Chunk {
+    Chunk() noexcept;
+    T *Elements() noexcept;
+
+    Chunk *next{nullptr};
+    Chunk *previous{nullptr};
+    size_t count{};
+    alignas(T) std::byte storage[kChunkCapacity * sizeof(T)];
+  };
+
+  using ChunkAllocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Chunk>;
+  using ChunkTraits = std::allocator_traits<ChunkAllocator>;
+
+  // Methods for allocating, linking and releasing chunks.
+  Chunk *CreateChunk(Chunk *previous);
+  void DestroyChunk(Chunk *chunk) noexcept;
+
+  // Methods working on elements inside chunks.
+  std::pair<Chunk *, size_t> Locate(size_t pos) const noexcept;
+  void InsertInto(Chunk *chunk, size_t index, T &&data);
+  void EraseFrom(Chunk *chunk, size_t index);
+  void MergeWithNext(Chunk *chunk);
+  void Truncate(Chunk *chunk, size_t count);
+
+  // Head and tail pointers to the first and last chunk.
+  Chunk *head_;
+  Chunk *tail_;
+
+  // Number of elements and chunks in the unrolled list.
+  size_t size_;
+  size_t chunk_count_;
+
+  // Allocator that provides memory for the chunks.
+  ALGLIB_NO_UNIQUE_ADDRESS ChunkAllocator chunk_allocator_;
+
+  // Statistics of the list, empty unless ALGLIB_ENABLE_STATS is defined.
+  ALGLIB_NO_UNIQUE_ADDRESS detail::StatsRecorder stats_;
+};
+
+/// <summary>
+/// Default constructor creating iterator that doesn't point to any element.
+/// </summary>
+template <typename T, size_t ChunkBytes, typename Allocator>
+template <typename Value>
+UnrolledList<T, ChunkBytes, Allocator>::Iter<Value>::Iter() noexcept
+    : chunk_(nullptr), index_(0), list_(nullptr) {}
+
+/// <summary>
+/// Converting constructor, used to make constant iterator from a mutable one.
+/// </summary>
+template <typename T, size_t ChunkBytes, typename Allocator>
+template <typename Value>
+template <typename OtherValue>
+  requires std::is_convertible_v<OtherValue *, Value *>
+UnrolledList<T, ChunkBytes, Allocator>::Iter<Value>::Iter(
+    const Iter<OtherValue> &other) noexcept
+    : chunk_(other.chunk_), index_(other.index_), list_(other.list_) {}
+
+/// <summary>
+/// Constructor used by the list to make iterator pointing to an element.
+/// </summary>
+/// <param name="chunk"> chunk holding the element or nullptr for the past the
+/// end iterator.</param>
+/// <param name="index"> index of the element in the chunk.</param>
+/// <param name="list"> list that the chunk belongs to.</param>
+template <typename T, size_t ChunkBytes, typename Allocator>
+template <typename Value>
+UnrolledList<T, ChunkBytes, Allocator>::Iter<Value>::Iter(
+    Chunk *chunk, size_t index, const UnrolledList *list) noexcept
+    : chunk_(chunk), index_(index), list_(list) {}
+
+/// <summary>
+/// Gets the element the iterator points to.
+/// </summary>
+template <typename T, size_t ChunkBytes, typename Allocator>
+template <typename Value>
+typename UnrolledList<T, ChunkBytes, Allocator>::template Iter<
+    Value>::reference
+UnrolledList<T, ChunkBytes, Allocator>::Iter<Value>::operator*()
+    const noexcept {
+  return chunk_->Elements()[index_];
+}
+
+/// <summary>
+/// Gives access to members of the element the iterator points to.
+/// </summary>
+template <typename T, size_t ChunkBytes, typename Allocator>
+template <typename Value>
+typename UnrolledList<T, ChunkBytes, Allocator>::template Iter<Value>::pointer
+UnrolledList<T, ChunkBytes, Allocator>::Iter<Value>::operator->()
+    const noexcept {
+  return chunk_->Elements() + index_;
+}
+
+/// <summary>
+/// Pre-increment. Makes the iterator point to the next element, moving to
+/// the next chunk after the last element of a chunk.
+/// </summary>
+template <typename T, size_t ChunkBytes, typename Allocator>
+template <typename Value>
+typename UnrolledList<T, ChunkBytes, Allocator>::template Iter<Value> &
+UnrolledList<T, ChunkBytes, Allocator>::Iter<Value>::operator++() noexcept {
+  if (++index_ == chunk_->count) {
+    chunk_ = chunk_->next;
+    index_ = 0;
+  }
+  return *this;
+}
+
+/// <summary>
+/// Post-increment. Makes the iterator point to the next element.
+/// </summary>
+template <typename T, size_t ChunkBytes, typename Allocator>
+template <typename Value>
+typename UnrolledList<T, ChunkBytes, Allocator>::template Iter<Value>
+UnrolledList<T, ChunkBytes, Allocator>::Iter<Value>::operator++(
+    int) noexcept {
+  Iter tmp{*this};
+  ++*this;
+  return tmp;
+}
+
+/// <summary>
+/// Pre-decrement. Makes the iterator point to the previous element. Past the
+/// end iterator moves to the last element.
+/// </summary>
+template <typename T, size_t ChunkBytes, typename Allocator>
+template <typename Value>
+typename UnrolledList<T, ChunkBytes, Allocator>::template Iter<Value> &
+UnrolledList<T, ChunkBytes, Allocator>::Iter<Value>::operator--() noexcept {
+  if (chunk_ == nullptr || index_ == 0) {
+    chunk_ = chunk_ ? chunk_->previous : list_->tail_;
+    index_ = chunk_->count;
+  }
+  --index_;
+  return *this;
+}
+
+/// <summary>
+/// Post-decrement. Makes the iterator point to the previous element.
+/// </summary>
+template <typename T, size_t ChunkBytes, typename Allocator>
+template <typename Value>
+typename UnrolledList<T, ChunkBytes, Allocator>::template Iter<Value>
+UnrolledList<T, ChunkBytes, Allocator>::Iter<Value>::operator--(
+    int) noexcept {
+  Iter tmp{*this};
+  --*this;
+  return tmp;
+}
+
+/// <summary>
+/// Checks whether two iterators point to the same element.
+/// </summary>
+template <typename T, size_t ChunkBytes, typename Allocator>
+template <typename Value>
+bool UnrolledList<T, ChunkBytes, Allocator>::Iter<Value>::operator==(
+    const Iter &other) const noexcept {
+  return chunk_ == other.chunk_ && index_ == other.index_;
+}
+
+/// <summary>
+/// Constructor for the Chunk structure. It leaves the element storage
+/// uninitialized.
+/// </summary>
+template <typename T, size_t ChunkBytes, typename Allocator>
+UnrolledList<T, ChunkBytes, Allocator>::Chunk::Chunk() noexcept {}
+
+/// <summary>
+/// Gets pointer to the first element stored in the chunk.
+/// </summary>
+template <typename T, size_t ChunkBytes, typename Allocator>
+T *UnrolledList<T, ChunkBytes, Allocator>::Chunk::Elements() noexcept {
+  return std::launder(reinterpret_cast<T *>(storage));
+}
+
+/// <summary>
+/// Constructor for the unrolled list. It initializes the head and tail
+/// pointers to nullptr.
+/// </summary>
+template <typename T, size_t ChunkBytes, typename Allocator>
+UnrolledList<T, ChunkBytes, Allocator>::UnrolledList()
+    : head_(nullptr),
+      tail_(nullptr),
+      size_(0),
+      chunk_count_(0),
+      chunk_allocator_() {}
+
+/// <summary>
+/// Constructor for the unrolled list that takes chunks from a given
+/// allocator. It initializes the head and tail pointers to nullptr.
+/// </summary>
+/// <param name="allocator"> allocator used for the chunks.</param>
+template <typename T, size_t ChunkBytes, typename Allocator>
+UnrolledList<T, ChunkBytes, Allocator>::UnrolledList(
+    const Allocator &allocator)
+    : head_(nullptr),
+      tail_(nullptr),
+      size_(0),
+      chunk_count_(0),
+      chunk_allocator_(allocator) {}
+
+/// <summary>
+/// Method for traversing the unrolled list. It passes elements of every
+/// chunk, from the head to the tail, to a callable by reference. The
+/// callable is a template parameter, so the call can be inlined into the
+/// loop over the elements.
+/// </summary>
+/// <param name="visit_callback">Callable taking T&. When it returns a value
+/// convertible to bool, false stops the traversal.</param>
+/// <returns>True if all elements were visited.</returns>
+template <typename T, size_t ChunkBytes, typename Allocator>
+template <typename Function>
+bool UnrolledList<T, ChunkBytes, Allocator>::Traverse(
+    Function &&visit_callback) {
+  for (Chunk *chunk{head_}; chunk; chunk = chunk->next) {
+    T *elements{chunk->Elements()};
+    for (size_t i{}; i < chunk->count; ++i) {
+      if (!detail::Visit(visit_callback, elements[i])) return false;
+    }
+  }
+  return true;
+}
+
+/// <summary>
+/// Method for traversing the constant unrolled list. It passes elements to a
+/// callable by constant reference.
+/// </summary>
+/// <param name="visit_callback">Callable taking const T&. When it returns a
+/// value convertible to bool, false stops the traversal.</param>
+/// <returns>True if all elements were visited.</returns>
+template <typename T, size_t ChunkBytes, typename Allocator>
+template <typename Function>
+bool UnrolledList<T, ChunkBytes, Allocator>::Traverse(
+    Function &&visit_callback) const {
+  for (Chunk *chunk{head_}; chunk; chunk = chunk->next) {
+    const T *elements{chunk->Elements()};
+    for (size_t i{}; i < chunk->count; ++i) {
+      if (!detail::Visit(visit_callback, elements[i])) return false;
+    }
+  }
+  return true;
+}
+
+/// <summary>
+/// Method for getting the number of elements in the unrolled list.
+/// </summary>
+/// <returns> Number of elements in list.</returns>
+template <typename T, size_t ChunkBytes, typename Allocator>
+size_t UnrolledList<T, ChunkBytes, Allocator>::Size() const noexcept {
+  return size_;
+}
+
+/// <summary>
+/// Method for getting the number of chunks that the elements are stored in.
+/// </summary>
+/// <returns> Number of chunks in list.</returns>
+template <typename T, size_t ChunkBytes, typename Allocator>
+size_t UnrolledList<T, ChunkBytes, Allocator>::ChunkCount() const noexcept {
+  return chunk_count_;
+}
+
+/// <summary>
+/// Method for finding a value in the unrolled list. It starts at the head of
+/// the list and visits elements until the value is found.
+/// </summary>
+/// <param name="value"> Value that list is searched for.</param>
+/// <returns> Iterator to the first element equal to the value or end() if
+/// the value is not in the list.</returns>
+template <typename T, size_t ChunkBytes, typename Allocator>
+typename UnrolledList<T, ChunkBytes, Allocator>::Iterator
+UnrolledList<T, ChunkBytes, Allocator>::Find(const T &value) noexcept {
+  ConstIterator found{std::as_const(*this).Find(value)};
+  return Iterator(found.chunk_, found.index_, this);
+}
+
+/// <summary>
+/// Method for finding a value in the constant unrolled list.
+/// </summary>
+/// <param name="value"> Value that list is searched for.</param>
+/// <returns> Constant iterator to the first element equal to the value or
+/// end() if the value is not in the list.</returns>
+template <typename T, size_t ChunkBytes, typename Allocator>
+typename UnrolledList<T, ChunkBytes, Allocator>::ConstIterator
+UnrolledList<T, ChunkBytes, Allocator>::Find(const T &value) const noexcept {
+  for (Chunk *chunk{head_}; chunk; chunk = chunk->next) {
+    T *elements{chunk->Elements()};
+    for (size_t i{}; i < chunk->count; ++i) {
+      if (elements[i] == value) return ConstIterator(chunk, i, this);
+    }
+  }
+  return end();
+}
+
+/// <summary>
+/// Method for converting the unrolled list to a vector.
+/// It is used for testing purposes.
+/// </summary>
+/// <returns>Unrolled list as vector.</returns>
+template <typename T, size_t ChunkBytes, typename Allocator>
+std::vector<T> UnrolledList<T, ChunkBytes, Allocator>::GetAsVector()
+    const noexcept {
+  std::vector<T> vec{};
+  vec.reserve(size_);
+  for (Chunk *chunk{head_}; chunk; chunk = chunk->next) {
+    T *elements{chunk->Elements()};
+    vec.insert(vec.end(), elements, elements + chunk->count);
+  }
+  return vec;
+}
+
+/// <summary>
+/// Returns iterator to the first element.
+/// </summary>
+template <typename T, size_t ChunkBytes, typename Allocator>
+typename UnrolledList<T, ChunkBytes, Allocator>::Iterator
+UnrolledList<T, ChunkBytes, Allocator>::begin() noexcept {
+  return Iterator(head_, 0, this);
+}
+
+/// <summary>
+/// Returns iterator to the position past the last element.
+/// </summary>
+template <typename T, size_t ChunkBytes, typename Allocator>
+typename UnrolledList<T, ChunkBytes, Allocator>::Iterator
+UnrolledList<T, ChunkBytes, Allocator>::end() noexcept {
+  return Iterator(nullptr, 0, this);
+}
+
+/// <summary>
+/// Returns constant iterator to the first element.
+/// </summary>
+template <typename T, size_t ChunkBytes, typename Allocator>
+typename UnrolledList<T, ChunkBytes, Allocator>::ConstIterator
+UnrolledList<T, ChunkBytes, Allocator>::begin() const noexcept {
+  return ConstIterator(head_, 0, this);
+}
+
+/// <summary>
+/// Returns constant iterator to the position past the last element.
+/// </summary>
+template <typename T, size_t ChunkBytes, typename Allocator>
+typename UnrolledList<T, ChunkBytes, Allocator>::ConstIterator
+UnrolledList<T, ChunkBytes, Allocator>::end() const noexcept {
+  return ConstIterator(nullptr, 0, this);
+}
+
+/// <summary>
+/// Returns constant iterator to the first element.
+/// </summary>
+template <typename T, size_t ChunkBytes, typename Allocator>
+typename UnrolledList<T, ChunkBytes, Allocator>::ConstIterator
+UnrolledList<T, ChunkBytes, Allocator>::cbegin() const noexcept {
+  return begin();
+}
+
+/// <summary>
+/// Returns constant iterator to the position past the last element.
+/// </summary>
+template <typename T, size_t ChunkBytes, typename Allocator>
+typename UnrolledList<T, ChunkBytes, Allocator>::ConstIterator
+UnrolledList<T, ChunkBytes, Allocator>::cend() const noexcept {
+  return end();
+}
+
+/// <summary>
+/// Method for inserting an element at the beginning of the unrolled list. A
+/// new chunk is linked before the head when the head chunk is full.
+/// </summary>
+/// <param name="data">Value that will be inserted.</param>
+template <typename T, size_t ChunkBytes, typename Allocator>
+void UnrolledList<T, ChunkBytes, Allocator>::InsertAtBeginning(T data) {
+  if (head_ == nullptr || head_->count == kChunkCapacity) {
+    CreateChunk(nullptr);
+  }
+  InsertInto(head_, 0, std::move(data));
+}
+
+/// <summary>
+/// Method for inserting an element at the end of the unrolled list. A new
+/// chunk is linked after the tail when the tail chunk is full, so lists built
+/// by appending keep all chunks but the last one full.
+/// </summary>
+/// <param name="data">Value that will be inserted.</param>
+template <typename T, size_t ChunkBytes, typename Allocator>
+void UnrolledList<T, ChunkBytes, Allocator>::InsertAtEnd(T data) {
+  if (tail_ == nullptr || tail_->count == kChunkCapacity) {
+    CreateChunk(tail_);
+  }
+  InsertInto(tail_, tail_->count, std::move(data));
+}
+
+/// <summary>
+/// Method for inserting an element at the given position in the unrolled
+/// list. The chunk is found by walking from the closer end of the list. When
+/// that chunk is full, its upper half is moved to a new chunk first. If pos
+/// is out of range, an exception is thrown.
+/// </summary>
+/// <param name="pos">Position to insert the data (0-based index).</param>
+/// <param name="data">Value that will be inserted.</param>
+template <typename T, size_t ChunkBytes, typename Allocator>
+void UnrolledList<T, ChunkBytes, Allocator>::InsertAtPosition(uint32_t pos,
+                                                              T data) {
+  if (pos > size_) {
+    ALGLIB_THROW(std::runtime_error(errors::kIndexOutOfRange));
+  }
+  if (pos == 0) {
+    InsertAtBeginning(std::move(data));
+    return;
+  }
+  if (pos == size_) {
+    InsertAtEnd(std::move(data));
+    return;
+  }
+  auto [chunk, index] = Locate(pos);
+  if (chunk->count == kChunkCapacity) {
+    Chunk *upper{CreateChunk(chunk)};
+    const size_t half{kChunkCapacity / 2};
+    T *elements{chunk->Elements()};
+    std::uninitialized_move(elements + half, elements + chunk->count,
+                            upper->Elements());
+    std::destroy(elements + half, elements + chunk->count);
+    stats_.Reallocation((chunk->count - half) * sizeof(T));
+    upper->count = chunk->count - half;
+    chunk->count = half;
+    if (index > half) {
+      chunk = upper;
+      index -= half;
+    }
+  }
+  InsertInto(chunk, index, std::move(data));
+}
+
+/// <summary>
+/// Method for deleting the first element of the unrolled list. If the list
+/// is empty, an exception is thrown.
+/// </summary>
+template <typename T, size_t ChunkBytes, typename Allocator>
+void UnrolledList<T, ChunkBytes, Allocator>::DeleteAtBeginning() {
+  if (IsEmpty()) {
+    ALGLIB_THROW(std::runtime_error(errors::kEmptyDeletion));
+  }
+  EraseFrom(head_, 0);
+}
+
+/// <summary>
+/// Method for deleting the last element of the unrolled list. If the list is
+/// empty, an exception is thrown.
+/// </summary>
+template <typename T, size_t ChunkBytes, typename Allocator>
+void UnrolledList<T, ChunkBytes, Allocator>::DeleteAtEnd() {
+  if (IsEmpty()) {
+    ALGLIB_THROW(std::runtime_error(errors::kEmptyDeletion));
+  }
+  EraseFrom(tail_, tail_->count - 1);
+}
+
+/// <summary>
+/// Deletes the element at the given position in the unrolled list. The
+/// chunk is found by walking from the closer end of the list. If the list is
+/// empty or the position is out of range, an exception is thrown.
+/// </summary>
+/// <param name="pos">Position of element to delete (0 - first).</param>
+template <typename T, size_t ChunkBytes, typename Allocator>
+void UnrolledList<T, ChunkBytes, Allocator>::DeleteAtPosition(uint32_t pos) {
+  if (IsEmpty()) {
+    ALGLIB_THROW(std::runtime_error(errors::kEmptyDeletion));
+  }
+  if (pos >= size_) {
+    ALGLIB_THROW(std::runtime_error(errors::kIndexOutOfRange));
+  }
+  auto [chunk, index] = Locate(pos);
+  EraseFrom(chunk, index);
+}
+
+/// <summary>
+/// Method for deleting all elements that satisfy a predicate, in a single
+/// pass over the list. Kept elements are moved towards the front of their
+/// chunk, emptied chunks are released and sparse ones merged with the
+/// previous chunk.
+/// </summary>
+/// <param name="predicate">Callable taking const T& and returning true for
+/// elements that will be deleted.</param>
+/// <returns>Number of deleted elements.</returns>
+template <typename T, size_t ChunkBytes, typename Allocator>
+template <typename Predicate>
+size_t UnrolledList<T, ChunkBytes, Allocator>::RemoveIf(Predicate predicate) {
+  const size_t old_size{size_};
+  Chunk *chunk{head_};
+  while (chunk) {
+    T *elements{chunk->Elements()};
+    size_t kept{};
+    size_t i{};
+    ALGLIB_TRY {
+      for (; i < chunk->count; ++i) {
+        if (std::invoke(predicate, std::as_const(elements[i]))) continue;
+        if (kept != i) elements[kept] = std::move(elements[i]);
+        ++kept;
+      }
+    } ALGLIB_CATCH_ALL {
+      // Close the gap left by deleted elements before passing the error on.
+      std::move(elements + i, elements + chunk->count, elements + kept);
+      Truncate(chunk, kept + chunk->count - i);
+      ALGLIB_RETHROW;
+    }
+    Chunk *next{chunk->next};
+    Chunk *previous{chunk->previous};
+    Truncate(chunk, kept);
+    if (kept != 0 && previous && previous->count + kept <= kChunkCapacity) {
+      MergeWithNext(previous);
+    }
+    chunk = next;
+  }
+  return old_size - size_;
+}
+
+/// <summary>
+/// Method for checking if the unrolled list is empty.
+/// </summary>
+/// <returns>True if the list is empty, false otherwise.</returns>
+template <typename T, size_t ChunkBytes, typename Allocator>
+bool UnrolledList<T, ChunkBytes, Allocator>::IsEmpty() const noexcept {
+  return size_ == 0;
+}
+
+/// <summary>
+/// Method for getting statistics of the unrolled list. It records allocated
+/// and released chunks, elements moved between chunks when a full chunk is
+/// split or two chunks are merged, and the biggest size. Without
+/// ALGLIB_ENABLE_STATS all counters are zero.
+/// </summary>
+/// <returns> Statistics of the list.</returns>
+template <typename T, size_t ChunkBytes, typename Allocator>
+ContainerStats UnrolledList<T, ChunkBytes, Allocator>::GetStats()
+    const noexcept {
+  return stats_.Get();
+}
+
+/// <summary>
+/// Destructor for the unrolled list. It destroys elements of every chunk and
+/// releases the chunks.
+/// </summary>
+template <typename T, size_t ChunkBytes, typename Allocator>
+UnrolledList<T, ChunkBytes, Allocator>::~UnrolledList() {
+  Chunk *chunk{head_};
+  while (chunk) {
+    Chunk *next{chunk->next};
+    std::destroy(chunk->Elements(), chunk->Elements() + chunk->count);
+    ChunkTraits::destroy(chunk_allocator_, chunk);
+    ChunkTraits::deallocate(chunk_allocator_, chunk, 1);
+    stats_.Deallocation();
+    chunk = next;
+  }
+}
+
+/// <summary>
+/// Obtains memory for an empty chunk and links it after a given chunk.
+/// </summary>
+/// <param name="previous"> chunk that the new one follows, nullptr makes it
+/// the new head.</param>
+/// <returns> pointer to the new chunk.</returns>
+template <typename T, size_t ChunkBytes, typename Allocator>
+typename UnrolledList<T, ChunkBytes, Allocator>::Chunk *
+UnrolledList<T, ChunkBytes, Allocator>::CreateChunk(Chunk *previous) {
+  Chunk *chunk{ChunkTraits::allocate(chunk_allocator_, 1)};
+  ChunkTraits::construct(chunk_allocator_, chunk);
+  stats_.Allocation();
+  Chunk *next{previous ? previous->next : head_};
+  chunk->previous = previous;
+  chunk->next = next;
+  if (previous) {
+    previous->next = chunk;
+  } else {
+    head_ = chunk;
+  }
+  if (next) {
+    next->previous = chunk;
+  } else {
+    tail_ = chunk;
+  }
+  ++chunk_count_;
+  return chunk;
+}
+
+/// <summary>
+/// Unlinks an empty chunk and returns its memory to the chunk allocator.
+/// </summary>
+/// <param name="chunk"> chunk without elements.</param>
+template <typename T, size_t ChunkBytes, typename Allocator>
+void UnrolledList<T, ChunkBytes, Allocator>::DestroyChunk(
+    Chunk *chunk) noexcept {
+  if (chunk->previous) {
+    chunk->previous->next = chunk->next;
+  } else {
+    head_ = chunk->next;
+  }
+  if (chunk->next) {
+    chunk->next->previous = chunk->previous;
+  } else {
+    tail_ = chunk->previous;
+  }
+  ChunkTraits::destroy(chunk_allocator_, chunk);
+  ChunkTraits::deallocate(chunk_allocator_, chunk, 1);
+  stats_.Deallocation();
+  --chunk_count_;
+}
+
+/// <summary>
+/// Finds the chunk holding the element at a given position by walking from
+/// the head or from the tail, whichever is closer.
+/// </summary>
+/// <param name="pos"> position of the element, smaller than size.</param>
+/// <returns> chunk and index of the element in it.</returns>
+template <typename T, size_t ChunkBytes, typename Allocator>
+std::pair<typename UnrolledList<T, ChunkBytes, Allocator>::Chunk *, size_t>
+UnrolledList<T, ChunkBytes, Allocator>::Locate(size_t pos) const noexcept {
+  if (pos < size_ / 2) {
+    Chunk *chunk{head_};
+    while (pos >= chunk->count) {
+      pos -= chunk->count;
+      chunk = chunk->next;
+    }
+    return {chunk, pos};
+  }
+  size_t from_end{size_ - pos};
+  Chunk *chunk{tail_};
+  while (from_end > chunk->count) {
+    from_end -= chunk->count;
+    chunk = chunk->previous;
+  }
+  return {chunk, chunk->count - from_end};
+}
+
+/// <summary>
+/// Inserts an element into a chunk that isn't full, moving the elements
+/// after the index one place to the right.
+/// </summary>
+/// <param name="chunk"> chunk with free space.</param>
+/// <param name="index"> index that the element will have.</param>
+/// <param name="data"> value that will be inserted.</param>
+template <typename T, size_t ChunkBytes, typename Allocator>
+void UnrolledList<T, ChunkBytes, Allocator>::InsertInto(Chunk *chunk,
+                                                        size_t index,
+                                                        T &&data) {
+  T *elements{chunk->Elements()};
+  if (index == chunk->count) {
+    std::construct_at(elements + index, std::move(data));
+  } else {
+    std::construct_at(elements + chunk->count,
+                      std::move(elements[chunk->count - 1]));
+    std::move_backward(elements + index, elements + chunk->count - 1,
+                       elements + chunk->count);
+    elements[index] = std::move(data);
+  }
+  ++chunk->count;
+  ++size_;
+  stats_.Size(size_);
+}
+
+/// <summary>
+/// Erases an element from a chunk, moving the elements after it one place
+/// to the left. A chunk left empty is released, and a chunk that fits into
+/// its neighbour together with it is merged with the neighbour.
+/// </summary>
+/// <param name="chunk"> chunk holding the element.</param>
+/// <param name="index"> index of the element in the chunk.</param>
+template <typename T, size_t ChunkBytes, typename Allocator>
+void UnrolledList<T, ChunkBytes, Allocator>::EraseFrom(Chunk *chunk,
+                                                       size_t index) {
+  T *elements{chunk->Elements()};
+  std::move(elements + index + 1, elements + chunk->count, elements + index);
+  std::destroy_at(elements + chunk->count - 1);
+  --chunk->count;
+  --size_;
+  if (chunk->count == 0) {
+    DestroyChunk(chunk);
+  } else if (chunk->count < kChunkCapacity / 2) {
+    if (chunk->next && chunk->count + chunk->next->count <= kChunkCapacity) {
+      MergeWithNext(chunk);
+    } else if (chunk->previous &&
+               chunk->previous->count + chunk->count <= kChunkCapacity) {
+      MergeWithNext(chunk->previous);
+    }
+  }
+}
+
+/// <summary>
+/// Moves all elements of the next chunk to the end of a given chunk and
+/// releases the next chunk.
+/// </summary>
+/// <param name="chunk"> chunk with room for elements of the next one.</param>
+template <typename T, size_t ChunkBytes, typename Allocator>
+void UnrolledList<T, ChunkBytes, Allocator>::MergeWithNext(Chunk *chunk) {
+  Chunk *next{chunk->next};
+  T *source{next->Elements()};
+  std::uninitialized_move(source, source + next->count,
+                          chunk->Elements() + chunk->count);
+  std::destroy(source, source + next->count);
+  stats_.Reallocation(next->count * sizeof(T));
+  chunk->count += next->count;
+  next->count = 0;
+  DestroyChunk(next);
+}
+
+/// <summary>
+/// Destroys elements at the end of a chunk, so that a given number of them
+/// remains. A chunk left empty is released.
+/// </summary>
+/// <param name="chunk"> chunk that is shortened.</param>
+/// <param name="count"> number of elements that remain.</param>
+template <typename T, size_t ChunkBytes, typename Allocator>
+void UnrolledList<T, ChunkBytes, Allocator>::Truncate(Chunk *chunk,
+                                                      size_t count) {
+  T *elements{chunk->Elements()};
+  std::destroy(elements + count, elements + chunk->count);
+  size_ -= chunk->count - count;
+  chunk->count = count;
+  if (count == 0) DestroyChunk(chunk);
+}
+
+/// <summary>
+/// Aliases for containers that take memory from a std::pmr::memory_resource.
+/// </summary>
+namespace pmr {
+
+template <typename T, size_t ChunkBytes = kDefaultChunkBytes>
+using UnrolledList = alglib::UnrolledList<T, ChunkBytes,
+                                          std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
+}  // namespace alglib
+
+#endif  // ALGLIB_INCLUDE_UNROLLEDLIST_H_
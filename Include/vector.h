@@ -28,16 +28,31 @@
 // This file contains the implementation of the Vector class. Implementation
 // is based on templates, so the class can be used with any type. Vector class
 // implements an array that can be extended and shrinked. All elements are
-// allocated on the heap. Capacity doubles every time the size exceeds current
-// capacity.
+// allocated on the heap. Every time the size exceeds current capacity, the
+// capacity grows according to the growth policy, doubling by default. Memory
+// is kept as raw storage and elements are constructed only when they are
+// added to the vector.
 //*****************************************************************************
 
 #ifndef ALGLIB_INCLUDE_VECTOR_H_
 #define ALGLIB_INCLUDE_VECTOR_H_
 
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <iterator>
+#include <new>
+#include <span>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 #include "constants.h"
+#include "growth_policy.h"
+#include "stats.h"
 
 /// <summary>
 /// Default namespace for the AlgLib library.
@@ -46,17 +61,40 @@ namespace alglib {
 
 // Declarations for Vector class. Implementations under vector class.
 template <typename VectorType> class VectorIter;
-template <typename VectorType> class ConstVectorIter;
-template <typename VectorType> class ReverseVectorIter;
-template <typename VectorType> class ConstReverseVectorIter;
+
+/// <summary>
+/// Iterator for alg-lib's vector that returns constants to disable possibility
+/// of modifying vector contents through it.
+/// </summary>
+template <typename VectorType>
+using ConstVectorIter = VectorIter<const VectorType>;
+
+/// <summary>
+/// Iterators that walk the vector from the last element to the first one.
+/// </summary>
+template <typename VectorType>
+using ReverseVectorIter = std::reverse_iterator<VectorIter<VectorType>>;
+template <typename VectorType>
+using ConstReverseVectorIter =
+    std::reverse_iterator<VectorIter<const VectorType>>;
 
 /// <summary>
 /// Template based vector implementation that uses an array as a base structure.
-/// It allocates memory on the heap, and it can grow dynamically. Capacity
-/// doubles every time the size exceeds current capacity.
+/// It allocates memory on the heap, and it can grow dynamically. Every time
+/// the size exceeds current capacity, new capacity is calculated by the growth
+/// policy, which doubles it by default.
 /// </summary>
 /// <typeparam name="T"> type of data stored in vector.</typeparam>
-template <typename T> class Vector {
+/// <typeparam name="Allocator"> allocator used to obtain memory for
+/// elements.</typeparam>
+/// <typeparam name="Growth"> policy that calculates new capacity when the
+/// vector runs out of memory.</typeparam>
+template <typename T, typename Allocator = std::allocator<T>,
+          typename Growth = DoublingGrowth>
+class Vector {
+  static_assert(GrowthPolicy<Growth>,
+                "Growth has to satisfy the GrowthPolicy concept.");
+
 public:
   using Iterator = VectorIter<T>;
   using IteratorRef = VectorIter<T> &;
@@ -73,14 +111,36 @@ public:
 public:
   // Constructors for vector class;
   Vector() noexcept;
-  Vector(size_t elements) noexcept;
-  Vector(size_t elements, const T &value) noexcept;
+  explicit Vector(const Allocator &allocator,
+                  const Growth &growth = Growth()) noexcept;
+  Vector(size_t elements, const Allocator &allocator = Allocator());
+  Vector(size_t elements, const T &value,
+         const Allocator &allocator = Allocator());
+  Vector(const Vector &other);
+  Vector(const Vector &other, const Allocator &allocator);
+  Vector(Vector &&other) noexcept;
+
+  // Copy and move assignment operators.
+  Vector &operator=(const Vector &other);
+  Vector &operator=(Vector &&other) noexcept(
+      std::allocator_traits<Allocator>::propagate_on_container_move_assignment::
+          value ||
+      std::allocator_traits<Allocator>::is_always_equal::value);
 
   // Inserting and removing elements from the vector.
-  void Push(const T &value) noexcept;
+  void Push(const T &value);
+  void Push(T &&value);
+  template <typename... Args> T &Emplace(Args &&...args);
   void Insert(const T &value, size_t index);
+  void Insert(T &&value, size_t index);
+  template <typename... Args> T &EmplaceAt(size_t index, Args &&...args);
   T Pop();
 
+  // Appending whole ranges at once.
+  template <std::input_iterator InputIt>
+  void Append(InputIt first, InputIt last);
+  void Append(std::span<const T> values);
+
   // Accessing elements in the vector.
   T &At(size_t index);
   const T &At(size_t index) const;
@@ -89,8 +149,18 @@ public:
   size_t Size() const noexcept;
   size_t Capacity() const noexcept;
 
-  // Resizing and shrinking the vector.
-  void Resize(size_t size);
+  // Getting allocator and growth policy of the vector.
+  Allocator GetAllocator() const noexcept;
+  Growth GetGrowthPolicy() const noexcept;
+
+  // Getting statistics of the vector.
+  ContainerStats GetStats() const noexcept;
+
+  // Resizing, reserving and shrinking the vector.
+  void Resize(size_t new_size);
+  void Resize(size_t new_size, const T &value);
+  void Reserve(size_t amount);
+  void Clear() noexcept;
   void ShrinkToFit();
 
   // Getting first and last element of the vector.
@@ -99,30 +169,59 @@ public:
   T &Back();
   const T &Back() const;
 
+  // Accessing underlying contiguous memory.
+  T *Data() noexcept;
+  const T *Data() const noexcept;
+  std::span<T> AsSpan() noexcept;
+  std::span<const T> AsSpan() const noexcept;
+  operator std::span<T>() noexcept;
+  operator std::span<const T>() const noexcept;
+
   // Iterators
-  Iterator begin();
-  Iterator end();
-  ConstIterator cbegin();
-  ConstIterator cend();
-  ReverseIterator rbegin();
-  ReverseIterator rend();
-  ConstReverseIterator crbegin();
-  ConstReverseIterator crend();
-  Iterator Begin();
-  Iterator End();
-  ConstIterator ConstBegin();
-  ConstIterator ConstEnd();
-  ReverseIterator ReverseBegin();
-  ReverseIterator ReverseEnd();
-  ConstReverseIterator ConstReverseBegin();
-  ConstReverseIterator ConstReverseEnd();
+  Iterator begin() noexcept;
+  Iterator end() noexcept;
+  ConstIterator begin() const noexcept;
+  ConstIterator end() const noexcept;
+  ConstIterator cbegin() const noexcept;
+  ConstIterator cend() const noexcept;
+  ReverseIterator rbegin() noexcept;
+  ReverseIterator rend() noexcept;
+  ConstReverseIterator crbegin() const noexcept;
+  ConstReverseIterator crend() const noexcept;
+  Iterator Begin() noexcept;
+  Iterator End() noexcept;
+  ConstIterator ConstBegin() const noexcept;
+  ConstIterator ConstEnd() const noexcept;
+  ReverseIterator ReverseBegin() noexcept;
+  ReverseIterator ReverseEnd() noexcept;
+  ConstReverseIterator ConstReverseBegin() const noexcept;
+  ConstReverseIterator ConstReverseEnd() const noexcept;
 
   ~Vector() noexcept;
 
 private:
+  using AllocatorTraits = std::allocator_traits<Allocator>;
+
   // Method that reallocates memory for the vector.
   void Reallocate(size_t amount);
 
+  // Method that moves elements between two raw memory blocks.
+  void Relocate(T *source, size_t count, T *destination);
+
+  // Method that calculates capacity needed to fit additional elements.
+  size_t GrownCapacity(size_t additional) const;
+
+  // Method that constructs elements at the end until the size is reached.
+  template <typename... Args>
+  void Extend(size_t new_size, const Args &...args);
+
+  // Methods that obtain memory and construct elements through allocator.
+  T *Allocate(size_t amount);
+  void Deallocate(T *block, size_t amount) noexcept;
+  template <typename... Args> void Construct(T *slot, Args &&...args);
+  void Destroy(T *first, size_t count) noexcept;
+  void SwapStorage(Vector &other) noexcept;
+
   /// <summary>
   /// Amount of elements in the vector.
   /// </summary>
@@ -133,381 +232,546 @@ private:
   size_t capacity;
 
   /// <summary>
-  /// Array that holds the data of the vector.
+  /// Raw storage that holds the data of the vector. Only the first size
+  /// elements are constructed.
   /// </summary>
   T *data;
-};
 
-/// <summary>
-/// Iterator for alg-lib's vector. Makes it possible to use for-each style loop.
-/// </summary>
-/// <typeparam name="T"> type of data stored in vector.</typeparam>
-template <typename VectorType> class VectorIter {
-public:
-  VectorIter(VectorType *element_address);
+  /// <summary>
+  /// Allocator that provides memory for the elements.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS Allocator allocator;
 
-  // Operator overloads
-  VectorType &operator*();
-  VectorIter &operator++();
-  VectorIter operator++(VectorType placeholder);
-  bool operator!=(const VectorIter &other);
-  bool operator==(const VectorIter &other);
+  /// <summary>
+  /// Policy that calculates new capacity when the vector grows. It belongs to
+  /// the vector object, so assignments don't change it.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS Growth growth;
 
-private:
   /// <summary>
-  /// Pointer to a specific element of vector
+  /// Statistics of the vector, empty unless ALGLIB_ENABLE_STATS is defined.
+  /// Like the growth policy, they belong to the vector object.
   /// </summary>
-  VectorType *_ptr;
+  ALGLIB_NO_UNIQUE_ADDRESS detail::StatsRecorder stats;
 };
 
 /// <summary>
-/// Iterator for alg-lib's vector. Returns constants to disable possibility of
-/// modifying vector contents through it.
+/// Iterator for alg-lib's vector. It satisfies std::contiguous_iterator, so
+/// it can be used with for-each style loops, all standard algorithms and
+/// ranges. Algorithms that have optimized versions for contiguous memory,
+/// like std::copy on trivially copyable types, use them.
 /// </summary>
-/// <typeparam name="T"> type of data stored in vector.</typeparam>
-template <typename VectorType> class ConstVectorIter {
+/// <typeparam name="VectorType"> type of data stored in vector. Const
+/// qualified type makes a constant iterator.</typeparam>
+template <typename VectorType> class VectorIter {
 public:
-  ConstVectorIter(VectorType *element_address);
-
-  // Operator overloads
-  const VectorType &operator*() const;
-  ConstVectorIter &operator++();
-  ConstVectorIter operator++(VectorType placeholder);
-  bool operator!=(const ConstVectorIter &other) const;
-  bool operator==(const ConstVectorIter &other) const;
+  using iterator_concept = std::contiguous_iterator_tag;
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::remove_cv_t<VectorType>;
+  using element_type = VectorType;
+  using difference_type = std::ptrdiff_t;
+  using pointer = VectorType *;
+  using reference = VectorType &;
+
+  // Constructors
+  VectorIter() noexcept;
+  VectorIter(VectorType *element_address) noexcept;
+  template <typename OtherType>
+    requires std::is_convertible_v<OtherType *, VectorType *>
+  VectorIter(const VectorIter<OtherType> &other) noexcept;
+
+  // Access operators
+  reference operator*() const noexcept;
+  pointer operator->() const noexcept;
+  reference operator[](difference_type offset) const noexcept;
+
+  // Moving operators
+  VectorIter &operator++() noexcept;
+  VectorIter operator++(int) noexcept;
+  VectorIter &operator--() noexcept;
+  VectorIter operator--(int) noexcept;
+  VectorIter &operator+=(difference_type offset) noexcept;
+  VectorIter &operator-=(difference_type offset) noexcept;
+  VectorIter operator+(difference_type offset) const noexcept;
+  VectorIter operator-(difference_type offset) const noexcept;
+  difference_type operator-(const VectorIter &other) const noexcept;
+
+  // Comparison operators
+  bool operator==(const VectorIter &other) const noexcept;
+  std::strong_ordering operator<=>(const VectorIter &other) const noexcept;
 
-private:
   /// <summary>
-  /// Pointer to a specific element of vector
+  /// Moves the iterator forward by a given offset, with the offset on the left.
   /// </summary>
-  const VectorType *_ptr;
-};
-
-template <typename VectorType> class ReverseVectorIter {
-public:
-  ReverseVectorIter(VectorType *element_address);
-
-  // Operator overloads
-  VectorType &operator*();
-  ReverseVectorIter &operator++();
-  ReverseVectorIter operator++(VectorType placeholder);
-  bool operator!=(const ReverseVectorIter &other);
-  bool operator==(const ReverseVectorIter &other);
+  friend VectorIter operator+(difference_type offset,
+                              const VectorIter &iter) noexcept {
+    return iter + offset;
+  }
 
 private:
+  template <typename OtherType> friend class VectorIter;
+
   /// <summary>
   /// Pointer to a specific element of vector
   /// </summary>
   VectorType *_ptr;
 };
 
-template <typename VectorType> class ConstReverseVectorIter {
-public:
-  ConstReverseVectorIter(VectorType *element_address);
-
-  // Operator overloads
-  const VectorType &operator*() const;
-  ConstReverseVectorIter &operator++();
-  ConstReverseVectorIter operator++(VectorType placeholder);
-  bool operator!=(const ConstReverseVectorIter &other) const;
-  bool operator==(const ConstReverseVectorIter &other) const;
-
-private:
-  /// <summary>
-  /// Pointer to a specific element of vector
-  /// </summary>
-  const VectorType *_ptr;
-};
+/// <summary>
+/// Default constructor creating iterator that doesn't point to any element.
+/// </summary>
+template <typename VectorType>
+VectorIter<VectorType>::VectorIter() noexcept : _ptr(nullptr) {}
 
 /// <summary>
 /// Constructor initialising the that iterator points to to argument value;
 /// </summary>
 template <typename VectorType>
-VectorIter<VectorType>::VectorIter(VectorType *element_address) {
-  _ptr = element_address;
-}
+VectorIter<VectorType>::VectorIter(VectorType *element_address) noexcept
+    : _ptr(element_address) {}
+
+/// <summary>
+/// Converting constructor, used to make constant iterator from a mutable one.
+/// </summary>
+template <typename VectorType>
+template <typename OtherType>
+  requires std::is_convertible_v<OtherType *, VectorType *>
+VectorIter<VectorType>::VectorIter(const VectorIter<OtherType> &other) noexcept
+    : _ptr(other._ptr) {}
 
 /// <summary>
 /// Dereferences held pointer to get the value of vector element.
 /// </summary>
-template <typename VectorType> VectorType &VectorIter<VectorType>::operator*() {
+template <typename VectorType>
+typename VectorIter<VectorType>::reference
+VectorIter<VectorType>::operator*() const noexcept {
   return *_ptr;
 }
 
 /// <summary>
-/// Pre-increment. Makes the iterator point to the next element in vector.
+/// Returns held pointer to access members of vector element.
 /// </summary>
 template <typename VectorType>
-VectorIter<VectorType> &VectorIter<VectorType>::operator++() {
-  ++_ptr;
-  return *this;
+typename VectorIter<VectorType>::pointer
+VectorIter<VectorType>::operator->() const noexcept {
+  return _ptr;
 }
 
 /// <summary>
-/// Post-increment. Makes the iterator point to the next element in vector.
+/// Gets the element that is a given offset away from the iterator.
 /// </summary>
 template <typename VectorType>
-VectorIter<VectorType>
-VectorIter<VectorType>::operator++(VectorType placeholder) {
-  VectorIter<VectorType> tmp = *this;
-  ++(this->_ptr);
-  return tmp;
+typename VectorIter<VectorType>::reference
+VectorIter<VectorType>::operator[](difference_type offset) const noexcept {
+  return _ptr[offset];
 }
 
 /// <summary>
-/// Checks inequality of two iterators.
+/// Pre-increment. Makes the iterator point to the next element in vector.
 /// </summary>
 template <typename VectorType>
-bool VectorIter<VectorType>::operator!=(const VectorIter &other) {
-  return this->_ptr != other._ptr;
+VectorIter<VectorType> &VectorIter<VectorType>::operator++() noexcept {
+  ++_ptr;
+  return *this;
 }
 
 /// <summary>
-/// Checks equality of two iterators.
+/// Post-increment. Makes the iterator point to the next element in vector.
 /// </summary>
 template <typename VectorType>
-bool VectorIter<VectorType>::operator==(const VectorIter &other) {
-  return this->_ptr == other._ptr;
+VectorIter<VectorType> VectorIter<VectorType>::operator++(int) noexcept {
+  VectorIter<VectorType> tmp = *this;
+  ++_ptr;
+  return tmp;
 }
 
 /// <summary>
-/// Constructor initialising the that iterator points to to argument value;
+/// Pre-decrement. Makes the iterator point to the previous element in vector.
 /// </summary>
 template <typename VectorType>
-ConstVectorIter<VectorType>::ConstVectorIter(VectorType *element_address) {
-  _ptr = element_address;
+VectorIter<VectorType> &VectorIter<VectorType>::operator--() noexcept {
+  --_ptr;
+  return *this;
 }
 
 /// <summary>
-/// Dereferences held pointer to get the value of vector element.
+/// Post-decrement. Makes the iterator point to the previous element in vector.
 /// </summary>
 template <typename VectorType>
-const VectorType &ConstVectorIter<VectorType>::operator*() const {
-  return *_ptr;
+VectorIter<VectorType> VectorIter<VectorType>::operator--(int) noexcept {
+  VectorIter<VectorType> tmp = *this;
+  --_ptr;
+  return tmp;
 }
 
 /// <summary>
-/// Pre-increment. Makes the iterator point to the next element in vector.
+/// Moves the iterator forward by a given offset.
 /// </summary>
 template <typename VectorType>
-ConstVectorIter<VectorType> &ConstVectorIter<VectorType>::operator++() {
-  ++_ptr;
+VectorIter<VectorType> &
+VectorIter<VectorType>::operator+=(difference_type offset) noexcept {
+  _ptr += offset;
   return *this;
 }
 
 /// <summary>
-/// Post-increment. Makes the iterator point to the next element in vector.
+/// Moves the iterator backward by a given offset.
 /// </summary>
 template <typename VectorType>
-ConstVectorIter<VectorType>
-ConstVectorIter<VectorType>::operator++(VectorType placeholder) {
-  ConstVectorIter<VectorType> tmp = *this;
-  ++(this->_ptr);
-  return tmp;
+VectorIter<VectorType> &
+VectorIter<VectorType>::operator-=(difference_type offset) noexcept {
+  _ptr -= offset;
+  return *this;
 }
 
 /// <summary>
-/// Checks inequality of two iterators.
+/// Returns iterator that is a given offset after this one.
 /// </summary>
 template <typename VectorType>
-bool ConstVectorIter<VectorType>::operator!=(
-    const ConstVectorIter &other) const {
-  return this->_ptr != other._ptr;
+VectorIter<VectorType>
+VectorIter<VectorType>::operator+(difference_type offset) const noexcept {
+  return VectorIter(_ptr + offset);
 }
 
 /// <summary>
-/// Checks equality of two iterators.
+/// Returns iterator that is a given offset before this one.
 /// </summary>
 template <typename VectorType>
-bool ConstVectorIter<VectorType>::operator==(
-    const ConstVectorIter &other) const {
-  return this->_ptr == other._ptr;
+VectorIter<VectorType>
+VectorIter<VectorType>::operator-(difference_type offset) const noexcept {
+  return VectorIter(_ptr - offset);
 }
 
 /// <summary>
-/// Constructor initialising the that iterator points to to argument value;
+/// Calculates distance between two iterators.
 /// </summary>
 template <typename VectorType>
-ReverseVectorIter<VectorType>::ReverseVectorIter(VectorType *element_address) {
-  _ptr = element_address;
+typename VectorIter<VectorType>::difference_type
+VectorIter<VectorType>::operator-(const VectorIter &other) const noexcept {
+  return _ptr - other._ptr;
 }
 
 /// <summary>
-/// Dereferences held pointer to get the value of vector element.
+/// Checks equality of two iterators. Inequality is generated from it.
 /// </summary>
 template <typename VectorType>
-VectorType &ReverseVectorIter<VectorType>::operator*() {
-  return *_ptr;
+bool VectorIter<VectorType>::operator==(
+    const VectorIter &other) const noexcept {
+  return _ptr == other._ptr;
 }
 
 /// <summary>
-/// Pre-increment. Makes the iterator point to the next element in vector.
+/// Compares positions of two iterators. Relational operators are generated
+/// from it.
 /// </summary>
 template <typename VectorType>
-ReverseVectorIter<VectorType> &ReverseVectorIter<VectorType>::operator++() {
-  --_ptr;
-  return *this;
+std::strong_ordering
+VectorIter<VectorType>::operator<=>(const VectorIter &other) const noexcept {
+  return _ptr <=> other._ptr;
 }
 
 /// <summary>
-/// Post-increment. Makes the iterator point to the next element in vector.
+/// No argument constructor for the vector class. It initializes the vector with
+/// default values. Memory is allocated lazily, space for the first elements
+/// is allocated when the first element is added.
 /// </summary>
-template <typename VectorType>
-ReverseVectorIter<VectorType>
-ReverseVectorIter<VectorType>::operator++(VectorType placeholder) {
-  ReverseVectorIter<VectorType> tmp = *this;
-  --(this->_ptr);
-  return tmp;
-}
+template <typename T, typename Allocator, typename Growth>
+Vector<T, Allocator, Growth>::Vector() noexcept
+    : size(0), capacity(0), data(nullptr), allocator(), growth() {}
 
 /// <summary>
-/// Checks inequality of two iterators.
+/// Constructor that initializes the vector with a given allocator and growth
+/// policy. All memory of the vector will be obtained from the allocator. Just
+/// like in the default constructor, nothing is allocated until the first
+/// element is added.
 /// </summary>
-template <typename VectorType>
-bool ReverseVectorIter<VectorType>::operator!=(const ReverseVectorIter &other) {
-  return this->_ptr != other._ptr;
-}
+/// <param name="allocator"> allocator used by the vector.</param>
+/// <param name="growth"> growth policy used by the vector.</param>
+template <typename T, typename Allocator, typename Growth>
+Vector<T, Allocator, Growth>::Vector(const Allocator &allocator,
+                                     const Growth &growth) noexcept
+    : size(0), capacity(0), data(nullptr), allocator(allocator),
+      growth(growth) {}
 
 /// <summary>
-/// Checks equality of two iterators.
+/// Constructor that initializes the vector with a given number of elements.
+/// Memory is only reserved, no element is constructed.
 /// </summary>
-template <typename VectorType>
-bool ReverseVectorIter<VectorType>::operator==(const ReverseVectorIter &other) {
-  return this->_ptr == other._ptr;
+/// <param name="elements"> amount of elements that will be initially
+/// allocated.</param>
+/// <param name="allocator"> allocator used by the vector.</param>
+template <typename T, typename Allocator, typename Growth>
+Vector<T, Allocator, Growth>::Vector(size_t elements,
+                                     const Allocator &allocator)
+    : size(0), capacity(0), data(nullptr), allocator(allocator), growth() {
+  Reallocate(elements);
 }
 
 /// <summary>
-/// Constructor initialising the that iterator points to to argument value;
+/// Constructor that initializes the vector to a given number of elements with a
+/// given value. Only the live range is constructed, so the size of the vector
+/// is equal to the amount of elements. If copying the value throws, the
+/// elements constructed so far are destroyed and the storage is released.
 /// </summary>
-template <typename VectorType>
-ConstReverseVectorIter<VectorType>::ConstReverseVectorIter(
-    VectorType *element_address) {
-  _ptr = element_address;
+/// <param name="elements"> amount of elements that will be initially
+/// allocated. </param>
+/// <param name="value"> value that all the elements will be
+/// initialised to.</param>
+/// <param name="allocator"> allocator used by the vector.</param>
+template <typename T, typename Allocator, typename Growth>
+Vector<T, Allocator, Growth>::Vector(size_t elements, const T &value,
+                                     const Allocator &allocator)
+    : size(0), capacity(0), data(nullptr), allocator(allocator), growth() {
+  Reallocate(elements);
+  ALGLIB_TRY {
+    for (; size < elements; ++size) {
+      Construct(data + size, value);
+    }
+  } ALGLIB_CATCH_ALL {
+    Destroy(data, size);
+    Deallocate(data, capacity);
+    ALGLIB_RETHROW;
+  }
 }
 
 /// <summary>
-/// Dereferences held pointer to get the value of vector element.
+/// Copy constructor. Allocates exactly as much memory as the other vector
+/// holds elements and copy constructs them. The allocator is selected with
+/// select_on_container_copy_construction.
 /// </summary>
-template <typename VectorType>
-const VectorType &ConstReverseVectorIter<VectorType>::operator*() const {
-  return *_ptr;
-}
+/// <param name="other"> vector that will be copied.</param>
+template <typename T, typename Allocator, typename Growth>
+Vector<T, Allocator, Growth>::Vector(const Vector &other)
+    : Vector(other, AllocatorTraits::select_on_container_copy_construction(
+                        other.allocator)) {}
 
 /// <summary>
-/// Pre-increment. Makes the iterator point to the next element in vector.
+/// Copy constructor that uses a given allocator for the copy. Growth policy is
+/// copied from the other vector. If copying an element throws, the storage of
+/// the new vector is released.
 /// </summary>
-template <typename VectorType>
-ConstReverseVectorIter<VectorType> &
-ConstReverseVectorIter<VectorType>::operator++() {
-  --_ptr;
-  return *this;
+/// <param name="other"> vector that will be copied.</param>
+/// <param name="allocator"> allocator used by the new vector.</param>
+template <typename T, typename Allocator, typename Growth>
+Vector<T, Allocator, Growth>::Vector(const Vector &other,
+                                     const Allocator &allocator)
+    : size(0), capacity(0), data(nullptr), allocator(allocator),
+      growth(other.growth) {
+  Reallocate(other.size);
+  ALGLIB_TRY {
+    Append(other.data, other.data + other.size);
+  } ALGLIB_CATCH_ALL {
+    Destroy(data, size);
+    Deallocate(data, capacity);
+    ALGLIB_RETHROW;
+  }
 }
 
 /// <summary>
-/// Post-increment. Makes the iterator point to the next element in vector.
+/// Move constructor. Takes over the memory and the allocator of the other
+/// vector, which is left empty and without any allocated memory.
 /// </summary>
-template <typename VectorType>
-ConstReverseVectorIter<VectorType>
-ConstReverseVectorIter<VectorType>::operator++(VectorType placeholder) {
-  ConstReverseVectorIter<VectorType> tmp = *this;
-  --(this->_ptr);
-  return tmp;
+/// <param name="other"> vector that will be moved from.</param>
+template <typename T, typename Allocator, typename Growth>
+Vector<T, Allocator, Growth>::Vector(Vector &&other) noexcept
+    : size(other.size),
+      capacity(other.capacity),
+      data(other.data),
+      allocator(std::move(other.allocator)),
+      growth(std::move(other.growth)) {
+  other.size = 0;
+  other.capacity = 0;
+  other.data = nullptr;
 }
 
 /// <summary>
-/// Checks inequality of two iterators.
+/// Copy assignment operator. Uses copy and swap, so the vector is left
+/// untouched if copying of any element throws. The allocator of the other
+/// vector is taken only if the allocator propagates on copy assignment.
 /// </summary>
-template <typename VectorType>
-bool ConstReverseVectorIter<VectorType>::operator!=(
-    const ConstReverseVectorIter &other) const {
-  return this->_ptr != other._ptr;
+/// <param name="other"> vector that will be copied.</param>
+/// <returns> reference to this vector.</returns>
+template <typename T, typename Allocator, typename Growth>
+Vector<T, Allocator, Growth> &
+Vector<T, Allocator, Growth>::operator=(const Vector &other) {
+  if (this != &other) {
+    constexpr bool kPropagate{
+        AllocatorTraits::propagate_on_container_copy_assignment::value};
+    Vector tmp(other, kPropagate ? other.allocator : allocator);
+    SwapStorage(tmp);
+    if constexpr (kPropagate) {
+      std::swap(allocator, tmp.allocator);
+    }
+  }
+  return *this;
 }
 
 /// <summary>
-/// Checks equality of two iterators.
+/// Move assignment operator. Swaps memory with the other vector, so the old
+/// elements are released when the other vector is destroyed. If the allocator
+/// doesn't propagate and the allocators differ, memory can't be shared and the
+/// elements are moved one by one instead.
 /// </summary>
-template <typename VectorType>
-bool ConstReverseVectorIter<VectorType>::operator==(
-    const ConstReverseVectorIter &other) const {
-  return this->_ptr == other._ptr;
+/// <param name="other"> vector that will be moved from.</param>
+/// <returns> reference to this vector.</returns>
+template <typename T, typename Allocator, typename Growth>
+Vector<T, Allocator, Growth> &
+Vector<T, Allocator, Growth>::operator=(Vector &&other) noexcept(
+    std::allocator_traits<Allocator>::propagate_on_container_move_assignment::
+        value ||
+    std::allocator_traits<Allocator>::is_always_equal::value) {
+  if constexpr (AllocatorTraits::propagate_on_container_move_assignment::
+                    value) {
+    SwapStorage(other);
+    std::swap(allocator, other.allocator);
+  } else {
+    if (allocator == other.allocator) {
+      SwapStorage(other);
+    } else {
+      Vector tmp(other.size, allocator);
+      for (; tmp.size < other.size; ++tmp.size) {
+        tmp.Construct(tmp.data + tmp.size, std::move(other.data[tmp.size]));
+      }
+      SwapStorage(tmp);
+    }
+  }
+  return *this;
 }
 
 /// <summary>
-/// No argument constructor for the vector class. It initializes the vector with
-/// default values. It allocates memory for 4 elements.
+/// Adds a copy of the value to the end of the vector. If the size exceeds the
+/// capacity, the capacity is grown by the growth policy.
 /// </summary>
-template <typename T>
-Vector<T>::Vector() noexcept : size(0), capacity(0), data(nullptr) {
-  Reallocate(4);
+/// <param name="value"> value to be added.</param>
+template <typename T, typename Allocator, typename Growth>
+void Vector<T, Allocator, Growth>::Push(const T &value) {
+  Emplace(value);
 }
 
 /// <summary>
-/// Constructor that initializes the vector with a given number of elements.
+/// Moves the value to the end of the vector. If the size exceeds the
+/// capacity, the capacity is grown by the growth policy.
 /// </summary>
-/// <param name="elements"> amount of elements that will be initially
-/// allocated.</param>
-template <typename T>
-Vector<T>::Vector(size_t elements) noexcept
-    : size(0), capacity(0), data(nullptr) {
-  Reallocate(elements);
+/// <param name="value"> value to be added.</param>
+template <typename T, typename Allocator, typename Growth>
+void Vector<T, Allocator, Growth>::Push(T &&value) {
+  Emplace(std::move(value));
 }
 
 /// <summary>
-/// Constructor that initializes the vector to a given number of elements with a
-/// given value. All elements will be set to the given value.
+/// Constructs a new element in place at the end of the vector. If the size
+/// exceeds the capacity, the capacity is grown. When memory is reallocated,
+/// the new element is constructed before old elements are relocated, so the
+/// arguments may refer to elements of the same vector.
 /// </summary>
-/// <param name="elements"> amount of elements that will be initially
-/// allocated. </param>
-/// <param name="value"> value that all the elements will be
-/// initialised to.</param>
-template <typename T>
-Vector<T>::Vector(size_t elements, const T &value) noexcept
-    : size(0), capacity(0), data(nullptr) {
-  Reallocate(elements);
-  for (size_t i{}; i < capacity; ++i) {
-    data[i] = value;
+/// <param name="args"> arguments passed to the constructor of T.</param>
+/// <returns> reference to the new element.</returns>
+template <typename T, typename Allocator, typename Growth>
+template <typename... Args>
+T &Vector<T, Allocator, Growth>::Emplace(Args &&...args) {
+  if (size < capacity) {
+    Construct(data + size, std::forward<Args>(args)...);
+    stats.Size(size + 1);
+    return data[size++];
+  }
+  const size_t new_capacity{GrownCapacity(1)};
+  T *new_data{Allocate(new_capacity)};
+  ALGLIB_TRY {
+    Construct(new_data + size, std::forward<Args>(args)...);
+  } ALGLIB_CATCH_ALL {
+    Deallocate(new_data, new_capacity);
+    ALGLIB_RETHROW;
+  }
+  ALGLIB_TRY {
+    Relocate(data, size, new_data);
+  } ALGLIB_CATCH_ALL {
+    Destroy(new_data + size, 1);
+    Deallocate(new_data, new_capacity);
+    ALGLIB_RETHROW;
   }
+  Destroy(data, size);
+  Deallocate(data, capacity);
+  data = new_data;
+  capacity = new_capacity;
+  stats.Size(size + 1);
+  return data[size++];
 }
 
 /// <summary>
-/// Adds a new element to the end of the vector. If the size exceeds the
-/// capacity, the capacity is doubled.
+/// Inserts a copy of the value at a given index. If the index is out of
+/// range, an exception is thrown. If the size exceeds the capacity, the
+/// capacity is grown just like in the Push method.
 /// </summary>
-/// <param name="value"> value to be added.</param>
-template <typename T> void Vector<T>::Push(const T &value) noexcept {
-  if (size >= capacity) {
-    Reallocate(capacity * 2);
-  }
-  data[size++] = value;
+/// <param name="value"> value to be inserted.</param>
+/// <param name="index"> inserting position.</param>
+template <typename T, typename Allocator, typename Growth>
+void Vector<T, Allocator, Growth>::Insert(const T &value, size_t index) {
+  EmplaceAt(index, value);
 }
 
 /// <summary>
-/// Inserts a new element at a given index. If the index is out of range, an
+/// Moves the value into a given index. If the index is out of range, an
 /// exception is thrown. If the size exceeds the capacity, the capacity is
-/// doubled just like in the Push method.
+/// grown just like in the Push method.
 /// </summary>
 /// <param name="value"> value to be inserted.</param>
 /// <param name="index"> inserting position.</param>
-template <typename T> void Vector<T>::Insert(const T &value, size_t index) {
+template <typename T, typename Allocator, typename Growth>
+void Vector<T, Allocator, Growth>::Insert(T &&value, size_t index) {
+  EmplaceAt(index, std::move(value));
+}
+
+/// <summary>
+/// Constructs a new element at a given index. If the index is out of range,
+/// an exception is thrown. Elements after the index are moved one slot to the
+/// right. Inserting at the end is the same as calling Emplace.
+/// </summary>
+/// <param name="index"> inserting position.</param>
+/// <param name="args"> arguments passed to the constructor of T.</param>
+/// <returns> reference to the new element.</returns>
+template <typename T, typename Allocator, typename Growth>
+template <typename... Args>
+T &Vector<T, Allocator, Growth>::EmplaceAt(size_t index, Args &&...args) {
   if (index > size) {
-    throw std::runtime_error(errors::kIndexOutOfRange);
+    ALGLIB_THROW(std::runtime_error(errors::kIndexOutOfRange));
   }
-  if (size + 1 > capacity) {
-    Reallocate(capacity == 0 ? 1 : capacity * 2);
+  if (index == size) {
+    return Emplace(std::forward<Args>(args)...);
   }
-  for (size_t i{size}; i > index; --i) {
-    data[i] = data[i - 1];
+  T value(std::forward<Args>(args)...);
+  if (size >= capacity) {
+    Reallocate(GrownCapacity(1));
   }
-  data[index] = value;
-  size++;
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    std::memmove(static_cast<void *>(data + index + 1), data + index,
+                 (size - index) * sizeof(T));
+    Construct(data + index, std::move(value));
+  } else {
+    Construct(data + size, std::move(data[size - 1]));
+    std::move_backward(data + index, data + size - 1, data + size);
+    data[index] = std::move(value);
+  }
+  ++size;
+  stats.Size(size);
+  return data[index];
 }
 
 /// <summary>
-/// Returns the last element of the vector and removes it from the vector by
-/// decrementing the size.
+/// Returns the last element of the vector and removes it from the vector.
+/// The removed element is destroyed. If the vector is empty, an exception is
+/// thrown.
 /// </summary>
 /// <returns> last element of the vector.</returns>
-template <typename T> T Vector<T>::Pop() { return data[size--]; }
+template <typename T, typename Allocator, typename Growth>
+T Vector<T, Allocator, Growth>::Pop() {
+  if (size == 0) {
+    ALGLIB_THROW(std::runtime_error(errors::kEmptyDeletion));
+  }
+  T result(std::move(data[size - 1]));
+  Destroy(data + size - 1, 1);
+  --size;
+  return result;
+}
 
 /// <summary>
 /// Returns the element at a given index. If the index is out of range, an
@@ -515,9 +779,10 @@ template <typename T> T Vector<T>::Pop() { return data[size--]; }
 /// </summary>
 /// <param name="index"> index of element to return.</param>
 /// <returns> element at a given index.</returns>
-template <typename T> T &Vector<T>::At(size_t index) {
+template <typename T, typename Allocator, typename Growth>
+T &Vector<T, Allocator, Growth>::At(size_t index) {
   if (index >= size) {
-    throw std::runtime_error(errors::kIndexOutOfRange);
+    ALGLIB_THROW(std::runtime_error(errors::kIndexOutOfRange));
   }
   return data[index];
 }
@@ -528,9 +793,10 @@ template <typename T> T &Vector<T>::At(size_t index) {
 /// </summary>
 /// <param name="index"> index of element to return.</param>
 /// <returns> element at a given index.</returns>
-template <typename T> const T &Vector<T>::At(size_t index) const {
+template <typename T, typename Allocator, typename Growth>
+const T &Vector<T, Allocator, Growth>::At(size_t index) const {
   if (index >= size) {
-    throw std::runtime_error(errors::kIndexOutOfRange);
+    ALGLIB_THROW(std::runtime_error(errors::kIndexOutOfRange));
   }
   return data[index];
 }
@@ -539,188 +805,608 @@ template <typename T> const T &Vector<T>::At(size_t index) const {
 /// Return amount of elements in the vector.
 /// </summary>
 /// <returns> amount of elements in the vector.</returns>
-template <typename T> size_t Vector<T>::Size() const noexcept { return size; }
+template <typename T, typename Allocator, typename Growth>
+size_t Vector<T, Allocator, Growth>::Size() const noexcept {
+  return size;
+}
 
 /// <summary>
 /// Returns current maximum capacity of the vector.
 /// </summary>
 /// <returns> current maximum capacity of the vector.</returns>
-template <typename T> size_t Vector<T>::Capacity() const noexcept {
+template <typename T, typename Allocator, typename Growth>
+size_t Vector<T, Allocator, Growth>::Capacity() const noexcept {
   return capacity;
 }
 
+/// <summary>
+/// Returns a copy of the allocator used by the vector.
+/// </summary>
+/// <returns> allocator of the vector.</returns>
+template <typename T, typename Allocator, typename Growth>
+Allocator Vector<T, Allocator, Growth>::GetAllocator() const noexcept {
+  return allocator;
+}
+
+/// <summary>
+/// Returns a copy of the growth policy used by the vector.
+/// </summary>
+/// <returns> growth policy of the vector.</returns>
+template <typename T, typename Allocator, typename Growth>
+Growth Vector<T, Allocator, Growth>::GetGrowthPolicy() const noexcept {
+  return growth;
+}
+
+/// <summary>
+/// Returns statistics of the vector. It records allocations, deallocations,
+/// reallocations with the bytes moved by them and the biggest size. Without
+/// ALGLIB_ENABLE_STATS all counters are zero.
+/// </summary>
+/// <returns> statistics of the vector.</returns>
+template <typename T, typename Allocator, typename Growth>
+ContainerStats Vector<T, Allocator, Growth>::GetStats() const noexcept {
+  return stats.Get();
+}
+
 /// <summary>
 /// Modifies the size of the vector. If the new size is smaller than the current
-/// size, the vector is truncated. If the new size is larger than the current
-/// size, the vector is extended.
+/// size, the vector is truncated and the capacity is kept. If the new size is
+/// larger than the current size, the new elements are value initialized.
 /// </summary>
-/// <param name="size"> new size.</param>
-template <typename T> void Vector<T>::Resize(size_t size) { Reallocate(size); }
+/// <param name="new_size"> new size.</param>
+template <typename T, typename Allocator, typename Growth>
+void Vector<T, Allocator, Growth>::Resize(size_t new_size) {
+  if (new_size <= size) {
+    Destroy(data + new_size, size - new_size);
+    size = new_size;
+    return;
+  }
+  Extend(new_size);
+}
+
+/// <summary>
+/// Modifies the size of the vector. If the new size is smaller than the current
+/// size, the vector is truncated and the capacity is kept. If the new size is
+/// larger than the current size, the new elements are copies of a given value.
+/// The value may refer to an element of the same vector.
+/// </summary>
+/// <param name="new_size"> new size.</param>
+/// <param name="value"> value that the new elements will be initialised
+/// to.</param>
+template <typename T, typename Allocator, typename Growth>
+void Vector<T, Allocator, Growth>::Resize(size_t new_size, const T &value) {
+  if (new_size <= size) {
+    Destroy(data + new_size, size - new_size);
+    size = new_size;
+    return;
+  }
+  if (new_size > capacity) {
+    const T copy(value);
+    Extend(new_size, copy);
+  } else {
+    Extend(new_size, value);
+  }
+}
+
+/// <summary>
+/// Makes sure that the vector can hold a given amount of elements without
+/// reallocating. Capacity is never decreased, so the size is not changed.
+/// </summary>
+/// <param name="amount"> amount of elements to reserve memory for.</param>
+template <typename T, typename Allocator, typename Growth>
+void Vector<T, Allocator, Growth>::Reserve(size_t amount) {
+  if (amount > capacity) {
+    Reallocate(amount);
+  }
+}
+
+/// <summary>
+/// Destroys all elements of the vector. Memory is kept, so the vector can be
+/// filled again without reallocating.
+/// </summary>
+template <typename T, typename Allocator, typename Growth>
+void Vector<T, Allocator, Growth>::Clear() noexcept {
+  Destroy(data, size);
+  size = 0;
+}
 
 /// <summary>
 /// Shrinks the capacity of the vector to the current size by
 /// reallocating memory with the size of the vector.
 /// </summary>
-template <typename T> void Vector<T>::ShrinkToFit() { Reallocate(size); }
+template <typename T, typename Allocator, typename Growth>
+void Vector<T, Allocator, Growth>::ShrinkToFit() {
+  Reallocate(size);
+}
 
 /// <summary>
 /// Returns the first element of the vector.
 /// </summary>
 /// <returns> first element of the vector.</returns>
-template <typename T> T &Vector<T>::Front() { return data[0]; }
+template <typename T, typename Allocator, typename Growth>
+T &Vector<T, Allocator, Growth>::Front() {
+  return data[0];
+}
 
 /// <summary>
 /// Returns the first element of the vector.
 /// </summary>
 /// <returns> first element of the vector.</returns>
-template <typename T> const T &Vector<T>::Front() const { return data[0]; }
+template <typename T, typename Allocator, typename Growth>
+const T &Vector<T, Allocator, Growth>::Front() const {
+  return data[0];
+}
 
 /// <summary>
 /// Returns the last element of the vector.
 /// </summary>
 /// <returns> last element of the vector.</returns>
-template <typename T> T &Vector<T>::Back() { return data[size - 1]; }
+template <typename T, typename Allocator, typename Growth>
+T &Vector<T, Allocator, Growth>::Back() {
+  return data[size - 1];
+}
 
 /// <summary>
 /// Returns the last element of the vector.
 /// </summary>
 /// <returns> last element of the vector.</returns>
-template <typename T> const T &Vector<T>::Back() const {
+template <typename T, typename Allocator, typename Growth>
+const T &Vector<T, Allocator, Growth>::Back() const {
   return data[size - 1];
 }
 
 /// <summary>
-/// Deletes the vector and deallocates memory.
+/// Destroys all live elements and returns memory to the allocator.
 /// </summary>
-template <typename T> Vector<T>::~Vector() noexcept { delete[] data; }
+template <typename T, typename Allocator, typename Growth>
+Vector<T, Allocator, Growth>::~Vector() noexcept {
+  Destroy(data, size);
+  Deallocate(data, capacity);
+}
+
+/// <summary>
+/// Appends all elements from a range to the end of the vector. For forward
+/// ranges the capacity grows at most once, to fit all the new elements.
+/// The range must not refer to elements of this vector.
+/// </summary>
+/// <param name="first"> iterator to the first element to append.</param>
+/// <param name="last"> iterator past the last element to append.</param>
+template <typename T, typename Allocator, typename Growth>
+template <std::input_iterator InputIt>
+void Vector<T, Allocator, Growth>::Append(InputIt first, InputIt last) {
+  if constexpr (std::forward_iterator<InputIt>) {
+    const size_t count{static_cast<size_t>(std::distance(first, last))};
+    if (size + count > capacity) {
+      Reallocate(GrownCapacity(count));
+    }
+    if constexpr (std::contiguous_iterator<InputIt> &&
+                  std::is_trivially_copyable_v<T> &&
+                  std::is_same_v<std::iter_value_t<InputIt>, T>) {
+      if (count != 0) {
+        std::memcpy(static_cast<void *>(data + size), std::to_address(first),
+                    count * sizeof(T));
+      }
+      size += count;
+      stats.Size(size);
+    } else {
+      const size_t old_size{size};
+      ALGLIB_TRY {
+        for (; first != last; ++first, ++size) {
+          Construct(data + size, *first);
+        }
+      } ALGLIB_CATCH_ALL {
+        Destroy(data + old_size, size - old_size);
+        size = old_size;
+        ALGLIB_RETHROW;
+      }
+      stats.Size(size);
+    }
+  } else {
+    for (; first != last; ++first) {
+      Emplace(*first);
+    }
+  }
+}
+
+/// <summary>
+/// Appends all elements from a span to the end of the vector. The capacity
+/// grows at most once and trivially copyable elements are copied with a
+/// single memcpy.
+/// </summary>
+/// <param name="values"> elements to append.</param>
+template <typename T, typename Allocator, typename Growth>
+void Vector<T, Allocator, Growth>::Append(std::span<const T> values) {
+  Append(values.begin(), values.end());
+}
 
 /// <summary>
-/// Reallocates memory for the vector. It copies all the elements from the old
-/// array to the new array. If the new capacity is smaller than the current
-/// size, the size is truncated.
+/// Reallocates memory for the vector. The new block is raw storage, so only
+/// live elements are constructed in it. If the new capacity is smaller than
+/// the current size, the size is truncated and the elements that don't fit
+/// are destroyed.
 /// </summary>
 /// <param name="amount"> new amount of elements.</param>
-template <typename T> void Vector<T>::Reallocate(size_t amount) {
-  T *new_data{new T[amount]};
-  size = (amount < size) ? amount : size;
-  for (size_t i{}; i < size; ++i) {
-    new_data[i] = data[i];
+template <typename T, typename Allocator, typename Growth>
+void Vector<T, Allocator, Growth>::Reallocate(size_t amount) {
+  T *new_data{Allocate(amount)};
+  const size_t kept{amount < size ? amount : size};
+  ALGLIB_TRY {
+    Relocate(data, kept, new_data);
+  } ALGLIB_CATCH_ALL {
+    Deallocate(new_data, amount);
+    ALGLIB_RETHROW;
   }
-  delete[] data;
+  Destroy(data, size);
+  Deallocate(data, capacity);
   data = new_data;
+  size = kept;
   capacity = amount;
 }
 
+/// <summary>
+/// Constructs count elements in destination memory from the elements in
+/// source memory. Trivially copyable elements are copied with a single
+/// memcpy, others are moved if their move constructor can't throw and copied
+/// otherwise. If any construction throws, already constructed elements are
+/// destroyed. Source elements are not destroyed.
+/// </summary>
+/// <param name="source"> block with constructed elements.</param>
+/// <param name="count"> amount of elements to relocate.</param>
+/// <param name="destination"> raw block for the elements.</param>
+template <typename T, typename Allocator, typename Growth>
+void Vector<T, Allocator, Growth>::Relocate(T *source, size_t count,
+                                            T *destination) {
+  if (source) {
+    stats.Reallocation(count * sizeof(T));
+  }
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    if (count != 0) {
+      std::memcpy(static_cast<void *>(destination), source, count * sizeof(T));
+    }
+  } else {
+    size_t constructed{};
+    ALGLIB_TRY {
+      for (; constructed < count; ++constructed) {
+        Construct(destination + constructed,
+                  std::move_if_noexcept(source[constructed]));
+      }
+    } ALGLIB_CATCH_ALL {
+      Destroy(destination, constructed);
+      ALGLIB_RETHROW;
+    }
+  }
+}
+
+/// <summary>
+/// Calculates the capacity needed to fit additional elements by asking the
+/// growth policy. Result is never smaller than the required amount, even if
+/// the policy returns less.
+/// </summary>
+/// <param name="additional"> amount of elements that will be added.</param>
+/// <returns> new capacity of the vector.</returns>
+template <typename T, typename Allocator, typename Growth>
+size_t Vector<T, Allocator, Growth>::GrownCapacity(size_t additional) const {
+  const size_t required{size + additional};
+  const size_t grown{static_cast<size_t>(growth(capacity, required))};
+  return grown < required ? required : grown;
+}
+
+/// <summary>
+/// Constructs elements at the end of the vector until it reaches a given size.
+/// Memory is grown by the growth policy if needed. If any construction throws,
+/// the new elements are destroyed and the size is left unchanged.
+/// </summary>
+/// <param name="new_size"> size of the vector after extending, not smaller
+/// than the current size.</param>
+/// <param name="args"> arguments passed to the constructor of every new
+/// element, none for value initialization.</param>
+template <typename T, typename Allocator, typename Growth>
+template <typename... Args>
+void Vector<T, Allocator, Growth>::Extend(size_t new_size,
+                                          const Args &...args) {
+  if (new_size > capacity) {
+    Reallocate(GrownCapacity(new_size - size));
+  }
+  const size_t old_size{size};
+  ALGLIB_TRY {
+    for (; size < new_size; ++size) {
+      Construct(data + size, args...);
+    }
+  } ALGLIB_CATCH_ALL {
+    Destroy(data + old_size, size - old_size);
+    size = old_size;
+    ALGLIB_RETHROW;
+  }
+  stats.Size(size);
+}
+
+/// <summary>
+/// Obtains raw memory for a given amount of elements from the allocator.
+/// </summary>
+/// <param name="amount"> amount of elements.</param>
+/// <returns> pointer to raw memory or nullptr if amount is 0.</returns>
+template <typename T, typename Allocator, typename Growth>
+T *Vector<T, Allocator, Growth>::Allocate(size_t amount) {
+  if (amount == 0) {
+    return nullptr;
+  }
+  T *block{AllocatorTraits::allocate(allocator, amount)};
+  stats.Allocation();
+  return block;
+}
+
+/// <summary>
+/// Returns raw memory to the allocator.
+/// </summary>
+/// <param name="block"> memory obtained from Allocate.</param>
+/// <param name="amount"> amount of elements the block was allocated
+/// for.</param>
+template <typename T, typename Allocator, typename Growth>
+void Vector<T, Allocator, Growth>::Deallocate(T *block,
+                                              size_t amount) noexcept {
+  if (block) {
+    AllocatorTraits::deallocate(allocator, block, amount);
+    stats.Deallocation();
+  }
+}
+
+/// <summary>
+/// Constructs an element in raw memory through the allocator.
+/// </summary>
+/// <param name="slot"> raw memory for the element.</param>
+/// <param name="args"> arguments passed to the constructor of T.</param>
+template <typename T, typename Allocator, typename Growth>
+template <typename... Args>
+void Vector<T, Allocator, Growth>::Construct(T *slot, Args &&...args) {
+  AllocatorTraits::construct(allocator, slot, std::forward<Args>(args)...);
+}
+
+/// <summary>
+/// Destroys a given amount of elements through the allocator. Memory is not
+/// released.
+/// </summary>
+/// <param name="first"> first element to destroy.</param>
+/// <param name="count"> amount of elements to destroy.</param>
+template <typename T, typename Allocator, typename Growth>
+void Vector<T, Allocator, Growth>::Destroy(T *first, size_t count) noexcept {
+  if constexpr (!std::is_trivially_destructible_v<T>) {
+    for (size_t i{}; i < count; ++i) {
+      AllocatorTraits::destroy(allocator, first + i);
+    }
+  }
+}
+
+/// <summary>
+/// Swaps memory and elements with other vector. Allocators are not swapped.
+/// </summary>
+/// <param name="other"> vector to swap memory with.</param>
+template <typename T, typename Allocator, typename Growth>
+void Vector<T, Allocator, Growth>::SwapStorage(Vector &other) noexcept {
+  std::swap(size, other.size);
+  std::swap(capacity, other.capacity);
+  std::swap(data, other.data);
+}
+
+/// <summary>
+/// Returns pointer to the first element of the vector.
+/// </summary>
+template <typename T, typename Allocator, typename Growth>
+T *Vector<T, Allocator, Growth>::Data() noexcept {
+  return data;
+}
+
+/// <summary>
+/// Returns pointer to the first element of the vector.
+/// </summary>
+template <typename T, typename Allocator, typename Growth>
+const T *Vector<T, Allocator, Growth>::Data() const noexcept {
+  return data;
+}
+
+/// <summary>
+/// Returns span that views all elements of the vector.
+/// </summary>
+template <typename T, typename Allocator, typename Growth>
+std::span<T> Vector<T, Allocator, Growth>::AsSpan() noexcept {
+  return std::span<T>(data, size);
+}
+
+/// <summary>
+/// Returns span that views all elements of the vector.
+/// </summary>
+template <typename T, typename Allocator, typename Growth>
+std::span<const T> Vector<T, Allocator, Growth>::AsSpan() const noexcept {
+  return std::span<const T>(data, size);
+}
+
+/// <summary>
+/// Converts the vector to a span that views all of its elements.
+/// </summary>
+template <typename T, typename Allocator, typename Growth>
+Vector<T, Allocator, Growth>::operator std::span<T>() noexcept {
+  return AsSpan();
+}
+
+/// <summary>
+/// Converts the vector to a span that views all of its elements.
+/// </summary>
+template <typename T, typename Allocator, typename Growth>
+Vector<T, Allocator, Growth>::operator std::span<const T>() const noexcept {
+  return AsSpan();
+}
+
+/// <summary>
+/// Standard compliant function returning iterator object
+/// </summary>
+template <typename T, typename Allocator, typename Growth>
+typename Vector<T, Allocator, Growth>::Iterator
+Vector<T, Allocator, Growth>::begin() noexcept {
+  return Iterator(data);
+}
+
+/// <summary>
+/// Standard compliant function returning iterator object
+/// </summary>
+template <typename T, typename Allocator, typename Growth>
+typename Vector<T, Allocator, Growth>::Iterator
+Vector<T, Allocator, Growth>::end() noexcept {
+  return Iterator(data + size);
+}
+
 /// <summary>
 /// Standard compliant function returning iterator object
 /// </summary>
-template <typename T> Vector<T>::Iterator Vector<T>::begin() {
-  return Vector<T>::Iterator(data);
+template <typename T, typename Allocator, typename Growth>
+typename Vector<T, Allocator, Growth>::ConstIterator
+Vector<T, Allocator, Growth>::begin() const noexcept {
+  return ConstIterator(data);
 }
 
 /// <summary>
 /// Standard compliant function returning iterator object
 /// </summary>
-template <typename T> Vector<T>::Iterator Vector<T>::end() {
-  return Vector<T>::Iterator(data + size - 1);
+template <typename T, typename Allocator, typename Growth>
+typename Vector<T, Allocator, Growth>::ConstIterator
+Vector<T, Allocator, Growth>::end() const noexcept {
+  return ConstIterator(data + size);
 }
 
 /// <summary>
 /// Standard compliant function returning iterator object
 /// </summary>
-template <typename T> Vector<T>::ConstIterator Vector<T>::cbegin() {
-  return Vector<T>::ConstIterator(data);
+template <typename T, typename Allocator, typename Growth>
+typename Vector<T, Allocator, Growth>::ConstIterator
+Vector<T, Allocator, Growth>::cbegin() const noexcept {
+  return ConstIterator(data);
 }
 
 /// <summary>
 /// Standard compliant function returning iterator object
 /// </summary>
-template <typename T> Vector<T>::ConstIterator Vector<T>::cend() {
-  return Vector<T>::ConstIterator(data + size);
+template <typename T, typename Allocator, typename Growth>
+typename Vector<T, Allocator, Growth>::ConstIterator
+Vector<T, Allocator, Growth>::cend() const noexcept {
+  return ConstIterator(data + size);
 }
 
 /// <summary>
 /// Standard compliant function returning iterator object
 /// </summary>
-template <typename T> Vector<T>::ReverseIterator Vector<T>::rbegin() {
-  return Vector<T>::ReverseIterator(data + size - 1);
+template <typename T, typename Allocator, typename Growth>
+typename Vector<T, Allocator, Growth>::ReverseIterator
+Vector<T, Allocator, Growth>::rbegin() noexcept {
+  return ReverseIterator(end());
 }
 
 /// <summary>
 /// Standard compliant function returning iterator object
 /// </summary>
-template <typename T> Vector<T>::ReverseIterator Vector<T>::rend() {
-  return Vector<T>::ReverseIterator(data - 1);
+template <typename T, typename Allocator, typename Growth>
+typename Vector<T, Allocator, Growth>::ReverseIterator
+Vector<T, Allocator, Growth>::rend() noexcept {
+  return ReverseIterator(begin());
 }
 
 /// <summary>
 /// Standard compliant function returning iterator object
 /// </summary>
-template <typename T> Vector<T>::ConstReverseIterator Vector<T>::crbegin() {
-  return Vector<T>::ConstReverseIterator(data + size - 1);
+template <typename T, typename Allocator, typename Growth>
+typename Vector<T, Allocator, Growth>::ConstReverseIterator
+Vector<T, Allocator, Growth>::crbegin() const noexcept {
+  return ConstReverseIterator(cend());
 }
 
 /// <summary>
 /// Standard compliant function returning iterator object
 /// </summary>
-template <typename T> Vector<T>::ConstReverseIterator Vector<T>::crend() {
-  return Vector<T>::ConstReverseIterator(data - 1);
+template <typename T, typename Allocator, typename Growth>
+typename Vector<T, Allocator, Growth>::ConstReverseIterator
+Vector<T, Allocator, Growth>::crend() const noexcept {
+  return ConstReverseIterator(cbegin());
 }
 
 /// <summary>
 /// Wrapper around standard compliant function name
 /// </summary>
-template <typename T> Vector<T>::Iterator Vector<T>::Begin() { return begin(); }
+template <typename T, typename Allocator, typename Growth>
+typename Vector<T, Allocator, Growth>::Iterator
+Vector<T, Allocator, Growth>::Begin() noexcept {
+  return begin();
+}
 
 /// <summary>
 /// Wrapper around standard compliant function name
 /// </summary>
-template <typename T> Vector<T>::Iterator Vector<T>::End() { return end(); }
+template <typename T, typename Allocator, typename Growth>
+typename Vector<T, Allocator, Growth>::Iterator
+Vector<T, Allocator, Growth>::End() noexcept {
+  return end();
+}
 
 /// <summary>
 /// Wrapper around standard compliant function name
 /// </summary>
-template <typename T> Vector<T>::ConstIterator Vector<T>::ConstBegin() {
+template <typename T, typename Allocator, typename Growth>
+typename Vector<T, Allocator, Growth>::ConstIterator
+Vector<T, Allocator, Growth>::ConstBegin() const noexcept {
   return cbegin();
 }
 
 /// <summary>
 /// Wrapper around standard compliant function name
 /// </summary>
-template <typename T> Vector<T>::ConstIterator Vector<T>::ConstEnd() {
+template <typename T, typename Allocator, typename Growth>
+typename Vector<T, Allocator, Growth>::ConstIterator
+Vector<T, Allocator, Growth>::ConstEnd() const noexcept {
   return cend();
 }
 
 /// <summary>
 /// Wrapper around standard compliant function name
 /// </summary>
-template <typename T> Vector<T>::ReverseIterator Vector<T>::ReverseBegin() {
+template <typename T, typename Allocator, typename Growth>
+typename Vector<T, Allocator, Growth>::ReverseIterator
+Vector<T, Allocator, Growth>::ReverseBegin() noexcept {
   return rbegin();
 }
 
 /// <summary>
 /// Wrapper around standard compliant function name
 /// </summary>
-template <typename T> Vector<T>::ReverseIterator Vector<T>::ReverseEnd() {
+template <typename T, typename Allocator, typename Growth>
+typename Vector<T, Allocator, Growth>::ReverseIterator
+Vector<T, Allocator, Growth>::ReverseEnd() noexcept {
   return rend();
 }
 
 /// <summary>
 /// Wrapper around standard compliant function name
 /// </summary>
-template <typename T>
-Vector<T>::ConstReverseIterator Vector<T>::ConstReverseBegin() {
+template <typename T, typename Allocator, typename Growth>
+typename Vector<T, Allocator, Growth>::ConstReverseIterator
+Vector<T, Allocator, Growth>::ConstReverseBegin() const noexcept {
   return crbegin();
 }
 
 /// <summary>
 /// Wrapper around standard compliant function name
 /// </summary>
-template <typename T>
-Vector<T>::ConstReverseIterator Vector<T>::ConstReverseEnd() {
+template <typename T, typename Allocator, typename Growth>
+typename Vector<T, Allocator, Growth>::ConstReverseIterator
+Vector<T, Allocator, Growth>::ConstReverseEnd() const noexcept {
   return crend();
 }
 
+/// <summary>
+/// Aliases for containers that take memory from a std::pmr::memory_resource.
+/// </summary>
+namespace pmr {
+
+template <typename T, typename Growth = DoublingGrowth>
+using Vector = alglib::Vector<T, std::pmr::polymorphic_allocator<T>, Growth>;
+
+} // namespace pmr
+
 } // namespace alglib
 
 #endif // ALGLIB_INCLUDE_VECTOR_H_
@@ -0,0 +1,313 @@
+//*****************************************************************************
+// The MIT License (MIT)
+//
+// Copyright � 2024 Piotr Walczak
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the �Software�), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED �AS IS�, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//*****************************************************************************
+
+//*****************************************************************************
+// File: work_stealing_deque.h
+//
+// This file contains the implementation of the WorkStealingDeque class. It is
+// the Chase-Lev deque: one owner thread pushes and pops at the bottom end,
+// while any number of other threads steal from the top end. The elements
+// sit in a circular array indexed like SpscRing, which is replaced with a
+// twice bigger one when it fills up. The class is implemented in the alglib
+// namespace.
+//*****************************************************************************
+
+#ifndef ALGLIB_INCLUDE_WORKSTEALINGDEQUE_H_
+#define ALGLIB_INCLUDE_WORKSTEALINGDEQUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "constants.h"
+#include "stats.h"
+
+/// <summary>
+/// Default namespace for the AlgLib library.
+/// </summary>
+namespace alglib {
+
+/// <summary>
+/// Lock-free deque for work stealing. The owner uses Push and TryPop, which
+/// work in last in, first out order and only synchronize with thieves when
+/// the deque is almost empty. Other threads use TrySteal, which takes the
+/// oldest element. Indexes only grow and are masked into a power of two
+/// capacity. Arrays replaced by growing are kept until the deque is
+/// destroyed, because a thief may still be reading from one.
+/// </summary>
+/// <typeparam name="T"> trivially copyable type stored in the deque, usually
+/// a pointer to a task.</typeparam>
+template <typename T>
+class WorkStealingDeque {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "WorkStealingDeque elements have to be trivially copyable.");
+
+ public:
+  // Constructors and assignment operators.
+  explicit WorkStealingDeque(size_t initial_capacity = 64);
+  WorkStealingDeque(const WorkStealingDeque &) = delete;
+  WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+  // Methods used by the owner thread.
+  void Push(T value);
+  bool TryPop(T &value) noexcept;
+
+  // Methods used by any thread.
+  bool TrySteal(T &value) noexcept;
+  bool IsEmpty() const noexcept;
+  size_t Size() const noexcept;
+  size_t Capacity() const noexcept;
+  ContainerStats GetStats() const noexcept;
+
+ private:
+  /// <summary>
+  /// Circular array of elements. Slots are atomic, because a thief may read
+  /// a slot that the owner is writing after the array wrapped around; such
+  /// a read is discarded by the failing compare-and-swap on top.
+  /// </summary>
+  struct Array {
+    explicit Array(size_t capacity);
+    T Get(std::ptrdiff_t index) const noexcept;
+    void Put(std::ptrdiff_t index, T value) noexcept;
+
+    size_t mask;
+    std::unique_ptr<std::atomic<T>[]> slots;
+  };
+
+  // Method replacing the array with a bigger one.
+  Array *Grow(Array *array, std::ptrdiff_t front, std::ptrdiff_t back);
+
+  /// <summary>
+  /// Index of the oldest element. Thieves move it forward.
+  /// </summary>
+  alignas(64) std::atomic<std::ptrdiff_t> top;
+
+  /// <summary>
+  /// Index one past the newest element. Written only by the owner.
+  /// </summary>
+  alignas(64) std::atomic<std::ptrdiff_t> bottom;
+
+  /// <summary>
+  /// Array currently holding the elements.
+  /// </summary>
+  std::atomic<Array *> array;
+
+  /// <summary>
+  /// All arrays the deque used, including the current one. Accessed only by
+  /// the owner.
+  /// </summary>
+  std::vector<std::unique_ptr<Array>> arrays;
+
+  /// <summary>
+  /// Statistics of the deque, empty unless ALGLIB_ENABLE_STATS is defined.
+  /// Written only by the owner.
+  /// </summary>
+  ALGLIB_NO_UNIQUE_ADDRESS detail::StatsRecorder stats;
+};
+
+/// <summary>
+/// Constructor for the array. Capacity is rounded up to a power of two.
+/// </summary>
+/// <param name="capacity"> minimal number of slots.</param>
+template <typename T>
+WorkStealingDeque<T>::Array::Array(size_t capacity)
+    : mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1),
+      slots(std::make_unique<std::atomic<T>[]>(mask + 1)) {}
+
+/// <summary>
+/// Reads the slot for an index.
+/// </summary>
+/// <param name="index"> index of an element, not reduced to capacity.</param>
+/// <returns> value stored in the slot.</returns>
+template <typename T>
+T WorkStealingDeque<T>::Array::Get(std::ptrdiff_t index) const noexcept {
+  return slots[static_cast<size_t>(index) & mask].load(
+      std::memory_order_relaxed);
+}
+
+/// <summary>
+/// Writes the slot for an index.
+/// </summary>
+/// <param name="index"> index of an element, not reduced to capacity.</param>
+/// <param name="value"> value to store.</param>
+template <typename T>
+void WorkStealingDeque<T>::Array::Put(std::ptrdiff_t index, T value) noexcept {
+  slots[static_cast<size_t>(index) & mask].store(value,
+                                                 std::memory_order_relaxed);
+}
+
+/// <summary>
+/// Constructor for the deque.
+/// </summary>
+/// <param name="initial_capacity"> number of elements that fit before the
+/// array has to grow, rounded up to a power of two.</param>
+template <typename T>
+WorkStealingDeque<T>::WorkStealingDeque(size_t initial_capacity)
+    : top(0), bottom(0) {
+  arrays.push_back(std::make_unique<Array>(initial_capacity));
+  array.store(arrays.back().get(), std::memory_order_relaxed);
+  stats.Allocation();
+}
+
+/// <summary>
+/// Adds an element at the bottom end. Only the owner may call it.
+/// </summary>
+/// <param name="value"> value to be added.</param>
+template <typename T>
+void WorkStealingDeque<T>::Push(T value) {
+  const std::ptrdiff_t back{bottom.load(std::memory_order_relaxed)};
+  const std::ptrdiff_t front{top.load(std::memory_order_acquire)};
+  Array *current{array.load(std::memory_order_relaxed)};
+  if (static_cast<size_t>(back - front) > current->mask) {
+    current = Grow(current, front, back);
+  }
+  current->Put(back, value);
+  bottom.store(back + 1, std::memory_order_release);
+  stats.Size(static_cast<size_t>(back + 1 - front));
+}
+
+/// <summary>
+/// Removes the newest element. Only the owner may call it. The bottom index
+/// is lowered before top is read, so a thief racing for the last element
+/// either sees it gone or loses the compare-and-swap on top.
+/// </summary>
+/// <param name="value"> variable that the element is stored in.</param>
+/// <returns> true if an element was removed, false if the deque was
+/// empty.</returns>
+template <typename T>
+bool WorkStealingDeque<T>::TryPop(T &value) noexcept {
+  const std::ptrdiff_t back{bottom.load(std::memory_order_relaxed) - 1};
+  Array *current{array.load(std::memory_order_relaxed)};
+  bottom.store(back, std::memory_order_seq_cst);
+  std::ptrdiff_t front{top.load(std::memory_order_seq_cst)};
+  if (front > back) {
+    bottom.store(back + 1, std::memory_order_relaxed);
+    return false;
+  }
+  value = current->Get(back);
+  if (front == back) {
+    // Last element, thieves may want it too.
+    const bool won{top.compare_exchange_strong(front, front + 1,
+                                               std::memory_order_seq_cst,
+                                               std::memory_order_relaxed)};
+    bottom.store(back + 1, std::memory_order_relaxed);
+    return won;
+  }
+  return true;
+}
+
+/// <summary>
+/// Removes the oldest element. Any thread may call it. It fails when the
+/// deque is empty or another thread took the element first.
+/// </summary>
+/// <param name="value"> variable that the element is stored in.</param>
+/// <returns> true if an element was removed, false if not.</returns>
+template <typename T>
+bool WorkStealingDeque<T>::TrySteal(T &value) noexcept {
+  std::ptrdiff_t front{top.load(std::memory_order_seq_cst)};
+  const std::ptrdiff_t back{bottom.load(std::memory_order_seq_cst)};
+  if (front >= back) return false;
+  const T stolen{array.load(std::memory_order_acquire)->Get(front)};
+  if (!top.compare_exchange_strong(front, front + 1,
+                                   std::memory_order_seq_cst,
+                                   std::memory_order_relaxed)) {
+    return false;
+  }
+  value = stolen;
+  return true;
+}
+
+/// <summary>
+/// Checks whether the deque has no elements. The answer may be out of date
+/// as soon as it is returned.
+/// </summary>
+/// <returns> true if empty, false if not.</returns>
+template <typename T>
+bool WorkStealingDeque<T>::IsEmpty() const noexcept {
+  return Size() == 0;
+}
+
+/// <summary>
+/// Gets the number of elements in the deque. The answer may be out of date
+/// as soon as it is returned.
+/// </summary>
+/// <returns> number of elements.</returns>
+template <typename T>
+size_t WorkStealingDeque<T>::Size() const noexcept {
+  const std::ptrdiff_t front{top.load(std::memory_order_acquire)};
+  const std::ptrdiff_t back{bottom.load(std::memory_order_acquire)};
+  return back > front ? static_cast<size_t>(back - front) : 0;
+}
+
+/// <summary>
+/// Gets the number of elements that fit before the array has to grow.
+/// </summary>
+/// <returns> capacity of the current array.</returns>
+template <typename T>
+size_t WorkStealingDeque<T>::Capacity() const noexcept {
+  return array.load(std::memory_order_acquire)->mask + 1;
+}
+
+/// <summary>
+/// Gets statistics of the deque. It records allocated arrays, the elements
+/// copied when the array grows and the biggest size seen by the owner after
+/// a push. Old arrays are kept until the deque is destroyed, so nothing is
+/// deallocated before. Without ALGLIB_ENABLE_STATS all counters are zero.
+/// </summary>
+/// <returns> statistics of the deque.</returns>
+template <typename T>
+ContainerStats WorkStealingDeque<T>::GetStats() const noexcept {
+  return stats.Get();
+}
+
+/// <summary>
+/// Copies the elements into an array of twice the capacity and publishes
+/// it. The old array stays alive for thieves that already loaded it.
+/// </summary>
+/// <param name="current"> array in use.</param>
+/// <param name="front"> top index read by the owner.</param>
+/// <param name="back"> bottom index.</param>
+/// <returns> the new array.</returns>
+template <typename T>
+typename WorkStealingDeque<T>::Array *WorkStealingDeque<T>::Grow(
+    Array *current, std::ptrdiff_t front, std::ptrdiff_t back) {
+  auto bigger{std::make_unique<Array>((current->mask + 1) * 2)};
+  for (std::ptrdiff_t i{front}; i < back; ++i) {
+    bigger->Put(i, current->Get(i));
+  }
+  arrays.push_back(std::move(bigger));
+  stats.Allocation();
+  stats.Reallocation(static_cast<size_t>(back - front) * sizeof(T));
+  Array *result{arrays.back().get()};
+  array.store(result, std::memory_order_release);
+  return result;
+}
+
+}  // namespace alglib
+
+#endif  // ALGLIB_INCLUDE_WORKSTEALINGDEQUE_H_
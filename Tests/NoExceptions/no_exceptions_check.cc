@@ -0,0 +1,91 @@
+// Checks that the library compiles with exceptions disabled. Every container
+// is explicitly instantiated, so all its members are compiled, and the
+// non-throwing Try* methods are exercised at run time. Errors that would be
+// thrown abort the program, so none of them may happen here.
+
+#include <cstdio>
+#include <string>
+
+#include "alg_lib.h"
+
+template class alglib::ArrayStack<std::string, 4>;
+template class alglib::BTreeMap<std::string, std::string>;
+template class alglib::BTreeSet<std::string>;
+template class alglib::ByteRing<64>;
+template class alglib::CircularQueue<std::string, 4>;
+template class alglib::ConcurrentQueue<int>;
+template class alglib::ConcurrentSegmentedVector<std::string>;
+template class alglib::ConcurrentStack<int>;
+template class alglib::DoublyLinkedList<int>;
+template class alglib::FlatHashMap<std::string, int>;
+template class alglib::FlatHashSet<std::string>;
+template class alglib::IndexedPriorityQueue<std::string>;
+template class alglib::LFUCache<int, int>;
+template class alglib::LRUCache<int, int>;
+template class alglib::MappedVector<int>;
+template class alglib::PriorityQueue<std::string>;
+template class alglib::SinglyLinkedList<int>;
+template class alglib::SLLQueue<std::string>;
+template class alglib::SLLStack<std::string>;
+template class alglib::SmallVector<std::string, 4>;
+template class alglib::BasicSoAVector<alglib::DoublingGrowth, int,
+                                      std::string>;
+template class alglib::SpscRing<int, 8>;
+template class alglib::UnrolledList<int>;
+template class alglib::Vector<std::string>;
+template class alglib::WorkStealingDeque<int>;
+
+namespace {
+
+int failures{};
+
+void Check(bool condition, const char *what) {
+  if (!condition) {
+    std::fprintf(stderr, "Check failed: %s\n", what);
+    ++failures;
+  }
+}
+
+void CheckArrayStack() {
+  alglib::ArrayStack<int, 2> stack;
+  int value{};
+  Check(!stack.TryPop(value), "ArrayStack::TryPop on empty");
+  Check(!stack.TryTop(value), "ArrayStack::TryTop on empty");
+  Check(stack.TryPush(1) && stack.TryEmplace(2) != nullptr,
+        "ArrayStack::TryPush");
+  Check(!stack.TryPush(3), "ArrayStack::TryPush on full");
+  Check(stack.TryTop(value) && value == 2, "ArrayStack::TryTop");
+  Check(stack.TryPop(value) && value == 2, "ArrayStack::TryPop");
+}
+
+void CheckCircularQueue() {
+  alglib::CircularQueue<int, 2> queue;
+  int value{};
+  Check(!queue.TryDequeue(value), "CircularQueue::TryDequeue on empty");
+  Check(queue.TryEnqueue(1) && queue.TryEnqueue(2),
+        "CircularQueue::TryEnqueue");
+  Check(!queue.TryEnqueue(3), "CircularQueue::TryEnqueue on full");
+  Check(queue.TryPeekRear(value) && value == 2, "CircularQueue::TryPeekRear");
+  Check(queue.TryDequeue(value) && value == 1, "CircularQueue::TryDequeue");
+}
+
+void CheckListAdapters() {
+  alglib::SLLQueue<int> queue;
+  alglib::SLLStack<int> stack;
+  int value{};
+  Check(!queue.TryDequeue(value), "SLLQueue::TryDequeue on empty");
+  Check(!stack.TryPop(value), "SLLStack::TryPop on empty");
+  queue.Enqueue(1);
+  stack.Push(1);
+  Check(queue.TryDequeue(value) && value == 1, "SLLQueue::TryDequeue");
+  Check(stack.TryPop(value) && value == 1, "SLLStack::TryPop");
+}
+
+}  // namespace
+
+int main() {
+  CheckArrayStack();
+  CheckCircularQueue();
+  CheckListAdapters();
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,421 @@
+// Statistics tests build as their own executable with ALGLIB_ENABLE_STATS
+// defined for the whole target, since the macro changes the layout of the
+// containers and has to be the same in every translation unit.
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "array_stack.h"
+#include "btree.h"
+#include "byte_ring.h"
+#include "cache.h"
+#include "circular_queue.h"
+#include "concurrent_queue.h"
+#include "concurrent_segmented_vector.h"
+#include "concurrent_stack.h"
+#include "doubly_linked_list.h"
+#include "flat_hash_map.h"
+#include "mapped_vector.h"
+#include "priority_queue.h"
+#include "singly_linked_list.h"
+#include "sll_queue.h"
+#include "sll_stack.h"
+#include "small_vector.h"
+#include "spsc_ring.h"
+#include "stats.h"
+#include "unrolled_list.h"
+#include "vector.h"
+#include "work_stealing_deque.h"
+
+namespace {
+
+// Element type stored in the containers under test.
+struct Item {
+  int value;
+  bool operator==(const Item &other) const = default;
+};
+
+}  // namespace
+
+TEST(StatsTest, Enabled) {
+  EXPECT_TRUE(alglib::kStatsEnabled);
+}
+
+TEST(StatsTest, VectorGrowth) {
+  alglib::Vector<Item> vector;
+  for (int i{}; i < 100; ++i) {
+    vector.Push(Item{i});
+  }
+  alglib::ContainerStats stats{vector.GetStats()};
+  EXPECT_GT(stats.allocations, 1);
+  EXPECT_EQ(stats.deallocations, stats.allocations - 1);
+  EXPECT_EQ(stats.reallocations, stats.allocations - 1);
+  EXPECT_GT(stats.bytes_moved, 0);
+  EXPECT_EQ(stats.high_water_mark, 100);
+  EXPECT_EQ(stats.rejected, 0);
+
+  vector.Clear();
+  vector.ShrinkToFit();
+  stats = vector.GetStats();
+  EXPECT_EQ(stats.high_water_mark, 100);
+  EXPECT_EQ(stats.deallocations, stats.allocations);
+}
+
+TEST(StatsTest, VectorReserveAvoidsReallocations) {
+  alglib::Vector<Item> vector;
+  vector.Reserve(64);
+  for (int i{}; i < 64; ++i) {
+    vector.Emplace(Item{i});
+  }
+  const alglib::ContainerStats stats{vector.GetStats()};
+  EXPECT_EQ(stats.allocations, 1);
+  EXPECT_EQ(stats.reallocations, 0);
+  EXPECT_EQ(stats.bytes_moved, 0);
+  EXPECT_EQ(stats.high_water_mark, 64);
+}
+
+TEST(StatsTest, CopyCountsOnlyItsOwnEvents) {
+  alglib::Vector<Item> vector;
+  for (int i{}; i < 10; ++i) {
+    vector.Push(Item{i});
+  }
+  alglib::Vector<Item> copy(vector);
+  EXPECT_EQ(copy.GetStats().allocations, 1);
+  EXPECT_EQ(copy.GetStats().reallocations, 0);
+  EXPECT_EQ(copy.GetStats().high_water_mark, 10);
+  EXPECT_GT(vector.GetStats().allocations, 1);
+}
+
+TEST(StatsTest, ArrayStackRejections) {
+  alglib::ArrayStack<Item, 3> stack;
+  for (int i{}; i < 3; ++i) {
+    stack.Push(Item{i});
+  }
+  EXPECT_THROW(stack.Push(Item{3}), std::runtime_error);
+  EXPECT_THROW(stack.Emplace(Item{4}), std::runtime_error);
+  stack.Pop();
+  const alglib::ContainerStats stats{stack.GetStats()};
+  EXPECT_EQ(stats.high_water_mark, 3);
+  EXPECT_EQ(stats.rejected, 2);
+  EXPECT_EQ(stats.allocations, 0);
+}
+
+TEST(StatsTest, CircularQueueRejections) {
+  alglib::CircularQueue<Item, 2> queue;
+  queue.Enqueue(Item{1});
+  queue.Enqueue(Item{2});
+  EXPECT_THROW(queue.Enqueue(Item{3}), std::runtime_error);
+  queue.Dequeue();
+  queue.Enqueue(Item{4});
+  const alglib::ContainerStats stats{queue.GetStats()};
+  EXPECT_EQ(stats.high_water_mark, 2);
+  EXPECT_EQ(stats.rejected, 1);
+}
+
+TEST(StatsTest, NodeContainers) {
+  alglib::SLLStack<Item> stack;
+  alglib::SLLQueue<Item> queue;
+  alglib::SinglyLinkedList<Item> singly;
+  alglib::DoublyLinkedList<Item> doubly;
+  for (int i{}; i < 5; ++i) {
+    stack.Push(Item{i});
+    queue.Enqueue(Item{i});
+    singly.InsertAtEnd(Item{i});
+    doubly.InsertAtEnd(Item{i});
+  }
+  stack.Pop();
+  queue.Dequeue();
+  singly.DeleteAtBeggining();
+  doubly.DeleteAtBeginning();
+  stack.Push(Item{5});
+  queue.Enqueue(Item{5});
+  singly.InsertAtEnd(Item{5});
+  doubly.InsertAtEnd(Item{5});
+  for (const alglib::ContainerStats &stats :
+       {stack.GetStats(), queue.GetStats(), singly.GetStats(),
+        doubly.GetStats()}) {
+    EXPECT_EQ(stats.allocations, 6);
+    EXPECT_EQ(stats.deallocations, 1);
+    EXPECT_EQ(stats.high_water_mark, 5);
+  }
+}
+
+TEST(StatsTest, SpliceUpdatesHighWaterMark) {
+  alglib::SinglyLinkedList<Item> list;
+  alglib::SinglyLinkedList<Item> other;
+  list.InsertAtEnd(Item{1});
+  other.InsertAtEnd(Item{2});
+  other.InsertAtEnd(Item{3});
+  list.Splice(other);
+  EXPECT_EQ(list.GetStats().high_water_mark, 3);
+  EXPECT_EQ(list.GetStats().allocations, 1);
+}
+
+TEST(StatsTest, SmallVectorCountsOnlyHeapMemory) {
+  alglib::SmallVector<Item, 4> vector;
+  for (int i{}; i < 4; ++i) {
+    vector.Push(Item{i});
+  }
+  EXPECT_EQ(vector.GetStats().allocations, 0);
+  vector.Push(Item{4});
+  alglib::ContainerStats stats{vector.GetStats()};
+  EXPECT_EQ(stats.allocations, 1);
+  EXPECT_EQ(stats.reallocations, 1);
+  EXPECT_EQ(stats.bytes_moved, 4 * sizeof(Item));
+  EXPECT_EQ(stats.high_water_mark, 5);
+
+  vector.Resize(2);
+  vector.ShrinkToFit();
+  stats = vector.GetStats();
+  EXPECT_TRUE(vector.IsInline());
+  EXPECT_EQ(stats.deallocations, 1);
+  EXPECT_EQ(stats.reallocations, 2);
+}
+
+TEST(StatsTest, UnrolledListChunks) {
+  alglib::UnrolledList<Item, 64> list;
+  for (int i{}; i < 40; ++i) {
+    list.InsertAtEnd(Item{i});
+  }
+  list.InsertAtPosition(1, Item{-1});
+  alglib::ContainerStats stats{list.GetStats()};
+  EXPECT_EQ(stats.allocations, list.ChunkCount());
+  EXPECT_EQ(stats.reallocations, 1);
+  EXPECT_GT(stats.bytes_moved, 0);
+  EXPECT_EQ(stats.high_water_mark, 41);
+
+  while (!list.IsEmpty()) {
+    list.DeleteAtBeginning();
+  }
+  stats = list.GetStats();
+  EXPECT_EQ(stats.deallocations, stats.allocations);
+  EXPECT_EQ(stats.high_water_mark, 41);
+}
+
+TEST(StatsTest, MappedVectorRemaps) {
+  const std::filesystem::path path{std::filesystem::temp_directory_path() /
+                                   "alglib_stats_mapped.bin"};
+  std::filesystem::remove(path);
+  {
+    alglib::MappedVector<int> vector(path);
+    for (int i{}; i < 10; ++i) {
+      vector.Push(i);
+    }
+    alglib::ContainerStats stats{vector.GetStats()};
+    EXPECT_EQ(stats.reallocations, stats.allocations);
+    EXPECT_EQ(stats.deallocations, stats.allocations - 1);
+    EXPECT_EQ(stats.bytes_moved, 0);
+    EXPECT_EQ(stats.high_water_mark, 10);
+    vector.Close();
+    stats = vector.GetStats();
+    EXPECT_EQ(stats.deallocations, stats.allocations);
+
+    vector.Open(path);
+    EXPECT_EQ(vector.GetStats().allocations, stats.allocations + 1);
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(StatsTest, CacheSizeAfterEvictions) {
+  alglib::LRUCache<int, int> lru(2, 10);
+  alglib::LFUCache<int, int> lfu(2, 10);
+  for (int i{}; i < 3; ++i) {
+    lru.Put(i, i, 1);
+    lfu.Put(i, i, 1);
+  }
+  EXPECT_FALSE(lru.Put(5, 5, 11));
+  EXPECT_FALSE(lfu.Put(5, 5, 11));
+  for (const alglib::ContainerStats &stats : {lru.GetStats(), lfu.GetStats()}) {
+    EXPECT_EQ(stats.allocations, 3);
+    EXPECT_EQ(stats.deallocations, 1);
+    EXPECT_EQ(stats.high_water_mark, 2);
+    EXPECT_EQ(stats.rejected, 1);
+  }
+}
+
+TEST(StatsTest, ShardedCacheSumsShards) {
+  alglib::ShardedCache<alglib::LRUCache<int, int>> cache(4, 100);
+  for (int i{}; i < 20; ++i) {
+    cache.Put(i, i);
+  }
+  const alglib::ContainerStats stats{cache.GetStats()};
+  EXPECT_EQ(stats.allocations, 20);
+  EXPECT_EQ(stats.deallocations, 0);
+  EXPECT_EQ(stats.high_water_mark, 20);
+}
+
+TEST(StatsTest, ConcurrentNodeContainers) {
+  alglib::ConcurrentStack<Item> stack;
+  alglib::ConcurrentQueue<Item> queue;
+  for (int i{}; i < 3; ++i) {
+    stack.Push(Item{i});
+    queue.Enqueue(Item{i});
+  }
+  stack.Pop();
+  queue.Dequeue();
+  const alglib::ContainerStats stack_stats{stack.GetStats()};
+  EXPECT_EQ(stack_stats.allocations, 3);
+  EXPECT_EQ(stack_stats.deallocations, 1);
+  EXPECT_EQ(stack_stats.high_water_mark, 3);
+  // The queue also allocates its dummy node.
+  const alglib::ContainerStats queue_stats{queue.GetStats()};
+  EXPECT_EQ(queue_stats.allocations, 4);
+  EXPECT_EQ(queue_stats.deallocations, 1);
+  EXPECT_EQ(queue_stats.high_water_mark, 4);
+}
+
+TEST(StatsTest, ConcurrentWritersLoseNoEvents) {
+  constexpr int kThreads{4};
+  constexpr int kPerThread{1000};
+  alglib::ConcurrentStack<int> stack;
+  alglib::ConcurrentSegmentedVector<int> vector;
+  std::vector<std::thread> threads;
+  for (int t{}; t < kThreads; ++t) {
+    threads.emplace_back([&stack, &vector] {
+      for (int i{}; i < kPerThread; ++i) {
+        stack.Push(i);
+        vector.PushBack(i);
+      }
+    });
+  }
+  for (std::thread &thread : threads) thread.join();
+  EXPECT_EQ(stack.GetStats().allocations, kThreads * kPerThread);
+  EXPECT_EQ(stack.GetStats().high_water_mark, kThreads * kPerThread);
+  const alglib::ContainerStats stats{vector.GetStats()};
+  EXPECT_EQ(stats.high_water_mark, kThreads * kPerThread);
+  EXPECT_GE(stats.allocations, 1);
+  EXPECT_EQ(stats.reallocations, 0);
+}
+
+TEST(StatsTest, SpscRingRejections) {
+  alglib::SpscRing<int, 4> ring;
+  for (int i{}; i < 5; ++i) {
+    ring.TryPush(i);
+  }
+  const std::array<int, 2> values{5, 6};
+  EXPECT_EQ(ring.PushN(values.begin(), values.size()), 0);
+  int value;
+  ring.TryPop(value);
+  const alglib::ContainerStats stats{ring.GetStats()};
+  EXPECT_EQ(stats.high_water_mark, 4);
+  EXPECT_EQ(stats.rejected, 2);
+  EXPECT_EQ(stats.allocations, 0);
+}
+
+TEST(StatsTest, WorkStealingDequeGrowth) {
+  alglib::WorkStealingDeque<int> deque(2);
+  for (int i{}; i < 5; ++i) {
+    deque.Push(i);
+  }
+  const alglib::ContainerStats stats{deque.GetStats()};
+  EXPECT_EQ(stats.allocations, 3);
+  EXPECT_EQ(stats.reallocations, 2);
+  EXPECT_EQ(stats.bytes_moved, 6 * sizeof(int));
+  EXPECT_EQ(stats.high_water_mark, 5);
+}
+
+TEST(StatsTest, FlatHashMapResizes) {
+  alglib::FlatHashMap<int, int> map;
+  for (int i{}; i < 100; ++i) {
+    map.Insert({i, i});
+  }
+  alglib::ContainerStats stats{map.GetStats()};
+  EXPECT_GT(stats.allocations, 1);
+  EXPECT_EQ(stats.deallocations, stats.allocations - 1);
+  EXPECT_EQ(stats.reallocations, stats.allocations - 1);
+  EXPECT_GT(stats.bytes_moved, 0);
+  EXPECT_EQ(stats.high_water_mark, 100);
+
+  alglib::FlatHashMap<int, int> reserved;
+  reserved.Reserve(100);
+  for (int i{}; i < 100; ++i) {
+    reserved.Insert({i, i});
+  }
+  stats = reserved.GetStats();
+  EXPECT_EQ(stats.allocations, 1);
+  EXPECT_EQ(stats.reallocations, 0);
+}
+
+TEST(StatsTest, BTreeNodes) {
+  alglib::BTreeMap<int, int> map;
+  for (int i{}; i < 1000; ++i) {
+    map.Insert(i, i);
+  }
+  alglib::ContainerStats stats{map.GetStats()};
+  EXPECT_GT(stats.allocations, 1);
+  EXPECT_EQ(stats.deallocations, 0);
+  EXPECT_EQ(stats.high_water_mark, 1000);
+  map.Clear();
+  stats = map.GetStats();
+  EXPECT_EQ(stats.deallocations, stats.allocations);
+}
+
+TEST(StatsTest, PriorityQueueUsesHeapVector) {
+  alglib::PriorityQueue<int> queue;
+  for (int i{}; i < 10; ++i) {
+    queue.Push(i);
+  }
+  queue.Pop();
+  const alglib::ContainerStats stats{queue.GetStats()};
+  EXPECT_GE(stats.allocations, 1);
+  EXPECT_EQ(stats.high_water_mark, 10);
+}
+
+TEST(StatsTest, ByteRingRejections) {
+  alglib::ByteRing<8> ring;
+  const std::array<std::byte, 10> bytes{};
+  EXPECT_EQ(ring.Write(bytes), 8);
+  EXPECT_THROW(ring.Commit(1), std::runtime_error);
+  const alglib::ContainerStats stats{ring.GetStats()};
+  EXPECT_EQ(stats.high_water_mark, 8);
+  EXPECT_EQ(stats.rejected, 2);
+}
+
+TEST(StatsTest, RegistrySnapshot) {
+  alglib::StatsRegistry registry;
+  alglib::Vector<Item> vector;
+  alglib::ArrayStack<Item, 2> stack;
+  {
+    alglib::StatsRegistry::Registration vector_registration{
+        registry.Register("vector", vector)};
+    alglib::StatsRegistry::Registration stack_registration{
+        registry.Register("stack", stack)};
+    vector.Push(Item{1});
+    stack.Push(Item{1});
+    stack.Push(Item{2});
+
+    auto entries{registry.Snapshot()};
+    ASSERT_EQ(entries.size(), 2);
+    EXPECT_EQ(entries[0].name, "vector");
+    EXPECT_EQ(entries[0].stats.high_water_mark, 1);
+    EXPECT_EQ(entries[1].name, "stack");
+    EXPECT_EQ(entries[1].stats.high_water_mark, 2);
+
+    alglib::StatsRegistry::Registration moved{std::move(stack_registration)};
+    EXPECT_EQ(registry.Count(), 2);
+    vector_registration = alglib::StatsRegistry::Registration();
+    EXPECT_EQ(registry.Count(), 1);
+    EXPECT_EQ(registry.Snapshot()[0].name, "stack");
+  }
+  EXPECT_EQ(registry.Count(), 0);
+}
+
+TEST(StatsTest, GlobalRegistry) {
+  alglib::StatsRegistry &registry{alglib::StatsRegistry::Global()};
+  EXPECT_EQ(&registry, &alglib::StatsRegistry::Global());
+  const size_t before{registry.Count()};
+  alglib::SLLQueue<Item> queue;
+  {
+    auto registration{registry.Register("queue", queue)};
+    EXPECT_EQ(registry.Count(), before + 1);
+  }
+  EXPECT_EQ(registry.Count(), before);
+}
@@ -1,7 +1,24 @@
 #include <gtest/gtest.h>
 
-#include "array_stack.h"  
+#include <string>
+#include <utility>
 
+#include "array_stack.h"
+
+namespace {
+
+// Type without default constructor that counts its live objects.
+struct Tracked {
+  static inline int live{};
+
+  explicit Tracked(int value) : value(value) { ++live; }
+  Tracked(const Tracked &other) : value(other.value) { ++live; }
+  ~Tracked() { --live; }
+
+  int value;
+};
+
+}  // namespace
 
 TEST(ArrayStackTest, ConstructorAndIsEmpty) {
   alglib::ArrayStack<int, 5> stack;
@@ -84,4 +101,83 @@ TEST(ArrayStackTest, Capacity) {
 TEST(ArrayStackTest, TopOnEmptyStack) {
   alglib::ArrayStack<int, 5> stack;
   EXPECT_THROW(stack.Top(), std::runtime_error);
-}
\ No newline at end of file
+}
+
+TEST(ArrayStackTest, NoElementsConstructedUpFront) {
+  Tracked::live = 0;
+  {
+    alglib::ArrayStack<Tracked, 1000> stack;
+    EXPECT_EQ(Tracked::live, 0);
+    stack.Push(Tracked(1));
+    stack.Push(Tracked(2));
+    EXPECT_EQ(Tracked::live, 2);
+    stack.Pop();
+    EXPECT_EQ(Tracked::live, 1);
+  }
+  EXPECT_EQ(Tracked::live, 0);
+}
+
+TEST(ArrayStackTest, Emplace) {
+  alglib::ArrayStack<std::pair<int, std::string>, 2> stack;
+  auto &element{stack.Emplace(1, "one")};
+  EXPECT_EQ(element.second, "one");
+  stack.Emplace(2, "two");
+  EXPECT_THROW(stack.Emplace(3, "three"), std::runtime_error);
+  EXPECT_EQ(stack.Top().second, "two");
+}
+
+TEST(ArrayStackTest, CopyAndMove) {
+  alglib::ArrayStack<std::string, 3> stack;
+  stack.Push("a");
+  stack.Push("b");
+  alglib::ArrayStack<std::string, 3> copy{stack};
+  alglib::ArrayStack<std::string, 3> moved{std::move(stack)};
+  EXPECT_EQ(copy.Pop(), moved.Pop());
+  copy = moved;
+  EXPECT_EQ(copy.Pop(), "a");
+  EXPECT_TRUE(copy.IsEmpty());
+}
+
+namespace {
+
+// Uses the container during constant evaluation.
+constexpr int ConstexprSum() {
+  alglib::ArrayStack<int, 4> stack;
+  for (int i{1}; i <= 6; ++i) {
+    if (stack.IsFull()) stack.Pop();
+    stack.Push(i);
+  }
+  int sum{};
+  while (!stack.IsEmpty()) sum += stack.Pop();
+  return sum;
+}
+
+}  // namespace
+
+TEST(ArrayStackTest, ConstexprEvaluation) {
+  static_assert(ConstexprSum() == 12);
+}
+
+TEST(ArrayStackTest, TryPushAndTryPop) {
+  alglib::ArrayStack<std::string, 2> stack;
+  std::string value{"unchanged"};
+  EXPECT_FALSE(stack.TryPop(value));
+  EXPECT_FALSE(stack.TryTop(value));
+  EXPECT_EQ(value, "unchanged");
+
+  EXPECT_TRUE(stack.TryPush("a"));
+  std::string *element{stack.TryEmplace(3, 'b')};
+  ASSERT_NE(element, nullptr);
+  EXPECT_EQ(*element, "bbb");
+  EXPECT_FALSE(stack.TryPush("c"));
+  EXPECT_EQ(stack.TryEmplace("d"), nullptr);
+  EXPECT_EQ(stack.Size(), 2);
+
+  EXPECT_TRUE(stack.TryTop(value));
+  EXPECT_EQ(value, "bbb");
+  EXPECT_TRUE(stack.TryPop(value));
+  EXPECT_EQ(value, "bbb");
+  EXPECT_TRUE(stack.TryPop(value));
+  EXPECT_EQ(value, "a");
+  EXPECT_TRUE(stack.IsEmpty());
+}
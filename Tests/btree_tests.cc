@@ -0,0 +1,272 @@
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <map>
+#include <memory_resource>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "btree.h"
+#include "vector.h"
+
+namespace {
+
+// Nodes this small hold the minimum of four keys, so even small trees are
+// several levels deep and every split and merge path runs.
+constexpr size_t kTinyNode{1};
+
+// Counts live instances, to check that no element is leaked or destroyed
+// twice.
+struct Counted {
+  static inline int live{};
+
+  explicit Counted(int value) : value(value) { ++live; }
+  Counted(const Counted &other) : value(other.value) { ++live; }
+  Counted(Counted &&other) noexcept : value(other.value) { ++live; }
+  Counted &operator=(const Counted &) = default;
+  Counted &operator=(Counted &&) noexcept = default;
+  ~Counted() { --live; }
+
+  int value;
+};
+
+// Memory resource that counts allocations and releases, used to check which
+// resource the nodes of a tree come from.
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  size_t allocations{};
+  size_t deallocations{};
+
+ private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+    ++deallocations;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+// Checks that a map holds the same elements as a reference map, walking
+// forward and backward.
+template <typename Map>
+void ExpectSame(const Map &map, const std::map<int, int> &expected) {
+  ASSERT_EQ(map.Size(), expected.size());
+  auto it{map.begin()};
+  for (const auto &[key, value] : expected) {
+    ASSERT_NE(it, map.end());
+    EXPECT_EQ((*it).first, key);
+    EXPECT_EQ(it->second, value);
+    ++it;
+  }
+  EXPECT_EQ(it, map.end());
+  for (auto rit{expected.rbegin()}; rit != expected.rend(); ++rit) {
+    --it;
+    EXPECT_EQ(it->first, rit->first);
+  }
+  EXPECT_EQ(it, map.begin());
+}
+
+}  // namespace
+
+TEST(BTreeMapTest, InsertFindAndAt) {
+  alglib::BTreeMap<int, std::string> map;
+  EXPECT_TRUE(map.IsEmpty());
+  EXPECT_EQ(map.Height(), 0);
+  EXPECT_EQ(map.Find(1), map.end());
+  EXPECT_TRUE(map.Insert(2, "two").second);
+  EXPECT_FALSE(map.Insert(2, "deux").second);
+  EXPECT_TRUE(map.TryEmplace(1, 3, 'x').second);
+  map[3] = "three";
+  EXPECT_FALSE(map.InsertOrAssign(2, "second").second);
+  EXPECT_EQ(map.Size(), 3);
+  EXPECT_EQ(map.At(1), "xxx");
+  EXPECT_EQ(map.At(2), "second");
+  EXPECT_EQ(map.Find(3)->second, "three");
+  EXPECT_TRUE(map.Contains(1));
+  EXPECT_FALSE(map.Contains(4));
+  EXPECT_THROW(map.At(4), std::runtime_error);
+  EXPECT_EQ(map.begin()->first, 1);
+}
+
+TEST(BTreeMapTest, MatchesStdMapUnderRandomOperations) {
+  std::mt19937 random(11);
+  alglib::BTreeMap<int, int, kTinyNode> map;
+  std::map<int, int> expected;
+  for (int i{}; i < 20000; ++i) {
+    const int key{static_cast<int>(random() % 2000)};
+    if (random() % 2 == 0) {
+      EXPECT_EQ(map.Erase(key), expected.erase(key));
+    } else {
+      EXPECT_EQ(map.Insert(key, i).second, expected.emplace(key, i).second);
+    }
+  }
+  ExpectSame(map, expected);
+  for (auto &[key, value] : expected) EXPECT_EQ(map.Erase(key), 1);
+  EXPECT_TRUE(map.IsEmpty());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.Height(), 0);
+}
+
+TEST(BTreeMapTest, InsertReturnsIteratorAfterSplit) {
+  alglib::BTreeMap<int, int, kTinyNode> map;
+  for (int i{}; i < 500; ++i) {
+    const int key{(i * 37) % 500};
+    const auto [it, inserted] = map.Insert(key, -key);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(it->first, key);
+    EXPECT_EQ(it->second, -key);
+  }
+}
+
+TEST(BTreeMapTest, BoundsAndRange) {
+  alglib::BTreeMap<int, int, kTinyNode> map;
+  for (int i{}; i < 100; ++i) map.Insert(i * 10, i);
+  EXPECT_EQ(map.LowerBound(50)->first, 50);
+  EXPECT_EQ(map.LowerBound(51)->first, 60);
+  EXPECT_EQ(map.UpperBound(50)->first, 60);
+  EXPECT_EQ(map.LowerBound(-5), map.begin());
+  EXPECT_EQ(map.LowerBound(991), map.end());
+  EXPECT_EQ(map.UpperBound(990), map.end());
+  std::vector<int> keys;
+  for (const auto &[key, value] : map.Range(95, 155)) keys.push_back(key);
+  EXPECT_EQ(keys, (std::vector<int>{100, 110, 120, 130, 140, 150}));
+  const auto &constant{map};
+  const auto empty{constant.Range(155, 95)};
+  EXPECT_EQ(empty.begin(), empty.end());
+}
+
+TEST(BTreeMapTest, BulkLoadBuildsBalancedTree) {
+  alglib::Vector<std::pair<int, int>> sorted;
+  std::map<int, int> expected;
+  for (int i{}; i < 10000; ++i) {
+    sorted.Push({i * 2, i});
+    expected.emplace(i * 2, i);
+  }
+  alglib::BTreeMap<int, int> map;
+  map.Insert(-1, -1);
+  map.BulkLoad(sorted);
+  ExpectSame(map, expected);
+  // Packed leaves of 27 pairs under internal nodes of 18 children.
+  EXPECT_EQ(map.Height(), 4);
+  // The loaded tree takes further updates like any other.
+  for (int i{}; i < 10000; i += 3) {
+    map.Erase(i * 2);
+    expected.erase(i * 2);
+    map.Insert(i * 2 + 1, i);
+    expected.emplace(i * 2 + 1, i);
+  }
+  ExpectSame(map, expected);
+}
+
+TEST(BTreeMapTest, BulkLoadRejectsUnsortedInput) {
+  alglib::BTreeMap<int, int> map{{1, 1}};
+  alglib::Vector<std::pair<int, int>> unsorted;
+  unsorted.Push({2, 0});
+  unsorted.Push({2, 0});
+  EXPECT_THROW(map.BulkLoad(unsorted), std::runtime_error);
+  EXPECT_EQ(map.Size(), 1);
+  EXPECT_TRUE(map.Contains(1));
+}
+
+TEST(BTreeMapTest, HeightGrowsLogarithmically) {
+  alglib::BTreeMap<int, int> map;
+  for (int i{}; i < 200000; ++i) map.Insert(i, i);
+  // Ascending inserts leave every node split in half, so at least 13
+  // elements per leaf and 9 children per internal node.
+  EXPECT_LE(map.Height(), 6);
+  EXPECT_EQ(map.Find(76543)->second, 76543);
+}
+
+TEST(BTreeMapTest, CopyMoveAndClearManageLifetimes) {
+  {
+    alglib::BTreeMap<std::string, Counted, kTinyNode> map;
+    for (int i{}; i < 300; ++i) map.TryEmplace(std::to_string(i), i);
+    for (int i{}; i < 300; i += 2) map.Erase(std::to_string(i));
+    EXPECT_EQ(Counted::live, 150);
+    alglib::BTreeMap<std::string, Counted, kTinyNode> copy{map};
+    EXPECT_EQ(Counted::live, 300);
+    EXPECT_EQ(copy.At("151").value, 151);
+    alglib::BTreeMap<std::string, Counted, kTinyNode> moved{std::move(map)};
+    EXPECT_TRUE(map.IsEmpty());
+    copy = moved;
+    EXPECT_EQ(Counted::live, 300);
+    moved.Clear();
+    EXPECT_EQ(Counted::live, 150);
+  }
+  EXPECT_EQ(Counted::live, 0);
+}
+
+TEST(BTreeMapTest, MemoryResourceAllocators) {
+  using Map = alglib::BTreeMap<
+      int, std::string, kTinyNode, std::less<int>,
+      std::pmr::polymorphic_allocator<std::pair<const int, std::string>>>;
+  CountingResource first;
+  CountingResource second;
+  {
+    Map map(std::less<int>{}, &first);
+    for (int i{}; i < 100; ++i) map.TryEmplace(i, std::to_string(i));
+    Map other(std::less<int>{}, &second);
+    other.TryEmplace(-1, "old");
+
+    // The allocator doesn't propagate, so the elements are copied and moved
+    // into nodes from the second resource.
+    const size_t first_allocations{first.allocations};
+    other = map;
+    EXPECT_EQ(other.Size(), 100);
+    EXPECT_EQ(other.At(42), "42");
+    other = std::move(map);
+    EXPECT_EQ(other.Size(), 100);
+    EXPECT_EQ(other.At(42), "42");
+    EXPECT_EQ(first.allocations, first_allocations);
+    EXPECT_EQ(first.deallocations, 0);
+  }
+  EXPECT_EQ(first.deallocations, first.allocations);
+  EXPECT_EQ(second.deallocations, second.allocations);
+
+  using Set = alglib::BTreeSet<std::string, kTinyNode, std::less<std::string>,
+                               std::pmr::polymorphic_allocator<std::string>>;
+  Set set(std::less<std::string>{}, &first);
+  for (int i{}; i < 100; ++i) set.Insert(std::to_string(i));
+  Set other_set(std::less<std::string>{}, &second);
+  other_set = std::move(set);
+  EXPECT_EQ(other_set.Size(), 100);
+  EXPECT_TRUE(other_set.Contains("42"));
+}
+
+TEST(BTreeSetTest, MatchesStdSet) {
+  std::mt19937 random(5);
+  alglib::BTreeSet<int, kTinyNode> set;
+  std::set<int> expected;
+  for (int i{}; i < 10000; ++i) {
+    const int key{static_cast<int>(random() % 1000)};
+    if (random() % 3 == 0) {
+      EXPECT_EQ(set.Erase(key), expected.erase(key));
+    } else {
+      EXPECT_EQ(set.Insert(key).second, expected.insert(key).second);
+    }
+  }
+  EXPECT_EQ(std::vector<int>(set.begin(), set.end()),
+            std::vector<int>(expected.begin(), expected.end()));
+  EXPECT_EQ(*set.LowerBound(500), *expected.lower_bound(500));
+}
+
+TEST(BTreeSetTest, InitializerListAndBulkLoad) {
+  alglib::BTreeSet<std::string> set{"pear", "apple", "fig", "apple"};
+  EXPECT_EQ(set.Size(), 3);
+  EXPECT_EQ(*set.begin(), "apple");
+  alglib::Vector<std::string> sorted;
+  for (const char *word : {"a", "b", "c", "d"}) sorted.Push(word);
+  set.BulkLoad(sorted);
+  EXPECT_EQ(std::vector<std::string>(set.begin(), set.end()),
+            (std::vector<std::string>{"a", "b", "c", "d"}));
+  EXPECT_FALSE(set.Contains("fig"));
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include "byte_ring.h"
+
+namespace {
+
+// Makes a span of bytes from a vector of chars.
+std::span<const std::byte> Bytes(const std::vector<char> &chars) {
+  return std::as_bytes(std::span<const char>(chars));
+}
+
+}  // namespace
+
+TEST(ByteRingTest, ConstructorAndIsEmpty) {
+  alglib::ByteRing<16> ring;
+  EXPECT_TRUE(ring.IsEmpty());
+  EXPECT_FALSE(ring.IsFull());
+  EXPECT_EQ(ring.FreeSpace(), 16);
+  auto writable{ring.WritableSpans()};
+  EXPECT_EQ(writable[0].size(), 16);
+  EXPECT_TRUE(writable[1].empty());
+  EXPECT_TRUE(ring.ReadableSpans()[0].empty());
+}
+
+TEST(ByteRingTest, CommitAndConsume) {
+  alglib::ByteRing<8> ring;
+  auto writable{ring.WritableSpans()};
+  for (size_t i{}; i < 5; ++i) writable[0][i] = std::byte(i);
+  ring.Commit(5);
+  EXPECT_EQ(ring.Size(), 5);
+  const auto &const_ring{ring};
+  auto readable{const_ring.ReadableSpans()};
+  ASSERT_EQ(readable[0].size(), 5);
+  EXPECT_EQ(readable[0][4], std::byte(4));
+  ring.Consume(2);
+  EXPECT_EQ(ring.ReadableSpans()[0][0], std::byte(2));
+  EXPECT_THROW(ring.Consume(4), std::runtime_error);
+  EXPECT_THROW(ring.Commit(6), std::runtime_error);
+  EXPECT_EQ(ring.Size(), 3);
+}
+
+TEST(ByteRingTest, SpansWrapAround) {
+  alglib::ByteRing<8> ring;
+  ring.Commit(6);
+  ring.Consume(4);
+  auto writable{ring.WritableSpans()};
+  EXPECT_EQ(writable[0].size(), 2);
+  EXPECT_EQ(writable[1].size(), 4);
+  EXPECT_EQ(writable[1].data(), ring.ReadableSpans()[0].data() - 4);
+  ring.Commit(5);
+  auto readable{ring.ReadableSpans()};
+  EXPECT_EQ(readable[0].size(), 4);
+  EXPECT_EQ(readable[1].size(), 3);
+  EXPECT_EQ(ring.WritableSpans()[0].size(), 1);
+  EXPECT_TRUE(ring.WritableSpans()[1].empty());
+}
+
+TEST(ByteRingTest, EmptyRingStartsOver) {
+  alglib::ByteRing<8> ring;
+  ring.Commit(5);
+  ring.Consume(5);
+  EXPECT_EQ(ring.WritableSpans()[0].size(), 8);
+  EXPECT_TRUE(ring.WritableSpans()[1].empty());
+}
+
+TEST(ByteRingTest, WriteAndRead) {
+  alglib::ByteRing<8> ring;
+  std::vector<char> chars(6);
+  std::iota(chars.begin(), chars.end(), 'a');
+  EXPECT_EQ(ring.Write(Bytes(chars)), 6);
+  EXPECT_EQ(ring.Write(Bytes(chars)), 2);
+  EXPECT_TRUE(ring.IsFull());
+  std::array<char, 5> out{};
+  EXPECT_EQ(ring.Read(std::as_writable_bytes(std::span(out))), 5);
+  EXPECT_EQ(std::string(out.data(), 5), "abcde");
+  EXPECT_EQ(ring.Write(Bytes(chars)), 5);
+  std::vector<char> rest(10);
+  EXPECT_EQ(ring.Read(std::as_writable_bytes(std::span(rest))), 8);
+  EXPECT_EQ(std::string(rest.data(), 8), "fababcde");
+  EXPECT_TRUE(ring.IsEmpty());
+}
+
+TEST(ByteRingTest, Clear) {
+  alglib::ByteRing<4> ring;
+  ring.Commit(3);
+  ring.Clear();
+  EXPECT_TRUE(ring.IsEmpty());
+  EXPECT_EQ(ring.WritableSpans()[0].size(), 4);
+}
+
+#ifndef _WIN32
+TEST(ByteRingTest, VectoredIo) {
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  alglib::ByteRing<8> ring;
+  ring.Commit(5);
+  ring.Consume(4);
+  std::vector<char> chars{'h', 'e', 'l', 'l', 'o', '!'};
+  ring.Write(Bytes(chars));
+  ring.Consume(1);
+  auto readable{ring.ReadableSpans()};
+  ASSERT_FALSE(readable[1].empty());
+  std::array<iovec, 2> out{};
+  for (size_t i{}; i < 2; ++i) {
+    out[i] = {readable[i].data(), readable[i].size()};
+  }
+  ASSERT_EQ(writev(fds[1], out.data(), 2), 6);
+  ring.Consume(6);
+
+  auto writable{ring.WritableSpans()};
+  std::array<iovec, 2> in{};
+  for (size_t i{}; i < 2; ++i) {
+    in[i] = {writable[i].data(), writable[i].size()};
+  }
+  const ssize_t received{readv(fds[0], in.data(), 2)};
+  ASSERT_EQ(received, 6);
+  ring.Commit(static_cast<size_t>(received));
+  std::vector<char> result(6);
+  ring.Read(std::as_writable_bytes(std::span(result)));
+  EXPECT_EQ(result, chars);
+  close(fds[0]);
+  close(fds[1]);
+}
+#endif
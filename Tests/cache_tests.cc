@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cache.h"
+
+TEST(LRUCacheTest, GetAndPut) {
+  alglib::LRUCache<int, std::string> cache(2);
+  EXPECT_EQ(cache.Get(1), nullptr);
+  EXPECT_TRUE(cache.Put(1, "one"));
+  EXPECT_TRUE(cache.Put(2, "two"));
+  ASSERT_NE(cache.Get(1), nullptr);
+  EXPECT_EQ(*cache.Get(1), "one");
+  EXPECT_TRUE(cache.Put(3, "three"));
+  EXPECT_FALSE(cache.Contains(2));
+  EXPECT_TRUE(cache.Contains(1));
+  EXPECT_TRUE(cache.Contains(3));
+  EXPECT_EQ(cache.Size(), 2);
+}
+
+TEST(LRUCacheTest, PutReplacesValue) {
+  alglib::LRUCache<int, int> cache(2);
+  cache.Put(1, 10);
+  cache.Put(2, 20);
+  cache.Put(1, 11);
+  cache.Put(3, 30);
+  EXPECT_EQ(*cache.Get(1), 11);
+  EXPECT_FALSE(cache.Contains(2));
+  EXPECT_EQ(cache.Size(), 2);
+}
+
+TEST(LRUCacheTest, ContainsDoesNotRefresh) {
+  alglib::LRUCache<int, int> cache(2);
+  cache.Put(1, 10);
+  cache.Put(2, 20);
+  EXPECT_TRUE(cache.Contains(1));
+  cache.Put(3, 30);
+  EXPECT_FALSE(cache.Contains(1));
+}
+
+TEST(LRUCacheTest, EraseAndClear) {
+  alglib::LRUCache<int, int> cache(4);
+  cache.Put(1, 10, 5);
+  cache.Put(2, 20, 7);
+  EXPECT_TRUE(cache.Erase(1));
+  EXPECT_FALSE(cache.Erase(1));
+  EXPECT_EQ(cache.Bytes(), 7);
+  cache.Clear();
+  EXPECT_EQ(cache.Size(), 0);
+  EXPECT_EQ(cache.Bytes(), 0);
+  cache.Put(3, 30);
+  EXPECT_EQ(*cache.Get(3), 30);
+}
+
+TEST(LRUCacheTest, ByteCapacity) {
+  alglib::LRUCache<int, int> cache(100, 10);
+  cache.Put(1, 10, 4);
+  cache.Put(2, 20, 4);
+  cache.Put(3, 30, 4);
+  EXPECT_FALSE(cache.Contains(1));
+  EXPECT_EQ(cache.Bytes(), 8);
+  cache.Put(2, 21, 9);
+  EXPECT_FALSE(cache.Contains(3));
+  EXPECT_EQ(cache.Bytes(), 9);
+  EXPECT_FALSE(cache.Put(4, 40, 11));
+  EXPECT_FALSE(cache.Put(2, 22, 11));
+  EXPECT_FALSE(cache.Contains(2));
+  EXPECT_EQ(cache.Bytes(), 0);
+}
+
+TEST(LRUCacheTest, EvictionCallback) {
+  alglib::LRUCache<int, std::string> cache(1);
+  std::vector<std::pair<int, std::string>> evicted;
+  cache.SetEvictionCallback([&evicted](const int &key, std::string &value) {
+    evicted.emplace_back(key, value);
+  });
+  cache.Put(1, "one");
+  cache.Put(2, "two");
+  cache.Erase(2);
+  EXPECT_EQ(evicted, (std::vector<std::pair<int, std::string>>{{1, "one"}}));
+}
+
+TEST(LRUCacheTest, MoveOnlyValues) {
+  alglib::LRUCache<int, std::unique_ptr<int>> cache(2);
+  cache.Put(1, std::make_unique<int>(10));
+  cache.Put(1, std::make_unique<int>(11));
+  EXPECT_EQ(**cache.Get(1), 11);
+}
+
+TEST(LRUCacheTest, ZeroCapacity) {
+  alglib::LRUCache<int, int> cache(0);
+  EXPECT_FALSE(cache.Put(1, 10));
+  EXPECT_EQ(cache.Size(), 0);
+}
+
+TEST(LFUCacheTest, EvictsLeastFrequent) {
+  alglib::LFUCache<int, int> cache(3);
+  cache.Put(1, 10);
+  cache.Put(2, 20);
+  cache.Put(3, 30);
+  cache.Get(1);
+  cache.Get(1);
+  cache.Get(3);
+  cache.Put(4, 40);
+  EXPECT_FALSE(cache.Contains(2));
+  EXPECT_EQ(cache.Frequency(1), 3);
+  EXPECT_EQ(cache.Frequency(3), 2);
+  EXPECT_EQ(cache.Frequency(4), 1);
+  cache.Put(5, 50);
+  EXPECT_FALSE(cache.Contains(4));
+  EXPECT_TRUE(cache.Contains(5));
+  EXPECT_THROW(cache.Frequency(4), std::runtime_error);
+}
+
+TEST(LFUCacheTest, TiesEvictLeastRecent) {
+  alglib::LFUCache<int, int> cache(3);
+  cache.Put(1, 10);
+  cache.Put(2, 20);
+  cache.Put(3, 30);
+  cache.Get(2);
+  cache.Get(1);
+  cache.Get(3);
+  cache.Put(4, 40);
+  EXPECT_FALSE(cache.Contains(2));
+  cache.Put(5, 50);
+  EXPECT_FALSE(cache.Contains(4));
+  cache.Get(5);
+  cache.Put(6, 60);
+  EXPECT_FALSE(cache.Contains(1));
+  EXPECT_TRUE(cache.Contains(3));
+  EXPECT_TRUE(cache.Contains(5));
+  EXPECT_TRUE(cache.Contains(6));
+}
+
+TEST(LFUCacheTest, PutCountsAsUse) {
+  alglib::LFUCache<int, int> cache(2, 10);
+  cache.Put(1, 10, 5);
+  cache.Put(1, 11, 5);
+  cache.Put(2, 20, 5);
+  cache.Put(2, 21, 5);
+  cache.Put(2, 22, 6);
+  EXPECT_FALSE(cache.Contains(1));
+  EXPECT_EQ(*cache.Get(2), 22);
+  EXPECT_EQ(cache.Bytes(), 6);
+  EXPECT_EQ(cache.Frequency(2), 4);
+}
+
+TEST(LFUCacheTest, EraseKeepsOrder) {
+  alglib::LFUCache<int, int> cache(3);
+  std::vector<int> evicted;
+  cache.SetEvictionCallback(
+      [&evicted](const int &key, int &) { evicted.push_back(key); });
+  for (int key{1}; key <= 3; ++key) cache.Put(key, key);
+  cache.Get(2);
+  cache.Get(3);
+  cache.Erase(3);
+  cache.Put(4, 4);
+  cache.Put(5, 5);
+  cache.Put(6, 6);
+  EXPECT_EQ(evicted, std::vector<int>({1, 4}));
+  cache.Clear();
+  EXPECT_EQ(cache.Size(), 0);
+  cache.Put(7, 7);
+  EXPECT_EQ(cache.Frequency(7), 1);
+}
+
+TEST(ShardedCacheTest, SplitsCapacity) {
+  alglib::ShardedCache<alglib::LRUCache<int, int>> cache(4, 100);
+  EXPECT_EQ(cache.ShardCount(), 4);
+  for (int i{}; i < 1000; ++i) cache.Put(i, i * 2);
+  EXPECT_LE(cache.Size(), 100);
+  EXPECT_GT(cache.Size(), 50);
+  EXPECT_EQ(cache.Get(999), 1998);
+  EXPECT_FALSE(cache.Get(-1).has_value());
+  EXPECT_TRUE(cache.Erase(999));
+  EXPECT_FALSE(cache.Contains(999));
+  cache.Clear();
+  EXPECT_EQ(cache.Size(), 0);
+}
+
+TEST(ShardedCacheTest, ConcurrentUse) {
+  alglib::ShardedCache<alglib::LFUCache<int, int>> cache(8, 256, 1024);
+  std::atomic<size_t> evictions{};
+  cache.SetEvictionCallback([&evictions](const int &, int &) { ++evictions; });
+  std::vector<std::thread> threads;
+  for (int t{}; t < 4; ++t) {
+    threads.emplace_back([&cache, t] {
+      for (int i{}; i < 2000; ++i) {
+        const int key{(i * 31 + t) % 512};
+        if (std::optional<int> value{cache.Get(key)}) {
+          EXPECT_EQ(*value, key);
+        } else {
+          cache.Put(key, key, 4);
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads) thread.join();
+  EXPECT_LE(cache.Bytes(), 1024);
+  EXPECT_EQ(cache.Bytes(), cache.Size() * 4);
+  EXPECT_GT(evictions.load(), 0);
+}
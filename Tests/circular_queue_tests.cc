@@ -1,7 +1,25 @@
 #include <gtest/gtest.h>
 
+#include <string>
+#include <utility>
+
 #include "circular_queue.h"
 
+namespace {
+
+// Type without default constructor that counts its live objects.
+struct Tracked {
+  static inline int live{};
+
+  explicit Tracked(int value) : value(value) { ++live; }
+  Tracked(const Tracked &other) : value(other.value) { ++live; }
+  ~Tracked() { --live; }
+
+  int value;
+};
+
+}  // namespace
+
 TEST(CircularQueueTest, ConstructorAndIsEmpty) {
   alglib::CircularQueue<int, 5> queue;
   EXPECT_TRUE(queue.IsEmpty());
@@ -89,4 +107,85 @@ TEST(CircularQueueTest, CircularBehavior) {
   EXPECT_EQ(queue.Dequeue(), 30);
   EXPECT_EQ(queue.Dequeue(), 40);
   EXPECT_TRUE(queue.IsEmpty());
-}
\ No newline at end of file
+}
+
+TEST(CircularQueueTest, NoElementsConstructedUpFront) {
+  Tracked::live = 0;
+  {
+    alglib::CircularQueue<Tracked, 1000> queue;
+    EXPECT_EQ(Tracked::live, 0);
+    queue.Enqueue(Tracked(1));
+    queue.Enqueue(Tracked(2));
+    EXPECT_EQ(Tracked::live, 2);
+    queue.Dequeue();
+    EXPECT_EQ(Tracked::live, 1);
+  }
+  EXPECT_EQ(Tracked::live, 0);
+}
+
+TEST(CircularQueueTest, Emplace) {
+  alglib::CircularQueue<std::pair<int, std::string>, 2> queue;
+  auto &element{queue.Emplace(1, "one")};
+  EXPECT_EQ(element.second, "one");
+  queue.Emplace(2, "two");
+  EXPECT_THROW(queue.Emplace(3, "three"), std::runtime_error);
+  EXPECT_EQ(queue.PeekFront().second, "one");
+}
+
+TEST(CircularQueueTest, CopyAndMove) {
+  alglib::CircularQueue<std::string, 3> queue;
+  queue.Enqueue("a");
+  queue.Enqueue("b");
+  alglib::CircularQueue<std::string, 3> copy{queue};
+  alglib::CircularQueue<std::string, 3> moved{std::move(queue)};
+  EXPECT_EQ(copy.Dequeue(), moved.Dequeue());
+  copy = moved;
+  EXPECT_EQ(copy.Dequeue(), "b");
+  EXPECT_TRUE(copy.IsEmpty());
+}
+
+namespace {
+
+// Uses the container during constant evaluation.
+constexpr int ConstexprSum() {
+  alglib::CircularQueue<int, 4> queue;
+  for (int i{1}; i <= 6; ++i) {
+    if (queue.IsFull()) queue.Dequeue();
+    queue.Enqueue(i);
+  }
+  int sum{};
+  while (!queue.IsEmpty()) sum += queue.Dequeue();
+  return sum;
+}
+
+}  // namespace
+
+TEST(CircularQueueTest, ConstexprEvaluation) {
+  static_assert(ConstexprSum() == 18);
+}
+
+TEST(CircularQueueTest, TryEnqueueAndTryDequeue) {
+  alglib::CircularQueue<std::string, 2> queue;
+  std::string value{"unchanged"};
+  EXPECT_FALSE(queue.TryDequeue(value));
+  EXPECT_FALSE(queue.TryPeekFront(value));
+  EXPECT_FALSE(queue.TryPeekRear(value));
+  EXPECT_EQ(value, "unchanged");
+
+  EXPECT_TRUE(queue.TryEnqueue("a"));
+  std::string *element{queue.TryEmplace(2, 'b')};
+  ASSERT_NE(element, nullptr);
+  EXPECT_EQ(*element, "bb");
+  EXPECT_FALSE(queue.TryEnqueue("c"));
+  EXPECT_EQ(queue.TryEmplace("d"), nullptr);
+
+  EXPECT_TRUE(queue.TryPeekFront(value));
+  EXPECT_EQ(value, "a");
+  EXPECT_TRUE(queue.TryPeekRear(value));
+  EXPECT_EQ(value, "bb");
+  EXPECT_TRUE(queue.TryDequeue(value));
+  EXPECT_EQ(value, "a");
+  EXPECT_TRUE(queue.TryEnqueue("e"));
+  EXPECT_TRUE(queue.TryPeekRear(value));
+  EXPECT_EQ(value, "e");
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "concurrent_queue.h"
+
+TEST(ConcurrentQueueTest, ConstructorAndIsEmpty) {
+  alglib::ConcurrentQueue<int> queue;
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(ConcurrentQueueTest, EnqueueAndDequeue) {
+  alglib::ConcurrentQueue<int> queue;
+  queue.Enqueue(10);
+  queue.Enqueue(20);
+  EXPECT_FALSE(queue.IsEmpty());
+  EXPECT_EQ(queue.Dequeue(), 10);
+  EXPECT_EQ(queue.Dequeue(), 20);
+  EXPECT_TRUE(queue.IsEmpty());
+  EXPECT_THROW(queue.Dequeue(), std::runtime_error);
+}
+
+TEST(ConcurrentQueueTest, TryDequeue) {
+  alglib::ConcurrentQueue<std::string> queue;
+  std::string value{"unchanged"};
+  EXPECT_FALSE(queue.TryDequeue(value));
+  EXPECT_EQ(value, "unchanged");
+  queue.Enqueue("first");
+  EXPECT_TRUE(queue.TryDequeue(value));
+  EXPECT_EQ(value, "first");
+}
+
+TEST(ConcurrentQueueTest, EnqueueBulk) {
+  alglib::ConcurrentQueue<int> queue;
+  std::vector<int> values{1, 2, 3, 4};
+  queue.Enqueue(0);
+  queue.EnqueueBulk(values.begin(), values.end());
+  queue.EnqueueBulk(values.end(), values.end());
+  queue.Enqueue(5);
+  for (int i{}; i <= 5; ++i) EXPECT_EQ(queue.Dequeue(), i);
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(ConcurrentQueueTest, MoveOnlyValues) {
+  alglib::ConcurrentQueue<std::unique_ptr<int>> queue;
+  queue.Enqueue(std::make_unique<int>(7));
+  EXPECT_EQ(*queue.Dequeue(), 7);
+}
+
+TEST(ConcurrentQueueTest, DestructorReleasesElements) {
+  auto shared{std::make_shared<int>(1)};
+  {
+    alglib::ConcurrentQueue<std::shared_ptr<int>> queue;
+    for (int i{}; i < 10; ++i) queue.Enqueue(shared);
+    queue.Dequeue();
+    EXPECT_EQ(shared.use_count(), 10);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(ConcurrentQueueTest, ManyProducersAndConsumers) {
+  constexpr int kProducers{4};
+  constexpr int kConsumers{4};
+  constexpr int kPerProducer{20000};
+  alglib::ConcurrentQueue<int> queue;
+  std::atomic<long long> sum{};
+  std::atomic<int> consumed{};
+  std::vector<std::thread> threads;
+  for (int p{}; p < kProducers; ++p) {
+    threads.emplace_back([&queue, p] {
+      std::vector<int> batch;
+      for (int i{}; i < kPerProducer; ++i) {
+        const int value{p * kPerProducer + i};
+        if (i % 4 == 0) {
+          queue.Enqueue(value);
+        } else {
+          batch.push_back(value);
+          if (batch.size() == 3) {
+            queue.EnqueueBulk(batch.begin(), batch.end());
+            batch.clear();
+          }
+        }
+      }
+      queue.EnqueueBulk(batch.begin(), batch.end());
+    });
+  }
+  for (int c{}; c < kConsumers; ++c) {
+    threads.emplace_back([&] {
+      std::vector<int> last(kProducers, -1);
+      int value;
+      while (consumed.load() < kProducers * kPerProducer) {
+        if (!queue.TryDequeue(value)) continue;
+        // Elements of a single producer come out in the order they went in.
+        const int producer{value / kPerProducer};
+        EXPECT_GT(value, last[producer]);
+        last[producer] = value;
+        sum += value;
+        ++consumed;
+      }
+    });
+  }
+  for (std::thread &thread : threads) thread.join();
+  const long long total{static_cast<long long>(kProducers) * kPerProducer};
+  EXPECT_EQ(consumed.load(), total);
+  EXPECT_EQ(sum.load(), total * (total - 1) / 2);
+  EXPECT_TRUE(queue.IsEmpty());
+}
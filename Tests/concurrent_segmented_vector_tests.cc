@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "concurrent_segmented_vector.h"
+#include "traversal.h"
+
+namespace {
+
+// Value whose constructor throws for one given argument, used to check
+// that a failed append leaves a slot that is never published.
+struct Picky {
+  explicit Picky(int value) : value(value) {
+    if (value < 0) throw std::runtime_error("negative value");
+  }
+  int value;
+};
+
+}  // namespace
+
+TEST(ConcurrentSegmentedVectorTest, ConstructorAndIsEmpty) {
+  alglib::ConcurrentSegmentedVector<int> vector;
+  EXPECT_TRUE(vector.IsEmpty());
+  EXPECT_EQ(vector.Size(), 0);
+  EXPECT_EQ(vector.TryGet(0), nullptr);
+  EXPECT_THROW(vector.At(0), std::runtime_error);
+}
+
+TEST(ConcurrentSegmentedVectorTest, PushBackReturnsIndices) {
+  alglib::ConcurrentSegmentedVector<std::string, 2> vector;
+  for (int i{}; i < 100; ++i) {
+    EXPECT_EQ(vector.PushBack(std::to_string(i)), static_cast<size_t>(i));
+  }
+  EXPECT_EQ(vector.Size(), 100);
+  for (int i{}; i < 100; ++i) {
+    EXPECT_EQ(vector[i], std::to_string(i));
+    EXPECT_EQ(vector.At(i), std::to_string(i));
+  }
+  EXPECT_THROW(vector.At(100), std::runtime_error);
+}
+
+TEST(ConcurrentSegmentedVectorTest, ReferencesStayValidWhileGrowing) {
+  alglib::ConcurrentSegmentedVector<int, 1> vector;
+  int &first{vector.Emplace(42)};
+  const int *address{&first};
+  for (int i{}; i < 10000; ++i) vector.PushBack(i);
+  EXPECT_EQ(&vector[0], address);
+  EXPECT_EQ(first, 42);
+}
+
+TEST(ConcurrentSegmentedVectorTest, ThrowingConstructorLeavesHole) {
+  alglib::ConcurrentSegmentedVector<Picky> vector;
+  vector.Emplace(1);
+  EXPECT_THROW(vector.Emplace(-1), std::runtime_error);
+  vector.Emplace(3);
+  EXPECT_EQ(vector.Size(), 3);
+  EXPECT_EQ(vector.TryGet(1), nullptr);
+  EXPECT_EQ(vector.TryGet(2)->value, 3);
+  int sum{};
+  vector.Traverse([&sum](const Picky &picky) { sum += picky.value; });
+  EXPECT_EQ(sum, 4);
+}
+
+TEST(ConcurrentSegmentedVectorTest, TraverseWorksWithHelpers) {
+  alglib::ConcurrentSegmentedVector<int> vector;
+  vector.Reserve(1000);
+  for (int i{1}; i <= 1000; ++i) vector.PushBack(i);
+  EXPECT_EQ(alglib::Accumulate(vector, 0LL), 500500);
+  EXPECT_EQ(alglib::CountIf(vector, [](int value) { return value > 990; }),
+            10);
+}
+
+TEST(ConcurrentSegmentedVectorTest, DestructorReleasesElements) {
+  auto shared{std::make_shared<int>(1)};
+  {
+    alglib::ConcurrentSegmentedVector<std::shared_ptr<int>> vector;
+    for (int i{}; i < 100; ++i) vector.PushBack(shared);
+    EXPECT_EQ(shared.use_count(), 101);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(ConcurrentSegmentedVectorTest, ConcurrentAppendsAndReads) {
+  constexpr int kWriters{4};
+  constexpr int kPerWriter{20000};
+  alglib::ConcurrentSegmentedVector<int, 4> vector;
+  std::atomic<bool> done{false};
+  std::atomic<bool> reader_failed{false};
+
+  // The reader checks that every published element holds a value that
+  // some writer appended, while the writers keep growing the vector.
+  std::thread reader([&] {
+    while (!done.load(std::memory_order_acquire)) {
+      const size_t size{vector.Size()};
+      for (size_t index{}; index < size; ++index) {
+        const int *value{vector.TryGet(index)};
+        if (value && (*value < 0 || *value >= kWriters * kPerWriter)) {
+          reader_failed = true;
+        }
+      }
+    }
+  });
+  std::vector<std::thread> writers;
+  std::vector<std::vector<size_t>> indices(kWriters);
+  for (int writer{}; writer < kWriters; ++writer) {
+    writers.emplace_back([&, writer] {
+      for (int i{}; i < kPerWriter; ++i) {
+        const size_t index{vector.PushBack(writer * kPerWriter + i)};
+        indices[writer].push_back(index);
+        if (vector[index] != writer * kPerWriter + i) reader_failed = true;
+      }
+    });
+  }
+  for (std::thread &writer : writers) writer.join();
+  done = true;
+  reader.join();
+
+  EXPECT_FALSE(reader_failed);
+  ASSERT_EQ(vector.Size(), static_cast<size_t>(kWriters * kPerWriter));
+  std::vector<bool> seen(kWriters * kPerWriter);
+  for (int writer{}; writer < kWriters; ++writer) {
+    for (int i{}; i < kPerWriter; ++i) {
+      EXPECT_EQ(vector.At(indices[writer][i]), writer * kPerWriter + i);
+      seen[indices[writer][i]] = true;
+    }
+  }
+  EXPECT_EQ(std::count(seen.begin(), seen.end(), true),
+            kWriters * kPerWriter);
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "concurrent_stack.h"
+
+TEST(ConcurrentStackTest, ConstructorAndIsEmpty) {
+  alglib::ConcurrentStack<int> stack;
+  EXPECT_TRUE(stack.IsEmpty());
+}
+
+TEST(ConcurrentStackTest, PushAndTop) {
+  alglib::ConcurrentStack<std::string> stack;
+  stack.Push("a");
+  EXPECT_EQ(stack.Top(), "a");
+  stack.Push("b");
+  EXPECT_EQ(stack.Top(), "b");
+  EXPECT_FALSE(stack.IsEmpty());
+}
+
+TEST(ConcurrentStackTest, Pop) {
+  alglib::ConcurrentStack<int> stack;
+  stack.Push(10);
+  stack.Push(20);
+  EXPECT_EQ(stack.Pop(), 20);
+  EXPECT_EQ(stack.Pop(), 10);
+  EXPECT_TRUE(stack.IsEmpty());
+  EXPECT_THROW(stack.Pop(), std::runtime_error);
+  EXPECT_THROW(stack.Top(), std::runtime_error);
+}
+
+TEST(ConcurrentStackTest, TryPop) {
+  alglib::ConcurrentStack<int> stack;
+  int value{-1};
+  EXPECT_FALSE(stack.TryPop(value));
+  EXPECT_EQ(value, -1);
+  stack.Push(5);
+  EXPECT_TRUE(stack.TryPop(value));
+  EXPECT_EQ(value, 5);
+}
+
+TEST(ConcurrentStackTest, PopAll) {
+  alglib::ConcurrentStack<int> stack;
+  for (int i{}; i < 5; ++i) stack.Push(i);
+  std::vector<int> values;
+  EXPECT_EQ(stack.PopAll(std::back_inserter(values)), 5);
+  EXPECT_EQ(values, (std::vector<int>{4, 3, 2, 1, 0}));
+  EXPECT_TRUE(stack.IsEmpty());
+  EXPECT_EQ(stack.PopAll(std::back_inserter(values)), 0);
+}
+
+TEST(ConcurrentStackTest, MoveOnlyValues) {
+  alglib::ConcurrentStack<std::unique_ptr<int>> stack;
+  stack.Push(std::make_unique<int>(1));
+  stack.Push(std::make_unique<int>(2));
+  EXPECT_EQ(*stack.Pop(), 2);
+  std::vector<std::unique_ptr<int>> values;
+  stack.PopAll(std::back_inserter(values));
+  ASSERT_EQ(values.size(), 1);
+  EXPECT_EQ(*values[0], 1);
+}
+
+TEST(ConcurrentStackTest, TopRacesWithPopOfStrings) {
+  constexpr int kThreads{8};
+  constexpr int kRounds{20000};
+  // Long enough to live on the heap, so a moved from string would be empty.
+  const std::string text(64, 'x');
+  alglib::ConcurrentStack<std::string> stack;
+  for (int i{}; i < kThreads; ++i) stack.Push(text);
+  std::vector<std::thread> threads;
+  for (int t{}; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (int round{}; round < kRounds; ++round) {
+        if (t % 2 == 0) {
+          std::string value;
+          if (stack.TryPop(value)) {
+            EXPECT_EQ(value, text);
+            stack.Push(std::move(value));
+          }
+        } else {
+          try {
+            EXPECT_EQ(stack.Top(), text);
+          } catch (const std::runtime_error &) {
+          }
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads) thread.join();
+}
+
+TEST(ConcurrentStackTest, DestructorReleasesElements) {
+  auto shared{std::make_shared<int>(1)};
+  {
+    alglib::ConcurrentStack<std::shared_ptr<int>> stack;
+    for (int i{}; i < 5; ++i) stack.Push(shared);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(ConcurrentStackTest, ManyThreadsRecycleObjects) {
+  constexpr int kThreads{8};
+  constexpr int kObjects{64};
+  constexpr int kRounds{5000};
+  alglib::ConcurrentStack<int> stack;
+  for (int i{}; i < kObjects; ++i) stack.Push(i);
+  std::vector<std::thread> threads;
+  for (int t{}; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      std::vector<int> held;
+      for (int round{}; round < kRounds; ++round) {
+        int value;
+        if (stack.TryPop(value)) held.push_back(value);
+        if (round % 7 == t % 7) {
+          // Top races with pops of the same node on other threads.
+          try {
+            EXPECT_LT(stack.Top(), kObjects);
+          } catch (const std::runtime_error &) {
+          }
+        }
+        if (held.size() > 2 || (round % 3 == 0 && !held.empty())) {
+          stack.Push(held.back());
+          held.pop_back();
+        }
+      }
+      for (int value : held) stack.Push(value);
+    });
+  }
+  for (std::thread &thread : threads) thread.join();
+  std::vector<int> values;
+  stack.PopAll(std::back_inserter(values));
+  std::sort(values.begin(), values.end());
+  ASSERT_EQ(values.size(), kObjects);
+  for (int i{}; i < kObjects; ++i) EXPECT_EQ(values[i], i);
+}
@@ -1,7 +1,37 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <memory_resource>
+
 #include "doubly_linked_list.h"
 
+namespace {
+
+// Memory resource that counts allocations and releases, used to check that
+// the container takes all of its memory from the given resource.
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  size_t allocations{};
+  size_t deallocations{};
+
+ private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+    ++deallocations;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+}  // namespace
+
 TEST(DoublyLinkedListTest, ConstructorAndIsEmpty) {
   alglib::DoublyLinkedList<int> list;
   EXPECT_TRUE(list.IsEmpty());
@@ -106,10 +136,10 @@ TEST(DoublyLinkedListTest, Find) {
   list.InsertAtEnd(20);
   list.InsertAtEnd(30);
 
-  EXPECT_EQ(list.Find(10), 0);
-  EXPECT_EQ(list.Find(20), 1);
-  EXPECT_EQ(list.Find(30), 2);
-  EXPECT_THROW(list.Find(40), std::runtime_error); 
+  EXPECT_EQ(list.Find(10), list.begin());
+  EXPECT_EQ(*list.Find(20), 20);
+  EXPECT_EQ(std::next(list.Find(30)), list.end());
+  EXPECT_EQ(list.Find(40), list.end()); 
 }
 
 TEST(DoublyLinkedListTest, GetAsVector) {
@@ -139,4 +169,105 @@ TEST(DoublyLinkedListTest, Destructor) {
 
   delete list; 
   EXPECT_TRUE(true); 
-}
\ No newline at end of file
+}
+
+TEST(DoublyLinkedListTest, MemoryResource) {
+  CountingResource resource;
+  {
+    alglib::pmr::DoublyLinkedList<int> list(&resource);
+    list.InsertAtEnd(10);
+    list.InsertAtBeginning(5);
+    list.InsertAtPosition(1, 7);
+    EXPECT_EQ(list.GetAsVector(), std::vector<int>({5, 7, 10}));
+    EXPECT_EQ(resource.allocations, 3);
+    list.DeleteAtBeginning();
+    EXPECT_EQ(resource.deallocations, 1);
+  }
+  EXPECT_EQ(resource.deallocations, resource.allocations);
+}
+
+TEST(DoublyLinkedListTest, Iterators) {
+  alglib::DoublyLinkedList<int> list;
+  EXPECT_EQ(list.begin(), list.end());
+  for (int i{}; i < 5; ++i) list.InsertAtEnd(i);
+
+  std::vector<int> forward(list.begin(), list.end());
+  EXPECT_EQ(forward, std::vector<int>({0, 1, 2, 3, 4}));
+
+  std::vector<int> backward;
+  for (auto it{list.end()}; it != list.begin();) backward.push_back(*--it);
+  EXPECT_EQ(backward, std::vector<int>({4, 3, 2, 1, 0}));
+
+  for (int &value : list) value *= 10;
+  const alglib::DoublyLinkedList<int> &view{list};
+  alglib::DoublyLinkedList<int>::ConstIterator it{list.begin()};
+  EXPECT_EQ(it, view.cbegin());
+  EXPECT_EQ(*std::prev(view.end()), 40);
+  static_assert(std::bidirectional_iterator<
+                alglib::DoublyLinkedList<int>::Iterator>);
+  static_assert(std::bidirectional_iterator<
+                alglib::DoublyLinkedList<int>::ConstIterator>);
+}
+
+TEST(DoublyLinkedListTest, InsertBeforeAndErase) {
+  alglib::DoublyLinkedList<int> list;
+  auto it{list.InsertBefore(list.end(), 30)};
+  list.InsertBefore(it, 10);
+  auto middle{list.InsertBefore(it, 20)};
+  list.InsertBefore(list.end(), 40);
+  EXPECT_EQ(list.GetAsVector(), std::vector<int>({10, 20, 30, 40}));
+  EXPECT_EQ(list.Size(), 4);
+
+  EXPECT_EQ(*list.Erase(middle), 30);
+  EXPECT_EQ(list.Erase(list.Find(40)), list.end());
+  EXPECT_EQ(list.Erase(list.begin()), it);
+  EXPECT_EQ(list.GetAsVector(), std::vector<int>({30}));
+  EXPECT_THROW(list.Erase(list.end()), std::runtime_error);
+  list.Erase(it);
+  EXPECT_TRUE(list.IsEmpty());
+  EXPECT_THROW(list.Erase(list.begin()), std::runtime_error);
+}
+
+TEST(DoublyLinkedListTest, PositionsMatchStdList) {
+  alglib::DoublyLinkedList<int> list;
+  std::list<int> expected;
+  for (int i{}; i < 200; ++i) {
+    const size_t pos{(static_cast<size_t>(i) * 37) % (expected.size() + 1)};
+    list.InsertAtPosition(static_cast<uint32_t>(pos), i);
+    expected.insert(std::next(expected.begin(), pos), i);
+  }
+  for (int i{}; i < 150; ++i) {
+    const size_t pos{(static_cast<size_t>(i) * 53) % expected.size()};
+    list.DeleteAtPosition(static_cast<uint32_t>(pos));
+    expected.erase(std::next(expected.begin(), pos));
+  }
+  EXPECT_EQ(list.Size(), expected.size());
+  EXPECT_TRUE(std::equal(list.begin(), list.end(), expected.begin(),
+                         expected.end()));
+  std::vector<int> backward;
+  for (auto it{list.end()}; it != list.begin();) backward.push_back(*--it);
+  EXPECT_TRUE(std::equal(backward.begin(), backward.end(), expected.rbegin(),
+                         expected.rend()));
+}
+
+TEST(DoublyLinkedListTest, Splice) {
+  alglib::DoublyLinkedList<int> list;
+  alglib::DoublyLinkedList<int> other;
+  for (int i{}; i < 4; ++i) list.InsertAtEnd(i);
+  other.InsertAtEnd(10);
+
+  auto last{list.Find(3)};
+  list.Splice(list.begin(), list, last);
+  EXPECT_EQ(list.GetAsVector(), std::vector<int>({3, 0, 1, 2}));
+  list.Splice(list.end(), list, list.begin());
+  list.Splice(list.end(), list, list.Find(3));
+  EXPECT_EQ(list.GetAsVector(), std::vector<int>({0, 1, 2, 3}));
+
+  list.Splice(list.Find(2), other, other.begin());
+  EXPECT_EQ(list.GetAsVector(), std::vector<int>({0, 1, 10, 2, 3}));
+  EXPECT_EQ(list.Size(), 5);
+  EXPECT_TRUE(other.IsEmpty());
+  EXPECT_EQ(*std::prev(list.end()), 3);
+  EXPECT_THROW(list.Splice(list.begin(), other, other.end()),
+               std::runtime_error);
+}
@@ -0,0 +1,249 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "flat_hash_map.h"
+
+namespace {
+
+// Hash that puts every key in the same group, to exercise long probes.
+struct CollidingHash {
+  size_t operator()(int) const noexcept { return 0; }
+};
+
+// Counts live instances, to check that no element is leaked or destroyed
+// twice.
+struct Counted {
+  static inline int live{};
+
+  explicit Counted(int value) : value(value) { ++live; }
+  Counted(const Counted &other) : value(other.value) { ++live; }
+  ~Counted() { --live; }
+
+  int value;
+};
+
+// Key that counts how many times it was copied.
+struct CopyCountedKey {
+  static inline int copies{};
+
+  explicit CopyCountedKey(int value) : value(value) {}
+  CopyCountedKey(const CopyCountedKey &other) : value(other.value) {
+    ++copies;
+  }
+  CopyCountedKey(CopyCountedKey &&other) noexcept = default;
+  bool operator==(const CopyCountedKey &other) const {
+    return value == other.value;
+  }
+
+  int value;
+};
+
+struct CopyCountedKeyHash {
+  size_t operator()(const CopyCountedKey &key) const noexcept {
+    return std::hash<int>{}(key.value);
+  }
+};
+
+// Mapped value whose construction throws for negative arguments.
+struct Picky {
+  explicit Picky(int value) : value(value) {
+    if (value < 0) throw std::runtime_error("negative");
+  }
+
+  int value;
+};
+
+}  // namespace
+
+TEST(FlatHashMapTest, InsertFindAndAt) {
+  alglib::FlatHashMap<int, std::string> map;
+  EXPECT_TRUE(map.IsEmpty());
+  EXPECT_EQ(map.Find(1), map.end());
+  EXPECT_TRUE(map.Insert({1, "one"}).second);
+  EXPECT_FALSE(map.Insert({1, "uno"}).second);
+  EXPECT_TRUE(map.TryEmplace(2, 3, 'x').second);
+  map[3] = "three";
+  EXPECT_EQ(map.Size(), 3);
+  EXPECT_EQ(map.At(1), "one");
+  EXPECT_EQ(map.At(2), "xxx");
+  EXPECT_EQ(map.Find(3)->second, "three");
+  EXPECT_TRUE(map.Contains(2));
+  EXPECT_FALSE(map.Contains(4));
+  EXPECT_THROW(map.At(4), std::runtime_error);
+  EXPECT_FALSE(map.InsertOrAssign(1, "first").second);
+  EXPECT_EQ(map.At(1), "first");
+}
+
+TEST(FlatHashMapTest, MatchesUnorderedMapUnderRandomOperations) {
+  std::mt19937 random(7);
+  alglib::FlatHashMap<int, int> map;
+  std::unordered_map<int, int> expected;
+  for (int i{}; i < 100000; ++i) {
+    const int key{static_cast<int>(random() % 5000)};
+    if (random() % 3 == 0) {
+      EXPECT_EQ(map.Erase(key), expected.erase(key));
+    } else {
+      map[key] += i;
+      expected[key] += i;
+    }
+  }
+  EXPECT_EQ(map.Size(), expected.size());
+  size_t visited{};
+  for (const auto &[key, value] : map) {
+    EXPECT_EQ(expected.at(key), value);
+    ++visited;
+  }
+  EXPECT_EQ(visited, expected.size());
+  EXPECT_LE(map.LoadFactor(), 0.875f);
+}
+
+TEST(FlatHashMapTest, CollidingKeysProbeManyGroups) {
+  alglib::FlatHashMap<int, int, CollidingHash> map;
+  for (int i{}; i < 100; ++i) map[i] = i * 2;
+  for (int i{}; i < 100; i += 2) EXPECT_EQ(map.Erase(i), 1);
+  for (int i{}; i < 100; ++i) {
+    EXPECT_EQ(map.Contains(i), i % 2 == 1);
+  }
+  // Deleted slots in the full groups are reused by new keys.
+  for (int i{}; i < 100; i += 2) map[i] = i;
+  EXPECT_EQ(map.Size(), 100);
+  for (int i{}; i < 100; ++i) EXPECT_EQ(map.At(i), i % 2 ? i * 2 : i);
+}
+
+TEST(FlatHashMapTest, EraseKeepsSlotsReusableWithoutGrowing) {
+  alglib::FlatHashMap<int, int> map;
+  map.Reserve(1000);
+  const size_t capacity{map.Capacity()};
+  for (int round{}; round < 50; ++round) {
+    for (int i{}; i < 1000; ++i) map[round * 1000 + i] = i;
+    for (int i{}; i < 1000; ++i) map.Erase(round * 1000 + i);
+  }
+  EXPECT_TRUE(map.IsEmpty());
+  EXPECT_EQ(map.Capacity(), capacity);
+}
+
+TEST(FlatHashMapTest, EraseByIteratorVisitsRemaining) {
+  alglib::FlatHashMap<int, int> map;
+  for (int i{}; i < 200; ++i) map[i] = i;
+  for (auto it{map.begin()}; it != map.end();) {
+    it = it->first % 3 == 0 ? map.Erase(it) : std::next(it);
+  }
+  EXPECT_EQ(map.Size(), 133);
+  for (const auto &[key, value] : map) EXPECT_NE(key % 3, 0);
+}
+
+TEST(FlatHashMapTest, MoveOnlyValuesSurviveGrowth) {
+  alglib::FlatHashMap<int, std::unique_ptr<int>> map;
+  for (int i{}; i < 1000; ++i) map[i] = std::make_unique<int>(i);
+  for (int i{}; i < 1000; ++i) EXPECT_EQ(*map.At(i), i);
+}
+
+TEST(FlatHashMapTest, GrowthMovesKeys) {
+  alglib::FlatHashMap<CopyCountedKey, std::unique_ptr<int>, CopyCountedKeyHash>
+      map;
+  for (int i{}; i < 1000; ++i) {
+    map.TryEmplace(CopyCountedKey(i), std::make_unique<int>(i));
+  }
+  EXPECT_EQ(CopyCountedKey::copies, 0);
+  EXPECT_EQ(*map.At(CopyCountedKey(999)), 999);
+}
+
+TEST(FlatHashMapTest, HeterogeneousLookup) {
+  alglib::FlatHashMap<std::string, int, alglib::StringHash, std::equal_to<>>
+      map{{"alpha", 1}, {"beta", 2}};
+  const std::string_view beta{"beta"};
+  EXPECT_EQ(map.Find(beta)->second, 2);
+  EXPECT_EQ(map.At("alpha"), 1);
+  EXPECT_TRUE(map.Contains("beta"));
+  EXPECT_FALSE(map.Contains(std::string_view("gamma")));
+  EXPECT_EQ(map.Erase(beta), 1);
+  EXPECT_EQ(map.Size(), 1);
+}
+
+TEST(FlatHashMapTest, CopyMoveAndClearManageLifetimes) {
+  {
+    alglib::FlatHashMap<int, Counted> map;
+    for (int i{}; i < 100; ++i) map.TryEmplace(i, i);
+    alglib::FlatHashMap<int, Counted> copy{map};
+    EXPECT_EQ(Counted::live, 200);
+    EXPECT_EQ(copy.At(42).value, 42);
+    alglib::FlatHashMap<int, Counted> moved{std::move(map)};
+    EXPECT_TRUE(map.IsEmpty());
+    EXPECT_EQ(Counted::live, 200);
+    copy = moved;
+    EXPECT_EQ(Counted::live, 200);
+    moved.Clear();
+    EXPECT_EQ(Counted::live, 100);
+    EXPECT_FALSE(moved.Contains(42));
+  }
+  EXPECT_EQ(Counted::live, 0);
+}
+
+TEST(FlatHashMapTest, ThrowingConstructorLeavesMapUnchanged) {
+  alglib::FlatHashMap<int, Picky> map;
+  map.TryEmplace(1, 1);
+  EXPECT_THROW(map.TryEmplace(2, -1), std::runtime_error);
+  EXPECT_EQ(map.Size(), 1);
+  EXPECT_FALSE(map.Contains(2));
+  EXPECT_TRUE(map.TryEmplace(2, 2).second);
+  EXPECT_EQ(map.At(2).value, 2);
+}
+
+TEST(FlatHashMapTest, MemoryResourceAllocators) {
+  using Map =
+      alglib::FlatHashMap<int, std::pmr::string, std::hash<int>,
+                          std::equal_to<int>,
+                          std::pmr::polymorphic_allocator<
+                              std::pair<const int, std::pmr::string>>>;
+  std::pmr::unsynchronized_pool_resource first;
+  std::pmr::unsynchronized_pool_resource second;
+  Map map(0, {}, {}, &first);
+  for (int i{}; i < 100; ++i) map[i] = std::to_string(i).c_str();
+  EXPECT_EQ(map.At(5).get_allocator().resource(), &first);
+
+  // The allocator doesn't propagate, so the elements are copied and moved
+  // into memory of the second resource.
+  Map other(0, {}, {}, &second);
+  other[-1] = "old";
+  other = map;
+  EXPECT_EQ(other.Size(), 100);
+  EXPECT_EQ(other.At(5).get_allocator().resource(), &second);
+  other = std::move(map);
+  EXPECT_EQ(other.Size(), 100);
+  EXPECT_EQ(other.At(42), "42");
+  EXPECT_EQ(other.At(42).get_allocator().resource(), &second);
+}
+
+TEST(FlatHashSetTest, InsertEraseAndIterate) {
+  alglib::FlatHashSet<std::string> set{"a", "b", "c"};
+  EXPECT_FALSE(set.Insert("a").second);
+  EXPECT_TRUE(set.Emplace(3, 'd').second);
+  EXPECT_EQ(*set.Find("ddd"), "ddd");
+  EXPECT_EQ(set.Erase("b"), 1);
+  EXPECT_EQ(set.Erase("b"), 0);
+  std::vector<std::string> keys(set.begin(), set.end());
+  std::sort(keys.begin(), keys.end());
+  EXPECT_EQ(keys, (std::vector<std::string>{"a", "c", "ddd"}));
+}
+
+TEST(FlatHashSetTest, MatchesUnorderedSet) {
+  std::mt19937 random(3);
+  alglib::FlatHashSet<int> set;
+  std::unordered_set<int> expected;
+  for (int i{}; i < 20000; ++i) {
+    const int key{static_cast<int>(random())};
+    EXPECT_EQ(set.Insert(key).second, expected.insert(key).second);
+  }
+  for (int key : expected) EXPECT_TRUE(set.Contains(key));
+  EXPECT_EQ(set.Size(), expected.size());
+}
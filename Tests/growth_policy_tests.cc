@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+
+#include "growth_policy.h"
+
+static_assert(alglib::GrowthPolicy<alglib::DoublingGrowth>);
+static_assert(alglib::GrowthPolicy<alglib::FixedChunkGrowth<64>>);
+static_assert(!alglib::GrowthPolicy<int>);
+
+TEST(GrowthPolicyTest, DoublingGrowth) {
+  constexpr alglib::DoublingGrowth growth;
+  EXPECT_EQ(growth(0, 1), alglib::kInitialGrowthCapacity);
+  EXPECT_EQ(growth(0, 10), 10);
+  EXPECT_EQ(growth(8, 9), 16);
+  EXPECT_EQ(growth(8, 100), 100);
+}
+
+TEST(GrowthPolicyTest, OneAndHalfGrowth) {
+  constexpr alglib::OneAndHalfGrowth growth;
+  EXPECT_EQ(growth(4, 5), 6);
+  EXPECT_EQ(growth(9, 10), 13);
+  EXPECT_EQ(growth(1, 2), 2);
+}
+
+TEST(GrowthPolicyTest, FixedChunkGrowth) {
+  constexpr alglib::FixedChunkGrowth<10> growth;
+  EXPECT_EQ(growth(0, 1), 10);
+  EXPECT_EQ(growth(10, 11), 20);
+  EXPECT_EQ(growth(20, 45), 50);
+}
+
+TEST(GrowthPolicyTest, PoliciesAreConstexpr) {
+  static_assert(alglib::DoublingGrowth()(16, 17) == 32);
+  static_assert(alglib::FixedChunkGrowth<4>()(4, 5) == 8);
+}
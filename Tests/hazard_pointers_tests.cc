@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "hazard_pointers.h"
+
+namespace {
+
+// Counts objects released by the deleter.
+std::atomic<int> released{};
+
+void ReleaseInt(void *node) {
+  delete static_cast<int *>(node);
+  ++released;
+}
+
+}  // namespace
+
+TEST(HazardPointersTest, ProtectReturnsCurrentValue) {
+  int value{};
+  std::atomic<int *> source{&value};
+  EXPECT_EQ(alglib::HazardPointers::Protect(0, source), &value);
+  alglib::HazardPointers::Clear(0);
+  source.store(nullptr);
+  EXPECT_EQ(alglib::HazardPointers::Protect(1, source), nullptr);
+}
+
+TEST(HazardPointersTest, ProtectedNodeIsNotReleased) {
+  released = 0;
+  int *node{new int(1)};
+  std::atomic<int *> source{node};
+  alglib::HazardPointers::Protect(0, source);
+  source.store(nullptr);
+  alglib::HazardPointers::Retire(node, &ReleaseInt);
+  alglib::HazardPointers::Scan();
+  EXPECT_EQ(released, 0);
+  EXPECT_EQ(alglib::HazardPointers::RetiredCount(), 1);
+  alglib::HazardPointers::Clear(0);
+  alglib::HazardPointers::Scan();
+  EXPECT_EQ(released, 1);
+  EXPECT_EQ(alglib::HazardPointers::RetiredCount(), 0);
+}
+
+TEST(HazardPointersTest, ReservedRetireDefersRelease) {
+  released = 0;
+  alglib::HazardPointers::Reserve(2);
+  alglib::HazardPointers::RetireReserved(new int(1), &ReleaseInt);
+  alglib::HazardPointers::RetireReserved(new int(2), &ReleaseInt);
+  EXPECT_EQ(released, 0);
+  EXPECT_EQ(alglib::HazardPointers::RetiredCount(), 2);
+  alglib::HazardPointers::Scan();
+  EXPECT_EQ(released, 2);
+  EXPECT_EQ(alglib::HazardPointers::RetiredCount(), 0);
+}
+
+TEST(HazardPointersTest, NodeProtectedByOtherThread) {
+  released = 0;
+  int *node{new int(1)};
+  std::atomic<int *> source{node};
+  std::atomic<bool> protected_node{false};
+  std::atomic<bool> done{false};
+  std::thread reader([&] {
+    alglib::HazardPointers::Protect(0, source);
+    protected_node = true;
+    while (!done) std::this_thread::yield();
+    alglib::HazardPointers::Clear(0);
+  });
+  while (!protected_node) std::this_thread::yield();
+  source.store(nullptr);
+  alglib::HazardPointers::Retire(node, &ReleaseInt);
+  alglib::HazardPointers::Scan();
+  EXPECT_EQ(released, 0);
+  done = true;
+  reader.join();
+  alglib::HazardPointers::Scan();
+  EXPECT_EQ(released, 1);
+}
+
+TEST(HazardPointersTest, RetiredByExitedThread) {
+  released = 0;
+  int *node{new int(1)};
+  std::atomic<int *> source{node};
+  alglib::HazardPointers::Protect(0, source);
+  std::thread retirer([node] {
+    alglib::HazardPointers::Retire(node, &ReleaseInt);
+  });
+  retirer.join();
+  EXPECT_EQ(released, 0);
+  alglib::HazardPointers::Clear(0);
+  alglib::HazardPointers::Scan();
+  EXPECT_EQ(released, 1);
+}
+
+TEST(HazardPointersTest, ScanIsTriggeredByRetire) {
+  released = 0;
+  for (int i{}; i < 1000; ++i) {
+    alglib::HazardPointers::Retire(new int(i), &ReleaseInt);
+  }
+  EXPECT_GT(released, 0);
+  EXPECT_LT(alglib::HazardPointers::RetiredCount(), 1000);
+  alglib::HazardPointers::Scan();
+  EXPECT_EQ(released, 1000);
+}
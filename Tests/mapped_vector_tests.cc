@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include "mapped_vector.h"
+
+namespace {
+
+struct Record {
+  int32_t id;
+  double value;
+};
+
+// Fixture that gives every test its own file in the temporary directory and
+// removes it afterwards.
+class MappedVectorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    path = std::filesystem::temp_directory_path() /
+           ("alglib_mapped_" +
+            std::string(::testing::UnitTest::GetInstance()
+                            ->current_test_info()
+                            ->name()) +
+            ".bin");
+    std::filesystem::remove(path);
+  }
+  void TearDown() override { std::filesystem::remove(path); }
+
+  std::filesystem::path path;
+};
+
+}  // namespace
+
+TEST_F(MappedVectorTest, DefaultConstructorIsClosed) {
+  alglib::MappedVector<int> vec;
+  EXPECT_FALSE(vec.IsOpen());
+  EXPECT_EQ(vec.Size(), 0);
+  EXPECT_THROW(vec.Push(1), std::runtime_error);
+}
+
+TEST_F(MappedVectorTest, CreatesEmptyFile) {
+  alglib::MappedVector<int> vec(path);
+  EXPECT_TRUE(vec.IsOpen());
+  EXPECT_FALSE(vec.IsReadOnly());
+  EXPECT_EQ(vec.Size(), 0);
+  EXPECT_EQ(vec.Data(), nullptr);
+  EXPECT_TRUE(std::filesystem::exists(path));
+}
+
+TEST_F(MappedVectorTest, ElementsPersistAcrossReopen) {
+  {
+    alglib::MappedVector<Record> vec(path);
+    for (int32_t i{}; i < 1000; ++i) vec.Push({i, i * 0.5});
+    EXPECT_GE(vec.Capacity(), 1000);
+  }
+  EXPECT_EQ(std::filesystem::file_size(path), 1000 * sizeof(Record));
+
+  alglib::MappedVector<Record> vec(path, alglib::MapMode::kReadOnly);
+  EXPECT_TRUE(vec.IsReadOnly());
+  ASSERT_EQ(vec.Size(), 1000);
+  EXPECT_EQ(vec.Capacity(), 1000);
+  EXPECT_EQ(vec.At(999).id, 999);
+  EXPECT_DOUBLE_EQ(vec.Back().value, 499.5);
+}
+
+TEST_F(MappedVectorTest, ReadOnlyRejectsModification) {
+  {
+    alglib::MappedVector<int> vec(path);
+    vec.Push(1);
+  }
+  alglib::MappedVector<int> vec(path, alglib::MapMode::kReadOnly);
+  EXPECT_THROW(vec.Push(2), std::runtime_error);
+  EXPECT_THROW(vec.Pop(), std::runtime_error);
+  EXPECT_THROW(vec.Resize(5), std::runtime_error);
+  EXPECT_THROW(vec.Clear(), std::runtime_error);
+  EXPECT_NO_THROW(vec.Sync());
+  EXPECT_EQ(vec.At(0), 1);
+}
+
+TEST_F(MappedVectorTest, MissingFileInReadOnlyModeThrows) {
+  EXPECT_THROW(alglib::MappedVector<int>(path, alglib::MapMode::kReadOnly),
+               std::system_error);
+}
+
+TEST_F(MappedVectorTest, MisalignedFileThrows) {
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << "abc";
+  }
+  EXPECT_THROW(alglib::MappedVector<int32_t> vec(path), std::runtime_error);
+}
+
+TEST_F(MappedVectorTest, IteratorsAndAlgorithms) {
+  alglib::MappedVector<int> vec(path);
+  for (int value : {5, 3, 8, 1}) vec.Push(value);
+  std::sort(vec.begin(), vec.end());
+  EXPECT_TRUE(std::is_sorted(vec.ConstBegin(), vec.ConstEnd()));
+  EXPECT_EQ(*vec.ReverseBegin(), 8);
+  EXPECT_EQ(vec.AsSpan().size(), 4);
+}
+
+TEST_F(MappedVectorTest, ReserveResizeAndClear) {
+  alglib::MappedVector<int> vec(path);
+  vec.Reserve(100);
+  EXPECT_EQ(vec.Capacity(), 100);
+  EXPECT_EQ(std::filesystem::file_size(path), 100 * sizeof(int));
+
+  vec.Resize(10, 7);
+  EXPECT_EQ(vec.Size(), 10);
+  EXPECT_EQ(vec.At(9), 7);
+  vec.Resize(3);
+  EXPECT_EQ(vec.Size(), 3);
+  EXPECT_EQ(vec.Pop(), 7);
+  EXPECT_THROW(vec.At(2), std::runtime_error);
+
+  vec.Sync();
+  vec.Advise(alglib::AccessAdvice::kSequential);
+  vec.Clear();
+  EXPECT_EQ(vec.Size(), 0);
+  EXPECT_EQ(vec.Capacity(), 100);
+  vec.Close();
+  EXPECT_EQ(std::filesystem::file_size(path), 0);
+}
+
+TEST_F(MappedVectorTest, ReopenAppendsToExistingElements) {
+  {
+    alglib::MappedVector<int> vec(path);
+    vec.Push(1);
+    vec.Push(2);
+  }
+  {
+    alglib::MappedVector<int> vec(path);
+    EXPECT_EQ(vec.Size(), 2);
+    vec.Push(3);
+  }
+  alglib::MappedVector<int> vec(path, alglib::MapMode::kReadOnly);
+  EXPECT_EQ(vec.Size(), 3);
+  EXPECT_EQ(vec.Back(), 3);
+}
+
+TEST_F(MappedVectorTest, MoveTransfersFile) {
+  alglib::MappedVector<int> vec(path);
+  vec.Push(42);
+  alglib::MappedVector<int> moved(std::move(vec));
+  EXPECT_FALSE(vec.IsOpen());
+  EXPECT_EQ(moved.At(0), 42);
+
+  alglib::MappedVector<int> assigned;
+  assigned = std::move(moved);
+  EXPECT_EQ(assigned.Front(), 42);
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "node_pool.h"
+#include "singly_linked_list.h"
+#include "sll_queue.h"
+#include "sll_stack.h"
+
+TEST(NodePoolTest, ReusesFreedBlocks) {
+  alglib::NodePool pool;
+  void *first{pool.Allocate(24, alignof(void *))};
+  pool.Deallocate(first, 24, alignof(void *));
+  void *second{pool.Allocate(24, alignof(void *))};
+  EXPECT_EQ(first, second);
+  pool.Deallocate(second, 24, alignof(void *));
+}
+
+TEST(NodePoolTest, ConsecutiveBlocksAreAdjacent) {
+  alglib::NodePool pool;
+  auto *first{static_cast<char *>(pool.Allocate(16, 8))};
+  auto *second{static_cast<char *>(pool.Allocate(16, 8))};
+  EXPECT_EQ(second - first,
+            static_cast<std::ptrdiff_t>(alglib::NodePool::kGranularity));
+  pool.Deallocate(first, 16, 8);
+  pool.Deallocate(second, 16, 8);
+}
+
+TEST(NodePoolTest, ChurnDoesNotGrowPool) {
+  alglib::NodePool pool;
+  std::vector<void *> blocks;
+  for (int i{}; i < 1000; ++i) blocks.push_back(pool.Allocate(32, 8));
+  const size_t slabs{pool.SlabCount()};
+  EXPECT_GT(slabs, 0u);
+  for (int round{}; round < 10; ++round) {
+    for (void *block : blocks) pool.Deallocate(block, 32, 8);
+    for (void *&block : blocks) block = pool.Allocate(32, 8);
+  }
+  EXPECT_EQ(pool.SlabCount(), slabs);
+  for (void *block : blocks) pool.Deallocate(block, 32, 8);
+}
+
+TEST(NodePoolTest, LargeAndOverAlignedRequests) {
+  alglib::NodePool pool;
+  void *large{pool.Allocate(alglib::NodePool::kMaxBlockBytes + 1, 8)};
+  void *aligned{pool.Allocate(64, 64)};
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(aligned) % 64, 0u);
+  EXPECT_EQ(pool.SlabCount(), 0u);
+  pool.Deallocate(large, alglib::NodePool::kMaxBlockBytes + 1, 8);
+  pool.Deallocate(aligned, 64, 64);
+}
+
+TEST(NodePoolTest, ReboundAllocatorsCompareEqual) {
+  alglib::NodePool pool;
+  alglib::PoolAllocator<int> ints(pool);
+  alglib::PoolAllocator<double> doubles(ints);
+  EXPECT_TRUE(ints == alglib::PoolAllocator<int>(doubles));
+  EXPECT_EQ(doubles.Pool(), &pool);
+  EXPECT_FALSE(ints == alglib::PoolAllocator<int>());
+  EXPECT_EQ(alglib::PoolAllocator<int>().Pool(), &alglib::NodePool::Shared());
+}
+
+TEST(NodePoolTest, ContainersUsePrivatePool) {
+  alglib::NodePool pool;
+  {
+    alglib::SLLQueue<int> queue{alglib::PoolAllocator<int>(pool)};
+    alglib::SLLStack<int> stack{alglib::PoolAllocator<int>(pool)};
+    for (int i{}; i < 100; ++i) {
+      queue.Enqueue(i);
+      stack.Push(i);
+    }
+    EXPECT_EQ(pool.SlabCount(), 1u);
+    for (int i{}; i < 100; ++i) {
+      EXPECT_EQ(queue.Dequeue(), i);
+      EXPECT_EQ(stack.Pop(), 99 - i);
+    }
+  }
+  EXPECT_EQ(pool.SlabCount(), 1u);
+}
+
+TEST(NodePoolTest, SharedPoolAcrossThreads) {
+  std::vector<std::thread> threads;
+  for (int t{}; t < 4; ++t) {
+    threads.emplace_back([] {
+      alglib::SinglyLinkedList<int> list;
+      for (int round{}; round < 20; ++round) {
+        for (int i{}; i < 100; ++i) list.InsertAtBeginning(i);
+        for (int i{}; i < 100; ++i) list.DeleteAtBeggining();
+      }
+    });
+  }
+  for (std::thread &thread : threads) thread.join();
+  alglib::SLLQueue<int> queue;
+  queue.Enqueue(1);
+  std::thread consumer([&queue] { EXPECT_EQ(queue.Dequeue(), 1); });
+  consumer.join();
+  EXPECT_TRUE(queue.IsEmpty());
+}
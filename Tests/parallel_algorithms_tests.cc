@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "parallel_algorithms.h"
+#include "small_vector.h"
+#include "vector.h"
+
+namespace {
+
+// Small grain size makes tests use many chunks without huge inputs.
+constexpr size_t kGrain{64};
+
+alglib::Vector<int> RandomVector(size_t size) {
+  std::mt19937 generator(12345);
+  std::uniform_int_distribution<int> distribution(-1000, 1000);
+  alglib::Vector<int> v;
+  for (size_t i{}; i < size; ++i) v.Push(distribution(generator));
+  return v;
+}
+
+}  // namespace
+
+TEST(ParallelAlgorithmsTest, SortMatchesStdSort) {
+  for (size_t size : {0, 1, 63, 64, 1000, 12345}) {
+    alglib::Vector<int> v{RandomVector(size)};
+    std::vector<int> expected(v.begin(), v.end());
+    std::sort(expected.begin(), expected.end());
+
+    alglib::ParallelSort(v, std::less<>(), kGrain);
+    EXPECT_TRUE(std::equal(v.begin(), v.end(), expected.begin(),
+                           expected.end()));
+  }
+}
+
+TEST(ParallelAlgorithmsTest, SortWithComparatorAndIterators) {
+  alglib::Vector<int> v{RandomVector(5000)};
+  alglib::ParallelSort(v.begin(), v.end(), std::greater<>(), kGrain);
+  EXPECT_TRUE(std::is_sorted(v.begin(), v.end(), std::greater<>()));
+}
+
+TEST(ParallelAlgorithmsTest, SortNonTrivialType) {
+  alglib::Vector<std::string> v;
+  for (int i{3000}; i > 0; --i) v.Push(std::to_string(i));
+  alglib::ParallelSort(v, std::less<>(), kGrain);
+  EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
+  EXPECT_EQ(v.Size(), 3000);
+}
+
+TEST(ParallelAlgorithmsTest, SortSmallVector) {
+  alglib::SmallVector<int, 8> v;
+  for (int i{1000}; i > 0; --i) v.Push(i);
+  alglib::ParallelSort(v, std::less<>(), kGrain);
+  EXPECT_EQ(v.At(0), 1);
+  EXPECT_EQ(v.At(999), 1000);
+}
+
+TEST(ParallelAlgorithmsTest, TransformIntoOtherRange) {
+  alglib::Vector<int> v{RandomVector(10000)};
+  std::vector<long> out(v.Size());
+  auto end = alglib::ParallelTransform(
+      v, out.begin(), [](int x) { return 2L * x; }, kGrain);
+  EXPECT_EQ(end, out.end());
+  for (size_t i{}; i < v.Size(); ++i) {
+    EXPECT_EQ(out[i], 2L * v.At(i));
+  }
+}
+
+TEST(ParallelAlgorithmsTest, TransformInPlace) {
+  alglib::Vector<int> v;
+  for (int i{}; i < 5000; ++i) v.Push(i);
+  alglib::ParallelTransform(
+      v.begin(), v.end(), v.begin(), [](int x) { return x + 1; }, kGrain);
+  for (int i{}; i < 5000; ++i) {
+    EXPECT_EQ(v.At(i), i + 1);
+  }
+}
+
+TEST(ParallelAlgorithmsTest, ReduceMatchesAccumulate) {
+  alglib::Vector<int> v{RandomVector(20000)};
+  long expected{std::accumulate(v.begin(), v.end(), 7L)};
+  EXPECT_EQ(alglib::ParallelReduce(v, 7L, std::plus<>(), kGrain), expected);
+  EXPECT_EQ(alglib::ParallelReduce(v.begin(), v.begin(), 7L), 7L);
+}
+
+TEST(ParallelAlgorithmsTest, ReduceKeepsOrderOfNonCommutativeOperation) {
+  alglib::Vector<std::string> v;
+  std::string expected;
+  for (int i{}; i < 2000; ++i) {
+    v.Push(std::string(1, static_cast<char>('a' + i % 26)));
+    expected += v.Back();
+  }
+  EXPECT_EQ(alglib::ParallelReduce(v, std::string(), std::plus<>(), kGrain),
+            expected);
+}
+
+TEST(ParallelAlgorithmsTest, InclusiveScanMatchesStd) {
+  for (size_t size : {1, 64, 129, 10000}) {
+    alglib::Vector<int> v{RandomVector(size)};
+    std::vector<int> expected(size);
+    std::inclusive_scan(v.begin(), v.end(), expected.begin());
+
+    std::vector<int> out(size);
+    alglib::ParallelInclusiveScan(v, out.begin(), std::plus<>(), kGrain);
+    EXPECT_EQ(out, expected);
+
+    alglib::ParallelInclusiveScan(v.begin(), v.end(), v.begin(),
+                                  std::plus<>(), kGrain);
+    EXPECT_TRUE(std::equal(v.begin(), v.end(), expected.begin()));
+  }
+}
+
+TEST(ParallelAlgorithmsTest, FindReturnsFirstOccurrence) {
+  alglib::Vector<int> v;
+  for (int i{}; i < 10000; ++i) v.Push(i % 1000);
+  auto found = alglib::ParallelFind(v, 999, kGrain);
+  EXPECT_EQ(found - v.begin(), 999);
+  EXPECT_EQ(alglib::ParallelFind(v, -1, kGrain), v.end());
+  EXPECT_EQ(alglib::ParallelFind(v.begin(), v.end(), 0, kGrain), v.begin());
+}
+
+TEST(ParallelAlgorithmsTest, FindIfWithPredicate) {
+  alglib::Vector<int> v;
+  for (int i{}; i < 10000; ++i) v.Push(i);
+  auto found = alglib::ParallelFindIf(
+      v, [](int x) { return x > 7777; }, kGrain);
+  EXPECT_EQ(*found, 7778);
+}
+
+TEST(ParallelAlgorithmsTest, NestedInsideSchedulerTasks) {
+  constexpr size_t kOuter{16};
+  std::vector<long long> sums(kOuter);
+  alglib::TaskScheduler::Default().ParallelFor(0, kOuter, [&](size_t i) {
+    alglib::Vector<int> v{RandomVector(4096)};
+    alglib::ParallelSort(v, std::less<>(), kGrain);
+    EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
+    sums[i] = alglib::ParallelReduce(v, 0LL, std::plus<>(), kGrain);
+  });
+  alglib::Vector<int> v{RandomVector(4096)};
+  long long expected{std::accumulate(v.begin(), v.end(), 0LL)};
+  for (long long sum : sums) EXPECT_EQ(sum, expected);
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "priority_queue.h"
+
+namespace {
+
+// Pops all values of a queue in order.
+template <typename Queue>
+std::vector<int> Drain(Queue &queue) {
+  std::vector<int> values;
+  while (!queue.IsEmpty()) values.push_back(queue.Pop());
+  return values;
+}
+
+}  // namespace
+
+TEST(PriorityQueueTest, PushAndPopInOrder) {
+  alglib::PriorityQueue<int> queue;
+  EXPECT_TRUE(queue.IsEmpty());
+  for (int value : {5, 1, 8, 3, 9, 2, 7}) queue.Push(value);
+  EXPECT_EQ(queue.Size(), 7);
+  EXPECT_EQ(queue.Top(), 9);
+  EXPECT_EQ(Drain(queue), (std::vector<int>{9, 8, 7, 5, 3, 2, 1}));
+  EXPECT_THROW(queue.Pop(), std::runtime_error);
+  EXPECT_THROW(queue.Top(), std::runtime_error);
+}
+
+TEST(PriorityQueueTest, MinQueueAndTryPop) {
+  alglib::PriorityQueue<int, std::greater<int>> queue;
+  int value{-1};
+  EXPECT_FALSE(queue.TryPop(value));
+  EXPECT_EQ(value, -1);
+  for (int i{10}; i > 0; --i) queue.Emplace(i);
+  EXPECT_TRUE(queue.TryPop(value));
+  EXPECT_EQ(value, 1);
+  EXPECT_EQ(queue.Top(), 2);
+}
+
+TEST(PriorityQueueTest, BuildHeapMatchesSort) {
+  std::mt19937 random(42);
+  std::vector<int> values(1000);
+  for (int &value : values) value = static_cast<int>(random() % 100);
+  alglib::PriorityQueue<int> queue(values.begin(), values.end());
+  std::sort(values.begin(), values.end(), std::greater<int>());
+  EXPECT_EQ(Drain(queue), values);
+
+  queue.Push(1);
+  const int replacement[]{4, 2, 6};
+  queue.BuildHeap(std::begin(replacement), std::end(replacement));
+  EXPECT_EQ(Drain(queue), (std::vector<int>{6, 4, 2}));
+}
+
+TEST(PriorityQueueTest, ArityVariants) {
+  std::mt19937 random(7);
+  std::vector<int> values(500);
+  for (int &value : values) value = static_cast<int>(random());
+  alglib::PriorityQueue<int, std::less<int>, 2> binary;
+  alglib::PriorityQueue<int, std::less<int>, 8> octal;
+  for (int value : values) {
+    binary.Push(value);
+    octal.Push(value);
+  }
+  std::sort(values.begin(), values.end(), std::greater<int>());
+  EXPECT_EQ(Drain(binary), values);
+  EXPECT_EQ(Drain(octal), values);
+}
+
+TEST(PriorityQueueTest, MoveOnlyValues) {
+  auto compare{[](const std::unique_ptr<int> &left,
+                  const std::unique_ptr<int> &right) {
+    return *left < *right;
+  }};
+  alglib::PriorityQueue<std::unique_ptr<int>, decltype(compare)> queue(
+      compare);
+  for (int i{}; i < 20; ++i) queue.Push(std::make_unique<int>(i * 7 % 20));
+  for (int expected{19}; expected >= 0; --expected) {
+    EXPECT_EQ(*queue.Pop(), expected);
+  }
+}
+
+TEST(IndexedPriorityQueueTest, PushPopAndHandles) {
+  alglib::IndexedPriorityQueue<std::string> queue;
+  auto b{queue.Push("b")};
+  auto d{queue.Push("d")};
+  auto a{queue.Push("a")};
+  EXPECT_EQ(queue.Size(), 3);
+  EXPECT_EQ(queue.Top(), "d");
+  EXPECT_EQ(queue.TopHandle(), d);
+  EXPECT_EQ(queue.Get(a), "a");
+  EXPECT_EQ(queue.Get(b), "b");
+  EXPECT_EQ(queue.Pop(), "d");
+  EXPECT_FALSE(queue.Contains(d));
+  EXPECT_THROW(queue.Get(d), std::runtime_error);
+  EXPECT_TRUE(queue.Contains(a));
+
+  // Handle of the popped value is given out again.
+  auto c{queue.Push("c")};
+  EXPECT_EQ(c, d);
+  EXPECT_EQ(queue.Pop(), "c");
+  EXPECT_EQ(queue.Pop(), "b");
+  EXPECT_EQ(queue.Pop(), "a");
+  EXPECT_THROW(queue.Pop(), std::runtime_error);
+  EXPECT_THROW(queue.TopHandle(), std::runtime_error);
+}
+
+TEST(IndexedPriorityQueueTest, DecreaseKeyForTimers) {
+  // Min-queue of deadlines, like a timer scheduler.
+  alglib::IndexedPriorityQueue<int, std::greater<int>> timers;
+  auto first{timers.Push(100)};
+  auto second{timers.Push(200)};
+  auto third{timers.Push(300)};
+  timers.DecreaseKey(third, 50);
+  EXPECT_EQ(timers.TopHandle(), third);
+  timers.Update(third, 250);
+  EXPECT_EQ(timers.TopHandle(), first);
+  timers.Update(first, 400);
+  EXPECT_EQ(timers.TopHandle(), second);
+  EXPECT_EQ(Drain(timers), (std::vector<int>{200, 250, 400}));
+  EXPECT_THROW(timers.DecreaseKey(first, 1), std::runtime_error);
+}
+
+TEST(IndexedPriorityQueueTest, EraseByHandle) {
+  alglib::IndexedPriorityQueue<int> queue;
+  std::vector<alglib::IndexedPriorityQueue<int>::Handle> handles;
+  for (int i{}; i < 10; ++i) handles.push_back(queue.Push(i));
+  EXPECT_EQ(queue.Erase(handles[9]), 9);
+  EXPECT_EQ(queue.Erase(handles[0]), 0);
+  EXPECT_EQ(queue.Erase(handles[4]), 4);
+  EXPECT_THROW(queue.Erase(handles[4]), std::runtime_error);
+  EXPECT_EQ(queue.Size(), 7);
+  for (int i : {1, 2, 3, 5, 6, 7, 8}) EXPECT_EQ(queue.Get(handles[i]), i);
+  EXPECT_EQ(Drain(queue), (std::vector<int>{8, 7, 6, 5, 3, 2, 1}));
+  queue.Push(1);
+  queue.Clear();
+  EXPECT_TRUE(queue.IsEmpty());
+  EXPECT_FALSE(queue.Contains(0));
+}
+
+TEST(IndexedPriorityQueueTest, RandomOperationsMatchReference) {
+  std::mt19937 random(1234);
+  alglib::IndexedPriorityQueue<int, std::less<int>, 3> queue;
+  std::vector<std::pair<alglib::IndexedPriorityQueue<int>::Handle, int>> live;
+  for (int step{}; step < 5000; ++step) {
+    const unsigned action{static_cast<unsigned>(random() % 4)};
+    if (action < 2 || live.empty()) {
+      const int value{static_cast<int>(random() % 1000)};
+      live.emplace_back(queue.Push(value), value);
+    } else {
+      const size_t index{random() % live.size()};
+      if (action == 2) {
+        EXPECT_EQ(queue.Erase(live[index].first), live[index].second);
+        live.erase(live.begin() + static_cast<std::ptrdiff_t>(index));
+      } else {
+        const int value{static_cast<int>(random() % 1000)};
+        queue.Update(live[index].first, value);
+        live[index].second = value;
+      }
+    }
+    ASSERT_EQ(queue.Size(), live.size());
+    if (!live.empty()) {
+      int greatest{live.front().second};
+      for (const auto &[handle, value] : live) {
+        greatest = std::max(greatest, value);
+      }
+      ASSERT_EQ(queue.Top(), greatest);
+    }
+  }
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include "array_stack.h"
+#include "btree.h"
+#include "circular_queue.h"
+#include "doubly_linked_list.h"
+#include "flat_hash_map.h"
+#include "priority_queue.h"
+#include "ranges.h"
+#include "singly_linked_list.h"
+#include "sll_queue.h"
+#include "small_vector.h"
+#include "vector.h"
+
+static_assert(std::ranges::forward_range<alglib::SinglyLinkedList<int>>);
+static_assert(std::ranges::sized_range<alglib::SinglyLinkedList<int>>);
+static_assert(
+    std::ranges::bidirectional_range<alglib::DoublyLinkedList<int>>);
+static_assert(std::ranges::contiguous_range<alglib::Vector<int>>);
+static_assert(std::ranges::contiguous_range<alglib::SmallVector<int, 4>>);
+static_assert(std::ranges::bidirectional_range<alglib::BTreeSet<int>>);
+static_assert(std::ranges::forward_range<alglib::FlatHashSet<int>>);
+static_assert(std::ranges::input_range<
+              alglib::DrainView<alglib::SLLQueue<int>>>);
+static_assert(std::ranges::view<
+              alglib::FilterView<std::views::all_t<alglib::Vector<int> &>,
+                                 bool (*)(int)>>);
+
+namespace {
+
+alglib::SinglyLinkedList<int> MakeList(int count) {
+  alglib::SinglyLinkedList<int> list;
+  for (int i = 1; i <= count; ++i) list.InsertAtEnd(i);
+  return list;
+}
+
+}  // namespace
+
+TEST(RangesTest, FilterTransformTakeOverList) {
+  alglib::SinglyLinkedList<int> list{MakeList(20)};
+  auto view = list | alglib::Filter([](int value) { return value % 3 == 0; }) |
+              alglib::Transform([](int value) { return value * value; }) |
+              alglib::Take(4);
+  static_assert(std::ranges::forward_range<decltype(view)>);
+  EXPECT_TRUE(std::ranges::equal(view, std::vector<int>{9, 36, 81, 144}));
+  EXPECT_EQ(std::ranges::distance(view), 4);
+}
+
+TEST(RangesTest, ViewsReferToContainer) {
+  alglib::DoublyLinkedList<std::string> list;
+  list.InsertAtEnd("a");
+  list.InsertAtEnd("bb");
+  list.InsertAtEnd("ccc");
+  auto longer = list | alglib::Filter([](const std::string &value) {
+                  return value.size() > 1;
+                });
+  for (std::string &value : longer) value += "!";
+  EXPECT_EQ(list.GetAsVector(),
+            (std::vector<std::string>{"a", "bb!", "ccc!"}));
+  auto last{longer.end()};
+  EXPECT_EQ(*--last, "ccc!");
+  EXPECT_EQ(*--last, "bb!");
+  EXPECT_EQ(last, longer.begin());
+}
+
+TEST(RangesTest, MovedFilterOfOwnedRange) {
+  alglib::SmallVector<int, 8> numbers;
+  for (int i = 0; i < 8; ++i) numbers.Push(i);
+  auto odd = std::move(numbers) |
+             alglib::Filter([](int value) { return value % 2 != 0; });
+  EXPECT_EQ(*odd.begin(), 1);
+  auto moved{std::move(odd)};
+  EXPECT_TRUE(std::ranges::equal(moved, std::vector<int>{1, 3, 5, 7}));
+  odd = std::move(moved);
+  EXPECT_TRUE(std::ranges::equal(odd, std::vector<int>{1, 3, 5, 7}));
+}
+
+TEST(RangesTest, TransformKeepsSize) {
+  alglib::Vector<int> vector;
+  for (int i = 0; i < 5; ++i) vector.Push(i);
+  auto halves = vector | alglib::Transform([](int value) {
+                  return value / 2.0;
+                });
+  EXPECT_EQ(halves.size(), 5);
+  EXPECT_EQ((vector | alglib::Take(3)).size(), 3);
+  EXPECT_EQ((vector | alglib::Take(30)).size(), 5);
+}
+
+TEST(RangesTest, DrainTakesElementsInOrder) {
+  alglib::SLLQueue<int> queue;
+  for (int i = 0; i < 5; ++i) queue.Enqueue(i);
+  std::vector<int> drained;
+  for (int value : alglib::Drain(queue)) drained.push_back(value);
+  EXPECT_EQ(drained, (std::vector<int>{0, 1, 2, 3, 4}));
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(RangesTest, TakeFromDrainLeavesRest) {
+  alglib::CircularQueue<int, 8> queue;
+  for (int i = 0; i < 6; ++i) queue.Enqueue(i);
+  std::vector<int> taken;
+  alglib::CopyTo(alglib::Drain(queue) | alglib::Take(2),
+                 std::back_inserter(taken));
+  EXPECT_EQ(taken, (std::vector<int>{0, 1}));
+  EXPECT_EQ(queue.PeekFront(), 2);
+  EXPECT_EQ(queue.PeekRear(), 5);
+}
+
+TEST(RangesTest, DrainStackAndPriorityQueue) {
+  alglib::ArrayStack<int, 4> stack;
+  for (int i = 0; i < 4; ++i) stack.Push(i);
+  std::vector<int> popped;
+  alglib::CopyTo(alglib::Drain(stack), std::back_inserter(popped));
+  EXPECT_EQ(popped, (std::vector<int>{3, 2, 1, 0}));
+
+  alglib::PriorityQueue<int> heap;
+  for (int value : {5, 1, 4, 2, 3}) heap.Push(value);
+  alglib::Vector<int> sorted;
+  alglib::AppendTo(alglib::Drain(heap) |
+                       alglib::Filter([](int value) { return value != 3; }),
+                   sorted);
+  EXPECT_TRUE(std::ranges::equal(sorted, std::vector<int>{5, 4, 2, 1}));
+}
+
+TEST(RangesTest, AppendToReservesSizedRanges) {
+  alglib::DoublyLinkedList<int> list;
+  for (int i = 0; i < 100; ++i) list.InsertAtEnd(i);
+  static_assert(std::ranges::sized_range<alglib::DoublyLinkedList<int>>);
+  auto doubled = list | alglib::Transform([](int value) { return value * 2; });
+  alglib::Vector<int> vector;
+  vector.Push(-1);
+  alglib::AppendTo(std::views::all(list), vector);
+  EXPECT_EQ(vector.Size(), 101);
+  alglib::Vector<int> exact;
+  alglib::AppendTo(doubled, exact);
+  EXPECT_EQ(exact.Capacity(), 100);
+  EXPECT_EQ(exact.At(99), 198);
+}
+
+TEST(RangesTest, CopyToPresizedBuffer) {
+  alglib::SinglyLinkedList<int> list{MakeList(10)};
+  std::vector<int> buffer(3);
+  auto end = alglib::CopyTo(list | alglib::Take(3), buffer.begin());
+  EXPECT_EQ(end, buffer.end());
+  EXPECT_EQ(buffer, (std::vector<int>{1, 2, 3}));
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "simd_algorithms.h"
+#include "small_vector.h"
+#include "vector.h"
+
+namespace {
+
+template <typename T>
+alglib::Vector<T> RandomVector(size_t size) {
+  std::mt19937 generator(4321);
+  std::uniform_int_distribution<int> distribution(-100, 100);
+  alglib::Vector<T> v;
+  for (size_t i{}; i < size; ++i) {
+    v.Push(static_cast<T>(distribution(generator)));
+  }
+  return v;
+}
+
+}  // namespace
+
+TEST(SimdAlgorithmsTest, FindMatchesStdFindForAllTails) {
+  for (size_t size{}; size < 70; ++size) {
+    alglib::Vector<int32_t> v{RandomVector<int32_t>(size)};
+    for (int32_t value : {-100, 0, 7, 100, 1000}) {
+      size_t expected(std::find(v.begin(), v.end(), value) - v.begin());
+      EXPECT_EQ(alglib::SimdFind(v, value), expected);
+    }
+  }
+}
+
+TEST(SimdAlgorithmsTest, FindFloatingPoint) {
+  alglib::Vector<float> floats{RandomVector<float>(1000)};
+  floats.Push(0.5f);
+  EXPECT_EQ(alglib::SimdFind(floats, 0.5f), 1000);
+  EXPECT_EQ(alglib::SimdFind(floats, 0.25f), floats.Size());
+
+  alglib::Vector<double> doubles{RandomVector<double>(1001)};
+  doubles.At(777) = 0.5;
+  EXPECT_EQ(alglib::SimdFind(doubles, 0.5), 777);
+}
+
+TEST(SimdAlgorithmsTest, CountMatchesStdCount) {
+  for (size_t size : {0, 1, 15, 16, 17, 1000, 4099}) {
+    alglib::Vector<int32_t> ints{RandomVector<int32_t>(size)};
+    alglib::Vector<double> doubles{RandomVector<double>(size)};
+    EXPECT_EQ(alglib::SimdCount(ints, 3),
+              static_cast<size_t>(std::count(ints.begin(), ints.end(), 3)));
+    EXPECT_EQ(
+        alglib::SimdCount(doubles, 3.0),
+        static_cast<size_t>(std::count(doubles.begin(), doubles.end(), 3.0)));
+  }
+}
+
+TEST(SimdAlgorithmsTest, SumWidensIntegers) {
+  alglib::Vector<int32_t> v;
+  for (int i{}; i < 1000; ++i) v.Push(INT32_MAX);
+  v.Push(-5);
+  EXPECT_EQ(alglib::SimdSum(v), 1000LL * INT32_MAX - 5);
+
+  alglib::Vector<int32_t> random{RandomVector<int32_t>(3333)};
+  EXPECT_EQ(alglib::SimdSum(random),
+            std::accumulate(random.begin(), random.end(), int64_t{}));
+}
+
+TEST(SimdAlgorithmsTest, SumFloatingPoint) {
+  alglib::Vector<double> doubles{RandomVector<double>(5000)};
+  EXPECT_DOUBLE_EQ(alglib::SimdSum(doubles),
+                   std::accumulate(doubles.begin(), doubles.end(), 0.0));
+
+  alglib::Vector<float> floats;
+  for (int i{}; i < 1001; ++i) floats.Push(0.5f);
+  EXPECT_FLOAT_EQ(alglib::SimdSum(floats), 500.5f);
+  EXPECT_EQ(alglib::SimdSum(alglib::Vector<float>()), 0.0f);
+}
+
+TEST(SimdAlgorithmsTest, MinMaxMatchesStd) {
+  for (size_t size : {1, 2, 15, 16, 33, 1000}) {
+    alglib::Vector<int32_t> ints{RandomVector<int32_t>(size)};
+    auto [int_min, int_max] = std::minmax_element(ints.begin(), ints.end());
+    EXPECT_EQ(alglib::SimdMinMax(ints), std::make_pair(*int_min, *int_max));
+
+    alglib::Vector<float> floats{RandomVector<float>(size)};
+    auto [min, max] = std::minmax_element(floats.begin(), floats.end());
+    EXPECT_EQ(alglib::SimdMinMax(floats), std::make_pair(*min, *max));
+  }
+}
+
+TEST(SimdAlgorithmsTest, MinMaxEmptyThrows) {
+  alglib::Vector<double> v;
+  EXPECT_THROW(alglib::SimdMinMax(v), std::runtime_error);
+}
+
+TEST(SimdAlgorithmsTest, ContainsSorted) {
+  alglib::Vector<int32_t> v;
+  for (int32_t i{}; i < 10000; i += 3) v.Push(i);
+  for (int32_t value{-5}; value < 10005; ++value) {
+    EXPECT_EQ(alglib::SimdContainsSorted(v, value),
+              std::binary_search(v.begin(), v.end(), value));
+  }
+  EXPECT_FALSE(alglib::SimdContainsSorted(alglib::Vector<int32_t>(), 0));
+}
+
+TEST(SimdAlgorithmsTest, ScalarFallbackForOtherTypes) {
+  alglib::Vector<int64_t> wide{RandomVector<int64_t>(100)};
+  wide.Push(1LL << 40);
+  EXPECT_EQ(alglib::SimdFind(wide, 1LL << 40), 100);
+  EXPECT_EQ(alglib::SimdMinMax(wide).second, 1LL << 40);
+
+  alglib::Vector<uint8_t> bytes;
+  for (int i{}; i < 300; ++i) bytes.Push(static_cast<uint8_t>(i));
+  EXPECT_EQ(alglib::SimdSum(bytes), 300ULL * 299 / 2 - 44ULL * 256);
+}
+
+TEST(SimdAlgorithmsTest, WorksWithOtherContiguousRanges) {
+  std::vector<int32_t> values{5, 1, 4, 1, 5, 9, 2, 6};
+  EXPECT_EQ(alglib::SimdFind(std::span<const int32_t>(values), 9), 5);
+  EXPECT_EQ(alglib::SimdCount(values, 1), 2);
+
+  alglib::SmallVector<double, 4> small;
+  small.Push(2.0);
+  small.Push(-3.0);
+  EXPECT_EQ(alglib::SimdMinMax(small), std::make_pair(-3.0, 2.0));
+}
@@ -1,7 +1,37 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <memory_resource>
+#include <ranges>
+#include <vector>
+
 #include "singly_linked_list.h"  
 
+namespace {
+
+// Memory resource that counts allocations and releases, used to check that
+// the container takes all of its memory from the given resource.
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  size_t allocations{};
+  size_t deallocations{};
+
+ private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+    ++deallocations;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+}  // namespace
+
 TEST(SinglyLinkedListTest, ConstructorAndIsEmpty) {
   alglib::SinglyLinkedList<int> list;
   EXPECT_EQ(list.Size(), 0);
@@ -137,4 +167,151 @@ TEST(SinglyLinkedListTest, Destructor) {
 
   delete list;
   EXPECT_TRUE(true);
-}
\ No newline at end of file
+}
+
+TEST(SinglyLinkedListTest, MemoryResource) {
+  CountingResource resource;
+  {
+    alglib::pmr::SinglyLinkedList<int> list(&resource);
+    list.InsertAtEnd(10);
+    list.InsertAtBeginning(5);
+    list.InsertAtPosition(1, 7);
+    EXPECT_EQ(list.GetAsVector(), std::vector<int>({5, 7, 10}));
+    EXPECT_EQ(resource.allocations, 3);
+    list.DeleteAtEnd();
+    EXPECT_EQ(resource.deallocations, 1);
+  }
+  EXPECT_EQ(resource.deallocations, resource.allocations);
+}
+
+TEST(SinglyLinkedListTest, MonotonicArena) {
+  std::byte buffer[1024];
+  std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                            std::pmr::null_memory_resource());
+  alglib::pmr::SinglyLinkedList<int> list(&arena);
+  for (int i{}; i < 10; ++i) list.InsertAtEnd(i);
+  EXPECT_EQ(list.Size(), 10);
+}
+TEST(SinglyLinkedListTest, SizeAndTail) {
+  alglib::SinglyLinkedList<int> list;
+  for (int i{}; i < 5; ++i) list.InsertAtEnd(i);
+  EXPECT_EQ(list.Size(), 5);
+  list.DeleteAtEnd();
+  list.InsertAtEnd(10);
+  list.DeleteAtPosition(4);
+  list.InsertAtEnd(20);
+  list.InsertAtPosition(5, 30);
+  list.DeleteAtBeggining();
+  EXPECT_EQ(list.Size(), 5);
+  EXPECT_EQ(list.GetAsVector(), std::vector<int>({1, 2, 3, 20, 30}));
+  while (list.Size() > 0) list.DeleteAtEnd();
+  list.InsertAtEnd(40);
+  EXPECT_EQ(list.GetAsVector(), std::vector<int>({40}));
+}
+
+TEST(SinglyLinkedListTest, Splice) {
+  alglib::SinglyLinkedList<int> list;
+  alglib::SinglyLinkedList<int> other;
+  other.InsertAtEnd(1);
+  other.InsertAtEnd(2);
+  list.Splice(other);
+  EXPECT_EQ(list.Size(), 2);
+  EXPECT_EQ(other.Size(), 0);
+
+  other.InsertAtEnd(3);
+  list.Splice(other);
+  list.InsertAtEnd(4);
+  other.InsertAtEnd(5);
+  EXPECT_EQ(list.GetAsVector(), std::vector<int>({1, 2, 3, 4}));
+  EXPECT_EQ(other.GetAsVector(), std::vector<int>({5}));
+}
+
+TEST(SinglyLinkedListTest, SpliceAfter) {
+  alglib::SinglyLinkedList<int> list;
+  alglib::SinglyLinkedList<int> other;
+  list.InsertAtEnd(1);
+  list.InsertAtEnd(4);
+  other.InsertAtEnd(2);
+  other.InsertAtEnd(3);
+  list.SpliceAfter(0, other);
+  EXPECT_TRUE(other.GetAsVector().empty());
+
+  other.InsertAtEnd(5);
+  list.SpliceAfter(3, other);
+  list.InsertAtEnd(6);
+  EXPECT_EQ(list.GetAsVector(), std::vector<int>({1, 2, 3, 4, 5, 6}));
+  EXPECT_EQ(list.Size(), 6);
+  EXPECT_THROW(list.SpliceAfter(6, other), std::runtime_error);
+}
+
+TEST(SinglyLinkedListTest, SpliceWithDifferentResources) {
+  std::pmr::unsynchronized_pool_resource first_resource;
+  std::pmr::unsynchronized_pool_resource second_resource;
+  alglib::pmr::SinglyLinkedList<int> list(&first_resource);
+  alglib::pmr::SinglyLinkedList<int> other(&second_resource);
+  other.InsertAtEnd(1);
+  EXPECT_THROW(list.Splice(other), std::runtime_error);
+  EXPECT_EQ(other.Size(), 1);
+}
+
+TEST(SinglyLinkedListTest, Sort) {
+  alglib::SinglyLinkedList<int> list;
+  list.Sort();
+  std::vector<int> expected;
+  for (int i{}; i < 1000; ++i) {
+    int value{(i * 7919) % 1000};
+    list.InsertAtEnd(value);
+    expected.push_back(value);
+  }
+  list.Sort();
+  std::sort(expected.begin(), expected.end());
+  EXPECT_EQ(list.GetAsVector(), expected);
+
+  list.Sort(std::greater<>());
+  std::reverse(expected.begin(), expected.end());
+  EXPECT_EQ(list.GetAsVector(), expected);
+  list.InsertAtEnd(-1);
+  EXPECT_EQ(list.Size(), 1001);
+  EXPECT_EQ(list.GetAsVector().back(), -1);
+}
+
+TEST(SinglyLinkedListTest, SortIsStable) {
+  alglib::SinglyLinkedList<std::pair<int, int>> list;
+  for (int i{}; i < 20; ++i) list.InsertAtEnd({i % 3, i});
+  list.Sort([](const auto &lhs, const auto &rhs) {
+    return lhs.first < rhs.first;
+  });
+  std::vector<std::pair<int, int>> values{list.GetAsVector()};
+  EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+}
+
+TEST(SinglyLinkedListTest, Merge) {
+  alglib::SinglyLinkedList<int> list;
+  alglib::SinglyLinkedList<int> other;
+  for (int value : {1, 3, 5, 7}) list.InsertAtEnd(value);
+  for (int value : {2, 3, 8, 9}) other.InsertAtEnd(value);
+  list.Merge(other);
+  EXPECT_EQ(list.GetAsVector(), std::vector<int>({1, 2, 3, 3, 5, 7, 8, 9}));
+  EXPECT_EQ(list.Size(), 8);
+  EXPECT_EQ(other.Size(), 0);
+  list.InsertAtEnd(10);
+  EXPECT_EQ(list.GetAsVector().back(), 10);
+
+  alglib::SinglyLinkedList<int> empty;
+  empty.Merge(list);
+  EXPECT_EQ(empty.Size(), 9);
+}
+
+TEST(SinglyLinkedListTest, Iterators) {
+  static_assert(std::ranges::forward_range<alglib::SinglyLinkedList<int>>);
+  alglib::SinglyLinkedList<int> list;
+  EXPECT_EQ(list.begin(), list.end());
+  for (int i = 1; i <= 4; ++i) list.InsertAtEnd(i);
+  for (int &value : list) value *= 10;
+  const auto &view = list;
+  EXPECT_TRUE(std::ranges::equal(view, std::vector<int>{10, 20, 30, 40}));
+  alglib::SinglyLinkedList<int>::ConstIterator it{list.begin()};
+  EXPECT_EQ(*it++, 10);
+  EXPECT_EQ(*it, 20);
+  EXPECT_EQ(std::ranges::distance(list), 4);
+}
@@ -1,7 +1,34 @@
 #include <gtest/gtest.h>
 
+#include <memory_resource>
+
 #include "sll_queue.h"
 
+namespace {
+
+// Memory resource that counts allocations and releases, used to check that
+// the container takes all of its memory from the given resource.
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  size_t allocations{};
+  size_t deallocations{};
+
+ private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+    ++deallocations;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+}  // namespace
+
 TEST(SLLQueueTest, ConstructorAndIsEmpty) {
   alglib::SLLQueue<int> queue;
   EXPECT_TRUE(queue.IsEmpty());
@@ -80,4 +107,48 @@ TEST(SLLQueueTest, Destructor) {
 
   delete queue; 
   EXPECT_TRUE(true);
-}
\ No newline at end of file
+}
+
+TEST(SLLQueueTest, MemoryResource) {
+  CountingResource resource;
+  {
+    alglib::pmr::SLLQueue<int> queue(&resource);
+    queue.Enqueue(10);
+    queue.Enqueue(20);
+    EXPECT_EQ(resource.allocations, 2);
+    EXPECT_EQ(queue.Dequeue(), 10);
+    EXPECT_EQ(resource.deallocations, 1);
+  }
+  EXPECT_EQ(resource.deallocations, resource.allocations);
+}
+
+TEST(SLLQueueTest, DequeueSingleElementEmptiesQueue) {
+  alglib::SLLQueue<int> queue;
+  queue.Enqueue(10);
+  EXPECT_EQ(queue.Dequeue(), 10);
+  EXPECT_TRUE(queue.IsEmpty());
+  queue.Enqueue(20);
+  EXPECT_EQ(queue.PeekFront(), 20);
+  EXPECT_EQ(queue.PeekRear(), 20);
+}
+TEST(SLLQueueTest, TryDequeueAndTryPeek) {
+  alglib::SLLQueue<int> queue;
+  int value{-1};
+  EXPECT_FALSE(queue.TryDequeue(value));
+  EXPECT_FALSE(queue.TryPeekFront(value));
+  EXPECT_FALSE(queue.TryPeekRear(value));
+  EXPECT_EQ(value, -1);
+
+  queue.Enqueue(10);
+  queue.Enqueue(20);
+  EXPECT_TRUE(queue.TryPeekFront(value));
+  EXPECT_EQ(value, 10);
+  EXPECT_TRUE(queue.TryPeekRear(value));
+  EXPECT_EQ(value, 20);
+  EXPECT_TRUE(queue.TryDequeue(value));
+  EXPECT_EQ(value, 10);
+  EXPECT_TRUE(queue.TryDequeue(value));
+  EXPECT_EQ(value, 20);
+  EXPECT_TRUE(queue.IsEmpty());
+  EXPECT_FALSE(queue.TryPeekRear(value));
+}
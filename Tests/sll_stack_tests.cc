@@ -1,7 +1,34 @@
 #include <gtest/gtest.h>
 
+#include <memory_resource>
+
 #include "sll_stack.h"
 
+namespace {
+
+// Memory resource that counts allocations and releases, used to check that
+// the container takes all of its memory from the given resource.
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  size_t allocations{};
+  size_t deallocations{};
+
+ private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+    ++deallocations;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+}  // namespace
+
 TEST(SLLStackTest, ConstructorAndIsEmpty) {
   alglib::SLLStack<int> stack;
   EXPECT_TRUE(stack.IsEmpty());
@@ -81,4 +108,34 @@ TEST(SLLStackTest, Destructor) {
 
   delete stack;       
   EXPECT_TRUE(true); 
-}
\ No newline at end of file
+}
+
+TEST(SLLStackTest, MemoryResource) {
+  CountingResource resource;
+  {
+    alglib::pmr::SLLStack<int> stack(&resource);
+    stack.Push(10);
+    stack.Push(20);
+    EXPECT_EQ(resource.allocations, 2);
+    EXPECT_EQ(stack.Pop(), 20);
+    EXPECT_EQ(resource.deallocations, 1);
+  }
+  EXPECT_EQ(resource.deallocations, resource.allocations);
+}
+TEST(SLLStackTest, TryPopAndTryTop) {
+  alglib::SLLStack<int> stack;
+  int value{-1};
+  EXPECT_FALSE(stack.TryPop(value));
+  EXPECT_FALSE(stack.TryTop(value));
+  EXPECT_EQ(value, -1);
+
+  stack.Push(10);
+  stack.Push(20);
+  EXPECT_TRUE(stack.TryTop(value));
+  EXPECT_EQ(value, 20);
+  EXPECT_TRUE(stack.TryPop(value));
+  EXPECT_EQ(value, 20);
+  EXPECT_TRUE(stack.TryPop(value));
+  EXPECT_EQ(value, 10);
+  EXPECT_TRUE(stack.IsEmpty());
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "small_vector.h"
+
+namespace {
+
+// Memory resource that counts allocations, used to check when the small
+// vector spills to the heap.
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  size_t allocations{};
+  size_t deallocations{};
+
+ private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+    ++deallocations;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+}  // namespace
+
+TEST(SmallVectorTest, DefaultConstructorIsInline) {
+  alglib::SmallVector<int, 8> vec;
+  EXPECT_EQ(vec.Size(), 0);
+  EXPECT_EQ(vec.Capacity(), 8);
+  EXPECT_TRUE(vec.IsInline());
+}
+
+TEST(SmallVectorTest, NoAllocationWhileInline) {
+  CountingResource resource;
+  alglib::pmr::SmallVector<int, 4> vec(&resource);
+  for (int i{}; i < 4; ++i) vec.Push(i);
+  EXPECT_EQ(resource.allocations, 0);
+  EXPECT_TRUE(vec.IsInline());
+  vec.Push(4);
+  EXPECT_EQ(resource.allocations, 1);
+  EXPECT_FALSE(vec.IsInline());
+  for (int i{}; i < 5; ++i) EXPECT_EQ(vec.At(i), i);
+}
+
+TEST(SmallVectorTest, ValueConstructor) {
+  alglib::SmallVector<std::string, 2> vec(3, "abc");
+  EXPECT_EQ(vec.Size(), 3);
+  EXPECT_FALSE(vec.IsInline());
+  EXPECT_EQ(vec.At(2), "abc");
+}
+
+TEST(SmallVectorTest, PushPopAndAccess) {
+  alglib::SmallVector<std::string, 2> vec;
+  vec.Push("a");
+  vec.Push(std::string("b"));
+  vec.Emplace(2, 'c');
+  EXPECT_EQ(vec.Front(), "a");
+  EXPECT_EQ(vec.Back(), "cc");
+  EXPECT_EQ(vec.Pop(), "cc");
+  EXPECT_EQ(vec.Pop(), "b");
+  EXPECT_EQ(vec.Pop(), "a");
+  EXPECT_THROW(vec.Pop(), std::runtime_error);
+  EXPECT_THROW(vec.At(0), std::runtime_error);
+}
+
+TEST(SmallVectorTest, InsertShiftsElements) {
+  alglib::SmallVector<int, 3> vec;
+  vec.Push(1);
+  vec.Push(3);
+  vec.Insert(2, 1);
+  vec.Insert(0, 0);
+  EXPECT_EQ(vec.Size(), 4);
+  for (int i{}; i < 4; ++i) EXPECT_EQ(vec.At(i), i);
+  EXPECT_THROW(vec.Insert(9, 10), std::runtime_error);
+}
+
+TEST(SmallVectorTest, AppendRange) {
+  alglib::SmallVector<int, 4> vec;
+  std::vector<int> source{1, 2, 3, 4, 5, 6};
+  vec.Append(source.begin(), source.end());
+  EXPECT_EQ(vec.Size(), 6);
+  EXPECT_EQ(vec.At(5), 6);
+}
+
+TEST(SmallVectorTest, ShrinkToFitReturnsToInline) {
+  alglib::SmallVector<std::string, 2> vec;
+  vec.Push("a");
+  vec.Push("b");
+  vec.Push("c");
+  EXPECT_FALSE(vec.IsInline());
+  vec.Pop();
+  vec.ShrinkToFit();
+  EXPECT_TRUE(vec.IsInline());
+  EXPECT_EQ(vec.At(0), "a");
+  EXPECT_EQ(vec.At(1), "b");
+}
+
+TEST(SmallVectorTest, CopyAndMoveInline) {
+  alglib::SmallVector<std::string, 4> vec;
+  vec.Push("a");
+  vec.Push("b");
+  alglib::SmallVector<std::string, 4> copy(vec);
+  EXPECT_EQ(copy.At(1), "b");
+  alglib::SmallVector<std::string, 4> moved(std::move(vec));
+  EXPECT_EQ(moved.Size(), 2);
+  EXPECT_EQ(vec.Size(), 0);
+  EXPECT_TRUE(moved.IsInline());
+}
+
+TEST(SmallVectorTest, MoveHeapStealsBuffer) {
+  alglib::SmallVector<int, 2> vec;
+  for (int i{}; i < 10; ++i) vec.Push(i);
+  const int *buffer = &vec.At(0);
+  alglib::SmallVector<int, 2> moved;
+  moved.Push(42);
+  moved = std::move(vec);
+  EXPECT_EQ(&moved.At(0), buffer);
+  EXPECT_EQ(moved.Size(), 10);
+  EXPECT_TRUE(vec.IsInline());
+
+  alglib::SmallVector<int, 2> assigned;
+  assigned = moved;
+  EXPECT_EQ(assigned.At(9), 9);
+}
+
+TEST(SmallVectorTest, IteratorsMatchVector) {
+  alglib::SmallVector<int, 4> vec;
+  for (int i{}; i < 6; ++i) vec.Push(i);
+  int expected{};
+  for (auto i = vec.Begin(); i != vec.End(); ++i) EXPECT_EQ(*i, expected++);
+  EXPECT_EQ(expected, 6);
+  for (auto i = vec.ReverseBegin(); i != vec.ReverseEnd(); ++i) {
+    EXPECT_EQ(*i, --expected);
+  }
+}
+
+TEST(SmallVectorTest, ResizeReserveAndClear) {
+  alglib::SmallVector<int, 4> vec;
+  vec.Resize(3, 7);
+  EXPECT_TRUE(vec.IsInline());
+  EXPECT_EQ(vec.At(2), 7);
+  vec.Resize(10);
+  EXPECT_FALSE(vec.IsInline());
+  EXPECT_EQ(vec.At(2), 7);
+  EXPECT_EQ(vec.At(9), 0);
+
+  vec.Clear();
+  EXPECT_EQ(vec.Size(), 0);
+  EXPECT_GE(vec.Capacity(), 10);
+  vec.Reserve(40);
+  EXPECT_EQ(vec.Capacity(), 40);
+}
+
+TEST(SmallVectorTest, FixedChunkGrowthPolicy) {
+  alglib::SmallVector<int, 2, std::allocator<int>, alglib::FixedChunkGrowth<8>>
+      vec;
+  for (int i{}; i < 3; ++i) vec.Push(i);
+  EXPECT_EQ(vec.Capacity(), 8);
+}
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "simd_algorithms.h"
+#include "soa_vector.h"
+
+namespace {
+
+// Field whose copy constructor throws once a countdown reaches zero, used to
+// check that a failed row leaves the vector unchanged.
+struct Fragile {
+  static inline int countdown{-1};
+  int value{};
+
+  Fragile(int value) : value(value) {}
+  Fragile(const Fragile &other) : value(other.value) {
+    if (countdown >= 0 && countdown-- == 0) {
+      throw std::runtime_error("copy failed");
+    }
+  }
+  Fragile &operator=(const Fragile &) = default;
+};
+
+}  // namespace
+
+TEST(SoAVectorTest, PushAndPop) {
+  alglib::SoAVector<int, double> vec;
+  EXPECT_TRUE(vec.IsEmpty());
+  vec.Push(1, 1.5);
+  vec.Push(2, 2.5);
+  EXPECT_EQ(vec.Size(), 2);
+  EXPECT_EQ(vec.Pop(), std::make_tuple(2, 2.5));
+  EXPECT_EQ(vec.Pop(), std::make_tuple(1, 1.5));
+  EXPECT_TRUE(vec.IsEmpty());
+  EXPECT_THROW(vec.Pop(), std::runtime_error);
+}
+
+TEST(SoAVectorTest, ColumnsAreAlignedAndContiguous) {
+  alglib::SoAVector<char, int, double> vec;
+  for (int i = 0; i < 100; ++i) vec.Push(static_cast<char>(i), i, i * 0.5);
+  auto chars = vec.Column<0>();
+  auto ints = vec.Column<1>();
+  auto doubles = vec.Column<2>();
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(chars.data()) %
+                alglib::kColumnAlignment, 0);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(ints.data()) %
+                alglib::kColumnAlignment, 0);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(doubles.data()) %
+                alglib::kColumnAlignment, 0);
+  ASSERT_EQ(ints.size(), 100);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(chars[i], static_cast<char>(i));
+    EXPECT_EQ(ints[i], i);
+    EXPECT_EQ(doubles[i], i * 0.5);
+  }
+}
+
+TEST(SoAVectorTest, GrowthFollowsPolicy) {
+  alglib::SoAVector<int, int> vec;
+  vec.Push(0, 0);
+  EXPECT_EQ(vec.Capacity(), alglib::kInitialGrowthCapacity);
+  for (int i = 1; i < 5; ++i) vec.Push(i, -i);
+  EXPECT_EQ(vec.Capacity(), 2 * alglib::kInitialGrowthCapacity);
+  vec.Reserve(100);
+  EXPECT_EQ(vec.Capacity(), 100);
+  vec.ShrinkToFit();
+  EXPECT_EQ(vec.Capacity(), 5);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(vec[i].Get<0>(), i);
+    EXPECT_EQ(vec[i].Get<1>(), -i);
+  }
+}
+
+TEST(SoAVectorTest, RowProxyWritesThroughToColumns) {
+  alglib::SoAVector<int, std::string> vec;
+  vec.Push(1, "one");
+  vec.Push(2, "two");
+  vec[1].Get<0>() = 20;
+  vec.At(0).Get<1>() += "!";
+  EXPECT_EQ(vec.Column<0>()[1], 20);
+  EXPECT_EQ(vec.Column<1>()[0], "one!");
+  EXPECT_EQ(vec.At(1).ToTuple(), std::make_tuple(20, std::string("two")));
+  EXPECT_THROW(vec.At(2), std::runtime_error);
+}
+
+TEST(SoAVectorTest, StructuredBindingsAndIteration) {
+  alglib::SoAVector<int, double> vec;
+  for (int i = 0; i < 10; ++i) vec.Push(i, 0.0);
+  for (auto [id, weight] : vec) weight = id * 2.0;
+  double total{};
+  const auto &view = vec;
+  for (auto [id, weight] : view) total += weight;
+  EXPECT_EQ(total, 90.0);
+}
+
+TEST(SoAVectorTest, EmplaceMayReferToOwnRows) {
+  alglib::SoAVector<std::string, int> vec;
+  vec.Push("first", 1);
+  while (vec.Size() < vec.Capacity()) vec.Push("filler", 0);
+  auto row = vec.Emplace(vec[0].Get<0>(), vec[0].Get<1>() + 1);
+  EXPECT_EQ(row.Get<0>(), "first");
+  EXPECT_EQ(row.Get<1>(), 2);
+  EXPECT_EQ(vec[0].Get<0>(), "first");
+}
+
+TEST(SoAVectorTest, CopyAndMove) {
+  alglib::SoAVector<int, std::string> vec;
+  for (int i = 0; i < 20; ++i) vec.Push(i, std::to_string(i));
+  alglib::SoAVector<int, std::string> copy(vec);
+  copy[0].Get<1>() = "changed";
+  EXPECT_EQ(vec[0].Get<1>(), "0");
+  alglib::SoAVector<int, std::string> moved(std::move(copy));
+  EXPECT_EQ(copy.Size(), 0);
+  EXPECT_EQ(moved.Size(), 20);
+  EXPECT_EQ(moved[19].ToTuple(), std::make_tuple(19, std::string("19")));
+  vec = moved;
+  EXPECT_EQ(vec[0].Get<1>(), "changed");
+  moved = std::move(vec);
+  EXPECT_EQ(moved[0].Get<1>(), "changed");
+}
+
+TEST(SoAVectorTest, ColumnFeedsSimdKernels) {
+  alglib::SoAVector<std::string, int> vec;
+  for (int i = 1; i <= 1000; ++i) vec.Push("row", i);
+  EXPECT_EQ(alglib::SimdSum(vec.Column<1>()), 500500);
+  EXPECT_EQ(alglib::SimdCount(vec.Column<1>(), 500), 1);
+}
+
+TEST(SoAVectorTest, ThrowingFieldLeavesVectorUnchanged) {
+  alglib::SoAVector<std::string, Fragile> vec;
+  vec.Reserve(4);
+  vec.Push("a", Fragile(1));
+  const Fragile value(2);
+  Fragile::countdown = 0;
+  EXPECT_THROW(vec.Push("b", value), std::runtime_error);
+  Fragile::countdown = -1;
+  EXPECT_EQ(vec.Size(), 1);
+  vec.Push("c", value);
+  EXPECT_EQ(vec[1].Get<0>(), "c");
+  EXPECT_EQ(vec[1].Get<1>().value, 2);
+}
+
+TEST(SoAVectorTest, ThrowingRelocationLeavesVectorUnchanged) {
+  alglib::SoAVector<std::string, Fragile> vec;
+  vec.Reserve(1);
+  const std::string text(100, 'x');
+  vec.Push(text, Fragile(1));
+  const Fragile value(2);
+  // The copy into the new row succeeds and the copy of row 0 during the
+  // relocation throws.
+  Fragile::countdown = 1;
+  EXPECT_THROW(vec.Push("b", value), std::runtime_error);
+  Fragile::countdown = -1;
+  EXPECT_EQ(vec.Size(), 1);
+  EXPECT_EQ(vec.Capacity(), 1);
+  EXPECT_EQ(vec[0].Get<0>(), text);
+  EXPECT_EQ(vec[0].Get<1>().value, 1);
+}
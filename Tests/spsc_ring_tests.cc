@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "spsc_ring.h"
+
+TEST(SpscRingTest, ConstructorAndCapacity) {
+  alglib::SpscRing<int, 8> ring;
+  EXPECT_TRUE(ring.IsEmpty());
+  EXPECT_FALSE(ring.IsFull());
+  EXPECT_EQ(ring.Size(), 0);
+  EXPECT_EQ(ring.Capacity(), 8);
+}
+
+TEST(SpscRingTest, PushAndPop) {
+  alglib::SpscRing<int, 4> ring;
+  EXPECT_TRUE(ring.TryPush(1));
+  EXPECT_TRUE(ring.TryPush(2));
+  EXPECT_EQ(ring.Size(), 2);
+  int value{};
+  EXPECT_TRUE(ring.TryPop(value));
+  EXPECT_EQ(value, 1);
+  EXPECT_TRUE(ring.TryPop(value));
+  EXPECT_EQ(value, 2);
+  EXPECT_FALSE(ring.TryPop(value));
+  EXPECT_EQ(value, 2);
+}
+
+TEST(SpscRingTest, PushToFull) {
+  alglib::SpscRing<int, 4> ring;
+  for (int i{}; i < 4; ++i) EXPECT_TRUE(ring.TryPush(i));
+  EXPECT_TRUE(ring.IsFull());
+  EXPECT_FALSE(ring.TryPush(4));
+  int value{};
+  ring.TryPop(value);
+  EXPECT_TRUE(ring.TryPush(4));
+  EXPECT_FALSE(ring.TryPush(5));
+}
+
+TEST(SpscRingTest, WrapsAround) {
+  alglib::SpscRing<int, 4> ring;
+  int value{};
+  for (int i{}; i < 100; ++i) {
+    ASSERT_TRUE(ring.TryPush(i));
+    ASSERT_TRUE(ring.TryPush(i + 1000));
+    ASSERT_TRUE(ring.TryPop(value));
+    EXPECT_EQ(value, i);
+    ASSERT_TRUE(ring.TryPop(value));
+    EXPECT_EQ(value, i + 1000);
+  }
+  EXPECT_TRUE(ring.IsEmpty());
+}
+
+TEST(SpscRingTest, FailedPushKeepsValue) {
+  alglib::SpscRing<std::unique_ptr<int>, 1> ring;
+  EXPECT_TRUE(ring.TryPush(std::make_unique<int>(1)));
+  auto value{std::make_unique<int>(2)};
+  EXPECT_FALSE(ring.TryPush(std::move(value)));
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(*value, 2);
+}
+
+TEST(SpscRingTest, PushNAndPopN) {
+  alglib::SpscRing<int, 8> ring;
+  std::vector<int> input{1, 2, 3, 4, 5, 6};
+  EXPECT_EQ(ring.PushN(input.begin(), input.size()), 6);
+  EXPECT_EQ(ring.PushN(input.begin(), input.size()), 2);
+  EXPECT_TRUE(ring.IsFull());
+  std::array<int, 5> output{};
+  EXPECT_EQ(ring.PopN(output.begin(), output.size()), 5);
+  EXPECT_EQ(output, (std::array<int, 5>{1, 2, 3, 4, 5}));
+  std::vector<int> rest;
+  EXPECT_EQ(ring.PopN(std::back_inserter(rest), 10), 3);
+  EXPECT_EQ(rest, (std::vector<int>{6, 1, 2}));
+  EXPECT_EQ(ring.PopN(output.begin(), output.size()), 0);
+}
+
+TEST(SpscRingTest, DestructorReleasesElements) {
+  auto shared{std::make_shared<int>(1)};
+  {
+    alglib::SpscRing<std::shared_ptr<int>, 4> ring;
+    for (int i{}; i < 3; ++i) ring.TryPush(shared);
+    std::shared_ptr<int> value;
+    ring.TryPop(value);
+    value.reset();
+    EXPECT_EQ(shared.use_count(), 3);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(SpscRingTest, ProducerAndConsumerThreads) {
+  constexpr int kCount{20000};
+  alglib::SpscRing<std::string, 64> ring;
+  std::thread producer([&] {
+    std::vector<std::string> batch;
+    for (int i{}; i < kCount;) {
+      if (i % 3 == 0) {
+        if (ring.TryPush(std::to_string(i))) {
+          ++i;
+        } else {
+          std::this_thread::yield();
+        }
+        continue;
+      }
+      batch.clear();
+      for (int j{i}; j < std::min(i + 5, kCount); ++j) {
+        batch.push_back(std::to_string(j));
+      }
+      i += static_cast<int>(ring.PushN(batch.begin(), batch.size()));
+    }
+  });
+  std::vector<std::string> batch(7);
+  int expected{};
+  while (expected < kCount) {
+    const size_t popped{ring.PopN(batch.begin(), batch.size())};
+    if (popped == 0) std::this_thread::yield();
+    for (size_t i{}; i < popped; ++i) {
+      EXPECT_EQ(batch[i], std::to_string(expected));
+      ++expected;
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(ring.IsEmpty());
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "task_scheduler.h"
+
+namespace {
+
+// Computes a Fibonacci number spawning a task for every call.
+long long Fibonacci(alglib::TaskScheduler &scheduler, int n) {
+  if (n < 2) return n;
+  long long left{};
+  alglib::TaskGroup group(scheduler);
+  group.Spawn([&] { left = Fibonacci(scheduler, n - 1); });
+  const long long right{Fibonacci(scheduler, n - 2)};
+  group.Wait();
+  return left + right;
+}
+
+}  // namespace
+
+TEST(TaskSchedulerTest, ParallelForVisitsEveryIndexOnce) {
+  alglib::TaskScheduler scheduler(3);
+  EXPECT_EQ(scheduler.ThreadCount(), 3);
+  std::vector<std::atomic<int>> visits(10000);
+  scheduler.ParallelFor(0, visits.size(), [&](size_t i) { ++visits[i]; }, 7);
+  for (std::atomic<int> &count : visits) EXPECT_EQ(count.load(), 1);
+}
+
+TEST(TaskSchedulerTest, ParallelForEmptyAndOffsetRanges) {
+  alglib::TaskScheduler scheduler(2);
+  std::atomic<size_t> sum{};
+  scheduler.ParallelFor(5, 5, [&](size_t i) { sum += i; });
+  EXPECT_EQ(sum.load(), 0);
+  scheduler.ParallelFor(10, 20, [&](size_t i) { sum += i; });
+  EXPECT_EQ(sum.load(), 145);
+}
+
+TEST(TaskSchedulerTest, SchedulerWithoutWorkersRunsOnCaller) {
+  alglib::TaskScheduler scheduler(0);
+  std::atomic<int> count{};
+  scheduler.ParallelFor(0, 100, [&](size_t) { ++count; });
+  EXPECT_EQ(count.load(), 100);
+  EXPECT_EQ(Fibonacci(scheduler, 10), 55);
+}
+
+TEST(TaskSchedulerTest, NestedForkJoin) {
+  alglib::TaskScheduler scheduler(3);
+  EXPECT_EQ(Fibonacci(scheduler, 18), 2584);
+}
+
+TEST(TaskSchedulerTest, NestedParallelFor) {
+  alglib::TaskScheduler scheduler(2);
+  std::atomic<int> count{};
+  scheduler.ParallelFor(0, 20, [&](size_t) {
+    scheduler.ParallelFor(0, 50, [&](size_t) { ++count; });
+  });
+  EXPECT_EQ(count.load(), 1000);
+}
+
+TEST(TaskSchedulerTest, WaitRethrowsException) {
+  alglib::TaskScheduler scheduler(2);
+  alglib::TaskGroup group(scheduler);
+  std::atomic<int> finished{};
+  for (int i{}; i < 10; ++i) {
+    group.Spawn([&finished, i] {
+      if (i == 4) throw std::runtime_error("task failed");
+      ++finished;
+    });
+  }
+  EXPECT_THROW(group.Wait(), std::runtime_error);
+  EXPECT_EQ(finished.load(), 9);
+  group.Spawn([&finished] { ++finished; });
+  EXPECT_NO_THROW(group.Wait());
+  EXPECT_EQ(finished.load(), 10);
+}
+
+TEST(TaskSchedulerTest, ParallelForRethrowsException) {
+  alglib::TaskScheduler scheduler(2);
+  EXPECT_THROW(scheduler.ParallelFor(0, 1000,
+                                     [](size_t i) {
+                                       if (i == 777) {
+                                         throw std::runtime_error("failed");
+                                       }
+                                     }),
+               std::runtime_error);
+}
+
+TEST(TaskSchedulerTest, DefaultScheduler) {
+  std::atomic<int> count{};
+  alglib::TaskGroup group;
+  for (int i{}; i < 16; ++i) group.Spawn([&count] { ++count; });
+  group.Wait();
+  EXPECT_EQ(count.load(), 16);
+  EXPECT_EQ(&alglib::TaskScheduler::Default(),
+            &alglib::TaskScheduler::Default());
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "thread_pool.h"
+
+TEST(ThreadPoolTest, ForEachChunkVisitsEveryChunkOnce) {
+  alglib::ThreadPool pool(4);
+  std::vector<std::atomic<int>> visits(100);
+  pool.ForEachChunk(visits.size(), [&](size_t chunk) { ++visits[chunk]; });
+  for (const auto &count : visits) {
+    EXPECT_EQ(count.load(), 1);
+  }
+}
+
+TEST(ThreadPoolTest, PoolWithoutWorkersRunsOnCaller) {
+  alglib::ThreadPool pool(0);
+  EXPECT_EQ(pool.ThreadCount(), 0);
+  int sum{};
+  pool.ForEachChunk(10, [&](size_t chunk) { sum += static_cast<int>(chunk); });
+  EXPECT_EQ(sum, 45);
+}
+
+TEST(ThreadPoolTest, SubmittedTasksFinishBeforeDestruction) {
+  std::atomic<int> done{};
+  {
+    alglib::ThreadPool pool(2);
+    for (int i{}; i < 50; ++i) {
+      pool.Submit([&done] { ++done; });
+    }
+  }
+  EXPECT_EQ(done.load(), 50);
+}
+
+TEST(ThreadPoolTest, ForEachChunkRethrowsException) {
+  alglib::ThreadPool pool(3);
+  EXPECT_THROW(pool.ForEachChunk(64,
+                                 [](size_t chunk) {
+                                   if (chunk == 17) throw std::runtime_error("");
+                                 }),
+               std::runtime_error);
+}
+
+TEST(ThreadPoolTest, NestedForEachChunkRunsSerially) {
+  alglib::ThreadPool pool(2);
+  std::atomic<int> inner{};
+  pool.ForEachChunk(8, [&](size_t) {
+    pool.ForEachChunk(8, [&](size_t) { ++inner; });
+  });
+  EXPECT_EQ(inner.load(), 64);
+}
+
+TEST(ThreadPoolTest, InWorkerOnlyInsideWorkers) {
+  alglib::ThreadPool pool(1);
+  EXPECT_FALSE(alglib::ThreadPool::InWorker());
+  std::atomic<bool> submitted{false};
+  std::atomic<bool> finished{false};
+  pool.Submit([&] {
+    submitted = alglib::ThreadPool::InWorker();
+    finished = true;
+  });
+  while (!finished) {
+  }
+  EXPECT_TRUE(submitted.load());
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "doubly_linked_list.h"
+#include "singly_linked_list.h"
+#include "traversal.h"
+#include "unrolled_list.h"
+
+namespace {
+
+// Value that counts how many times it was copied.
+struct CopyCounter {
+  explicit CopyCounter(int value) : value(value) {}
+  CopyCounter(const CopyCounter &other) : value(other.value) { ++copies; }
+  CopyCounter(CopyCounter &&other) noexcept : value(other.value) {}
+  CopyCounter &operator=(const CopyCounter &other) {
+    value = other.value;
+    ++copies;
+    return *this;
+  }
+  CopyCounter &operator=(CopyCounter &&other) noexcept {
+    value = other.value;
+    return *this;
+  }
+  bool operator==(const CopyCounter &other) const {
+    return value == other.value;
+  }
+
+  int value;
+  static inline int copies{};
+};
+
+template <typename List>
+class TraversalTest : public testing::Test {};
+
+using Lists = testing::Types<alglib::SinglyLinkedList<CopyCounter>,
+                             alglib::DoublyLinkedList<CopyCounter>,
+                             alglib::UnrolledList<CopyCounter, 64>>;
+TYPED_TEST_SUITE(TraversalTest, Lists);
+
+}  // namespace
+
+TYPED_TEST(TraversalTest, TraverseByReference) {
+  TypeParam list;
+  for (int i{}; i < 10; ++i) list.InsertAtEnd(CopyCounter(i));
+  CopyCounter::copies = 0;
+  EXPECT_TRUE(list.Traverse([](CopyCounter &value) { value.value *= 2; }));
+  int sum{};
+  const TypeParam &view{list};
+  view.Traverse([&sum](const CopyCounter &value) { sum += value.value; });
+  EXPECT_EQ(sum, 90);
+  EXPECT_EQ(CopyCounter::copies, 0);
+}
+
+TYPED_TEST(TraversalTest, TraverseStopsEarly) {
+  TypeParam list;
+  for (int i{}; i < 10; ++i) list.InsertAtEnd(CopyCounter(i));
+  int visited{};
+  EXPECT_FALSE(list.Traverse([&visited](const CopyCounter &value) {
+    ++visited;
+    return value.value < 4;
+  }));
+  EXPECT_EQ(visited, 5);
+}
+
+TYPED_TEST(TraversalTest, Combinators) {
+  TypeParam list;
+  for (int i{}; i < 100; ++i) list.InsertAtEnd(CopyCounter(i));
+  CopyCounter::copies = 0;
+
+  auto counter{alglib::ForEach(list, [calls = 0](CopyCounter &value) mutable {
+    value.value += 1;
+    ++calls;
+    return calls;
+  })};
+  CopyCounter extra(0);
+  EXPECT_EQ(counter(extra), 101);
+  EXPECT_EQ(alglib::Accumulate(list, 0,
+                               [](int sum, const CopyCounter &value) {
+                                 return sum + value.value;
+                               }),
+            5050);
+  auto above_ninety{[](const CopyCounter &value) { return value.value > 90; }};
+  EXPECT_EQ(alglib::CountIf(list, above_ninety), 10);
+  EXPECT_EQ(CopyCounter::copies, 0);
+}
+
+TYPED_TEST(TraversalTest, RemoveIf) {
+  TypeParam list;
+  for (int i{}; i < 100; ++i) list.InsertAtEnd(CopyCounter(i));
+  CopyCounter::copies = 0;
+  EXPECT_EQ(list.RemoveIf([](const CopyCounter &value) {
+    return value.value % 3 != 0;
+  }),
+            66);
+  EXPECT_EQ(CopyCounter::copies, 0);
+  EXPECT_EQ(list.Size(), 34);
+  int expected{};
+  EXPECT_TRUE(list.Traverse([&expected](const CopyCounter &value) {
+    const bool matches{value.value == expected};
+    expected += 3;
+    return matches;
+  }));
+  list.InsertAtEnd(CopyCounter(100));
+  EXPECT_EQ(list.RemoveIf([](const CopyCounter &) { return true; }), 35);
+  EXPECT_EQ(list.Size(), 0);
+  list.InsertAtEnd(CopyCounter(1));
+  EXPECT_EQ(list.Size(), 1);
+}
+
+TEST(TraversalTest, AccumulateStrings) {
+  alglib::DoublyLinkedList<std::string> list;
+  list.InsertAtEnd("a");
+  list.InsertAtEnd("b");
+  list.InsertAtEnd("c");
+  EXPECT_EQ(alglib::Accumulate(list, std::string()), "abc");
+}
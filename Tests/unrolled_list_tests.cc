@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <memory_resource>
+#include <numeric>
+#include <string>
+
+#include "unrolled_list.h"
+
+TEST(UnrolledListTest, ConstructorAndIsEmpty) {
+  alglib::UnrolledList<int> list;
+  EXPECT_TRUE(list.IsEmpty());
+  EXPECT_EQ(list.Size(), 0);
+  EXPECT_EQ(list.ChunkCount(), 0);
+  EXPECT_EQ(list.begin(), list.end());
+}
+
+TEST(UnrolledListTest, ChunkCapacity) {
+  EXPECT_EQ(alglib::UnrolledList<int>::kChunkCapacity, 26);
+  EXPECT_EQ((alglib::UnrolledList<double, 64>::kChunkCapacity), 5);
+  EXPECT_EQ((alglib::UnrolledList<std::string, 16>::kChunkCapacity), 2);
+}
+
+TEST(UnrolledListTest, InsertAtEndFillsChunks) {
+  alglib::UnrolledList<int, 64> list;
+  const size_t capacity{alglib::UnrolledList<int, 64>::kChunkCapacity};
+  for (int i{}; i < 100; ++i) list.InsertAtEnd(i);
+  EXPECT_EQ(list.Size(), 100);
+  EXPECT_EQ(list.ChunkCount(), (100 + capacity - 1) / capacity);
+  std::vector<int> expected(100);
+  std::iota(expected.begin(), expected.end(), 0);
+  EXPECT_EQ(list.GetAsVector(), expected);
+}
+
+TEST(UnrolledListTest, InsertAtBeginning) {
+  alglib::UnrolledList<int, 64> list;
+  for (int i{}; i < 30; ++i) list.InsertAtBeginning(i);
+  std::vector<int> expected(30);
+  std::iota(expected.rbegin(), expected.rend(), 0);
+  EXPECT_EQ(list.GetAsVector(), expected);
+}
+
+TEST(UnrolledListTest, InsertAtPosition) {
+  alglib::UnrolledList<int> list;
+  list.InsertAtPosition(0, 10);
+  list.InsertAtPosition(1, 30);
+  list.InsertAtPosition(1, 20);
+  EXPECT_EQ(list.GetAsVector(), std::vector<int>({10, 20, 30}));
+  EXPECT_THROW(list.InsertAtPosition(4, 40), std::runtime_error);
+}
+
+TEST(UnrolledListTest, Delete) {
+  alglib::UnrolledList<int> list;
+  EXPECT_THROW(list.DeleteAtBeginning(), std::runtime_error);
+  EXPECT_THROW(list.DeleteAtEnd(), std::runtime_error);
+  EXPECT_THROW(list.DeleteAtPosition(0), std::runtime_error);
+  for (int i{}; i < 5; ++i) list.InsertAtEnd(i);
+  list.DeleteAtBeginning();
+  list.DeleteAtEnd();
+  list.DeleteAtPosition(1);
+  EXPECT_EQ(list.GetAsVector(), std::vector<int>({1, 3}));
+  EXPECT_THROW(list.DeleteAtPosition(2), std::runtime_error);
+  list.DeleteAtEnd();
+  list.DeleteAtEnd();
+  EXPECT_TRUE(list.IsEmpty());
+  EXPECT_EQ(list.ChunkCount(), 0);
+}
+
+TEST(UnrolledListTest, FindAndTraverse) {
+  alglib::UnrolledList<int, 64> list;
+  for (int i{}; i < 20; ++i) list.InsertAtEnd(i * 2);
+  EXPECT_EQ(*list.Find(24), 24);
+  EXPECT_EQ(std::distance(list.begin(), list.Find(24)), 12);
+  EXPECT_EQ(list.Find(25), list.end());
+  const alglib::UnrolledList<int, 64> &view{list};
+  EXPECT_EQ(view.Find(0), view.cbegin());
+
+  int sum{};
+  list.Traverse([&sum](int value) { sum += value; });
+  EXPECT_EQ(sum, 380);
+}
+
+TEST(UnrolledListTest, Iterators) {
+  alglib::UnrolledList<int, 64> list;
+  for (int i{}; i < 12; ++i) list.InsertAtEnd(i);
+  for (int &value : list) value *= 10;
+  std::vector<int> backward;
+  for (auto it{list.end()}; it != list.begin();) backward.push_back(*--it);
+  EXPECT_EQ(backward.front(), 110);
+  EXPECT_EQ(backward.back(), 0);
+  EXPECT_EQ(backward.size(), 12);
+  static_assert(std::bidirectional_iterator<
+                alglib::UnrolledList<int>::ConstIterator>);
+}
+
+TEST(UnrolledListTest, MatchesStdList) {
+  alglib::UnrolledList<std::string, 96> list;
+  std::list<std::string> expected;
+  for (int i{}; i < 500; ++i) {
+    const size_t pos{(static_cast<size_t>(i) * 37) % (expected.size() + 1)};
+    list.InsertAtPosition(static_cast<uint32_t>(pos), std::to_string(i));
+    expected.insert(std::next(expected.begin(), pos), std::to_string(i));
+  }
+  for (int i{}; i < 450; ++i) {
+    const size_t pos{(static_cast<size_t>(i) * 53) % expected.size()};
+    list.DeleteAtPosition(static_cast<uint32_t>(pos));
+    expected.erase(std::next(expected.begin(), pos));
+  }
+  EXPECT_EQ(list.Size(), expected.size());
+  EXPECT_TRUE(std::equal(list.begin(), list.end(), expected.begin(),
+                         expected.end()));
+  EXPECT_LE(list.ChunkCount(), expected.size());
+}
+
+TEST(UnrolledListTest, SparseChunksAreMerged) {
+  alglib::UnrolledList<int, 64> list;
+  const size_t capacity{alglib::UnrolledList<int, 64>::kChunkCapacity};
+  for (size_t i{}; i < capacity * 4; ++i) list.InsertAtEnd(1);
+  for (size_t i{}; i < capacity * 3; ++i) list.DeleteAtPosition(1);
+  EXPECT_EQ(list.Size(), capacity);
+  EXPECT_LE(list.ChunkCount(), 2);
+}
+
+TEST(UnrolledListTest, MemoryResource) {
+  std::pmr::monotonic_buffer_resource arena;
+  {
+    alglib::pmr::UnrolledList<int> list(&arena);
+    for (int i{}; i < 100; ++i) list.InsertAtEnd(i);
+    EXPECT_EQ(list.Size(), 100);
+  }
+}
+
+TEST(UnrolledListTest, RemoveIfWithThrowingPredicate) {
+  alglib::UnrolledList<int, 64> list;
+  for (int i{}; i < 40; ++i) list.InsertAtEnd(i);
+  EXPECT_THROW(list.RemoveIf([](int value) {
+    if (value == 7) throw std::runtime_error("");
+    return value % 2 == 0;
+  }),
+               std::runtime_error);
+  EXPECT_EQ(list.Size(), 36);
+  std::vector<int> values{list.GetAsVector()};
+  EXPECT_EQ(values.front(), 1);
+  EXPECT_EQ(values[3], 7);
+  EXPECT_EQ(values[4], 8);
+  EXPECT_EQ(values.back(), 39);
+  EXPECT_EQ(list.RemoveIf([](int value) { return value < 30; }), 26);
+  EXPECT_EQ(list.GetAsVector(),
+            std::vector<int>({30, 31, 32, 33, 34, 35, 36, 37, 38, 39}));
+  EXPECT_LE(list.ChunkCount(), 2);
+}
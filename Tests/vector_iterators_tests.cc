@@ -1,7 +1,21 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <string>
+#include <vector>
+
 #include "vector.h"
 
+static_assert(std::contiguous_iterator<alglib::VectorIter<int>>);
+static_assert(std::contiguous_iterator<alglib::ConstVectorIter<int>>);
+static_assert(std::random_access_iterator<alglib::ReverseVectorIter<int>>);
+static_assert(std::ranges::contiguous_range<alglib::Vector<int>>);
+static_assert(std::ranges::sized_range<alglib::Vector<int>>);
+
 TEST(VectorIteratorsTest, BeginTest) {
   alglib::Vector<int> v;
   v.Push(3);
@@ -119,3 +133,99 @@ TEST(VectorIteratorsTest, ForEachTest) {
     EXPECT_EQ(i, v.At(j++));
   }
 }
+
+TEST(VectorIteratorsTest, RangeForVisitsEveryElement) {
+  alglib::Vector<int> v;
+  for (int i{}; i < 5; ++i) v.Push(i);
+
+  int count{};
+  for (int value : v) {
+    EXPECT_EQ(value, count++);
+  }
+  EXPECT_EQ(count, 5);
+  EXPECT_EQ(v.End() - v.Begin(), 5);
+}
+
+TEST(VectorIteratorsTest, EmptyVectorIteration) {
+  alglib::Vector<int> v;
+  EXPECT_EQ(v.Begin(), v.End());
+  EXPECT_EQ(v.ReverseBegin(), v.ReverseEnd());
+}
+
+TEST(VectorIteratorsTest, RandomAccessArithmetic) {
+  alglib::Vector<int> v;
+  for (int i{}; i < 10; ++i) v.Push(i * 10);
+
+  auto it = v.Begin();
+  EXPECT_EQ(*(it + 3), 30);
+  EXPECT_EQ(*(3 + it), 30);
+  EXPECT_EQ(it[7], 70);
+  it += 5;
+  EXPECT_EQ(*it, 50);
+  it -= 2;
+  EXPECT_EQ(*it--, 30);
+  EXPECT_EQ(*it, 20);
+  EXPECT_TRUE(v.Begin() < it);
+  EXPECT_TRUE(v.End() > it);
+  EXPECT_EQ(v.End() - it, 8);
+}
+
+TEST(VectorIteratorsTest, ArrowOperator) {
+  alglib::Vector<std::string> v;
+  v.Push("abc");
+  EXPECT_EQ(v.Begin()->size(), 3);
+}
+
+TEST(VectorIteratorsTest, ConstIteratorFromMutable) {
+  alglib::Vector<int> v;
+  v.Push(1);
+  alglib::ConstVectorIter<int> citer = v.Begin();
+  EXPECT_EQ(citer, v.ConstBegin());
+  const auto &const_v = v;
+  EXPECT_EQ(*const_v.begin(), 1);
+}
+
+TEST(VectorIteratorsTest, StandardAlgorithms) {
+  alglib::Vector<int> v;
+  for (int value : {5, 3, 9, 1, 7}) v.Push(value);
+
+  std::sort(v.begin(), v.end());
+  EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
+  EXPECT_EQ(*std::lower_bound(v.begin(), v.end(), 6), 7);
+  EXPECT_EQ(std::accumulate(v.begin(), v.end(), 0), 25);
+
+  std::vector<int> copy(v.Size());
+  std::copy(v.begin(), v.end(), copy.begin());
+  EXPECT_EQ(copy, std::vector<int>({1, 3, 5, 7, 9}));
+
+  std::reverse(v.begin(), v.end());
+  EXPECT_EQ(v.At(0), 9);
+}
+
+TEST(VectorIteratorsTest, RangesAlgorithms) {
+  alglib::Vector<int> v;
+  for (int value : {4, 2, 8, 6}) v.Push(value);
+
+  std::ranges::sort(v);
+  EXPECT_EQ(v.At(0), 2);
+  EXPECT_EQ(*std::ranges::find(v, 6), 6);
+  EXPECT_EQ(std::ranges::distance(v), 4);
+  EXPECT_EQ(std::ranges::data(v), v.Data());
+}
+
+TEST(VectorIteratorsTest, SpanConversion) {
+  alglib::Vector<int> v;
+  for (int i{}; i < 4; ++i) v.Push(i);
+
+  std::span<int> view = v;
+  EXPECT_EQ(view.size(), 4);
+  EXPECT_EQ(view.data(), v.Data());
+  view[0] = 42;
+  EXPECT_EQ(v.At(0), 42);
+
+  const auto &const_v = v;
+  std::span<const int> const_view = const_v.AsSpan();
+  EXPECT_EQ(const_view[3], 3);
+  std::span<int> from_range(v.begin(), v.end());
+  EXPECT_EQ(from_range.size(), 4);
+}
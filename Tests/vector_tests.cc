@@ -1,10 +1,67 @@
 #include <gtest/gtest.h>
 
+#include <iterator>
+#include <memory_resource>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 #include "vector.h"
 
+namespace {
+
+// Type that counts how many of its instances are alive, used to check that
+// the vector only constructs elements that are actually stored in it.
+struct Counted {
+  static inline int alive{};
+  int value;
+  Counted(int v) : value(v) { ++alive; }
+  Counted(const Counted &other) : value(other.value) { ++alive; }
+  Counted(Counted &&other) noexcept : value(other.value) { ++alive; }
+  Counted &operator=(const Counted &) = default;
+  Counted &operator=(Counted &&) noexcept = default;
+  ~Counted() { --alive; }
+};
+
+// Memory resource that counts allocations and releases, used to check that
+// the container takes all of its memory from the given resource.
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  size_t allocations{};
+  size_t deallocations{};
+
+ private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+    ++deallocations;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+// Type whose copy constructor throws once a set number of copies has been
+// made, used to check that a failed construction releases its memory.
+struct ThrowingCopy {
+  static inline int copies_left{};
+  ThrowingCopy() = default;
+  ThrowingCopy(const ThrowingCopy &) {
+    if (copies_left-- == 0) throw std::runtime_error("copy failed");
+  }
+};
+
+}  // namespace
+
 TEST(VectorTest, DefaultConstructor) {
   alglib::Vector<int> vec;
   EXPECT_EQ(vec.Size(), 0);
+  EXPECT_EQ(vec.Capacity(), 0);
+  vec.Push(1);
   EXPECT_GE(vec.Capacity(), 4);
 }
 
@@ -16,8 +73,9 @@ TEST(VectorTest, ElementCountConstructor) {
 
 TEST(VectorTest, ValueConstructor) {
   alglib::Vector<int> vec(5, 42);
-  EXPECT_EQ(vec.Size(), 0);
+  EXPECT_EQ(vec.Size(), 5);
   EXPECT_EQ(vec.Capacity(), 5);
+  for (size_t i{}; i < vec.Size(); ++i) EXPECT_EQ(vec.At(i), 42);
 }
 
 TEST(VectorTest, BasicPushAndAccess) {
@@ -32,9 +90,10 @@ TEST(VectorTest, BasicPushAndAccess) {
 
 TEST(VectorTest, CapacityGrowth) {
   alglib::Vector<int> vec;
+  vec.Push(0);
   const size_t initial_cap = vec.Capacity();
 
-  for (int i{}; i < initial_cap; ++i) vec.Push(i);
+  for (size_t i{1}; i < initial_cap; ++i) vec.Push(static_cast<int>(i));
 
   EXPECT_EQ(vec.Capacity(), initial_cap);
   vec.Push(100);
@@ -90,7 +149,8 @@ TEST(VectorTest, ComplexTypeSupport) {
 TEST(VectorTest, ValueInitialization) {
   alglib::Vector<int> vec(3, 100);
   vec.Push(200); 
-  EXPECT_EQ(vec.At(0), 200);
+  EXPECT_EQ(vec.At(0), 100);
+  EXPECT_EQ(vec.At(3), 200);
 }
 
 TEST(VectorTest, InitializationSafety) {
@@ -155,4 +215,307 @@ TEST(VectorTest, InsertIntoEmptyVector) {
   vec.Insert(1, 0);
   EXPECT_EQ(vec.Size(), 1);
   EXPECT_EQ(vec.At(0), 1);
-}
\ No newline at end of file
+}
+
+TEST(VectorTest, ReservedStorageIsNotConstructed) {
+  Counted::alive = 0;
+  {
+    alglib::Vector<Counted> vec(100);
+    EXPECT_EQ(Counted::alive, 0);
+    vec.Push(Counted(1));
+    vec.Push(Counted(2));
+    EXPECT_EQ(Counted::alive, 2);
+  }
+  EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(VectorTest, ReallocationKeepsOnlyLiveElements) {
+  Counted::alive = 0;
+  {
+    alglib::Vector<Counted> vec;
+    for (int i{}; i < 100; ++i) vec.Push(Counted(i));
+    EXPECT_EQ(Counted::alive, 100);
+    for (int i{}; i < 100; ++i) EXPECT_EQ(vec.At(i).value, i);
+  }
+  EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(VectorTest, PopReturnsLastAndDestroysIt) {
+  Counted::alive = 0;
+  alglib::Vector<Counted> vec;
+  vec.Push(Counted(1));
+  vec.Push(Counted(2));
+  EXPECT_EQ(vec.Pop().value, 2);
+  EXPECT_EQ(vec.Size(), 1);
+  EXPECT_EQ(Counted::alive, 1);
+  EXPECT_EQ(vec.Pop().value, 1);
+  EXPECT_THROW(vec.Pop(), std::runtime_error);
+}
+
+TEST(VectorTest, PushOwnElementDuringReallocation) {
+  alglib::Vector<std::string> vec(1);
+  vec.Push("first element that is long enough to live on the heap");
+  vec.Push(vec.At(0));
+  EXPECT_EQ(vec.At(1), vec.At(0));
+}
+
+TEST(VectorTest, InsertComplexTypeShiftsElements) {
+  alglib::Vector<std::string> vec;
+  vec.Push("a");
+  vec.Push("c");
+  vec.Push("d");
+  vec.Insert("b", 1);
+  EXPECT_EQ(vec.At(0), "a");
+  EXPECT_EQ(vec.At(1), "b");
+  EXPECT_EQ(vec.At(2), "c");
+  EXPECT_EQ(vec.At(3), "d");
+}
+
+TEST(VectorTest, CopyIsDeep) {
+  alglib::Vector<std::string> vec;
+  vec.Push("one");
+  vec.Push("two");
+  alglib::Vector<std::string> copy(vec);
+  copy.At(0) = "changed";
+  EXPECT_EQ(vec.At(0), "one");
+  EXPECT_EQ(copy.Size(), 2);
+
+  alglib::Vector<std::string> assigned;
+  assigned = vec;
+  EXPECT_EQ(assigned.At(1), "two");
+}
+
+TEST(VectorTest, ShrinkToFitDestroysNothingLive) {
+  Counted::alive = 0;
+  alglib::Vector<Counted> vec(10);
+  vec.Push(Counted(1));
+  vec.Push(Counted(2));
+  vec.ShrinkToFit();
+  EXPECT_EQ(vec.Capacity(), 2);
+  EXPECT_EQ(Counted::alive, 2);
+  EXPECT_EQ(vec.At(1).value, 2);
+}
+
+TEST(VectorTest, PushMovesRvalue) {
+  alglib::Vector<std::string> vec;
+  std::string value(64, 'x');
+  vec.Push(std::move(value));
+  EXPECT_EQ(vec.At(0), std::string(64, 'x'));
+  EXPECT_TRUE(value.empty());
+}
+
+TEST(VectorTest, EmplaceConstructsInPlace) {
+  alglib::Vector<std::string> vec(1);
+  std::string &first = vec.Emplace(3, 'a');
+  EXPECT_EQ(first, "aaa");
+  vec.Emplace(vec.At(0));
+  EXPECT_EQ(vec.Size(), 2);
+  EXPECT_EQ(vec.At(1), "aaa");
+}
+
+TEST(VectorTest, EmplaceAtShiftsElements) {
+  alglib::Vector<std::string> vec;
+  vec.Push("a");
+  vec.Push("d");
+  vec.EmplaceAt(1, "b");
+  vec.EmplaceAt(2, 1, 'c');
+  vec.EmplaceAt(4, "e");
+  EXPECT_EQ(vec.Size(), 5);
+  EXPECT_EQ(vec.At(1), "b");
+  EXPECT_EQ(vec.At(2), "c");
+  EXPECT_EQ(vec.At(3), "d");
+  EXPECT_EQ(vec.At(4), "e");
+  EXPECT_THROW(vec.EmplaceAt(7, "x"), std::runtime_error);
+}
+
+TEST(VectorTest, MoveConstructorStealsBuffer) {
+  alglib::Vector<int> vec;
+  vec.Push(1);
+  vec.Push(2);
+  const int *buffer = &vec.At(0);
+  alglib::Vector<int> moved(std::move(vec));
+  EXPECT_EQ(&moved.At(0), buffer);
+  EXPECT_EQ(moved.Size(), 2);
+  EXPECT_EQ(vec.Size(), 0);
+  vec.Push(3);
+  EXPECT_EQ(vec.At(0), 3);
+}
+
+TEST(VectorTest, MoveAssignment) {
+  alglib::Vector<std::string> vec;
+  vec.Push("one");
+  alglib::Vector<std::string> other;
+  other.Push("two");
+  other.Push("three");
+  vec = std::move(other);
+  EXPECT_EQ(vec.Size(), 2);
+  EXPECT_EQ(vec.At(1), "three");
+}
+
+TEST(VectorTest, AppendRangeGrowsOnce) {
+  alglib::Vector<int> vec(2);
+  vec.Push(0);
+  std::vector<int> source{1, 2, 3, 4, 5, 6, 7, 8, 9};
+  vec.Append(source.begin(), source.end());
+  EXPECT_EQ(vec.Size(), 10);
+  EXPECT_EQ(vec.Capacity(), 10);
+  for (int i{}; i < 10; ++i) EXPECT_EQ(vec.At(i), i);
+}
+
+TEST(VectorTest, AppendSpanOfComplexType) {
+  alglib::Vector<std::string> vec;
+  vec.Push("a");
+  const std::string source[]{"b", "c", "d", "e", "f"};
+  vec.Append(std::span<const std::string>(source));
+  EXPECT_EQ(vec.Size(), 6);
+  EXPECT_EQ(vec.At(5), "f");
+}
+
+TEST(VectorTest, AppendInputIterators) {
+  alglib::Vector<int> vec;
+  std::istringstream stream("1 2 3 4 5");
+  vec.Append(std::istream_iterator<int>(stream), std::istream_iterator<int>());
+  EXPECT_EQ(vec.Size(), 5);
+  EXPECT_EQ(vec.At(4), 5);
+}
+
+
+TEST(VectorTest, MemoryResource) {
+  CountingResource resource;
+  {
+    alglib::pmr::Vector<std::string> vec(&resource);
+    EXPECT_EQ(resource.allocations, 0);
+    for (int i{}; i < 5; ++i) vec.Push(std::to_string(i));
+    EXPECT_EQ(resource.allocations, 2);
+    EXPECT_EQ(vec.At(4), "4");
+    EXPECT_EQ(vec.GetAllocator().resource(), &resource);
+
+    alglib::pmr::Vector<std::string> copy(vec);
+    EXPECT_EQ(copy.At(0), "0");
+  }
+  EXPECT_EQ(resource.deallocations, resource.allocations);
+}
+
+TEST(VectorTest, ValueConstructorReleasesMemoryOnThrow) {
+  CountingResource resource;
+  ThrowingCopy::copies_left = 3;
+  EXPECT_THROW(alglib::pmr::Vector<ThrowingCopy>(5, ThrowingCopy{}, &resource),
+               std::runtime_error);
+  EXPECT_EQ(resource.allocations, 1);
+  EXPECT_EQ(resource.deallocations, 1);
+}
+
+TEST(VectorTest, CopyConstructorReleasesMemoryOnThrow) {
+  CountingResource resource;
+  ThrowingCopy::copies_left = 5;
+  alglib::pmr::Vector<ThrowingCopy> vec(5, ThrowingCopy{}, &resource);
+  ThrowingCopy::copies_left = 2;
+  EXPECT_THROW(alglib::pmr::Vector<ThrowingCopy>(vec, &resource),
+               std::runtime_error);
+  EXPECT_EQ(resource.allocations, 2);
+  EXPECT_EQ(resource.deallocations, 1);
+}
+
+TEST(VectorTest, MoveAssignmentBetweenResources) {
+  CountingResource first;
+  CountingResource second;
+  alglib::pmr::Vector<int> vec(&first);
+  vec.Push(1);
+  vec.Push(2);
+  alglib::pmr::Vector<int> other(&second);
+  other = std::move(vec);
+  EXPECT_EQ(other.Size(), 2);
+  EXPECT_EQ(other.At(1), 2);
+  EXPECT_EQ(other.GetAllocator().resource(), &second);
+}
+TEST(VectorTest, ReserveOnlyGrows) {
+  alglib::Vector<int> vec;
+  vec.Reserve(100);
+  EXPECT_EQ(vec.Capacity(), 100);
+  EXPECT_EQ(vec.Size(), 0);
+  vec.Reserve(10);
+  EXPECT_EQ(vec.Capacity(), 100);
+}
+
+TEST(VectorTest, ClearKeepsCapacity) {
+  Counted::alive = 0;
+  {
+    alglib::Vector<Counted> vec;
+    for (int i{}; i < 10; ++i) vec.Emplace(i);
+    const size_t capacity{vec.Capacity()};
+    const Counted *buffer{vec.Data()};
+    vec.Clear();
+    EXPECT_EQ(vec.Size(), 0);
+    EXPECT_EQ(Counted::alive, 0);
+    EXPECT_EQ(vec.Capacity(), capacity);
+    vec.Emplace(7);
+    EXPECT_EQ(vec.Data(), buffer);
+  }
+  EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(VectorTest, ResizeValueInitializes) {
+  alglib::Vector<int> vec;
+  vec.Push(5);
+  vec.Resize(4);
+  EXPECT_EQ(vec.Size(), 4);
+  EXPECT_EQ(vec.At(0), 5);
+  EXPECT_EQ(vec.At(3), 0);
+
+  vec.Resize(2);
+  EXPECT_EQ(vec.Size(), 2);
+  EXPECT_GE(vec.Capacity(), 4);
+}
+
+TEST(VectorTest, ResizeWithValue) {
+  Counted::alive = 0;
+  {
+    alglib::Vector<Counted> vec;
+    vec.Emplace(1);
+    vec.Resize(50, vec.At(0));
+    EXPECT_EQ(vec.Size(), 50);
+    EXPECT_EQ(vec.At(49).value, 1);
+    EXPECT_EQ(Counted::alive, 50);
+    vec.Resize(3, Counted(9));
+    EXPECT_EQ(Counted::alive, 3);
+  }
+  EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(VectorTest, OneAndHalfGrowthPolicy) {
+  alglib::Vector<int, std::allocator<int>, alglib::OneAndHalfGrowth> vec;
+  std::vector<size_t> capacities;
+  for (int i{}; i < 30; ++i) {
+    if (vec.Size() == vec.Capacity()) capacities.push_back(vec.Capacity());
+    vec.Push(i);
+  }
+  EXPECT_EQ(capacities, std::vector<size_t>({0, 4, 6, 9, 13, 19, 28}));
+}
+
+TEST(VectorTest, FixedChunkGrowthPolicy) {
+  alglib::Vector<int, std::allocator<int>, alglib::FixedChunkGrowth<16>> vec;
+  vec.Push(1);
+  EXPECT_EQ(vec.Capacity(), 16);
+  for (int i{}; i < 16; ++i) vec.Push(i);
+  EXPECT_EQ(vec.Capacity(), 32);
+}
+
+TEST(VectorTest, StatefulGrowthPolicy) {
+  struct AddStep {
+    size_t step;
+    size_t operator()(size_t capacity, size_t) const {
+      return capacity + step;
+    }
+  };
+  alglib::Vector<int, std::allocator<int>, AddStep> vec(std::allocator<int>(),
+                                                        AddStep{10});
+  vec.Push(1);
+  EXPECT_EQ(vec.Capacity(), 10);
+  alglib::Vector<int, std::allocator<int>, AddStep> copy(vec);
+  EXPECT_EQ(copy.GetGrowthPolicy().step, 10);
+
+  // Policy returning less than required is corrected by the vector.
+  std::vector<int> values(25, 0);
+  vec.Append(values.begin(), values.end());
+  EXPECT_GE(vec.Capacity(), 26);
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "work_stealing_deque.h"
+
+TEST(WorkStealingDequeTest, ConstructorAndIsEmpty) {
+  alglib::WorkStealingDeque<int> deque(5);
+  EXPECT_TRUE(deque.IsEmpty());
+  EXPECT_EQ(deque.Size(), 0);
+  EXPECT_EQ(deque.Capacity(), 8);
+  int value{};
+  EXPECT_FALSE(deque.TryPop(value));
+  EXPECT_FALSE(deque.TrySteal(value));
+}
+
+TEST(WorkStealingDequeTest, OwnerPopsNewestFirst) {
+  alglib::WorkStealingDeque<int> deque;
+  for (int i{}; i < 3; ++i) deque.Push(i);
+  int value{};
+  for (int expected{2}; expected >= 0; --expected) {
+    ASSERT_TRUE(deque.TryPop(value));
+    EXPECT_EQ(value, expected);
+  }
+  EXPECT_FALSE(deque.TryPop(value));
+}
+
+TEST(WorkStealingDequeTest, StealTakesOldestFirst) {
+  alglib::WorkStealingDeque<int> deque;
+  for (int i{}; i < 3; ++i) deque.Push(i);
+  int value{};
+  ASSERT_TRUE(deque.TrySteal(value));
+  EXPECT_EQ(value, 0);
+  ASSERT_TRUE(deque.TryPop(value));
+  EXPECT_EQ(value, 2);
+  ASSERT_TRUE(deque.TrySteal(value));
+  EXPECT_EQ(value, 1);
+  EXPECT_TRUE(deque.IsEmpty());
+}
+
+TEST(WorkStealingDequeTest, GrowsWhenFull) {
+  alglib::WorkStealingDeque<int> deque(2);
+  int value{};
+  deque.Push(-1);
+  deque.TrySteal(value);
+  for (int i{}; i < 100; ++i) deque.Push(i);
+  EXPECT_EQ(deque.Size(), 100);
+  EXPECT_GE(deque.Capacity(), 100);
+  for (int i{}; i < 50; ++i) {
+    ASSERT_TRUE(deque.TrySteal(value));
+    EXPECT_EQ(value, i);
+  }
+  for (int i{99}; i >= 50; --i) {
+    ASSERT_TRUE(deque.TryPop(value));
+    EXPECT_EQ(value, i);
+  }
+}
+
+TEST(WorkStealingDequeTest, ThievesAndOwnerTakeEachElementOnce) {
+  constexpr int kCount{50000};
+  constexpr int kThieves{3};
+  alglib::WorkStealingDeque<int> deque(4);
+  std::vector<std::atomic<int>> taken(kCount);
+  std::atomic<bool> done{false};
+  std::vector<std::thread> thieves;
+  for (int t{}; t < kThieves; ++t) {
+    thieves.emplace_back([&] {
+      int value;
+      while (!done.load()) {
+        if (deque.TrySteal(value)) {
+          ++taken[value];
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  int value;
+  for (int i{}; i < kCount; ++i) {
+    deque.Push(i);
+    if (i % 3 == 0 && deque.TryPop(value)) ++taken[value];
+  }
+  while (deque.TryPop(value)) ++taken[value];
+  done = true;
+  for (std::thread &thief : thieves) thief.join();
+  while (deque.TrySteal(value)) ++taken[value];
+  for (int i{}; i < kCount; ++i) EXPECT_EQ(taken[i].load(), 1) << i;
+}